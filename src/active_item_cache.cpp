@@ -49,8 +49,9 @@ bool active_item_cache::add( item &it, point_rel_ms location, item *parent,
         return ret;
     }
     std::unordered_map<item *, safe_reference<item>> &target_index = active_items_index[speed];
-    std::list<item_reference> &target_list = active_items[speed];
-    if( target_index.empty() && !target_index.empty() ) {
+    speed_queue &target_queue = active_items[speed];
+    std::vector<item_reference> &target_list = target_queue.refs;
+    if( target_index.empty() && !target_list.empty() ) {
         // If the index has been cleared, rebuild it first.
         for( item_reference &iter : target_list ) {
             // Omit those expired references
@@ -74,7 +75,11 @@ bool active_item_cache::add( item &it, point_rel_ms location, item *parent,
     if( it.get_use( "explosion" ) ) {
         special_items[special_item_type::explosive].emplace_back( ref );
     }
-    target_list.emplace_back( std::move( ref ) );
+    // Queued last, just before the next item to be processed.
+    target_list.emplace( target_list.begin() + target_queue.next, std::move( ref ) );
+    if( target_list.size() > 1 ) {
+        ++target_queue.next;
+    }
     target_index.emplace( &it, it.get_safe_reference() );
     return true;
 }
@@ -82,23 +87,30 @@ bool active_item_cache::add( item &it, point_rel_ms location, item *parent,
 bool active_item_cache::empty() const
 {
     return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
-        return active_queue.second.empty();
+        return active_queue.second.refs.empty();
     } );
 }
 
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
-            if( it->item_ref ) {
-                all_cached_items.emplace_back( *it );
-                ++it;
+    for( std::pair<const int, speed_queue> &kv : active_items ) {
+        std::vector<item_reference> &refs = kv.second.refs;
+        for( size_t i = 0; i < refs.size(); ) {
+            if( refs[i].item_ref ) {
+                all_cached_items.emplace_back( refs[i] );
+                ++i;
             } else {
                 active_items_index[kv.first].clear();
-                it = kv.second.erase( it );
+                refs.erase( refs.begin() + i );
+                if( i < kv.second.next ) {
+                    --kv.second.next;
+                }
             }
         }
+        if( kv.second.next >= refs.size() ) {
+            kv.second.next = 0;
+        }
     }
     return all_cached_items;
 }
@@ -108,26 +120,31 @@ std::vector<item_reference> active_item_cache::get_for_processing()
     std::vector<item_reference> items_to_process;
     items_to_process.reserve( std::accumulate( active_items.begin(), active_items.end(), std::size_t{ 0 },
     []( size_t prev, const auto & kv ) {
-        return prev + kv.second.size() / static_cast<size_t>( kv.first );
+        return prev + kv.second.refs.size() / static_cast<size_t>( kv.first );
     } ) );
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
+    for( std::pair<const int, speed_queue> &kv : active_items ) {
+        std::vector<item_reference> &refs = kv.second.refs;
         // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
-            if( it->item_ref ) {
-                items_to_process.push_back( *it );
+        int num_to_process = refs.size() / kv.first;
+        // Each item is visited at most once, going around from the next one.
+        const size_t to_visit = refs.size();
+        size_t i = kv.second.next;
+        for( size_t visited = 0; visited < to_visit && num_to_process >= 0; ++visited ) {
+            if( i >= refs.size() ) {
+                i = 0;
+            }
+            if( refs[i].item_ref ) {
+                items_to_process.push_back( refs[i] );
                 --num_to_process;
-                ++it;
+                ++i;
             } else {
                 // The item has been destroyed, so remove the reference from the cache
                 active_items_index[kv.first].clear();
-                it = kv.second.erase( it );
+                refs.erase( refs.begin() + i );
             }
         }
-        // Rotate the returned items to the end of their list so that the items that weren't
-        // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
+        // The items that weren't returned this time will be first in line on the next call
+        kv.second.next = i < refs.size() ? i : 0;
     }
     return items_to_process;
 }
@@ -135,7 +152,7 @@ std::vector<item_reference> active_item_cache::get_for_processing()
 std::vector<item_reference> active_item_cache::get_special( special_item_type type )
 {
     std::vector<item_reference> matching_items;
-    std::list<item_reference> &items = special_items[type];
+    std::vector<item_reference> &items = special_items[type];
     for( auto it = items.begin(); it != items.end(); ) {
         if( it->item_ref ) {
             matching_items.push_back( *it );
@@ -149,8 +166,8 @@ std::vector<item_reference> active_item_cache::get_special( special_item_type ty
 
 void active_item_cache::subtract_locations( const point_rel_ms &delta )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
+    for( std::pair<const int, speed_queue> &pair : active_items ) {
+        for( item_reference &ir : pair.second.refs ) {
             ir.location -= delta;
         }
     }
@@ -158,8 +175,8 @@ void active_item_cache::subtract_locations( const point_rel_ms &delta )
 
 void active_item_cache::rotate_locations( int turns, const point_rel_ms &dim )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
+    for( std::pair<const int, speed_queue> &pair : active_items ) {
+        for( item_reference &ir : pair.second.refs ) {
             // Should 'rotate' be propaged up to the typed coordinates?
             ir.location = ir.location.rotate( turns, dim.raw() );
         }
@@ -168,8 +185,8 @@ void active_item_cache::rotate_locations( int turns, const point_rel_ms &dim )
 
 void active_item_cache::mirror( const point_rel_ms &dim, bool horizontally )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
+    for( std::pair<const int, speed_queue> &pair : active_items ) {
+        for( item_reference &ir : pair.second.refs ) {
             if( horizontally ) {
                 ir.location.x() = dim.x() - 1 - ir.location.x();
             } else {
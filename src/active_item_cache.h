@@ -3,7 +3,6 @@
 #define CATA_SRC_ACTIVE_ITEM_CACHE_H
 
 #include <cstddef>
-#include <list>
 #include <unordered_map>
 #include <vector>
 
@@ -52,8 +51,13 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
-        std::unordered_map<special_item_type, std::list<item_reference>> special_items;
+        // The items of one processing speed, processed in turn starting from `next`.
+        struct speed_queue {
+            std::vector<item_reference> refs;
+            size_t next = 0;
+        };
+        std::unordered_map<int, speed_queue> active_items;
+        std::unordered_map<special_item_type, std::vector<item_reference>> special_items;
         std::unordered_map<int, std::unordered_map<item *, safe_reference<item>>> active_items_index;
     public:
         /**
@@ -79,9 +83,9 @@ class active_item_cache
         std::vector<item_reference> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the next size() / processing_speed() elements of each queue, rounded up.
+         * The next call carries on after the items returned, otherwise only the first n items
+         * will ever be processed.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
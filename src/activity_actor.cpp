@@ -7988,8 +7988,11 @@ void unload_loot_activity_actor::do_turn( player_activity &act, Character &you )
         }
         // sort source tiles by distance
         const auto &src_sorted = get_sorted_tiles_by_distance( abspos, src_set );
+        // Found for all source tiles at once when the first of them can't be reached
+        std::vector<int> src_costs;
 
-        for( const tripoint_abs_ms &src : src_sorted ) {
+        for( size_t src_index = 0; src_index < src_sorted.size(); ++src_index ) {
+            const tripoint_abs_ms &src = src_sorted[src_index];
             placement = src;
             coord_set.erase( src );
 
@@ -8039,10 +8042,15 @@ void unload_loot_activity_actor::do_turn( player_activity &act, Character &you )
 
                 // get either direct route or route to nearest adjacent tile if
                 // source tile is impassable
-                route = here.route( you, pathfinding_target::adjacent( src_loc ) );
+                if( src_costs.empty() || src_costs[src_index] >= 0 ) {
+                    route = here.route( you, pathfinding_target::adjacent( src_loc ) );
+                }
 
                 // check if we found path to source / adjacent tile
                 if( route.empty() ) {
+                    if( src_costs.empty() ) {
+                        src_costs = route_adjacent_costs( you, src_sorted );
+                    }
                     add_msg( m_info, _( "%s can't reach the source tile." ),
                              you.disp_name() );
                     continue;
@@ -38,6 +38,10 @@ std::vector<Point> get_sorted_tiles_by_distance( const Point &center, const Cont
 }
 
 std::vector<tripoint_bub_ms> route_adjacent( const Character &you, const tripoint_bub_ms &dest );
+// Cost of the cheapest route on to or next to each of tiles, -1 where there is none.  All
+// tiles are answered by a single search.
+std::vector<int> route_adjacent_costs( const Character &you,
+                                       const std::vector<tripoint_abs_ms> &tiles );
 
 enum class requirement_check_result : int {
     SKIP_LOCATION = 0,
@@ -687,6 +687,35 @@ static void move_item( Character &you, item &it, const int quantity, const tripo
     }
 }
 
+// Route to the first of tiles that can be reached.  Once one of them turns out to be
+// unreachable, a single search rules out the others that are too.
+static std::vector<tripoint_bub_ms> route_first_reachable( const Character &you,
+        const std::vector<tripoint_bub_ms> &tiles )
+{
+    const map &here = get_map();
+    std::vector<int> costs;
+    for( size_t i = 0; i < tiles.size(); ++i ) {
+        if( !costs.empty() && costs[i] < 0 ) {
+            continue;
+        }
+        std::vector<tripoint_bub_ms> route =
+            here.route( you, pathfinding_target::point( tiles[i] ) );
+
+        if( !route.empty() ) {
+            return route;
+        }
+        if( costs.empty() ) {
+            std::vector<pathfinding_target> targets;
+            targets.reserve( tiles.size() );
+            for( const tripoint_bub_ms &tp : tiles ) {
+                targets.push_back( pathfinding_target::point( tp ) );
+            }
+            costs = here.route_costs( you, targets );
+        }
+    }
+    return {};
+}
+
 std::vector<tripoint_bub_ms> route_adjacent( const Character &you, const tripoint_bub_ms &dest )
 {
     std::unordered_set<tripoint_bub_ms> passable_tiles;
@@ -701,16 +730,19 @@ std::vector<tripoint_bub_ms> route_adjacent( const Character &you, const tripoin
     const std::vector<tripoint_bub_ms> &sorted =
         get_sorted_tiles_by_distance( you.pos_bub(), passable_tiles );
 
-    for( const tripoint_bub_ms &tp : sorted ) {
-        std::vector<tripoint_bub_ms> route =
-            here.route( you, pathfinding_target::point( tp ) );
+    return route_first_reachable( you, sorted );
+}
 
-        if( !route.empty() ) {
-            return route;
-        }
+std::vector<int> route_adjacent_costs( const Character &you,
+                                       const std::vector<tripoint_abs_ms> &tiles )
+{
+    const map &here = get_map();
+    std::vector<pathfinding_target> targets;
+    targets.reserve( tiles.size() );
+    for( const tripoint_abs_ms &tile : tiles ) {
+        targets.push_back( pathfinding_target::adjacent( here.get_bub( tile ) ) );
     }
-
-    return {};
+    return here.route_costs( you, targets );
 }
 
 static std::vector<tripoint_bub_ms> route_best_workbench(
@@ -778,16 +810,7 @@ static std::vector<tripoint_bub_ms> route_best_workbench(
         // We are on the best tile
         return {};
     }
-    for( const tripoint_bub_ms &tp : sorted ) {
-        std::vector<tripoint_bub_ms> route =
-            here.route( you, pathfinding_target::point( tp ) );
-
-        if( !route.empty() ) {
-            return route;
-        }
-    }
-    return {};
-
+    return route_first_reachable( you, sorted );
 }
 
 namespace
@@ -2076,8 +2099,11 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
         }
         // sort source tiles by distance
         const auto &src_sorted = get_sorted_tiles_by_distance( abspos, src_set );
+        // Found for all source tiles at once when the first of them can't be reached
+        std::vector<int> src_costs;
 
-        for( const tripoint_abs_ms &src : src_sorted ) {
+        for( size_t src_index = 0; src_index < src_sorted.size(); ++src_index ) {
+            const tripoint_abs_ms &src = src_sorted[src_index];
             act.placement = src;
             act.coord_set.erase( src );
 
@@ -2266,10 +2292,15 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
 
                 // get either direct route or route to nearest adjacent tile if
                 // source tile is impassable
-                route = here.route( you, pathfinding_target::adjacent( src_loc ) );
+                if( src_costs.empty() || src_costs[src_index] >= 0 ) {
+                    route = here.route( you, pathfinding_target::adjacent( src_loc ) );
+                }
 
                 // check if we found path to source / adjacent tile
                 if( route.empty() ) {
+                    if( src_costs.empty() ) {
+                        src_costs = route_adjacent_costs( you, src_sorted );
+                    }
                     add_msg( m_info, _( "%s can't reach the source tile.  Try to sort out loot without a cart." ),
                              you.disp_name() );
                     continue;
@@ -464,33 +464,35 @@ void advanced_inventory::print_items( side p, bool active )
             mvwprintz( window, point( 1, 6 + item_line ), thiscolor, spaces );
         }
 
-        std::string item_name;
-        std::string stolen_string;
-        bool stolen = false;
-        if( !it.is_owned_by( player_character, true ) ) {
-            stolen_string = "<color_light_red>!</color>";
-            stolen = true;
-        }
-        if( it.is_money() ) {
-            //Count charges
-            // TODO: transition to the item_location system used for the normal inventory
-            unsigned int charges_total = 0;
-            for( const item_location &item : sitem.items ) {
-                charges_total += item->ammo_remaining( );
+        if( !sitem.row_name ) {
+            std::string stolen_string;
+            bool stolen = false;
+            if( !it.is_owned_by( player_character, true ) ) {
+                stolen_string = "<color_light_red>!</color>";
+                stolen = true;
             }
-            if( stolen ) {
-                item_name = string_format( "%s %s", stolen_string, it.display_money( sitem.items.size(),
-                                           charges_total ) );
-            } else {
-                item_name = it.display_money( sitem.items.size(), charges_total );
-            }
-        } else {
-            if( stolen ) {
-                item_name = string_format( "%s %s", stolen_string, it.display_name() );
+            if( it.is_money() ) {
+                //Count charges
+                // TODO: transition to the item_location system used for the normal inventory
+                unsigned int charges_total = 0;
+                for( const item_location &item : sitem.items ) {
+                    charges_total += item->ammo_remaining( );
+                }
+                if( stolen ) {
+                    sitem.row_name = string_format( "%s %s", stolen_string,
+                                                    it.display_money( sitem.items.size(), charges_total ) );
+                } else {
+                    sitem.row_name = it.display_money( sitem.items.size(), charges_total );
+                }
             } else {
-                item_name = it.display_name();
+                if( stolen ) {
+                    sitem.row_name = string_format( "%s %s", stolen_string, it.display_name() );
+                } else {
+                    sitem.row_name = it.display_name();
+                }
             }
         }
+        std::string item_name = *sitem.row_name;
         if( get_option<bool>( "ITEM_SYMBOLS" ) ) {
             item_name = string_format( "%s %s", it.symbol(), item_name );
         }
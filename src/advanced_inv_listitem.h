@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_ADVANCED_INV_LISTITEM_H
 #define CATA_SRC_ADVANCED_INV_LISTITEM_H
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,11 @@ class advanced_inv_listitem
          * Name of the item (singular) without damage (or similar) prefix, used for sorting.
          */
         std::string name_without_prefix;
+        /**
+         * The name shown in the pane, made when the entry is first drawn. The entries are
+         * made again whenever the items may have changed, so it is kept until then.
+         */
+        mutable std::optional<std::string> row_name;
         unsigned int contents_count;
         /**
          * Whether auto pickup is enabled for this item (based on the name).
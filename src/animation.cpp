@@ -67,9 +67,11 @@ class basic_animation
         }
 
         void progress() const {
+            // The delay is the length of a whole frame, drawing it included, so slow draws
+            // don't stretch the animation on top of the delay.
+            const auto sleep_till = std::chrono::steady_clock::now() + std::chrono::nanoseconds( delay );
             draw();
 
-            const auto sleep_till = std::chrono::steady_clock::now() + std::chrono::nanoseconds( delay );
             do {
                 const auto sleep_for = std::min( sleep_till - std::chrono::steady_clock::now(),
                                                  // Pump events every 100 ms
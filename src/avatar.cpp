@@ -247,6 +247,11 @@ bool avatar::save_map_memory()
     return player_map_memory->save( pos_abs() );
 }
 
+void avatar::drop_far_map_memory()
+{
+    player_map_memory->drop_far_submaps( pos_abs() );
+}
+
 void avatar::load_map_memory()
 {
     player_map_memory->load( pos_abs() );
@@ -265,6 +270,11 @@ const memorized_tile &avatar::get_memorized_tile( const tripoint_abs_ms &p ) con
     return mm_submap::default_tile;
 }
 
+size_t avatar::map_memory_estimate() const
+{
+    return player_map_memory->memory_estimate();
+}
+
 void avatar::memorize_terrain( const tripoint_abs_ms &p, std::string_view id,
                                int subtile, int rotation )
 {
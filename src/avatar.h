@@ -92,6 +92,8 @@ class avatar : public Character
         void serialize( JsonOut &json ) const override;
         void deserialize( const JsonObject &data ) override;
         bool save_map_memory();
+        // Drop the map memory save_map_memory would drop, for saves written by a forked copy.
+        void drop_far_map_memory();
         void load_map_memory();
 
         // newcharacter.cpp
@@ -140,6 +142,7 @@ class avatar : public Character
         bool should_show_map_memory() const;
         void prepare_map_memory_region( const tripoint_abs_ms &p1, const tripoint_abs_ms &p2 );
         const memorized_tile &get_memorized_tile( const tripoint_abs_ms &p ) const;
+        size_t map_memory_estimate() const;
         void memorize_terrain( const tripoint_abs_ms &p, std::string_view id,
                                int subtile, int rotation );
         void memorize_decoration( const tripoint_abs_ms &p, std::string_view id,
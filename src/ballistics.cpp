@@ -492,9 +492,12 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
                 }
             }
 
+            // Looked up once per tile, nothing below moves the shooter's vehicle.
+            bool in_own_veh = false;
             if( in_veh != nullptr ) {
                 const optional_vpart_position other = here->veh_at( tp );
-                if( in_veh == veh_pointer_or_null( other ) && other->is_inside() ) {
+                in_own_veh = in_veh == veh_pointer_or_null( other );
+                if( in_own_veh && other->is_inside() ) {
                     // Turret is on the roof and can't hit anything inside
                     continue;
                 }
@@ -540,8 +543,7 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
             }
 
             if( critter != nullptr && cur_missed_by < 1.0 ) {
-                if( in_veh != nullptr && veh_pointer_or_null( here->veh_at( tp ) ) == in_veh &&
-                    critter->is_avatar() ) {
+                if( in_own_veh && critter->is_avatar() ) {
                     // Turret either was aimed by the player (who is now ducking) and shoots from above
                     // Or was just IFFing, giving lots of warnings and time to get out of the line of fire
                     continue;
@@ -579,7 +581,7 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
                         dt.first->onhit_effects( origin, attack.last_hit_critter );
                     }
                 }
-            } else if( in_veh != nullptr && veh_pointer_or_null( here->veh_at( tp ) ) == in_veh ) {
+            } else if( in_own_veh ) {
                 // Don't do anything, especially don't call map::shoot as this would damage the vehicle
             } else {
                 double it = here->shoot( tp, proj, !no_item_damage && tp == target_c );
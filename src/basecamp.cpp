@@ -757,16 +757,17 @@ void basecamp::form_storage_zones( map &here, const tripoint_abs_ms &abspos )
     set_liquid_dumping_spot( possible_liquid_dumps );
 
 }
-void basecamp::form_crafting_inventory( map &target_map )
+void basecamp::form_zone_inventory( map &target_map )
 {
-    _inv.clear();
+    zone_inventory_cache &cache = zone_inv_cache;
+    cache.items.clear();
     zone_manager &mgr = zone_manager::get_manager();
     map &here = get_map();
     if( here.check_vehicle_zones( here.get_abs_sub().z() ) ) {
         mgr.cache_vzones();
     }
     if( !src_set.empty() ) {
-        _inv.form_from_zone( target_map, src_set, nullptr, false );
+        cache.items.form_from_zone( target_map, src_set, nullptr, false );
     }
     /*
      * something of a hack: add the resources we know the camp has
@@ -775,11 +776,11 @@ void basecamp::form_crafting_inventory( map &target_map )
      * map changes
      */
     // make sure the array is empty
-    fuels.clear();
+    cache.fuels.clear();
     for( const itype_id &fuel_id : fuel_types ) {
         basecamp_fuel bcp_f;
         bcp_f.ammo_id = fuel_id;
-        fuels.emplace_back( bcp_f );
+        cache.fuels.emplace_back( bcp_f );
     }
 
     // find available fuel
@@ -788,7 +789,7 @@ void basecamp::form_crafting_inventory( map &target_map )
         const tripoint_bub_ms &pt = target_map.get_bub( abs_ms_pt );
         if( target_map.accessible_items( pt ) ) {
             for( const item &i : target_map.i_at( pt ) ) {
-                for( basecamp_fuel &bcp_f : fuels ) {
+                for( basecamp_fuel &bcp_f : cache.fuels ) {
                     if( bcp_f.ammo_id == i.typeId() ) {
                         bcp_f.available += i.charges;
                         break;
@@ -798,6 +799,30 @@ void basecamp::form_crafting_inventory( map &target_map )
         }
 
     }
+}
+
+void basecamp::invalidate_crafting_inventory()
+{
+    zone_inv_cache.valid = false;
+}
+
+void basecamp::form_crafting_inventory( map &target_map )
+{
+    zone_inventory_cache &cache = zone_inv_cache;
+    const int moves = get_avatar().get_moves();
+    if( !cache.valid || cache.time != calendar::turn || cache.moves != moves ||
+        cache.target != &target_map || cache.src_set != src_set || cache.fuel_types != fuel_types ) {
+        form_zone_inventory( target_map );
+        cache.valid = true;
+        cache.time = calendar::turn;
+        cache.moves = moves;
+        cache.target = &target_map;
+        cache.src_set = src_set;
+        cache.fuel_types = fuel_types;
+    }
+    _inv = cache.items;
+    fuels = cache.fuels;
+
     for( basecamp_resource &bcp_r : resources ) {
         bcp_r.consumed = 0;
         item camp_item( bcp_r.fake_id, calendar::turn_zero );
@@ -853,6 +878,7 @@ map &basecamp::get_camp_map()
 
 void basecamp::unload_camp_map()
 {
+    invalidate_crafting_inventory();
     if( camp_map.map_ ) {
         camp_map.map_.reset();
     }
@@ -1063,5 +1089,6 @@ void basecamp_action_components::consume_components()
             target_map.use_charges( src, bcp_r.ammo_id, bcp_r.consumed );
         }
     }
+    base_.invalidate_crafting_inventory();
     target_map.save();
 }
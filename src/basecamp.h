@@ -293,6 +293,9 @@ class basecamp
         int recipe_batch_max( const recipe &making ) const;
         void form_crafting_inventory();
         void form_crafting_inventory( map &target_map );
+        // Forget the storage zone items kept by form_crafting_inventory, for when items enter or
+        // leave the camp storage without the avatar acting.
+        void invalidate_crafting_inventory();
         std::list<item> use_charges( const itype_id &fake_id, int &quantity );
         /**
          * spawn items or corpses based on search attempts
@@ -347,7 +350,7 @@ class basecamp
         /// Returns a string for the number of plants that are harvestable, plots ready to plant,
         /// and ground that needs tilling
         std::string farm_description( const point_rel_omt &dir, size_t &plots_count,
-                                      farm_ops operation );
+                                      farm_ops operation, smallmap &farm_map );
         /// Returns the description of a camp crafting options. converts fire charges to charcoal,
         /// allows dark crafting
         std::string craft_description( const recipe_id &itm );
@@ -458,8 +461,9 @@ class basecamp
         * @param op whether to plow, plant, or harvest
         */
         bool farm_return( const mission_id &miss_id, const point_rel_omt &dir );
+        // farm_map is the farm when already loaded, otherwise it's loaded (and saved if comp works it)
         std::pair<size_t, std::string> farm_action( const point_rel_omt &dir, farm_ops op,
-                const npc_ptr &comp = nullptr );
+                const npc_ptr &comp = nullptr, smallmap *farm_map = nullptr );
         void fortifications_return( const mission_id &miss_id );
         bool salt_water_pipe_swamp_return( const mission_id &miss_id,
                                            const comp_list &npc_list );
@@ -498,6 +502,8 @@ class basecamp
         faction *fac() const;
         // lazy re-evaluation of available camp resources
         void reset_camp_resources( map &here );
+        // forms the storage zone items and fuels of zone_inv_cache
+        void form_zone_inventory( map &target_map );
         void add_resource( const itype_id &camp_resource );
         // omt pos
         tripoint_abs_omt omt_pos;
@@ -517,6 +523,18 @@ class basecamp
         std::vector<basecamp_resource> resources; // NOLINT(cata-serialize)
         std::vector<std::vector<ui_mission_id>> temp_ui_mission_keys;   // NOLINT(cata-serialize)
         inventory _inv; // NOLINT(cata-serialize)
+        // The storage zone part of _inv, kept while the avatar browses the camp menus.
+        struct zone_inventory_cache {
+            bool valid = false; // other fields are only valid if this flag is true
+            time_point time;
+            int moves = 0;
+            const map *target = nullptr;
+            std::unordered_set<tripoint_abs_ms> src_set;
+            std::set<itype_id> fuel_types;
+            inventory items;
+            std::vector<basecamp_fuel> fuels;
+        };
+        zone_inventory_cache zone_inv_cache; // NOLINT(cata-serialize)
         bool by_radio = false; // NOLINT(cata-serialize)
 };
 
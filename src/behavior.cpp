@@ -36,11 +36,7 @@ status_t node_t::process_predicates( const oracle_t *subject ) const
 {
     status_t result = status_t::running;
 
-    for( const std::tuple< predicate_type, std::string, bool > &predicate_tuple : conditions ) {
-        predicate_type pt = std::get<0>( predicate_tuple );
-        std::string pargs = std::get<1>( predicate_tuple );
-        bool pinvert = std::get<2>( predicate_tuple );
-
+    for( const auto &[pt, pargs, pinvert] : conditions ) {
         result = pt( subject, pargs );
 
         if( pinvert ) {
@@ -23,7 +23,7 @@ using namespace behavior;
 
 // A standard behavior strategy, execute runnable children in order unless one fails.
 behavior_return sequential_t::evaluate( const oracle_t *subject,
-                                        const std::vector<const node_t *> children ) const
+                                        const std::vector<const node_t *> &children ) const
 {
     for( const node_t *child : children ) {
         behavior_return outcome = child->tick( subject );
@@ -36,7 +36,7 @@ behavior_return sequential_t::evaluate( const oracle_t *subject,
 
 // A standard behavior strategy, execute runnable children in order until one succeeds.
 behavior_return fallback_t::evaluate( const oracle_t *subject,
-                                      const std::vector<const node_t *> children ) const
+                                      const std::vector<const node_t *> &children ) const
 {
     for( const node_t *child : children ) {
         behavior_return outcome = child->tick( subject );
@@ -49,7 +49,7 @@ behavior_return fallback_t::evaluate( const oracle_t *subject,
 
 // A non-standard behavior strategy, execute runnable children in order unconditionally.
 behavior_return sequential_until_done_t::evaluate( const oracle_t *subject,
-        const std::vector<const node_t *> children ) const
+        const std::vector<const node_t *> &children ) const
 {
     for( const node_t *child : children ) {
         behavior_return outcome = child->tick( subject );
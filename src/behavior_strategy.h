@@ -18,25 +18,25 @@ class strategy_t
     public:
         virtual ~strategy_t() = default;
         virtual behavior_return evaluate( const oracle_t *subject,
-                                          std::vector<const node_t *> children ) const = 0;
+                                          const std::vector<const node_t *> &children ) const = 0;
 };
 
 class sequential_t : public strategy_t
 {
         behavior_return evaluate( const oracle_t *subject,
-                                  std::vector<const node_t *> children ) const override;
+                                  const std::vector<const node_t *> &children ) const override;
 };
 
 class fallback_t : public strategy_t
 {
         behavior_return evaluate( const oracle_t *subject,
-                                  std::vector<const node_t *> children ) const override;
+                                  const std::vector<const node_t *> &children ) const override;
 };
 
 class sequential_until_done_t : public strategy_t
 {
         behavior_return evaluate( const oracle_t *subject,
-                                  std::vector<const node_t *> children ) const override;
+                                  const std::vector<const node_t *> &children ) const override;
 };
 
 extern std::unordered_map<std::string, const strategy_t *> strategy_map;
@@ -31,5 +31,5 @@ mouse_t mouse;
 
 #ifndef CATA_IN_TOOL
 error_log_format_t error_log_format = error_log_format_t::human_readable;
-check_plural_t check_plural = check_plural_t::certain;
+thread_local check_plural_t check_plural = check_plural_t::certain;
 #endif
@@ -68,7 +68,8 @@ enum class check_plural_t {
     possible, // report strings that may or may not have a non-regular plural form, such as those containing the word "of"
 };
 #ifndef CATA_IN_TOOL
-extern check_plural_t check_plural;
+// Per thread, as data loaded on the thread pool is checked like it was when it was queued.
+extern thread_local check_plural_t check_plural;
 #else
 constexpr check_plural_t check_plural = check_plural_t::none;
 #endif
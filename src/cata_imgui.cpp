@@ -1,5 +1,9 @@
 #include "cata_imgui.h"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui/imgui.h>
 #include <imgui/imgui_internal.h>
@@ -755,6 +759,43 @@ void cataimgui::draw_colored_text( const std::string &original_text, nc_color &c
     ImGui::PopStyleColor();
 }
 
+namespace
+{
+// Text of draw_colored_text with its colors replaced, folded and split into color segments.
+struct folded_colored_text {
+    std::string text;
+    std::vector<std::vector<std::string>> lines;
+};
+} // namespace
+
+// Windows are redrawn every frame with the same texts, so their parses are remembered.
+static const folded_colored_text &fold_colored_text( const std::string &original_text,
+        const size_t chars_per_line )
+{
+    static constexpr size_t max_cached_texts = 4096;
+    static std::unordered_map<size_t, std::unordered_map<std::string, folded_colored_text>> cache;
+    static size_t cached_texts = 0;
+
+    std::unordered_map<std::string, folded_colored_text> &by_text = cache[chars_per_line];
+    const auto found = by_text.find( original_text );
+    if( found != by_text.end() ) {
+        return found->second;
+    }
+    if( cached_texts >= max_cached_texts ) {
+        for( auto &[width, texts] : cache ) {
+            texts.clear();
+        }
+        cached_texts = 0;
+    }
+    folded_colored_text &folded = by_text[original_text];
+    ++cached_texts;
+    folded.text = replace_colors( original_text );
+    for( const std::string &line : foldstring( folded.text, chars_per_line ) ) {
+        folded.lines.emplace_back( split_by_color( line ) );
+    }
+    return folded;
+}
+
 void cataimgui::draw_colored_text( const std::string &original_text,
                                    float wrap_width, bool *is_selected, bool *is_focused, bool *is_hovered )
 {
@@ -762,11 +803,6 @@ void cataimgui::draw_colored_text( const std::string &original_text,
         ImGui::NewLine();
         return;
     }
-    const std::string &text = replace_colors( original_text );
-
-    ImGui::PushID( text.c_str() );
-    int startColorStackCount = GImGui->ColorStack.Size;
-    ImGuiID itemId = GImGui->CurrentWindow->IDStack.back();
 
     size_t chars_per_line = size_t( wrap_width );
     if( chars_per_line == 0 ) {
@@ -776,10 +812,13 @@ void cataimgui::draw_colored_text( const std::string &original_text,
     size_t char_width = size_t( ImGui::CalcTextSize( " " ).x );
     chars_per_line /= char_width;
 #endif
-    std::vector<std::string> folded_msg = foldstring( text, chars_per_line );
+    const folded_colored_text &folded = fold_colored_text( original_text, chars_per_line );
+
+    ImGui::PushID( folded.text.c_str() );
+    int startColorStackCount = GImGui->ColorStack.Size;
+    ImGuiID itemId = GImGui->CurrentWindow->IDStack.back();
 
-    for( const std::string &line : folded_msg ) {
-        const auto color_segments = split_by_color( line );
+    for( const std::vector<std::string> &color_segments : folded.lines ) {
         if( is_selected != nullptr ) {
             ImGui::Selectable( "", is_selected );
             ImGui::SameLine( 0, 0 );
@@ -0,0 +1,178 @@
+#include "cata_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace cata
+{
+
+static thread_local bool is_worker_thread = false;
+
+thread_pool::thread_pool( const int num_workers )
+{
+    workers.reserve( std::max( num_workers, 0 ) );
+    for( int i = 0; i < num_workers; ++i ) {
+        workers.emplace_back( [this]() {
+            worker_loop();
+        } );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lk( tasks_mutex );
+        stopping = true;
+    }
+    tasks_cv.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+bool thread_pool::on_worker_thread()
+{
+    return is_worker_thread;
+}
+
+void thread_pool::enqueue( std::function<void()> task )
+{
+    {
+        std::lock_guard<std::mutex> lk( tasks_mutex );
+        tasks.emplace_back( std::move( task ) );
+    }
+    tasks_cv.notify_one();
+}
+
+void thread_pool::enqueue_front( std::function<void()> task )
+{
+    {
+        std::lock_guard<std::mutex> lk( tasks_mutex );
+        tasks.emplace_front( std::move( task ) );
+    }
+    tasks_cv.notify_one();
+}
+
+void thread_pool::worker_loop()
+{
+    is_worker_thread = true;
+    while( true ) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lk( tasks_mutex );
+            tasks_cv.wait( lk, [this]() {
+                return stopping || !tasks.empty();
+            } );
+            // Drain the queue before stopping so no future is left without a value.
+            if( tasks.empty() ) {
+                return;
+            }
+            task = std::move( tasks.front() );
+            tasks.pop_front();
+            ++running;
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lk( tasks_mutex );
+            --running;
+        }
+        idle_cv.notify_all();
+    }
+}
+
+void thread_pool::wait_until_idle()
+{
+    std::unique_lock<std::mutex> lk( tasks_mutex );
+    idle_cv.wait( lk, [this]() {
+        return tasks.empty() && running == 0;
+    } );
+}
+
+void thread_pool::run_on_caller_only()
+{
+    caller_only = true;
+}
+
+void thread_pool::parallel_for( const int begin, const int end,
+                                const std::function<void( int )> &func )
+{
+    if( begin >= end ) {
+        return;
+    }
+    const int helpers = on_worker_thread() ? 0 : std::min( num_workers(), end - begin - 1 );
+    if( helpers <= 0 ) {
+        for( int i = begin; i < end; ++i ) {
+            func( i );
+        }
+        return;
+    }
+
+    // Helpers can still be queued behind background work when the caller runs out of indices.
+    // They share this state rather than the caller's stack, so the caller need not wait for
+    // them to start, and one that starts after the loop was closed does nothing.
+    struct loop_state {
+        std::atomic<int> next;
+        int end;
+        const std::function<void( int )> *func;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        int helpers_running = 0;
+        bool closed = false;
+    };
+    const std::shared_ptr<loop_state> state = std::make_shared<loop_state>();
+    state->next = begin;
+    state->end = end;
+    state->func = &func;
+
+    const auto run = []( loop_state & st ) {
+        for( int i = st.next++; i < st.end; i = st.next++ ) {
+            try {
+                ( *st.func )( i );
+            } catch( ... ) {
+                std::lock_guard<std::mutex> lk( st.mutex );
+                if( !st.error ) {
+                    st.error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    for( int h = 0; h < helpers; ++h ) {
+        // Ahead of queued background tasks, as the caller is waiting on these.
+        enqueue_front( [state, run]() {
+            {
+                std::lock_guard<std::mutex> lk( state->mutex );
+                if( state->closed ) {
+                    return;
+                }
+                ++state->helpers_running;
+            }
+            run( *state );
+            std::lock_guard<std::mutex> lk( state->mutex );
+            if( --state->helpers_running == 0 ) {
+                state->done_cv.notify_one();
+            }
+        } );
+    }
+    run( *state );
+
+    std::unique_lock<std::mutex> lk( state->mutex );
+    state->closed = true;
+    state->done_cv.wait( lk, [&]() {
+        return state->helpers_running == 0;
+    } );
+    if( state->error ) {
+        std::rethrow_exception( state->error );
+    }
+}
+
+thread_pool &get_thread_pool()
+{
+    static thread_pool pool( std::max( static_cast<int>( std::thread::hardware_concurrency() ) - 1,
+                                       0 ) );
+    return pool;
+}
+
+} // namespace cata
@@ -0,0 +1,107 @@
+#pragma once
+#ifndef CATA_SRC_CATA_THREAD_POOL_H
+#define CATA_SRC_CATA_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+namespace cata
+{
+
+/**
+ * A fixed set of worker threads consuming a shared queue of tasks.
+ *
+ * Game state is generally not thread safe, so work handed to the pool must only read shared
+ * data and write to memory no other task touches.
+ */
+class thread_pool
+{
+    public:
+        // A pool with no workers is valid; all work then runs on the calling thread.
+        explicit thread_pool( int num_workers );
+        ~thread_pool();
+
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+
+        // Number of worker threads, not counting threads that wait on results.
+        int num_workers() const {
+            return caller_only ? 0 : static_cast<int>( workers.size() );
+        }
+
+        // True if called from one of the workers of any pool.
+        static bool on_worker_thread();
+
+        /**
+         * Queue func to run on a worker and return a future for its result.
+         * Exceptions thrown by func are rethrown from future::get.
+         * With no workers, func runs immediately on the calling thread.
+         */
+        template<typename F>
+        std::future<std::invoke_result_t<F>> submit( F &&func ) {
+            using result_t = std::invoke_result_t<F>;
+            auto task = std::make_shared<std::packaged_task<result_t()>>( std::forward<F>( func ) );
+            std::future<result_t> result = task->get_future();
+            if( num_workers() == 0 ) {
+                ( *task )();
+            } else {
+                enqueue( [task]() {
+                    ( *task )();
+                } );
+            }
+            return result;
+        }
+
+        /**
+         * Call func( i ) for every i in [begin, end) and return once all calls finished.
+         * The calling thread takes part in the work, and does not wait for helpers that had not
+         * started by the time it ran out of calls, so a busy pool never delays the loop beyond
+         * running it serially.  Calls from a worker thread run the loop serially, so nesting
+         * cannot deadlock.  The first exception thrown by func is rethrown
+         * after every other call has finished.
+         */
+        void parallel_for( int begin, int end, const std::function<void( int )> &func );
+
+        // Wait until every queued task has finished.
+        void wait_until_idle();
+
+        /**
+         * Run everything on the calling thread from now on.  For a forked copy of the
+         * process, in which the workers do not exist.
+         */
+        void run_on_caller_only();
+
+    private:
+        void enqueue( std::function<void()> task );
+        void enqueue_front( std::function<void()> task );
+        void worker_loop();
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex tasks_mutex;
+        std::condition_variable tasks_cv;
+        std::condition_variable idle_cv;
+        // Tasks taken off the queue that have not finished yet.
+        int running = 0;
+        bool stopping = false;
+        bool caller_only = false;
+};
+
+// The pool shared by the game, with one worker less than the hardware has threads.
+thread_pool &get_thread_pool();
+
+} // namespace cata
+
+#endif // CATA_SRC_CATA_THREAD_POOL_H
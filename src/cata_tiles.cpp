@@ -27,6 +27,7 @@
 #include "calendar.h"
 #include "cata_assert.h"
 #include "cata_path.h"
+#include "cata_thread_pool.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "character.h"
@@ -70,6 +71,7 @@
 #include "npc.h"
 #include "npc_attack.h"
 #include "omdata.h"
+#include "options.h"
 #include "output.h"
 #include "overlay_ordering.h"
 #include "overmap.h"
@@ -107,6 +109,9 @@ static const trait_id trait_INATTENTIVE( "INATTENTIVE" );
 
 static const trap_str_id tr_unfinished_construction( "tr_unfinished_construction" );
 
+static const option_handle<bool> option_nv_green_toggle( "NV_GREEN_TOGGLE" );
+static const option_handle<std::string> option_use_celsius( "USE_CELSIUS" );
+
 static const std::string ITEM_HIGHLIGHT( "highlight_item" );
 static const std::string ZOMBIE_REVIVAL_INDICATOR( "zombie_revival_indicator" );
 
@@ -365,6 +370,7 @@ void cata_tiles::load_tileset( const std::string &tileset_id, const bool prechec
     tileset_mutation_overlay_ordering.clear();
 
     tileset_ptr = cache.load_tileset( tileset_id, renderer, precheck, force, pump_events, terrain );
+    clear_looks_like_cache();
 
     set_draw_scale( 16 );
 
@@ -429,16 +435,21 @@ static void get_tile_information( const cata_path &config_path, std::string &jso
     }
 }
 
-template<typename PixelConverter>
-static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
-        PixelConverter pixel_converter )
+static SDL_Surface_Ptr copy_surface_32( const SDL_Surface_Ptr &original )
 {
     cata_assert( original );
     SDL_Surface_Ptr surf = create_surface_32( original->w, original->h );
     cata_assert( surf );
     throwErrorIf( SDL_BlitSurface( original.get(), nullptr, surf.get(), nullptr ) != 0,
                   "SDL_BlitSurface failed" );
+    return surf;
+}
 
+// Only touches the pixels of surf, so it can run on several surfaces at once.
+template<typename PixelConverter>
+static void apply_color_filter( const SDL_Surface_Ptr &surf, PixelConverter pixel_converter )
+{
+    cata_assert( surf );
     SDL_Color *pix = static_cast<SDL_Color *>( surf->pixels );
 
     for( int y = 0, ey = surf->h; y < ey; ++y ) {
@@ -451,8 +462,6 @@ static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
             *pix = pixel_converter( *pix );
         }
     }
-
-    return surf;
 }
 
 static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
@@ -464,7 +473,7 @@ static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
 }
 
 void tileset_cache::loader::copy_surface_to_texture( const SDL_Surface_Ptr &surf,
-        const point &offset, std::vector<texture> &target )
+        const point &offset, const std::vector<std::vector<texture> *> &targets )
 {
     cata_assert( surf );
     const rect_range<SDL_Rect> input_range( sprite_width, sprite_height,
@@ -482,9 +491,11 @@ void tileset_cache::loader::copy_surface_to_texture( const SDL_Surface_Ptr &surf
         cata_assert( pos.y % sprite_height == 0 );
         const size_t index = this->offset + ( pos.x / sprite_width ) + ( pos.y / sprite_height ) *
                              ( tile_atlas_width / sprite_width );
-        cata_assert( index < target.size() );
-        cata_assert( target[index].dimension() == std::make_pair( 0, 0 ) );
-        target[index] = texture( texture_ptr, rect );
+        for( std::vector<texture> *target : targets ) {
+            cata_assert( index < target->size() );
+            cata_assert( ( *target )[index].dimension() == std::make_pair( 0, 0 ) );
+            ( *target )[index] = texture( texture_ptr, rect );
+        }
     }
 }
 
@@ -503,18 +514,34 @@ void tileset_cache::loader::create_textures_from_tile_atlas( const SDL_Surface_P
             { std::make_tuple( &ts.memory_tile_values, tilecontext->memory_map_mode ) }
         }
     };
-    for( tiles_pixel_color_entry &entry : tile_values_data ) {
-        std::vector<texture> *tile_values = std::get<0>( entry );
-        color_pixel_function_pointer color_pixel_function = get_color_pixel_function( std::get<1>
-                ( entry ) );
-        if( !color_pixel_function ) {
-            // TODO: Move it inside apply_color_filter.
-            copy_surface_to_texture( tile_atlas, offset, *tile_values );
+    std::array<color_pixel_function_pointer, std::tuple_size_v<decltype( tile_values_data )>>
+            color_pixel_functions;
+    std::array<SDL_Surface_Ptr, std::tuple_size_v<decltype( tile_values_data )>> filtered;
+    // SDL surfaces must not be blitted from several threads, so copy the atlas for each
+    // filter here and only convert the pixels in parallel.
+    for( size_t i = 0; i < tile_values_data.size(); ++i ) {
+        color_pixel_functions[i] = get_color_pixel_function( std::get<1>( tile_values_data[i] ) );
+        if( color_pixel_functions[i] ) {
+            filtered[i] = copy_surface_32( tile_atlas );
+        }
+    }
+    cata::get_thread_pool().parallel_for( 0, static_cast<int>( tile_values_data.size() ),
+    [&]( const int i ) {
+        if( color_pixel_functions[i] ) {
+            apply_color_filter( filtered[i], color_pixel_functions[i] );
+        }
+    } );
+    // Textures are created on this thread, the renderer is not thread safe.  The unfiltered
+    // variants all show the atlas as it is, so they share one texture.
+    std::vector<std::vector<texture> *> unfiltered;
+    for( size_t i = 0; i < tile_values_data.size(); ++i ) {
+        if( filtered[i] ) {
+            copy_surface_to_texture( filtered[i], offset, { std::get<0>( tile_values_data[i] ) } );
         } else {
-            copy_surface_to_texture( apply_color_filter( tile_atlas, color_pixel_function ), offset,
-                                     *tile_values );
+            unfiltered.push_back( std::get<0>( tile_values_data[i] ) );
         }
     }
+    copy_surface_to_texture( tile_atlas, offset, unfiltered );
 }
 
 template<typename T>
@@ -1633,9 +1660,9 @@ void cata_tiles::draw( const point &dest, const tripoint_bub_ms &center, int wid
                             }
 
                             std::string temp_str;
-                            if( get_option<std::string>( "USE_CELSIUS" ) == "celsius" ) {
+                            if( option_use_celsius() == "celsius" ) {
                                 temp_str = string_format( "%.0f", celsius_temp_value );
-                            } else if( get_option<std::string>( "USE_CELSIUS" ) == "kelvin" ) {
+                            } else if( option_use_celsius() == "kelvin" ) {
                                 temp_str = string_format( "%.0f", units::to_kelvin( temp_value ) );
                             } else {
                                 temp_str = string_format( "%.0f", units::to_fahrenheit( temp_value ) );
@@ -2324,6 +2351,33 @@ cata_tiles::find_tile_with_season( const std::string &id ) const
     return tileset_ptr->find_tile_type_by_season( id, season );
 }
 
+std::optional<tile_lookup_res>
+cata_tiles::find_tile_looks_like_cached( const std::string &id, TILE_CATEGORY category,
+        const std::string &variant ) const
+{
+    const season_type season = season_of_year( calendar::turn );
+    if( season != looks_like_cache_season ) {
+        clear_looks_like_cache();
+        looks_like_cache_season = season;
+    }
+    // Only copies id when it is seen for the first time.
+    auto &by_variant = looks_like_cache[static_cast<size_t>( category )][id];
+    const auto iter = by_variant.find( variant );
+    if( iter != by_variant.end() ) {
+        return iter->second;
+    }
+    std::optional<tile_lookup_res> res = find_tile_looks_like( id, category, variant );
+    by_variant.emplace( variant, res );
+    return res;
+}
+
+void cata_tiles::clear_looks_like_cache() const
+{
+    for( auto &by_id : looks_like_cache ) {
+        by_id.clear();
+    }
+}
+
 template<typename T>
 std::optional<tile_lookup_res>
 cata_tiles::find_tile_looks_like_by_string_id( std::string_view id, TILE_CATEGORY category,
@@ -2553,7 +2607,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         int intensity_level, const std::string &variant,
         const point &offset )
 {
-    bool nv_color_active = apply_night_vision_goggles && get_option<bool>( "NV_GREEN_TOGGLE" );
+    bool nv_color_active = apply_night_vision_goggles && option_nv_green_toggle();
     // If the ID string does not produce a drawable tile
     // it will revert to the "unknown" tile.
     // The "unknown" tile is one that is highly visible so you kinda can't miss it :D
@@ -2587,7 +2641,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
 
         // Adding to the id like this breaks the fragile string handling that vision level uses for looks_like.
         if( prevent_occlusion_transp && retract > 0 && category != TILE_CATEGORY::OVERMAP_VISION_LEVEL ) {
-            res = find_tile_looks_like( id + "_transparent", category, variant );
+            res = find_tile_looks_like_cached( id + "_transparent", category, variant );
             if( res ) {
                 tt = &res -> tile();
             }
@@ -2597,14 +2651,15 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
     // check if there is an available intensity tile and if there is use that instead of the basic tile
     // this is only relevant for fields
     if( intensity_level > 0 ) {
-        res = find_tile_looks_like( id + "_int" + std::to_string( intensity_level ), category, variant );
+        res = find_tile_looks_like_cached( id + "_int" + std::to_string( intensity_level ), category,
+                                           variant );
         if( res ) {
             tt = &res -> tile();
         }
     }
     // if a tile with intensity hasn't already been found then fall back to a base tile
     if( !res ) {
-        res = find_tile_looks_like( id, category, variant );
+        res = find_tile_looks_like_cached( id, category, variant );
         if( res ) {
             tt = &res -> tile();
         }
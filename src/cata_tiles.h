@@ -147,6 +147,11 @@ class texture
         int render_copy_ex( const SDL_Renderer_Ptr &renderer, const SDL_Rect *const dstrect,
                             const double angle,
                             const SDL_Point *const center, const SDL_RendererFlip flip ) const {
+            // Unrotated, unflipped sprites take SDL's plain copy path, which batches on all
+            // renderers and skips the per-vertex rotation.
+            if( angle == 0 && flip == SDL_FLIP_NONE ) {
+                return SDL_RenderCopy( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect );
+            }
             return SDL_RenderCopyEx( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect, angle, center,
                                      flip );
         }
@@ -329,8 +334,9 @@ class tileset_cache::loader
 
         void ensure_default_item_highlight();
 
+        // Makes one texture of surf and shares it with every one of targets.
         void copy_surface_to_texture( const SDL_Surface_Ptr &surf, const point &offset,
-                                      std::vector<texture> &target );
+                                      const std::vector<std::vector<texture> *> &targets );
         void create_textures_from_tile_atlas( const SDL_Surface_Ptr &tile_atlas, const point &offset );
 
         void process_variations_after_loading( weighted_int_list<std::vector<int>> &v ) const;
@@ -483,6 +489,11 @@ class cata_tiles
         std::optional<tile_lookup_res>
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category, const std::string &variant,
                               int looks_like_jumps_limit = 10 ) const;
+        /** find_tile_looks_like, remembering the result until the tileset or the season changes */
+        std::optional<tile_lookup_res>
+        find_tile_looks_like_cached( const std::string &id, TILE_CATEGORY category,
+                                     const std::string &variant ) const;
+        void clear_looks_like_cache() const;
 
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
@@ -891,6 +902,13 @@ class cata_tiles
          */
         bool nv_goggles_activated = false;
 
+        // Results of find_tile_looks_like_cached, per category, keyed on id then variant, so
+        // that a lookup doesn't have to copy either string.
+        mutable std::array<std::unordered_map<std::string,
+                std::unordered_map<std::string, std::optional<tile_lookup_res>>>,
+                static_cast<size_t>( TILE_CATEGORY::last )> looks_like_cache;
+        mutable season_type looks_like_cache_season = season_type::NUM_SEASONS;
+
         pimpl<pixel_minimap> minimap;
 
     public:
@@ -624,6 +624,27 @@ bool read_from_zzip_optional( const std::shared_ptr<zzip> &z,
     }
 }
 
+bool read_from_zzip_stream_optional( const std::shared_ptr<zzip> &z,
+                                     const std::filesystem::path &file,
+                                     const std::function<void( std::istream & )> &reader )
+{
+    if( !z || !z->has_file( file ) ) {
+        return false;
+    }
+    try {
+        std::unique_ptr<std::istream> stream = z->get_file_stream( file );
+        if( !stream ) {
+            throw std::runtime_error( "compressed data is corrupt" );
+        }
+        reader( *stream );
+        return true;
+    } catch( const std::exception &err ) {
+        debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), file.generic_u8string().c_str(),
+                  err.what() );
+        return false;
+    }
+}
+
 bool read_from_zzip_optional( const std::shared_ptr<zzip_stack> &z,
                               const std::filesystem::path &file,
                               const std::function<void( std::string_view )> &reader )
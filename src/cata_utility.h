@@ -374,6 +374,10 @@ bool read_from_zzip_optional( const std::shared_ptr<zzip> &z,
 bool read_from_zzip_optional( const std::shared_ptr<zzip_stack> &z,
                               const std::filesystem::path &file,
                               const std::function<void( std::string_view )> &reader );
+// Decompresses the file while the reader consumes the stream, instead of all of it up front.
+bool read_from_zzip_stream_optional( const std::shared_ptr<zzip> &z,
+                                     const std::filesystem::path &file,
+                                     const std::function<void( std::istream & )> &reader );
 /**@}*/
 
 /**
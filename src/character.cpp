@@ -10622,9 +10622,11 @@ std::vector<Creature *> Character::get_visible_creatures( const int range ) cons
 {
     const map &here = get_map();
 
-    return g->get_creatures_if( [this, range, &here]( const Creature & critter ) -> bool {
+    creature_tracker &creatures = get_creature_tracker();
+
+    return g->get_creatures_if( [this, range, &here, &creatures]( const Creature & critter ) -> bool {
         return this != &critter && pos_abs() != critter.pos_abs() &&
-        rl_dist( pos_abs(), critter.pos_abs() ) <= range && sees( here, critter );
+        rl_dist( pos_abs(), critter.pos_abs() ) <= range && creatures.sees( here, *this, critter );
     } );
 }
 
@@ -10712,12 +10714,16 @@ void Character::echo_pulse()
         sounds::sound( this->pos_bub(), 5, sounds::sound_t::movement, _( "chirp." ), true,
                        "none", "none" );
     }
-    for( tripoint_bub_ms origin : points_in_radius( pos_bub(), pulse_range ) ) {
-        if( here.move_cost( origin ) == 0 && here.sees( pos_bub(), origin, pulse_range, false ) ) {
+    const tripoint_range<tripoint_bub_ms> pulse_area = points_in_radius( pos_bub(), pulse_range );
+    const std::vector<tripoint_bub_ms> origins( pulse_area.begin(), pulse_area.end() );
+    const std::vector<bool> in_sight = here.sees( pos_bub(), origins, pulse_range, false );
+    for( size_t i = 0; i < origins.size(); ++i ) {
+        const tripoint_bub_ms &origin = origins[i];
+        if( here.move_cost( origin ) == 0 && in_sight[i] ) {
             sounds::sound( origin, 5, sounds::sound_t::sensory, _( "clack." ), true,
                            "none", "none" );
             // This only counts obstacles which can be moved through, so the echo is pretty quiet.
-        } else if( is_obstacle( origin ) && here.sees( pos_bub(), origin, pulse_range, false ) ) {
+        } else if( is_obstacle( origin ) && in_sight[i] ) {
             sounds::sound( origin, 1, sounds::sound_t::sensory, _( "click." ), true,
                            "none", "none" );
         }
@@ -10729,7 +10735,7 @@ void Character::echo_pulse()
             add_known_trap( origin, tr );
         }
         Creature *critter = get_creature_tracker().creature_at( origin, true );
-        if( critter && here.sees( pos_bub(), origin, pulse_range, false ) ) {
+        if( critter && in_sight[i] ) {
             switch( critter->get_size() ) {
                 case creature_size::tiny:
                     echo_volume = 1;
@@ -478,7 +478,7 @@ void Character::update_bodytemp()
     // Sunlight
     const float scaled_sun_irradiance = incident_sun_irradiance( get_weather().weather_id,
                                         calendar::turn ) / max_sun_irradiance();
-    const units::temperature_delta sunlight_warmth = !g->is_sheltered( pos_bub() ) ? 3_C_delta *
+    const units::temperature_delta sunlight_warmth = !sheltered ? 3_C_delta *
             scaled_sun_irradiance :
             0_C_delta;
     const int best_fire = get_best_fire( pos_bub() );
@@ -495,13 +495,20 @@ void Character::update_bodytemp()
     // Difference between high and low is the "safe" heat - one we only apply if it's beneficial
     const units::temperature_delta mutation_heat_bonus = mutation_heat_high - mutation_heat_low;
 
-    const units::temperature_delta h_radiation = get_heat_radiation( pos_bub() );
+    const units::temperature_delta h_radiation = weather_man.get_heat_radiation( pos_bub() );
 
     // 111F (44C) is a temperature in which proteins break down: https://en.wikipedia.org/wiki/Burn
     // Blisters arbitrarily scale with the sqrt of the temperature difference in fahrenheit.
     const int radiation_blister_count = h_radiation > 44_C_delta ? static_cast<int>( std::sqrt(
                                             units::to_fahrenheit_delta( h_radiation - 44_C_delta ) ) ) : 0;
 
+    // The same for every body part, only the wind reaching each part differs.
+    const int local_humidity = get_local_humidity( weather.humidity, weather_man.weather_id,
+                               sheltered );
+    const bool in_deep_water = here.has_flag_ter( ter_furn_flag::TFLAG_DEEP_WATER, pos_bub() );
+    const bool in_shallow_water = here.has_flag_ter( ter_furn_flag::TFLAG_SHALLOW_WATER, pos_bub() );
+    const bool pyromania = has_trait( trait_PYROMANIA );
+
     std::map<bodypart_id, std::vector<const item *>> clothing_map;
     for( const bodypart_id &bp : get_all_body_parts() ) {
         clothing_map.emplace( bp, std::vector<const item *>() );
@@ -540,8 +547,7 @@ void Character::update_bodytemp()
         bp_windpower = static_cast<int>( static_cast<float>( bp_windpower ) *
                                          ( 1 - wind_res_per_bp[bp] / 100.0 ) );
         // Calculate windchill
-        units::temperature_delta windchill = get_local_windchill( player_local_temp,
-                                             get_local_humidity( weather.humidity, get_weather().weather_id, sheltered ),
+        units::temperature_delta windchill = get_local_windchill( player_local_temp, local_humidity,
                                              bp_windpower );
 
         static const auto is_lower = []( const bodypart_id & bp ) {
@@ -555,8 +561,7 @@ void Character::update_bodytemp()
         // Change the ambient temperature into a delta based on our comfortable temperature.
         units::temperature_delta adjusted_temp = player_local_temp - ambient_norm;
         // If you're standing in water, air temperature is replaced by water temperature. No wind.
-        if( here.has_flag_ter( ter_furn_flag::TFLAG_DEEP_WATER, pos_bub() ) ||
-            ( here.has_flag_ter( ter_furn_flag::TFLAG_SHALLOW_WATER, pos_bub() ) && is_lower( bp ) ) ) {
+        if( in_deep_water || ( in_shallow_water && is_lower( bp ) ) ) {
             adjusted_temp = water_temperature - ambient_norm; // Swap out air temp for water temp.
             windchill = 0_C_delta;
         }
@@ -594,7 +599,6 @@ void Character::update_bodytemp()
         }
         blister_count += radiation_blister_count;
 
-        const bool pyromania = has_trait( trait_PYROMANIA );
         // BLISTERS : Skin gets blisters from intense heat exposure.
         // Fire protection protects from blisters.
         // Heatsinks give near-immunity.
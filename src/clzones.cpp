@@ -965,12 +965,15 @@ void zone_manager::cache_vzones( map *pmap )
     }
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set( const zone_type_id &type,
-        const faction_id &fac ) const
+// Returned for the zone types that have no points cached.
+static const std::unordered_set<tripoint_abs_ms> empty_point_set;
+
+const std::unordered_set<tripoint_abs_ms> &zone_manager::get_point_set(
+    const zone_type_id &type, const faction_id &fac ) const
 {
     const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
+        return empty_point_set;
     }
 
     return type_iter->second;
@@ -1024,13 +1027,13 @@ std::unordered_set<tripoint_bub_ms> zone_manager::get_point_set_loot( const trip
     return res;
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_vzone_set( const zone_type_id &type,
-        const faction_id &fac ) const
+const std::unordered_set<tripoint_abs_ms> &zone_manager::get_vzone_set(
+    const zone_type_id &type, const faction_id &fac ) const
 {
     //Only regenerate the vehicle zone cache if any vehicles have moved
     const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
+        return empty_point_set;
     }
 
     return type_iter->second;
@@ -1110,9 +1113,19 @@ bool zone_manager::has_loot_dest_near( const tripoint_abs_ms &where ) const
 const zone_data *zone_manager::get_zone_at( const tripoint_abs_ms &where,
         const zone_type_id &type, const faction_id &fac ) const
 {
-    std::vector<zone_data const *> ret = get_zones_at( where, type, fac );
-    if( !ret.empty() ) {
-        return ret.front();
+    auto const check = [&type, &fac, &where]( zone_data const & z ) {
+        return z.has_inside( where ) && z.get_type() == type && z.get_faction() == fac;
+    };
+    for( const zone_data &zone : zones ) {
+        if( check( zone ) ) {
+            return &zone;
+        }
+    }
+    map &here = get_map();
+    for( const zone_data *zone : here.get_vehicle_zones( here.get_abs_sub().z() ) ) {
+        if( check( *zone ) ) {
+            return zone;
+        }
     }
 
     return nullptr;
@@ -1197,6 +1210,25 @@ std::unordered_set<tripoint_abs_ms> zone_manager::get_near( const zone_type_id &
     return near_point_set;
 }
 
+bool zone_manager::has_near_for_item( const zone_type_id &type, const tripoint_abs_ms &where,
+                                      int range, const item &it, const faction_id &fac ) const
+{
+    for( const tripoint_abs_ms &point : get_point_set( type, fac ) ) {
+        if( square_dist( point, where ) <= range && custom_loot_has( point, &it, type, fac ) ) {
+            return true;
+        }
+    }
+
+    for( const tripoint_abs_ms &point : get_vzone_set( type, fac ) ) {
+        if( point.z() == where.z() && square_dist( point, where ) <= range &&
+            custom_loot_has( point, &it, type, fac ) ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &type,
         const tripoint_abs_ms &where, int range, const faction_id &fac ) const
 {
@@ -1240,15 +1272,11 @@ zone_type_id zone_manager::get_near_zone_type_for_item( const item &it,
 {
     const item_category &cat = it.get_category_of_contents();
 
-    if( has_near( zone_type_LOOT_CUSTOM, where, range, fac ) ) {
-        if( !get_near( zone_type_LOOT_CUSTOM, where, range, &it, fac ).empty() ) {
-            return zone_type_LOOT_CUSTOM;
-        }
+    if( has_near_for_item( zone_type_LOOT_CUSTOM, where, range, it, fac ) ) {
+        return zone_type_LOOT_CUSTOM;
     }
-    if( has_near( zone_type_LOOT_ITEM_GROUP, where, range, fac ) ) {
-        if( !get_near( zone_type_LOOT_ITEM_GROUP, where, range, &it, fac ).empty() ) {
-            return zone_type_LOOT_ITEM_GROUP;
-        }
+    if( has_near_for_item( zone_type_LOOT_ITEM_GROUP, where, range, it, fac ) ) {
+        return zone_type_LOOT_ITEM_GROUP;
     }
     if( it.has_flag( STATIC( flag_id( "FIREWOOD" ) ) ) ) {
         if( has_near( zone_type_LOOT_WOOD, where, range, fac ) ) {
@@ -1357,9 +1385,8 @@ const zone_data *zone_manager::get_zone_at( const tripoint_abs_ms &where, bool l
     map &here = get_map();
 
     auto const check = [&fac, loot_only, &where]( zone_data const & z ) {
-        return z.get_faction() == fac &&
-               ( !loot_only || z.get_type().str().substr( 0, 4 ) == "LOOT" ) &&
-               z.has_inside( where );
+        return z.has_inside( where ) && z.get_faction() == fac &&
+               ( !loot_only || string_starts_with( z.get_type().str(), "LOOT" ) );
     };
     for( auto it = zones.rbegin(); it != zones.rend(); ++it ) {
         if( check( *it ) ) {
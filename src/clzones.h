@@ -565,10 +565,14 @@ class zone_manager
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> vzone_cache;
-        std::unordered_set<tripoint_abs_ms> get_point_set( const zone_type_id &type,
+        const std::unordered_set<tripoint_abs_ms> &get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint_abs_ms> get_vzone_set( const zone_type_id &type,
+        const std::unordered_set<tripoint_abs_ms> &get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
+        // Whether a custom or item group loot zone in range accepts the item, like
+        // !get_near( type, where, range, &it, fac ).empty() without collecting the points.
+        bool has_near_for_item( const zone_type_id &type, const tripoint_abs_ms &where, int range,
+                                const item &it, const faction_id &fac ) const;
     public:
         zone_manager();
         ~zone_manager() = default;
@@ -0,0 +1,337 @@
+#include "compression_dictionary.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <system_error>
+#include <utility>
+
+#include <zstd/zstd.h>
+
+#include "cata_scope_helpers.h"
+#include "cata_utility.h"
+#include "path_info.h"
+#include "save_writer.h"
+#include "translations.h"
+#include "zzip.h"
+
+namespace
+{
+
+constexpr size_t kNumKinds = static_cast<size_t>( compression_kind::last );
+
+// Reservoir of samples kept per kind, and how much of each sample is kept.
+constexpr size_t kMaxSamples = 256;
+constexpr size_t kMaxSampleSize = 16 * 1024;
+// Samples offered since the last training before training again.
+constexpr uint64_t kSamplesBetweenTrainings = 2048;
+constexpr size_t kMinSamples = 32;
+constexpr size_t kDictionarySize = 64 * 1024;
+// Every this many samples is held back to compare the new dictionary with the current one.
+constexpr size_t kHoldOutEvery = 4;
+// How much smaller the held back samples must get for the new dictionary to be used.
+constexpr double kRequiredGain = 0.98;
+// Same as the contexts zzip compresses with.
+constexpr int kCompressionLevel = 7;
+
+const std::array<const char *, kNumKinds> dictionary_names = {
+    "maps.dict", "overmaps.dict", "mmr.dict"
+};
+
+struct kind_state {
+    uint32_t version = 0;
+    std::vector<std::string> samples;
+    // Samples offered since the reservoir was last emptied.
+    uint64_t offered = 0;
+    bool training = false;
+};
+
+struct dictionaries_state {
+    std::string world;
+    std::array<kind_state, kNumKinds> kinds;
+    std::minstd_rand rng;
+};
+
+std::mutex state_mutex;
+dictionaries_state state;
+
+std::filesystem::path base_dictionary_path( compression_kind kind )
+{
+    return ( PATH_INFO::world_base_save_path() / dictionary_names[static_cast<size_t>( kind )] )
+           .get_unrelative_path();
+}
+
+// The newest version of the dictionary found on disk.
+uint32_t newest_version( const std::filesystem::path &base )
+{
+    uint32_t newest = 0;
+    std::error_code ec;
+    for( const std::filesystem::directory_entry &entry :
+         std::filesystem::directory_iterator( base.parent_path(), ec ) ) {
+        const uint32_t version = zzip::dictionary_version( entry.path() );
+        if( version > newest && zzip::dictionary_version_path( base, version ) == entry.path() ) {
+            newest = version;
+        }
+    }
+    return newest;
+}
+
+// Starts over when another world was loaded.  Requires state_mutex.
+void ensure_world_state()
+{
+    const std::string world = PATH_INFO::world_base_save_path().generic_u8string();
+    if( state.world == world ) {
+        return;
+    }
+    state.world = world;
+    for( size_t i = 0; i < kNumKinds; ++i ) {
+        state.kinds[i] = kind_state();
+        state.kinds[i].version = newest_version( base_dictionary_path( static_cast<compression_kind>
+                                 ( i ) ) );
+    }
+}
+
+// Trains a new version from the samples and installs it if it does better than the current one.
+void train_version( compression_kind kind, const std::string &world,
+                    const std::filesystem::path &current_path, const std::filesystem::path &next_path,
+                    uint32_t next_version, std::vector<std::string> samples )
+{
+    std::vector<std::string> training;
+    std::vector<std::string> held_out;
+    for( size_t i = 0; i < samples.size(); ++i ) {
+        ( i % kHoldOutEvery == 0 ? held_out : training ).emplace_back( std::move( samples[i] ) );
+    }
+    const std::string candidate = compression_dictionary::train( training, kDictionarySize );
+    const std::string current = read_whole_file( current_path ).value_or( std::string() );
+    if( candidate.empty() || compression_dictionary::compressed_size( held_out, candidate ) >=
+        compression_dictionary::compressed_size( held_out, current ) * kRequiredGain ) {
+        return;
+    }
+    write_to_file( next_path, [&]( std::ostream & fout ) {
+        fout << candidate;
+    } );
+    std::lock_guard<std::mutex> lk( state_mutex );
+    kind_state &ks = state.kinds[static_cast<size_t>( kind )];
+    if( state.world == world ) {
+        ks.version = std::max( ks.version, next_version );
+    }
+}
+
+} // namespace
+
+std::filesystem::path compression_dictionary::current( compression_kind kind )
+{
+    std::lock_guard<std::mutex> lk( state_mutex );
+    ensure_world_state();
+    const std::filesystem::path base = base_dictionary_path( kind );
+    kind_state &ks = state.kinds[static_cast<size_t>( kind )];
+    std::filesystem::path path = zzip::dictionary_version_path( base, ks.version );
+    std::error_code ec;
+    if( std::filesystem::exists( path, ec ) ) {
+        return path;
+    }
+    // Deleted behind our back, e.g. by decompressing the world.
+    ks.version = newest_version( base );
+    path = zzip::dictionary_version_path( base, ks.version );
+    if( std::filesystem::exists( path, ec ) ) {
+        return path;
+    }
+    return {};
+}
+
+void compression_dictionary::reset()
+{
+    {
+        std::lock_guard<std::mutex> lk( state_mutex );
+        state.world.clear();
+        for( kind_state &ks : state.kinds ) {
+            // Trainings in flight clear their own flag, and only install their version if
+            // the same world is still loaded.
+            const bool training = ks.training;
+            ks = kind_state();
+            ks.training = training;
+        }
+    }
+    zzip::invalidate_dictionary_cache();
+}
+
+void compression_dictionary::add_sample( compression_kind kind, std::string_view data )
+{
+    if( data.empty() ) {
+        return;
+    }
+    data = data.substr( 0, kMaxSampleSize );
+    std::lock_guard<std::mutex> lk( state_mutex );
+    kind_state &ks = state.kinds[static_cast<size_t>( kind )];
+    ++ks.offered;
+    if( ks.samples.size() < kMaxSamples ) {
+        ks.samples.emplace_back( data );
+        return;
+    }
+    // Keep a uniform choice among everything offered, not just the start of the session.
+    const uint64_t slot = std::uniform_int_distribution<uint64_t>( 0, ks.offered - 1 )( state.rng );
+    if( slot < kMaxSamples ) {
+        ks.samples[slot].assign( data );
+    }
+}
+
+void compression_dictionary::retrain_if_due()
+{
+    std::lock_guard<std::mutex> lk( state_mutex );
+    ensure_world_state();
+    for( size_t i = 0; i < kNumKinds; ++i ) {
+        kind_state &ks = state.kinds[i];
+        if( ks.training || ks.offered < kSamplesBetweenTrainings || ks.samples.size() < kMinSamples ) {
+            continue;
+        }
+        const compression_kind kind = static_cast<compression_kind>( i );
+        const std::filesystem::path base = base_dictionary_path( kind );
+        const uint32_t next_version = ks.version + 1;
+        const std::filesystem::path current_path = zzip::dictionary_version_path( base, ks.version );
+        const std::filesystem::path next_path = zzip::dictionary_version_path( base, next_version );
+        ks.training = true;
+        ks.offered = 0;
+        get_save_writer().enqueue( next_path.generic_u8string(), _( "compression dictionary" ),
+                                   [kind, world = state.world, current_path, next_path, next_version,
+                                            samples = std::move( ks.samples )]() mutable {
+            on_out_of_scope done( [kind]() {
+                std::lock_guard<std::mutex> lk( state_mutex );
+                state.kinds[static_cast<size_t>( kind )].training = false;
+            } );
+            train_version( kind, world, current_path, next_path, next_version, std::move( samples ) );
+        } );
+        ks.samples.clear();
+    }
+}
+
+std::string compression_dictionary::train( const std::vector<std::string> &samples,
+        const size_t capacity )
+{
+    // Segments are picked by how many samples share the d byte strings (dmers) they contain,
+    // following the fast cover algorithm of zstd's dictionary builder.
+    constexpr size_t dmer_size = 8;
+    constexpr size_t segment_size = 256;
+    constexpr int hash_bits = 20;
+    constexpr uint64_t hash_prime = 0xCF1BBCDCB7A56463ULL;
+
+    std::string data;
+    std::vector<size_t> sample_ends;
+    for( const std::string &sample : samples ) {
+        data += sample;
+        sample_ends.push_back( data.size() );
+    }
+    if( data.size() < segment_size + dmer_size ) {
+        return data.substr( 0, capacity );
+    }
+    const auto hash_at = [&data]( size_t pos ) {
+        uint64_t dmer = 0;
+        memcpy( &dmer, data.data() + pos, dmer_size );
+        return static_cast<size_t>( ( dmer * hash_prime ) >> ( 64 - hash_bits ) );
+    };
+
+    // In how many samples each dmer occurs.
+    std::vector<uint32_t> freqs( size_t{ 1 } << hash_bits, 0 );
+    {
+        std::vector<uint32_t> last_sample( freqs.size(), 0 );
+        size_t begin = 0;
+        for( size_t s = 0; s < sample_ends.size(); ++s ) {
+            for( size_t pos = begin; pos + dmer_size <= sample_ends[s]; ++pos ) {
+                const size_t h = hash_at( pos );
+                if( last_sample[h] != s + 1 ) {
+                    last_sample[h] = s + 1;
+                    ++freqs[h];
+                }
+            }
+            begin = sample_ends[s];
+        }
+    }
+
+    // The best segment of each epoch is picked in turn until the dictionary is full.
+    const size_t num_dmers = data.size() - dmer_size + 1;
+    const size_t window = segment_size - dmer_size + 1;
+    const size_t epochs = std::max<size_t>( 1, std::min( capacity / segment_size,
+                                            num_dmers / segment_size ) );
+    const size_t epoch_size = num_dmers / epochs;
+    std::vector<uint16_t> in_window( freqs.size(), 0 );
+    std::string dictionary( capacity, '\0' );
+    size_t tail = capacity;
+    size_t fruitless_epochs = 0;
+    for( size_t epoch = 0; tail > 0 && fruitless_epochs < epochs; epoch = ( epoch + 1 ) % epochs ) {
+        const size_t begin = epoch * epoch_size;
+        const size_t end = epoch + 1 == epochs ? num_dmers : begin + epoch_size;
+        uint64_t score = 0;
+        uint64_t best_score = 0;
+        size_t best_begin = begin;
+        size_t window_begin = begin;
+        for( size_t pos = begin; pos < end; ++pos ) {
+            const size_t h = hash_at( pos );
+            // Each dmer only counts once per segment.
+            if( in_window[h]++ == 0 ) {
+                score += freqs[h];
+            }
+            if( pos - window_begin + 1 > window ) {
+                const size_t old = hash_at( window_begin++ );
+                if( --in_window[old] == 0 ) {
+                    score -= freqs[old];
+                }
+            }
+            if( pos - window_begin + 1 == window && score > best_score ) {
+                best_score = score;
+                best_begin = window_begin;
+            }
+        }
+        for( size_t pos = window_begin; pos < end; ++pos ) {
+            in_window[hash_at( pos )] = 0;
+        }
+        if( best_score == 0 ) {
+            ++fruitless_epochs;
+            continue;
+        }
+        fruitless_epochs = 0;
+        // What the segment covers is not worth anything to the next ones.
+        for( size_t pos = best_begin; pos < best_begin + window; ++pos ) {
+            freqs[hash_at( pos )] = 0;
+        }
+        const size_t len = std::min( segment_size, tail );
+        tail -= len;
+        memcpy( &dictionary[tail], data.data() + best_begin, len );
+    }
+    dictionary.erase( 0, tail );
+
+    // zstd would take a dictionary starting with its magic number for a trained one.
+    uint32_t magic = 0;
+    if( dictionary.size() >= sizeof( magic ) ) {
+        memcpy( &magic, dictionary.data(), sizeof( magic ) );
+        if( magic == ZSTD_MAGIC_DICTIONARY ) {
+            dictionary.erase( 0, 1 );
+        }
+    }
+    return dictionary;
+}
+
+size_t compression_dictionary::compressed_size( const std::vector<std::string> &samples,
+        std::string_view dictionary )
+{
+    ZSTD_CCtx *cctx = ZSTD_createCCtx();
+    on_out_of_scope free_cctx( [cctx]() {
+        ZSTD_freeCCtx( cctx );
+    } );
+    ZSTD_CCtx_setParameter( cctx, ZSTD_c_compressionLevel, kCompressionLevel );
+    if( !dictionary.empty() ) {
+        ZSTD_CCtx_loadDictionary( cctx, dictionary.data(), dictionary.size() );
+    }
+    size_t total = 0;
+    std::string buffer;
+    for( const std::string &sample : samples ) {
+        buffer.resize( ZSTD_compressBound( sample.size() ) );
+        const size_t size = ZSTD_compress2( cctx, buffer.data(), buffer.size(), sample.data(),
+                                            sample.size() );
+        total += ZSTD_isError( size ) ? sample.size() : size;
+    }
+    return total;
+}
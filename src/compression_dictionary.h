@@ -0,0 +1,52 @@
+#pragma once
+#ifndef CATA_SRC_COMPRESSION_DICTIONARY_H
+#define CATA_SRC_COMPRESSION_DICTIONARY_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The kinds of data in a compressed world, each with its own zstd dictionary.
+enum class compression_kind : int {
+    maps,
+    overmaps,
+    map_memory,
+    last
+};
+
+/**
+ * The zstd dictionaries of the active world.  A world starts with the dictionaries shipped
+ * with the game, and retrains them from samples of its own data as it is saved.  Each new
+ * version is kept next to the old ones (see zzip::dictionary_version_path) and is only used
+ * if it compresses the samples held back from training better than the current one.
+ * Entries move to the new version whenever they are written again.
+ */
+namespace compression_dictionary
+{
+
+// The dictionary new entries of this kind are compressed with.
+std::filesystem::path current( compression_kind kind );
+
+// Forget the dictionaries of the active world, for when a world is loaded or unloaded, or its
+// dictionaries were deleted or replaced.  They are found on disk again when next used.
+void reset();
+
+// Offer data that is about to be compressed as a sample for the next retraining.
+// Safe to call from any thread.
+void add_sample( compression_kind kind, std::string_view data );
+
+// Queue retraining on the save writer for every kind that gathered enough new samples.
+void retrain_if_due();
+
+// A raw content dictionary of at most capacity bytes, made of the segments that occur in the
+// most samples.  The most common segments go last, where zstd reaches them cheapest.
+std::string train( const std::vector<std::string> &samples, size_t capacity );
+
+// Total size of the samples compressed one by one with the given dictionary.
+size_t compressed_size( const std::vector<std::string> &samples, std::string_view dictionary );
+
+} // namespace compression_dictionary
+
+#endif // CATA_SRC_COMPRESSION_DICTIONARY_H
@@ -625,7 +625,7 @@ struct project_to_impl<0, ScaleDown, ResultScale> {
     coord_point_ob<Point, Origin, ResultScale> CATA_FORCEINLINE operator()(
         const coord_point_ob<Point, Origin, SourceScale> src ) {
         return coord_point_ob<Point, Origin, ResultScale>(
-                   divide_xy_round_to_minus_infinity( src.raw(), ScaleDown ) );
+                   divide_xy_round_to_minus_infinity<ScaleDown>( src.raw() ) );
     }
 
     template<typename Point, origin Origin, scale SourceScale>
@@ -635,7 +635,7 @@ struct project_to_impl<0, ScaleDown, ResultScale> {
         //
         // They are also guaranteed to be >= 0, so we can use a more effecient method of scaling.
         return coord_point_ib<Point, Origin, ResultScale>::make_unchecked(
-                   divide_xy_round_to_minus_infinity_non_negative( src.raw(), ScaleDown ) );
+                   divide_xy_round_to_minus_infinity_non_negative<ScaleDown>( src.raw() ) );
     }
 };
 
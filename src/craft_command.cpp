@@ -351,15 +351,16 @@ bool craft_command::continue_prompt_liquids( const std::function<bool( const ite
 }
 
 static std::list<item> sane_consume_items( const comp_selection<item_comp> &it, Character *crafter,
-        int batch, const std::function<bool( const item & )> &filter )
+        int batch, const std::function<bool( const item & )> &filter,
+        const std::vector<tripoint_bub_ms> &reachable_pts )
 {
     map &m = get_map();
-    const std::vector<pocket_data> it_pkt = it.comp.type->pockets;
+    const std::vector<pocket_data> &it_pkt = it.comp.type->pockets;
     if( ( item::count_by_charges( it.comp.type ) && it.comp.count > 0 ) ||
     !std::any_of( it_pkt.begin(), it_pkt.end(), []( const pocket_data & p ) {
     return p.type == pocket_type::CONTAINER && p.watertight;
 } ) ) {
-        std::list<item> consumed = crafter->consume_items( it, batch, filter );
+        std::list<item> consumed = crafter->consume_items( m, it, batch, filter, reachable_pts );
         return consumed;
     }
 
@@ -378,7 +379,7 @@ static std::list<item> sane_consume_items( const comp_selection<item_comp> &it,
                     if( rl_dist( loc, p ) >= radius ) {
                         std::list<item> tmp = m.use_amount_square( p, it.comp.type, real_count,
                                               i == 0 ? empty_filter : filter );
-                        ret.insert( ret.end(), tmp.begin(), tmp.end() );
+                        ret.splice( ret.end(), tmp );
                     }
                 }
             }
@@ -387,7 +388,7 @@ static std::list<item> sane_consume_items( const comp_selection<item_comp> &it,
             std::list<item> tmp = crafter->use_amount( it.comp.type, real_count,
                                   i == 0 ? empty_filter : filter );
             real_count -= tmp.size();
-            ret.insert( ret.end(), tmp.begin(), tmp.end() );
+            ret.splice( ret.end(), tmp );
         }
     }
     return ret;
@@ -453,8 +454,11 @@ item craft_command::create_in_progress_craft()
         return item();
     }
 
+    // Taking the components does not change which tiles can be reached, so they are found once.
+    const std::vector<tripoint_bub_ms> reachable_pts = get_map().reachable_flood_steps(
+                crafter->pos_bub(), PICKUP_RANGE, 1, 100 );
     for( const auto &it : item_selections ) {
-        std::list<item> tmp = sane_consume_items( it, crafter, batch_size, filter );
+        std::list<item> tmp = sane_consume_items( it, crafter, batch_size, filter, reachable_pts );
         for( item &tmp_it : tmp ) {
             if( safe_to_unload_comp( tmp_it ) ) {
                 item_location tmp_loc( *crafter, &tmp_it );
@@ -1689,8 +1689,11 @@ bool Character::can_continue_craft( item &craft, const requirement_data &continu
             }
             item_selections.push_back( is );
         }
+        map &here = get_map();
+        const std::vector<tripoint_bub_ms> reachable_pts = here.reachable_flood_steps( pos_bub(),
+                PICKUP_RANGE, 1, 100 );
         for( const auto &it : item_selections ) {
-            for( item &itm : consume_items( it, batch_size, filter ) ) {
+            for( item &itm : consume_items( here, it, batch_size, filter, reachable_pts ) ) {
                 craft.components.add( itm );
             }
         }
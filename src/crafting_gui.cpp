@@ -241,15 +241,24 @@ struct availability {
                 can_craft = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
                             req.can_make_with_inventory( inv, all_items_filter, batch_size, craft_flags::start_only );
             }
-            would_use_rotten = !req.can_make_with_inventory( inv, no_rotten_filter, batch_size,
-                               craft_flags::start_only );
-            would_use_favorite = !req.can_make_with_inventory( inv, no_favorite_filter, batch_size,
-                                 craft_flags::start_only );
+            // Each of these searches the inventory again, and only tells something about
+            // recipes that can or cannot be crafted, respectively.
+            if( can_craft ) {
+                would_use_rotten = !req.can_make_with_inventory( inv, no_rotten_filter, batch_size,
+                                   craft_flags::start_only );
+                would_use_favorite = !req.can_make_with_inventory( inv, no_favorite_filter, batch_size,
+                                     craft_flags::start_only );
+                apparently_craftable = true;
+            } else {
+                would_use_rotten = false;
+                would_use_favorite = false;
+                const requirement_data &simple_req = r->simple_requirements();
+                apparently_craftable = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
+                                       simple_req.can_make_with_inventory( inv, all_items_filter, batch_size,
+                                               craft_flags::start_only );
+            }
             useless_practice = r->is_practice() && cannot_gain_skill_or_prof( crafter, *r );
             is_nested_category = r->is_nested();
-            const requirement_data &simple_req = r->simple_requirements();
-            apparently_craftable = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
-                                   simple_req.can_make_with_inventory( inv, all_items_filter, batch_size, craft_flags::start_only );
             for( const auto& [skill, skill_lvl] : r->required_skills ) {
                 if( crafter.get_skill_level( skill ) < skill_lvl ) {
                     has_all_skills = false;
@@ -57,6 +57,7 @@
 #include "npc.h"
 #include "options.h"
 #include "output.h"
+#include "pathfinding.h"
 #include "point.h"
 #include "projectile.h"
 #include "ret_val.h"
@@ -3546,6 +3547,50 @@ tripoint_abs_omt Creature::pos_abs_omt() const
     return project_to<coords::omt>( location );
 }
 
+// How far the target of a planned route may move before the route is planned from scratch.
+static constexpr int max_reused_path_displacement = 3;
+
+bool Creature::reuse_path( std::vector<tripoint_bub_ms> &path, const tripoint_bub_ms &t,
+                           const pathfinding_settings &settings,
+                           const std::function<bool( const tripoint_bub_ms & )> &avoid ) const
+{
+    const tripoint_bub_ms pos = pos_bub();
+    if( path.empty() || path_generation < 0 || !( settings == *path_settings ) ||
+        t.z() != pos.z() || path.back().z() != pos.z() || rl_dist( pos, path.front() ) > 1 ) {
+        return false;
+    }
+    const int displacement = rl_dist( path.back(), t );
+    const map &here = get_map();
+    if( displacement > max_reused_path_displacement ||
+        !here.route_unchanged_since( path, path_generation ) ) {
+        return false;
+    }
+    const std::vector<tripoint_bub_ms>::iterator reaches_t = std::find( path.begin(), path.end(), t );
+    if( reaches_t != path.end() ) {
+        // The target moved onto the route
+        path.erase( reaches_t + 1, path.end() );
+        return true;
+    }
+    // Plan again from where the old end of the route may start bending away from t
+    const size_t keep = path.size() > static_cast<size_t>( 2 * displacement ) ?
+                        path.size() - 2 * displacement : 0;
+    const tripoint_bub_ms from = keep == 0 ? pos : path[keep - 1];
+    const std::vector<tripoint_bub_ms> end = here.route( from, pathfinding_target::point( t ),
+            settings, avoid );
+    if( end.empty() ) {
+        return false;
+    }
+    path.resize( keep );
+    path.insert( path.end(), end.begin(), end.end() );
+    return true;
+}
+
+void Creature::mark_path_planned( const pathfinding_settings &settings )
+{
+    path_generation = get_map().get_pathfinding_generation( posz() );
+    *path_settings = settings;
+}
+
 std::unique_ptr<talker> get_talker_for( Creature &me )
 {
     if( me.is_monster() ) {
@@ -972,6 +972,18 @@ class Creature : public viewer
         virtual const pathfinding_settings &get_pathfinding_settings() const = 0;
         /** Returns a set of points we do not want to path through. */
         virtual std::function<bool( const tripoint_bub_ms & )> get_path_avoid() const = 0;
+        /**
+         * Adapts the planned route `path` to a target at t instead of planning a new one, if
+         * it was planned with the same settings, none of its tiles changed in the pathfinding
+         * cache since mark_path_planned and its end is at most a few tiles from t.  Only the end
+         * of the route is planned again.
+         * Returns false if a new route has to be planned from scratch.
+         */
+        bool reuse_path( std::vector<tripoint_bub_ms> &path, const tripoint_bub_ms &t,
+                         const pathfinding_settings &settings,
+                         const std::function<bool( const tripoint_bub_ms & )> &avoid ) const;
+        // Call after planning a new route with settings to allow reuse_path on it.
+        void mark_path_planned( const pathfinding_settings &settings );
 
         bool underwater;
         void draw( const catacurses::window &w, const point_bub_ms &origin, bool inverted ) const;
@@ -1351,6 +1363,10 @@ class Creature : public viewer
         void load( const JsonObject &jsin );
 
     private:
+        // Pathfinding cache generation at the last mark_path_planned, -1 before the first.
+        int path_generation = -1; // NOLINT(cata-serialize)
+        // The settings the route was planned with at the last mark_path_planned.
+        pimpl<pathfinding_settings> path_settings; // NOLINT(cata-serialize)
         int pain;
         // calculate how well the projectile hits
         double accuracy_projectile_attack( const int &speed, const double &missed_by ) const;
@@ -9,6 +9,7 @@
 
 #include "avatar.h"
 #include "cata_assert.h"
+#include "cata_utility.h"
 #include "debug.h"
 #include "flood_fill.h"
 #include "game.h"
@@ -94,6 +95,8 @@ bool creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
 
     monsters_list.emplace_back( critter_ptr );
     monsters_by_location[critter.pos_abs()] = critter_ptr;
+    // The zones only list the creatures that were there when they were filled.
+    invalidate_reachability_cache();
     return true;
 }
 
@@ -177,6 +180,37 @@ void creature_tracker::remove( const monster &critter )
     remove_from_location_map( critter );
     removed_this_turn_.emplace( *iter );
     monsters_list.erase( iter );
+    // Whatever is placed at its address next must not get its answers.
+    erase_if( sees_memo_, [&critter]( const auto & entry ) {
+        return entry.first.first == &critter || entry.first.second == &critter;
+    } );
+}
+
+bool creature_tracker::sees( const map &here, const Creature &observer, const Creature &target )
+{
+    const uint64_t generation = here.get_vision_generation();
+    if( calendar::turn != sees_memo_turn_ || generation != sees_memo_generation_ ) {
+        // None of the answers can be reused, keeping them would only grow the memo.
+        sees_memo_.clear();
+        sees_memo_turn_ = calendar::turn;
+        sees_memo_generation_ = generation;
+    }
+    sees_memo_entry now;
+    now.observer_pos = observer.pos_abs();
+    now.target_pos = target.pos_abs();
+    now.observer_moves = observer.get_moves();
+    now.target_moves = target.get_moves();
+    const auto [iter, inserted] = sees_memo_.try_emplace( { &observer, &target }, now );
+    sees_memo_entry &memo = iter->second;
+    if( !inserted && memo.observer_pos == now.observer_pos && memo.target_pos == now.target_pos &&
+        memo.observer_moves == now.observer_moves && memo.target_moves == now.target_moves ) {
+        ++sees_stats_.hits;
+        return memo.sees;
+    }
+    ++sees_stats_.misses;
+    now.sees = observer.sees( here, target );
+    memo = now;
+    return memo.sees;
 }
 
 void creature_tracker::clear()
@@ -185,6 +219,7 @@ void creature_tracker::clear()
     monsters_by_location.clear();
     removed_this_turn_.clear();
     creatures_by_zone_and_faction_.clear();
+    sees_memo_.clear();
     invalidate_reachability_cache();
 }
 
@@ -264,6 +299,13 @@ bool creature_tracker::kill_marked_for_death()
     // Important: `Creature::die` must not be called after creature objects (NPCs, monsters) have
     // been removed, the dying creature could still have a pointer (the killer) to another creature.
     bool monster_is_dead = false;
+    // Most turns nobody died, which needs no copy of the list below.
+    if( std::none_of( monsters_list.begin(), monsters_list.end(),
+    []( const shared_ptr_fast<monster> &mon_ptr ) {
+        return mon_ptr->is_dead();
+    } ) ) {
+        return false;
+    }
     // Copy the list so we can iterate the copy safely *and* add new monsters from within monster::die
     // This happens for example with blob monsters (they split into two smaller monsters).
     const auto copy = monsters_list;
@@ -286,16 +328,22 @@ bool creature_tracker::kill_marked_for_death()
 void creature_tracker::remove_dead()
 {
     // Can't use game::all_monsters() as it would not contain *dead* monsters.
-    for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ) {
+    // The living are moved down over the dead in one pass, keeping their order.
+    auto kept = monsters_list.begin();
+    for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ++iter ) {
         monster *const critter = iter->get();
         if( critter->is_dead() ) {
             remove_from_location_map( *critter );
-            iter = monsters_list.erase( iter );
         } else {
-            ++iter;
+            if( kept != iter ) {
+                *kept = std::move( *iter );
+            }
+            ++kept;
         }
     }
+    monsters_list.erase( kept, monsters_list.end() );
     removed_this_turn_.clear();
+    sees_memo_.clear();
 }
 
 template<typename T>
@@ -307,7 +355,11 @@ T *creature_tracker::creature_at( const tripoint_bub_ms &p, bool allow_hallucina
 template<typename T>
 T *creature_tracker::creature_at( const tripoint_abs_ms &p, bool allow_hallucination )
 {
-    if( const shared_ptr_fast<monster> mon_ptr = find( p ) ) {
+    // Looked up without find, which would copy the shared pointer on this hot path.
+    const auto mon_iter = monsters_by_location.find( p );
+    monster *const mon_ptr = mon_iter != monsters_by_location.end() ? mon_iter->second.get() :
+                             nullptr;
+    if( mon_ptr && !mon_ptr->is_dead() ) {
         if( !allow_hallucination && mon_ptr->is_hallucination() ) {
             return nullptr;
         }
@@ -321,7 +373,7 @@ T *creature_tracker::creature_at( const tripoint_abs_ms &p, bool allow_hallucina
         if( !mon_ptr->has_effect( effect_ridden ) || ( std::is_same<T, monster>::value ||
                 std::is_same<T, Creature>::value || std::is_same<T, const monster>::value ||
                 std::is_same<T, const Creature>::value ) ) {
-            return dynamic_cast<T *>( mon_ptr.get() );
+            return dynamic_cast<T *>( mon_ptr );
         }
     }
     if( !std::is_same<T, npc>::value && !std::is_same<T, const npc>::value ) {
@@ -3,6 +3,7 @@
 #define CATA_SRC_CREATURE_TRACKER_H
 
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <unordered_map>
@@ -10,14 +11,17 @@
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "coordinates.h"
 #include "creature.h"
+#include "hash_utils.h"
 #include "memory_fast.h"
 #include "type_id.h"
 
 class JsonArray;
 class JsonOut;
 class game;
+class map;
 class monster;
 class npc;
 
@@ -96,6 +100,7 @@ class creature_tracker
         void clear();
         void clear_npcs() {
             active_npc.clear();
+            sees_memo_.clear();
         }
         /** Swaps the positions of two monsters */
         void swap_positions( monster &first, monster &second );
@@ -123,6 +128,25 @@ class creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Returns whether @p observer sees @p target, remembering the answer for the turn.
+         * It is asked again once either of them moved or spent moves.  All answers are
+         * forgotten when the turn or the vision generation of the map changes.
+         */
+        bool sees( const map &here, const Creature &observer, const Creature &target );
+
+        struct sees_memo_stats {
+            size_t hits = 0;
+            size_t misses = 0;
+        };
+        // How often @ref sees answered from the memo, since the start of the game.
+        const sees_memo_stats &get_sees_memo_stats() const {
+            return sees_stats_;
+        }
+        size_t sees_memo_size() const {
+            return sees_memo_.size();
+        }
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( const JsonArray &ja );
 
@@ -164,6 +188,22 @@ class creature_tracker
         std::unordered_map<int, std::unordered_map<mfaction_id, std::vector<shared_ptr_fast<Creature>>>>
         creatures_by_zone_and_faction_;  // NOLINT(cata-serialize)
 
+        struct sees_memo_entry {
+            tripoint_abs_ms observer_pos;
+            tripoint_abs_ms target_pos;
+            int observer_moves = 0;
+            int target_moves = 0;
+            bool sees = false;
+        };
+        // Answers of sees, by observer and target.  The answers of a creature are dropped
+        // whenever it goes away, so the pointers never dangle.
+        std::unordered_map<std::pair<const Creature *, const Creature *>, sees_memo_entry,
+            cata::tuple_hash> sees_memo_;  // NOLINT(cata-serialize)
+        // The turn and map::get_vision_generation the answers in sees_memo_ are from.
+        time_point sees_memo_turn_;  // NOLINT(cata-serialize)
+        uint64_t sees_memo_generation_ = 0;  // NOLINT(cata-serialize)
+        sees_memo_stats sees_stats_;  // NOLINT(cata-serialize)
+
         friend game;
 };
 
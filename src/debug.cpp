@@ -109,6 +109,8 @@ static bool error_observed = false;
 static bool capturing = false;
 /** сaptured debug messages */
 static std::string captured;
+/** Where debugmsg calls on this thread go instead, see defer_debugmsg_during */
+static thread_local std::vector<deferred_debugmsg> *deferred_messages = nullptr;
 
 #if defined(_WIN32) and defined(LIBBACKTRACE)
 // Get the image base of a module from its PE header
@@ -203,6 +205,24 @@ capture_debugmsg::~capture_debugmsg()
     capturing = false;
 }
 
+void defer_debugmsg_during( const std::function<void()> &func,
+                            std::vector<deferred_debugmsg> &into )
+{
+    std::vector<deferred_debugmsg> *const outer = deferred_messages;
+    deferred_messages = &into;
+    on_out_of_scope restore( [outer]() {
+        deferred_messages = outer;
+    } );
+    func();
+}
+
+void report_deferred_debugmsg( const std::vector<deferred_debugmsg> &messages )
+{
+    for( const deferred_debugmsg &msg : messages ) {
+        realDebugmsg( msg.filename, msg.line, msg.funcname, msg.text );
+    }
+}
+
 bool debug_has_error_been_observed()
 {
     return error_observed;
@@ -517,6 +537,11 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     cata_assert( line != nullptr );
     cata_assert( funcname != nullptr );
 
+    if( deferred_messages != nullptr ) {
+        deferred_messages->push_back( { filename, line, funcname, text } );
+        return;
+    }
+
     if( capturing ) {
         captured += text;
     } else {
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "string_formatter.h"
 
@@ -216,6 +217,25 @@ bool debug_has_error_been_observed();
  */
 std::string capture_debugmsg_during( const std::function<void()> &func );
 
+// A debugmsg call kept to be reported later.  The pointers are to string literals.
+struct deferred_debugmsg {
+    const char *filename;
+    const char *line;
+    const char *funcname;
+    std::string text;
+};
+
+/**
+ * Runs func with the debugmsg calls it makes on this thread added to into instead of
+ * being reported, also if func throws.  Lets work on other threads have its messages
+ * reported by the main thread with report_deferred_debugmsg.
+ */
+void defer_debugmsg_during( const std::function<void()> &func,
+                            std::vector<deferred_debugmsg> &into );
+
+// Report messages kept by defer_debugmsg_during as if debugmsg was called now.
+void report_deferred_debugmsg( const std::vector<deferred_debugmsg> &messages );
+
 /**
  * Should be called after catacurses::stdscr is initialized.
  * If catacurses::stdscr is available, shows all buffered debugmsg prompts.
@@ -52,6 +52,7 @@
 #include "dialogue_chatbin.h"
 #include "dialogue_helpers.h"
 #include "display.h"
+#include "do_turn.h"
 #include "effect.h"
 #include "effect_on_condition.h"
 #include "enum_conversions.h"
@@ -65,6 +66,7 @@
 #include "global_vars.h"
 #include "imgui/imgui.h"
 #include "imgui_demo.h"
+#include "init.h"
 #include "input.h"
 #include "input_context.h"
 #include "input_enums.h"
@@ -81,6 +83,7 @@
 #include "map_iterator.h"
 #include "map_scale_constants.h"
 #include "mapgen.h"
+#include "mapbuffer.h"
 #include "mapgendata.h"
 #include "martialarts.h"
 #include "math_parser_diag_value.h"
@@ -264,6 +267,9 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::DISPLAY_TRANSPARENCY: return "DISPLAY_TRANSPARENCY";
         case debug_menu::debug_menu_index::DISPLAY_RADIATION: return "DISPLAY_RADIATION";
         case debug_menu::debug_menu_index::HOUR_TIMER: return "HOUR_TIMER";
+        case debug_menu::debug_menu_index::MEMORY_REPORT: return "MEMORY_REPORT";
+        case debug_menu::debug_menu_index::SAVE_LOAD_METRICS: return "SAVE_LOAD_METRICS";
+        case debug_menu::debug_menu_index::TURN_LATENCY: return "TURN_LATENCY";
         case debug_menu::debug_menu_index::CHANGE_SPELLS: return "CHANGE_SPELLS";
         case debug_menu::debug_menu_index::TEST_MAP_EXTRA_DISTRIBUTION: return "TEST_MAP_EXTRA_DISTRIBUTION";
         case debug_menu::debug_menu_index::NESTED_MAPGEN: return "NESTED_MAPGEN";
@@ -284,6 +290,7 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::TALK_TOPIC: return "TALK_TOPIC";
         case debug_menu::debug_menu_index::IMGUI_DEMO: return "IMGUI_DEMO";
         case debug_menu::debug_menu_index::VEHICLE_EFFECTS: return "VEHICLE_EFFECTS";
+        case debug_menu::debug_menu_index::RELOAD_DATA: return "RELOAD_DATA";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -886,6 +893,9 @@ static int info_uilist( bool display_all_entries = true )
         { uilist_entry( debug_menu_index::SAVE_SCREENSHOT, true, 'H', _( "Take screenshot" ) ) },
         { uilist_entry( debug_menu_index::GAME_REPORT, true, 'r', _( "Generate game report" ) ) },
         { uilist_entry( debug_menu_index::GAME_MIN_ARCHIVE, true, '!', _( "Generate minimized save archive" ) ) },
+        { uilist_entry( debug_menu_index::MEMORY_REPORT, true, 'o', _( "Estimate memory use" ) ) },
+        { uilist_entry( debug_menu_index::SAVE_LOAD_METRICS, true, 'O', _( "Show last save and load metrics" ) ) },
+        { uilist_entry( debug_menu_index::TURN_LATENCY, true, 'k', _( "Show turn latency and stalls" ) ) },
     };
 
     if( display_all_entries ) {
@@ -939,6 +949,7 @@ static int game_uilist()
         { uilist_entry( debug_menu_index::ACTIVATE_EOC, true, 'E', _( "Activate EOC" ) ) },
         { uilist_entry( debug_menu_index::QUIT_NOSAVE, true, 'Q', _( "Quit to main menu" ) )  },
         { uilist_entry( debug_menu_index::QUICKLOAD, true, 'q', _( "Quickload" ) )  },
+        { uilist_entry( debug_menu_index::RELOAD_DATA, true, 'r', _( "Reload changed data files" ) )  },
     };
 
     return uilist( _( "Game…" ), uilist_initializer );
@@ -3449,6 +3460,27 @@ static void game_report()
     popup( popup_msg );
 }
 
+// Estimates only: they count the objects and the buffers those own directly, not everything
+// they point to.
+static void memory_report()
+{
+    constexpr size_t mib = 1024 * 1024;
+    size_t monsters = 0;
+    for( const monster &critter : g->all_monsters() ) {
+        monsters += !critter.is_dead();
+    }
+    std::string report;
+    report += string_format( "submaps: %d, %d MiB\n", MAPBUFFER.submap_count(),
+                             MAPBUFFER.memory_estimate() / mib );
+    report += string_format( "overmaps: %d, %d MiB\n", overmap_buffer.loaded_overmap_count(),
+                             overmap_buffer.loaded_overmap_count() * sizeof( overmap ) / mib );
+    report += string_format( "map memory: %d MiB\n",
+                             get_avatar().map_memory_estimate() / mib );
+    report += string_format( "monsters: %d, %d MiB\n", monsters, monsters * sizeof( monster ) / mib );
+    DebugLog( DL_ALL, DC_ALL ) << " MEMORY REPORT:\n" << report;
+    popup( report );
+}
+
 static void generate_effect_list()
 {
     write_to_file( "effect_list.output", [&]( std::ostream & testfile ) {
@@ -3980,6 +4012,9 @@ void debug()
         debug_menu_index::SAVE_SCREENSHOT,
         debug_menu_index::GAME_REPORT,
         debug_menu_index::GAME_MIN_ARCHIVE,
+        debug_menu_index::MEMORY_REPORT,
+        debug_menu_index::SAVE_LOAD_METRICS,
+        debug_menu_index::TURN_LATENCY,
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::UNLOCK_ALL,
         debug_menu_index::BENCHMARK,
@@ -4376,6 +4411,20 @@ void debug()
         case debug_menu_index::GAME_REPORT:
             game_report();
             break;
+        case debug_menu_index::MEMORY_REPORT:
+            memory_report();
+            break;
+        case debug_menu_index::SAVE_LOAD_METRICS:
+            popup( g->describe_save_load_metrics() );
+            break;
+        case debug_menu_index::TURN_LATENCY: {
+            std::string report = turn_latency::describe();
+            if( turn_latency::write_to_file( "turn_latency.output" ) ) {
+                report += "\nThe recent turns were written to turn_latency.output.";
+            }
+            popup( report );
+            break;
+        }
         case debug_menu_index::GAME_MIN_ARCHIVE: {
             g->quicksave();
 
@@ -4488,6 +4537,18 @@ void debug()
             display_talk_topic();
             break;
 
+        case debug_menu_index::RELOAD_DATA:
+            try {
+                if( DynamicDataLoader::get_instance().reload_changed_data() ) {
+                    popup( _( "Reloaded the changed data files." ) );
+                } else {
+                    popup( _( "Only dialogue, ASCII art and dreams can be reloaded while playing.  Quit to the main menu and load the world again to reload the other changes." ) );
+                }
+            } catch( const std::exception &err ) {
+                popup( _( "Reloading failed: %s" ), err.what() );
+            }
+            break;
+
         case debug_menu_index::last:
             return;
     }
@@ -92,6 +92,9 @@ enum class debug_menu_index : int {
     DISPLAY_TRANSPARENCY,
     DISPLAY_RADIATION,
     HOUR_TIMER,
+    MEMORY_REPORT,
+    SAVE_LOAD_METRICS,
+    TURN_LATENCY,
     CHANGE_SPELLS,
     TEST_MAP_EXTRA_DISTRIBUTION,
     NESTED_MAPGEN,
@@ -117,6 +120,7 @@ enum class debug_menu_index : int {
     TALK_TOPIC,
     IMGUI_DEMO,
     VEHICLE_EFFECTS,
+    RELOAD_DATA,
     last
 };
 
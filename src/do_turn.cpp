@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <optional>
@@ -23,6 +24,7 @@
 #include "bionics.h"
 #include "cached_options.h"
 #include "calendar.h"
+#include "cata_utility.h"
 #include "cata_variant.h"
 #include "clzones.h"
 #include "coordinates.h"
@@ -56,6 +58,7 @@
 #include "output.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "perf.h"
 #include "pimpl.h"
 #include "player_activity.h"
 #include "point.h"
@@ -78,6 +81,7 @@
 #include "weather.h"
 #include "weather_type.h"
 #include "worldfactory.h"
+#include "zzip_maintenance.h"
 
 static const activity_id ACT_AUTODRIVE( "ACT_AUTODRIVE" );
 static const activity_id ACT_FIRSTAID( "ACT_FIRSTAID" );
@@ -94,6 +98,11 @@ static const event_statistic_id event_statistic_last_words( "last_words" );
 
 static const trait_id trait_HAS_NEMESIS( "HAS_NEMESIS" );
 
+static const option_handle<bool> option_autosave( "AUTOSAVE" );
+static const option_handle<int> option_autosave_turns( "AUTOSAVE_TURNS" );
+static const option_handle<bool> option_force_redraw( "FORCE_REDRAW" );
+static const option_handle<bool> option_wander_spawns( "WANDER_SPAWNS" );
+
 #if defined(__ANDROID__)
 extern std::map<std::string, std::list<input_event>> quick_shortcuts_map;
 extern bool add_best_key_for_action_to_quick_shortcuts( action_id action,
@@ -269,6 +278,9 @@ void monmove()
     g->cleanup_dead();
     map &m = get_map();
     avatar &u = get_avatar();
+    // Monsters closer than this to the avatar set off their motion alarm.
+    const double motion_alarm_range = u.enchantment_cache->modify_value(
+                                       enchant_vals::mod::MOTION_ALARM, 0 );
 
     for( monster &critter : g->all_monsters() ) {
         if( !m.inbounds( critter.pos_abs() ) ) {
@@ -329,9 +341,8 @@ void monmove()
             m.creature_in_field( critter );
         }
 
-        if( !critter.is_dead() && !critter.is_hallucination() &&
-            rl_dist( u.pos_abs(), critter.pos_abs() ) < u.enchantment_cache->modify_value(
-                enchant_vals::mod::MOTION_ALARM, 0 ) ) {
+        if( motion_alarm_range > 0 && !critter.is_dead() && !critter.is_hallucination() &&
+            rl_dist( u.pos_abs(), critter.pos_abs() ) < motion_alarm_range ) {
             if( u.has_active_bionic( bio_alarm ) ) {
                 u.mod_power_level( -bio_alarm->power_trigger );
                 add_msg( m_warning, _( "Your motion alarm goes off!" ) );
@@ -405,6 +416,7 @@ void monmove()
 void overmap_npc_move()
 {
     avatar &u = get_avatar();
+    const map &here = get_map();
     std::vector<npc *> travelling_npcs;
     static constexpr int move_search_radius = 600;
     for( auto &elem : overmap_buffer.get_npcs_near_player( move_search_radius ) ) {
@@ -435,8 +447,10 @@ void overmap_npc_move()
                     elem->goal = npc::no_goal_point;
                 }
             } else {
+                // Only a step out of or into the reality bubble changes which NPCs are loaded.
+                const bool was_active = elem->is_active();
                 elem->travel_overmap( elem->omt_path.back() );
-                npcs_need_reload = true;
+                npcs_need_reload = npcs_need_reload || was_active || here.inbounds( elem->pos_abs() );
             }
         }
         if( !elem->has_omt_destination() && calendar::once_every( 1_hours ) && one_in( 3 ) ) {
@@ -451,10 +465,220 @@ void overmap_npc_move()
 
 } // namespace
 
+int process_world_turn()
+{
+    avatar &u = get_avatar();
+    map &m = get_map();
+    scent_map &scent = get_scent();
+    // No-scent debug mutation has to be processed here or else it takes time to start working
+    if( !u.has_flag( STATIC( json_character_flag( "NO_SCENT" ) ) ) ) {
+        scent.set( u.pos_bub(), u.scent, u.get_type_of_scent() );
+        overmap_buffer.set_scent( u.pos_abs_omt(),  u.scent );
+    }
+    scent.update( u.pos_bub(), m );
+
+    // We need floor cache before checking falling 'n stuff
+    m.build_floor_caches();
+
+    m.process_falling();
+    {
+        cata_timer timer( "vehmove" );
+        m.vehmove();
+    }
+    {
+        cata_timer timer( "process_fields" );
+        m.process_fields();
+    }
+    {
+        cata_timer timer( "process_items" );
+        m.process_items();
+    }
+    explosion_handler::process_explosions();
+    m.creature_in_field( u );
+
+    // Apply sounds from previous turn to monster and NPC AI.
+    sounds::process_sounds();
+    const int levz = m.get_abs_sub().z();
+    // Update vision caches for monsters. If this turns out to be expensive,
+    // consider a stripped down cache just for monsters.
+    {
+        cata_timer timer( "build_map_cache" );
+        m.build_map_cache( levz, true );
+    }
+    {
+        cata_timer timer( "monmove" );
+        monmove();
+    }
+    if( calendar::once_every( time_between_npc_OM_moves ) ) {
+        cata_timer timer( "overmap_npc_move" );
+        overmap_npc_move();
+    }
+    if( calendar::once_every( 10_seconds ) ) {
+        for( const tripoint_bub_ms &elem : m.get_furn_field_locations() ) {
+            const furn_t &furn = *m.furn( elem );
+            for( const emit_id &e : furn.emissions ) {
+                m.emit_field( elem, e );
+            }
+        }
+        for( const tripoint_bub_ms &elem : m.get_ter_field_locations() ) {
+            const ter_t &ter = *m.ter( elem );
+            for( const emit_id &e : ter.emissions ) {
+                m.emit_field( elem, e );
+            }
+        }
+    }
+    return levz;
+}
+
+namespace turn_latency
+{
+
+// Turn durations give percentiles, so the last hour or so of play at most.
+static constexpr size_t kept_turns = 1000;
+static constexpr size_t kept_stalls = 20;
+
+struct stall {
+    time_point turn;
+    std::chrono::microseconds duration;
+    std::string phases;
+};
+
+struct recent_turns {
+    // Microseconds, a ring of kept_turns once full.
+    std::vector<int64_t> durations;
+    size_t next = 0;
+    std::deque<stall> stalls;
+};
+
+static recent_turns &recent()
+{
+    static recent_turns turns;
+    return turns;
+}
+
+using phase_durations = std::vector<std::pair<std::string, uint64_t>>;
+
+static phase_durations current_phases()
+{
+    phase_durations phases;
+    if( cata_timer::collecting() ) {
+        for( const auto &[name, stats] : cata_timer::get_stats() ) {
+            phases.emplace_back( name, stats.duration );
+        }
+    }
+    return phases;
+}
+
+// What each phase took since before, the slowest first.
+static std::string describe_phases( const phase_durations &before )
+{
+    if( !cata_timer::collecting() ) {
+        return "no phases, the debug hour timer was off";
+    }
+    phase_durations took;
+    for( const auto &[name, stats] : cata_timer::get_stats() ) {
+        uint64_t start = 0;
+        for( const std::pair<std::string, uint64_t> &phase : before ) {
+            if( phase.first == name ) {
+                start = phase.second;
+            }
+        }
+        if( stats.duration > start ) {
+            took.emplace_back( name, stats.duration - start );
+        }
+    }
+    std::sort( took.begin(), took.end(), []( const auto & a, const auto & b ) {
+        return a.second > b.second;
+    } );
+    std::string out;
+    for( const std::pair<std::string, uint64_t> &phase : took ) {
+        out += string_format( "%s%s %d ms", out.empty() ? "" : ", ", phase.first,
+                              phase.second / 1000 );
+    }
+    return out;
+}
+
+// Times the turn it lives through, less the waits for input.
+class turn_timer
+{
+    public:
+        turn_timer() : start( std::chrono::steady_clock::now() ),
+            waited( input_context::time_waiting_for_input() ), phases( current_phases() ) {}
+
+        ~turn_timer() {
+            const std::chrono::microseconds duration =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start -
+                    ( input_context::time_waiting_for_input() - waited ) );
+            recent_turns &turns = recent();
+            if( turns.durations.size() < kept_turns ) {
+                turns.durations.push_back( duration.count() );
+            } else {
+                turns.durations[turns.next] = duration.count();
+            }
+            turns.next = ( turns.next + 1 ) % kept_turns;
+            if( duration < stall_threshold ) {
+                return;
+            }
+            stall s{ calendar::turn, duration, describe_phases( phases ) };
+            DebugLog( D_INFO, D_GAME ) << "turn stalled for " << duration.count() / 1000 << " ms: "
+                                       << s.phases;
+            turns.stalls.push_back( std::move( s ) );
+            if( turns.stalls.size() > kept_stalls ) {
+                turns.stalls.pop_front();
+            }
+        }
+
+        turn_timer( const turn_timer & ) = delete;
+        turn_timer &operator=( const turn_timer & ) = delete;
+    private:
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration waited;
+        phase_durations phases;
+};
+
+std::string describe()
+{
+    const recent_turns &turns = recent();
+    if( turns.durations.empty() ) {
+        return "No turns yet.";
+    }
+    std::vector<int64_t> sorted = turns.durations;
+    std::sort( sorted.begin(), sorted.end() );
+    const auto percentile = [&sorted]( const size_t p ) {
+        return sorted[sorted.size() * p / 100] / 1000.0;
+    };
+    std::string out = string_format(
+                          "Last %d turns: p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms\n",
+                          sorted.size(), percentile( 50 ), percentile( 90 ), percentile( 99 ),
+                          sorted.back() / 1000.0 );
+    out += string_format( "Stalls over %d ms: %d\n", stall_threshold.count(), turns.stalls.size() );
+    for( auto it = turns.stalls.rbegin(); it != turns.stalls.rend(); ++it ) {
+        out += string_format( "  %s: %d ms, %s\n", to_string( it->turn ),
+                              it->duration.count() / 1000, it->phases );
+    }
+    return out;
+}
+
+bool write_to_file( const std::string &path )
+{
+    const recent_turns &turns = recent();
+    return ::write_to_file( path, [&turns]( std::ostream & fout ) {
+        fout << "turn_us\n";
+        const size_t first = turns.durations.size() < kept_turns ? 0 : turns.next;
+        for( size_t i = 0; i < turns.durations.size(); ++i ) {
+            fout << turns.durations[( first + i ) % turns.durations.size()] << '\n';
+        }
+    }, "turn latency" );
+}
+
+} // namespace turn_latency
+
 // MAIN GAME LOOP
 // Returns true if game is over (death, saved, quit, etc)
 bool do_turn()
 {
+    turn_latency::turn_timer timer;
     if( g->is_game_over() ) {
         return turn_handler::cleanup_at_end();
     }
@@ -479,7 +703,7 @@ bool do_turn()
     play_music( music::get_music_id_string() );
 
     // starting a new turn, clear out temperature cache
-    weather.temperature_cache.clear();
+    weather.clear_temp_cache();
 
     if( g->npcs_dirty ) {
         g->load_npcs();
@@ -515,7 +739,7 @@ bool do_turn()
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
 
-        if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+        if( option_wander_spawns() ) {
             overmap_buffer.move_hordes();
         }
         if( u.has_trait( trait_HAS_NEMESIS ) ) {
@@ -531,11 +755,16 @@ bool do_turn()
     u.update_body();
 
     // Auto-save if autosave is enabled
-    if( get_option<bool>( "AUTOSAVE" ) &&
-        calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
+    if( option_autosave() &&
+        calendar::once_every( 1_turns * option_autosave_turns() ) &&
         !u.is_dead_state() ) {
         g->autosave();
     }
+    g->take_over_forked_save();
+    MAPBUFFER.enforce_budget();
+    zzip_maintenance::step_if_idle();
+    overmap_buffer.pregenerate_near( u.pos_abs_omt() );
+    m.generate_queued_ahead();
 
     weather.update_weather();
     g->reset_light_level();
@@ -640,51 +869,10 @@ bool do_turn()
         g->calc_driving_offset( veh );
     }
 
-    scent_map &scent = get_scent();
-    // No-scent debug mutation has to be processed here or else it takes time to start working
-    if( !u.has_flag( STATIC( json_character_flag( "NO_SCENT" ) ) ) ) {
-        scent.set( u.pos_bub(), u.scent, u.get_type_of_scent() );
-        overmap_buffer.set_scent( u.pos_abs_omt(),  u.scent );
-    }
-    scent.update( u.pos_bub(), m );
-
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
-
-    m.process_falling();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
-    explosion_handler::process_explosions();
-    m.creature_in_field( u );
-
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    const int levz = m.get_abs_sub().z();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( levz, true );
-    monmove();
-    if( calendar::once_every( time_between_npc_OM_moves ) ) {
-        overmap_npc_move();
-    }
-    if( calendar::once_every( 10_seconds ) ) {
-        for( const tripoint_bub_ms &elem : m.get_furn_field_locations() ) {
-            const furn_t &furn = *m.furn( elem );
-            for( const emit_id &e : furn.emissions ) {
-                m.emit_field( elem, e );
-            }
-        }
-        for( const tripoint_bub_ms &elem : m.get_ter_field_locations() ) {
-            const ter_t &ter = *m.ter( elem );
-            for( const emit_id &e : ter.emissions ) {
-                m.emit_field( elem, e );
-            }
-        }
-    }
+    const int levz = process_world_turn();
     g->mon_info_update();
     u.process_turn();
-    if( u.get_moves() < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    if( u.get_moves() < 0 && option_force_redraw() ) {
         ui_manager::redraw();
         refresh_display();
     }
@@ -716,8 +904,10 @@ bool do_turn()
         }
     }
     if( wait_redraw ) {
-        if( g->first_redraw_since_waiting_started ||
-            calendar::once_every( std::min( 1_minutes, wait_refresh_rate ) ) ) {
+        // The sleep message never changes, so only refresh its popup along with the main UI.
+        const time_duration popup_refresh_rate = player_is_sleeping ? wait_refresh_rate :
+                std::min( 1_minutes, wait_refresh_rate );
+        if( g->first_redraw_since_waiting_started || calendar::once_every( popup_refresh_rate ) ) {
             if( g->first_redraw_since_waiting_started || calendar::once_every( wait_refresh_rate ) ) {
                 ui_manager::redraw();
             }
@@ -2,8 +2,32 @@
 #ifndef CATA_SRC_DO_TURN_H
 #define CATA_SRC_DO_TURN_H
 
+#include <chrono>
+#include <string>
+
 /** MAIN GAME LOOP. Returns true if game is over (death, saved, quit, etc.). */
 bool do_turn();
 void handle_key_blocking_activity();
+/**
+ * The world side of a turn: scent, falling, vehicles, fields, items, sounds, monsters and NPCs
+ * travelling on the overmap.  It needs no player input nor drawing, so runs without a player
+ * at the keyboard, like benchmarks, can call it instead of do_turn.
+ * @return the z-level of the map it was processed on.
+ */
+int process_world_turn();
+
+/**
+ * How long the recent turns took, without the time waiting for input, and the stalls among
+ * them: turns slower than stall_threshold, kept with the phases timed by cata_timer when the
+ * debug hour timer runs.
+ */
+namespace turn_latency
+{
+constexpr std::chrono::milliseconds stall_threshold( 250 );
+/** p50, p90, p99 and max of the recent turns and the last stalls, for the debug menu. */
+std::string describe();
+/** Writes the duration of each recent turn, oldest first, as tab separated values. */
+bool write_to_file( const std::string &path );
+} // namespace turn_latency
 
 #endif // CATA_SRC_DO_TURN_H
@@ -1,12 +1,14 @@
 #include "effect_on_condition.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <list>
 #include <memory>
 #include <unordered_map>
 #include <ostream>
 #include <queue>
+#include <set>
 
 #include "avatar.h"
 #include "calendar.h"
@@ -56,6 +58,8 @@ namespace
 {
 generic_factory<effect_on_condition>
 effect_on_condition_factory( "effect_on_condition" );
+// The eocs declared inline, which reloads of the data declaring them load again.
+std::set<effect_on_condition_id> inline_eoc_ids;
 } // namespace
 
 template<>
@@ -112,7 +116,20 @@ void effect_on_condition::load( const JsonObject &jo, std::string_view src )
     }
 
     if( type == eoc_type::EVENT ) {
-        mandatory( jo, was_loaded, "required_event", required_event );
+        // Several events for an eoc that should run whenever any of its inputs changes, rather
+        // than on a recurrence that checks whether they did.
+        if( jo.has_array( "required_event" ) ) {
+            mandatory( jo, was_loaded, "required_event", required_events );
+            if( required_events.empty() ) {
+                jo.throw_error_at( "required_event", "An EVENT effect_on_condition needs an event." );
+            }
+        } else if( jo.has_member( "required_event" ) ) {
+            event_type required_event;
+            mandatory( jo, was_loaded, "required_event", required_event );
+            required_events = { required_event };
+        } else if( !was_loaded ) {
+            jo.throw_error( "An EVENT effect_on_condition needs a required_event." );
+        }
     }
 }
 
@@ -125,7 +142,13 @@ effect_on_condition_id effect_on_conditions::load_inline_eoc( const JsonValue &j
         effect_on_condition inline_eoc;
         inline_eoc.load( jv.get_object(), src );
         mod_tracker::assign_src( inline_eoc, src );
+        if( reloading_inline_eocs() && inline_eoc_ids.count( inline_eoc.id ) > 0 ) {
+            // Replaced in place, so the ids already handed out stay valid.
+            const_cast<effect_on_condition &>( inline_eoc.id.obj() ) = inline_eoc;
+            return inline_eoc.id;
+        }
         effect_on_condition_factory.insert( inline_eoc );
+        inline_eoc_ids.insert( inline_eoc.id );
         return inline_eoc.id;
     } else {
         jv.throw_error( "effect_on_condition needs to be either a string or an effect_on_condition object." );
@@ -322,8 +345,54 @@ void effect_on_conditions::process_reactivate()
                           g->queued_global_effect_on_conditions, d );
 }
 
+bool &effect_on_conditions::profiling()
+{
+    static bool profiling = false;
+    return profiling;
+}
+
+static std::unordered_map<effect_on_condition_id, effect_on_conditions::eoc_profile> &profiles()
+{
+    static std::unordered_map<effect_on_condition_id, effect_on_conditions::eoc_profile> profiles;
+    return profiles;
+}
+
+std::vector<std::pair<effect_on_condition_id, effect_on_conditions::eoc_profile>>
+        effect_on_conditions::get_profile()
+{
+    std::vector<std::pair<effect_on_condition_id, eoc_profile>> result( profiles().begin(),
+            profiles().end() );
+    std::sort( result.begin(), result.end(), []( const auto & a, const auto & b ) {
+        return a.second.time > b.second.time;
+    } );
+    return result;
+}
+
+void effect_on_conditions::reset_profile()
+{
+    profiles().clear();
+}
+
+// Checks a condition of the eoc, timing it while profiling.
+static bool check_condition( const effect_on_condition &eoc,
+                             const std::function<bool( const_dialogue const & )> &condition, const_dialogue const &d )
+{
+    if( !effect_on_conditions::profiling() ) {
+        return condition( d );
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const bool result = condition( d );
+    effect_on_conditions::eoc_profile &profile = profiles()[eoc.id];
+    profile.condition_checks++;
+    profile.condition_time += std::chrono::steady_clock::now() - start;
+    return result;
+}
+
 bool effect_on_condition::activate( dialogue &d, bool require_callstack_check ) const
 {
+    const bool profile = effect_on_conditions::profiling();
+    const std::chrono::steady_clock::time_point start = profile ? std::chrono::steady_clock::now() :
+            std::chrono::steady_clock::time_point();
     bool retval = false;
     if( require_callstack_check ) {
         d.amend_callstack( "EOC: " + id.str() );
@@ -336,7 +405,7 @@ bool effect_on_condition::activate( dialogue &d, bool require_callstack_check )
     }
     // each version needs a copy of the dialogue to pass down
     dialogue d_eoc( d );
-    if( !has_condition || condition( d_eoc ) ) {
+    if( !has_condition || check_condition( *this, condition, d_eoc ) ) {
         true_effect.apply( d_eoc );
         retval = true;
     } else if( has_false_effect ) {
@@ -347,13 +416,18 @@ bool effect_on_condition::activate( dialogue &d, bool require_callstack_check )
     if( global && run_for_npcs ) {
         for( npc &guy : g->all_npcs() ) {
             dialogue d_npc( get_talker_for( guy ), nullptr, d.get_conditionals(), d.get_context() );
-            if( !has_condition || condition( d_npc ) ) {
+            if( !has_condition || check_condition( *this, condition, d_npc ) ) {
                 true_effect.apply( d_npc );
             } else if( has_false_effect ) {
                 false_effect.apply( d_npc );
             }
         }
     }
+    if( profile ) {
+        effect_on_conditions::eoc_profile &p = profiles()[id];
+        p.activations++;
+        p.time += std::chrono::steady_clock::now() - start;
+    }
     return retval;
 }
 
@@ -362,12 +436,12 @@ bool effect_on_condition::check_deactivate( const_dialogue const &d ) const
     if( !has_deactivate_condition || has_false_effect ) {
         return false;
     }
-    return deactivate_condition( d );
+    return check_condition( *this, deactivate_condition, d );
 }
 
 bool effect_on_condition::test_condition( const_dialogue const &d ) const
 {
-    return !has_condition || condition( d );
+    return !has_condition || check_condition( *this, condition, d );
 }
 
 void effect_on_condition::apply_true_effects( dialogue &d )  const
@@ -502,6 +576,13 @@ const std::vector<effect_on_condition> &effect_on_conditions::get_all()
 void effect_on_conditions::reset()
 {
     effect_on_condition_factory.reset();
+    inline_eoc_ids.clear();
+}
+
+bool &effect_on_conditions::reloading_inline_eocs()
+{
+    static bool reloading = false;
+    return reloading;
 }
 
 void effect_on_conditions::load( const JsonObject &jo, const std::string &src )
@@ -535,7 +616,9 @@ void eoc_events::notify( const cata::event &e, std::unique_ptr<talker> alpha,
         //create a cache for the specific types of EOC's so they aren't constantly all itterated through
         for( const effect_on_condition &eoc : effect_on_conditions::get_all() ) {
             if( eoc.type == eoc_type::EVENT ) {
-                event_EOCs[eoc.required_event].emplace_back( eoc );
+                for( const event_type required_event : eoc.required_events ) {
+                    event_EOCs[required_event].emplace_back( eoc );
+                }
             }
         }
 
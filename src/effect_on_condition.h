@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_EFFECT_ON_CONDITION_H
 #define CATA_SRC_EFFECT_ON_CONDITION_H
 
+#include <chrono>
 #include <functional>
 #include <map>
 #include <string>
@@ -64,7 +65,8 @@ struct effect_on_condition {
         bool has_deactivate_condition = false;
         bool has_condition = false;
         bool has_false_effect = false;
-        event_type required_event;
+        // Any of them runs an EVENT eoc.
+        std::vector<event_type> required_events;
         duration_or_var recurrence;
         bool activate( dialogue &d, bool require_callstack_check = true ) const;
         bool check_deactivate( const_dialogue const &d ) const;
@@ -93,6 +95,9 @@ void load_new_character( Character &you );
 void load_existing_character( Character &you );
 /** Loads an inline eoc */
 effect_on_condition_id load_inline_eoc( const JsonValue &jv, std::string_view src );
+/** Whether inline eocs loaded again replace the old ones, off unless the data declaring them
+ * is being reloaded. */
+bool &reloading_inline_eocs();
 /** queue an eoc to happen in the future */
 void queue_effect_on_condition( time_duration duration, effect_on_condition_id eoc,
                                 Character &you, global_variables::impl_t const &context );
@@ -110,6 +115,19 @@ void write_global_eocs_to_file();
 void prevent_death();
 /** Run all avatar death eocs */
 void avatar_death();
+
+/** What one eoc took while profiling, the eocs it ran included. */
+struct eoc_profile {
+    int activations = 0;
+    std::chrono::nanoseconds time{ 0 };
+    int condition_checks = 0;
+    std::chrono::nanoseconds condition_time{ 0 };
+};
+/** Whether activations and condition checks of each eoc are timed, off unless set. */
+bool &profiling();
+/** What was timed since the last reset, the slowest eoc first. */
+std::vector<std::pair<effect_on_condition_id, eoc_profile>> get_profile();
+void reset_profile();
 } // namespace effect_on_conditions
 
 template<>
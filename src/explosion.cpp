@@ -968,15 +968,22 @@ void process_explosions()
     std::vector<queued_explosion> explosions_copy( _explosions );
     _explosions.clear();
 
-    for( const queued_explosion &ex : explosions_copy ) {
+    map *bubble_map = &reality_bubble();
+    const auto needs_own_map = [bubble_map]( const queued_explosion & ex ) {
         const int safe_range = ex.data.safe_range();
-        map  *bubble_map = &reality_bubble();
         const tripoint_bub_ms bubble_pos( bubble_map->get_bub( ex.pos ) );
+        return bubble_pos.x() - safe_range < 0 || bubble_pos.x() + safe_range > MAPSIZE_X ||
+               bubble_pos.y() - safe_range < 0 || bubble_pos.y() + safe_range > MAPSIZE_Y;
+    };
+    const auto own_map_origo = []( const queued_explosion & ex ) {
+        return project_to<coords::sm>( ex.pos ) - point_rel_sm{ HALF_MAPSIZE, HALF_MAPSIZE};
+    };
 
-        if( bubble_pos.x() - safe_range < 0 || bubble_pos.x() + safe_range > MAPSIZE_X ||
-            bubble_pos.y() - safe_range < 0 || bubble_pos.y() + safe_range > MAPSIZE_Y ) {
+    for( size_t i = 0; i < explosions_copy.size(); ) {
+        const queued_explosion &ex = explosions_copy[i];
+        if( needs_own_map( ex ) ) {
             map m;
-            const tripoint_abs_sm origo( project_to<coords::sm>( ex.pos ) - point_rel_sm{ HALF_MAPSIZE, HALF_MAPSIZE} );
+            const tripoint_abs_sm origo( own_map_origo( ex ) );
             // Create a map centered around the explosion point to allow an explosion with a radius of up to 5 submaps
             // to be created without being cut off by the map's boundary. That also means there is no need for the map
             // to actually overlap the reality bubble, so a large explosion can be detonated without blowing up the PC
@@ -987,10 +994,18 @@ void process_explosions()
             m.spawn_monsters( true, true );
             g->load_npcs( &m );
             process_explosions_in_progress = false;
-            _make_explosion( &m, ex.source, m.get_bub( ex.pos ), ex.data );
-            m.process_falling();
+            // A chain of explosions (a cooking off ammo stash, a row of tanks) is queued together,
+            // so the following ones centered in the same submap reuse the map loaded here.
+            do {
+                const queued_explosion &cur = explosions_copy[i];
+                _make_explosion( &m, cur.source, m.get_bub( cur.pos ), cur.data );
+                m.process_falling();
+                ++i;
+            } while( i < explosions_copy.size() && needs_own_map( explosions_copy[i] ) &&
+                     own_map_origo( explosions_copy[i] ) == origo );
         } else {
             _make_explosion( bubble_map, ex.source, bubble_map->get_bub( ex.pos ), ex.data );
+            ++i;
         }
     }
 }
@@ -727,7 +727,9 @@ void talk_function::start_camp( npc &p )
         const oter_id &om_type = oter_id( om_near.first );
         if( is_ot_match( "faction_base", om_type, ot_match_type::contains ) ) {
             tripoint_abs_omt const &building_omt_pos = om_near.second;
-            std::vector<basecamp> const &camps = overmap_buffer.get_om_global( building_omt_pos ).om->camps;
+            const overmap *om = overmap_buffer.get_om_global( building_omt_pos ).om;
+            om->ensure_dynamic_loaded();
+            std::vector<basecamp> const &camps = om->camps;
             if( std::any_of( camps.cbegin(), camps.cend(), [&building_omt_pos]( const basecamp & camp ) {
             return camp.camp_omt_pos() == building_omt_pos;
             } ) ) {
@@ -1302,6 +1304,15 @@ void basecamp::get_available_missions_by_dir( mission_data &mission_key, const p
         }
     }
 
+    // The farm is loaded once for the descriptions of all three farm missions.
+    std::unique_ptr<smallmap> farm_map;
+    const auto loaded_farm_map = [&]() -> smallmap & {
+        if( !farm_map ) {
+            farm_map = std::make_unique<smallmap>();
+            farm_map->load( expansions.at( dir ).pos, false );
+        }
+        return *farm_map;
+    };
     if( has_provides( "farming", dir ) ) {
         size_t plots = 0;
         const mission_id miss_id = { Camp_Plow, "", {}, dir };
@@ -1309,7 +1320,7 @@ void basecamp::get_available_missions_by_dir( mission_data &mission_key, const p
         if( npc_list.empty() ) {
             entry = _( "Notes:\n"
                        "Plow any spaces that have reverted to dirt or grass.\n\n" ) +
-                    farm_description( dir, plots, farm_ops::plow ) +
+                    farm_description( dir, plots, farm_ops::plow, loaded_farm_map() ) +
                     _( "\n\n"
                        "Skill used: fabrication\n"
                        "Difficulty: N/A\n"
@@ -1337,7 +1348,7 @@ void basecamp::get_available_missions_by_dir( mission_data &mission_key, const p
             entry = _( "Notes:\n"
                        "Plant designated seeds in the spaces that have already been "
                        "tilled.\n\n" ) +
-                    farm_description( dir, plots, farm_ops::plant ) +
+                    farm_description( dir, plots, farm_ops::plant, loaded_farm_map() ) +
                     _( "\n\n"
                        "Skill used: survival\n"
                        "Difficulty: N/A\n"
@@ -1366,7 +1377,7 @@ void basecamp::get_available_missions_by_dir( mission_data &mission_key, const p
         if( npc_list.empty() ) {
             entry = _( "Notes:\n"
                        "Harvest any plants that are ripe and bring the produce back.\n\n" ) +
-                    farm_description( dir, plots, farm_ops::harvest ) +
+                    farm_description( dir, plots, farm_ops::harvest, loaded_farm_map() ) +
                     _( "\n\n"
                        "Skill used: survival\n"
                        "Difficulty: N/A\n"
@@ -1951,6 +1962,8 @@ bool basecamp::handle_mission( const ui_mission_id &miss_id )
             break;
     }
 
+    // Missions move items in and out of the camp storage without a turn passing.
+    invalidate_crafting_inventory();
     return true;
 }
 
@@ -3595,7 +3608,7 @@ static bool farm_valid_seed( const item &itm )
 }
 
 std::pair<size_t, std::string> basecamp::farm_action( const point_rel_omt &dir, farm_ops op,
-        const npc_ptr &comp )
+        const npc_ptr &comp, smallmap *loaded_farm_map )
 {
     size_t plots_cnt = 0;
     std::string crops;
@@ -3618,8 +3631,13 @@ std::pair<size_t, std::string> basecamp::farm_action( const point_rel_omt &dir,
     }
 
     // farm_map is what the area actually looks like
-    smallmap farm_map;
-    farm_map.load( omt_tgt, false );
+    std::unique_ptr<smallmap> own_farm_map;
+    if( !loaded_farm_map ) {
+        own_farm_map = std::make_unique<smallmap>();
+        own_farm_map->load( omt_tgt, false );
+        loaded_farm_map = own_farm_map.get();
+    }
+    smallmap &farm_map = *loaded_farm_map;
     // farm_json is what the area should look like according to jsons (loaded on demand)
     std::unique_ptr<small_fake_map> farm_json;
     tripoint_omt_ms mapmin{ 0, 0, omt_tgt.z() };
@@ -3744,7 +3762,7 @@ std::pair<size_t, std::string> basecamp::farm_action( const point_rel_omt &dir,
                 break;
         }
     }
-    if( comp ) {
+    if( comp && own_farm_map ) {
         farm_map.save();
     }
 
@@ -5644,9 +5662,9 @@ std::string basecamp::gathering_description()
 }
 
 std::string basecamp::farm_description( const point_rel_omt &dir, size_t &plots_count,
-                                        farm_ops operation )
+                                        farm_ops operation, smallmap &farm_map )
 {
-    std::pair<size_t, std::string> farm_data = farm_action( dir, operation );
+    std::pair<size_t, std::string> farm_data = farm_action( dir, operation, nullptr, &farm_map );
     plots_count = farm_data.first;
     switch( operation ) {
         case farm_ops::harvest:
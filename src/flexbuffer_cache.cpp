@@ -1,15 +1,23 @@
 #include "flexbuffer_cache.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <random>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <system_error>
 #include <type_traits>
 #include <unordered_map>
@@ -18,12 +26,15 @@
 
 #include <flatbuffers/flexbuffers.h>
 #include <flatbuffers/idl.h>
+#include <zstd/common/xxhash.h>
 
+#include "cata_thread_pool.h"
 #include "cata_utility.h"
 #include "filesystem.h"
 #include "json.h"
 #include "mmap_file.h"
 #include "options.h"
+#include "string_formatter.h"
 
 namespace
 {
@@ -56,6 +67,33 @@ std::filesystem::file_time_type get_file_mtime_millis( const std::filesystem::pa
     return ret;
 }
 
+// A name next to path for writing it aside, that no other thread or instance of the game
+// writes to at the same time.
+std::filesystem::path unique_tmp_path( const std::filesystem::path &path )
+{
+    static std::atomic<uint64_t> counter{ std::random_device()() };
+    std::filesystem::path tmp_path = path;
+    tmp_path += std::filesystem::u8path( ".tmp." + std::to_string( std::random_device()() ) + "." +
+                                         std::to_string( counter++ ) );
+    return tmp_path;
+}
+
+// Stale game data found by the thread pool, reported by the main thread.
+std::mutex stale_mutex;
+std::vector<std::string> stale_files;
+
+void report_stale( const std::string &filepath_and_name )
+{
+    if( get_option<bool>( "WARN_ON_MODIFIED" ) ) {
+        debugmsg( "Stale game data detected at %s, did you overwrite old files?  When updating the game you must install to a fresh folder, overwriting old files will cause errors.",
+                  filepath_and_name );
+    } else {
+        // we still log the modification warning even if the option is disabled, for sifting bug reports
+        DebugLog( D_WARNING, D_MAIN ) << "Stale game data detected (error disabled by user): " <<
+                                      filepath_and_name;
+    }
+}
+
 std::vector<uint8_t> parse_json_to_flexbuffer_(
     const char *buffer,
     const char *source_filename_opt ) noexcept( false )
@@ -128,6 +166,192 @@ std::vector<uint8_t> parse_json_to_flexbuffer_(
     return std::move( fbb ).GetBuffer();
 }
 
+// Checks that every offset, size and type in a FlexBuffer stays inside the buffer, so that a
+// truncated or corrupt file on disk cannot make the readers run off its end.  The vendored
+// FlatBuffers predates flexbuffers::Verifier, this follows the same rules.
+class flexbuffer_verifier
+{
+    public:
+        flexbuffer_verifier( const uint8_t *data, size_t size ) : data_( data ), size_( size ),
+            seen_as_( size ) {}
+
+        bool verify() {
+            // The root is written last: its value, its packed type and its width.
+            if( size_ < 3 ) {
+                return false;
+            }
+            const uint8_t root_width = data_[size_ - 1];
+            if( !valid_width( root_width ) || size_ - 2 < root_width ) {
+                return false;
+            }
+            return verify_reference( size_ - 2 - root_width, root_width, data_[size_ - 2], size_,
+                                     0 );
+        }
+
+    private:
+        static bool valid_width( uint64_t width ) {
+            return width == 1 || width == 2 || width == 4 || width == 8;
+        }
+
+        bool in_range( size_t pos, uint64_t len ) const {
+            return pos <= size_ && len <= size_ - pos;
+        }
+
+        uint64_t read( size_t pos, uint8_t width ) const {
+            return flexbuffers::ReadUInt64( data_ + pos, width );
+        }
+
+        // Follows the offset stored at pos, offsets always point back towards the start.
+        bool indirect( size_t pos, uint8_t width, size_t &target ) const {
+            if( !in_range( pos, width ) ) {
+                return false;
+            }
+            const uint64_t offset = read( pos, width );
+            if( offset > pos ) {
+                return false;
+            }
+            target = pos - offset;
+            return true;
+        }
+
+        // Reads the size prefix of the object at target, whose elements take elem_size bytes.
+        bool sized( size_t target, uint8_t width, uint64_t elem_size, uint64_t &len ) const {
+            if( target < width || target > size_ ) {
+                return false;
+            }
+            len = read( target - width, width );
+            return len <= ( size_ - target ) / elem_size;
+        }
+
+        bool verify_reference( size_t pos, uint8_t parent_width, uint8_t packed_type, size_t parent,
+                               int depth ) {
+            return verify_value( pos, parent_width,
+                                 static_cast<flexbuffers::Type>( packed_type >> 2 ),
+                                 static_cast<uint8_t>( 1U << ( packed_type & 3 ) ), parent, depth );
+        }
+
+        // The vectors in a vector are written before it, which also rules out cycles.  parent
+        // is where the vector holding this value starts.
+        bool verify_value( size_t pos, uint8_t parent_width, flexbuffers::Type type,
+                           uint8_t byte_width, size_t parent, int depth ) {
+            if( !in_range( pos, parent_width ) ) {
+                return false;
+            }
+            if( flexbuffers::IsInline( type ) ) {
+                return true;
+            }
+            size_t target = 0;
+            if( !indirect( pos, parent_width, target ) ) {
+                return false;
+            }
+            switch( type ) {
+                case flexbuffers::FBT_KEY:
+                    return memchr( data_ + target, '\0', size_ - target ) != nullptr;
+                case flexbuffers::FBT_STRING: {
+                    uint64_t len = 0;
+                    // Strings are followed by their terminator.
+                    return sized( target, byte_width, 1, len ) && len < size_ - target;
+                }
+                case flexbuffers::FBT_BLOB: {
+                    uint64_t len = 0;
+                    return sized( target, byte_width, 1, len );
+                }
+                case flexbuffers::FBT_INDIRECT_INT:
+                case flexbuffers::FBT_INDIRECT_UINT:
+                case flexbuffers::FBT_INDIRECT_FLOAT:
+                    return in_range( target, byte_width );
+                default:
+                    break;
+            }
+            if( target >= parent || depth >= FLATBUFFERS_MAX_PARSING_DEPTH ) {
+                return false;
+            }
+            // Vectors can be shared, by maps with the same keys for one, so each is only
+            // checked once.  Never as two different types, though, that is not written.
+            const uint8_t packed_type = static_cast<uint8_t>( ( type << 2 ) |
+                                        ( byte_width == 8 ? 3 : byte_width / 2 ) );
+            if( seen_as_[target] != 0 ) {
+                return seen_as_[target] == packed_type;
+            }
+            seen_as_[target] = packed_type;
+            if( type == flexbuffers::FBT_MAP || type == flexbuffers::FBT_VECTOR ) {
+                return verify_vector( target, byte_width, type == flexbuffers::FBT_MAP, depth );
+            }
+            if( flexbuffers::IsTypedVector( type ) ) {
+                flexbuffers::Type elem_type = flexbuffers::ToTypedVectorElementType( type );
+                if( elem_type == flexbuffers::FBT_STRING ) {
+                    // Read as keys, see Reference::AsTypedVector.
+                    elem_type = flexbuffers::FBT_KEY;
+                }
+                uint64_t len = 0;
+                return sized( target, byte_width, byte_width, len ) &&
+                       verify_elements( target, byte_width, len, elem_type, depth );
+            }
+            if( flexbuffers::IsFixedTypedVector( type ) ) {
+                uint8_t len = 0;
+                const flexbuffers::Type elem_type =
+                    flexbuffers::ToFixedTypedVectorElementType( type, &len );
+                return in_range( target, static_cast<uint64_t>( len ) * byte_width ) &&
+                       verify_elements( target, byte_width, len, elem_type, depth );
+            }
+            return false;
+        }
+
+        bool verify_elements( size_t target, uint8_t width, uint64_t len,
+                              flexbuffers::Type elem_type, int depth ) {
+            for( uint64_t i = 0; i < len; ++i ) {
+                if( !verify_value( target + i * width, width, elem_type, 1, target, depth + 1 ) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Untyped vectors store a packed type byte per element after the elements.  Maps are
+        // such a vector of their values, led by the offset and width of their keys vector.
+        bool verify_vector( size_t target, uint8_t width, bool is_map, int depth ) {
+            uint64_t len = 0;
+            if( !sized( target, width, width + 1ULL, len ) ) {
+                return false;
+            }
+            if( is_map ) {
+                size_t keys_target = 0;
+                if( target < 3ULL * width || !indirect( target - 3 * width, width, keys_target ) ) {
+                    return false;
+                }
+                const uint64_t keys_width = read( target - 2 * width, width );
+                if( !valid_width( keys_width ) ||
+                    !verify_value( target - 3 * width, width, flexbuffers::FBT_VECTOR_KEY,
+                                   static_cast<uint8_t>( keys_width ), target, depth ) ) {
+                    return false;
+                }
+                uint64_t keys_len = 0;
+                if( !sized( keys_target, static_cast<uint8_t>( keys_width ), keys_width,
+                            keys_len ) || keys_len != len ) {
+                    return false;
+                }
+            }
+            const size_t types = target + len * width;
+            for( uint64_t i = 0; i < len; ++i ) {
+                if( !verify_reference( target + i * width, width, data_[types + i], target,
+                                       depth + 1 ) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const uint8_t *data_;
+        size_t size_;
+        // The packed type each vector was checked as, 0 before it is.
+        std::vector<uint8_t> seen_as_;
+};
+
+bool verify_flexbuffer( const uint8_t *data, size_t size )
+{
+    return flexbuffer_verifier( data, size ).verify();
+}
+
 } // namespace
 
 struct flexbuffer_vector_storage : flexbuffer_storage {
@@ -144,6 +368,24 @@ struct flexbuffer_vector_storage : flexbuffer_storage {
     }
 };
 
+// One of the buffers of a pack.
+struct flexbuffer_pack_storage : flexbuffer_storage {
+    std::shared_ptr<const mmap_file> mmap_handle_;
+    size_t offset_;
+    size_t size_;
+
+    flexbuffer_pack_storage( std::shared_ptr<const mmap_file> mmap_handle, size_t offset,
+                             size_t size ) : mmap_handle_{ std::move( mmap_handle ) }, offset_{ offset },
+        size_{ size } {}
+
+    const uint8_t *data() const override {
+        return static_cast<const uint8_t *>( mmap_handle_->base() ) + offset_;
+    }
+    size_t size() const override {
+        return size_;
+    }
+};
+
 struct flexbuffer_mmap_storage : flexbuffer_storage {
     std::shared_ptr<const mmap_file> mmap_handle_;
 
@@ -163,6 +405,120 @@ parsed_flexbuffer::parsed_flexbuffer( std::shared_ptr<flexbuffer_storage> storag
     // TODO assert?
 }
 
+uint64_t flexbuffer_key_index::hash( const std::string_view key )
+{
+    return XXH64( key.data(), key.size(), 0 );
+}
+
+size_t flexbuffer_key_index::slot_of( const uint64_t hash, const uint32_t displacement,
+                                      const size_t slot_mask )
+{
+    uint64_t h = hash ^ ( displacement * 0x9E3779B97F4A7C15ULL );
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return static_cast<size_t>( h ) & slot_mask;
+}
+
+std::unique_ptr<flexbuffer_key_index> flexbuffer_key_index::build(
+    const flexbuffers::TypedVector &keys )
+{
+    // Slots hold key indexes, with the largest value marking the free ones.
+    constexpr uint16_t free_slot = std::numeric_limits<uint16_t>::max();
+    constexpr uint32_t max_displacement = 1 << 16;
+    const size_t num_keys = keys.size();
+    if( num_keys >= free_slot ) {
+        return nullptr;
+    }
+    std::unique_ptr<flexbuffer_key_index> index( new flexbuffer_key_index() );
+    size_t num_slots = 1;
+    while( num_slots < num_keys * 2 ) {
+        num_slots *= 2;
+    }
+    // Four keys to a bucket on average.
+    const size_t num_buckets = std::max<size_t>( 1, num_slots / 8 );
+    index->slot_mask_ = num_slots - 1;
+    index->bucket_mask_ = num_buckets - 1;
+    index->displacements_.assign( num_buckets, 0 );
+    index->slots_.assign( num_slots, free_slot );
+
+    std::vector<uint64_t> hashes( num_keys );
+    std::vector<std::vector<uint16_t>> buckets( num_buckets );
+    for( size_t i = 0; i < num_keys; ++i ) {
+        hashes[i] = hash( keys[i].AsKey() );
+        buckets[hashes[i] & index->bucket_mask_].push_back( static_cast<uint16_t>( i ) );
+    }
+    // The fullest buckets are placed first, while most slots are still free.
+    std::vector<size_t> order( num_buckets );
+    for( size_t b = 0; b < num_buckets; ++b ) {
+        order[b] = b;
+    }
+    std::stable_sort( order.begin(), order.end(), [&buckets]( size_t lhs, size_t rhs ) {
+        return buckets[lhs].size() > buckets[rhs].size();
+    } );
+    std::vector<size_t> placed;
+    for( const size_t b : order ) {
+        if( buckets[b].empty() ) {
+            break;
+        }
+        bool fits = false;
+        for( uint32_t d = 0; d < max_displacement && !fits; ++d ) {
+            placed.clear();
+            fits = true;
+            for( const uint16_t key : buckets[b] ) {
+                const size_t slot = slot_of( hashes[key], d, index->slot_mask_ );
+                if( index->slots_[slot] != free_slot ||
+                    std::find( placed.begin(), placed.end(), slot ) != placed.end() ) {
+                    fits = false;
+                    break;
+                }
+                placed.push_back( slot );
+            }
+            if( fits ) {
+                index->displacements_[b] = d;
+                for( size_t i = 0; i < placed.size(); ++i ) {
+                    index->slots_[placed[i]] = buckets[b][i];
+                }
+            }
+        }
+        if( !fits ) {
+            return nullptr;
+        }
+    }
+    return index;
+}
+
+size_t flexbuffer_key_index::candidate( const std::string_view key ) const
+{
+    const uint64_t h = hash( key );
+    return slots_[slot_of( h, displacements_[h & bucket_mask_], slot_mask_ )];
+}
+
+namespace
+{
+// Where the keys of a map are, which flexbuffers keeps protected.  Maps with the same keys
+// may share them, and then share their index too.
+struct key_vector_address : flexbuffers::TypedVector {
+    static const uint8_t *of( const flexbuffers::TypedVector &keys ) {
+        return keys.*( &key_vector_address::data_ );
+    }
+};
+} // namespace
+
+const flexbuffer_key_index *parsed_flexbuffer::key_index( const flexbuffers::TypedVector &keys )
+const
+{
+    if( keys.size() < flexbuffer_key_index::min_keys ) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lk( key_indexes_mutex_ );
+    const auto [it, inserted] = key_indexes_.try_emplace( key_vector_address::of( keys ) );
+    if( inserted ) {
+        it->second = flexbuffer_key_index::build( keys );
+    }
+    return it->second.get();
+}
+
 struct file_flexbuffer : parsed_flexbuffer {
         file_flexbuffer(
             std::shared_ptr<flexbuffer_storage> &&storage,
@@ -230,6 +586,29 @@ struct string_flexbuffer : parsed_flexbuffer {
         std::string source_;
 };
 
+// A buffer that was stored in binary form.  There is no text source, so error reports get
+// the json regenerated from the buffer itself.
+struct binary_flexbuffer : parsed_flexbuffer {
+        explicit binary_flexbuffer( std::shared_ptr<flexbuffer_storage> &&storage )
+            : parsed_flexbuffer{ std::move( storage ) } {}
+
+        ~binary_flexbuffer() override = default;
+
+        bool is_stale() const override {
+            return false;
+        }
+
+        std::unique_ptr<std::istream> get_source_stream() const override {
+            std::string source;
+            flexbuffers::GetRoot( storage_->data(), storage_->size() ).ToString( true, true, source );
+            return std::make_unique<std::istringstream>( std::move( source ) );
+        }
+
+        std::filesystem::path get_source_path() const noexcept override {
+            return {};
+        }
+};
+
 class flexbuffer_disk_cache
 {
     public:
@@ -291,11 +670,13 @@ class flexbuffer_disk_cache
         }
 
         bool has_cached_flexbuffer_for_json( const std::filesystem::path &json_source_path ) {
+            std::lock_guard<std::mutex> lk( mutex_ );
             return cached_flexbuffers_.count( json_source_path.u8string() ) > 0;
         }
 
         std::filesystem::file_time_type cached_mtime_for_json( const std::filesystem::path
                 &json_source_path ) {
+            std::lock_guard<std::mutex> lk( mutex_ );
             auto it = cached_flexbuffers_.find( json_source_path.u8string() );
             if( it != cached_flexbuffers_.end() ) {
                 return it->second.mtime;
@@ -311,12 +692,6 @@ class flexbuffer_disk_cache
                 lexically_normal_json_source_path.lexically_relative(
                     root_path_ ).lexically_normal();
 
-            // Is there even a potential cached flexbuffer for this file.
-            auto disk_entry = cached_flexbuffers_.find( root_relative_source_path.u8string() );
-            if( disk_entry == cached_flexbuffers_.end() ) {
-                return storage;
-            }
-
             std::error_code ec;
             std::filesystem::file_time_type source_mtime = get_file_mtime_millis(
                         lexically_normal_json_source_path, ec );
@@ -324,6 +699,21 @@ class flexbuffer_disk_cache
                 return storage;
             }
 
+            std::lock_guard<std::mutex> lk( mutex_ );
+            // Is there even a potential cached flexbuffer for this file.
+            auto disk_entry = cached_flexbuffers_.find( root_relative_source_path.u8string() );
+            if( disk_entry == cached_flexbuffers_.end() ) {
+                // Another instance of the game may have cached it since this one started.
+                // Cached files only ever appear whole, see save_to_disk.
+                std::filesystem::path flexbuffer_path = cache_file_path(
+                        lexically_normal_json_source_path, source_mtime );
+                if( !file_exist( flexbuffer_path ) ) {
+                    return storage;
+                }
+                disk_entry = cached_flexbuffers_.emplace( root_relative_source_path.u8string(),
+                             disk_cache_entry{ std::move( flexbuffer_path ), source_mtime } ).first;
+            }
+
             // Does the source file's mtime match what we cached previously
             if( source_mtime != disk_entry->second.mtime ) {
                 std::string filepath_and_name = disk_entry->first;
@@ -332,13 +722,11 @@ class flexbuffer_disk_cache
                                        *root_relative_source_path.begin() != std::filesystem::u8path( "achievements" ) &&
                                        *root_relative_source_path.begin() != std::filesystem::u8path( "templates" );
                 if( stale_game_data ) {
-                    if( get_option<bool>( "WARN_ON_MODIFIED" ) ) {
-                        debugmsg( "Stale game data detected at %s, did you overwrite old files?  When updating the game you must install to a fresh folder, overwriting old files will cause errors.",
-                                  filepath_and_name );
+                    if( cata::thread_pool::on_worker_thread() ) {
+                        std::lock_guard<std::mutex> stale_lk( stale_mutex );
+                        stale_files.push_back( filepath_and_name );
                     } else {
-                        // we still log the modification warning even if the option is disabled, for sifting bug reports
-                        DebugLog( D_WARNING, D_MAIN ) << "Stale game data detected (error disabled by user): " <<
-                                                      filepath_and_name;
+                        report_stale( filepath_and_name );
                     }
                 }
                 // Cached flexbuffer on disk is out of date, remove it.
@@ -353,49 +741,73 @@ class flexbuffer_disk_cache
             if( !mmap_handle ) {
                 return storage;
             }
+            if( !verify_flexbuffer( static_cast<const uint8_t *>( mmap_handle->base() ),
+                                    mmap_handle->len() ) ) {
+                // Corrupt, the json gets parsed and cached again.
+                mmap_handle.reset();
+                remove_file( disk_entry->second.flexbuffer_path.u8string() );
+                cached_flexbuffers_.erase( disk_entry );
+                return storage;
+            }
 
             storage = std::make_shared<flexbuffer_mmap_storage>( mmap_handle );
 
             return storage;
         }
 
-        bool save_to_disk( const std::filesystem::path &lexically_normal_json_source_path,
-                           const std::vector<uint8_t> &flexbuffer_binary ) {
+        // Writes the flexbuffer to the cache, and returns a mapping of the written file so the
+        // caller can share its pages with other instances of the game instead of keeping its
+        // own copy.  Returns nullptr if it could not be written or mapped.
+        std::shared_ptr<flexbuffer_mmap_storage> save_to_disk(
+            const std::filesystem::path &lexically_normal_json_source_path,
+            const std::vector<uint8_t> &flexbuffer_binary ) {
             std::error_code ec;
             std::string json_source_path_string = lexically_normal_json_source_path.u8string();
             std::filesystem::file_time_type mtime = get_file_mtime_millis( lexically_normal_json_source_path,
                                                     ec );
             if( ec ) {
-                return false;
+                return nullptr;
             }
 
-            int64_t mtime_ms = std::chrono::duration_cast<std::chrono::milliseconds>
-                               ( mtime.time_since_epoch() ).count();
-
-            // Doing some variable reuse to avoid copies.
-            std::filesystem::path flexbuffer_path = ( cache_path_ /
-                                                    lexically_normal_json_source_path.lexically_relative(
-                                                            root_path_ ) ).remove_filename();
-
-            assure_dir_exist( flexbuffer_path );
-
-            std::filesystem::path flexbuffer_filename = lexically_normal_json_source_path.filename();
-            flexbuffer_filename += std::filesystem::u8path( "." + std::to_string( mtime_ms ) + ".fb" );
-            flexbuffer_path /= flexbuffer_filename;
-            std::ofstream fb( flexbuffer_path, std::ofstream::binary );
-            if( !fb.good() ) {
-                return false;
+            const std::filesystem::path flexbuffer_path = cache_file_path(
+                        lexically_normal_json_source_path, mtime );
+            assure_dir_exist( flexbuffer_path.parent_path() );
+
+            // Other instances may map the file as soon as it is there, so it is written aside
+            // and renamed into place.
+            const std::filesystem::path tmp_path = unique_tmp_path( flexbuffer_path );
+            {
+                std::ofstream fb( tmp_path, std::ofstream::binary );
+                if( fb.good() ) {
+                    fb.write( reinterpret_cast<const char *>( flexbuffer_binary.data() ),
+                              flexbuffer_binary.size() );
+                }
+                if( !fb.good() ) {
+                    fb.close();
+                    std::filesystem::remove( tmp_path, ec );
+                    return nullptr;
+                }
+            }
+            std::filesystem::rename( tmp_path, flexbuffer_path, ec );
+            if( ec ) {
+                std::filesystem::remove( tmp_path, ec );
+                return nullptr;
             }
 
-            fb.write( reinterpret_cast<const char *>( flexbuffer_binary.data() ), flexbuffer_binary.size() );
-            if( !fb.good() ) {
-                return false;
+            {
+                std::lock_guard<std::mutex> lk( mutex_ );
+                cached_flexbuffers_[json_source_path_string] = disk_cache_entry{ flexbuffer_path, mtime };
             }
 
-            fb.close();
-            cached_flexbuffers_[json_source_path_string] = disk_cache_entry{ flexbuffer_path, mtime };
+            std::shared_ptr<const mmap_file> mmap_handle = mmap_file::map_file( flexbuffer_path );
+            if( !mmap_handle || mmap_handle->len() != flexbuffer_binary.size() ) {
+                return nullptr;
+            }
+            return std::make_shared<flexbuffer_mmap_storage>( mmap_handle );
+        }
 
-            return true;
+        const std::filesystem::path &cache_path() const {
+            return cache_path_;
         }
 
     private:
@@ -403,6 +815,20 @@ class flexbuffer_disk_cache
                                         std::filesystem::path root_path ) : cache_path_{ std::move( cache_path ) },
             root_path_{ std::move( root_path ) } {}
 
+        // <cache>/<root relative path of the json>.<mtime in ms>.fb
+        std::filesystem::path cache_file_path(
+            const std::filesystem::path &lexically_normal_json_source_path,
+            std::filesystem::file_time_type mtime ) const {
+            const int64_t mtime_ms = std::chrono::duration_cast<std::chrono::milliseconds>
+                                     ( mtime.time_since_epoch() ).count();
+            std::filesystem::path flexbuffer_path = ( cache_path_ /
+                                                    lexically_normal_json_source_path.lexically_relative(
+                                                            root_path_ ) ).remove_filename();
+            std::filesystem::path flexbuffer_filename = lexically_normal_json_source_path.filename();
+            flexbuffer_filename += std::filesystem::u8path( "." + std::to_string( mtime_ms ) + ".fb" );
+            return flexbuffer_path / flexbuffer_filename;
+        }
+
         std::filesystem::path cache_path_;
         std::filesystem::path root_path_;
 
@@ -412,6 +838,8 @@ class flexbuffer_disk_cache
         };
         // Maps game root relative json source path to the most recent cached flexbuffer we have on disk for it.
         std::unordered_map<std::string, disk_cache_entry> cached_flexbuffers_;
+        // Files are parsed on the thread pool while data loads.
+        std::mutex mutex_;
 };
 
 flexbuffer_cache::flexbuffer_cache( const std::filesystem::path &cache_directory,
@@ -481,11 +909,13 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
     const char *json_text = reinterpret_cast<const char *>( json_source.c_str() ) + offset;
     std::vector<uint8_t> fb = parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
 
+    std::shared_ptr<flexbuffer_storage> storage;
     if( disk_cache_ ) {
-        disk_cache_->save_to_disk( lexically_normal_json_source_path, fb );
+        storage = disk_cache_->save_to_disk( lexically_normal_json_source_path, fb );
+    }
+    if( !storage ) {
+        storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
     }
-
-    auto storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
 
     std::error_code ec;
     std::filesystem::file_time_type mtime = std::filesystem::last_write_time(
@@ -505,3 +935,226 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_buffer( std::string b
     auto storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
     return std::make_shared<string_flexbuffer>( std::move( storage ), std::move( buffer ) );
 }
+
+namespace
+{
+
+// A pack starts with the magic, the number of files, and for each file the offset and size
+// of its buffer and its path.  The buffers follow, each at a multiple of kPackAlignment.
+constexpr std::array<char, 8> kPackMagic = { 'c', 'd', 'd', 'a', 'p', 'k', '0', '1' };
+constexpr size_t kPackAlignment = 8;
+
+struct pack_file {
+    std::filesystem::path path;
+    std::filesystem::file_time_type mtime;
+};
+
+// What names the pack of the files.  The first hash is of the paths alone, the second also of
+// the sizes and modification times, so the packs written for older versions of the same files
+// can be found and removed.
+std::optional<std::pair<uint64_t, uint64_t>> pack_key( const std::vector<std::filesystem::path>
+        &paths, std::vector<pack_file> &files )
+{
+    uint64_t paths_hash = 0;
+    uint64_t key = 0;
+    for( const std::filesystem::path &path : paths ) {
+        std::error_code ec;
+        const std::filesystem::file_time_type mtime = get_file_mtime_millis( path, ec );
+        const uint64_t size = std::filesystem::file_size( path, ec );
+        if( ec ) {
+            return std::nullopt;
+        }
+        const std::string name = path.generic_u8string();
+        const int64_t mtime_ms = std::chrono::duration_cast<std::chrono::milliseconds>
+                                 ( mtime.time_since_epoch() ).count();
+        paths_hash = XXH64( name.data(), name.size() + 1, paths_hash );
+        key = XXH64( name.data(), name.size() + 1, key );
+        key = XXH64( &size, sizeof( size ), key );
+        key = XXH64( &mtime_ms, sizeof( mtime_ms ), key );
+        files.push_back( pack_file{ path, mtime } );
+    }
+    return std::make_pair( paths_hash, key );
+}
+
+std::string pack_file_name( const std::pair<uint64_t, uint64_t> &key )
+{
+    return string_format( "%016llx.%016llx.pack", static_cast<unsigned long long>( key.first ),
+                          static_cast<unsigned long long>( key.second ) );
+}
+
+bool read_pack_uint( const uint8_t *base, size_t len, size_t &pos, uint64_t &out )
+{
+    if( len < sizeof( out ) || pos > len - sizeof( out ) ) {
+        return false;
+    }
+    memcpy( &out, base + pos, sizeof( out ) );
+    pos += sizeof( out );
+    return true;
+}
+
+void write_pack_uint( std::ostream &out, uint64_t value )
+{
+    out.write( reinterpret_cast<const char *>( &value ), sizeof( value ) );
+}
+
+} // namespace
+
+std::optional<std::vector<std::shared_ptr<parsed_flexbuffer>>> flexbuffer_cache::load_pack(
+            const std::vector<std::filesystem::path> &lexically_normal_json_source_paths )
+{
+    if( !disk_cache_ ) {
+        return std::nullopt;
+    }
+    std::vector<pack_file> files;
+    std::optional<std::pair<uint64_t, uint64_t>> key = pack_key( lexically_normal_json_source_paths,
+            files );
+    if( !key ) {
+        return std::nullopt;
+    }
+    const std::filesystem::path pack_path = disk_cache_->cache_path() / "packs" /
+                                            std::filesystem::u8path( pack_file_name( *key ) );
+    std::error_code ec;
+    if( !std::filesystem::exists( pack_path, ec ) ) {
+        return std::nullopt;
+    }
+    std::shared_ptr<const mmap_file> pack = mmap_file::map_file( pack_path );
+    if( !pack || pack->len() < kPackMagic.size() ) {
+        return std::nullopt;
+    }
+    const uint8_t *base = static_cast<const uint8_t *>( pack->base() );
+    const size_t len = pack->len();
+    if( memcmp( base, kPackMagic.data(), kPackMagic.size() ) != 0 ) {
+        return std::nullopt;
+    }
+    size_t pos = kPackMagic.size();
+    uint64_t count = 0;
+    if( !read_pack_uint( base, len, pos, count ) || count != files.size() ) {
+        return std::nullopt;
+    }
+    std::vector<shared_flexbuffer> buffers;
+    buffers.reserve( files.size() );
+    for( pack_file &file : files ) {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint64_t name_size = 0;
+        if( !read_pack_uint( base, len, pos, offset ) || !read_pack_uint( base, len, pos, size ) ||
+            !read_pack_uint( base, len, pos, name_size ) || name_size > len - pos ||
+            offset > len || size > len - offset || size == 0 ) {
+            return std::nullopt;
+        }
+        // The hash of the files matched, but the pack has to be of these very files.
+        const std::string name = file.path.generic_u8string();
+        if( std::string_view( reinterpret_cast<const char *>( base + pos ), name_size ) != name ) {
+            return std::nullopt;
+        }
+        pos += name_size;
+        // A corrupt pack is ignored, and written again once the files are parsed.
+        if( !verify_flexbuffer( base + offset, size ) ) {
+            return std::nullopt;
+        }
+        buffers.push_back( std::make_shared<file_flexbuffer>(
+                               std::make_shared<flexbuffer_pack_storage>( pack, offset, size ),
+                               std::move( file.path ), file.mtime, 0 ) );
+    }
+    return buffers;
+}
+
+bool flexbuffer_cache::save_pack( const std::vector<std::filesystem::path>
+                                  &lexically_normal_json_source_paths, const std::vector<shared_flexbuffer> &buffers )
+{
+    if( !disk_cache_ || buffers.size() != lexically_normal_json_source_paths.size() ) {
+        return false;
+    }
+    std::vector<pack_file> files;
+    std::optional<std::pair<uint64_t, uint64_t>> key = pack_key( lexically_normal_json_source_paths,
+            files );
+    if( !key ) {
+        return false;
+    }
+    const std::filesystem::path packs_dir = disk_cache_->cache_path() / "packs";
+    const std::string file_name = pack_file_name( *key );
+    assure_dir_exist( packs_dir );
+
+    std::vector<std::string> names;
+    size_t header_size = kPackMagic.size() + sizeof( uint64_t );
+    for( const pack_file &file : files ) {
+        names.push_back( file.path.generic_u8string() );
+        header_size += 3 * sizeof( uint64_t ) + names.back().size();
+    }
+    const auto align = []( size_t offset ) {
+        return ( offset + kPackAlignment - 1 ) / kPackAlignment * kPackAlignment;
+    };
+
+    const std::filesystem::path pack_path = packs_dir / std::filesystem::u8path( file_name );
+    const std::filesystem::path tmp_path = unique_tmp_path( pack_path );
+    {
+        std::ofstream out( tmp_path, std::ofstream::binary );
+        out.write( kPackMagic.data(), kPackMagic.size() );
+        write_pack_uint( out, files.size() );
+        size_t offset = align( header_size );
+        for( size_t i = 0; i < files.size(); ++i ) {
+            const size_t size = buffers[i]->get_storage()->size();
+            write_pack_uint( out, offset );
+            write_pack_uint( out, size );
+            write_pack_uint( out, names[i].size() );
+            out.write( names[i].data(), names[i].size() );
+            offset = align( offset + size );
+        }
+        size_t written = header_size;
+        for( const shared_flexbuffer &buffer : buffers ) {
+            const std::string padding( align( written ) - written, '\0' );
+            out.write( padding.data(), padding.size() );
+            const flexbuffer_storage &storage = *buffer->get_storage();
+            out.write( reinterpret_cast<const char *>( storage.data() ), storage.size() );
+            written = align( written ) + storage.size();
+        }
+        if( !out.good() ) {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove( tmp_path, ec );
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename( tmp_path, pack_path, ec );
+    if( ec ) {
+        return false;
+    }
+    // The packs of older versions of the same files are never used again.
+    const std::string prefix = file_name.substr( 0, file_name.find( '.' ) + 1 );
+    for( const std::filesystem::directory_entry &entry :
+         std::filesystem::directory_iterator( packs_dir, ec ) ) {
+        const std::string name = entry.path().filename().generic_u8string();
+        if( name != file_name && name.compare( 0, prefix.size(), prefix ) == 0 ) {
+            std::error_code remove_ec;
+            std::filesystem::remove( entry.path(), remove_ec );
+        }
+    }
+    return true;
+}
+
+void flexbuffer_cache::report_deferred_warnings()
+{
+    std::vector<std::string> stale;
+    {
+        std::lock_guard<std::mutex> lk( stale_mutex );
+        stale.swap( stale_files );
+    }
+    for( const std::string &filepath_and_name : stale ) {
+        report_stale( filepath_and_name );
+    }
+}
+
+std::vector<uint8_t> flexbuffer_cache::json_to_binary( const std::string &buffer )
+{
+    return parse_json_to_flexbuffer_( buffer.c_str(), nullptr );
+}
+
+std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::from_binary( std::vector<uint8_t> buffer )
+{
+    if( !verify_flexbuffer( buffer.data(), buffer.size() ) ) {
+        throw JsonError( "corrupt binary json data" );
+    }
+    auto storage = std::make_shared<flexbuffer_vector_storage>( std::move( buffer ) );
+    return std::make_shared<binary_flexbuffer>( std::move( storage ) );
+}
@@ -2,10 +2,16 @@
 #ifndef CATA_SRC_FLEXBUFFER_CACHE_H
 #define CATA_SRC_FLEXBUFFER_CACHE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <flatbuffers/flexbuffers.h>
 
@@ -16,6 +22,36 @@ struct flexbuffer_storage {
     virtual size_t size() const = 0;
 };
 
+/**
+ * A perfect hash of the keys of a flexbuffer map, so looking up a member of a map with many
+ * members costs one hash and one comparison instead of a binary search over the keys.
+ * Keys are hashed into buckets, and each bucket gets the displacement that moves all of its
+ * keys to free slots of a table twice the size of the map (hash and displace).
+ */
+class flexbuffer_key_index
+{
+    public:
+        // Maps with fewer keys are searched, which is as quick for them.
+        static constexpr size_t min_keys = 16;
+
+        // Returns nullptr if no perfect hash was found for the keys.
+        static std::unique_ptr<flexbuffer_key_index> build( const flexbuffers::TypedVector &keys );
+
+        // The index of the only key that can be equal to key.  The caller compares them.
+        size_t candidate( std::string_view key ) const;
+
+    private:
+        flexbuffer_key_index() = default;
+
+        static uint64_t hash( std::string_view key );
+        static size_t slot_of( uint64_t hash, uint32_t displacement, size_t slot_mask );
+
+        size_t bucket_mask_ = 0;
+        size_t slot_mask_ = 0;
+        std::vector<uint32_t> displacements_;
+        std::vector<uint16_t> slots_;
+};
+
 struct parsed_flexbuffer {
         parsed_flexbuffer() = delete;
 
@@ -38,10 +74,20 @@ struct parsed_flexbuffer {
             return storage_;
         }
 
+        // The key index of a map in this buffer, built the first time it is asked for.
+        // Returns nullptr for maps too small to be worth one.  Safe to call from any thread.
+        const flexbuffer_key_index *key_index( const flexbuffers::TypedVector &keys ) const;
+
     protected:
         explicit parsed_flexbuffer( std::shared_ptr<flexbuffer_storage> storage );
 
         std::shared_ptr<flexbuffer_storage> storage_;
+
+    private:
+        mutable std::mutex key_indexes_mutex_;
+        // By the address of the keys of the map.
+        mutable std::unordered_map<const uint8_t *, std::unique_ptr<flexbuffer_key_index>>
+        key_indexes_;
 };
 
 class flexbuffer_disk_cache;
@@ -64,6 +110,31 @@ class flexbuffer_cache
 
         static shared_flexbuffer parse_buffer( std::string buffer ) noexcept( false );
 
+        // Parses json text into the FlexBuffer binary form, so it can be stored and handed
+        // back to from_binary later without being parsed again.  Throws on parse errors.
+        static std::vector<uint8_t> json_to_binary( const std::string &buffer ) noexcept( false );
+        // Wraps a FlexBuffer made by json_to_binary.  Throws if the buffer is corrupt.
+        static shared_flexbuffer from_binary( std::vector<uint8_t> buffer ) noexcept( false );
+
+        // Files parse_and_cache can run on the thread pool, but the warnings it finds there
+        // wait for the main thread to call this.
+        static void report_deferred_warnings();
+
+        /**
+         * A pack holds the flexbuffers of all the json files of a data folder in a single file
+         * under the cache directory, so later launches map one file instead of looking up the
+         * cache of each.  It is only used for the exact same files with the same sizes and
+         * modification times it was written for.
+         *
+         * Returns the buffers of the files in order, or nothing if there is no such pack.
+         */
+        std::optional<std::vector<shared_flexbuffer>> load_pack(
+                    const std::vector<std::filesystem::path> &lexically_normal_json_source_paths );
+        // Writes the pack of the files from their parsed buffers, replacing the older packs of
+        // the same files.  Returns false if it could not be written.
+        bool save_pack( const std::vector<std::filesystem::path> &lexically_normal_json_source_paths,
+                        const std::vector<shared_flexbuffer> &buffers );
+
     private:
         flexbuffer_cache( flexbuffer_cache && ) noexcept = default;
 
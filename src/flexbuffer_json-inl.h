@@ -613,9 +613,8 @@ auto JsonArray::read( T &v, bool throw_on_error ) const -> decltype( v.front(),
 
 inline JsonValue JsonArray::operator[]( size_t idx ) const
 {
-    // Manually bsearch for the key idx to store in visited_fields_bitset_.
-    // flexbuffers::Map::operator[] will probably be faster but won't give us the idx,
-    // which we need to track visited fields.
+    // Look up the key idx ourselves to store in visited_fields_bitset_.
+    // flexbuffers::Map::operator[] won't give us the idx, which we need to track visited fields.
 
     if( idx < size_ ) {
         mark_visited( idx );
@@ -831,7 +830,7 @@ template<typename T, typename std::enable_if_t<std::is_convertible_v<T, std::str
 std::string JsonObject::get_string( const char *key, T &&fallback ) const
 {
     size_t idx = 0;
-    bool found = find_map_key_idx( key, keys_, idx );
+    bool found = find_member_idx( key, idx );
     if( found ) {
         return get_string( key );
     }
@@ -959,7 +958,7 @@ inline std::set<std::string> JsonObject::get_as_string_set( const std::string &n
 inline bool JsonObject::has_member( const std::string_view key ) const
 {
     size_t idx;
-    return find_map_key_idx( key, keys_, idx );
+    return find_member_idx( key, idx );
 }
 
 inline bool JsonObject::has_null( const std::string_view key ) const
@@ -1042,7 +1041,7 @@ inline bool JsonObject::get_bool( const std::string_view key, bool fallback ) co
 inline std::optional<JsonValue> JsonObject::get_member_opt( const std::string_view key ) const
 {
     size_t idx = 0;
-    bool found = find_map_key_idx( key, keys_, idx );
+    bool found = find_member_idx( key, idx );
     if( found ) {
         mark_visited( idx );
         return JsonValue{ root_, values_[ idx ], &path_, idx };
@@ -1052,11 +1051,10 @@ inline std::optional<JsonValue> JsonObject::get_member_opt( const std::string_vi
 
 inline JsonValue JsonObject::get_member( const std::string_view key ) const
 {
-    // Manually bsearch for the key idx to store in visited_fields_bitset_.
-    // flexbuffers::Map::operator[] will probably be faster but won't give us the idx,
-    // which we need to track visited fields.
+    // Look up the key idx ourselves to store in visited_fields_bitset_.
+    // flexbuffers::Map::operator[] won't give us the idx, which we need to track visited fields.
     size_t idx = 0;
-    bool found = find_map_key_idx( key, keys_, idx );
+    bool found = find_member_idx( key, idx );
     if( found ) {
         mark_visited( idx );
         return JsonValue{ root_, values_[ idx ], &path_, idx };
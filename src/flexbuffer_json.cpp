@@ -1,9 +1,18 @@
 #include "flexbuffer_json.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "cata_unreachable.h"
 #include "filesystem.h"
@@ -12,13 +21,129 @@
 namespace
 {
 std::atomic_bool report_unvisited_members{true};
+
+struct member_counts {
+    uint64_t lookups = 0;
+    uint64_t failed = 0;
+    std::chrono::nanoseconds time{ 0 };
+    std::chrono::nanoseconds failed_time{ 0 };
+};
+
+// Each thread records into its own table, so the lock of a table is only ever contended
+// while the tables are read or reset.
+struct thread_member_stats {
+    std::mutex mutex;
+    // By type, then by member.
+    std::map<std::string, std::map<std::string, member_counts, std::less<>>, std::less<>> counts;
+};
+
+std::mutex all_member_stats_mutex;
+// Tables outlive their threads, so what was loaded on the thread pool is still there.
+std::vector<std::shared_ptr<thread_member_stats>> all_member_stats;
+
+thread_member_stats &local_member_stats()
+{
+    thread_local const std::shared_ptr<thread_member_stats> local = []() {
+        std::shared_ptr<thread_member_stats> stats = std::make_shared<thread_member_stats>();
+        std::lock_guard<std::mutex> lk( all_member_stats_mutex );
+        all_member_stats.push_back( stats );
+        return stats;
+    }();
+    return *local;
+}
+
+thread_local std::string_view member_stats_type;
 } // namespace
 
+std::atomic_bool JsonObject::record_member_stats_{ false };
+
 bool Json::globally_report_unvisited_members( bool do_report )
 {
     return report_unvisited_members.exchange( do_report );
 }
 
+bool JsonObject::globally_record_member_stats( bool do_record )
+{
+    return record_member_stats_.exchange( do_record );
+}
+
+std::vector<json_member_stat> JsonObject::member_stats()
+{
+    std::map<std::pair<std::string, std::string>, member_counts> merged;
+    {
+        std::lock_guard<std::mutex> all_lk( all_member_stats_mutex );
+        for( const std::shared_ptr<thread_member_stats> &stats : all_member_stats ) {
+            std::lock_guard<std::mutex> lk( stats->mutex );
+            for( const auto &[type, members] : stats->counts ) {
+                for( const auto &[member, counts] : members ) {
+                    member_counts &total = merged[std::make_pair( type, member )];
+                    total.lookups += counts.lookups;
+                    total.failed += counts.failed;
+                    total.time += counts.time;
+                    total.failed_time += counts.failed_time;
+                }
+            }
+        }
+    }
+    std::vector<json_member_stat> result;
+    result.reserve( merged.size() );
+    for( const auto &[key, counts] : merged ) {
+        result.push_back( json_member_stat{ key.first, key.second, counts.lookups, counts.failed,
+                                            counts.time, counts.failed_time } );
+    }
+    std::stable_sort( result.begin(), result.end(), []( const json_member_stat & lhs,
+    const json_member_stat & rhs ) {
+        return lhs.time > rhs.time;
+    } );
+    return result;
+}
+
+void JsonObject::reset_member_stats()
+{
+    std::lock_guard<std::mutex> all_lk( all_member_stats_mutex );
+    for( const std::shared_ptr<thread_member_stats> &stats : all_member_stats ) {
+        std::lock_guard<std::mutex> lk( stats->mutex );
+        stats->counts.clear();
+    }
+}
+
+JsonObject::member_stats_scope::member_stats_scope( std::string_view type )
+    : previous_( member_stats_type )
+{
+    member_stats_type = type;
+}
+
+JsonObject::member_stats_scope::~member_stats_scope()
+{
+    member_stats_type = previous_;
+}
+
+bool JsonObject::find_member_idx_recorded( const std::string_view key, size_t &idx ) const
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const bool found = find_member_idx_unrecorded( key, idx );
+    const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+    thread_member_stats &stats = local_member_stats();
+    std::lock_guard<std::mutex> lk( stats.mutex );
+    auto type_it = stats.counts.find( member_stats_type );
+    if( type_it == stats.counts.end() ) {
+        type_it = stats.counts.emplace( member_stats_type, decltype( type_it->second )() ).first;
+    }
+    auto member_it = type_it->second.find( key );
+    if( member_it == type_it->second.end() ) {
+        member_it = type_it->second.emplace( key, member_counts() ).first;
+    }
+    member_counts &counts = member_it->second;
+    ++counts.lookups;
+    counts.time += elapsed;
+    if( !found ) {
+        ++counts.failed;
+        counts.failed_time += elapsed;
+    }
+    return found;
+}
+
 const std::string &Json::flexbuffer_type_to_string( flexbuffers::Type t )
 {
     static const std::array<std::string, 36> type_map = { {
@@ -2,9 +2,14 @@
 #ifndef CATA_SRC_FLEXBUFFER_JSON_H
 #define CATA_SRC_FLEXBUFFER_JSON_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include <flatbuffers/flexbuffers.h>
 
@@ -523,12 +528,30 @@ class JsonMember : public JsonValue
         flexbuffers::String name_;
 };
 
+// How often and for how long JsonObjects looked up a member, counted while
+// JsonObject::globally_record_member_stats is on.
+struct json_member_stat {
+    // The type of the object loaded when it was looked up, empty outside of a member_stats_scope.
+    std::string type;
+    std::string member;
+    uint64_t lookups = 0;
+    // Lookups of the member in objects that did not have it, included in lookups.
+    uint64_t failed = 0;
+    std::chrono::nanoseconds time{ 0 };
+    std::chrono::nanoseconds failed_time{ 0 };
+};
+
 class JsonObject : JsonWithPath
 {
     protected:
         flexbuffers::TypedVector keys_ = flexbuffers::TypedVector::EmptyTypedVector();
         flexbuffers::Vector values_ = flexbuffers::Vector::EmptyVector();
         mutable tiny_bitset visited_fields_bitset_;
+        // Fetched from the root on the first lookup in a map with many keys.
+        mutable const flexbuffer_key_index *key_index_ = nullptr;
+        mutable bool key_index_fetched_ = false;
+
+        static std::atomic_bool record_member_stats_;
 
         static const auto &empty_object_() {
             // NOLINTNEXTLINE(cata-almost-never-auto)
@@ -583,6 +606,8 @@ class JsonObject : JsonWithPath
             flexbuffers::Map json_map = json.AsMap();
             keys_ = json_map.Keys();
             values_ = json_map.Values();
+            key_index_ = nullptr;
+            key_index_fetched_ = false;
             if( moved_visited_fields ) {
                 using namespace std;
                 swap( visited_fields_bitset_, *moved_visited_fields );
@@ -668,6 +693,26 @@ class JsonObject : JsonWithPath
             visited_fields_bitset_ = rhs.visited_fields_bitset_;
         }
 
+        // Atomically sets whether member lookups are counted and timed. Returns the prior value.
+        // Recording slows loading down, so it is meant for finding where loading spends its time.
+        static bool globally_record_member_stats( bool do_record );
+        // What was recorded on all threads so far, the longest total time first.
+        static std::vector<json_member_stat> member_stats();
+        static void reset_member_stats();
+
+        // Lookups on this thread are recorded under the given type while this is alive.
+        class member_stats_scope
+        {
+            public:
+                // The type must outlive the scope.
+                explicit member_stats_scope( std::string_view type );
+                ~member_stats_scope();
+                member_stats_scope( const member_stats_scope & ) = delete;
+                member_stats_scope &operator=( const member_stats_scope & ) = delete;
+            private:
+                std::string_view previous_;
+        };
+
         using Json::str;
 
         class const_iterator;
@@ -683,13 +728,38 @@ class JsonObject : JsonWithPath
         // NOLINTNEXTLINE(cata-large-inline-function)
         flexbuffers::Reference find_value_ref( const std::string_view key ) const {
             size_t idx = 0;
-            bool found = find_map_key_idx( key, keys_, idx );
+            bool found = find_member_idx( key, idx );
             if( found ) {
                 return values_[ idx ];
             }
             return flexbuffers::Reference();
         }
 
+        // NOLINTNEXTLINE(cata-large-inline-function)
+        bool find_member_idx( const std::string_view key, size_t &idx ) const {
+            if( record_member_stats_.load( std::memory_order_relaxed ) ) {
+                return find_member_idx_recorded( key, idx );
+            }
+            return find_member_idx_unrecorded( key, idx );
+        }
+
+        // NOLINTNEXTLINE(cata-large-inline-function)
+        bool find_member_idx_unrecorded( const std::string_view key, size_t &idx ) const {
+            if( keys_.size() >= flexbuffer_key_index::min_keys ) {
+                if( !key_index_fetched_ ) {
+                    key_index_ = root_->key_index( keys_ );
+                    key_index_fetched_ = true;
+                }
+                if( key_index_ ) {
+                    idx = key_index_->candidate( key );
+                    return idx < keys_.size() && std::string_view( keys_[ idx ].AsKey() ) == key;
+                }
+            }
+            return find_map_key_idx( key, keys_, idx );
+        }
+
+        bool find_member_idx_recorded( std::string_view key, size_t &idx ) const;
+
         // NOLINTNEXTLINE(cata-large-inline-function)
         static bool find_map_key_idx( const std::string_view key, const flexbuffers::TypedVector &keys,
                                       size_t &idx ) {
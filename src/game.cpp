@@ -1,6 +1,7 @@
 #include "game.h"
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <chrono>
 #include <climits>
@@ -69,6 +70,7 @@
 #include "clzones.h"
 #include "colony.h"
 #include "color.h"
+#include "compression_dictionary.h"
 #include "condition.h"
 #include "computer.h"
 #include "computer_session.h"
@@ -170,6 +172,7 @@
 #include "past_achievements_info.h"
 #include "path_info.h"
 #include "pathfinding.h"
+#include "perf.h"
 #include "pickup.h"
 #include "player_activity.h"
 #include "popup.h"
@@ -180,6 +183,7 @@
 #include "ret_val.h"
 #include "rng.h"
 #include "safemode_ui.h"
+#include "save_writer.h"
 #include "scenario.h"
 #include "scent_map.h"
 #include "scores_ui.h"
@@ -371,6 +375,10 @@ static const trait_id trait_WAYFARER( "WAYFARER" );
 static const zone_type_id zone_type_LOOT_CUSTOM( "LOOT_CUSTOM" );
 static const zone_type_id zone_type_NO_AUTO_PICKUP( "NO_AUTO_PICKUP" );
 
+static const option_handle<bool> option_autosafemode( "AUTOSAFEMODE" );
+static const option_handle<int> option_autosafemode_turns( "AUTOSAFEMODETURNS" );
+static const option_handle<int> option_safemode_proximity( "SAFEMODEPROXIMITY" );
+
 #if defined(TILES)
 #include "cata_tiles.h"
 #endif // TILES
@@ -1396,6 +1404,7 @@ void game::remove_npc( character_id const &id )
     } );
     if( it != active_npc.end() ) {
         active_npc.erase( it );
+        critter_tracker->sees_memo_.clear();
     }
 }
 
@@ -3208,8 +3217,52 @@ bool game::load( const std::string &world )
     return true;
 }
 
+// How long each stage of a save or load took, and what the zzips did meanwhile.
+struct save_load_metrics {
+    std::vector<std::pair<std::string, std::chrono::microseconds>> stages;
+    zzip::io_stats zzip_io;
+    bool in_background = false;
+};
+static save_load_metrics last_save_metrics;
+static save_load_metrics last_load_metrics;
+
+static std::string describe_metrics( const std::string_view what,
+                                     const save_load_metrics &metrics )
+{
+    if( metrics.stages.empty() ) {
+        return string_format( "%s: none yet\n", what );
+    }
+    constexpr uint64_t kib = 1024;
+    std::chrono::microseconds total( 0 );
+    std::string stages;
+    for( const auto &[name, duration] : metrics.stages ) {
+        stages += string_format( "  %s: %d ms\n", name, duration.count() / 1000 );
+        total += duration;
+    }
+    const zzip::io_stats &z = metrics.zzip_io;
+    std::string out = string_format( "%s: %d ms%s\n", what, total.count() / 1000,
+                                     metrics.in_background ? ", map files written in the background not counted" : "" );
+    out += stages;
+    out += string_format( "  zzip entries written: %d, %d KiB raw, %d KiB compressed, %d ms\n",
+                          z.entries_written, z.bytes_written / kib, z.compressed_bytes_written / kib,
+                          z.write_us / 1000 );
+    out += string_format( "  zzip entries read: %d, %d KiB, %d ms\n", z.entries_read,
+                          z.bytes_read / kib, z.read_us / 1000 );
+    out += string_format( "  zzips compacted: %d, %d KiB reclaimed\n", z.compactions,
+                          z.compacted_bytes / kib );
+    return out;
+}
+
+std::string game::describe_save_load_metrics() const
+{
+    return describe_metrics( "Last save", last_save_metrics ) +
+           describe_metrics( "Last load", last_load_metrics );
+}
+
 bool game::load( const save_t &name )
 {
+    // The last save may still be writing the files we are about to read
+    get_save_writer().flush();
     map &here = get_map();
 
     const cata_path worldpath = PATH_INFO::world_base_save_path();
@@ -3364,14 +3417,22 @@ bool game::load( const save_t &name )
         }
     };
 
+    save_load_metrics metrics;
+    const zzip::io_stats zzip_before = zzip::get_io_stats();
     for( const named_entry &e : entries ) {
         loading_ui::show( _( "Loading the save…" ), e.first );
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         e.second();
+        metrics.stages.emplace_back( e.first, std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::steady_clock::now() - start ) );
         if( abort ) {
             loading_ui::done();
             return false;
         }
     }
+    metrics.zzip_io = zzip::get_io_stats().since( zzip_before );
+    last_load_metrics = metrics;
+    DebugLog( D_INFO, D_GAME ) << describe_metrics( "Load", metrics );
 
     loading_ui::done();
     return true;
@@ -3462,6 +3523,9 @@ void game::reset_npc_dispositions()
 //Saves all factions and missions and npcs.
 bool game::save_factions_missions_npcs()
 {
+    // Before the global overmap state is written, which counts its unique specials, so the
+    // overmap placing them is saved with it.
+    overmap_buffer.complete_pregeneration();
     cata_path masterfile = PATH_INFO::world_base_save_path() / SAVE_MASTER;
     return write_to_file( masterfile, [&]( std::ostream & fout ) {
         serialize_master( fout );
@@ -3476,6 +3540,9 @@ bool game::save_maps()
         here.save();
         overmap_buffer.save(); // can throw
         MAPBUFFER.save(); // can throw
+        if( world_generator->active_world->has_compression_enabled() ) {
+            compression_dictionary::retrain_if_due();
+        }
         return true;
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
@@ -3626,27 +3693,181 @@ spell_events &game::spell_events_subscriber()
     return *spell_events_ptr;
 }
 
-bool game::save()
+namespace
+{
+
+// What the quads were last written as and the overmaps last saved as, see
+// mapbuffer::written_hashes and overmapbuffer::saved_hashes.
+struct save_hashes {
+    std::unordered_map<tripoint_abs_omt, uint64_t> quads;
+    std::unordered_map<point_abs_om, std::array<uint64_t, 3>> overmaps;
+};
+
+save_hashes current_written_hashes()
+{
+    return { MAPBUFFER.written_hashes(), overmap_buffer.saved_hashes() };
+}
+
+// The report of a forked save: what it changed of the hashes, one line per quad or overmap.
+std::string describe_written_hash_changes( const save_hashes &before,
+        const save_hashes &after )
+{
+    std::ostringstream out;
+    out.imbue( std::locale::classic() );
+    const auto write_quad = [&out]( const tripoint_abs_omt & p, uint64_t hash ) {
+        out << "q " << p.x() << ' ' << p.y() << ' ' << p.z() << ' ' << hash << '\n';
+    };
+    for( const auto &[p, hash] : after.quads ) {
+        const auto it = before.quads.find( p );
+        if( it == before.quads.end() || it->second != hash ) {
+            write_quad( p, hash );
+        }
+    }
+    for( const auto &[p, hash] : before.quads ) {
+        if( after.quads.count( p ) == 0 ) {
+            write_quad( p, 0 );
+        }
+    }
+    for( const auto &[p, hashes] : after.overmaps ) {
+        const auto it = before.overmaps.find( p );
+        if( it == before.overmaps.end() || it->second != hashes ) {
+            out << "o " << p.x() << ' ' << p.y() << ' ' << hashes[0] << ' ' << hashes[1] << ' ' <<
+                hashes[2] << '\n';
+        }
+    }
+    // Marks the report as complete.
+    out << "end\n";
+    return out.str();
+}
+
+bool parse_written_hash_changes( const std::string &report, save_hashes &changes )
+{
+    std::istringstream in( report );
+    in.imbue( std::locale::classic() );
+    std::string kind;
+    while( in >> kind ) {
+        if( kind == "end" ) {
+            return true;
+        }
+        if( kind == "q" ) {
+            int x = 0;
+            int y = 0;
+            int z = 0;
+            uint64_t hash = 0;
+            if( !( in >> x >> y >> z >> hash ) ) {
+                return false;
+            }
+            changes.quads[tripoint_abs_omt( x, y, z )] = hash;
+        } else if( kind == "o" ) {
+            int x = 0;
+            int y = 0;
+            std::array<uint64_t, 3> hashes;
+            if( !( in >> x >> y >> hashes[0] >> hashes[1] >> hashes[2] ) ) {
+                return false;
+            }
+            changes.overmaps[point_abs_om( x, y )] = hashes;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void game::take_over_forked_save()
 {
+    std::optional<save_writer::fork_result> result = get_save_writer().take_fork_result();
+    if( !result ) {
+        return;
+    }
+    save_hashes changes;
+    if( !result->saved || !parse_written_hash_changes( result->report, changes ) ||
+        !MAPBUFFER.update_written( changes.quads ) ) {
+        // What the copy wrote is unknown, so the next save writes everything again.
+        MAPBUFFER.forget_written();
+        overmap_buffer.forget_saved_hashes();
+        return;
+    }
+    overmap_buffer.update_saved_hashes( changes.overmaps );
+}
+
+bool game::save( const bool in_background )
+{
+    // Only one save at a time, and failures of the last one are reported now
+    get_save_writer().flush();
+    take_over_forked_save();
     std::chrono::seconds time_since_load =
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::steady_clock::now() - time_of_last_load );
     std::chrono::seconds total_time_played = time_played_at_last_load + time_since_load;
     events().send<event_type::game_save>( time_since_load, total_time_played );
+    // A copy of the process writes the save as it is now while this one plays on.
+    // Only used in the copy, which reports what it wrote for take_over_forked_save.
+    save_hashes before_fork;
+    if( in_background && get_option<bool>( "FORK_SAVES" ) &&
+    get_save_writer().run_in_fork( [this, total_time_played, &before_fork]() {
+    before_fork = current_written_hashes();
+    return write_save( total_time_played, false );
+    }, _( "the game" ), [&before_fork]() {
+        return describe_written_hash_changes( before_fork, current_written_hashes() );
+    } ) ) {
+        // The copy writes what saving would unload, only the unloading is left to do here.
+        MAPBUFFER.track_written_changes();
+        MAPBUFFER.drop_outside_reality_bubble();
+        u.drop_far_map_memory();
+        world_generator->last_world_name = world_generator->active_world->world_name;
+        world_generator->last_character_name = u.name;
+        world_generator->active_world->add_save( save_t::from_save_id( u.get_save_id() ) );
+        return true;
+    }
+    return write_save( total_time_played, in_background );
+}
+
+bool game::write_save( const std::chrono::seconds total_time_played, const bool in_background )
+{
+    save_load_metrics metrics;
+    metrics.in_background = in_background;
+    const zzip::io_stats zzip_before = zzip::get_io_stats();
+    const auto stage = [&metrics]( const std::string & name, const std::function<bool()> &save ) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const bool saved = save();
+        metrics.stages.emplace_back( name, std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::steady_clock::now() - start ) );
+        return saved;
+    };
     try {
-        if( !save_player_data() ||
-            !save_achievements() ||
-            !save_factions_missions_npcs() ||
-            !save_maps() ||
-            !get_auto_pickup().save_character() ||
-            !get_auto_notes_settings().save( true ) ||
-            !get_safemode().save_character() ||
-            !zone_manager::get_manager().save_zones() ||
-            !write_to_file( PATH_INFO::world_base_save_path() / "uistate.json", [&](
-        std::ostream & fout ) {
-        JsonOut jsout( fout );
-            uistate.serialize( jsout );
-        }, _( "uistate data" ) ) ) {
+        const bool saved =
+        stage( "player", [this]() {
+            return save_player_data();
+        } ) &&
+        stage( "achievements", [this]() {
+            return save_achievements();
+        } ) &&
+        stage( "factions, missions and npcs", [this]() {
+            return save_factions_missions_npcs();
+        } ) &&
+        stage( "maps", [this]() {
+            return save_maps();
+        } ) &&
+        stage( "character settings", []() {
+            return get_auto_pickup().save_character() &&
+                   get_auto_notes_settings().save( true ) &&
+                   get_safemode().save_character() &&
+                   zone_manager::get_manager().save_zones() &&
+                   write_to_file( PATH_INFO::world_base_save_path() / "uistate.json", [&](
+            std::ostream & fout ) {
+                JsonOut jsout( fout );
+                uistate.serialize( jsout );
+            }, _( "uistate data" ) );
+        } ) &&
+        ( in_background || stage( "waiting for writes", []() {
+            return get_save_writer().flush();
+        } ) );
+        metrics.zzip_io = zzip::get_io_stats().since( zzip_before );
+        last_save_metrics = metrics;
+        DebugLog( D_INFO, D_GAME ) << describe_metrics( "Save", metrics );
+        if( !saved ) {
             debugmsg( "game not saved" );
             return false;
         } else {
@@ -4152,6 +4373,7 @@ void game::draw( ui_adaptor &ui )
     if( test_mode ) {
         return;
     }
+    cata_timer timer( "draw" );
 
     ter_view_p.z() = ( u.pos_bub() + u.view_offset ).z();
     here.build_map_cache( ter_view_p.z() );
@@ -4467,8 +4689,8 @@ character_id game::assign_npc_id()
 
 Creature *game::is_hostile_nearby()
 {
-    int distance = ( get_option<int>( "SAFEMODEPROXIMITY" ) <= 0 ) ? MAX_VIEW_DISTANCE :
-                   get_option<int>( "SAFEMODEPROXIMITY" );
+    int distance = ( option_safemode_proximity() <= 0 ) ? MAX_VIEW_DISTANCE :
+                   option_safemode_proximity();
     return is_hostile_within( distance );
 }
 
@@ -4631,7 +4853,7 @@ void game::mon_info_update( )
     const tripoint_bub_ms pos = u.pos_bub( here );
 
     int newseen = 0;
-    const int safe_proxy_dist = get_option<int>( "SAFEMODEPROXIMITY" );
+    const int safe_proxy_dist = option_safemode_proximity();
     const int iProxyDist = ( safe_proxy_dist <= 0 ) ? MAX_VIEW_DISTANCE :
                            safe_proxy_dist;
 
@@ -4830,11 +5052,11 @@ void game::mon_info_update( )
         if( safe_mode == SAFE_MODE_ON ) {
             set_safe_mode( SAFE_MODE_STOP );
         }
-    } else if( calendar::turn > previous_turn && get_option<bool>( "AUTOSAFEMODE" ) &&
+    } else if( calendar::turn > previous_turn && option_autosafemode() &&
                newseen == 0 ) { // Auto safe mode, but only if it's a new turn
         turnssincelastmon += calendar::turn - previous_turn;
         time_duration auto_safe_mode =
-            time_duration::from_turns( get_option<int>( "AUTOSAFEMODETURNS" ) );
+            time_duration::from_turns( option_autosafemode_turns() );
         if( turnssincelastmon >= auto_safe_mode && safe_mode == SAFE_MODE_OFF ) {
             set_safe_mode( SAFE_MODE_ON );
             add_msg( m_info, _( "Safe mode ON!" ) );
@@ -4853,9 +5075,13 @@ void game::cleanup_dead()
 {
     map &here = get_map();
 
+    // Monsters that run out of hp from here on are left for the next call.
+    const bool look_for_dead_monsters = critter_died;
+    critter_died = false;
+
     // Dead monsters need to stay in the tracker until everything else that needs to die does so
     // This is because dying monsters can still interact with other dying monsters (@ref Creature::killer)
-    bool monster_is_dead = critter_tracker->kill_marked_for_death();
+    bool monster_is_dead = look_for_dead_monsters && critter_tracker->kill_marked_for_death();
 
     bool npc_is_dead = false;
     // can't use all_npcs as that does not include dead ones
@@ -4882,9 +5108,8 @@ void game::cleanup_dead()
                 ++it;
             }
         }
+        critter_tracker->sees_memo_.clear();
     }
-
-    critter_died = false;
 }
 
 /* Knockback target at t by force number of tiles in direction from s to t
@@ -5299,7 +5524,7 @@ monster *game::place_critter_around( const mtype_id &id, const tripoint_bub_ms &
     if( id.is_null() ) {
         return nullptr;
     }
-    shared_ptr_fast<monster> mon = make_shared_fast<monster>( id );
+    shared_ptr_fast<monster> mon = make_pooled_shared_fast<monster>( id );
     mon->ammo = mon->type->starting_ammo;
     return place_critter_around( mon, center, radius );
 }
@@ -5340,7 +5565,7 @@ monster *game::place_critter_within( const mtype_id &id,
     if( id.is_null() ) {
         return nullptr;
     }
-    shared_ptr_fast<monster> mon = make_shared_fast<monster>( id );
+    shared_ptr_fast<monster> mon = make_pooled_shared_fast<monster>( id );
     mon->ammo = mon->type->starting_ammo;
     return place_critter_within( mon, range );
 }
@@ -5507,7 +5732,7 @@ bool game::spawn_hallucination( const tripoint_bub_ms &p, const mtype_id &mt,
         return false;
     }
 
-    const shared_ptr_fast<monster> phantasm = make_shared_fast<monster>( mt );
+    const shared_ptr_fast<monster> phantasm = make_pooled_shared_fast<monster>( mt );
     phantasm->hallucination = true;
     phantasm->spawn( p );
     if( lifespan.has_value() ) {
@@ -5713,9 +5938,9 @@ bool game::revive_corpse( const tripoint_bub_ms &p, item &it, int radius )
     shared_ptr_fast<monster> newmon_ptr;
     if( it.has_var( "zombie_form" ) ) {
         // the monster was not a zombie but turns into one when its corpse is revived
-        newmon_ptr = make_shared_fast<monster>( mtype_id( it.get_var( "zombie_form" ) ) );
+        newmon_ptr = make_pooled_shared_fast<monster>( mtype_id( it.get_var( "zombie_form" ) ) );
     } else {
-        newmon_ptr = make_shared_fast<monster>( it.get_mtype()->id );
+        newmon_ptr = make_pooled_shared_fast<monster>( it.get_mtype()->id );
     }
     monster &critter = *newmon_ptr;
     critter.init_from_item( it );
@@ -9582,7 +9807,7 @@ game::vmenu_ret game::list_monsters( const std::vector<Creature *> &monster_list
                 const monster *m = dynamic_cast<monster *>( cCurMon );
                 const std::string monName = ( m != nullptr ) ? m->name() : "human";
 
-                get_safemode().add_rule( monName, Creature::Attitude::ANY, get_option<int>( "SAFEMODEPROXIMITY" ),
+                get_safemode().add_rule( monName, Creature::Attitude::ANY, option_safemode_proximity(),
                                          rule_state::BLACKLISTED );
             }
         } else if( action == "look" ) {
@@ -13128,6 +13353,16 @@ point_rel_sm game::update_map( int &x, int &y, bool z_level_changed )
     // Update what parts of the world map we can see
     update_overmap_seen();
 
+    // Start reading the submaps the map is heading into, further ahead the faster the vehicle.
+    int prefetch_depth = 1;
+    if( const optional_vpart_position vp = here.veh_at( u.pos_bub() ); vp && u.in_vehicle ) {
+        // Roughly one submap a turn per 25 mph.
+        prefetch_depth += std::min( std::abs( vp->vehicle().velocity ) / 2500, 3 );
+    }
+    here.prefetch_ahead( shift, prefetch_depth );
+    // Mapgen goes an overmap terrain further, so what it makes is never read from the disk.
+    here.queue_generation_ahead( shift, prefetch_depth + 2 );
+
     return shift;
 }
 
@@ -13419,6 +13654,8 @@ void game::debug_hour_timer::toggle()
 {
     enabled = !enabled;
     start_time = std::nullopt;
+    cata_timer::collecting() = enabled;
+    effect_on_conditions::profiling() = enabled;
     add_msg( string_format( "debug timer %s", enabled ? "enabled" : "disabled" ) );
 }
 
@@ -13430,9 +13667,46 @@ void game::debug_hour_timer::print_time()
                                       std::chrono::steady_clock::now() );
             if( start_time ) {
                 add_msg( "in-game hour took: %d ms", ( now - *start_time ).count() );
+                // The phases of do_turn and drawing timed by cata_timer, slowest first.
+                std::vector<const cata_timer::timer_stats *> phases;
+                for( const auto &[name, stats] : cata_timer::get_stats() ) {
+                    phases.push_back( &stats );
+                }
+                std::sort( phases.begin(), phases.end(),
+                []( const cata_timer::timer_stats * a, const cata_timer::timer_stats * b ) {
+                    return a->duration > b->duration;
+                } );
+                for( const cata_timer::timer_stats *stats : phases ) {
+                    add_msg( "  %s: %d ms (%d calls)", stats->name, stats->duration / 1000, stats->count );
+                }
+                cata_timer::print_stats();
+                const map::cache_invalidation_counts &inv = map::invalidation_counts();
+                add_msg( "  cache invalidations: transparency %d (%d points), seen %d (%d points), "
+                         "outside %d, floor %d, pathfinding %d (%d points), whole level %d",
+                         inv.transparency, inv.transparency_points, inv.seen, inv.seen_points,
+                         inv.outside, inv.floor, inv.pathfinding, inv.pathfinding_points,
+                         inv.whole_level );
+                // The eocs that took longest, with the eocs they ran; all of them go to the log.
+                const std::vector<std::pair<effect_on_condition_id, effect_on_conditions::eoc_profile>>
+                        eocs = effect_on_conditions::get_profile();
+                for( size_t i = 0; i < eocs.size(); ++i ) {
+                    const effect_on_conditions::eoc_profile &p = eocs[i].second;
+                    const std::string line = string_format(
+                                                 "  eoc %s: %d us (%d runs), conditions %d us (%d checks)", eocs[i].first.str(),
+                                                 p.time.count() / 1000, p.activations, p.condition_time.count() / 1000,
+                                                 p.condition_checks );
+                    if( i < 5 ) {
+                        add_msg( line );
+                    }
+                    DebugLog( D_INFO, D_GAME ) << line;
+                }
             } else {
                 add_msg( "starting debug timer" );
             }
+            // No timer runs here, do_turn is between its phases.
+            cata_timer::reset_stats();
+            map::invalidation_counts() = map::cache_invalidation_counts();
+            effect_on_conditions::reset_profile();
             start_time = now;
         }
     }
@@ -13498,8 +13772,8 @@ void game::quicksave()
 
     time_t now = std::time( nullptr ); //timestamp for start of saving procedure
 
-    //perform save
-    save();
+    //perform save, leaving the maps to be written while play goes on
+    save( true );
     //Now reset counters for autosaving, so we don't immediately autosave after a quicksave or autosave.
     moves_since_last_save = 0;
     last_save_timestamp = now;
@@ -246,8 +246,24 @@ class game
         void unserialize_impl( const JsonObject &data );
     public:
 
-        /** Returns false if saving failed. */
-        bool save();
+        /**
+         * Returns false if saving failed.  In the background, map and overmap files are
+         * still being written when this returns, and failures to write them are reported
+         * later.
+         */
+        bool save( bool in_background = false );
+        /**
+         * Once a save written by a forked copy finished, take over what it wrote, so the next
+         * save only writes what changed since.  Called every turn.
+         */
+        void take_over_forked_save();
+    private:
+        // Writes everything save() saves.
+        bool write_save( std::chrono::seconds total_time_played, bool in_background );
+    public:
+
+        /** Describes how long each stage of the last save and load took and what they wrote. */
+        std::string describe_save_load_metrics() const;
 
         /** Returns a list of currently active character saves. */
         std::vector<std::string> list_active_saves();
@@ -1092,7 +1108,8 @@ class game
         void display_radiation(); // Displays radiation map
         void display_transparency(); // Displays transparency map
 
-        // prints the IRL time in ms of the last full in-game hour
+        // prints the IRL time in ms of the last full in-game hour, the part of it taken by
+        // each phase timed by cata_timer, and the slowest effect_on_conditions
         class debug_hour_timer
         {
             public:
@@ -4,6 +4,8 @@
 #include "output.h"
 #include "wcwidth.h"
 
+bool string_id_cache_frozen = false;
+
 bool one_char_symbol_reader( const JsonObject &jo, std::string_view member_name, int &sym,
                              bool )
 {
@@ -130,6 +130,12 @@ const my_class &string_id<my_class>::obj() const
 \endcode
 */
 
+/**
+ * While set, lookups leave the int_id cached in each string_id alone, so that several threads
+ * may look ids up at once.  Only change it while no lookup runs.
+ */
+extern bool string_id_cache_frozen;
+
 template<typename T>
 class generic_factory
 {
@@ -167,11 +173,15 @@ class generic_factory
             // map lookup happens at most once per string_id instance per generic_factory::version
             // id was not found, explicitly marking it as "invalid"
             if( iter == map.end() ) {
-                id.set_cid_version( INVALID_CID, version );
+                if( !string_id_cache_frozen ) {
+                    id.set_cid_version( INVALID_CID, version );
+                }
                 return false;
             }
             result = iter->second;
-            id.set_cid_version( result.to_i(), version );
+            if( !string_id_cache_frozen ) {
+                id.set_cid_version( result.to_i(), version );
+            }
             return true;
         }
 
@@ -506,6 +516,14 @@ class generic_factory
             int_id<T> dummy;
             return find_id( id, dummy );
         }
+        /**
+         * Returns the object with the given id, or nullptr if there is none.
+         * Unlike calling is_valid and then obj, this looks the id up only once.
+         */
+        const T *find( const string_id<T> &id ) const {
+            int_id<T> i_id;
+            return find_id( id, i_id ) ? &list[i_id.to_i()] : nullptr;
+        }
         /**
          * Converts string_id<T> to int_id<T>. Returns null_id on failure.
          * When optional flag warn is true, issues a warning if `id` is not found and null_id was returned.
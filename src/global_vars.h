@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_GLOBAL_VARS_H
 #define CATA_SRC_GLOBAL_VARS_H
 
+#include <cstdint>
+
 #include "math_parser_diag_value.h"
 
 #include "json.h"
@@ -23,6 +25,7 @@ class global_variables
 
         void remove_global_value( const std::string &key ) {
             global_values.erase( key );
+            ++generation;
         }
 
         diag_value const *maybe_get_global_value( const std::string &key ) const {
@@ -45,6 +48,8 @@ class global_variables
         }
 
         impl_t &get_global_values() {
+            // May be erased from by the caller.
+            ++generation;
             return global_values;
         }
 
@@ -54,10 +59,20 @@ class global_variables
 
         void clear_global_values() {
             global_values.clear();
+            ++generation;
         }
 
         void set_global_values( impl_t input ) {
             global_values = std::move( input );
+            ++generation;
+        }
+
+        /**
+         * Changes whenever values may have been erased.  Until then the values found stay where
+         * they are, even as others are set, so lookups by name can be skipped by keeping them.
+         */
+        uint64_t get_generation() const {
+            return generation;
         }
         void unserialize( const JsonObject &jo );
         void serialize( JsonOut &jsout ) const;
@@ -67,6 +82,8 @@ class global_variables
 
     private:
         impl_t global_values;
+        // Starts past the generation of pointers kept before any lookup.
+        uint64_t generation = 1; // NOLINT(cata-serialize)
 };
 global_variables &get_globals();
 
@@ -2,12 +2,23 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 #include "achievement.h"
@@ -22,8 +33,10 @@
 #include "bodygraph.h"
 #include "bodypart.h"
 #include "butchery_requirements.h"
+#include "cached_options.h"
 #include "cata_assert.h"
 #include "cata_scope_helpers.h"
+#include "cata_thread_pool.h"
 #include "character_modifier.h"
 #include "city.h"
 #include "climbing.h"
@@ -49,8 +62,10 @@
 #include "field_type.h"
 #include "filesystem.h"
 #include "flag.h"
+#include "flexbuffer_cache.h"
 #include "flexbuffer_json.h"
 #include "gates.h"
+#include "generic_factory.h"
 #include "global_vars.h"
 #include "harvest.h"
 #include "help.h"
@@ -91,6 +106,7 @@
 #include "overmap.h"
 #include "overmap_connection.h"
 #include "overmap_location.h"
+#include "perf.h"
 #include "profession.h"
 #include "profession_group.h"
 #include "proficiency.h"
@@ -127,12 +143,50 @@
 #include "sdltiles.h"
 #endif
 
-DynamicDataLoader::DynamicDataLoader()
+namespace
+{
+
+// Types that no other type reads or adds to while loading, and that only need to be there
+// once loading finishes, so their objects load on the thread pool alongside the rest.
+// Snippets are not among them, as items add their own snippets while they load.
+const std::set<std::string> &background_types()
+{
+    static const std::set<std::string> types = {
+        "achievement", "conduct", "event_statistic", "event_transformation", "help", "score",
+    };
+    return types;
+}
+
+} // namespace
+
+struct DynamicDataLoader::background_object {
+    std::string type;
+    JsonObject jo;
+    std::string src;
+    cata_path base_path;
+    cata_path full_path;
+    check_plural_t check_plural;
+};
+
+struct DynamicDataLoader::background_loading {
+    std::mutex mutex;
+    std::deque<background_object> queue;
+    // Set while drain_background is queued or running.
+    bool running = false;
+    std::future<void> done;
+    std::vector<deferred_debugmsg> messages;
+    std::exception_ptr error;
+};
+
+DynamicDataLoader::DynamicDataLoader() : background( std::make_unique<background_loading>() )
 {
     initialize();
 }
 
-DynamicDataLoader::~DynamicDataLoader() = default;
+DynamicDataLoader::~DynamicDataLoader()
+{
+    finish_background_loading( false );
+}
 
 DynamicDataLoader &DynamicDataLoader::get_instance()
 {
@@ -149,9 +203,121 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
     if( it == type_function_map.end() ) {
         jo.throw_error_at( "type", "unrecognized JSON object" );
     }
+    if( loading_types != nullptr ) {
+        loading_types->insert( type );
+    }
+    if( background_batch != nullptr && background_types().count( type ) ) {
+        background_object &queued = background_batch->emplace_back( background_object{
+            type, jo, src, base_path, full_path, check_plural } );
+        queued.jo.copy_visited_members( jo );
+        jo.allow_omitted_members();
+        return;
+    }
+    JsonObject::member_stats_scope stats_scope( type );
+    cata_timer timer( type );
     it->second( jo, src, base_path, full_path );
 }
 
+void DynamicDataLoader::load_in_background( std::vector<background_object> &&batch )
+{
+    if( batch.empty() ) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk( background->mutex );
+        if( background->error ) {
+            // Loading already failed, so what comes after it is not loaded either.
+            for( background_object &obj : batch ) {
+                obj.jo.allow_omitted_members();
+            }
+            return;
+        }
+        std::move( batch.begin(), batch.end(), std::back_inserter( background->queue ) );
+        if( background->running ) {
+            return;
+        }
+        background->running = true;
+    }
+    // Without workers this runs right here, so the lock must not be held.
+    std::future<void> done = cata::get_thread_pool().submit( [this]() {
+        drain_background();
+    } );
+    std::lock_guard<std::mutex> lk( background->mutex );
+    background->done = std::move( done );
+}
+
+void DynamicDataLoader::drain_background()
+{
+    cata_timer timer( "background loading" );
+    while( true ) {
+        std::optional<background_object> next;
+        {
+            std::lock_guard<std::mutex> lk( background->mutex );
+            if( background->queue.empty() ) {
+                background->running = false;
+                return;
+            }
+            next.emplace( std::move( background->queue.front() ) );
+            background->queue.pop_front();
+        }
+        std::vector<deferred_debugmsg> messages;
+        std::exception_ptr error;
+        defer_debugmsg_during( [&]() {
+            // Destroyed in here, as it reports its unvisited members.
+            background_object obj = std::move( *next );
+            next.reset();
+            try {
+                restore_on_out_of_scope restore_check_plural( check_plural );
+                check_plural = obj.check_plural;
+                JsonObject::member_stats_scope stats_scope( obj.type );
+                cata_timer type_timer( obj.type );
+                type_function_map.at( obj.type )( obj.jo, obj.src, obj.base_path, obj.full_path );
+            } catch( ... ) {
+                obj.jo.allow_omitted_members();
+                error = std::current_exception();
+            }
+        }, messages );
+        std::lock_guard<std::mutex> lk( background->mutex );
+        std::move( messages.begin(), messages.end(), std::back_inserter( background->messages ) );
+        if( error ) {
+            background->error = error;
+            for( background_object &obj : background->queue ) {
+                obj.jo.allow_omitted_members();
+            }
+            background->queue.clear();
+            background->running = false;
+            return;
+        }
+    }
+}
+
+void DynamicDataLoader::finish_background_loading( const bool report_errors )
+{
+    std::future<void> done;
+    {
+        std::lock_guard<std::mutex> lk( background->mutex );
+        done = std::move( background->done );
+    }
+    // Only this thread queues objects, so nothing is left once the last drain finished.
+    if( done.valid() ) {
+        done.wait();
+    }
+    std::vector<deferred_debugmsg> messages;
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lk( background->mutex );
+        messages.swap( background->messages );
+        std::swap( error, background->error );
+    }
+    if( !report_errors ) {
+        return;
+    }
+    report_deferred_debugmsg( messages );
+    if( error ) {
+        std::rethrow_exception( error );
+    }
+}
+
 struct DynamicDataLoader::cached_streams {
     lru_cache<std::string, shared_ptr_fast<std::istringstream>> cache;
 };
@@ -472,6 +638,57 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+void DynamicDataLoader::load_files( const std::vector<cata_path> &files, const std::string &src,
+                                    const cata_path &base_path )
+{
+    cata_timer timer( "loading " + src );
+    // Unchanged files were all parsed into a single pack on an earlier launch.
+    if( std::optional<std::vector<JsonValue>> packed = json_loader::from_pack( files ) ) {
+        for( size_t i = 0; i < files.size(); ++i ) {
+            try {
+                load_file( ( *packed )[i], src, base_path, files[i] );
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( err.what() );
+            }
+        }
+        return;
+    }
+    // Parsing a file does not depend on any other, but loading the objects in it may depend on
+    // the files before it.  So the next few files are parsed on the pool while this thread
+    // loads the objects of the current one, and parse errors come up in file order.
+    cata::thread_pool &pool = cata::get_thread_pool();
+    const size_t parse_ahead = static_cast<size_t>( pool.num_workers() ) * 2 + 1;
+    std::deque<std::future<JsonValue>> parsed;
+    size_t next_to_parse = 0;
+    // Nothing may be left parsing into the caches when this returns or throws.
+    on_out_of_scope wait_for_parsing( [&parsed]() {
+        for( std::future<JsonValue> &jsin : parsed ) {
+            jsin.wait();
+        }
+    } );
+    for( const cata_path &file : files ) {
+        while( next_to_parse < files.size() && parsed.size() < parse_ahead ) {
+            parsed.push_back( pool.submit( [&file = files[next_to_parse]]() {
+                return json_loader::from_path( file );
+            } ) );
+            ++next_to_parse;
+        }
+        std::future<JsonValue> next = std::move( parsed.front() );
+        parsed.pop_front();
+        try {
+            JsonValue jsin = next.get();
+            flexbuffer_cache::report_deferred_warnings();
+            load_file( jsin, src, base_path, file );
+        } catch( const JsonError &err ) {
+            throw std::runtime_error( err.what() );
+        }
+    }
+    // A single file is no faster to load from a pack.
+    if( files.size() > 1 ) {
+        json_loader::save_pack( files );
+    }
+}
+
 void DynamicDataLoader::load_data_from_path( const cata_path &path, const std::string &src )
 {
     cata_assert( !finalized &&
@@ -490,16 +707,7 @@ void DynamicDataLoader::load_data_from_path( const cata_path &path, const std::s
         files.emplace_back( path );
     }
 
-    // iterate over each file
-    for( const cata_path &file : files ) {
-        try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file );
-            load_all_from_json( jsin, src, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
-    }
+    load_files( files, src, path );
 }
 
 void DynamicDataLoader::load_mod_data_from_path( const cata_path &path, const std::string &src )
@@ -523,16 +731,7 @@ void DynamicDataLoader::load_mod_data_from_path( const cata_path &path, const st
         files.emplace_back( path );
     }
 
-    // iterate over each file
-    for( const cata_path &file : files ) {
-        try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file );
-            load_all_from_json( jsin, src, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
-    }
+    load_files( files, src, path );
 }
 
 void DynamicDataLoader::load_mod_interaction_files_from_path( const cata_path &path,
@@ -567,7 +766,7 @@ void DynamicDataLoader::load_mod_interaction_files_from_path( const cata_path &p
         try {
             // parse it
             JsonValue jsin = json_loader::from_path( file.second );
-            load_all_from_json( jsin, string_format( "%s#%s", src, file.first.str() ), path, file.second );
+            load_file( jsin, string_format( "%s#%s", src, file.first.str() ), path, file.second );
         } catch( const JsonError &err ) {
             throw std::runtime_error( err.what() );
         }
@@ -594,9 +793,138 @@ void DynamicDataLoader::load_all_from_json( const JsonValue &jsin, const std::st
     inp_mngr.pump_events();
 }
 
+void DynamicDataLoader::load_file( const JsonValue &jsin, const std::string &src,
+                                   const cata_path &base_path, const cata_path &file )
+{
+    loaded_file loaded{ file, src, base_path, {}, {} };
+    std::error_code ec;
+    loaded.mtime = std::filesystem::last_write_time( file.get_unrelative_path(), ec );
+    std::vector<background_object> batch;
+    loading_types = &loaded.types;
+    background_batch = &batch;
+    on_out_of_scope stop_noting( [this, &batch]() {
+        loading_types = nullptr;
+        background_batch = nullptr;
+        for( background_object &obj : batch ) {
+            obj.jo.allow_omitted_members();
+        }
+    } );
+    load_all_from_json( jsin, src, base_path, file );
+    load_in_background( std::move( batch ) );
+    batch.clear();
+    loaded_files.emplace_back( std::move( loaded ) );
+}
+
+namespace
+{
+
+// Types whose objects nothing else holds on to but by id and that need no finalization, so
+// reload_changed_data can reset and load them again on their own.
+const std::map<std::string, std::function<void()>> &reloadable_types()
+{
+    static const std::map<std::string, std::function<void()>> types = {
+        { "ascii_art", &ascii_art::reset },
+        { "dream", []() { dreams.clear(); } },
+        { "talk_topic", &unload_talk_topics },
+    };
+    return types;
+}
+
+// Calls func on every object in the contents of a data file.
+void for_each_object( const JsonValue &jsin, const std::function<void( const JsonObject & )> &func )
+{
+    if( jsin.test_object() ) {
+        func( jsin.get_object() );
+    } else if( jsin.test_array() ) {
+        for( JsonObject jo : jsin.get_array() ) {
+            func( jo );
+        }
+    } else {
+        jsin.throw_error( "expected object or array" );
+    }
+}
+
+} // namespace
+
+bool DynamicDataLoader::reload_changed_data()
+{
+    cata_assert( finalized && "Only finalized data can be reloaded." );
+    // Files changed since they were loaded, with their new contents.
+    std::map<size_t, JsonValue> changed;
+    std::set<std::string> types;
+    for( size_t i = 0; i < loaded_files.size(); ++i ) {
+        const loaded_file &file = loaded_files[i];
+        std::error_code ec;
+        const std::filesystem::file_time_type mtime =
+            std::filesystem::last_write_time( file.path.get_unrelative_path(), ec );
+        if( ec ) {
+            return false;
+        }
+        if( mtime == file.mtime ) {
+            continue;
+        }
+        JsonValue jsin = json_loader::from_path( file.path );
+        types.insert( file.types.begin(), file.types.end() );
+        for_each_object( jsin, [&types]( const JsonObject & jo ) {
+            jo.allow_omitted_members();
+            types.insert( jo.get_string( "type", "" ) );
+        } );
+        changed.emplace( i, std::move( jsin ) );
+    }
+    for( const std::string &type : types ) {
+        if( reloadable_types().count( type ) == 0 ) {
+            return false;
+        }
+    }
+    if( changed.empty() ) {
+        return true;
+    }
+
+    for( const std::string &type : types ) {
+        reloadable_types().at( type )();
+    }
+    // Talk topics declare their inline eocs again, which replace the ones loaded before.
+    effect_on_conditions::reloading_inline_eocs() = true;
+    on_out_of_scope stop_reloading_eocs( []() {
+        effect_on_conditions::reloading_inline_eocs() = false;
+    } );
+    // The files are loaded again in their order, as the objects in each may override or copy
+    // from those in the files before it.
+    for( size_t i = 0; i < loaded_files.size(); ++i ) {
+        loaded_file &file = loaded_files[i];
+        const auto new_contents = changed.find( i );
+        const bool has_reset_type = std::any_of( file.types.begin(), file.types.end(),
+        [&types]( const std::string & type ) {
+            return types.count( type ) > 0;
+        } );
+        if( new_contents == changed.end() && !has_reset_type ) {
+            continue;
+        }
+        const JsonValue jsin = new_contents != changed.end() ? new_contents->second :
+                               json_loader::from_path( file.path );
+        std::set<std::string> file_types;
+        for_each_object( jsin, [&]( const JsonObject & jo ) {
+            const std::string type = jo.get_string( "type", "" );
+            file_types.insert( type );
+            if( types.count( type ) > 0 ) {
+                load_object( jo, file.src, file.base_path, file.path );
+            } else {
+                jo.allow_omitted_members();
+            }
+        } );
+        file.types = std::move( file_types );
+        std::error_code ec;
+        file.mtime = std::filesystem::last_write_time( file.path.get_unrelative_path(), ec );
+    }
+    return true;
+}
+
 void DynamicDataLoader::unload_data()
 {
+    // Whatever went wrong in the background was about the data thrown away here.
+    finish_background_loading( false );
     finalized = false;
+    loaded_files.clear();
 
     achievement::reset();
     activity_type::reset();
@@ -737,6 +1065,10 @@ void DynamicDataLoader::finalize_loaded_data()
         stream_cache.reset();
     } );
     stream_cache = std::make_unique<cached_streams>();
+    {
+        cata_timer timer( "waiting for background loading" );
+        finish_background_loading( true );
+    }
 
     using named_entry = std::pair<std::string, std::function<void()>>;
     const std::vector<named_entry> entries = {{
@@ -811,12 +1143,17 @@ void DynamicDataLoader::finalize_loaded_data()
         }
     };
 
-    for( const named_entry &e : entries ) {
-        loading_ui::show( _( "Finalizing" ), e.first );
-        e.second();
+    {
+        cata_timer timer( "finalizing" );
+        for( const named_entry &e : entries ) {
+            loading_ui::show( _( "Finalizing" ), e.first );
+            cata_timer entry_timer( e.first );
+            e.second();
+        }
     }
 
     if( !get_option<bool>( "SKIP_VERIFICATION" ) ) {
+        cata_timer timer( "verifying" );
         check_consistency();
     }
     finalized = true;
@@ -824,17 +1161,24 @@ void DynamicDataLoader::finalize_loaded_data()
 
 void DynamicDataLoader::check_consistency()
 {
-    using named_entry = std::pair<std::string, std::function<void()>>;
-    const std::vector<named_entry> entries = {{
+    struct check_entry {
+        std::string name;
+        std::function<void()> check;
+        // Only reads the loaded data, so it may run at the same time as the other such checks.
+        // Checks that construct items stay serial, as that draws from the global RNG.
+        // No check depends on what another one found.
+        bool concurrent = false;
+    };
+    const std::vector<check_entry> entries = {{
             { _( "Flags" ), &json_flag::check_consistency },
             { _( "Option sliders" ), &option_slider::check_consistency },
             {
                 _( "Crafting requirements" ), []()
                 {
                     requirement_data::check_consistency();
-                }
+                }, true
             },
-            { _( "Vitamins" ), &vitamin::check_consistency },
+            { _( "Vitamins" ), &vitamin::check_consistency, true },
             { _( "Weather types" ), &weather_types::check_consistency },
             { _( "Weapon categories" ), &weapon_category::verify_weapon_categories },
             { _( "Effect on conditions" ), &effect_on_conditions::check_consistency },
@@ -842,13 +1186,14 @@ void DynamicDataLoader::check_consistency()
             { _( "Field type migrations" ), &field_type_migrations::check },
             { _( "Ammo effects" ), &ammo_effects::check_consistency },
             { _( "Emissions" ), &emit::check_consistency },
-            { _( "Effect types" ), &effect_type::check_consistency },
+            { _( "Effect types" ), &effect_type::check_consistency, true },
             { _( "Activities" ), &activity_type::check_consistency },
             { _( "Addiction types" ), &add_type::check_add_types },
+            // Builds items from groups, which rolls the global RNG.
             { _( "Items" ), &items::check_consistency },
-            { _( "Materials" ), &materials::check },
+            { _( "Materials" ), &materials::check, true },
             { _( "Faults" ), &faults::check_consistency },
-            { _( "Vehicle parts" ), &vehicles::parts::check },
+            { _( "Vehicle parts" ), &vehicles::parts::check, true },
             { _( "Vehicle part migrations" ), &vpart_migration::check },
             { _( "Mapgen definitions" ), &check_mapgen_definitions },
             { _( "Mapgen palettes" ), &mapgen_palette::check_definitions },
@@ -859,15 +1204,15 @@ void DynamicDataLoader::check_consistency()
                 }
             },
             { _( "Monster groups" ), &MonsterGroupManager::check_group_definitions },
-            { _( "Furniture and terrain" ), &check_furniture_and_terrain },
+            { _( "Furniture and terrain" ), &check_furniture_and_terrain, true },
             { _( "Furniture and terrain migrations" ), &ter_furn_migrations::check },
             { _( "Constructions" ), &check_constructions },
-            { _( "Crafting recipes" ), &recipe_dictionary::check_consistency },
-            { _( "Professions" ), &profession::check_definitions },
+            { _( "Crafting recipes" ), &recipe_dictionary::check_consistency, true },
+            { _( "Professions" ), &profession::check_definitions, true },
             { _( "Profession groups" ), &profession_group::check_profession_group_consistency },
             { _( "Martial arts" ), &check_martialarts },
             { _( "Climbing aid" ), &climbing_aid::check_consistency },
-            { _( "Mutations" ), &mutation_branch::check_consistency },
+            { _( "Mutations" ), &mutation_branch::check_consistency, true },
             { _( "Mutation categories" ), &mutation_category_trait::check_consistency },
             { _( "Mod migrations" ), &mod_migrations::check },
             { _( "Region settings" ), check_region_settings },
@@ -881,10 +1226,10 @@ void DynamicDataLoader::check_consistency()
             { _( "Map extras" ), &MapExtras::check_consistency },
             { _( "Shop rates" ), &shopkeeper_cons_rates::check_all },
             { _( "Start locations" ), &start_locations::check_consistency },
-            { _( "Ammunition types" ), &ammunition_type::check_consistency },
-            { _( "Traps" ), &trap::check_consistency },
+            { _( "Ammunition types" ), &ammunition_type::check_consistency, true },
+            { _( "Traps" ), &trap::check_consistency, true },
             { _( "Trap migrations" ), &trap_migrations::check },
-            { _( "Bionics" ), &bionic_data::check_bionic_consistency },
+            { _( "Bionics" ), &bionic_data::check_bionic_consistency, true },
             { _( "Gates" ), &gates::check },
             { _( "NPC classes" ), &npc_class::check_consistency },
             { _( "Behaviors" ), &behavior::check_consistency },
@@ -895,12 +1240,12 @@ void DynamicDataLoader::check_consistency()
                     item_action_generator::generator().check_consistency();
                 }
             },
-            { _( "Harvest lists" ), &harvest_list::check_consistency },
+            { _( "Harvest lists" ), &harvest_list::check_consistency, true },
             { _( "NPC templates" ), &npc_template::check_consistency },
-            { _( "Body parts" ), &body_part_type::check_consistency },
+            { _( "Body parts" ), &body_part_type::check_consistency, true },
             { _( "Body graphs" ), &bodygraph::check_all },
             { _( "Anatomies" ), &anatomy::check_consistency },
-            { _( "Spells" ), &spell_type::check_consistency },
+            { _( "Spells" ), &spell_type::check_consistency, true },
             { _( "Transformations" ), &event_transformation::check_consistency },
             { _( "Statistics" ), &event_statistic::check_consistency },
             { _( "Scent types" ), &scent_type::check_scent_consistency },
@@ -912,8 +1257,44 @@ void DynamicDataLoader::check_consistency()
         }
     };
 
-    for( const named_entry &e : entries ) {
-        loading_ui::show( _( "Verifying" ), e.first );
-        e.second();
+    // The concurrent checks run first, spread over the thread pool.  The debug messages they
+    // make are kept, and reported in list order once all of them finished.  Id lookups don't
+    // write their caches meanwhile, as the checks share many of the ids.
+    std::vector<const check_entry *> concurrent;
+    for( const check_entry &e : entries ) {
+        if( e.concurrent ) {
+            concurrent.push_back( &e );
+        }
+    }
+    std::vector<std::vector<deferred_debugmsg>> messages( concurrent.size() );
+    std::vector<std::exception_ptr> errors( concurrent.size() );
+    loading_ui::show( _( "Verifying" ), _( "Independent checks" ) );
+    {
+        cata_timer timer( "independent checks" );
+        string_id_cache_frozen = true;
+        on_out_of_scope thaw_string_ids( []() {
+            string_id_cache_frozen = false;
+        } );
+        cata::get_thread_pool().parallel_for( 0, static_cast<int>( concurrent.size() ), [&]( int i ) {
+            try {
+                defer_debugmsg_during( concurrent[i]->check, messages[i] );
+            } catch( ... ) {
+                errors[i] = std::current_exception();
+            }
+        } );
+    }
+    for( size_t i = 0; i < concurrent.size(); ++i ) {
+        report_deferred_debugmsg( messages[i] );
+        if( errors[i] ) {
+            std::rethrow_exception( errors[i] );
+        }
+    }
+
+    for( const check_entry &e : entries ) {
+        if( !e.concurrent ) {
+            loading_ui::show( _( "Verifying" ), e.name );
+            cata_timer timer( e.name );
+            e.check();
+        }
     }
 }
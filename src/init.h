@@ -2,11 +2,13 @@
 #ifndef CATA_SRC_INIT_H
 #define CATA_SRC_INIT_H
 
+#include <filesystem>
 #include <functional>
 #include <iosfwd>
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string> // IWYU pragma: keep
 #include <utility>
 #include <vector>
@@ -65,6 +67,27 @@ class DynamicDataLoader
     private:
         bool finalized = false;
 
+        // A data file loaded since the last unload, as reload_changed_data needs to know.
+        struct loaded_file {
+            cata_path path;
+            std::string src;
+            cata_path base_path;
+            std::filesystem::file_time_type mtime;
+            // The types of the objects in it.
+            std::set<std::string> types;
+        };
+        std::vector<loaded_file> loaded_files;
+        // Where load_object notes the types it loads, while loading a file.
+        std::set<std::string> *loading_types = nullptr;
+
+        // An object of a type nothing else needs while loading (see background_types in
+        // init.cpp), queued to be loaded on the thread pool while the rest loads here.
+        struct background_object;
+        struct background_loading;
+        std::unique_ptr<background_loading> background;
+        // Where load_object queues such objects, while loading a file.
+        std::vector<background_object> *background_batch = nullptr;
+
         struct cached_streams;
 
         std::unique_ptr<cached_streams> stream_cache;
@@ -108,6 +131,25 @@ class DynamicDataLoader
         void load_object( const JsonObject &jo, const std::string &src,
                           const cata_path &base_path = cata_path{},
                           const cata_path &full_path = cata_path{} );
+        /**
+         * Load the files one after another, in order, while the thread pool parses the
+         * files after them.
+         * @throws std::exception on all kind of errors.
+         */
+        void load_files( const std::vector<cata_path> &files, const std::string &src,
+                         const cata_path &base_path );
+        // load_all_from_json for a whole data file, which is noted in loaded_files.
+        void load_file( const JsonValue &jsin, const std::string &src, const cata_path &base_path,
+                        const cata_path &file );
+        // Hands the objects queued while loading a file to the thread pool, in order.
+        void load_in_background( std::vector<background_object> &&batch );
+        // Runs on the thread pool until nothing is left queued.
+        void drain_background();
+        /**
+         * Waits for the objects loaded in the background, and reports the debug messages
+         * they raised.  Rethrows the first error loading them threw, if report_errors.
+         */
+        void finish_background_loading( bool report_errors );
 
         DynamicDataLoader();
         ~DynamicDataLoader();
@@ -178,6 +220,18 @@ class DynamicDataLoader
         void finalize_loaded_data();
         /*@}*/
 
+        /**
+         * Reloads the data files changed since they were loaded, for data developers.
+         * Only works if every object in them, before and after the change, is of a type
+         * nothing else holds on to but by id and that needs no finalization, such as dialogue.
+         * Those types are reset and loaded again from all the loaded files.  Changes to any
+         * other type, removed files and files new to a folder need the data unloaded and
+         * loaded again.
+         * @return false, without changing anything, if that is needed.
+         * @throws std::exception on all kind of errors.
+         */
+        bool reload_changed_data();
+
         /**
          * Loads and then removes entries from @param data
          */
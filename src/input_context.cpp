@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <fstream>
 #include <iterator>
 #include <memory>
 #include <optional>
@@ -14,6 +16,7 @@
 #include <utility>
 
 #include "action.h"
+#include "calendar.h"
 #include "cata_imgui.h"
 #include "cata_utility.h"
 #include "catacharset.h"
@@ -21,6 +24,7 @@
 #include "coordinates.h"
 #include "cuboid_rectangle.h"
 #include "cursesdef.h"
+#include "debug.h"
 #include "game.h"
 #include "help.h"
 #include "imgui/imgui.h"
@@ -426,6 +430,35 @@ std::string input_context::describe_key_and_name( const std::string &action_desc
     return get_desc( action_descriptor, get_action_name( action_descriptor ), evt_filter );
 }
 
+// Where record_actions writes the handled actions, not open if it was not called.
+static std::ofstream &action_record()
+{
+    static std::ofstream record;
+    return record;
+}
+
+void input_context::record_actions( const std::string &filename, const unsigned int seed )
+{
+    std::ofstream &record = action_record();
+    record.open( filename, std::ios::out | std::ios::trunc );
+    if( !record ) {
+        debugmsg( "Could not open %s to record the actions to", filename );
+        return;
+    }
+    record << "seed\t" << seed << '\n' << std::flush;
+}
+
+static std::chrono::steady_clock::duration &waited_for_input()
+{
+    static std::chrono::steady_clock::duration waited( 0 );
+    return waited;
+}
+
+std::chrono::steady_clock::duration input_context::time_waiting_for_input()
+{
+    return waited_for_input();
+}
+
 const std::string &input_context::handle_input()
 {
     return handle_input( timeout );
@@ -441,7 +474,9 @@ const std::string &input_context::handle_input( const int timeout )
     const std::string *result = &CATA_ERROR;
     while( true ) {
 
+        const std::chrono::steady_clock::time_point wait_start = std::chrono::steady_clock::now();
         next_action = inp_mngr.get_input_event( preferred_keyboard_mode );
+        waited_for_input() += std::chrono::steady_clock::now() - wait_start;
         if( next_action.type == input_event_t::timeout ) {
             result = &TIMEOUT;
             break;
@@ -488,6 +523,16 @@ const std::string &input_context::handle_input( const int timeout )
         // enters something proper.
     }
     inp_mngr.set_timeout( old_timeout );
+    std::ofstream &record = action_record();
+    if( record.is_open() && result != &TIMEOUT && result != &CATA_ERROR ) {
+        // Flushed so the actions before a hang or a crash are not lost.
+        record << to_turns<int>( calendar::turn - calendar::turn_zero ) << '\t' << category << '\t'
+               << *result;
+        if( result == &ANY_INPUT ) {
+            record << '\t' << next_action.long_description();
+        }
+        record << std::endl;
+    }
     return *result;
 }
 
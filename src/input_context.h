@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <map>
 #include <optional>
@@ -291,6 +292,17 @@ class input_context
         const std::string &handle_input();
         const std::string &handle_input( int timeout );
 
+        /**
+         * Appends every action returned by `handle_input()` from now on to the file, one
+         * "turn, category, action" line each, after a first line with the rng seed, which
+         * --engine-seed takes back.  Together with a copy of the save it was started on this
+         * lets the steps leading to a slowdown be repeated.
+         */
+        static void record_actions( const std::string &filename, unsigned int seed );
+
+        /** Time `handle_input()` spent waiting for input, summed since the start. */
+        static std::chrono::steady_clock::duration time_waiting_for_input();
+
         /**
          * Convert a direction action (UP, DOWN etc) to a delta vector.
          *
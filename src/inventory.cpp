@@ -975,12 +975,12 @@ units::volume inventory::volume_without( const std::map<const item *, int> &with
 int inventory::count_item( const itype_id &item_type ) const
 {
     int num = 0;
-    const itype_bin bin = get_binned_items();
-    if( bin.find( item_type ) == bin.end() ) {
+    const itype_bin &bin = get_binned_items();
+    const auto found = bin.find( item_type );
+    if( found == bin.end() ) {
         return num;
     }
-    const std::list<const item *> items = get_binned_items().find( item_type )->second;
-    for( const item *it : items ) {
+    for( const item *it : found->second ) {
         num += it->count();
     }
     return num;
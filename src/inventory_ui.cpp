@@ -1539,31 +1539,43 @@ void inventory_column::prepare_paging( const std::string &filter )
         collate();
     }
 
-    // Recover categories
+    // Recover categories. The entries are copied over rather than inserted into, which would
+    // move all the entries after each category.
+    entries_t with_categories;
+    with_categories.reserve( entries.size() );
     const item_category *current_category = nullptr;
-    for( auto iter = entries.begin(); iter != entries.end(); ++iter ) {
-        if( iter->get_category_ptr() == current_category ) {
-            continue;
+    for( inventory_entry &entry : entries ) {
+        if( entry.get_category_ptr() != current_category ) {
+            current_category = entry.get_category_ptr();
+            with_categories.emplace_back( current_category );
         }
-        current_category = iter->get_category_ptr();
-        iter = entries.insert( iter, inventory_entry( current_category ) );
+        with_categories.emplace_back( std::move( entry ) );
     }
+    entries = std::move( with_categories );
     // Determine the new height.
     entries_per_page = height;
     if( entries.size() > entries_per_page ) {
         entries_per_page -= 1;  // Make room for the page number.
-        for( size_t i = entries_per_page - 1; i < entries.size(); i += entries_per_page ) {
-            auto iter = std::next( entries.begin(), i );
-            if( iter->is_category() ) {
-                // The last item on the page must not be a category.
-                entries.insert( iter, inventory_entry() );
-            } else {
-                // The first item on the next page must be a category.
-                iter = std::next( iter );
-                if( iter != entries.end() && iter->is_item() ) {
-                    entries.insert( iter, inventory_entry( iter->get_category_ptr() ) );
+        if( entries_per_page > 0 ) {
+            entries_t paged;
+            paged.reserve( entries.size() + 2 * ( entries.size() / entries_per_page + 1 ) );
+            for( auto iter = entries.begin(); iter != entries.end(); ++iter ) {
+                if( paged.size() % entries_per_page != entries_per_page - 1 ) {
+                    paged.emplace_back( std::move( *iter ) );
+                } else if( iter->is_category() ) {
+                    // The last item on the page must not be a category.
+                    paged.emplace_back();
+                    paged.emplace_back( std::move( *iter ) );
+                } else {
+                    // The first item on the next page must be a category.
+                    const auto next = std::next( iter );
+                    paged.emplace_back( std::move( *iter ) );
+                    if( next != entries.end() && next->is_item() ) {
+                        paged.emplace_back( next->get_category_ptr() );
+                    }
                 }
             }
+            entries = std::move( paged );
         }
     }
     paging_is_valid = true;
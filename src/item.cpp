@@ -1787,7 +1787,6 @@ stacking_info item::stacks_with( const item &rhs, bool check_components, bool co
                 corpse_name == rhs.corpse_name ) );
     bits.set( tname::segments::FOOD_PERISHABLE, _stacks_food_perishable( *this, rhs, check_cat ) );
     bits.set( tname::segments::CLOTHING_SIZE, _stacks_clothing_size( *this, rhs ) );
-    bits.set( tname::segments::BROKEN, is_broken() == rhs.is_broken() );
     // In-progress crafts are always distinct items. Easier to handle for the player,
     // and there shouldn't be that many items of this type around anyway.
     bits.set( tname::segments::CRAFT, !craft_data_ && !rhs.craft_data_ );
@@ -7261,9 +7260,11 @@ units::mass item::weight( bool include_contents, bool integral ) const
         ret_mul *= 0.75;
     }
 
+    // Collected once, as the sawn-off checks below also look through them.
+    const std::vector<const item *> mods = gunmods();
     // if this is a gun apply all of its gunmods' weight multipliers
     if( type->gun ) {
-        for( const item *mod : gunmods() ) {
+        for( const item *mod : mods ) {
             ret_mul *= mod->type->gunmod->weight_multiplier;
         }
     }
@@ -7311,8 +7312,13 @@ units::mass item::weight( bool include_contents, bool integral ) const
         ret += links.weight();
     }
 
+    const auto has_mod = [&mods]( const itype_id & mod ) {
+        return std::any_of( mods.begin(), mods.end(), [&mod]( const item * e ) {
+            return e->typeId() == mod;
+        } );
+    };
     // reduce weight for sawn-off barrel capped to the apportioned weight of the barrel
-    if( gunmod_find( itype_barrel_small ) ) {
+    if( has_mod( itype_barrel_small ) ) {
         const units::volume b = type->gun->barrel_volume;
         const units::mass max_barrel_weight = units::from_gram( to_milliliter( b ) );
         const units::mass barrel_weight = units::from_gram( b.value() * type->weight.value() /
@@ -7321,7 +7327,7 @@ units::mass item::weight( bool include_contents, bool integral ) const
     }
 
     // reduce weight for sawn-off stock
-    if( gunmod_find( itype_stock_none ) ) {
+    if( has_mod( itype_stock_none ) ) {
         // Length taken from item::length(), height and width are "average" values
         const float stock_dimensions = 0.26f * 0.11f * 0.04f; // length * height * width = 0.00114 m3.
         // density of 'wood' material
@@ -7572,11 +7578,13 @@ units::volume item::volume( bool integral, bool ignore_contents, int charges_in_
     ret -= collapsed_volume_delta();
 
     if( is_gun() ) {
+        bool sawn_off = false;
         for( const item *elem : gunmods() ) {
             ret += elem->volume( true );
+            sawn_off = sawn_off || elem->typeId() == itype_barrel_small;
         }
 
-        if( gunmod_find( itype_barrel_small ) ) {
+        if( sawn_off ) {
             ret -= type->gun->barrel_volume;
         }
     }
@@ -9627,6 +9635,7 @@ const std::set<itype_id> &item::repaired_with() const
     static std::set<itype_id> tools;
     tools.clear();
 
+    type->ensure_finalized();
     std::copy_if( type->repair.begin(), type->repair.end(), std::inserter( tools, tools.begin() ),
     []( const itype_id & i ) {
         return !item_is_blacklisted( i );
@@ -10164,6 +10173,7 @@ bool item::is_melee( const damage_type_id &dt ) const
 const islot_armor *item::find_armor_data() const
 {
     if( type->armor ) {
+        type->ensure_finalized();
         return &*type->armor;
     }
     // Currently the only way to make a non-armor item into armor is to install a gun mod.
@@ -10171,6 +10181,7 @@ const islot_armor *item::find_armor_data() const
     // tools in a tool belt (a container actually), or the ammo in a quiver (container again).
     for( const item *mod : gunmods() ) {
         if( mod->type->armor ) {
+            mod->type->ensure_finalized();
             return &*mod->type->armor;
         }
     }
@@ -13484,6 +13495,32 @@ void item::apply_freezerburn()
     set_flag( flag_MUSHY );
 }
 
+// Items kept together catch up on the same hours of the same place, so the weather temperatures
+// of the last place asked about are shared by them.
+static units::temperature past_weather_temperature( const weather_generator &wgen,
+        const tripoint_abs_ms &location, const time_point &time, const unsigned seed )
+{
+    // About a month of hours, more than any stack of items needs at once.
+    static constexpr size_t max_kept = 24 * 30;
+    static const weather_generator *kept_wgen = nullptr;
+    static tripoint_abs_ms kept_location;
+    static unsigned kept_seed = 0;
+    static std::unordered_map<int, units::temperature> kept;
+    if( kept_wgen != &wgen || kept_location != location || kept_seed != seed ||
+        kept.size() >= max_kept ) {
+        kept.clear();
+        kept_wgen = &wgen;
+        kept_location = location;
+        kept_seed = seed;
+    }
+    const int turn = to_turns<int>( time - calendar::turn_zero );
+    const auto [iter, inserted] = kept.try_emplace( turn );
+    if( inserted ) {
+        iter->second = wgen.get_weather_temperature( location, time, seed );
+    }
+    return iter->second;
+}
+
 bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos, map &here,
                                     Character *carrier, const temperature_flag flag, float spoil_modifier, bool watertight_container )
 {
@@ -13549,7 +13586,7 @@ bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos
         units::temperature_delta temp_mod;
         // Toilets and vending machines will try to get the heat radiation and convection during mapgen and segfault.
         if( !g->new_game ) {
-            temp_mod = get_heat_radiation( pos );
+            temp_mod = get_weather().get_heat_radiation( pos );
             temp_mod += get_convection_temperature( pos );
             temp_mod += here.get_temperature_mod( pos );
         } else {
@@ -13562,6 +13599,7 @@ bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos
 
         // Process the past of this item in 1h chunks until there is less than 1h left.
         time_duration time_delta = 1_hours;
+        const tripoint_abs_ms location = get_map().get_abs( pos );
 
         while( now - time > 1_hours ) {
             time += time_delta;
@@ -13570,7 +13608,7 @@ bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos
             // Use weather if above ground, use map temp if below
             units::temperature env_temperature;
             if( pos.z() >= 0 && flag != temperature_flag::ROOT_CELLAR ) {
-                env_temperature = wgen.get_weather_temperature( get_map().get_abs( pos ), time, seed );
+                env_temperature = past_weather_temperature( wgen, location, time, seed );
             } else {
                 env_temperature = units::from_celsius( get_weather().get_cur_weather_gen().base_temperature );
             }
@@ -16005,8 +16043,8 @@ std::list<const item *> item::all_items_ptr() const
     std::list<const item *> all_items_internal;
     for( int i = static_cast<int>( pocket_type::CONTAINER );
          i < static_cast<int>( pocket_type::LAST ); i++ ) {
-        std::list<const item *> inserted{ all_items_top_recursive( static_cast<pocket_type>( i ) ) };
-        all_items_internal.insert( all_items_internal.end(), inserted.begin(), inserted.end() );
+        all_items_internal.splice( all_items_internal.end(),
+                                   all_items_top_recursive( static_cast<pocket_type>( i ) ) );
     }
     return all_items_internal;
 }
@@ -16016,8 +16054,8 @@ std::list<item *> item::all_items_ptr()
     std::list<item *> all_items_internal;
     for( int i = static_cast<int>( pocket_type::CONTAINER );
          i < static_cast<int>( pocket_type::LAST ); i++ ) {
-        std::list<item *> inserted{ all_items_top_recursive( static_cast<pocket_type>( i ) ) };
-        all_items_internal.insert( all_items_internal.end(), inserted.begin(), inserted.end() );
+        all_items_internal.splice( all_items_internal.end(),
+                                   all_items_top_recursive( static_cast<pocket_type>( i ) ) );
     }
     return all_items_internal;
 }
@@ -16035,26 +16073,24 @@ std::list<item *> item::all_items_ptr( pocket_type pk_type )
 std::list<const item *> item::all_items_top_recursive( pocket_type pk_type )
 const
 {
-    std::list<const item *> contained = contents.all_items_top( pk_type );
-    std::list<const item *> all_items_internal{ contained };
-    for( const item *it : contained ) {
-        std::list<const item *> recursion_items = it->all_items_top_recursive( pk_type );
-        all_items_internal.insert( all_items_internal.end(), recursion_items.begin(),
-                                   recursion_items.end() );
+    std::list<const item *> all_items_internal = contents.all_items_top( pk_type );
+    std::list<const item *> nested;
+    for( const item *it : all_items_internal ) {
+        nested.splice( nested.end(), it->all_items_top_recursive( pk_type ) );
     }
+    all_items_internal.splice( all_items_internal.end(), nested );
 
     return all_items_internal;
 }
 
 std::list<item *> item::all_items_top_recursive( pocket_type pk_type )
 {
-    std::list<item *> contained = contents.all_items_top( pk_type );
-    std::list<item *> all_items_internal{ contained };
-    for( item *it : contained ) {
-        std::list<item *> recursion_items = it->all_items_top_recursive( pk_type );
-        all_items_internal.insert( all_items_internal.end(), recursion_items.begin(),
-                                   recursion_items.end() );
+    std::list<item *> all_items_internal = contents.all_items_top( pk_type );
+    std::list<item *> nested;
+    for( item *it : all_items_internal ) {
+        nested.splice( nested.end(), it->all_items_top_recursive( pk_type ) );
     }
+    all_items_internal.splice( all_items_internal.end(), nested );
 
     return all_items_internal;
 }
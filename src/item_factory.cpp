@@ -7,6 +7,7 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <tuple>
@@ -169,9 +170,8 @@ static std::optional<std::reference_wrapper<const itype>> find_template_list_con
             const itype_id &it_id )
 
 {
-    generic_factory<itype> &factory = item_controller->get_generic_factory();
-    if( factory.is_valid( it_id ) ) {
-        return factory.obj( it_id );
+    if( const itype *found = item_controller->get_generic_factory().find( it_id ) ) {
+        return *found;
     }
     return std::nullopt;
 }
@@ -205,6 +205,44 @@ bool itype_id::is_valid() const
     return item_controller->has_template( *this );
 }
 
+/** @relates int_id */
+template<>
+bool int_id<itype>::is_valid() const
+{
+    return item_controller->get_generic_factory().is_valid( *this );
+}
+
+/** @relates int_id */
+template<>
+const itype &int_id<itype>::obj() const
+{
+    return item_controller->get_generic_factory().obj( *this );
+}
+
+/** @relates int_id */
+template<>
+const itype_id &int_id<itype>::id() const
+{
+    return item_controller->get_generic_factory().convert( *this );
+}
+
+/**
+ * Runtime item types (see Item_factory::add_runtime) are not part of the factory and have no
+ * int_id, they convert to an invalid one.
+ * @relates int_id
+ */
+template<>
+itype_int_id itype_id::id() const
+{
+    return item_controller->get_generic_factory().convert( *this, itype_int_id( -1 ), false );
+}
+
+/** @relates int_id */
+template<>
+int_id<itype>::int_id( const itype_id &id ) : _id( id.id().to_i() )
+{
+}
+
 /** @relates string_id */
 template<>
 bool string_id<Item_spawn_data>::is_valid() const
@@ -857,10 +895,6 @@ void Item_factory::finalize_post( itype &obj )
         return;
     }
 
-    if( obj.armor ) {
-        finalize_post_armor( obj );
-    }
-
     // if we haven't set what the item can be repaired with calculate it now
     if( obj.repairs_with.empty() ) {
         for( const auto &mats : obj.materials ) {
@@ -868,25 +902,10 @@ void Item_factory::finalize_post( itype &obj )
         }
     }
 
-    // for each item iterate through potential repair tools
-    for( const auto &tool : repair_tools ) {
-
-        // check if item can be repaired with any of the actions?
-        for( const auto &act : repair_actions ) {
-            const use_function *func = find_template_list_const( tool )->get().get_use( act );
-            if( func == nullptr ) {
-                continue;
-            }
-
-            // tool has a possible repair action, check if the materials are compatible
-            const auto &opts = dynamic_cast<const repair_item_actor *>( func->get_actor_ptr() )->materials;
-            if( std::any_of( obj.repairs_with.begin(),
-            obj.repairs_with.end(), [&opts]( const material_id & m ) {
-            return opts.count( m ) > 0;
-            } ) ) {
-                obj.repair.insert( tool );
-            }
-        }
+    if( lazy_finalization ) {
+        obj.lazy_pending.set( true );
+    } else {
+        finalize_post_derived( obj );
     }
 
     if( obj.has_flag( json_flag_NO_UNLOAD ) ) {
@@ -936,6 +955,46 @@ void Item_factory::finalize_post( itype &obj )
     }
 }
 
+void Item_factory::finalize_post_derived( itype &obj )
+{
+    if( obj.armor ) {
+        finalize_post_armor( obj );
+    }
+
+    // for each item iterate through potential repair tools
+    for( const auto &tool : repair_tools ) {
+
+        // check if item can be repaired with any of the actions?
+        for( const auto &act : repair_actions ) {
+            const use_function *func = find_template_list_const( tool )->get().get_use( act );
+            if( func == nullptr ) {
+                continue;
+            }
+
+            // tool has a possible repair action, check if the materials are compatible
+            const auto &opts = dynamic_cast<const repair_item_actor *>( func->get_actor_ptr() )->materials;
+            if( std::any_of( obj.repairs_with.begin(),
+            obj.repairs_with.end(), [&opts]( const material_id & m ) {
+            return opts.count( m ) > 0;
+            } ) ) {
+                obj.repair.insert( tool );
+            }
+        }
+    }
+}
+
+void Item_factory::finalize_lazily( const itype &obj )
+{
+    std::lock_guard<std::mutex> lk( lazy_mutex );
+    if( !obj.lazy_pending.get() ) {
+        return;
+    }
+    // Only the derived data is written, which nothing reads before this returns.
+    itype &def = const_cast<itype &>( obj );
+    finalize_post_derived( def );
+    def.lazy_pending.set( false );
+}
+
 void Item_factory::finalize_post_armor( itype &obj )
 {
     // Tally up all the hard-defined similar BPs
@@ -1517,6 +1576,7 @@ void Item_factory::finalize()
 
     // we can no longer add or adjust static item templates
     frozen = true;
+    lazy_finalization = get_option<bool>( "LAZY_ITEM_FINALIZATION" );
 
     for( const itype &e : item_factory.get_all() ) {
         finalize_pre( const_cast<itype &>( e ) );
@@ -2247,6 +2307,7 @@ void Item_factory::check_definitions() const
     for( const itype &elem : item_factory.get_all() ) {
         std::string msg;
         const itype *type = &elem;
+        type->ensure_finalized();
 
         if( !type->has_flag( flag_TARDIS ) ) {
             if( is_container( type ) ) {
@@ -2802,6 +2863,7 @@ void Item_factory::check_definitions() const
 const itype *Item_factory::add_runtime( const itype_id &id, translation name,
                                         translation description ) const
 {
+    std::lock_guard<std::recursive_mutex> lk( runtimes_mutex );
     itype *def = new itype();
     def->id = id;
     def->name = std::move( name );
@@ -2824,6 +2886,7 @@ const itype *Item_factory::find_template( const itype_id &id ) const
         return &found->get();
     }
 
+    std::lock_guard<std::recursive_mutex> lk( runtimes_mutex );
     auto rt = m_runtimes.find( id );
     if( rt != m_runtimes.end() ) {
         return rt->second.get();
@@ -4874,7 +4937,11 @@ std::vector<item_group_id> Item_factory::get_all_group_names()
 
 bool Item_factory::has_template( const itype_id &id ) const
 {
-    return template_list_contains( id ) || m_runtimes.count( id );
+    if( template_list_contains( id ) ) {
+        return true;
+    }
+    std::lock_guard<std::recursive_mutex> lk( runtimes_mutex );
+    return m_runtimes.count( id );
 }
 
 const std::vector<const itype *> &Item_factory::all() const
@@ -4882,6 +4949,7 @@ const std::vector<const itype *> &Item_factory::all() const
     cata_assert( frozen );
     // if (!m_runtimes_dirty) then runtimes haven't changed.
     // Since frozen == true, m_templates haven't changed either.
+    std::lock_guard<std::recursive_mutex> lk( runtimes_mutex );
     if( m_runtimes_dirty ) {
         templates_all_cache.clear();
         templates_all_cache.reserve( item_factory.get_all().size() + m_runtimes.size() );
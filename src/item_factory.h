@@ -6,6 +6,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -201,6 +202,9 @@ class Item_factory
         /** called after all JSON has been read and performs any necessary cleanup tasks */
         void finalize();
 
+        /** Computes what finalize left for the first use of the type, see itype::ensure_finalized */
+        void finalize_lazily( const itype &obj );
+
         /** Migrations transform items loaded from legacy saves */
         void load_migration( const JsonObject &jo );
 
@@ -284,7 +288,13 @@ class Item_factory
     private:
         /** Set at finalization and prevents alterations to the static item templates */
         bool frozen = false;
+        /** Set at finalization from the option, finalize_post_derived then waits for first use */
+        bool lazy_finalization = false;
+        std::mutex lazy_mutex;
 
+        // Runtimes are added by lookups of missing ids, which the data checks make from several
+        // threads at once, so they and the cache below are guarded by runtimes_mutex.
+        mutable std::recursive_mutex runtimes_mutex;
         mutable std::map<itype_id, std::unique_ptr<itype>> m_runtimes;
         /** Runtimes rarely change. Used for cache templates_all_cache for the all() method. */
         mutable bool m_runtimes_dirty = true;
@@ -355,6 +365,8 @@ class Item_factory
         void register_cached_uses( const itype &obj );
         /** Applies part of finalization that depends on other items. */
         void finalize_post( itype &obj );
+        /** The part of finalize_post that only derives data no other item needs at load. */
+        void finalize_post_derived( itype &obj );
 
         void finalize_post_armor( itype &obj );
 
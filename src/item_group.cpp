@@ -1,8 +1,11 @@
 #include "item_group.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <mutex>
+#include <numeric>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -827,6 +830,63 @@ void Item_group::add_entry( std::unique_ptr<Item_spawn_data> ptr )
         sic->inherit_ammo_mag_chances( with_ammo, with_magazine );
     }
     items.push_back( std::move( ptr ) );
+    alias_table_stale = true;
+}
+
+void Item_group::build_alias_table() const
+{
+    alias_threshold.clear();
+    alias.clear();
+    if( type != G_DISTRIBUTION || items.empty() ) {
+        return;
+    }
+    // Weights are scaled by the number of entries, so every column holds exactly sum_prob.
+    const int64_t n = items.size();
+    std::vector<int64_t> scaled( n );
+    std::vector<size_t> small;
+    std::vector<size_t> large;
+    for( size_t i = 0; i < items.size(); ++i ) {
+        scaled[i] = items[i]->get_probability( true ) * n;
+        ( scaled[i] < sum_prob ? small : large ).push_back( i );
+    }
+    alias_threshold.assign( n, sum_prob );
+    alias.resize( n );
+    std::iota( alias.begin(), alias.end(), 0 );
+    while( !small.empty() && !large.empty() ) {
+        const size_t s = small.back();
+        small.pop_back();
+        const size_t l = large.back();
+        alias_threshold[s] = static_cast<int>( scaled[s] );
+        alias[s] = l;
+        scaled[l] -= sum_prob - scaled[s];
+        if( scaled[l] < sum_prob ) {
+            large.pop_back();
+            small.push_back( l );
+        }
+    }
+}
+
+size_t Item_group::roll_distribution() const
+{
+    if( items.empty() ) {
+        return 0;
+    }
+    if( alias_table_stale.load( std::memory_order_acquire ) ) {
+        // Groups may be rolled from several threads, like the consistency checks do.
+        static std::mutex build_mutex;
+        std::lock_guard<std::mutex> lk( build_mutex );
+        if( alias_table_stale.load( std::memory_order_relaxed ) ) {
+            build_alias_table();
+            alias_table_stale.store( false, std::memory_order_release );
+        }
+    }
+    const size_t column = rng( 0, items.size() - 1 );
+    size_t i = rng( 0, sum_prob - 1 ) < alias_threshold[column] ? column : alias[column];
+    // Entries of events that are not on pass their roll on to the entry after them.
+    while( i < items.size() && items[i]->is_event_based() && items[i]->get_probability( false ) == 0 ) {
+        ++i;
+    }
+    return i;
 }
 
 std::size_t Item_group::create( Item_spawn_data::ItemList &list,
@@ -841,17 +901,9 @@ std::size_t Item_group::create( Item_spawn_data::ItemList &list,
             elem->create( list, birthday, rec, flags );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
-            elem->create( list, birthday, rec, flags );
-            break;
+        const size_t rolled = roll_distribution();
+        if( rolled < items.size() ) {
+            items[rolled]->create( list, birthday, rec, flags );
         }
     }
     const std::size_t items_created = list.size() - prev_list_size;
@@ -871,16 +923,9 @@ item Item_group::create_single( const time_point &birthday, RecursionList &rec )
             return elem->create_single( birthday, rec );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
-            return elem->create_single( birthday, rec );
+        const size_t rolled = roll_distribution();
+        if( rolled < items.size() ) {
+            return items[rolled]->create_single( birthday, rec );
         }
     }
     return item( itype_id::NULL_ID(), birthday );
@@ -930,6 +975,7 @@ bool Item_group::remove_item( const itype_id &itemid )
             ++a;
         }
     }
+    alias_table_stale = true;
     if( container_item && ( *container_item == itemid ) ) {
         container_item = std::nullopt;
         on_overflow = overflow_behaviour::none;
@@ -1016,6 +1062,16 @@ item_group::ItemList item_group::items_from( const item_group_id &group_id,
     return result;
 }
 
+std::size_t item_group::items_from( const item_group_id &group_id, const time_point &birthday,
+                                    ItemList &into, spawn_flags flags )
+{
+    const Item_spawn_data *group = item_controller->get_group( group_id );
+    if( group == nullptr ) {
+        return 0;
+    }
+    return group->create( into, birthday, flags );
+}
+
 item_group::ItemList item_group::items_from( const item_group_id &group_id )
 {
     return items_from( group_id, calendar::turn_zero );
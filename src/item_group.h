@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_ITEM_GROUP_H
 #define CATA_SRC_ITEM_GROUP_H
 
+#include <atomic>
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -74,6 +75,12 @@ ItemList items_from( const item_group_id &group_id, const time_point &birthday,
  * Same as above but with implicit birthday at turn 0.
  */
 ItemList items_from( const item_group_id &group_id );
+/**
+ * Same as above but appends the items to into, so callers spawning from groups many times can
+ * reuse one list.  Returns the number of items appended.
+ */
+std::size_t items_from( const item_group_id &group_id, const time_point &birthday,
+                        ItemList &into, spawn_flags flags = spawn_flags::none );
 /**
  * Check whether a specific item group contains a specific item type.
  */
@@ -419,6 +426,19 @@ class Item_group : public Item_spawn_data
          * Links to the entries in this group.
          */
         prop_list items;
+        /**
+         * Walker alias table of a distribution, so rolling an entry takes the same time however
+         * many there are.  An entry picked from column c is c if a roll in [0, sum_prob) is below
+         * alias_threshold[c], alias[c] otherwise.  Built by the first roll after the entries
+         * changed, so adding the entries of a group one by one doesn't rebuild it each time.
+         */
+        mutable std::vector<int> alias_threshold;
+        mutable std::vector<size_t> alias;
+        mutable std::atomic<bool> alias_table_stale{ false };
+
+        void build_alias_table() const;
+        // The rolled entry of a distribution, or items.size() if it rolled none.
+        size_t roll_distribution() const;
 };
 
 #endif // CATA_SRC_ITEM_GROUP_H
@@ -516,9 +516,7 @@ std::list<item *> item_pocket::all_items_ptr( pocket_type pk_type )
     }
     std::list<item *> all_items_top_level{ all_items_top() };
     for( item *it : all_items_top_level ) {
-        std::list<item *> all_items_internal{ it->all_items_ptr( pk_type ) };
-        all_items_top_level.insert( all_items_top_level.end(), all_items_internal.begin(),
-                                    all_items_internal.end() );
+        all_items_top_level.splice( all_items_top_level.end(), it->all_items_ptr( pk_type ) );
     }
     return all_items_top_level;
 }
@@ -530,9 +528,7 @@ std::list<const item *> item_pocket::all_items_ptr( pocket_type pk_type ) const
     }
     std::list<const item *> all_items_top_level{ all_items_top() };
     for( const item *it : all_items_top_level ) {
-        std::list<const item *> all_items_internal{ it->all_items_ptr( pk_type ) };
-        all_items_top_level.insert( all_items_top_level.end(), all_items_internal.begin(),
-                                    all_items_internal.end() );
+        all_items_top_level.splice( all_items_top_level.end(), it->all_items_ptr( pk_type ) );
     }
     return all_items_top_level;
 }
@@ -11,6 +11,7 @@
 #include "debug.h"
 #include "generic_factory.h"
 #include "item.h"
+#include "item_factory.h"
 #include "make_static.h"
 #include "map.h"
 #include "material.h"
@@ -104,6 +105,13 @@ std::string itype::get_item_type_string() const
     return "misc";
 }
 
+void itype::ensure_finalized() const
+{
+    if( lazy_pending.get() ) {
+        item_controller->finalize_lazily( *this );
+    }
+}
+
 std::string itype::nname( unsigned int quantity ) const
 {
     // Always use singular form for liquids.
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_ITYPE_H
 #define CATA_SRC_ITYPE_H
 
+#include <atomic>
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -1417,7 +1418,10 @@ struct itype {
         // Minimum stat(s) or skill(s) to use the item
         std::map<skill_id, int> min_skills;
 
-        /** What items can be used to repair this item? @see Item_factory::finalize */
+        /**
+         * What items can be used to repair this item? @see Item_factory::finalize
+         * Call ensure_finalized before reading it.
+         */
         std::set<itype_id> repair;
 
         /** What faults (if any) can occur */
@@ -1449,7 +1453,36 @@ struct itype {
     private:
         FlagsSetType item_tags;
 
+        // Set while Item_factory::finalize_lazily has yet to run on this type.  Copies like a
+        // plain bool, but may be read from several threads at once.
+        class pending_flag
+        {
+            public:
+                pending_flag() = default;
+                pending_flag( const pending_flag &other ) : value( other.get() ) {}
+                pending_flag &operator=( const pending_flag &other ) {
+                    set( other.get() );
+                    return *this;
+                }
+                bool get() const {
+                    return value.load( std::memory_order_acquire );
+                }
+                void set( bool v ) {
+                    value.store( v, std::memory_order_release );
+                }
+            private:
+                std::atomic<bool> value{ false };
+        };
+        pending_flag lazy_pending;
+
     public:
+        /**
+         * With the LAZY_ITEM_FINALIZATION option, the armor portion data and the repair tools
+         * are only derived from the rest of the type on the first call of this.  Anything
+         * reading them goes through item::find_armor_data or calls this first.  Thread safe.
+         */
+        void ensure_finalized() const;
+
         // memory card related per-type static data
         cata::value_ptr<memory_card_info> memory_card_data;
         // How should the item explode
@@ -8066,7 +8066,7 @@ std::optional<int> iuse::capture_monster_veh( Character *p, item *it, const trip
 
 bool item::release_monster( const tripoint_bub_ms &target, const int radius )
 {
-    shared_ptr_fast<monster> new_monster = make_shared_fast<monster>();
+    shared_ptr_fast<monster> new_monster = make_pooled_shared_fast<monster>();
     try {
         ::deserialize_from_string( *new_monster, get_var( "contained_json", "" ) );
     } catch( const std::exception &e ) {
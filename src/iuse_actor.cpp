@@ -1062,7 +1062,7 @@ std::optional<int> place_monster_iuse::use( Character *p, item &it, map *here,
         return std::nullopt;
     }
 
-    shared_ptr_fast<monster> newmon_ptr = make_shared_fast<monster>( mtypeid );
+    shared_ptr_fast<monster> newmon_ptr = make_pooled_shared_fast<monster>( mtypeid );
     monster &newmon = *newmon_ptr;
     newmon.init_from_item( it );
     if( place_randomly ) {
@@ -2,6 +2,7 @@
 
 #include <clocale>
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <cmath> // IWYU pragma: keep
 #include <cstdint>
@@ -9,11 +10,13 @@
 #include <cstring> // strcmp
 #include <exception>
 #include <functional>
+#include <ios>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <set>
 #include <sstream> // IWYU pragma: keep
+#include <streambuf>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,6 +40,40 @@ static bool is_whitespace( char ch )
     return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r';
 }
 
+// Characters that go into a string as they are, so runs of them can be copied without the
+// checks escapes, line ends and utf8 sequences need.
+static constexpr std::array<bool, 256> plain_string_chars = []() {
+    std::array<bool, 256> plain{};
+    for( int c = 0x20; c < 0x80; ++c ) {
+        plain[c] = c != '"' && c != '\\';
+    }
+    return plain;
+}();
+
+// Appends the plain characters at the read position of sb to s, a block at a time.  Reads
+// straight from the buffer, as the checks of an istream call for every character are most
+// of the time spent reading text.
+static void append_plain_run( std::streambuf &sb, std::string &s )
+{
+    // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+    char block[64];
+    size_t used = 0;
+    for( int c = sb.sgetc(); c != EOF && plain_string_chars[c]; c = sb.snextc() ) {
+        block[used++] = static_cast<char>( c );
+        if( used == sizeof( block ) ) {
+            s.append( block, used );
+            used = 0;
+        }
+    }
+    s.append( block, used );
+}
+
+static void skip_plain_run( std::streambuf &sb )
+{
+    for( int c = sb.sgetc(); c != EOF && plain_string_chars[c]; c = sb.snextc() ) {
+    }
+}
+
 // Thw following function would fit more logically in catacharset.cpp, but it's
 // needed for the json formatter and we can't easily include that file in that
 // binary.
@@ -855,8 +892,17 @@ void TextJsonIn::seek( int pos )
 
 void TextJsonIn::eat_whitespace()
 {
-    while( is_whitespace( peek() ) ) {
-        stream->get();
+    if( !stream->good() ) {
+        return;
+    }
+    std::streambuf &sb = *stream->rdbuf();
+    int c = sb.sgetc();
+    while( c != EOF && is_whitespace( static_cast<char>( c ) ) ) {
+        c = sb.snextc();
+    }
+    if( c == EOF ) {
+        // As peeking at the end would have.
+        stream->setstate( std::ios::eofbit );
     }
 }
 
@@ -942,6 +988,7 @@ void TextJsonIn::skip_string()
         error( -1, err.str() );
     }
     while( stream->good() ) {
+        skip_plain_run( *stream->rdbuf() );
         stream->get( ch );
         if( ch == '\\' ) {
             stream->get( ch );
@@ -1217,8 +1264,9 @@ std::string TextJsonIn::get_string()
             err = "expected string but got '" + std::string( 1, ch ) + "'";
             break;
         }
-        // add chars to the string, one at a time
+        // add chars to the string, plain runs at once and the rest one at a time
         do {
+            append_plain_run( *stream->rdbuf(), s );
             ch = stream->peek();
             if( !stream->good() ) {
                 err = "read operation failed";
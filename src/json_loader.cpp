@@ -3,6 +3,8 @@
 #include <filesystem>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "filesystem.h"
 #include "flexbuffer_cache.h"
@@ -171,3 +173,72 @@ std::optional<JsonValue> json_loader::from_string_opt( std::string const &data )
     }
     return ret;
 }
+
+JsonValue json_loader::from_flexbuffer( std::vector<uint8_t> data )
+{
+    std::shared_ptr<parsed_flexbuffer> buffer = flexbuffer_cache::from_binary( std::move( data ) );
+    flexbuffers::Reference buffer_root = flexbuffer_root_from_storage( buffer->get_storage() );
+    return JsonValue( std::move( buffer ), buffer_root, nullptr, 0 );
+}
+
+namespace
+{
+
+// The cache all the files are under, if there is one.
+flexbuffer_cache *cache_for_pack( const std::vector<cata_path> &files,
+                                  std::vector<std::filesystem::path> &paths )
+{
+    if( files.empty() ) {
+        return nullptr;
+    }
+    const cata_path::root_path root = files.front().get_logical_root();
+    if( root == cata_path::root_path::unknown || root == cata_path::root_path::save ) {
+        return nullptr;
+    }
+    for( const cata_path &file : files ) {
+        const cata_path lexically_normal_path = file.lexically_normal();
+        if( lexically_normal_path.get_logical_root() != root ) {
+            return nullptr;
+        }
+        paths.emplace_back( lexically_normal_path.get_unrelative_path() );
+    }
+    return &cache_for_lexically_normal_path( files.front().lexically_normal() );
+}
+
+} // namespace
+
+std::optional<std::vector<JsonValue>> json_loader::from_pack( const std::vector<cata_path> &files )
+{
+    std::vector<std::filesystem::path> paths;
+    flexbuffer_cache *cache = cache_for_pack( files, paths );
+    if( cache == nullptr ) {
+        return std::nullopt;
+    }
+    std::optional<std::vector<std::shared_ptr<parsed_flexbuffer>>> buffers = cache->load_pack( paths );
+    if( !buffers ) {
+        return std::nullopt;
+    }
+    std::vector<JsonValue> values;
+    values.reserve( buffers->size() );
+    for( std::shared_ptr<parsed_flexbuffer> &buffer : *buffers ) {
+        flexbuffers::Reference buffer_root = flexbuffer_root_from_storage( buffer->get_storage() );
+        values.emplace_back( std::move( buffer ), buffer_root, nullptr, 0 );
+    }
+    return values;
+}
+
+void json_loader::save_pack( const std::vector<cata_path> &files ) noexcept( false )
+{
+    std::vector<std::filesystem::path> paths;
+    flexbuffer_cache *cache = cache_for_pack( files, paths );
+    if( cache == nullptr ) {
+        return;
+    }
+    // Each file was just parsed, so this maps the flexbuffer the cache keeps of it.
+    std::vector<std::shared_ptr<parsed_flexbuffer>> buffers;
+    buffers.reserve( paths.size() );
+    for( const std::filesystem::path &path : paths ) {
+        buffers.push_back( cache->parse_and_cache( path, 0 ) );
+    }
+    cache->save_pack( paths, buffers );
+}
@@ -2,6 +2,10 @@
 #ifndef CATA_SRC_JSON_LOADER_H
 #define CATA_SRC_JSON_LOADER_H
 
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 #include "path_info.h"
 #include "flexbuffer_json.h"
 
@@ -24,6 +28,17 @@ class json_loader
         static JsonValue from_string( std::string data ) noexcept( false );
         static std::optional<JsonValue> from_string_opt( std::string const &data ) noexcept( false );
 
+        // Wraps json already parsed into a FlexBuffer by flexbuffer_cache::json_to_binary.
+        // Throws if the buffer is corrupt.
+        static JsonValue from_flexbuffer( std::vector<uint8_t> data ) noexcept( false );
+
+        // Like from_path for each of the files, from the pack written for them by save_pack
+        // (see flexbuffer_cache::load_pack).  Returns nothing if there is no such pack.
+        static std::optional<std::vector<JsonValue>> from_pack( const std::vector<cata_path> &files );
+        // Packs the files, which must have been parsed by from_path since they last changed, so
+        // the next from_pack of them finds them.
+        static void save_pack( const std::vector<cata_path> &files ) noexcept( false );
+
 };
 
 #endif // CATA_SRC_JSON_LOADER_H
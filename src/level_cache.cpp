@@ -15,6 +15,8 @@ level_cache::level_cache()
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
+    std::fill_n( &buffered_lm[0][0], map_dimensions, four_zeros );
+    std::fill_n( &buffered_lm_sources[0][0], map_dimensions, 0.0f );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
@@ -22,12 +24,13 @@ level_cache::level_cache()
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, lit_level::DARK );
+    veh_cached_parts.fill( std::make_pair( nullptr, -1 ) );
     clear_vehicle_cache();
 }
 
 bool level_cache::get_veh_in_active_range() const
 {
-    return !veh_cached_parts.empty();
+    return veh_exists_count > 0;
 }
 
 bool level_cache::get_veh_exists_at( const tripoint_bub_ms &pt ) const
@@ -37,9 +40,8 @@ bool level_cache::get_veh_exists_at( const tripoint_bub_ms &pt ) const
 
 std::pair<vehicle *, int> level_cache::get_veh_cached_parts( const tripoint_bub_ms &pt ) const
 {
-    auto it = veh_cached_parts.find( pt );
-    if( it != veh_cached_parts.end() ) {
-        return it->second;
+    if( get_veh_exists_at( pt ) ) {
+        return veh_cached_parts[pt.xy()];
     }
     vehicle *veh = nullptr;
     return std::make_pair( veh, -1 );
@@ -48,13 +50,17 @@ std::pair<vehicle *, int> level_cache::get_veh_cached_parts( const tripoint_bub_
 void level_cache::set_veh_exists_at( const tripoint_bub_ms &pt, bool exists_at )
 {
     veh_cache_cleared = false;
-    veh_exists_at[ pt.x() * MAPSIZE_X + pt.y()] = exists_at;
+    const size_t i = pt.x() * MAPSIZE_X + pt.y();
+    if( veh_exists_at[i] != exists_at ) {
+        veh_exists_count += exists_at ? 1 : -1;
+        veh_exists_at[i] = exists_at;
+    }
 }
 
 void level_cache::set_veh_cached_parts( const tripoint_bub_ms &pt, vehicle &veh, int part_num )
 {
     veh_cache_cleared = false;
-    veh_cached_parts[ pt ] = std::make_pair( &veh, part_num );
+    veh_cached_parts[pt.xy()] = std::make_pair( &veh, part_num );
 }
 
 void level_cache::clear_vehicle_cache()
@@ -62,15 +68,16 @@ void level_cache::clear_vehicle_cache()
     if( veh_cache_cleared ) {
         return;
     }
+    // veh_cached_parts is only read where veh_exists_at is set, so it is left as is.
     veh_exists_at.reset();
-    veh_cached_parts.clear();
+    veh_exists_count = 0;
     veh_cache_cleared = true;
 }
 
 void level_cache::clear_veh_from_veh_cached_parts( const tripoint_bub_ms &pt, vehicle *veh )
 {
-    auto it = veh_cached_parts.find( pt );
-    if( it != veh_cached_parts.end() && it->second.first == veh ) {
-        veh_cached_parts.erase( it );
+    std::pair<vehicle *, int> &cached = veh_cached_parts[pt.xy()];
+    if( cached.first == veh ) {
+        cached = std::make_pair( nullptr, -1 );
     }
 }
@@ -5,7 +5,6 @@
 #include <array>
 #include <bitset>
 #include <set>
-#include <unordered_map>
 #include <utility>
 
 #include "coordinates.h"
@@ -27,6 +26,8 @@ struct level_cache {
         bool outside_cache_dirty = false;
         bool floor_cache_dirty = false;
         bool seen_cache_dirty = false;
+        // Set when the outside, floor or transparency cache changed since the last sunlight pass.
+        bool sunlight_inputs_dirty = true;
         // This is a single value indicating that the entire level is floored.
         bool no_floor_gaps = false;
 
@@ -35,6 +36,17 @@ struct level_cache {
         // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
         // This is only valid for the duration of generate_lightmap
         cata::mdarray<float, point_bub_ms> light_source_buffer;
+        // Combined rays of all light_source_buffer sources; persists between turns so only sources
+        // near a change need to be recast (see update_buffered_lightmap in lightmap.cpp).
+        cata::mdarray<four_quadrants, point_bub_ms> buffered_lm;
+        // The light_source_buffer contents that buffered_lm was cast from.
+        cata::mdarray<float, point_bub_ms> buffered_lm_sources;
+        // Submaps whose transparency changed since buffered_lm was last updated.
+        std::bitset<MAPSIZE *MAPSIZE> buffered_lm_transparency_dirty;
+        // Weather sight penalty that buffered_lm was cast with.
+        float buffered_lm_sight_penalty = 0.0f;
+        // If true, buffered_lm must be rebuilt from scratch.
+        bool buffered_lm_dirty = true;
 
         // Cache of natural light level is useful if it needs to be in sync with the light cache.
         float natural_light_level_cache;
@@ -63,6 +75,8 @@ struct level_cache {
         // initial values derived from transparency_cache, uses same units
         // examples of adjustment: changed transparency on player's tile and special case for crouching
         cata::mdarray<float, point_bub_ms> vision_transparency_cache;
+        // 8-bit copy of vision_transparency_cache used by the 3D field of view
+        transparency_palette_grid vision_transparency_palette;
 
         // stores "visibility" of the tiles to the player
         // values range from 1 (fully visible to player) to 0 (not visible)
@@ -96,6 +110,9 @@ struct level_cache {
         // since the most recent call to clear_vehicle_cache()
         bool veh_cache_cleared = true;
         std::bitset<MAPSIZE_X *MAPSIZE_Y> veh_exists_at;
-        std::unordered_map<tripoint_bub_ms, std::pair<vehicle *, int>> veh_cached_parts;
+        // Number of tiles set in veh_exists_at.
+        int veh_exists_count = 0;
+        // Vehicle and part index of each tile, only meaningful where veh_exists_at is set.
+        cata::mdarray<std::pair<vehicle *, int>, point_bub_ms> veh_cached_parts;
 };
 #endif // CATA_SRC_LEVEL_CACHE_H
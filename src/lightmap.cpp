@@ -34,6 +34,7 @@
 #include "monster.h"
 #include "mtype.h"
 #include "npc.h"
+#include "perf.h"
 #include "point.h"
 #include "string_formatter.h"
 #include "submap.h"
@@ -111,6 +112,8 @@ bool map::build_transparency_cache( const int zlev )
 
     // if true, all submaps are invalid (can use batch init)
     bool rebuild_all = map_cache.transparency_cache_dirty.all();
+    map_cache.buffered_lm_transparency_dirty |= map_cache.transparency_cache_dirty;
+    map_cache.sunlight_inputs_dirty = true;
 
     if( rebuild_all ) {
         // Default to just barely not transparent.
@@ -281,6 +284,7 @@ bool map::build_vision_transparency_cache( int zlev )
         vision_transparency_cache[p.x()][p.y()] = LIGHT_TRANSPARENCY_OPEN_AIR;
     }
 
+    map_cache.vision_transparency_palette.build( vision_transparency_cache );
     map_cache.transparency_cache_dirty.reset();
     return dirty;
 }
@@ -314,6 +318,23 @@ void map::build_sunlight_cache( int pzlev )
     // Plus one zlevel to prevent clipping inside structures
     const int zlev_max = clamp( calc_max_populated_zlev() + 1, std::min( pzlev + 1, OVERMAP_HEIGHT ),
                                 OVERMAP_HEIGHT );
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    // The pass only depends on the caches of the levels it covers and on the natural light, so
+    // while none of them changed the previous result is still valid.  Only pzlev has to be
+    // restored, as generate_lightmap adds the other light sources to it.
+    std::array<float, OVERMAP_LAYERS> natural_light{};
+    bool inputs_changed = !last_sunlight;
+    for( int zlev = zlev_max; zlev >= zlev_min; zlev-- ) {
+        natural_light[zlev + OVERMAP_DEPTH] = g->natural_light_level( zlev );
+        inputs_changed |= get_cache( zlev ).sunlight_inputs_dirty;
+    }
+    if( !inputs_changed && !last_sunlight->other_levels_lit && last_sunlight->pzlev == pzlev &&
+        last_sunlight->zlev_max == zlev_max && last_sunlight->sight_penalty == sight_penalty &&
+        last_sunlight->natural_light == natural_light ) {
+        get_cache( pzlev ).lm = last_sunlight->lm;
+        return;
+    }
 
     // true if all previous z-levels are fully transparent to light (no floors, transparency >= air)
     bool fully_outside = true;
@@ -332,7 +353,8 @@ void map::build_sunlight_cache( int pzlev )
     for( int zlev = zlev_max; zlev >= zlev_min; zlev-- ) {
 
         level_cache &map_cache = get_cache( zlev );
-        map_cache.natural_light_level_cache = g->natural_light_level( zlev );
+        map_cache.natural_light_level_cache = natural_light[zlev + OVERMAP_DEPTH];
+        map_cache.sunlight_inputs_dirty = false;
         auto &lm = map_cache.lm;
         // Grab illumination at ground level.
         const float outside_light_level = g->natural_light_level( 0 );
@@ -379,7 +401,6 @@ void map::build_sunlight_cache( int pzlev )
         const auto &prev_transparency_cache = prev_map_cache.transparency_cache;
         const auto &prev_floor_cache = prev_map_cache.floor_cache;
         const auto &outside_cache = map_cache.outside_cache;
-        const float sight_penalty = get_weather().weather_id->sight_penalty;
         // TODO: Replace these with a lookup inside the four_quadrants class.
         constexpr std::array<point, 5> cardinals = {
             { point::zero, point::north, point::west, point::east, point::south }
@@ -438,10 +459,23 @@ void map::build_sunlight_cache( int pzlev )
             }
         }
     }
+
+    if( !last_sunlight ) {
+        last_sunlight = std::make_unique<sunlight_snapshot>();
+    }
+    last_sunlight->pzlev = pzlev;
+    last_sunlight->zlev_max = zlev_max;
+    last_sunlight->sight_penalty = sight_penalty;
+    last_sunlight->natural_light = natural_light;
+    last_sunlight->other_levels_lit = false;
+    last_sunlight->lm = get_cache_ref( pzlev ).lm;
 }
 
+static void update_buffered_lightmap( level_cache &map_cache, float sight_penalty );
+
 void map::generate_lightmap( const int zlev )
 {
+    cata_timer timer( "lightmap" );
     level_cache &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -478,9 +512,14 @@ void map::generate_lightmap( const int zlev )
 
     build_sunlight_cache( zlev );
 
+    // Set if light was cast onto a level other than zlev
+    bool lit_other_levels = false;
+
     apply_character_light( get_player_character() );
+    lit_other_levels |= get_player_character().posz() != zlev;
     for( npc &guy : g->all_npcs() ) {
         apply_character_light( guy );
+        lit_other_levels |= guy.posz() != zlev;
     }
 
     std::vector<std::pair<tripoint_bub_ms, float>> lm_override;
@@ -518,20 +557,36 @@ void map::generate_lightmap( const int zlev )
                             }
                         }
                     }
+                }
+            }
 
-                    if( cur_submap->get_lum( { sx, sy } ) ) {
-                        add_light_from_items( p, i_at( p ) );
-                    }
+            // Only visit the tiles that can emit light instead of the whole submap.
+            for( const point_sm_ms &sp : cur_submap->get_light_emitters() ) {
+                const tripoint_bub_ms p( sp.x() + smx * SEEX, sp.y() + smy * SEEY, zlev );
+                if( cur_submap->get_lum( sp ) ) {
+                    add_light_from_items( p, i_at( p ) );
+                }
 
-                    const ter_id &terrain = cur_submap->get_ter( { sx, sy } );
-                    if( terrain->light_emitted > 0 ) {
-                        add_light_source( p, terrain->light_emitted );
-                    }
-                    const furn_id &furniture = cur_submap->get_furn( {sx, sy } );
-                    if( furniture->light_emitted > 0 ) {
-                        add_light_source( p, furniture->light_emitted );
-                    }
+                const ter_id &terrain = cur_submap->get_ter( sp );
+                if( terrain->light_emitted > 0 ) {
+                    add_light_source( p, terrain->light_emitted );
+                }
+                const furn_id &furniture = cur_submap->get_furn( sp );
+                if( furniture->light_emitted > 0 ) {
+                    add_light_source( p, furniture->light_emitted );
+                }
+            }
 
+            if( cur_submap->field_count == 0 ) {
+                continue;
+            }
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                const int column = cur_submap->get_field_column( sx );
+                for( int sy = 0; sy < SEEY && ( column >> sy ) != 0; ++sy ) {
+                    if( !( ( column >> sy ) & 1 ) ) {
+                        continue;
+                    }
+                    const tripoint_bub_ms p( sx + smx * SEEX, sy + smy * SEEY, zlev );
                     for( const auto &fld : cur_submap->get_field( { sx, sy } ) ) {
                         const field_entry *cur = &fld.second;
                         const int light_emitted = cur->get_intensity_level().light_emitted;
@@ -554,6 +609,7 @@ void map::generate_lightmap( const int zlev )
         }
         const tripoint_bub_ms mp = critter.pos_bub();
         if( inbounds( mp ) ) {
+            lit_other_levels |= mp.z() != zlev;
             if( critter.has_effect( effect_onfire ) ) {
                 apply_light_source( mp, 8 );
             }
@@ -594,6 +650,7 @@ void map::generate_lightmap( const int zlev )
             if( !inbounds( src ) ) {
                 continue;
             }
+            lit_other_levels |= src.z() != zlev;
 
             if( vp.has_flag( VPFLAG_CONE_LIGHT ) ) {
                 if( veh_luminance > lit_level::LIT ) {
@@ -642,6 +699,7 @@ void map::generate_lightmap( const int zlev )
             if( !inbounds( pos ) || vpr.info().has_flag( "COVERED" ) ) {
                 continue;
             }
+            lit_other_levels |= pos.z() != zlev;
             add_light_from_items( pos, vpr.items() );
         }
     }
@@ -650,17 +708,29 @@ void map::generate_lightmap( const int zlev )
       This may seem like extra work, but take a 12x12 raging inferno:
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
+      The rays themselves are kept in buffered_lm and only recast where something changed.
     */
-    const tripoint_bub_ms cache_start( 0, 0, zlev );
-    const tripoint_bub_ms cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint_bub_ms &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x()][p.y()] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x()][p.y()] );
+    update_buffered_lightmap( map_cache, get_weather().weather_id->sight_penalty );
+    const auto &buffered_lm = map_cache.buffered_lm;
+    for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+            const float luminance = light_source_buffer[x][y];
+            if( luminance > 0.0f ) {
+                const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+                lm[x][y] = elementwise_max( lm[x][y], min_light );
+                sm[x][y] = std::max( sm[x][y], luminance );
+            }
+            lm[x][y] = elementwise_max( lm[x][y], buffered_lm[x][y] );
         }
     }
     for( const std::pair<tripoint_bub_ms, float> &elem : lm_override ) {
         lm[elem.first.x()][elem.first.y()].fill( elem.second );
     }
+
+    // Light cast onto other levels has to be cleared by the next sunlight pass.
+    last_sunlight->other_levels_lit |= lit_other_levels;
+
+    ++vision_generation;
 }
 
 void map::add_light_source( const tripoint_bub_ms &p, float luminance )
@@ -878,6 +948,31 @@ static constexpr quadrant quadrant_from_x_y( int x, int y )
            ( ( y > 0 ) ? quadrant::NE : quadrant::SE );
 }
 
+// rl_dist from the origin to ( dx, dy ), looked up in a table when possible since the
+// shadowcasting loops below need it for every tile they visit.
+static int shadowcasting_dist( const int dx, const int dy )
+{
+    if( !trigdist ) {
+        return std::max( std::abs( dx ), std::abs( dy ) );
+    }
+    static const cata::mdarray<int, point, MAX_VIEW_DISTANCE + 1, MAX_VIEW_DISTANCE + 1> table =
+    []() {
+        cata::mdarray<int, point, MAX_VIEW_DISTANCE + 1, MAX_VIEW_DISTANCE + 1> result;
+        for( int x = 0; x <= MAX_VIEW_DISTANCE; ++x ) {
+            for( int y = 0; y <= MAX_VIEW_DISTANCE; ++y ) {
+                result[x][y] = rl_dist( point::zero, point( x, y ) );
+            }
+        }
+        return result;
+    }();
+    const int ax = std::abs( dx );
+    const int ay = std::abs( dy );
+    if( ax > MAX_VIEW_DISTANCE || ay > MAX_VIEW_DISTANCE ) {
+        return rl_dist( point::zero, point( dx, dy ) );
+    }
+    return table[ax][ay];
+}
+
 template<int xx, int xy, int yx, int yy, typename T, typename Out,
          T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
@@ -912,6 +1007,10 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
         delta.y = -distance;
         bool started_row = false;
         T current_transparency( 0.0 );
+        // Within a row numerator and cumulative_transparency are fixed, so neighbouring tiles
+        // at the same distance share their intensity and calc() (an exp()) can be skipped.
+        int calc_dist = -1;
+        T calc_intensity( 0.0 );
         float away = start - ( -distance + 0.5f ) / ( -distance -
                      0.5f ); //The distance between our first leadingEdge and start
 
@@ -934,8 +1033,12 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
                 current_transparency = input_array[ current.x ][ current.y ];
             }
 
-            const int dist = rl_dist( tripoint::zero, delta ) + offsetDistance;
-            last_intensity = calc( numerator, cumulative_transparency, dist );
+            const int dist = shadowcasting_dist( delta.x, delta.y ) + offsetDistance;
+            if( dist != calc_dist ) {
+                calc_dist = dist;
+                calc_intensity = calc( numerator, cumulative_transparency, dist );
+            }
+            last_intensity = calc_intensity;
 
             T new_transparency = input_array[ current.x ][ current.y ];
 
@@ -1040,6 +1143,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
                             bool cumulative, bool camera, int penalty )
 {
     level_cache &map_cache = get_cache( target_z );
+    ++vision_generation;
     using mdarray = cata::mdarray<float, point_bub_ms>;
     mdarray &transparency_cache = map_cache.vision_transparency_cache;
     mdarray &seen_cache = map_cache.seen_cache;
@@ -1055,12 +1159,16 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
 
     // Cache the caches (pointers to them)
     array_of_grids_of<const float> transparency_caches;
+    std::array<const transparency_palette_grid *, OVERMAP_LAYERS> transparency_palettes;
+    bool use_palettes = true;
     array_of_grids_of<float> seen_caches;
     array_of_grids_of<const bool> floor_caches;
     vertical_direction directions_to_cast = vertical_direction::BOTH;
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         level_cache &cur_cache = get_cache( z );
         transparency_caches[z + OVERMAP_DEPTH] = &cur_cache.vision_transparency_cache;
+        transparency_palettes[z + OVERMAP_DEPTH] = &cur_cache.vision_transparency_palette;
+        use_palettes &= cur_cache.vision_transparency_palette.valid;
         seen_caches[z + OVERMAP_DEPTH] = camera ? &cur_cache.camera_cache : &cur_cache.seen_cache;
         floor_caches[z + OVERMAP_DEPTH] = &cur_cache.floor_cache;
         if( !cumulative ) {
@@ -1076,9 +1184,15 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
         ( *seen_caches[ target_z + OVERMAP_DEPTH ] )[origin.x()][origin.y()] = VISIBILITY_FULL;
     }
 
-    cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
-        seen_caches, transparency_caches, floor_caches, origin, penalty, 1.0,
-        directions_to_cast );
+    if( use_palettes ) {
+        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+            seen_caches, transparency_palettes, floor_caches, origin, penalty, 1.0,
+            directions_to_cast );
+    } else {
+        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+            seen_caches, transparency_caches, floor_caches, origin, penalty, 1.0,
+            directions_to_cast );
+    }
     seen_cache_process_ledges( seen_caches, floor_caches, std::nullopt );
 
     const optional_vpart_position vp = veh_at( origin );
@@ -1214,23 +1328,12 @@ static bool light_check( const float &transparency, const float &intensity )
     return transparency > LIGHT_TRANSPARENCY_SOLID && intensity > LIGHT_AMBIENT_LOW;
 }
 
-void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
+// Casts the rays of a circular light source at p2 into lm, but not the light on its own tile.
+static void cast_light_source( cata::mdarray<four_quadrants, point_bub_ms> &lm,
+                               const cata::mdarray<float, point_bub_ms> &transparency_cache,
+                               const cata::mdarray<float, point_bub_ms> &light_source_buffer,
+                               const point_bub_ms &p2, float luminance )
 {
-    level_cache &cache = get_cache( p.z() );
-    cata::mdarray<four_quadrants, point_bub_ms> &lm = cache.lm;
-    cata::mdarray<float, point_bub_ms> &sm = cache.sm;
-    cata::mdarray<float, point_bub_ms> &transparency_cache =
-        cache.transparency_cache;
-    cata::mdarray<float, point_bub_ms> &light_source_buffer =
-        cache.light_source_buffer;
-
-    const point_bub_ms p2( p.xy() );
-
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x()][p2.y()] = elementwise_max( lm[p2.x()][p2.y()], min_light );
-        sm[p2.x()][p2.y()] = std::max( sm[p2.x()][p2.y()], luminance );
-    }
     if( luminance <= lit_level::LOW ) {
         return;
     } else if( luminance <= lit_level::BRIGHT_ONLY ) {
@@ -1296,6 +1399,133 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
+{
+    level_cache &cache = get_cache( p.z() );
+    cata::mdarray<four_quadrants, point_bub_ms> &lm = cache.lm;
+    cata::mdarray<float, point_bub_ms> &sm = cache.sm;
+
+    const point_bub_ms p2( p.xy() );
+
+    if( inbounds( p ) ) {
+        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+        lm[p2.x()][p2.y()] = elementwise_max( lm[p2.x()][p2.y()], min_light );
+        sm[p2.x()][p2.y()] = std::max( sm[p2.x()][p2.y()], luminance );
+    }
+    cast_light_source( lm, cache.transparency_cache, cache.light_source_buffer, p2, luminance );
+}
+
+// How far (in squares, along either axis) the rays of a buffered light source can reach.
+// Light never falls off slower than through the most transparent tile, so past this distance
+// castLight has already dropped below LIGHT_AMBIENT_LOW and stopped.
+// Fields only ever make a tile less transparent, so the weather penalty gives the bound.
+static int buffered_light_reach( float luminance, float sight_penalty )
+{
+    const float min_transparency = LIGHT_TRANSPARENCY_OPEN_AIR * std::min( sight_penalty, 1.0f );
+    if( luminance <= LIGHT_AMBIENT_LOW ) {
+        return 2;
+    }
+    if( min_transparency <= LIGHT_TRANSPARENCY_SOLID ) {
+        return MAX_VIEW_DISTANCE;
+    }
+    return std::min( static_cast<int>( std::log( luminance / LIGHT_AMBIENT_LOW ) / min_transparency ) + 2,
+                     MAX_VIEW_DISTANCE );
+}
+
+// Brings buffered_lm in sync with light_source_buffer. Only sources that appeared, vanished or
+// changed, sources next to those (their ray skipping depends on neighbours) and sources whose
+// reach covers a submap with changed transparency are recast; everything else keeps last turn's
+// rays. Since light is merged with max(), recasting every source that touches the affected
+// submaps reproduces exactly what a full rebuild would have produced there.
+static void update_buffered_lightmap( level_cache &map_cache, const float sight_penalty )
+{
+    const cata::mdarray<float, point_bub_ms> &buffer = map_cache.light_source_buffer;
+    cata::mdarray<float, point_bub_ms> &sources = map_cache.buffered_lm_sources;
+    cata::mdarray<four_quadrants, point_bub_ms> &buffered_lm = map_cache.buffered_lm;
+    std::bitset<MAPSIZE *MAPSIZE> &transparency_dirty = map_cache.buffered_lm_transparency_dirty;
+
+    const auto reach_submaps = [sight_penalty]( const point & p, float luminance ) {
+        const int reach = buffered_light_reach( luminance, sight_penalty );
+        return inclusive_rectangle<point>(
+                   point( std::max( p.x - reach, 0 ) / SEEX, std::max( p.y - reach, 0 ) / SEEY ),
+                   point( std::min( p.x + reach, LIGHTMAP_CACHE_X - 1 ) / SEEX,
+                          std::min( p.y + reach, LIGHTMAP_CACHE_Y - 1 ) / SEEY ) );
+    };
+    const auto touches = []( const std::bitset<MAPSIZE *MAPSIZE> &submaps,
+    const inclusive_rectangle<point> &r ) {
+        for( int smx = r.p_min.x; smx <= r.p_max.x; ++smx ) {
+            for( int smy = r.p_min.y; smy <= r.p_max.y; ++smy ) {
+                if( submaps[smx * MAPSIZE + smy] ) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    std::bitset<MAPSIZE *MAPSIZE> dirty;
+    const auto mark = [&dirty]( const inclusive_rectangle<point> &r ) {
+        for( int smx = r.p_min.x; smx <= r.p_max.x; ++smx ) {
+            for( int smy = r.p_min.y; smy <= r.p_max.y; ++smy ) {
+                dirty.set( smx * MAPSIZE + smy );
+            }
+        }
+    };
+
+    if( map_cache.buffered_lm_dirty || map_cache.buffered_lm_sight_penalty != sight_penalty ) {
+        dirty.set();
+    } else {
+        constexpr std::array<point, 5> self_and_neighbours = {
+            { point::zero, point::north, point::west, point::east, point::south }
+        };
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                const float luminance = buffer[x][y];
+                if( luminance != sources[x][y] ) {
+                    for( const point &d : self_and_neighbours ) {
+                        const point n = point( x, y ) + d;
+                        if( n.x < 0 || n.y < 0 || n.x >= LIGHTMAP_CACHE_X || n.y >= LIGHTMAP_CACHE_Y ) {
+                            continue;
+                        }
+                        const float n_luminance = std::max( buffer[n.x][n.y], sources[n.x][n.y] );
+                        if( n_luminance > 0.0f ) {
+                            mark( reach_submaps( n, n_luminance ) );
+                        }
+                    }
+                } else if( luminance > 0.0f && transparency_dirty.any() ) {
+                    const inclusive_rectangle<point> r = reach_submaps( point( x, y ), luminance );
+                    if( touches( transparency_dirty, r ) ) {
+                        mark( r );
+                    }
+                }
+            }
+        }
+    }
+
+    if( dirty.any() ) {
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                if( dirty[( x / SEEX ) * MAPSIZE + y / SEEY] ) {
+                    buffered_lm[x][y].fill( 0.0f );
+                }
+            }
+        }
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                const float luminance = buffer[x][y];
+                if( luminance > 0.0f && touches( dirty, reach_submaps( point( x, y ), luminance ) ) ) {
+                    cast_light_source( buffered_lm, map_cache.transparency_cache, buffer,
+                                       point_bub_ms( x, y ), luminance );
+                }
+            }
+        }
+        sources = buffer;
+    }
+    transparency_dirty.reset();
+    map_cache.buffered_lm_sight_penalty = sight_penalty;
+    map_cache.buffered_lm_dirty = false;
+}
+
 void map::apply_directional_light( const tripoint_bub_ms &p, int direction, float luminance )
 {
     const point_bub_ms p2( p.xy() );
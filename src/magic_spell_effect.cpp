@@ -1968,7 +1968,7 @@ void spell_effect::slime_split_on_death( const spell &sp, Creature &caster,
                 slime_id = mon_blob;
             }
 
-            shared_ptr_fast<monster> mon = make_shared_fast<monster>( slime_id );
+            shared_ptr_fast<monster> mon = make_pooled_shared_fast<monster>( slime_id );
             mon->ammo = mon->type->starting_ammo;
             if( mon->will_move_to( dest ) && mon->know_danger_at( dest ) ) {
                 if( monster *const blob = g->place_critter_around( mon, dest, 0 ) ) {
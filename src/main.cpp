@@ -19,6 +19,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -41,12 +42,14 @@
 #include "event.h"
 #include "event_bus.h"
 #include "filesystem.h"
+#include "flexbuffer_json.h"
 #include "game.h"
 #include "game_constants.h"
 #include "game_ui.h"
 #include "get_version.h"
 #include "help.h"
 #include "input.h"
+#include "input_context.h"
 #include "main_menu.h"
 #include "mapsharing.h"
 #include "memory_fast.h"
@@ -54,6 +57,7 @@
 #include "ordered_static_globals.h"
 #include "output.h"
 #include "path_info.h"
+#include "perf.h"
 #include "rng.h"
 #include "system_locale.h"
 #include "translations.h"
@@ -140,11 +144,59 @@ namespace
 // Used only if AttachConsole() works
 FILE *CONOUT;
 #endif
+
+// Where --json-member-stats writes what was recorded, empty if it was not given.
+std::string json_member_stats_path;
+
+void write_json_member_stats()
+{
+    if( json_member_stats_path.empty() ) {
+        return;
+    }
+    write_to_file( json_member_stats_path, []( std::ostream & fout ) {
+        fout << "type\tmember\tlookups\tfailed\ttime_ns\tfailed_time_ns\n";
+        for( const json_member_stat &stat : JsonObject::member_stats() ) {
+            fout << stat.type << '\t' << stat.member << '\t' << stat.lookups << '\t' << stat.failed
+                 << '\t' << stat.time.count() << '\t' << stat.failed_time.count() << '\n';
+        }
+    }, "json member stats" );
+}
+
+// Where --load-timings writes what was timed, empty if it was not given.
+std::string load_timings_path;
+
+static void write_timer_stats( std::ostream &fout, const cata_timer::timer_stats &stats,
+                               const std::string &indent )
+{
+    fout << indent << stats.name << '\t' << stats.count << '\t' << stats.duration << '\n';
+    for( const auto &[name, child] : stats.child_timers ) {
+        write_timer_stats( fout, child, indent + "  " );
+    }
+}
+
+void write_load_timings()
+{
+    if( load_timings_path.empty() ) {
+        return;
+    }
+    write_to_file( load_timings_path, []( std::ostream & fout ) {
+        fout << "timer\tcount\ttime_us\n";
+        for( const auto &[name, stats] : cata_timer::get_stats() ) {
+            write_timer_stats( fout, stats, "" );
+        }
+    }, "load timings" );
+}
+
+// Where --record-actions writes the handled actions, empty if it was not given.
+std::string record_actions_path;
+
 void exit_handler( int s )
 {
     const int old_timeout = inp_mngr.get_timeout();
     inp_mngr.reset_timeout();
     if( s != 2 || query_yn( _( "Really Quit?  All unsaved changes will be lost." ) ) ) {
+        write_json_member_stats();
+        write_load_timings();
         deinitDebug();
 
         int exit_status = 0;
@@ -299,6 +351,16 @@ cli_opts parse_commandline( int argc, const char **argv )
                     return 1;
                 }
             },
+            {
+                "--engine-seed", "<number>",
+                "Sets the random number generator's seed to the given value, such as the one written by --record-actions",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.seed = static_cast<int>( std::strtoul( params[0], nullptr, 10 ) );
+                    return 1;
+                }
+            },
             {
                 "--jsonverify", {},
                 "Checks the CDDA json files and exits",
@@ -324,6 +386,38 @@ cli_opts parse_commandline( int argc, const char **argv )
                     return 0;
                 }
             },
+            {
+                "--json-member-stats", "<filename>",
+                "Counts and times the json member lookups of loading per type and member, and writes them to the file on exit",
+                section_default,
+                1,
+                []( int, const char **params ) -> int {
+                    json_member_stats_path = params[0];
+                    JsonObject::globally_record_member_stats( true );
+                    return 1;
+                }
+            },
+            {
+                "--load-timings", "<filename>",
+                "Times the loading of each mod and json type in it, and each finalization and verification step, and writes them to the file on exit",
+                section_default,
+                1,
+                []( int, const char **params ) -> int {
+                    load_timings_path = params[0];
+                    cata_timer::collecting() = true;
+                    return 1;
+                }
+            },
+            {
+                "--record-actions", "<filename>",
+                "Writes the rng seed and then every handled input action to the file, to repeat the steps leading to a performance problem with --engine-seed",
+                section_default,
+                1,
+                []( int, const char **params ) -> int {
+                    record_actions_path = params[0];
+                    return 1;
+                }
+            },
             {
                 "--noverify", {},
                 "Skips JSON verification",
@@ -777,6 +871,9 @@ int main( int argc, const char *argv[] )
     set_language_from_options();
 
     rng_set_engine_seed( cli.seed );
+    if( !record_actions_path.empty() ) {
+        input_context::record_actions( record_actions_path, cli.seed );
+    }
 
     game_ui::init_ui();
 
@@ -792,7 +889,10 @@ int main( int argc, const char *argv[] )
         if( cli.check_mods ) {
             init_colors();
             const std::vector<mod_id> mods( cli.opts.begin(), cli.opts.end() );
-            exit( g->check_mod_data( mods ) && !debug_has_error_been_observed() ? 0 : 1 );
+            const bool mods_ok = g->check_mod_data( mods ) && !debug_has_error_been_observed();
+            write_json_member_stats();
+            write_load_timings();
+            exit( mods_ok ? 0 : 1 );
         }
     } catch( const std::exception &err ) {
         debugmsg( "%s", err.what() );
@@ -5,13 +5,17 @@
 #include <climits>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <numeric>
 #include <optional>
 #include <ostream>
 #include <queue>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "active_item_cache.h"
 #include "ammo.h"
@@ -22,6 +26,7 @@
 #include "cached_options.h"
 #include "calendar.h"
 #include "cata_assert.h"
+#include "cata_thread_pool.h"
 #include "cata_type_traits.h"
 #include "character.h"
 #include "character_id.h"
@@ -292,9 +297,24 @@ map &map::operator=( map && ) = default;
 
 static submap null_submap;
 
+map::cache_invalidation_counts &map::invalidation_counts()
+{
+    static cache_invalidation_counts counts;
+    return counts;
+}
+
+// Only the reality bubble rebuilds its caches every turn.
+static void count_invalidation( const map *m, uint64_t map::cache_invalidation_counts::*counter )
+{
+    if( m == &reality_bubble() ) {
+        ++( map::invalidation_counts().*counter );
+    }
+}
+
 void map::set_transparency_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
+        count_invalidation( this, &cache_invalidation_counts::transparency );
         get_cache( zlev ).transparency_cache_dirty.set();
     }
 }
@@ -302,6 +322,7 @@ void map::set_transparency_cache_dirty( const int zlev )
 void map::set_transparency_cache_dirty( const tripoint_bub_ms &p, bool field )
 {
     if( inbounds( p ) ) {
+        count_invalidation( this, &cache_invalidation_counts::transparency_points );
         const tripoint_bub_sm smp = coords::project_to<coords::sm>( p );
         get_cache( smp.z() ).transparency_cache_dirty.set( smp.x() * MAPSIZE + smp.y() );
         if( !field ) {
@@ -313,6 +334,7 @@ void map::set_transparency_cache_dirty( const tripoint_bub_ms &p, bool field )
 void map::set_seen_cache_dirty( const tripoint_bub_ms &change_location )
 {
     if( inbounds( change_location ) ) {
+        count_invalidation( this, &cache_invalidation_counts::seen_points );
         level_cache &cache = get_cache( change_location.z() );
         if( cache.seen_cache_dirty ) {
             return;
@@ -327,6 +349,7 @@ void map::set_seen_cache_dirty( const tripoint_bub_ms &change_location )
 void map::set_seen_cache_dirty( const int zlevel )
 {
     if( inbounds_z( zlevel ) ) {
+        count_invalidation( this, &cache_invalidation_counts::seen );
         level_cache &cache = get_cache( zlevel );
         cache.seen_cache_dirty = true;
     }
@@ -335,6 +358,7 @@ void map::set_seen_cache_dirty( const int zlevel )
 void map::set_outside_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
+        count_invalidation( this, &cache_invalidation_counts::outside );
         get_cache( zlev ).outside_cache_dirty = true;
     }
 }
@@ -342,6 +366,7 @@ void map::set_outside_cache_dirty( const int zlev )
 void map::set_floor_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
+        count_invalidation( this, &cache_invalidation_counts::floor );
         get_cache( zlev ).floor_cache_dirty = true;
     }
 }
@@ -397,11 +422,12 @@ void map::memory_clear_vehicle_points( const vehicle &veh ) const
 void map::invalidate_map_cache( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
+        count_invalidation( this, &cache_invalidation_counts::whole_level );
         level_cache &ch = get_cache( zlev );
         ch.floor_cache_dirty = true;
         ch.seen_cache_dirty = true;
         ch.outside_cache_dirty = true;
-        set_transparency_cache_dirty( zlev );
+        ch.transparency_cache_dirty.set();
     }
 }
 
@@ -481,9 +507,9 @@ void map::add_vehicle_to_cache( vehicle *veh )
             continue;
         }
         const tripoint_bub_ms p = veh->bub_part_pos( *this, vpr.part() );
-        level_cache &ch = get_cache( p.z() );
-        ch.set_veh_cached_parts( p, *veh, static_cast<int>( vpr.part_index() ) );
         if( inbounds( p ) ) {
+            level_cache &ch = get_cache( p.z() );
+            ch.set_veh_cached_parts( p, *veh, static_cast<int>( vpr.part_index() ) );
             ch.set_veh_exists_at( p, true );
             set_transparency_cache_dirty( p );
         }
@@ -498,10 +524,8 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint_bub_ms &p
     }
 
     level_cache *ch = get_cache_lazy( pt.z() );
-    if( ch ) {
-        if( inbounds( pt ) ) {
-            ch->set_veh_exists_at( pt, false );
-        }
+    if( ch && inbounds( pt ) ) {
+        ch->set_veh_exists_at( pt, false );
         ch->clear_veh_from_veh_cached_parts( pt, veh );
     }
 }
@@ -1492,18 +1516,24 @@ bool map::displace_vehicle( vehicle &veh, const tripoint_rel_ms &dp, const bool
     // first, let's find our position in current vehicles vector
     size_t our_i = 0;
     bool found = false;
-    for( submap *&smap : grid ) {
+    const auto find_in = [&]( submap * smap ) {
         for( size_t i = 0; i < smap->vehicles.size(); i++ ) {
             if( smap->vehicles[i].get() == &veh ) {
                 our_i = i;
                 src_submap = smap;
                 found = true;
-                break;
+                return;
             }
         }
+    };
+    // The vehicle is normally kept by the submap under its position, only look through the
+    // whole grid when it is not.
+    find_in( src_submap );
+    for( submap *&smap : grid ) {
         if( found ) {
             break;
         }
+        find_in( smap );
     }
 
     if( !found ) {
@@ -3544,12 +3574,17 @@ bool map::has_nearby_chair( const tripoint_bub_ms &p, int radius ) const
 
 bool map::has_nearby_ter( const tripoint_bub_ms &p, const ter_id &type, int radius ) const
 {
-    for( const tripoint_bub_ms &pt : points_in_radius( p, radius ) ) {
-        if( ter( pt ) == type ) {
-            return true;
-        }
-    }
-    return false;
+    bool found = false;
+    function_over( p - point( radius, radius ), p + point( radius, radius ),
+    [&]( const tripoint_rel_sm &, const submap * sm, const point_sm_ms & lp ) {
+        if( sm->get_ter( lp ) == type ) {
+            found = true;
+            return ITER_FINISH;
+        }
+        // A uniform submap has the same terrain on all of its tiles
+        return sm->is_uniform() ? ITER_SKIP_SUBMAP : ITER_CONTINUE;
+    } );
+    return found;
 }
 
 bool map::terrain_moppable( const tripoint_bub_ms &p )
@@ -4757,10 +4792,19 @@ void map::translate( const ter_id &from, const ter_id &to )
                   from.obj().name() );
         return;
     }
-    for( const tripoint_bub_ms &p : points_on_zlevel() ) {
-        if( ter( p ) == from ) {
-            ter_set( p, to );
+    std::vector<tripoint_bub_ms> found;
+    function_over( tripoint_bub_ms( 0, 0, abs_sub.z() ),
+                   tripoint_bub_ms( SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, abs_sub.z() ),
+    [&]( const tripoint_rel_sm & gp, const submap * sm, const point_sm_ms & lp ) {
+        if( sm->get_ter( lp ) == from ) {
+            found.emplace_back( rebase_bub( coords::project_to<coords::ms>( gp ) + lp.raw() ) );
+        } else if( sm->is_uniform() ) {
+            return ITER_SKIP_SUBMAP;
         }
+        return ITER_CONTINUE;
+    } );
+    for( const tripoint_bub_ms &p : found ) {
+        ter_set( p, to );
     }
 }
 
@@ -4923,6 +4967,38 @@ void map::set_radiation( const tripoint_bub_ms &p, const int value )
     current_submap->set_radiation( l, value );
 }
 
+void map::set_radiation_square( const point_bub_ms &p1, const point_bub_ms &p2, const int z,
+                                const int value )
+{
+    const int max_ms = SEEX * my_MAPSIZE - 1;
+    const point_bub_ms from( std::max( p1.x(), 0 ), std::max( p1.y(), 0 ) );
+    const point_bub_ms to( std::min( p2.x(), max_ms ), std::min( p2.y(), max_ms ) );
+    if( from.x() > to.x() || from.y() > to.y() || !inbounds( tripoint_bub_ms( from, z ) ) ) {
+        return;
+    }
+
+    for( int smx = from.x() / SEEX; smx <= to.x() / SEEX; ++smx ) {
+        for( int smy = from.y() / SEEY; smy <= to.y() / SEEY; ++smy ) {
+            submap *const current_submap = get_submap_at_grid( tripoint_rel_sm( smx, smy, z ) );
+            if( current_submap == nullptr ) {
+                debugmsg( "Tried to set radiation at grid (%d,%d,%d) but the submap is not loaded", smx, smy,
+                          z );
+                continue;
+            }
+            const point_bub_ms sm_origin( smx * SEEX, smy * SEEY );
+            const point_rel_ms lo = point_bub_ms( std::max( from.x(), sm_origin.x() ),
+                                                  std::max( from.y(), sm_origin.y() ) ) - sm_origin;
+            const point_rel_ms hi = point_bub_ms( std::min( to.x(), sm_origin.x() + SEEX - 1 ),
+                                                  std::min( to.y(), sm_origin.y() + SEEY - 1 ) ) - sm_origin;
+            for( int x = lo.x(); x <= hi.x(); ++x ) {
+                for( int y = lo.y(); y <= hi.y(); ++y ) {
+                    current_submap->set_radiation( point_sm_ms( x, y ), value );
+                }
+            }
+        }
+    }
+}
+
 void map::adjust_radiation( const tripoint_bub_ms &p, const int delta )
 {
     if( !inbounds( p ) ) {
@@ -5029,18 +5105,26 @@ void map::i_clear( const tripoint_bub_ms &p )
 }
 
 std::vector<item *> map::spawn_items( const tripoint_bub_ms &p, const std::vector<item> &new_items )
+{
+    if( !inbounds( p ) || has_flag( ter_furn_flag::TFLAG_DESTROY_ITEM, p ) ) {
+        return {};
+    }
+    return spawn_items( p, std::vector<item>( new_items ) );
+}
+
+std::vector<item *> map::spawn_items( const tripoint_bub_ms &p, std::vector<item> &&new_items )
 {
     std::vector<item *> ret;
     if( !inbounds( p ) || has_flag( ter_furn_flag::TFLAG_DESTROY_ITEM, p ) ) {
         return ret;
     }
     const bool swimmable = has_flag( ter_furn_flag::TFLAG_SWIMMABLE, p );
-    for( const item &new_item : new_items ) {
+    for( item &new_item : new_items ) {
 
         if( new_item.made_of( phase_id::LIQUID ) && swimmable ) {
             continue;
         }
-        item &it = add_item_or_charges( p, new_item );
+        item &it = add_item_or_charges( p, std::move( new_item ) );
         if( !it.is_null() ) {
             ret.push_back( &it );
         }
@@ -5073,13 +5157,26 @@ void map::spawn_item( const tripoint_bub_ms &p, const itype_id &type_id, const u
     if( item_is_blacklisted( type_id ) ) {
         return;
     }
-    // recurse to spawn (quantity - 1) items
-    for( size_t i = 1; i < quantity; i++ ) {
-        spawn_item( p, type_id, 1, charges, birthday, damlevel, flags, variant, faction );
-    }
     // migrate and spawn the item
     itype_id mig_type_id = item_controller->migrate_id( type_id );
     item new_item( mig_type_id, birthday );
+    // Whether an item fits is rolled before it is put in its container, and variants and
+    // snippets are rolled when it is made, so those are made one by one.  Other copies only
+    // differ in their degradation and are cloned from this one.
+    const auto rolls_own_looks = []( const itype & type ) {
+        return !type.variants.empty() || !type.snippet_category.empty() || type.expand_snippets;
+    };
+    // All of the copies but this one.
+    const auto spawn_others_one_by_one = [&]( unsigned total ) {
+        for( unsigned i = 1; i < total; i++ ) {
+            spawn_item( p, type_id, 1, charges, birthday, damlevel, flags, variant, faction );
+        }
+    };
+    unsigned copies = quantity;
+    if( new_item.has_flag( flag_VARSIZE ) || rolls_own_looks( *new_item.type ) ) {
+        spawn_others_one_by_one( quantity );
+        copies = 1;
+    }
     new_item.set_itype_variant( variant );
     new_item.set_owner( faction_id( faction ) );
     if( one_in( 3 ) && new_item.has_flag( flag_VARSIZE ) ) {
@@ -5092,18 +5189,30 @@ void map::spawn_item( const tripoint_bub_ms &p, const itype_id &type_id, const u
     }
     new_item = new_item.in_its_container();
     new_item.set_owner( faction_id( faction ) ); // Set faction to the container as well
+    if( copies > 1 && rolls_own_looks( *new_item.type ) ) {
+        spawn_others_one_by_one( copies );
+        copies = 1;
+    }
     if( ( new_item.made_of( phase_id::LIQUID ) && has_flag( ter_furn_flag::TFLAG_SWIMMABLE, p ) ) ||
         has_flag( ter_furn_flag::TFLAG_DESTROY_ITEM, p ) ) {
         return;
     }
 
     new_item.set_damage( damlevel );
-    new_item.rand_degradation();
-    for( const flag_id &flag : flags ) {
-        new_item.set_flag( flag );
-    }
 
-    add_item_or_charges( p, new_item );
+    const auto finish = [&flags]( item & it ) {
+        it.rand_degradation();
+        for( const flag_id &flag : flags ) {
+            it.set_flag( flag );
+        }
+    };
+    for( unsigned i = 1; i < copies; i++ ) {
+        item copy( new_item );
+        finish( copy );
+        add_item_or_charges( p, std::move( copy ) );
+    }
+    finish( new_item );
+    add_item_or_charges( p, std::move( new_item ) );
 }
 
 units::volume map::max_volume( const tripoint_bub_ms &p )
@@ -5348,9 +5457,15 @@ item &map::add_item( const tripoint_bub_ms &p, item new_item, int copies )
 
     current_submap->update_lum_add( l, new_item );
 
-    const map_stack::iterator new_pos = current_submap->get_items( l ).insert( new_item );
+    cata::colony<item> &stack = current_submap->get_items( l );
+    if( copies > 1 && stack.empty() ) {
+        // One allocation for all the copies.  Reserving more for a stack that holds items would
+        // consolidate it, moving the items that others point to.
+        stack.reserve( copies );
+    }
+    const map_stack::iterator new_pos = stack.insert( new_item );
     while( --copies > 0 ) {
-        current_submap->get_items( l ).insert( new_item );
+        stack.insert( new_item );
     }
 
     if( current_submap->active_items.add( *new_pos, l ) ) {
@@ -6565,6 +6680,7 @@ bool map::add_field( const tripoint_bub_ms &p, const field_type_id &type_id, int
     invalidate_max_populated_zlev( p.z() );
 
     if( current_submap->get_field( l ).add_field( converted_type_id, intensity, age ) ) {
+        current_submap->mark_field_tile( l );
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
             get_cache( p.z() ).field_cache.set(
@@ -7434,6 +7550,78 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
     return visible;
 }
 
+std::vector<bool> map::sees( const tripoint_bub_ms &F, const std::vector<tripoint_bub_ms> &targets,
+                             const int range, bool with_fields ) const
+{
+    bool ( map:: * f_transparent )( const tripoint_bub_ms & p ) const =
+        with_fields ? &map::is_transparent : &map::is_transparent_wo_fields;
+    lru_cache_t &skew_cache = with_fields ? skew_vision_cache : skew_vision_wo_fields_cache;
+    std::vector<bool> visible( targets.size(), false );
+
+    // With a start offset of zero, the Bresenham line to F + k * step is k copies of the line
+    // to F + step, so targets in the same direction share one walk to the farthest of them.
+    struct ray {
+        int max_steps = 0;
+        tripoint_bub_ms farthest;
+        // Number of steps to the target and its index in targets
+        std::vector<std::pair<int, size_t>> targets;
+    };
+    std::unordered_map<point, ray> rays;
+    for( size_t i = 0; i < targets.size(); ++i ) {
+        const tripoint_bub_ms &T = targets[i];
+        if( T.z() != F.z() ) {
+            visible[i] = sees( F, T, range, with_fields );
+            continue;
+        }
+        if( ( range >= 0 && range < rl_dist( F, T ) ) || !inbounds( T ) ) {
+            continue;
+        }
+        const point key = sees_cache_key( F, T );
+        const char cached = skew_cache.get( key, -1 );
+        if( cached != -1 ) {
+            visible[i] = cached > 0;
+            continue;
+        }
+        const point d = ( T - F ).xy().raw();
+        if( d == point::zero ) {
+            visible[i] = true;
+            skew_cache.insert( 100000, key, 1 );
+            continue;
+        }
+        const point step = d / std::gcd( std::abs( d.x ), std::abs( d.y ) );
+        const int steps = std::max( std::abs( d.x ), std::abs( d.y ) );
+        ray &r = rays[step];
+        if( steps > r.max_steps ) {
+            r.max_steps = steps;
+            r.farthest = T;
+        }
+        r.targets.emplace_back( steps, i );
+    }
+
+    for( const std::pair<const point, ray> &elem : rays ) {
+        const ray &r = elem.second;
+        // Count the transparent tiles in front of the first opaque one.
+        int clear_steps = 0;
+        bresenham( F.xy(), r.farthest.xy(), 0,
+        [this, f_transparent, &clear_steps, &r]( const point_bub_ms & new_point ) {
+            if( new_point == r.farthest.xy() ||
+                !( this->*f_transparent )( { new_point, r.farthest.z() } ) ) {
+                return false;
+            }
+            ++clear_steps;
+            return true;
+        } );
+        for( const std::pair<int, size_t> &target : r.targets ) {
+            // The last square is still visible even if opaque.
+            const bool target_visible = clear_steps >= target.first - 1;
+            visible[target.second] = target_visible;
+            skew_cache.insert( 100000, sees_cache_key( F, targets[target.second] ),
+                               target_visible ? 1 : 0 );
+        }
+    }
+    return visible;
+}
+
 int map::obstacle_coverage( const tripoint_bub_ms &loc1, const tripoint_bub_ms &loc2 ) const
 {
     // Can't hide if you are standing on furniture, or non-flat slowing-down terrain tile.
@@ -7979,6 +8167,142 @@ shift_bitset_cache<MAPSIZE_X, SEEX>( std::bitset<MAPSIZE_X *MAPSIZE_X> &cache,
 template void
 shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, const point_rel_sm &s );
 
+// Moves the tiles of a cache along with a shift of the map by s submaps.  The tiles entering
+// the map keep stale values, the caller has to mark their submaps dirty.
+template<typename T>
+static void shift_tile_cache( cata::mdarray<T, point_bub_ms> &cache, const point_rel_sm &s )
+{
+    static_assert( std::is_trivially_copyable_v<T>, "columns are moved with memmove" );
+    const point d( s.x() * SEEX, s.y() * SEEY );
+    const size_t column_len = MAPSIZE_Y - std::abs( d.y );
+    const int dst_y = std::max( -d.y, 0 );
+    const int src_y = std::max( d.y, 0 );
+    const auto shift_column = [&]( const int x ) {
+        std::memmove( &cache[x][dst_y], &cache[x + d.x][src_y], column_len * sizeof( T ) );
+    };
+    if( d.x >= 0 ) {
+        for( int x = 0; x < MAPSIZE_X - d.x; ++x ) {
+            shift_column( x );
+        }
+    } else {
+        for( int x = MAPSIZE_X - 1; x >= -d.x; --x ) {
+            shift_column( x );
+        }
+    }
+}
+
+static void shift_tile_cache( std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> &cache,
+                              const point_rel_sm &s )
+{
+    const point d( s.x() * SEEX, s.y() * SEEY );
+    const auto shift_column = [&]( const int x ) {
+        const std::bitset<MAPSIZE_Y> &src = cache[x + d.x];
+        cache[x] = d.y >= 0 ? src >> d.y : src << -d.y;
+    };
+    if( d.x >= 0 ) {
+        for( int x = 0; x < MAPSIZE_X - d.x; ++x ) {
+            shift_column( x );
+        }
+    } else {
+        for( int x = MAPSIZE_X - 1; x >= -d.x; --x ) {
+            shift_column( x );
+        }
+    }
+}
+
+// Same as shift_bitset_cache, for caches indexed by smx * MAPSIZE + smy.
+static void shift_submap_dirty_cache( std::bitset<MAPSIZE *MAPSIZE> &cache, const point_rel_sm &s )
+{
+    const std::bitset<MAPSIZE *MAPSIZE> old = cache;
+    cache.reset();
+    for( int smx = 0; smx < MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < MAPSIZE; ++smy ) {
+            const point src( smx + s.x(), smy + s.y() );
+            if( src.x >= 0 && src.x < MAPSIZE && src.y >= 0 && src.y < MAPSIZE ) {
+                cache[smx * MAPSIZE + smy] = old[src.x * MAPSIZE + src.y];
+            }
+        }
+    }
+}
+
+std::unordered_set<tripoint_abs_omt> map::quads_ahead( const point_rel_sm &dir, const int depth,
+        const int zmin, const int zmax ) const
+{
+    std::unordered_set<tripoint_abs_omt> quads;
+    if( dir == point_rel_sm::zero || depth <= 0 ) {
+        return quads;
+    }
+    const tripoint_abs_sm abs = get_abs_sub();
+    // The columns or rows about to come into the map, relative to its corner.
+    const auto ahead = [&]( int d ) {
+        return d > 0 ? std::make_pair( my_MAPSIZE, my_MAPSIZE + depth ) : std::make_pair( -depth, 0 );
+    };
+    const std::pair<int, int> whole = { 0, my_MAPSIZE };
+
+    const auto add_band = [&]( const std::pair<int, int> &xs, const std::pair<int, int> &ys ) {
+        for( int x = xs.first; x < xs.second; ++x ) {
+            for( int y = ys.first; y < ys.second; ++y ) {
+                for( int z = zmin; z <= zmax; ++z ) {
+                    quads.insert( project_to<coords::omt>( tripoint_abs_sm( abs.x() + x, abs.y() + y, z ) ) );
+                }
+            }
+        }
+    };
+    if( dir.x() != 0 ) {
+        add_band( ahead( dir.x() ), whole );
+    }
+    if( dir.y() != 0 ) {
+        add_band( whole, ahead( dir.y() ) );
+    }
+    return quads;
+}
+
+void map::prefetch_ahead( const point_rel_sm &dir, const int depth ) const
+{
+    const tripoint_abs_sm abs = get_abs_sub();
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs.z();
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs.z();
+    const std::unordered_set<tripoint_abs_omt> quads = quads_ahead( dir, depth, zmin, zmax );
+    if( quads.empty() ) {
+        return;
+    }
+    MAPBUFFER.prefetch( std::vector<tripoint_abs_omt>( quads.begin(), quads.end() ) );
+}
+
+void map::queue_generation_ahead( const point_rel_sm &dir, const int depth )
+{
+    // Mapgen makes every level of an overmap terrain at once.
+    const std::unordered_set<tripoint_abs_omt> quads = quads_ahead( dir, depth, 0, 0 );
+    generation_ahead.assign( quads.begin(), quads.end() );
+    const tripoint_abs_omt center = project_to<coords::omt>( get_abs_sub() + point( my_MAPSIZE / 2,
+                                    my_MAPSIZE / 2 ) );
+    std::sort( generation_ahead.begin(), generation_ahead.end(),
+    [&]( const tripoint_abs_omt & a, const tripoint_abs_omt & b ) {
+        return square_dist( a, center ) > square_dist( b, center );
+    } );
+}
+
+void map::generate_queued_ahead()
+{
+    const tripoint_abs_omt center = project_to<coords::omt>( get_abs_sub() + point( my_MAPSIZE / 2,
+                                    my_MAPSIZE / 2 ) );
+    while( !generation_ahead.empty() ) {
+        const tripoint_abs_omt omt = generation_ahead.back();
+        generation_ahead.pop_back();
+        // Left behind by a teleport or a turn, or generated or saved before.
+        if( square_dist( omt, center ) > my_MAPSIZE ||
+            MAPBUFFER.submap_exists_approx( project_to<coords::sm>( omt ) ) ) {
+            continue;
+        }
+        // The same as loadn does for submaps it finds missing.
+        smallmap tmp_map;
+        swap_map swap( *tmp_map.cast_to_map() );
+        tmp_map.main_cleanup_override( false );
+        tmp_map.generate( omt, calendar::turn, true );
+        return;
+    }
+}
+
 void map::shift( const point_rel_sm &sp )
 {
     if( !zlevels ) {
@@ -8042,6 +8366,12 @@ void map::shift( const point_rel_sm &sp )
             shift_bitset_cache<MAPSIZE_X, SEEX>( cache->map_memory_cache_dec, sp );
             shift_bitset_cache<MAPSIZE_X, SEEX>( cache->map_memory_cache_ter, sp );
             shift_bitset_cache<MAPSIZE, 1>( cache->field_cache, sp );
+            // The transparency of submaps that stay loaded does not change, so it moves along
+            // and only the submaps around the ones loaded below are rebuilt.
+            shift_tile_cache( cache->transparency_cache, sp );
+            shift_tile_cache( cache->transparent_cache_wo_fields, sp );
+            shift_submap_dirty_cache( cache->transparency_cache_dirty, sp );
+            cache->buffered_lm_dirty = true;
         }
     }
 
@@ -8069,6 +8399,22 @@ void map::shift( const point_rel_sm &sp )
         }
     }
 
+    // Tiles next to the new submaps can change their outside status, which in turn affects their
+    // transparency, so their submaps are rebuilt too.
+    for( const tripoint_rel_sm &loaded_grid : loaded_grids ) {
+        level_cache *cache = get_cache_lazy( loaded_grid.z() );
+        if( !cache ) {
+            continue;
+        }
+        for( int smx = loaded_grid.x() - 1; smx <= loaded_grid.x() + 1; ++smx ) {
+            for( int smy = loaded_grid.y() - 1; smy <= loaded_grid.y() + 1; ++smy ) {
+                if( smx >= 0 && smx < my_MAPSIZE && smy >= 0 && smy < my_MAPSIZE ) {
+                    cache->transparency_cache_dirty.set( smx * MAPSIZE + smy );
+                }
+            }
+        }
+    }
+
     rebuild_vehicle_level_caches();
 
     g->setremoteveh( remoteveh );
@@ -8228,8 +8574,11 @@ void map::loadn( const point_bub_sm &grid, bool update_vehicles )
 
     for( int z = start_z; z <= stop_z; z++ ) {
         const tripoint_abs_sm pos = { grid_abs_sub.xy(), z };
-        // New submap changes the content of the map and all caches must be recalculated
-        set_transparency_cache_dirty( z );
+        // New submap changes the content of the map and all caches must be recalculated,
+        // except for the transparency of the other submaps
+        if( inbounds_z( z ) ) {
+            get_cache( z ).transparency_cache_dirty.set( grid.x() * MAPSIZE + grid.y() );
+        }
         set_seen_cache_dirty( z );
         set_outside_cache_dirty( z );
         set_floor_cache_dirty( z );
@@ -8795,8 +9144,6 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
                                        bool ignore_sight )
 {
     Character &player_character = get_player_character();
-    const int s_range = std::min( HALF_MAPSIZE_X,
-                                  player_character.sight_range( g->light_level( player_character.posz() ) ) );
     int pop = group.population;
     std::vector<tripoint_bub_ms> locations;
     if( !ignore_sight ) {
@@ -8812,7 +9159,7 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
         ignore_sight = true;
     }
 
-    static const auto allow_on_terrain = [&]( const tripoint_bub_ms & p ) {
+    const auto allow_on_terrain = [this]( const tripoint_bub_ms & p ) {
         // TODO: flying creatures should be allowed to spawn without a floor,
         // but the new creature is created *after* determining the terrain, so
         // we can't check for it here.
@@ -8843,6 +9190,8 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
         ignore_inside_checks = true;
     }
 
+    const int s_range = ignore_sight ? 0 : std::min( HALF_MAPSIZE_X,
+                        player_character.sight_range( g->light_level( player_character.posz() ) ) );
     creature_tracker &creatures = get_creature_tracker();
     for( int x = 0; x < SEEX; ++x ) {
         for( int y = 0; y < SEEY; ++y ) {
@@ -8856,14 +9205,15 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
                 continue; // solid area, impassable
             }
 
-            if( !ignore_sight && sees( player_character.pos_bub(), fp, s_range ) ) {
-                continue; // monster must spawn outside the viewing range of the player
-            }
-
             if( !ignore_inside_checks && has_flag_ter_or_furn( ter_furn_flag::TFLAG_INDOORS, fp ) ) {
                 continue; // monster must spawn outside.
             }
 
+            // Done last, as the line of sight is by far the most expensive check.
+            if( !ignore_sight && sees( player_character.pos_bub(), fp, s_range ) ) {
+                continue; // monster must spawn outside the viewing range of the player
+            }
+
             locations.push_back( fp );
         }
     }
@@ -8926,7 +9276,7 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
                                tmp.wander_pos.to_string_writable() );
             }
 
-            monster *const placed = g->place_critter_at( make_shared_fast<monster>( tmp ),
+            monster *const placed = g->place_critter_at( make_pooled_shared_fast<monster>( tmp ),
                                     local_pos );
             if( placed ) {
                 placed->on_load();
@@ -9006,7 +9356,8 @@ void map::spawn_monsters_submap( const tripoint_rel_sm &gp, bool ignore_sight, b
 
             // This can fail, but there isn't much we can do about it if it does. We could output some
             // kind of info message, but, again, it's unlikely to result in anything that can be acted on.
-            g->place_critter_at_or_within( make_shared_fast<monster>( tmp ), this, center, points );
+            g->place_critter_at_or_within( make_pooled_shared_fast<monster>( tmp ), this, center,
+                                           points );
         }
     }
     current_submap->spawns.clear();
@@ -9297,6 +9648,7 @@ void map::build_outside_cache( const int zlev )
         return;
     }
     level_cache &ch = *ch_lazy;
+    ch.sunlight_inputs_dirty = true;
 
     // Make a bigger cache to avoid bounds checking
     // We will later copy it to our regular cache
@@ -9308,6 +9660,7 @@ void map::build_outside_cache( const int zlev )
     if( zlev < 0 ) {
         std::uninitialized_fill_n(
             &outside_cache[0][0], MAPSIZE_X * MAPSIZE_Y, false );
+        ch.outside_cache_dirty = false;
         return;
     }
 
@@ -9454,6 +9807,7 @@ bool map::build_floor_cache( const int zlev )
         return false;
     }
     level_cache &ch = *ch_lazy;
+    ch.sunlight_inputs_dirty = true;
 
     auto &floor_cache = ch.floor_cache;
     std::uninitialized_fill_n(
@@ -9513,7 +9867,8 @@ void map::build_floor_caches()
     }
 }
 
-static void vehicle_caching_internal( level_cache &zch, const vpart_reference &vp, vehicle *v )
+// Returns true if the part changed the transparency of its tile.
+static bool vehicle_caching_internal( level_cache &zch, const vpart_reference &vp, vehicle *v )
 {
     // TODO: Check if this is actually reasonable. Probably need to feed the map in.
     // The guess is that the reality bubble should be affected, but that needs to be checked as well.
@@ -9527,23 +9882,35 @@ static void vehicle_caching_internal( level_cache &zch, const vpart_reference &v
     const tripoint_bub_ms part_pos =  v->bub_part_pos( here, vp.part() );
 
     bool vehicle_is_opaque = vp.has_feature( VPFLAG_OPAQUE ) && !vp.part().is_broken();
+    bool transparency_changed = false;
 
     if( vehicle_is_opaque ) {
         int dpart = v->part_with_feature( part, VPFLAG_OPENABLE, true );
         if( dpart < 0 || !v->part( dpart ).open ) {
-            transparency_cache[part_pos.x()][part_pos.y()] = LIGHT_TRANSPARENCY_SOLID;
+            float &transparency = transparency_cache[part_pos.x()][part_pos.y()];
+            if( transparency != LIGHT_TRANSPARENCY_SOLID ) {
+                transparency = LIGHT_TRANSPARENCY_SOLID;
+                zch.buffered_lm_transparency_dirty.set( ( part_pos.x() / SEEX ) * MAPSIZE +
+                                                        part_pos.y() / SEEY );
+                transparency_changed = true;
+                zch.sunlight_inputs_dirty = true;
+            }
         } else {
             vehicle_is_opaque = false;
         }
     }
 
-    if( vehicle_is_opaque || vp.is_inside() ) {
+    if( ( vehicle_is_opaque || vp.is_inside() ) && outside_cache[part_pos.x()][part_pos.y()] ) {
         outside_cache[part_pos.x()][part_pos.y()] = false;
+        zch.sunlight_inputs_dirty = true;
     }
 
-    if( vp.has_feature( VPFLAG_BOARDABLE ) && !vp.part().is_broken() ) {
+    if( vp.has_feature( VPFLAG_BOARDABLE ) && !vp.part().is_broken() &&
+        !floor_cache[part_pos.x()][part_pos.y()] ) {
         floor_cache[part_pos.x()][part_pos.y()] = true;
+        zch.sunlight_inputs_dirty = true;
     }
+    return transparency_changed;
 }
 
 static void vehicle_caching_internal_above( level_cache &zch_above, const vpart_reference &vp,
@@ -9555,7 +9922,11 @@ static void vehicle_caching_internal_above( level_cache &zch_above, const vpart_
         reality_bubble();
     if( vp.has_feature( VPFLAG_ROOF ) || vp.has_feature( VPFLAG_OPAQUE ) ) {
         const tripoint_bub_ms part_pos = v->bub_part_pos( here, vp.part() );
-        zch_above.floor_cache[part_pos.x()][part_pos.y()] = true;
+        bool &has_floor = zch_above.floor_cache[part_pos.x()][part_pos.y()];
+        if( !has_floor ) {
+            has_floor = true;
+            zch_above.sunlight_inputs_dirty = true;
+        }
     }
 }
 
@@ -9571,7 +9942,9 @@ void map::do_vehicle_caching( int z )
             if( !inbounds( part_pos.xy() ) ) {
                 continue;
             }
-            vehicle_caching_internal( get_cache( part_pos.z() ), vp, v );
+            if( vehicle_caching_internal( get_cache( part_pos.z() ), vp, v ) ) {
+                ++vision_generation;
+            }
             if( part_pos.z() < OVERMAP_HEIGHT ) {
                 vehicle_caching_internal_above( get_cache( part_pos.z() + 1 ), vp, v );
             }
@@ -9585,11 +9958,24 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
     bool camera_cache_dirty = false;
+    // These only write to the cache of their own z-level, so the levels can be built in parallel.
+    // Their debug messages are reported from this thread once all levels are done.
+    std::array<bool, OVERMAP_LAYERS> floor_cache_was_dirty{};
+    std::array<bool, OVERMAP_LAYERS> transparency_cache_was_dirty{};
+    std::array<std::vector<deferred_debugmsg>, OVERMAP_LAYERS> level_messages;
+    cata::get_thread_pool().parallel_for( minz, maxz + 1, [&]( const int z ) {
+        defer_debugmsg_during( [&]() {
+            build_outside_cache( z );
+            transparency_cache_was_dirty[z + OVERMAP_DEPTH] = build_transparency_cache( z );
+            floor_cache_was_dirty[z + OVERMAP_DEPTH] = build_floor_cache( z );
+        }, level_messages[z + OVERMAP_DEPTH] );
+    } );
     for( int z = minz; z <= maxz; z++ ) {
-        build_outside_cache( z );
-        build_transparency_cache( z );
-        bool floor_cache_was_dirty = build_floor_cache( z );
-        seen_cache_dirty |= floor_cache_was_dirty;
+        report_deferred_debugmsg( level_messages[z + OVERMAP_DEPTH] );
+        if( transparency_cache_was_dirty[z + OVERMAP_DEPTH] ) {
+            ++vision_generation;
+        }
+        seen_cache_dirty |= floor_cache_was_dirty[z + OVERMAP_DEPTH];
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty;
     }
     // needs a separate pass as it changes the caches on neighbour z-levels (e.g. floor_cache);
@@ -10146,8 +10532,8 @@ void map::maybe_trigger_trap( const tripoint_bub_ms &pos, Creature &c, const boo
 }
 
 template<typename Functor>
-void map::function_over( const tripoint_bub_ms &start, const tripoint_bub_ms &end,
-                         Functor fun ) const
+void map::function_over_submaps( const tripoint_bub_ms &start, const tripoint_bub_ms &end,
+                                 Functor fun ) const
 {
     // start and end are just two points, end can be "before" start
     // Also clip the area to map area
@@ -10176,64 +10562,81 @@ void map::function_over( const tripoint_bub_ms &start, const tripoint_bub_ms &en
                     continue;
                 }
                 // Bounds on the submap coordinates
-                const point_bub_sm sm_min( smx > min_sm.x() ? 0 : min.x() % SEEX,
-                                           smy > min_sm.y() ? 0 : min.y() % SEEY );
-                const point_bub_sm sm_max( smx < max_sm.x() ? SEEX - 1 : max.x() % SEEX,
-                                           smy < max_sm.y() ? SEEY - 1 : max.y() % SEEY );
-
-                point_sm_ms lp;
-                int &sx = lp.x();
-                int &sy = lp.y();
-                for( sx = sm_min.x(); sx <= sm_max.x(); ++sx ) {
-                    for( sy = sm_min.y(); sy <= sm_max.y(); ++sy ) {
-                        const iteration_state rval = fun( gp, cur_submap, lp );
-                        if( rval != ITER_CONTINUE ) {
-                            switch( rval ) {
-                                case ITER_SKIP_ZLEVEL:
-                                    smx = my_MAPSIZE + 1;
-                                    smy = my_MAPSIZE + 1;
-                                    [[fallthrough]];
-                                case ITER_SKIP_SUBMAP:
-                                    sx = SEEX;
-                                    sy = SEEY;
-                                    break;
-                                default:
-                                    return;
-                            }
-                        }
-                    }
+                const point_sm_ms sm_min( smx > min_sm.x() ? 0 : min.x() % SEEX,
+                                          smy > min_sm.y() ? 0 : min.y() % SEEY );
+                const point_sm_ms sm_max( smx < max_sm.x() ? SEEX - 1 : max.x() % SEEX,
+                                          smy < max_sm.y() ? SEEY - 1 : max.y() % SEEY );
+
+                switch( fun( gp, cur_submap, sm_min, sm_max ) ) {
+                    case ITER_SKIP_ZLEVEL:
+                        smx = my_MAPSIZE + 1;
+                        smy = my_MAPSIZE + 1;
+                        break;
+                    case ITER_FINISH:
+                        return;
+                    default:
+                        break;
                 }
             }
         }
     }
 }
 
+template<typename Functor>
+void map::function_over( const tripoint_bub_ms &start, const tripoint_bub_ms &end,
+                         Functor fun ) const
+{
+    function_over_submaps( start, end, [&fun]( const tripoint_rel_sm & gp, const submap * sm,
+    const point_sm_ms & sm_min, const point_sm_ms & sm_max ) {
+        point_sm_ms lp;
+        int &sx = lp.x();
+        int &sy = lp.y();
+        for( sx = sm_min.x(); sx <= sm_max.x(); ++sx ) {
+            for( sy = sm_min.y(); sy <= sm_max.y(); ++sy ) {
+                const iteration_state rval = fun( gp, sm, lp );
+                if( rval != ITER_CONTINUE ) {
+                    return rval;
+                }
+            }
+        }
+        return ITER_CONTINUE;
+    } );
+}
+
 void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &blocks_scent,
                           std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
                           const point_bub_ms &min, const point_bub_ms &max )
 {
     ter_furn_flag reduce = ter_furn_flag::TFLAG_REDUCE_SCENT;
     ter_furn_flag block = ter_furn_flag::TFLAG_NO_SCENT;
-    auto fill_values = [&]( const tripoint_rel_sm & gp, const submap * sm, const point_sm_ms & lp ) {
+    auto fill_values = [&]( const tripoint_rel_sm & gp, const submap * sm,
+    const point_sm_ms & sm_min, const point_sm_ms & sm_max ) {
         // We need to generate the x/y coordinates, because we can't get them "for free"
-        const point_sm_ms p = lp + coords::project_to<coords::ms>( gp.xy() );
-        if( sm->get_ter( lp ).obj().has_flag( block ) ) {
-            blocks_scent[p.x()][p.y()] = true;
-            reduces_scent[p.x()][p.y()] = false;
-        } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
-                   sm->get_furn( lp ).obj().has_flag( reduce ) ) {
-            blocks_scent[p.x()][p.y()] = false;
-            reduces_scent[p.x()][p.y()] = true;
-        } else {
-            blocks_scent[p.x()][p.y()] = false;
-            reduces_scent[p.x()][p.y()] = false;
+        const auto origin = coords::project_to<coords::ms>( gp.xy() );
+        // A uniform submap has the same terrain and no furniture on all of its tiles
+        const bool uniform = sm->is_uniform();
+        bool blocks = false;
+        bool reduces = false;
+        for( int x = sm_min.x(); x <= sm_max.x(); ++x ) {
+            for( int y = sm_min.y(); y <= sm_max.y(); ++y ) {
+                const point_sm_ms lp( x, y );
+                if( !uniform || lp == sm_min ) {
+                    const ter_t &t = sm->get_ter( lp ).obj();
+                    blocks = t.has_flag( block );
+                    reduces = !blocks && ( t.has_flag( reduce ) ||
+                                           sm->get_furn( lp ).obj().has_flag( reduce ) );
+                }
+                const point_sm_ms p = lp + origin;
+                blocks_scent[p.x()][p.y()] = blocks;
+                reduces_scent[p.x()][p.y()] = reduces;
+            }
         }
 
         return ITER_CONTINUE;
     };
 
-    function_over( tripoint_bub_ms( min, abs_sub.z() ), tripoint_bub_ms( max, abs_sub.z() ),
-                   fill_values );
+    function_over_submaps( tripoint_bub_ms( min, abs_sub.z() ), tripoint_bub_ms( max, abs_sub.z() ),
+                           fill_values );
 
     const inclusive_rectangle<point_bub_ms> local_bounds( min, max );
 
@@ -10422,6 +10825,7 @@ const level_cache &map::access_cache( int zlev ) const
 pathfinding_cache::pathfinding_cache()
 {
     dirty = true;
+    changed_generation.fill( 0 );
 }
 
 pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
@@ -10432,6 +10836,7 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
+        count_invalidation( this, &cache_invalidation_counts::pathfinding );
         get_pathfinding_cache( zlev ).dirty = true;
     }
 }
@@ -10439,6 +10844,7 @@ void map::set_pathfinding_cache_dirty( const int zlev )
 void map::set_pathfinding_cache_dirty( const tripoint_bub_ms &p )
 {
     if( inbounds( p ) ) {
+        count_invalidation( this, &cache_invalidation_counts::pathfinding_points );
         get_pathfinding_cache( p.z() ).dirty_points.insert( p.xy() );
     }
 }
@@ -10460,6 +10866,27 @@ void map::main_cleanup_override( bool over )
     _main_cleanup_override = over;
 }
 
+int map::get_pathfinding_generation( const int zlev ) const
+{
+    return get_pathfinding_cache_ref( zlev ).generation;
+}
+
+bool map::route_unchanged_since( const std::vector<tripoint_bub_ms> &path,
+                                 const int generation ) const
+{
+    if( path.empty() ) {
+        return true;
+    }
+    const int zlev = path.front().z();
+    const pathfinding_cache &cache = get_pathfinding_cache_ref( zlev );
+    if( cache.rebuilt_generation > generation ) {
+        return false;
+    }
+    return std::all_of( path.begin(), path.end(), [&]( const tripoint_bub_ms & p ) {
+        return p.z() == zlev && inbounds( p ) && cache.changed_generation[p.xy()] <= generation;
+    } );
+}
+
 const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
 {
     if( !inbounds_z( zlev ) ) {
@@ -10499,6 +10926,12 @@ void map::update_pathfinding_cache( const tripoint_bub_ms &p ) const
         if( terrain.has_flag( ter_furn_flag::TFLAG_CLIMBABLE ) ) {
             cur_value |= PathfindingFlag::Climbable;
         }
+        if( terrain.open || furniture.open ) {
+            cur_value |= PathfindingFlag::Door;
+        }
+        if( ( furniture.id && furniture.bash ) || ( terrain.bash && !terrain.bash->bash_below ) ) {
+            cur_value |= PathfindingFlag::Bashable;
+        }
     }
 
     if( veh != nullptr ) {
@@ -10557,12 +10990,21 @@ void map::update_pathfinding_cache( int zlev ) const
             }
         }
         cache.dirty = false;
+        for( submap_graph &graph : cache.submap_graphs ) {
+            graph.dirty.set();
+        }
+        cache.rebuilt_generation = cache.generation + 1;
     } else {
         for( const point_bub_ms &p : cache.dirty_points ) {
             update_pathfinding_cache( { p, zlev } );
+            cache.changed_generation[p] = cache.generation + 1;
+            for( submap_graph &graph : cache.submap_graphs ) {
+                graph.dirty.set( ( p.x() / SEEX ) * MAPSIZE + p.y() / SEEY );
+            }
         }
     }
     cache.dirty_points.clear();
+    cache.generation++;
 }
 
 void map::clip_to_bounds( tripoint_bub_ms &p ) const
@@ -96,9 +96,14 @@ using VehicleList = std::vector<wrapped_vehicle>;
 class map;
 
 enum class ter_furn_flag : int;
+enum class route_passage : uint8_t;
 struct pathfinding_cache;
 struct pathfinding_settings;
 struct pathfinding_target;
+struct route_flow_field;
+struct route_flow_requests;
+struct route_sweep;
+struct submap_graph;
 template<typename T>
 struct weighted_int_list;
 struct field_proc_data;
@@ -368,6 +373,7 @@ class map
 {
         friend class teleport;
         friend class editmap;
+        friend class pixel_minimap;
         friend std::list<item> map_cursor::remove_items_with( const std::function<bool( const item & )> &,
                 int );
 
@@ -426,6 +432,21 @@ class map
 
         void invalidate_map_cache( int zlev );
 
+        // Calls of the above on the reality bubble, so the debug hour timer can show what keeps
+        // the caches rebuilding.  The point versions are counted apart from the level ones.
+        struct cache_invalidation_counts {
+            uint64_t transparency = 0;
+            uint64_t transparency_points = 0;
+            uint64_t seen = 0;
+            uint64_t seen_points = 0;
+            uint64_t outside = 0;
+            uint64_t floor = 0;
+            uint64_t pathfinding = 0;
+            uint64_t pathfinding_points = 0;
+            uint64_t whole_level = 0;
+        };
+        static cache_invalidation_counts &invalidation_counts();
+
         // @returns true if map memory decoration should be re/memorized
         bool memory_cache_dec_is_dirty( const tripoint_bub_ms &p ) const;
         // @returns true if map memory terrain should be re/memorized
@@ -530,6 +551,21 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( const point_rel_sm &s );
+        /**
+         * Start reading the saved submaps of the depth submaps beyond the edge of the map in
+         * direction dir, so that shifting there does not wait for the disk.
+         */
+        void prefetch_ahead( const point_rel_sm &dir, int depth ) const;
+        /**
+         * Queue the overmap terrains depth submaps beyond the edge of the map in direction dir
+         * for generate_queued_ahead, in place of those queued before.
+         */
+        void queue_generation_ahead( const point_rel_sm &dir, int depth );
+        /**
+         * Run mapgen for the nearest queued overmap terrain that was never generated, so that
+         * shifting seldom has to generate a whole edge of the map at once.  Called once per turn.
+         */
+        void generate_queued_ahead();
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -639,6 +675,18 @@ class map
         */
         bool sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, int range,
                    bool with_fields = true ) const;
+        // Changes whenever one of the level caches that sight is worked out from may have
+        // changed, so creature_tracker::sees knows which answers it remembers are stale.
+        uint64_t get_vision_generation() const {
+            return vision_generation;
+        }
+        /**
+        * Batched version of sees() for a single observer, returns whether `F` sees each of
+        * `targets`.  Lines of sight in the same direction share their walk, so this is
+        * cheaper than querying the targets one by one.
+        */
+        std::vector<bool> sees( const tripoint_bub_ms &F, const std::vector<tripoint_bub_ms> &targets,
+                                int range, bool with_fields = true ) const;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -734,25 +782,99 @@ class map
          */
         std::vector<tripoint_bub_ms> route( const Creature &who, const pathfinding_target &target ) const;
 
+        /**
+         * Like route( who, pathfinding_target::point( t ) ), but once a second creature heads for
+         * t with the same pathfinding settings this turn, answered from a flow field they all
+         * share, so a crowd chasing one target costs a single search.  Falls back to route for
+         * the first of them, when t is on another z-level, can't be reached on this one, or the
+         * shared path crosses a tile who avoids.
+         */
+        std::vector<tripoint_bub_ms> flow_route( const Creature &who, const tripoint_bub_ms &t ) const;
+
+        /**
+         * Cost of the cheapest route from f into each of targets, or -1 for targets it can't
+         * reach, found with a single search of the whole map rather than one route per target.
+         * Uses the step costs of route, so a target that is unreachable here is one route
+         * won't find a path to either.  route bounds its search, so it may still fail for a
+         * target reachable here.
+         */
+        std::vector<int> route_costs( const tripoint_bub_ms &f,
+                                      const std::vector<pathfinding_target> &targets,
+                                      const pathfinding_settings &settings,
+        const std::function<bool( const tripoint_bub_ms & )> &avoid = []( const tripoint_bub_ms & ) {
+            return false;
+        } ) const;
+        std::vector<int> route_costs( const Creature &who,
+                                      const std::vector<pathfinding_target> &targets ) const;
+
+        /**
+         * False if no route from f to target can exist on this z-level for settings, because
+         * they are in parts of it that no tile the route could pass connects.  Answered from
+         * labels of the level that are kept up to date with the pathfinding cache, so it is
+         * cheap enough to ask before every search.  Always true for routes between z-levels.
+         */
+        bool route_possible( const tripoint_bub_ms &f, const pathfinding_target &target,
+                             const pathfinding_settings &settings ) const;
+
         // Get a straight route from f to t, only along non-rough terrain. Returns an empty vector
         // if that is not possible.
         std::vector<tripoint_bub_ms> straight_route( const tripoint_bub_ms &f,
                 const tripoint_bub_ms &t ) const;
     private:
+        // straight_route, but empty if the line crosses any special or avoided tile.
+        std::vector<tripoint_bub_ms> plain_straight_route( const tripoint_bub_ms &f,
+                const tripoint_bub_ms &t,
+                const std::function<bool( const tripoint_bub_ms & )> &avoid ) const;
+        // A* from f to target.  Searches the padded bounding box of f and the target, or the
+        // whole level restricted to the submaps set in corridor if one is given.  Then
+        // left_corridor, if given, is set when the search had to skip a tile outside the
+        // corridor.  With a sweep, target is ignored and the search is a Dijkstra over the
+        // whole map that records the cost of reaching every target of the sweep instead of
+        // returning a route.
+        std::vector<tripoint_bub_ms> route_search( const tripoint_bub_ms &f,
+                const pathfinding_target &target, const pathfinding_settings &settings,
+                const std::function<bool( const tripoint_bub_ms & )> &avoid,
+                const std::bitset<MAPSIZE * MAPSIZE> *corridor, bool *left_corridor,
+                route_sweep *sweep ) const;
+        // route_search, with the settings it checks for every tile taken from flags.  Flags
+        // types that fix them at compile time let common profiles skip those branches.
+        template<typename Flags>
+        std::vector<tripoint_bub_ms> route_kernel( const tripoint_bub_ms &f,
+                const pathfinding_target &target, const pathfinding_settings &settings,
+                const Flags &flags, const std::function<bool( const tripoint_bub_ms & )> &avoid,
+                const std::bitset<MAPSIZE * MAPSIZE> *corridor, bool *left_corridor,
+                route_sweep *sweep ) const;
+        // The submap graph of zlev for passage, with any submaps changed since it was last
+        // used labelled again.
+        const submap_graph &get_submap_graph( int zlev, route_passage passage ) const;
+        // Submaps, indexed smx * MAPSIZE + smy, that a route from f to t on one z-level should
+        // stay in: those on the cheapest path through the pathfinding cache's submap graph and
+        // their neighbours.
+        std::bitset<MAPSIZE * MAPSIZE> route_corridor( const tripoint_bub_ms &f,
+                const tripoint_bub_ms &t ) const;
+        // Records that flow_route was asked for t with settings, and returns whether it already
+        // was this turn, so a flow field is worth building or was built.
+        bool route_flow_shared( const tripoint_bub_ms &t, const pathfinding_settings &settings ) const;
+        // Finds or builds the flow field to t for settings.  Stale fields are dropped first.
+        const route_flow_field &get_route_flow_field( const tripoint_bub_ms &t,
+                const pathfinding_settings &settings ) const;
         // Pathfinding cost helper that computes the cost of moving into |p| from |cur|.
         // Includes climbing, bashing and opening doors.
+        // The avoid_* settings are taken from flags, as in route_kernel.
+        template<typename Flags>
         int cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
-                          const pathfinding_settings &settings,
+                          const pathfinding_settings &settings, const Flags &flags,
                           PathfindingFlags p_special ) const;
         // Pathfinding cost helper that computes the cost of moving into |p|
         // from |cur| based on perceived danger.
         // Includes moving through traps.
+        template<typename Flags>
         int cost_to_avoid( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
-                           const pathfinding_settings &settings,
-                           PathfindingFlags p_special ) const;
+                           const Flags &flags, PathfindingFlags p_special ) const;
         // Sum of cost_to_pass and cost_to_avoid.
+        template<typename Flags>
         int extra_cost( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
-                        const pathfinding_settings &settings,
+                        const pathfinding_settings &settings, const Flags &flags,
                         PathfindingFlags p_special ) const;
     public:
 
@@ -1208,6 +1330,10 @@ class map
         void set_radiation( const point_bub_ms &p, const int value ) {
             set_radiation( tripoint_bub_ms( p, abs_sub.z() ), value );
         }
+        /** Sets the radiation of every tile in the rectangle p1 - p2 (inclusive) on z-level z,
+         *  resolving each submap only once. Tiles outside of the map are skipped.
+         */
+        void set_radiation_square( const point_bub_ms &p1, const point_bub_ms &p2, int z, int value );
 
         /** Increment the radiation in the given tile by the given delta
         *  (decrement it if delta is negative)
@@ -1398,6 +1524,8 @@ class map
         // Places a list of items, or nothing if the list is empty.
         std::vector<item *> spawn_items( const tripoint_bub_ms &p,
                                          const std::vector<item> &new_items );
+        // The same, but moves the items onto the map instead of copying them.
+        std::vector<item *> spawn_items( const tripoint_bub_ms &p, std::vector<item> &&new_items );
 
         void create_anomaly( const tripoint_bub_ms &p, artifact_natural_property prop,
                              bool create_rubble = true );
@@ -2109,6 +2237,15 @@ class map
         template<typename Functor>
         void function_over( const tripoint_bub_ms &start, const tripoint_bub_ms &end, Functor fun ) const;
         /*@}*/
+        /**
+        * Same as `function_over`, but runs the functor once per submap with the bounds of the
+        * area on it, so it can look at whole rows or uniform submaps at once.
+        * The functor is called as `fun( gp, submap, sm_min, sm_max )`, both bounds inclusive.
+        * ITER_SKIP_SUBMAP is the same as ITER_CONTINUE.
+        */
+        template<typename Functor>
+        void function_over_submaps( const tripoint_bub_ms &start, const tripoint_bub_ms &end,
+                                    Functor fun ) const;
 
         /**
          * The list of currently loaded submaps. The size of this should not be changed.
@@ -2137,11 +2274,19 @@ class map
         mutable std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        // Flow fields built by flow_route, oldest first.
+        mutable std::vector<std::unique_ptr<route_flow_field>> route_flow_fields;
+        mutable std::unique_ptr<route_flow_requests> route_flow_asked;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
         std::set<tripoint_abs_sm> submaps_with_active_items;
         std::set<tripoint_abs_sm> submaps_with_active_items_dirty;
+        // Overmap terrains for generate_queued_ahead, the nearest last.
+        std::vector<tripoint_abs_omt> generation_ahead;
+        // The overmap terrains with submaps depth submaps beyond the edge towards dir.
+        std::unordered_set<tripoint_abs_omt> quads_ahead( const point_rel_sm &dir, int depth,
+                int zmin, int zmax ) const;
 
         /**
          * Cache of coordinate pairs recently checked for visibility.
@@ -2166,6 +2311,20 @@ class map
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
 
         visibility_variables visibility_variables_cache;
+        // See get_vision_generation.
+        uint64_t vision_generation = 0;
+        // Inputs of the last build_sunlight_cache pass, which is skipped while they stay the same.
+        struct sunlight_snapshot {
+            int pzlev = INT_MIN;
+            int zlev_max = INT_MIN;
+            float sight_penalty = 0.0f;
+            std::array<float, OVERMAP_LAYERS> natural_light{};
+            // Set once light sources were cast onto a level other than pzlev after the pass.
+            bool other_levels_lit = false;
+            // Sunlight of pzlev, which generate_lightmap overwrites with the other light sources.
+            cata::mdarray<four_quadrants, point_bub_ms> lm;
+        };
+        std::unique_ptr<sunlight_snapshot> last_sunlight;
 
         // caches the highest zlevel above which all zlevels are uniform
         // !value || value->first != map::abs_sub means cache is invalid
@@ -2187,6 +2346,12 @@ class map
         }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
+        // Current generation of the pathfinding cache of zlev, to check routes planned now
+        // with route_unchanged_since later.
+        int get_pathfinding_generation( int zlev ) const;
+        // True if path stays on one z-level and none of its tiles changed in the pathfinding
+        // cache after it had the given generation.
+        bool route_unchanged_since( const std::vector<tripoint_bub_ms> &path, int generation ) const;
 
         void update_pathfinding_cache( const tripoint_bub_ms &p ) const;
         void update_pathfinding_cache( int zlev ) const;
@@ -2405,6 +2570,9 @@ class tinymap : private map
         std::vector<item *> spawn_items( const tripoint_omt_ms &p, const std::vector<item> &new_items ) {
             return map::spawn_items( rebase_bub( p ), new_items );
         }
+        std::vector<item *> spawn_items( const tripoint_omt_ms &p, std::vector<item> &&new_items ) {
+            return map::spawn_items( rebase_bub( p ), std::move( new_items ) );
+        }
         item &add_item( const tripoint_omt_ms &p, item new_item ) {
             return map::add_item( rebase_bub( p ), std::move( new_item ) );
         }
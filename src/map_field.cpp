@@ -276,13 +276,6 @@ void map::gas_spread_to( field_entry &cur, maptile &dst, const tripoint_bub_ms &
 void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_spread,
                       const time_duration &outdoor_age_speedup, scent_block &sblk, const oter_id &om_ter )
 {
-    const bool sheltered = g->is_sheltered( p );
-    weather_manager &weather = get_weather();
-    const int winddirection = weather.winddirection;
-    const int windpower = get_local_windpower( weather.windspeed, om_ter, get_abs( p ),
-                          winddirection,
-                          sheltered );
-
     const int current_intensity = cur.get_field_intensity();
     const field_type_id ft_id = cur.get_field_type();
 
@@ -302,8 +295,20 @@ void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_sp
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
-    // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+    // Bail out if we don't meet the required intensity, before working out the wind.
+    if( current_intensity <= 1 ) {
+        return;
+    }
+
+    const bool sheltered = g->is_sheltered( p );
+    weather_manager &weather = get_weather();
+    const int winddirection = weather.winddirection;
+    const int windpower = get_local_windpower( weather.windspeed, om_ter, get_abs( p ),
+                          winddirection,
+                          sheltered );
+
+    // Bail out if we don't meet the spread chance.
+    if( rng( 1, 100 - windpower ) > percent_spread ) {
         return;
     }
 
@@ -446,6 +451,16 @@ void map::process_fields_in_submap( submap *const current_submap,
     // Loop through all tiles in this submap indicated by current_submap
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            // Skip the tiles that are known to hold no fields without touching them.
+            // The column is read again for every tile, as processing can add fields.
+            const int column = current_submap->get_field_column( locx ) >> locy;
+            if( column == 0 ) {
+                break;
+            }
+            if( !( column & 1 ) ) {
+                continue;
+            }
+
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
             field &curfield = current_submap->get_field( { static_cast<int>( locx ), static_cast<int>( locy ) } );
@@ -453,6 +468,9 @@ void map::process_fields_in_submap( submap *const current_submap,
             // when displayed_field_type == fd_null it means that `curfield` has no fields inside
             // avoids instantiating (relatively) expensive map iterator
             if( !curfield.displayed_field_type() ) {
+                if( curfield.field_count() == 0 ) {
+                    current_submap->unmark_field_tile( map_tile.pos() );
+                }
                 continue;
             }
 
@@ -1760,6 +1778,10 @@ void map::creature_in_field( Creature &critter )
     bool in_vehicle = false;
     bool inside_vehicle = false;
     if( critter.is_monster() ) {
+        // Monsters are only ever affected by the fields on their tile, and most submaps have none.
+        if( !has_field_at( critter.pos_bub() ) ) {
+            return;
+        }
         monster_in_field( *static_cast<monster *>( &critter ) );
     } else {
         Character *you = critter.as_character();
@@ -1,18 +1,23 @@
 #include <algorithm>
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <filesystem>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 
 #include "cached_options.h"
 #include "cata_assert.h"
 #include "cata_path.h"
 #include "cata_utility.h"
+#include "compression_dictionary.h"
 #include "coordinate_conversions.h"
 #include "cuboid_rectangle.h"
 #include "debug.h"
@@ -22,12 +27,14 @@
 #include "json_loader.h"
 #include "map_memory.h"
 #include "path_info.h"
+#include "save_writer.h"
 #include "string_formatter.h"
 #include "translations.h"
 #include "worldfactory.h"
 #include "zzip_stack.h"
 
 const memorized_tile mm_submap::default_tile = {};
+static_assert( sizeof( memorized_tile ) == 16, "Map memory holds a lot of tiles" );
 
 static constexpr int MM_SIZE = MAPSIZE * 2;
 
@@ -39,7 +46,7 @@ static tripoint_abs_sm mmr_to_sm_copy( const tripoint &p )
     return tripoint_abs_sm( p.x * MM_REG_SIZE, p.y * MM_REG_SIZE, p.z );
 }
 
-static cata_path find_mm_dir()
+cata_path map_memory::save_dir()
 {
     return PATH_INFO::player_base_save_path() + ".mm1";
 }
@@ -107,24 +114,90 @@ bool mm_region::is_empty() const
     return true;
 }
 
+namespace
+{
+
+// Like the rest of map memory, only used from the main thread.
+struct memorized_id_table {
+    // A deque so the ids stay where the index points into them.
+    std::deque<std::string> ids;
+    std::unordered_map<std::string_view, uint32_t> index;
+
+    memorized_id_table() {
+        intern( "" );
+    }
+
+    uint32_t intern( std::string_view id ) {
+        const auto it = index.find( id );
+        if( it != index.end() ) {
+            return it->second;
+        }
+        const uint32_t ret = ids.size();
+        ids.emplace_back( id );
+        index.emplace( ids.back(), ret );
+        return ret;
+    }
+};
+
+memorized_id_table &memorized_ids()
+{
+    static memorized_id_table table;
+    return table;
+}
+
+} // namespace
+
+uint32_t memorized_tile::intern( std::string_view id )
+{
+    if( id.empty() ) {
+        return 0;
+    }
+    return memorized_ids().intern( id );
+}
+
+const std::string &memorized_tile::interned( uint32_t index )
+{
+    return memorized_ids().ids[index];
+}
+
 const std::string &memorized_tile::get_ter_id() const
 {
-    return ter_id.str();
+    return interned( ter_id );
 }
 
 const std::string &memorized_tile::get_dec_id() const
 {
-    return dec_id;
+    return interned( dec_id );
 }
 
 void memorized_tile::set_ter_id( std::string_view id )
 {
-    ter_id = ter_str_id( id );
+    ter_id = intern( id );
 }
 
 void memorized_tile::set_dec_id( std::string_view id )
 {
-    dec_id = id;
+    dec_id = intern( id );
+}
+
+int mm_string_table::index_of( uint32_t id )
+{
+    const auto it = index.find( id );
+    if( it != index.end() ) {
+        return it->second;
+    }
+    const int ret = ids.size();
+    ids.push_back( id );
+    index.emplace( id, ret );
+    return ret;
+}
+
+uint32_t mm_string_table::id_at( int index ) const
+{
+    if( index < 0 || static_cast<size_t>( index ) >= ids.size() ) {
+        throw JsonError( string_format( "map memory refers to unknown id %d", index ) );
+    }
+    return ids[index];
 }
 
 int memorized_tile::get_ter_rotation() const
@@ -299,6 +372,7 @@ bool map_memory::prepare_region( const tripoint_abs_ms &p1, const tripoint_abs_m
     cache_pos = sm_pos;
     cache_size = sm_size.raw();
     cached.clear();
+    std::shared_ptr<zzip_stack> stack;
     // Loop through each z-level in vision range
     for( int z = std::max( sm_pos.z() - fov_3d_z_range, -OVERMAP_DEPTH );
          z <= std::min( sm_pos.z() + fov_3d_z_range, OVERMAP_HEIGHT ); z++ ) {
@@ -307,20 +381,21 @@ bool map_memory::prepare_region( const tripoint_abs_ms &p1, const tripoint_abs_m
             for( int dx = 0; dx < cache_size.x; dx++ ) {
                 // Store submap pointer in cache, categorized by z-level
                 const tripoint_abs_sm smpos( cache_pos.x() + dx, cache_pos.y() + dy, z );
-                cached[z].push_back( fetch_submap( smpos ) );
+                cached[z].push_back( fetch_submap( smpos, stack ) );
             }
         }
     }
     return true;
 }
 
-shared_ptr_fast<mm_submap> map_memory::fetch_submap( const tripoint_abs_sm &sm_pos )
+shared_ptr_fast<mm_submap> map_memory::fetch_submap( const tripoint_abs_sm &sm_pos,
+        std::shared_ptr<zzip_stack> &stack )
 {
     shared_ptr_fast<mm_submap> sm = find_submap( sm_pos );
     if( sm ) {
         return sm;
     }
-    sm = load_submap( sm_pos );
+    sm = load_submap( sm_pos, stack );
     if( sm ) {
         return sm;
     }
@@ -339,7 +414,7 @@ shared_ptr_fast<mm_submap> map_memory::allocate_submap( const tripoint_abs_sm &s
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
         for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
             const tripoint_abs_sm pos( mmr_to_sm_copy( reg ) + tripoint( x, y, 0 ) );
-            shared_ptr_fast<mm_submap> sm = make_shared_fast<mm_submap>();
+            shared_ptr_fast<mm_submap> sm = make_pooled_shared_fast<mm_submap>();
             if( pos == sm_pos ) {
                 ret = sm;
             }
@@ -360,14 +435,15 @@ shared_ptr_fast<mm_submap> map_memory::find_submap( const tripoint_abs_sm &sm_po
     }
 }
 
-shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint_abs_sm &sm_pos )
+shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint_abs_sm &sm_pos,
+        std::shared_ptr<zzip_stack> &stack )
 {
     if( test_mode ) {
         return nullptr;
     }
 
     const reg_coord_pair p( sm_pos );
-    const cata_path mm_dir = find_mm_dir();
+    const cata_path mm_dir = save_dir();
     std::filesystem::path mm_filename = std::filesystem::u8path( find_region_filename( p.reg ) );
 
     mm_region mmr;
@@ -378,12 +454,16 @@ shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint_abs_sm &sm_po
     try {
 
         if( world_generator->active_world->has_compression_enabled() ) {
-            std::shared_ptr<zzip_stack> z = zzip_stack::load( mm_dir.get_unrelative_path(),
-                                            ( PATH_INFO::world_base_save_path() / "mmr.dict" ).get_unrelative_path() );
-            if( !z ) {
-                return nullptr;
+            if( !stack ) {
+                // The stack may be being compacted in the background, see zzip_maintenance.
+                get_save_writer().wait_for( mm_dir.generic_u8string() );
+                stack = zzip_stack::load( mm_dir.get_unrelative_path(),
+                                          compression_dictionary::current( compression_kind::map_memory ) );
+                if( !stack ) {
+                    return nullptr;
+                }
             }
-            if( !read_from_zzip_optional( z, mm_filename, [&]( std::string_view sv ) {
+            if( !read_from_zzip_optional( stack, mm_filename, [&]( std::string_view sv ) {
             JsonValue jsin = json_loader::from_string( std::string( sv ) );
                 loader( jsin );
             } ) ) {
@@ -444,6 +524,17 @@ mm_submap &map_memory::get_submap( const tripoint_abs_sm &sm_pos )
     }
 }
 
+size_t map_memory::memory_estimate() const
+{
+    size_t total = 0;
+    for( const auto &[p, sm] : submaps ) {
+        if( sm ) {
+            total += sm->memory_estimate();
+        }
+    }
+    return total;
+}
+
 bool map_memory::is_valid() const
 {
     return cache_pos != invalid_cache_pos;
@@ -456,9 +547,10 @@ void map_memory::load( const tripoint_abs_ms &pos )
     dbg( D_INFO ) << "[LOAD] Loading memory map around " << p.sm << ". Loading submaps within " << start
                   << "->" << start + tripoint( MM_SIZE, MM_SIZE, 0 );
     clear_cache();
+    std::shared_ptr<zzip_stack> stack;
     for( int dy = 0; dy < MM_SIZE; dy++ ) {
         for( int dx = 0; dx < MM_SIZE; dx++ ) {
-            fetch_submap( start + tripoint_rel_sm( dx, dy, 0 ) );
+            fetch_submap( start + tripoint_rel_sm( dx, dy, 0 ), stack );
         }
     }
     dbg( D_INFO ) << "[LOAD] Done.";
@@ -467,7 +559,7 @@ void map_memory::load( const tripoint_abs_ms &pos )
 bool map_memory::save( const tripoint_abs_ms &pos )
 {
     const tripoint_abs_sm sm_center = coord_pair( pos ).sm;
-    const cata_path dirname = find_mm_dir();
+    const cata_path dirname = save_dir();
     assure_dir_exist( dirname );
 
     clear_cache();
@@ -493,8 +585,9 @@ bool map_memory::save( const tripoint_abs_ms &pos )
 
     std::shared_ptr<zzip_stack> z;
     if( world_generator->active_world->has_compression_enabled() ) {
+        get_save_writer().wait_for( dirname.generic_u8string() );
         z = zzip_stack::load( dirname.get_unrelative_path(),
-                              ( PATH_INFO::world_base_save_path() / "mmr.dict" ).get_unrelative_path() );
+                              compression_dictionary::current( compression_kind::map_memory ) );
     }
     for( auto &it : regions ) {
         const tripoint &regp = it.first;
@@ -511,6 +604,7 @@ bool map_memory::save( const tripoint_abs_ms &pos )
 
             if( world_generator->active_world->has_compression_enabled() ) {
                 if( z ) {
+                    compression_dictionary::add_sample( compression_kind::map_memory, mm_str );
                     result = z->add_file( mm_filename, mm_str ) && result;
                 } else {
                     result = false;
@@ -555,6 +649,22 @@ bool map_memory::save( const tripoint_abs_ms &pos )
     return result;
 }
 
+void map_memory::drop_far_submaps( const tripoint_abs_ms &pos )
+{
+    const tripoint_abs_sm sm_center = coord_pair( pos ).sm;
+    constexpr point MM_HSIZE_P = point( MM_SIZE / 2, MM_SIZE / 2 );
+    rectangle<point_abs_sm> rect_keep( sm_center.xy() - MM_HSIZE_P, sm_center.xy() + MM_HSIZE_P );
+    clear_cache();
+    // Whole regions are kept or dropped, like save does.
+    for( auto it = submaps.begin(); it != submaps.end(); ) {
+        const tripoint_abs_sm regp_sm( mmr_to_sm_copy( reg_coord_pair( it->first ).reg ) );
+        const half_open_rectangle<point_abs_sm> rect_reg(
+            regp_sm.xy(),
+            regp_sm.xy() + point( MM_REG_SIZE, MM_REG_SIZE ) );
+        it = rect_reg.overlaps( rect_keep ) ? std::next( it ) : submaps.erase( it );
+    }
+}
+
 void map_memory::clear_cache()
 {
     cached.clear();
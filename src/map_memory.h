@@ -4,8 +4,10 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "coordinates.h"
@@ -18,6 +20,8 @@
 class JsonArray;
 class JsonOut;
 class JsonValue;
+class cata_path;
+class zzip_stack;
 
 class memorized_tile
 {
@@ -43,16 +47,34 @@ class memorized_tile
         bool operator!=( const memorized_tile &rhs ) const {
             return !( *this == rhs );
         }
+
+        // Tiles hold the index of their ids in a table of all memorized ids, which keeps them
+        // at 16 bytes.  Index 0 is the empty id.
+        static uint32_t intern( std::string_view id );
+        static const std::string &interned( uint32_t index );
     private:
         friend struct mm_submap; // serialization needs access to private members
-        ter_str_id ter_id;       // terrain tile id
-        std::string dec_id;      // decoration tile id (furniture, vparts ...)
+        uint32_t ter_id = 0;     // terrain tile id
+        uint32_t dec_id = 0;     // decoration tile id (furniture, vparts ...)
         int8_t ter_rotation = 0;
         int8_t dec_rotation = 0;
         int8_t ter_subtile = 0;
         int8_t dec_subtile = 0;
 };
 
+/**
+ * The ids the tiles of a saved region refer to.  Each is saved once, and the tiles save
+ * their index in here.
+ */
+struct mm_string_table {
+    // Interned ids (see memorized_tile::intern) by their index in the saved table.
+    std::vector<uint32_t> ids;
+    std::unordered_map<uint32_t, int> index;
+
+    int index_of( uint32_t id );
+    uint32_t id_at( int index ) const;
+};
+
 /** Represent a submap-sized chunk of tile memory. */
 struct mm_submap {
     public:
@@ -69,8 +91,12 @@ struct mm_submap {
         const memorized_tile &get_tile( const point_sm_ms &p ) const;
         void set_tile( const point_sm_ms &p, const memorized_tile &value );
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( int version, const JsonArray &ja );
+        void serialize( JsonOut &jsout, mm_string_table &strings ) const;
+        void deserialize( int version, const JsonArray &ja, const mm_string_table &strings );
+
+        size_t memory_estimate() const {
+            return sizeof( mm_submap ) + tiles.capacity() * sizeof( memorized_tile );
+        }
 
     private:
         // NOLINTNEXTLINE(cata-serialize)
@@ -118,12 +144,19 @@ class map_memory
         // @returns true if map memory has been loaded
         bool is_valid() const;
 
+        /** Folder the map memory of the current character is saved in. */
+        static cata_path save_dir();
+
         /** Load memorized submaps around given global map square pos. */
         void load( const tripoint_abs_ms &pos );
 
         /** Save memorized submaps to disk, drop ones far from given global map square pos. */
         bool save( const tripoint_abs_ms &pos );
 
+        /** Drop the submaps save would drop, without saving them.  For when a forked copy of
+         * this process saved them. */
+        void drop_far_submaps( const tripoint_abs_ms &pos );
+
         /**
          * Prepares map memory for rendering and/or memorization of given region.
          * @param p1 top-left corner of the region, in global ms coords
@@ -166,6 +199,9 @@ class map_memory
          */
         void clear_tile_decoration( const tripoint_abs_ms &pos, std::string_view prefix = "" );
 
+        /** Estimated memory use of the memorized submaps, in bytes. */
+        size_t memory_estimate() const;
+
     private:
         std::map<tripoint_abs_sm, shared_ptr_fast<mm_submap>> submaps;
 
@@ -173,12 +209,18 @@ class map_memory
         tripoint_abs_sm cache_pos;
         point cache_size;
 
-        /** Find, load or allocate a submap. @returns the submap. */
-        shared_ptr_fast<mm_submap> fetch_submap( const tripoint_abs_sm &sm_pos );
+        /**
+         * Find, load or allocate a submap. @returns the submap.
+         * @param stack compressed save the submap is read from, opened on first use so that
+         * several fetches share it.
+         */
+        shared_ptr_fast<mm_submap> fetch_submap( const tripoint_abs_sm &sm_pos,
+                std::shared_ptr<zzip_stack> &stack );
         /** Find submap amongst the loaded submaps. @returns nullptr if failed. */
         shared_ptr_fast<mm_submap> find_submap( const tripoint_abs_sm &sm_pos );
         /** Load submap from disk. @returns nullptr if failed. */
-        shared_ptr_fast<mm_submap> load_submap( const tripoint_abs_sm &sm_pos );
+        shared_ptr_fast<mm_submap> load_submap( const tripoint_abs_sm &sm_pos,
+                                                std::shared_ptr<zzip_stack> &stack );
         /** Allocate empty submap. @returns the submap. */
         shared_ptr_fast<mm_submap> allocate_submap( const tripoint_abs_sm &sm_pos );
 
@@ -1,33 +1,47 @@
 #include "mapbuffer.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <cstddef>
 #include <exception>
 #include <filesystem>
 #include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <zstd/common/xxhash.h>
+
 #include "cata_path.h"
+#include "cata_thread_pool.h"
 #include "cata_utility.h"
+#include "compression_dictionary.h"
 #include "debug.h"
 #include "filesystem.h"
+#include "flexbuffer_cache.h"
 #include "flexbuffer_json.h"
 #include "input.h"
 #include "json.h"
 #include "json_loader.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
 #include "point.h"
 #include "popup.h"
+#include "save_writer.h"
 #include "std_hash_fs_path.h"
 #include "string_formatter.h"
 #include "submap.h"
@@ -59,14 +73,180 @@ static cata_path find_dirname( const tripoint_abs_omt &om_addr )
             segment_addr.y(), segment_addr.z() );
 }
 
+// Quads saved with BINARY_SUBMAPS hold the FlexBuffer of their json behind this header:
+// the magic, the format version and the size of the buffer, so that loading them skips the
+// json parse.  Json quads start with '[' and can never match the magic.
+static constexpr std::string_view binary_quad_magic = "CSMB";
+static constexpr uint32_t binary_quad_version = 1;
+static constexpr size_t binary_quad_header_size = binary_quad_magic.size() + sizeof( uint32_t ) +
+        sizeof( uint64_t );
+
+template<typename T>
+static void append_le( std::string &out, T value )
+{
+    for( size_t i = 0; i < sizeof( T ); ++i ) {
+        out.push_back( static_cast<char>( ( value >> ( 8 * i ) ) & 0xff ) );
+    }
+}
+
+template<typename T>
+static T read_le( std::string_view in )
+{
+    T value = 0;
+    for( size_t i = 0; i < sizeof( T ); ++i ) {
+        value |= static_cast<T>( static_cast<unsigned char>( in[i] ) ) << ( 8 * i );
+    }
+    return value;
+}
+
+static std::string encode_binary_quad( const std::string &json )
+{
+    const std::vector<uint8_t> buffer = flexbuffer_cache::json_to_binary( json );
+    std::string out;
+    out.reserve( binary_quad_header_size + buffer.size() );
+    out.append( binary_quad_magic );
+    append_le<uint32_t>( out, binary_quad_version );
+    append_le<uint64_t>( out, buffer.size() );
+    out.append( reinterpret_cast<const char *>( buffer.data() ), buffer.size() );
+    return out;
+}
+
+// Parses a stored quad in either format.
+static JsonValue decode_quad( std::string data )
+{
+    const std::string_view view = data;
+    if( view.substr( 0, binary_quad_magic.size() ) != binary_quad_magic ) {
+        return json_loader::from_string( std::move( data ) );
+    }
+    if( view.size() < binary_quad_header_size ) {
+        throw JsonError( "truncated binary map data" );
+    }
+    const uint32_t version = read_le<uint32_t>( view.substr( binary_quad_magic.size() ) );
+    if( version != binary_quad_version ) {
+        throw JsonError( string_format( "unsupported binary map data version %d", version ) );
+    }
+    const uint64_t size = read_le<uint64_t>( view.substr( binary_quad_magic.size() + sizeof(
+                              uint32_t ) ) );
+    if( size != view.size() - binary_quad_header_size ) {
+        throw JsonError( "truncated binary map data" );
+    }
+    const uint8_t *begin = reinterpret_cast<const uint8_t *>( view.data() ) + binary_quad_header_size;
+    return json_loader::from_flexbuffer( std::vector<uint8_t>( begin, begin + size ) );
+}
+
+// Submaps with the same contents as others written to a compressed segment at the same time,
+// or as one stored already, are stored once in the zzip under this folder and refer to it by
+// their key.  The refs entry lists the keys each quad refers to, so that contents no quad
+// refers to any more can be removed.
+static const std::filesystem::path shared_folder = std::filesystem::u8path( "shared" );
+static const std::filesystem::path shared_refs = shared_folder / std::filesystem::u8path( "refs" );
+
+static std::string shared_key( std::string_view contents )
+{
+    const uint64_t hash = XXH64( contents.data(), contents.size(), 0 );
+    return string_format( "%016llx-%llx", static_cast<unsigned long long>( hash ),
+                          static_cast<unsigned long long>( contents.size() ) );
+}
+
+// The json of a quad, with the submaps that have a key in shared_keys referring to their
+// shared contents instead of holding them.
+std::string mapbuffer::quad_json( const quad_write &quad,
+                                  const std::vector<std::string> &shared_keys )
+{
+    std::string json = "[";
+    for( size_t i = 0; i < quad.submaps.size(); ++i ) {
+        const submap_write &sm = quad.submaps[i];
+        if( i > 0 ) {
+            json += ',';
+        }
+        // Both are objects, the members of the contents go in place of the closing brace.
+        json.append( sm.header, 0, sm.header.size() - 1 );
+        json += ',';
+        if( i < shared_keys.size() && !shared_keys[i].empty() ) {
+            json += "\"shared\":\"" + shared_keys[i] + "\"}";
+        } else {
+            json.append( sm.contents, 1, std::string::npos );
+        }
+    }
+    json += ']';
+    return json;
+}
+
+// Reads the contents stored for the submaps with the given key, see write_quads.
+static JsonValue read_shared( const cata_path &dirname, const std::string &key,
+                              const std::shared_ptr<zzip> &z )
+{
+    const std::filesystem::path entry = shared_folder / std::filesystem::u8path( key );
+    std::string contents;
+    if( z ) {
+        if( !z->has_file( entry ) ) {
+            throw JsonError( "missing shared submap contents " + key );
+        }
+        std::vector<std::byte> data = z->get_file( entry );
+        contents.assign( reinterpret_cast<const char *>( data.data() ), data.size() );
+    } else {
+        const std::filesystem::path path = ( dirname / "shared" / key ).get_unrelative_path();
+        if( !file_exist( path ) ) {
+            throw JsonError( "missing shared submap contents " + key );
+        }
+        contents = read_entire_file( path );
+    }
+    return decode_quad( std::move( contents ) );
+}
+
 mapbuffer MAPBUFFER;
 
-mapbuffer::mapbuffer() = default;
-mapbuffer::~mapbuffer() = default;
+struct mapbuffer::prefetched_quads {
+    // Quads without an entry were not on disk.
+    std::unordered_map<tripoint_abs_omt, JsonValue> quads;
+    // The shared contents the quads refer to.
+    std::unordered_map<std::string, JsonValue> shared;
+};
+
+struct mapbuffer::written_quads {
+    std::mutex mutex;
+    std::unordered_map<tripoint_abs_omt, uint64_t> hashes;
+    // While a forked save is being taken over, the quads this process wrote itself since.
+    bool tracking = false;
+    std::unordered_set<tripoint_abs_omt> touched;
+
+    // Requires mutex.
+    void touch( const tripoint_abs_omt &om_addr ) {
+        if( tracking ) {
+            touched.insert( om_addr );
+        }
+    }
+
+    // Forget the hashes of quads that could not be written, so they are written again.
+    void forget( const std::vector<std::pair<tripoint_abs_omt, uint64_t>> &quads ) {
+        std::lock_guard<std::mutex> lk( mutex );
+        for( const auto &[om_addr, hash] : quads ) {
+            auto it = hashes.find( om_addr );
+            if( it != hashes.end() && it->second == hash ) {
+                hashes.erase( it );
+            }
+        }
+    }
+};
+
+// Submaps added between two checks of the memory budget.
+static constexpr size_t budget_check_interval = 64;
+
+mapbuffer::mapbuffer() : written( std::make_shared<written_quads>() ) {}
+mapbuffer::~mapbuffer()
+{
+    drop_prefetched();
+}
 
 void mapbuffer::clear()
 {
+    drop_prefetched();
     submaps.clear();
+    tile_owners.clear();
+    last_used.clear();
+    submaps_at_last_check = 0;
+    // Writes still in flight keep the old hashes to themselves.
+    written = std::make_shared<written_quads>();
 }
 
 void mapbuffer::clear_outside_reality_bubble()
@@ -88,7 +268,10 @@ bool mapbuffer::add_submap( const tripoint_abs_sm &p, std::unique_ptr<submap> &s
         return false;
     }
 
+    submap &added = *sm;
     submaps[p] = std::move( sm );
+    share_tiles( p, added );
+    last_used[project_to<coords::omt>( p )] = ++use_clock;
 
     return true;
 }
@@ -105,6 +288,28 @@ bool mapbuffer::add_submap( const tripoint_abs_sm &p, submap *sm )
     return result;
 }
 
+void mapbuffer::share_tiles( const tripoint_abs_sm &p, submap &sm )
+{
+    if( !sm.can_share_tiles() ) {
+        return;
+    }
+    const size_t hash = sm.tiles_hash();
+    std::vector<tripoint_abs_sm> &owners = tile_owners[hash];
+    for( auto it = owners.begin(); it != owners.end(); ) {
+        const auto found = submaps.find( *it );
+        if( found == submaps.end() || !found->second || !found->second->can_share_tiles() ||
+            found->second->tiles_hash() != hash ) {
+            it = owners.erase( it );
+            continue;
+        }
+        if( sm.share_tiles_with( *found->second ) ) {
+            return;
+        }
+        ++it;
+    }
+    owners.push_back( p );
+}
+
 void mapbuffer::remove_submap( const tripoint_abs_sm &addr )
 {
     auto m_target = submaps.find( addr );
@@ -113,6 +318,7 @@ void mapbuffer::remove_submap( const tripoint_abs_sm &addr )
         return;
     }
     submaps.erase( m_target );
+    last_used.erase( project_to<coords::omt>( addr ) );
 }
 
 submap *mapbuffer::lookup_submap( const tripoint_abs_sm &p )
@@ -122,6 +328,7 @@ submap *mapbuffer::lookup_submap( const tripoint_abs_sm &p )
 
     const auto iter = submaps.find( p );
     if( iter == submaps.end() ) {
+        ++stats.misses;
         try {
             return unserialize_submaps( p );
         } catch( const std::exception &err ) {
@@ -130,6 +337,8 @@ submap *mapbuffer::lookup_submap( const tripoint_abs_sm &p )
         return nullptr;
     }
 
+    ++stats.hits;
+    last_used[project_to<coords::omt>( p )] = ++use_clock;
     return iter->second.get();
 }
 
@@ -161,13 +370,15 @@ bool mapbuffer::submap_exists_approx( const tripoint_abs_sm &p )
             if( world_generator->active_world->has_compression_enabled() ) {
                 cata_path zzip_name = dirname;
                 zzip_name += ".zzip";
+                get_save_writer().wait_for( zzip_name.generic_u8string() );
                 if( !file_exist( zzip_name ) ) {
                     return false;
                 }
                 std::shared_ptr<zzip> z = zzip::load( zzip_name.get_unrelative_path(),
-                                                      ( PATH_INFO::world_base_save_path() / "maps.dict" ).get_unrelative_path() );
+                                                      compression_dictionary::current( compression_kind::maps ) );
                 return z->has_file( std::filesystem::u8path( file_name ) );
             } else {
+                get_save_writer().wait_for( ( dirname / file_name ).generic_u8string() );
                 return file_exist( dirname / file_name );
             }
         } catch( const std::exception &err ) {
@@ -179,8 +390,165 @@ bool mapbuffer::submap_exists_approx( const tripoint_abs_sm &p )
     return true;
 }
 
+// Reads a quad for prefetch, and the shared contents it refers to.  Runs on the thread pool,
+// so it reports errors by throwing and leaves it to unserialize_submaps to read the quad again
+// and tell the player.
+static std::optional<JsonValue> read_quad( const cata_path &dirname,
+        const std::string &file_name, const std::shared_ptr<zzip> &z,
+        std::unordered_map<std::string, JsonValue> &shared )
+{
+    std::string contents;
+    if( z ) {
+        const std::filesystem::path file_name_path = std::filesystem::u8path( file_name );
+        if( !z->has_file( file_name_path ) ) {
+            return std::nullopt;
+        }
+        std::vector<std::byte> data = z->get_file( file_name_path );
+        contents.assign( reinterpret_cast<const char *>( data.data() ), data.size() );
+    } else {
+        const std::filesystem::path quad_path = ( dirname / file_name ).get_unrelative_path();
+        if( !file_exist( quad_path ) ) {
+            return std::nullopt;
+        }
+        contents = read_entire_file( quad_path );
+    }
+    JsonValue quad = decode_quad( std::move( contents ) );
+    JsonArray submaps = quad;
+    for( JsonObject submap_json : submaps ) {
+        submap_json.allow_omitted_members();
+        if( submap_json.has_string( "shared" ) ) {
+            const std::string key = submap_json.get_string( "shared" );
+            if( shared.count( key ) == 0 ) {
+                shared.emplace( key, read_shared( dirname, key, z ) );
+            }
+        }
+    }
+    return quad;
+}
+
+void mapbuffer::prefetch( const std::vector<tripoint_abs_omt> &quads )
+{
+    // Without workers the reads would run right here, which is no better than reading the
+    // quads when they are needed.
+    if( cata::get_thread_pool().num_workers() == 0 ) {
+        return;
+    }
+
+    std::unordered_set<tripoint_abs_omt> requested( quads.begin(), quads.end() );
+    // Drop what was read ahead for a direction the map did not go in.
+    for( auto it = prefetched.begin(); it != prefetched.end(); ) {
+        if( requested.count( it->first ) == 0 &&
+            it->second.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready ) {
+            it = prefetched.erase( it );
+        } else {
+            ++it;
+        }
+    }
+
+    const bool compressed = world_generator->active_world->has_compression_enabled();
+    std::unordered_map<std::string, std::pair<cata_path, std::vector<tripoint_abs_omt>>> segments;
+    for( const tripoint_abs_omt &om_addr : quads ) {
+        if( prefetched.count( om_addr ) || submaps.count( project_to<coords::sm>( om_addr ) ) ) {
+            continue;
+        }
+        const cata_path dirname = find_dirname( om_addr );
+        cata_path target = dirname;
+        if( compressed ) {
+            target += ".zzip";
+        } else {
+            target = dirname / quad_file_name( om_addr );
+        }
+        if( get_save_writer().is_pending( target.generic_u8string() ) ) {
+            continue;
+        }
+        segments.try_emplace( dirname.generic_u8string(), dirname,
+                              std::vector<tripoint_abs_omt>() ).first->second.second.push_back( om_addr );
+    }
+
+    const std::filesystem::path dict_path = compression_dictionary::current( compression_kind::maps );
+    for( auto &[name, segment] : segments ) {
+        std::shared_future<std::shared_ptr<prefetched_quads>> batch =
+        cata::get_thread_pool().submit( [compressed, dict_path, dirname = segment.first,
+                 segment_quads = segment.second]() {
+            std::shared_ptr<prefetched_quads> ret = std::make_shared<prefetched_quads>();
+            std::shared_ptr<zzip> z;
+            if( compressed ) {
+                cata_path zzip_name = dirname;
+                zzip_name += ".zzip";
+                if( !file_exist( zzip_name.get_unrelative_path() ) ) {
+                    return ret;
+                }
+                z = zzip::load( zzip_name.get_unrelative_path(), dict_path );
+                if( !z ) {
+                    throw std::runtime_error( "Failed opening " + zzip_name.generic_u8string() );
+                }
+            }
+            for( const tripoint_abs_omt &om_addr : segment_quads ) {
+                if( std::optional<JsonValue> json = read_quad( dirname, quad_file_name( om_addr ), z,
+                                                 ret->shared ) ) {
+                    ret->quads.emplace( om_addr, std::move( *json ) );
+                }
+            }
+            return ret;
+        } ).share();
+        for( const tripoint_abs_omt &om_addr : segment.second ) {
+            prefetched.emplace( om_addr, batch );
+        }
+    }
+}
+
+void mapbuffer::drop_prefetched()
+{
+    for( auto &[om_addr, batch] : prefetched ) {
+        batch.wait();
+    }
+    prefetched.clear();
+}
+
+void mapbuffer::drop_prefetched( const std::string &dirname )
+{
+    for( auto it = prefetched.begin(); it != prefetched.end(); ) {
+        if( find_dirname( it->first ).generic_u8string() == dirname ) {
+            it->second.wait();
+            it = prefetched.erase( it );
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::optional<JsonValue> mapbuffer::take_prefetched( const tripoint_abs_omt &om_addr,
+        shared_contents &shared )
+{
+    auto it = prefetched.find( om_addr );
+    if( it == prefetched.end() ) {
+        return std::nullopt;
+    }
+    std::shared_future<std::shared_ptr<prefetched_quads>> batch = std::move( it->second );
+    prefetched.erase( it );
+    try {
+        const std::shared_ptr<prefetched_quads> &ret = batch.get();
+        auto found = ret->quads.find( om_addr );
+        if( found != ret->quads.end() ) {
+            shared = [ret]( const std::string & key ) {
+                auto it = ret->shared.find( key );
+                if( it == ret->shared.end() ) {
+                    throw JsonError( "missing shared submap contents " + key );
+                }
+                return it->second;
+            };
+            return found->second;
+        }
+    } catch( const std::exception & ) {
+        // The quad is read again, which reports the error.
+    }
+    return std::nullopt;
+}
+
 void mapbuffer::save( bool delete_after_save )
 {
+    // Quads are about to be written, what was read ahead may be out of date.
+    drop_prefetched();
     assure_dir_exist( PATH_INFO::world_base_save_path() / "maps" );
 
     int num_saved_submaps = 0;
@@ -195,6 +563,8 @@ void mapbuffer::save( bool delete_after_save )
     std::list<tripoint_abs_sm> submaps_to_delete;
     static constexpr std::chrono::milliseconds update_interval( 500 );
     std::chrono::steady_clock::time_point last_update = std::chrono::steady_clock::now();
+    // Quads are written a segment at a time, so a compressed world writes each zzip once.
+    std::unordered_map<std::string, std::pair<cata_path, std::vector<quad_write>>> segment_writes;
 
     for( auto &elem : submaps ) {
         std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
@@ -226,17 +596,179 @@ void mapbuffer::save( bool delete_after_save )
         bool inside_reality_bubble = here.inbounds( om_addr );
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
-        save_quad( dirname, quad_path, om_addr, submaps_to_delete,
-                   delete_after_save || !inside_reality_bubble );
+        std::optional<quad_write> quad = save_quad( quad_path, om_addr, submaps_to_delete,
+                                         delete_after_save || !inside_reality_bubble );
+        if( quad ) {
+            segment_writes.try_emplace( dirname.generic_u8string(), dirname,
+                                        std::vector<quad_write>() ).first->second.second.push_back( std::move( *quad ) );
+        }
         num_saved_submaps += 4;
     }
+    for( auto &[name, segment] : segment_writes ) {
+        write_quads( segment.first, std::move( segment.second ) );
+    }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    prune_tile_owners();
+    submaps_at_last_check = submaps.size();
+}
+
+void mapbuffer::forget_written()
+{
+    std::lock_guard<std::mutex> lk( written->mutex );
+    written->hashes.clear();
+    written->tracking = false;
+    written->touched.clear();
+}
+
+std::unordered_map<tripoint_abs_omt, uint64_t> mapbuffer::written_hashes() const
+{
+    std::lock_guard<std::mutex> lk( written->mutex );
+    return written->hashes;
+}
+
+void mapbuffer::track_written_changes()
+{
+    std::lock_guard<std::mutex> lk( written->mutex );
+    written->tracking = true;
+    written->touched.clear();
 }
 
-void mapbuffer::save_quad(
-    const cata_path &dirname, const cata_path &filename, const tripoint_abs_omt &om_addr,
+bool mapbuffer::update_written( const std::unordered_map<tripoint_abs_omt, uint64_t> &changes )
+{
+    std::lock_guard<std::mutex> lk( written->mutex );
+    if( !written->tracking ) {
+        return false;
+    }
+    for( const auto &[om_addr, hash] : changes ) {
+        // What this process wrote since is queued after the copy's writes, so it is on disk.
+        if( written->touched.count( om_addr ) != 0 ) {
+            continue;
+        }
+        if( hash == 0 ) {
+            written->hashes.erase( om_addr );
+        } else {
+            written->hashes[om_addr] = hash;
+        }
+    }
+    written->tracking = false;
+    written->touched.clear();
+    return true;
+}
+
+void mapbuffer::drop_outside_reality_bubble()
+{
+    map &here = get_map();
+    std::vector<tripoint_abs_sm> to_drop;
+    for( const auto &[p, sm] : submaps ) {
+        if( !here.inbounds( project_to<coords::omt>( p ) ) ) {
+            to_drop.push_back( p );
+        }
+    }
+    for( const tripoint_abs_sm &p : to_drop ) {
+        remove_submap( p );
+    }
+    prune_tile_owners();
+    submaps_at_last_check = submaps.size();
+}
+
+size_t mapbuffer::memory_estimate() const
+{
+    size_t total = 0;
+    for( const auto &[p, sm] : submaps ) {
+        if( sm != nullptr ) {
+            total += sm->memory_estimate();
+        }
+    }
+    return total;
+}
+
+void mapbuffer::enforce_budget()
+{
+    const size_t budget = static_cast<size_t>( get_option<int>( "MAPBUFFER_BUDGET" ) ) * 1024 *
+                          1024;
+    // Estimating looks at every submap, so it waits until enough were added.
+    if( budget == 0 || submaps.size() < submaps_at_last_check + budget_check_interval ) {
+        return;
+    }
+    submaps_at_last_check = submaps.size();
+
+    map &here = get_map();
+    std::unordered_map<tripoint_abs_omt, size_t> quad_memory;
+    size_t total = 0;
+    for( const auto &[p, sm] : submaps ) {
+        if( sm == nullptr ) {
+            continue;
+        }
+        const size_t used = sm->memory_estimate();
+        total += used;
+        const tripoint_abs_omt om_addr = project_to<coords::omt>( p );
+        if( !here.inbounds( om_addr ) ) {
+            quad_memory[om_addr] += used;
+        }
+    }
+    stats.memory_estimate = total;
+    if( total <= budget ) {
+        return;
+    }
+
+    // Unload to somewhat below the budget, so the next few checks have nothing to do.
+    const size_t target = budget - budget / 8;
+    std::vector<std::pair<uint64_t, tripoint_abs_omt>> candidates;
+    candidates.reserve( quad_memory.size() );
+    for( const auto &[om_addr, used] : quad_memory ) {
+        const auto it = last_used.find( om_addr );
+        candidates.emplace_back( it == last_used.end() ? 0 : it->second, om_addr );
+    }
+    std::sort( candidates.begin(), candidates.end() );
+
+    assure_dir_exist( PATH_INFO::world_base_save_path() / "maps" );
+    std::list<tripoint_abs_sm> submaps_to_delete;
+    std::unordered_map<std::string, std::pair<cata_path, std::vector<quad_write>>> segment_writes;
+    const uint64_t evictions_before = stats.evictions;
+    for( const auto &[used_at, om_addr] : candidates ) {
+        if( total <= target ) {
+            break;
+        }
+        const cata_path dirname = find_dirname( om_addr );
+        std::optional<quad_write> quad = save_quad( dirname / quad_file_name( om_addr ), om_addr,
+                                         submaps_to_delete, true );
+        ++stats.evictions;
+        if( quad ) {
+            ++stats.evictions_written;
+            segment_writes.try_emplace( dirname.generic_u8string(), dirname,
+                                        std::vector<quad_write>() ).first->second.second.push_back( std::move( *quad ) );
+        }
+        total -= quad_memory[om_addr];
+    }
+    for( auto &[name, segment] : segment_writes ) {
+        drop_prefetched( name );
+        write_quads( segment.first, std::move( segment.second ) );
+    }
+    for( const tripoint_abs_sm &p : submaps_to_delete ) {
+        remove_submap( p );
+    }
+    prune_tile_owners();
+    submaps_at_last_check = submaps.size();
+    dbg( D_INFO ) << "mapbuffer::enforce_budget unloaded " << stats.evictions - evictions_before
+                  << " quads, " << submaps.size() << " submaps left";
+}
+
+void mapbuffer::prune_tile_owners()
+{
+    for( auto it = tile_owners.begin(); it != tile_owners.end(); ) {
+        std::vector<tripoint_abs_sm> &owners = it->second;
+        owners.erase( std::remove_if( owners.begin(), owners.end(),
+        [this]( const tripoint_abs_sm & p ) {
+            return submaps.count( p ) == 0;
+        } ), owners.end() );
+        it = owners.empty() ? tile_owners.erase( it ) : std::next( it );
+    }
+}
+
+std::optional<mapbuffer::quad_write> mapbuffer::save_quad(
+    const cata_path &filename, const tripoint_abs_omt &om_addr,
     std::list<tripoint_abs_sm> &submaps_to_delete, bool delete_after_save )
 {
     std::vector<point_rel_sm> offsets;
@@ -249,27 +781,7 @@ void mapbuffer::save_quad(
     offsets.push_back( point_rel_sm::south_east );
 
     bool all_uniform = true;
-    bool reverted_to_uniform = false;
-    bool file_exists = false;
-
-    std::shared_ptr<zzip> z;
-    // The number of uniform submaps is so enormous that the filesystem overhead
-    // for this step of just checking if the quad exists approaches 70% of the
-    // total cost of saving the mapbuffer, in one test save I had.
-    if( world_generator->active_world->has_compression_enabled() ) {
-        cata_path zzip_name = dirname;
-        zzip_name += ".zzip";
-        z = zzip::load( zzip_name.get_unrelative_path(),
-                        ( PATH_INFO::world_base_save_path() / "maps.dict" ).get_unrelative_path() );
-        if( !z ) {
-            throw std::runtime_error( "Failed opening compressed save file " +
-                                      zzip_name.get_unrelative_path().generic_u8string() );
-        }
-        file_exists = z->has_file( filename.get_relative_path().filename() );
-    } else {
-        file_exists = std::filesystem::exists( filename.get_unrelative_path() );
-    }
-
+    bool any_reverted = false;
     for( point_rel_sm &offsets_offset : offsets ) {
         tripoint_abs_sm submap_addr = project_to<coords::sm>( om_addr );
         submap_addr += offsets_offset.raw(); // TODO: Make += etc. available to relative parameters as well.
@@ -279,7 +791,7 @@ void mapbuffer::save_quad(
             if( !sm->is_uniform() ) {
                 all_uniform = false;
             } else if( sm->reverted ) {
-                reverted_to_uniform = file_exists;
+                any_reverted = true;
             }
         }
     }
@@ -294,16 +806,13 @@ void mapbuffer::save_quad(
             }
         }
 
-        // deleting the file might fail on some platforms in some edge cases so force serialize this
-        // uniform quad
-        if( !reverted_to_uniform ) {
-            return;
+        // A quad that was saved before reverting to uniform still has to be deleted
+        if( !any_reverted ) {
+            return std::nullopt;
         }
     }
 
-    std::stringstream stringout;
-    JsonOut jsout( stringout );
-    jsout.start_array();
+    quad_write quad{ filename, om_addr, 0, all_uniform, {} };
     for( auto &submap_addr : submap_addrs ) {
         if( submaps.count( submap_addr ) == 0 ) {
             continue;
@@ -315,6 +824,8 @@ void mapbuffer::save_quad(
             continue;
         }
 
+        std::stringstream headerout;
+        JsonOut jsout( headerout );
         jsout.start_object();
 
         jsout.member( "version", savegame_version );
@@ -326,37 +837,248 @@ void mapbuffer::save_quad(
         jsout.write( submap_addr.z() );
         jsout.end_array();
 
-        sm->store( jsout );
+        jsout.member( "turn_last_touched", sm->last_touched );
 
         jsout.end_object();
 
+        std::stringstream contentsout;
+        JsonOut contents_jsout( contentsout );
+        contents_jsout.start_object();
+        sm->store_contents( contents_jsout );
+        contents_jsout.end_object();
+
+        quad.submaps.push_back( { std::move( headerout ).str(), std::move( contentsout ).str() } );
+
         if( delete_after_save ) {
             submaps_to_delete.push_back( submap_addr );
         }
     }
 
-    jsout.end_array();
-
-    std::string s = std::move( stringout ).str();
-
-    if( z ) {
-        z->add_file( filename.get_relative_path().filename(), s );
-        z->compact( 2.0 );
-    } else {
-        // Don't create the directory if it would be empty
-        assure_dir_exist( dirname );
-        write_to_file( filename, [&]( std::ostream & fout ) {
-            fout << s;
-        } );
+    // Quads that serialize the same as when they were last written are not written again.
+    std::lock_guard<std::mutex> lk( written->mutex );
+    written->touch( om_addr );
+    if( all_uniform ) {
+        written->hashes.erase( om_addr );
+        return quad;
     }
+    uint64_t hash = 0;
+    for( const submap_write &sm : quad.submaps ) {
+        hash = XXH64( sm.header.data(), sm.header.size(), hash );
+        hash = XXH64( sm.contents.data(), sm.contents.size(), hash );
+    }
+    // Never 0, which stands for not written yet.
+    quad.hash = hash | 1;
+    uint64_t &last_written = written->hashes[om_addr];
+    // While a forked save is being written, the disk may not hold what was last written here.
+    if( last_written == quad.hash && !written->tracking ) {
+        return std::nullopt;
+    }
+    last_written = quad.hash;
+    return quad;
+}
 
-    if( all_uniform && reverted_to_uniform ) {
-        if( z ) {
-            z->delete_files( { filename.get_relative_path().filename() } );
-        } else {
-            std::filesystem::remove( filename.get_unrelative_path() );
+void mapbuffer::write_quads( const cata_path &dirname, std::vector<quad_write> quads )
+{
+    // The files are written by the save writer, so the game can go on while it compresses and
+    // writes the quads.  Everything it needs is worked out here.
+    const bool binary = get_option<bool>( "BINARY_SUBMAPS" );
+    const auto encode = [binary]( std::string json ) {
+        return binary ? encode_binary_quad( json ) : json;
+    };
+    // Quads that could not be written have to be written again, even if they do not change.
+    const auto write_or_forget = [written = written]( const std::vector<quad_write> &quads,
+    const std::function<void()> &write ) {
+        try {
+            write();
+        } catch( ... ) {
+            std::vector<std::pair<tripoint_abs_omt, uint64_t>> failed;
+            for( const quad_write &quad : quads ) {
+                failed.emplace_back( quad.om_addr, quad.hash );
+            }
+            written->forget( failed );
+            throw;
+        }
+    };
+    if( !world_generator->active_world->has_compression_enabled() ) {
+        for( quad_write &quad : quads ) {
+            get_save_writer().enqueue( quad.filename.generic_u8string(), _( "map data" ),
+            [dirname, encode, write_or_forget,
+                     quads = std::vector<quad_write> { std::move( quad ) }]() {
+                write_or_forget( quads, [&]() {
+                    const quad_write &quad = quads.front();
+                    const bool file_exists = std::filesystem::exists(
+                                                 quad.filename.get_unrelative_path() );
+                    if( quad.all_uniform && !file_exists ) {
+                        // Reverted to uniform before it was ever saved
+                        return;
+                    }
+                    // deleting the file might fail on some platforms in some edge cases so force
+                    // serialize this uniform quad
+                    // Don't create the directory if it would be empty
+                    assure_dir_exist( dirname );
+                    write_to_file( quad.filename, [&]( std::ostream & fout ) {
+                        fout << encode( quad_json( quad, {} ) );
+                    } );
+                    if( quad.all_uniform ) {
+                        std::filesystem::remove( quad.filename.get_unrelative_path() );
+                    }
+                } );
+            } );
         }
+        return;
     }
+
+    cata_path zzip_name = dirname;
+    zzip_name += ".zzip";
+    const std::filesystem::path zzip_path = zzip_name.get_unrelative_path();
+    const std::filesystem::path dict_path = compression_dictionary::current( compression_kind::maps );
+    get_save_writer().enqueue( zzip_name.generic_u8string(), _( "map data" ), [zzip_path, dict_path,
+                               encode, write_or_forget, quads = std::move( quads )]() {
+        write_or_forget( quads, [&]() {
+            std::shared_ptr<zzip> z = zzip::load( zzip_path, dict_path );
+            if( !z ) {
+                throw std::runtime_error( "Failed opening compressed save file " +
+                                          zzip_path.generic_u8string() );
+            }
+            // The number of uniform submaps is so enormous that the filesystem overhead
+            // for this step of just checking if the quad exists approaches 70% of the
+            // total cost of saving the mapbuffer, in one test save I had.
+            std::vector<const quad_write *> to_write;
+            std::unordered_set<std::filesystem::path, std_fs_path_hash> to_delete;
+            for( const quad_write &quad : quads ) {
+                const std::filesystem::path entry = quad.filename.get_relative_path().filename();
+                if( quad.all_uniform ) {
+                    if( !z->has_file( entry ) ) {
+                        // Reverted to uniform before it was ever saved
+                        continue;
+                    }
+                    to_delete.insert( entry );
+                }
+                to_write.push_back( &quad );
+            }
+            if( to_write.empty() ) {
+                return;
+            }
+
+            // Contents that more than one of the submaps have, or that are stored already, are
+            // only stored once.
+            std::vector<std::vector<std::string>> keys( to_write.size() );
+            cata::get_thread_pool().parallel_for( 0, static_cast<int>( to_write.size() ), [&]( int i ) {
+                if( to_write[i]->all_uniform ) {
+                    return;
+                }
+                for( const submap_write &sm : to_write[i]->submaps ) {
+                    keys[i].push_back( shared_key( sm.contents ) );
+                }
+            } );
+            std::unordered_map<std::string, std::pair<int, const std::string *>> uses;
+            for( size_t i = 0; i < to_write.size(); ++i ) {
+                for( size_t j = 0; j < keys[i].size(); ++j ) {
+                    std::pair<int, const std::string *> &use = uses[keys[i][j]];
+                    ++use.first;
+                    use.second = &to_write[i]->submaps[j].contents;
+                }
+            }
+            std::vector<std::pair<std::filesystem::path, std::string>> new_shared;
+            for( const auto &[key, use] : uses ) {
+                const std::filesystem::path entry = shared_folder / std::filesystem::u8path( key );
+                if( z->has_file( entry ) ) {
+                    continue;
+                }
+                if( use.first > 1 ) {
+                    new_shared.emplace_back( entry, *use.second );
+                }
+            }
+            for( std::vector<std::string> &quad_keys : keys ) {
+                for( std::string &key : quad_keys ) {
+                    if( uses[key].first < 2 &&
+                        !z->has_file( shared_folder / std::filesystem::u8path( key ) ) ) {
+                        key.clear();
+                    }
+                }
+            }
+
+            // Which keys each quad refers to, to find the contents none refers to any more.
+            std::map<std::string, std::vector<std::string>> refs;
+            const bool had_refs = z->has_file( shared_refs );
+            if( had_refs ) {
+                std::vector<std::byte> data = z->get_file( shared_refs );
+                JsonValue refs_json = json_loader::from_string( std::string(
+                                          reinterpret_cast<const char *>( data.data() ), data.size() ) );
+                JsonObject refs_obj = refs_json;
+                for( JsonMember quad_refs : refs_obj ) {
+                    quad_refs.read( refs[quad_refs.name()] );
+                }
+            }
+            for( size_t i = 0; i < to_write.size(); ++i ) {
+                const std::string entry =
+                    to_write[i]->filename.get_relative_path().filename().generic_u8string();
+                std::vector<std::string> quad_refs;
+                if( !to_write[i]->all_uniform ) {
+                    for( const std::string &key : keys[i] ) {
+                        if( !key.empty() ) {
+                            quad_refs.push_back( key );
+                        }
+                    }
+                }
+                if( quad_refs.empty() ) {
+                    refs.erase( entry );
+                } else {
+                    refs[entry] = std::move( quad_refs );
+                }
+            }
+
+            // Quads that went back to uniform are only removed, by the same footer that adds
+            // the others.
+            std::vector<std::string> contents( to_write.size() + new_shared.size() );
+            cata::get_thread_pool().parallel_for( 0, static_cast<int>( contents.size() ), [&]( int i ) {
+                if( static_cast<size_t>( i ) < to_write.size() ) {
+                    if( to_write[i]->all_uniform ) {
+                        return;
+                    }
+                    contents[i] = encode( quad_json( *to_write[i], keys[i] ) );
+                    compression_dictionary::add_sample( compression_kind::maps, contents[i] );
+                } else {
+                    contents[i] = encode( std::move( new_shared[i - to_write.size()].second ) );
+                }
+            } );
+            std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+            files.reserve( contents.size() + 1 );
+            for( size_t i = 0; i < to_write.size(); ++i ) {
+                if( !to_write[i]->all_uniform ) {
+                    files.emplace_back( to_write[i]->filename.get_relative_path().filename(),
+                                        contents[i] );
+                }
+            }
+            for( size_t i = 0; i < new_shared.size(); ++i ) {
+                files.emplace_back( new_shared[i].first, contents[to_write.size() + i] );
+            }
+            std::string refs_contents;
+            if( had_refs || !refs.empty() ) {
+                std::ostringstream refsout;
+                JsonOut jsout( refsout );
+                jsout.write( refs );
+                refs_contents = std::move( refsout ).str();
+                files.emplace_back( shared_refs, refs_contents );
+                std::unordered_set<std::string> live;
+                for( const auto &[quad, quad_refs] : refs ) {
+                    live.insert( quad_refs.begin(), quad_refs.end() );
+                }
+                for( const std::filesystem::path &entry : z->get_entries() ) {
+                    if( entry.parent_path() == shared_folder && entry != shared_refs &&
+                        live.count( entry.filename().generic_u8string() ) == 0 ) {
+                        to_delete.insert( entry );
+                    }
+                }
+            }
+            // Everything of this segment goes in with a single footer.
+            if( !z->add_files( files, to_delete ) ) {
+                throw std::runtime_error( "Failed writing compressed save file " +
+                                          zzip_path.generic_u8string() );
+            }
+            z->compact( 2.0 );
+        } );
+    } );
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -371,23 +1093,38 @@ submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
     cata_path quad_path = dirname / file_name;
 
     bool read = [&] {
+        // A quad that was not on disk when it was read ahead is still looked for below.
+        shared_contents shared;
+        if( std::optional<JsonValue> staged = take_prefetched( om_addr, shared ) )
+        {
+            try {
+                deserialize( *staged, shared );
+            } catch( std::exception &err ) {
+                debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), quad_path.generic_u8string(),
+                          err.what() );
+                return false;
+            }
+            return true;
+        }
         if( world_generator->active_world->has_compression_enabled() )
         {
             cata_path zzip_name = dirname;
             zzip_name += ".zzip";
+            get_save_writer().wait_for( zzip_name.generic_u8string() );
             if( !file_exist( zzip_name ) ) {
                 return false;
             }
             std::shared_ptr<zzip> z = zzip::load( zzip_name.get_unrelative_path(),
-                                                  ( PATH_INFO::world_base_save_path() / "maps.dict" ).get_unrelative_path() );
+                                                  compression_dictionary::current( compression_kind::maps ) );
             if( !z->has_file( file_name_path ) ) {
                 return false;
             }
             std::vector<std::byte> contents = z->get_file( file_name_path );
             std::string_view string_contents{ reinterpret_cast<char *>( contents.data() ), contents.size() };
-            JsonValue jsin = json_loader::from_string( std::string( string_contents ) );
             try {
-                deserialize( jsin );
+                deserialize( decode_quad( std::string( string_contents ) ), [&]( const std::string & key ) {
+                    return read_shared( dirname, key, z );
+                } );
             } catch( std::exception &err ) {
                 debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), zzip_name.generic_u8string() + ":" + file_name,
                           err.what() );
@@ -396,10 +1133,24 @@ submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
             return true;
         } else
         {
-            return read_from_file_optional_json( quad_path, [this]( const JsonValue & jsin ) {
-                deserialize( jsin );
-            } );
-
+            get_save_writer().wait_for( quad_path.generic_u8string() );
+            if( !file_exist( quad_path ) ) {
+                return false;
+            }
+            std::optional<std::string> contents = read_whole_file( quad_path );
+            if( !contents ) {
+                return false;
+            }
+            try {
+                deserialize( decode_quad( std::move( *contents ) ), [&]( const std::string & key ) {
+                    return read_shared( dirname, key, nullptr );
+                } );
+            } catch( std::exception &err ) {
+                debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), quad_path.generic_u8string(),
+                          err.what() );
+                return false;
+            }
+            return true;
         }
     }();
 
@@ -419,7 +1170,7 @@ submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
     return submaps[ p ].get();
 }
 
-void mapbuffer::deserialize( const JsonArray &ja )
+void mapbuffer::deserialize( const JsonArray &ja, const shared_contents &shared )
 {
     for( JsonObject submap_json : ja ) {
         std::unique_ptr<submap> sm = std::make_unique<submap>();
@@ -435,6 +1186,11 @@ void mapbuffer::deserialize( const JsonArray &ja )
                 JsonArray coords_array = submap_member;
                 tripoint_abs_sm loc{ coords_array.next_int(), coords_array.next_int(), coords_array.next_int() };
                 submap_coordinates = loc;
+            } else if( submap_member_name == "shared" ) {
+                JsonObject contents = shared( submap_member.get_string() );
+                for( JsonMember contents_member : contents ) {
+                    sm->load( contents_member, contents_member.name(), version );
+                }
             } else {
                 sm->load( submap_member, submap_member_name, version );
             }
@@ -2,14 +2,23 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "cata_path.h"
 #include "coordinates.h"
 
 class JsonArray;
-class cata_path;
+class JsonValue;
 class submap;
 
 /**
@@ -27,6 +36,28 @@ class mapbuffer
          **/
         void save( bool delete_after_save = false );
 
+        /** Forget what every quad was last written as, so the next save writes them all.
+         * For saves written where this process does not see what was written.
+         **/
+        void forget_written();
+
+        /** What every quad was last written as, 0 for quads that were not. **/
+        std::unordered_map<tripoint_abs_omt, uint64_t> written_hashes() const;
+        /** For a save written by a forked copy of this process: from now on, remember which
+         * quads this process writes itself, so update_written leaves them alone.
+         **/
+        void track_written_changes();
+        /** Take over what the forked copy wrote, the changes of its written_hashes, for the
+         * quads this process did not write since track_written_changes.  Returns false,
+         * changing nothing, if nothing was tracked, e.g. because the buffer was cleared since.
+         **/
+        bool update_written( const std::unordered_map<tripoint_abs_omt, uint64_t> &changes );
+
+        /** Delete the submaps outside the reality bubble without writing them, as save does
+         * after writing them.  For when a forked copy of this process saved them.
+         **/
+        void drop_outside_reality_bubble();
+
         /** Delete all buffered submaps. **/
         void clear();
 
@@ -66,6 +97,49 @@ class mapbuffer
         // Cheaper version of the above for when you don't mind some false results
         bool submap_exists_approx( const tripoint_abs_sm &p );
 
+        /**
+         * Start reading the given quads from disk on the thread pool, so that lookup_submap
+         * only has to deserialize them once the map gets there.  Quads already loaded or
+         * read ahead, and quads whose file still has writes queued, are skipped.
+         */
+        void prefetch( const std::vector<tripoint_abs_omt> &quads );
+
+        /**
+         * Wait for the quads being read ahead from the segment in folder @p dirname and drop
+         * them, before its files are changed.  There are no reads ahead of a segment while a
+         * write to it is queued, so call it before handing the save writer anything that
+         * changes the segment.
+         */
+        void drop_prefetched( const std::string &dirname );
+
+        /**
+         * If the submaps are estimated to take more memory than the MAPBUFFER_BUDGET option
+         * allows, unload the quads outside the reality bubble that were used the longest ago
+         * until they are back under it, writing the ones that changed since they were last
+         * written.  Only call this where no tinymap holds on to submaps, like between turns.
+         */
+        void enforce_budget();
+
+        struct cache_stats {
+            // Lookups of submaps that were loaded, and of ones that were not.
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            // Quads unloaded by enforce_budget, and how many of those had changes to write.
+            uint64_t evictions = 0;
+            uint64_t evictions_written = 0;
+            // Estimated memory use of the submaps when the budget was last checked.
+            size_t memory_estimate = 0;
+        };
+        const cache_stats &get_stats() const {
+            return stats;
+        }
+
+        size_t submap_count() const {
+            return submaps.size();
+        }
+        // Estimated memory use of the loaded submaps, see submap::memory_estimate.
+        size_t memory_estimate() const;
+
     private:
         using submap_map_t = std::map<tripoint_abs_sm, std::unique_ptr<submap>>;
 
@@ -83,12 +157,60 @@ class mapbuffer
         void remove_submap( const tripoint_abs_sm &addr );
         submap *unserialize_submaps( const tripoint_abs_sm &p );
         bool submap_file_exists( const tripoint_abs_sm &p );
-        void deserialize( const JsonArray &ja );
-        void save_quad(
-            const cata_path &dirname, const cata_path &filename,
-            const tripoint_abs_omt &om_addr, std::list<tripoint_abs_sm> &submaps_to_delete,
-            bool delete_after_save );
+        // The contents identical submaps of a segment share on disk, by their key.
+        using shared_contents = std::function<JsonValue( const std::string & )>;
+        void deserialize( const JsonArray &ja, const shared_contents &shared );
+        // Share the tiles of a newly added submap with an identical one already here.
+        void share_tiles( const tripoint_abs_sm &p, submap &sm );
+        // A submap serialized by save_quad: the object with its coordinates and when it was
+        // last touched, and the object with the rest of it, which identical submaps share.
+        struct submap_write {
+            std::string header;
+            std::string contents;
+        };
+        // A quad serialized by save_quad, for write_quads to write out.
+        struct quad_write {
+            cata_path filename;
+            tripoint_abs_omt om_addr;
+            // Of the serialized quad, see written_quads.
+            uint64_t hash = 0;
+            // The quad reverted to uniform, so a copy saved earlier has to be removed.
+            bool all_uniform = false;
+            std::vector<submap_write> submaps;
+        };
+        std::optional<quad_write> save_quad(
+            const cata_path &filename, const tripoint_abs_omt &om_addr,
+            std::list<tripoint_abs_sm> &submaps_to_delete, bool delete_after_save );
+        static std::string quad_json( const quad_write &quad,
+                                      const std::vector<std::string> &shared_keys );
+        // Hands the quads of one segment to the save writer.
+        void write_quads( const cata_path &dirname, std::vector<quad_write> quads );
+        // Drops the tile_owners entries of submaps that are gone.
+        void prune_tile_owners();
+        // Waits for quads being read ahead and drops them, before the files may change.
+        void drop_prefetched();
+        std::optional<JsonValue> take_prefetched( const tripoint_abs_omt &om_addr,
+                shared_contents &shared );
         submap_map_t submaps; // NOLINT(cata-serialize)
+        // Submaps whose tiles the next ones added may share, by tiles_hash.  Entries for
+        // submaps that were removed or changed since are dropped as they are found.
+        std::unordered_map<size_t, std::vector<tripoint_abs_sm>> tile_owners; // NOLINT(cata-serialize)
+        // The hashes of the quads as they were last written, so quads that serialize the same
+        // are not written again.  Shared with the writes in flight, which forget the hashes of
+        // quads they failed to write.
+        struct written_quads;
+        std::shared_ptr<written_quads> written; // NOLINT(cata-serialize)
+        cache_stats stats; // NOLINT(cata-serialize)
+        // When each loaded quad was last looked up or added, by use_clock.
+        std::unordered_map<tripoint_abs_omt, uint64_t> last_used; // NOLINT(cata-serialize)
+        uint64_t use_clock = 0; // NOLINT(cata-serialize)
+        // How many submaps there were when the budget was last checked.
+        size_t submaps_at_last_check = 0; // NOLINT(cata-serialize)
+        // Quads of one segment read ahead by prefetch.
+        struct prefetched_quads;
+        // The read of the segment each prefetched quad is in.
+        std::unordered_map<tripoint_abs_omt, std::shared_future<std::shared_ptr<prefetched_quads>>>
+        prefetched; // NOLINT(cata-serialize)
 };
 
 extern mapbuffer MAPBUFFER;
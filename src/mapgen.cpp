@@ -78,6 +78,7 @@
 #include "output.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
+#include "perf.h"
 #include "pocket_type.h"
 #include "point.h"
 #include "regional_settings.h"
@@ -1120,6 +1121,7 @@ static mapgen_factory oter_mapgen;
 
 std::map<nested_mapgen_id, nested_mapgen> nested_mapgens;
 std::map<update_mapgen_id, update_mapgen> update_mapgens;
+bool mapgen_shortcuts = true;
 static std::unordered_map<std::string, tripoint_abs_ms> queued_points;
 
 template<>
@@ -2119,6 +2121,13 @@ class mapgen_value
         Id get( const mapgendata &dat ) const {
             return source_->get( dat );
         }
+        // The value when it is given verbatim, and so is the same wherever it is used.
+        std::optional<Id> get_fixed() const {
+            if( const id_source *fixed = dynamic_cast<const id_source *>( source_.get() ) ) {
+                return fixed->id;
+            }
+            return std::nullopt;
+        }
         std::vector<StringId> all_possible_results( const mapgen_parameters &params ) const {
             return source_->all_possible_results( params );
         }
@@ -3484,6 +3493,12 @@ class jmapgen_terrain : public jmapgen_piece_with_has_vehicle_collision
             act_unknown, act_ignore, act_dismantle, act_erase
         };
     public:
+        // What happens to the furniture, trap and items under placed terrain.
+        struct placing_actions {
+            apply_action furn = apply_action::act_unknown;
+            apply_action trap = apply_action::act_unknown;
+            apply_action item = apply_action::act_unknown;
+        };
         mapgen_value<ter_id> id;
         jmapgen_terrain( const JsonObject &jsi, std::string_view/*context*/ ) :
             jmapgen_terrain( jsi.get_member( "ter" ) ) {}
@@ -3502,14 +3517,12 @@ class jmapgen_terrain : public jmapgen_piece_with_has_vehicle_collision
             if( chosen_id.id().is_null() ) {
                 return;
             }
-            tripoint_bub_ms p( x.get(), y.get(), dat.zlevel() + z.get() );
-
-            const ter_id &terrain_here = dat.m.ter( p );
-            const ter_t &chosen_ter = *chosen_id;
-            const bool is_wall = chosen_ter.has_flag( ter_furn_flag::TFLAG_WALL );
-            const bool place_item = chosen_ter.has_flag( ter_furn_flag::TFLAG_PLACE_ITEM );
-            const bool is_boring_wall = is_wall && !place_item;
+            place( dat, tripoint_bub_ms( x.get(), y.get(), dat.zlevel() + z.get() ), chosen_id,
+                   get_actions( dat, context ), context );
+        }
 
+        // Depends on the flags of the mapgen only, so it is the same for all its terrain.
+        static placing_actions get_actions( const mapgendata &dat, const std::string &context ) {
             apply_action act_furn = apply_action::act_unknown;
             apply_action act_trap = apply_action::act_unknown;
             apply_action act_item = apply_action::act_unknown;
@@ -3557,6 +3570,20 @@ class jmapgen_terrain : public jmapgen_piece_with_has_vehicle_collision
                           "mistake, as any dismantle outputs will not be preserved.",
                           context, dat.terrain_type().id().str() );
             }
+            return placing_actions{ act_furn, act_trap, act_item };
+        }
+
+        void place( const mapgendata &dat, const tripoint_bub_ms &p, const ter_id &chosen_id,
+                    const placing_actions &actions, const std::string &context ) const {
+            const apply_action act_furn = actions.furn;
+            const apply_action act_trap = actions.trap;
+            const apply_action act_item = actions.item;
+
+            const ter_id &terrain_here = dat.m.ter( p );
+            const ter_t &chosen_ter = *chosen_id;
+            const bool is_wall = chosen_ter.has_flag( ter_furn_flag::TFLAG_WALL );
+            const bool place_item = chosen_ter.has_flag( ter_furn_flag::TFLAG_PLACE_ITEM );
+            const bool is_boring_wall = is_wall && !place_item;
 
             if( is_boring_wall || act_furn == apply_action::act_erase ) {
                 dat.m.furn_clear( p );
@@ -5110,6 +5137,19 @@ void update_mapgen_function_json::setup()
 void mapgen_function_json::finalize_parameters()
 {
     finalize_parameters_common();
+
+    fixed_ter.clear();
+    fixed_furn.clear();
+    const std::optional<ter_id> fill = fill_ter ? fill_ter->get_fixed() : std::nullopt;
+    if( !fill || fill->id().is_null() || predecessor_mapgen != oter_str_id::NULL_ID() ||
+        expects_predecessor() || !setmap_points.empty() ) {
+        return;
+    }
+    fixed_fill = *fill;
+    if( !objects.get_fixed_layout( fixed_fill, fixed_ter, fixed_furn ) ) {
+        fixed_ter.clear();
+        fixed_furn.clear();
+    }
 }
 
 void mapgen_function_json_nested::finalize_parameters()
@@ -5421,6 +5461,23 @@ void jmapgen_objects::finalize()
 {
     std::stable_sort( objects.begin(), objects.end(), compare_phases );
     objects.shrink_to_fit();
+
+    cell_terrains.clear();
+    cell_terrains.reserve( objects.size() );
+    const auto is_fixed = []( const jmapgen_int & v ) {
+        return v.val == v.valmax;
+    };
+    for( const jmapgen_obj &obj : objects ) {
+        const jmapgen_place &where = obj.first;
+        const jmapgen_terrain *terrain = dynamic_cast<const jmapgen_terrain *>( obj.second.get() );
+        cell_terrain &cell = cell_terrains.emplace_back();
+        if( terrain && is_fixed( where.x ) && is_fixed( where.y ) && is_fixed( where.z ) &&
+            is_fixed( where.repeat ) && where.repeat.val == 1 &&
+            is_fixed( terrain->repeat ) && terrain->repeat.val == 1 ) {
+            cell.piece = terrain;
+            cell.fixed = terrain->id.get_fixed();
+        }
+    }
 }
 
 void jmapgen_objects::check( const std::string &context, const mapgen_parameters &parameters ) const
@@ -5452,6 +5509,49 @@ void jmapgen_objects::add_placement_coords_to( std::unordered_set<point_rel_ms>
     }
 }
 
+bool jmapgen_objects::get_fixed_layout( const ter_id &fill, std::vector<ter_id> &ter,
+                                        std::vector<furn_id> &furn ) const
+{
+    const point_rel_ms size( SEEX * 2, SEEY * 2 );
+    ter.assign( static_cast<size_t>( size.x() ) * size.y(), fill );
+    furn.assign( ter.size(), furn_str_id::NULL_ID() );
+    const auto is_fixed = []( const jmapgen_int & v ) {
+        return v.val == v.valmax;
+    };
+    for( size_t i = 0; i < objects.size(); ++i ) {
+        const jmapgen_place &where = objects[i].first;
+        const jmapgen_piece &what = *objects[i].second;
+        if( !is_fixed( where.x ) || !is_fixed( where.y ) || where.z.val != 0 ||
+            where.z.valmax != 0 || !is_fixed( where.repeat ) || where.repeat.val != 1 ||
+            !is_fixed( what.repeat ) || what.repeat.val != 1 ||
+            where.x.val < 0 || where.x.val >= size.x() || where.y.val < 0 || where.y.val >= size.y() ) {
+            return false;
+        }
+        const size_t cell = where.x.val + static_cast<size_t>( where.y.val ) * size.x();
+        if( const jmapgen_terrain *terrain = dynamic_cast<const jmapgen_terrain *>( &what ) ) {
+            const std::optional<ter_id> id = terrain->id.get_fixed();
+            if( !id ) {
+                return false;
+            }
+            if( !id->id().is_null() ) {
+                ter[cell] = *id;
+            }
+        } else if( const jmapgen_furniture *furniture = dynamic_cast<const jmapgen_furniture *>
+                   ( &what ) ) {
+            const std::optional<furn_id> id = furniture->id.get_fixed();
+            if( !id ) {
+                return false;
+            }
+            if( !id->id().is_null() ) {
+                furn[cell] = *id;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 ///// 3 - mapgen (gameplay)
 ///// stuff below is the actual in-game map generation (ill)logic
@@ -5782,11 +5882,8 @@ bool jmapgen_setmap::apply( const mapgendata &dat, const tripoint_rel_ms &offset
                 const point_rel_ms c2( x_get(), y_get() );
                 const int cx2 = x2_get();
                 const int cy2 = y2_get();
-                for( int tx = c2.x(); tx <= cx2; tx++ ) {
-                    for( int ty = c2.y(); ty <= cy2; ty++ ) {
-                        m.set_radiation( tripoint_bub_ms( tx, ty, z_level ), static_cast<int>( val.get() ) );
-                    }
-                }
+                m.set_radiation_square( point_bub_ms( c2.x(), c2.y() ), point_bub_ms( cx2, cy2 ), z_level,
+                                        static_cast<int>( val.get() ) );
             }
             break;
 
@@ -5911,6 +6008,7 @@ static ret_val<void> apply_mapgen_in_phases(
  */
 void mapgen_function_json::generate( mapgendata &md )
 {
+    cata_timer timer( "mapgen_function_json::generate" );
     map *const m = &md.m;
     const oter_t &ter = *md.terrain_type();
 
@@ -5954,6 +6052,14 @@ void mapgen_function_json::generate( mapgendata &md )
 
     // rotation.get can return a random value if val differs from valmax. Use same value in both directions.
     const int rot = rotation.get() % 4;
+
+    // Rotating there and back again only turns what this places.
+    const int turns = ter.is_rotatable() || ter.is_linear() ? rot + ter.get_rotation() : rot;
+    if( mapgen_shortcuts && !fixed_ter.empty() && place_fixed_layout( md, turns % 4 ) ) {
+        set_queued_points();
+        return;
+    }
+
     m->rotate( 4 - rot );
 
     if( ter.is_rotatable() || ter.is_linear() ) {
@@ -5982,6 +6088,37 @@ void mapgen_function_json::generate( mapgendata &md )
     set_queued_points();
 }
 
+bool mapgen_function_json::place_fixed_layout( mapgendata &md, const int turns ) const
+{
+    map &m = md.m;
+    const int z = md.zlevel();
+    if( !md.skip.empty() ) {
+        return false;
+    }
+    // Placing terrain clears or complains about what is there, so only empty levels are copied to.
+    for( const tripoint_bub_ms &p : m.points_on_zlevel( z ) ) {
+        if( m.has_furn( p ) || m.tr_at( p ) != tr_null || !m.i_at( p ).empty() ) {
+            return false;
+        }
+    }
+    m.draw_fill_background( fixed_fill );
+    const point_rel_ms size( SEEX * 2, SEEY * 2 );
+    for( int y = 0; y < size.y(); ++y ) {
+        for( int x = 0; x < size.x(); ++x ) {
+            const size_t cell = x + static_cast<size_t>( y ) * size.x();
+            const tripoint_bub_ms p( point_bub_ms( x, y ).rotate( turns, size.raw() ), z );
+            if( fixed_ter[cell] != fixed_fill ) {
+                m.ter_set( p, fixed_ter[cell] );
+            }
+            if( !fixed_furn[cell].id().is_null() && !m.furn_set( p, fixed_furn[cell] ) ) {
+                debugmsg( "Problem setting furniture in %s", context_ );
+            }
+        }
+    }
+    resolve_regional_terrain_and_furniture( md );
+    return true;
+}
+
 bool mapgen_function_json::expects_predecessor() const
 {
     return fallback_predecessor_mapgen_ != oter_str_id::NULL_ID();
@@ -6020,11 +6157,27 @@ void jmapgen_objects::apply( const mapgendata &dat, mapgen_phase phase,
                              const std::string &context ) const
 {
     bool terrain_resolved = false;
+    std::optional<jmapgen_terrain::placing_actions> terrain_actions;
 
     auto range_at_phase = std::equal_range( objects.begin(), objects.end(), phase, compare_phases );
 
     for( auto it = range_at_phase.first; it != range_at_phase.second; ++it ) {
         const jmapgen_obj &obj = *it;
+        const cell_terrain &cell = cell_terrains[it - objects.begin()];
+        if( cell.piece && mapgen_shortcuts ) {
+            const ter_id chosen_id = cell.fixed ? *cell.fixed : cell.piece->id.get( dat );
+            if( chosen_id.id().is_null() ) {
+                continue;
+            }
+            if( !terrain_actions ) {
+                terrain_actions = jmapgen_terrain::get_actions( dat, context );
+            }
+            const tripoint_rel_ms p = tripoint_rel_ms( obj.first.x.val, obj.first.y.val,
+                                      obj.first.z.val ) + offset;
+            cell.piece->place( dat, tripoint_bub_ms( p.x(), p.y(), dat.zlevel() + p.z() ), chosen_id,
+                               *terrain_actions, context );
+            continue;
+        }
         jmapgen_place where = obj.first;
         where.offset( tripoint_rel_ms( -offset.raw() ) );
         const jmapgen_piece &what = *obj.second;
@@ -7262,6 +7415,7 @@ std::vector<item *> map::place_items(
     const tripoint_bub_ms &p2, const bool ongrass, const time_point &turn, const int magazine,
     const int ammo, const std::string &faction )
 {
+    cata_timer timer( "map::place_items" );
     std::vector<item *> res;
 
     if( chance > 100 || chance <= 0 ) {
@@ -7279,6 +7433,8 @@ std::vector<item *> map::place_items(
     // spawn rates < 1 are handled in item_group
     const float spawn_rate = std::max( get_option<float>( "ITEM_SPAWNRATE" ), 1.0f );
     const int spawn_count = roll_remainder( chance * spawn_rate / 100.0f );
+    // Reused by every spawn, so rolling the group does not allocate each time.
+    Item_list rolled;
     for( int i = 0; i < spawn_count; i++ ) {
         // Might contain one item or several that belong together like guns & their ammo
         int tries = 0;
@@ -7305,7 +7461,9 @@ std::vector<item *> map::place_items(
                 }
             };
 
-            for( const item &itm : item_group::items_from( group_id, turn, spawn_flags::use_spawn_rate ) ) {
+            rolled.clear();
+            item_group::items_from( group_id, turn, rolled, spawn_flags::use_spawn_rate );
+            for( const item &itm : rolled ) {
                 const float item_cat_spawn_rate = std::max( 0.0f, item_category_spawn_rate( itm ) );
                 if( item_cat_spawn_rate == 0.0f ) {
                     continue;
@@ -7360,9 +7518,7 @@ std::vector<item *> map::put_items_from_loc( const item_group_id &group_id,
         const tripoint_bub_ms &p,
         const time_point &turn )
 {
-    const std::vector<item> items =
-        item_group::items_from( group_id, turn, spawn_flags::use_spawn_rate );
-    return spawn_items( p, items );
+    return spawn_items( p, item_group::items_from( group_id, turn, spawn_flags::use_spawn_rate ) );
 }
 
 void map::add_spawn( const MonsterGroupResult &spawn_details, const tripoint_bub_ms &p )
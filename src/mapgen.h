@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -28,6 +29,7 @@
 #include "weighted_list.h"
 
 // IWYU pragma: no_forward_declare jmapgen_flags
+class jmapgen_terrain;
 class map;
 class mapgendata;
 class mission;
@@ -405,6 +407,14 @@ struct jmapgen_objects {
 
         void add_placement_coords_to( std::unordered_set<point_rel_ms> & ) const;
 
+        /**
+         * If these only place terrain and furniture given verbatim, each once on a single cell
+         * of the first overmap terrain, gets what they leave on each cell after a fill with
+         * fill, by x + y * SEEX * 2.
+         */
+        bool get_fixed_layout( const ter_id &fill, std::vector<ter_id> &ter,
+                               std::vector<furn_id> &furn ) const;
+
         void apply( const mapgendata &dat, mapgen_phase, const std::string &context ) const;
         void apply( const mapgendata &dat, mapgen_phase, const tripoint_rel_ms &offset,
                     const std::string &context ) const;
@@ -421,6 +431,17 @@ struct jmapgen_objects {
          */
         using jmapgen_obj = std::pair<jmapgen_place, shared_ptr_fast<const jmapgen_piece> >;
         std::vector<jmapgen_obj> objects;
+        /**
+         * Terrain placed once on a single cell, like that of the rows of a mapgen, which apply
+         * places directly instead of through the placement of generic pieces.
+         */
+        struct cell_terrain {
+            const jmapgen_terrain *piece = nullptr;
+            // Unless it is a parameter or picked when placed.
+            std::optional<ter_id> fixed;
+        };
+        // Made by finalize, one for each of objects.
+        std::vector<cell_terrain> cell_terrains;
         tripoint_rel_ms m_offset;
         point_rel_ms mapgensize;
         point_rel_ms total_size;
@@ -498,6 +519,12 @@ class mapgen_function_json : public mapgen_function_json_base, public virtual ma
     private:
         jmapgen_int rotation;
         oter_str_id fallback_predecessor_mapgen_;
+        // What it always makes, when it is the same every time, so it can be copied instead.
+        ter_id fixed_fill;
+        std::vector<ter_id> fixed_ter;
+        std::vector<furn_id> fixed_furn;
+
+        bool place_fixed_layout( mapgendata &md, int turns ) const;
 };
 
 class update_mapgen_function_json : public mapgen_function_json_base
@@ -657,4 +684,10 @@ void add_corpse( map *m, const point_bub_ms & );
 extern std::map<nested_mapgen_id, nested_mapgen> nested_mapgens;
 extern std::map<update_mapgen_id, update_mapgen> update_mapgens;
 
+/**
+ * Whether mapgen places what is the same every time directly, instead of through the generic
+ * placement of every piece.  Only the tests comparing the two turn it off.
+ */
+extern bool mapgen_shortcuts;
+
 #endif // CATA_SRC_MAPGEN_H
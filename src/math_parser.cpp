@@ -23,6 +23,7 @@
 #include "debug.h"
 #include "dialogue.h"
 #include "dialogue_helpers.h"
+#include "global_vars.h"
 #include "math_parser_diag.h"
 #include "math_parser_diag_value.h"
 #include "math_parser_func.h"
@@ -203,6 +204,11 @@ std::vector<double> _eval_params( std::vector<thingie> const &params, const_dial
     return elems;
 }
 
+bool is_constant( thingie const &thing )
+{
+    return std::holds_alternative<double>( thing.data );
+}
+
 constexpr void _validate_operand( thingie const &thing, std::string_view symbol )
 {
     if( std::holds_alternative<std::string>( thing.data ) ) {
@@ -278,7 +284,18 @@ double func_jmath::eval( const_dialogue const &d ) const
 
 double var::eval( const_dialogue const &d ) const
 {
-    if( diag_value const *ret = maybe_read_var_value( varinfo, d ); ret ) {
+    diag_value const *ret = nullptr;
+    if( varinfo.type == var_type::global ) {
+        const global_variables &globvars = get_globals();
+        if( global == nullptr || global_generation != globvars.get_generation() ) {
+            global = globvars.maybe_get_global_value( varinfo.name );
+            global_generation = globvars.get_generation();
+        }
+        ret = global;
+    } else {
+        ret = maybe_read_var_value( varinfo, d );
+    }
+    if( ret ) {
         try {
             return ret->dbl( d );
         } catch( math::exception &ex ) {
@@ -832,6 +849,15 @@ void math_exp::math_exp_impl::new_func()
             },
             [&params, this]( pmath_func v )
             {
+                if( v->foldable && std::all_of( params.begin(), params.end(), is_constant ) ) {
+                    std::vector<double> args;
+                    args.reserve( params.size() );
+                    for( const thingie &param : params ) {
+                        args.push_back( std::get<double>( param.data ) );
+                    }
+                    output.emplace( v->f( args ) );
+                    return;
+                }
                 output.emplace( std::in_place_type_t<func>(), std::move( params ), v->f );
             },
             [&params, this]( jmath_func_id const & v )
@@ -869,6 +895,10 @@ void math_exp::math_exp_impl::new_ternary( thingie &lhs, thingie &rhs )
     thingie cond = std::move( output.top() );
     _validate_operand( cond, "?:" );
     output.pop();
+    if( is_constant( cond ) ) {
+        output.emplace( std::get<double>( cond.data ) > 0 ? std::move( lhs ) : std::move( rhs ) );
+        return;
+    }
     output.emplace( std::in_place_type_t<ternary>(), cond, lhs, rhs );
 }
 
@@ -935,6 +965,11 @@ void math_exp::math_exp_impl::new_oper()
                 if( output.empty() && arity.empty() ) {
                     type = v->type;
                 }
+                if( is_constant( lhs ) && is_constant( rhs ) ) {
+                    output.emplace( ( *v->f )( std::get<double>( lhs.data ),
+                                               std::get<double>( rhs.data ) ) );
+                    return;
+                }
                 output.emplace( std::in_place_type_t<oper>(), lhs, rhs, v->f );
             }
         },
@@ -945,6 +980,10 @@ void math_exp::math_exp_impl::new_oper()
             output.pop();
             parse_position = op.pos;
             _validate_operand( rhs, v->symbol );
+            if( is_constant( rhs ) ) {
+                output.emplace( ( *v->f )( 0.0, std::get<double>( rhs.data ) ) );
+                return;
+            }
             output.emplace( std::in_place_type_t<oper>(), thingie { 0.0 }, rhs, v->f );
         },
         [this, &op]( pass_op v )
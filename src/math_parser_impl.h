@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -131,6 +132,9 @@ struct var {
     void assign( dialogue &d, double val ) const;
 
     var_info varinfo;
+    // A global variable last found and the generation of the globals it was found in.
+    mutable diag_value const *global = nullptr;
+    mutable uint64_t global_generation = 0;
 };
 struct kwarg {
     kwarg() = default;
@@ -0,0 +1,77 @@
+#include "memory_fast.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+
+namespace cata
+{
+
+// Blocks carved from each slab.
+static constexpr size_t blocks_per_slab = 64;
+
+class block_pool
+{
+    public:
+        explicit block_pool( size_t size ) : block_size( round_up( size ) ) {}
+
+        void *allocate() {
+            std::lock_guard<std::mutex> lk( mutex );
+            if( free_blocks == nullptr ) {
+                add_slab();
+            }
+            free_block *const block = free_blocks;
+            free_blocks = block->next;
+            return block;
+        }
+
+        void deallocate( void *p ) {
+            std::lock_guard<std::mutex> lk( mutex );
+            free_blocks = new( p ) free_block{ free_blocks };
+        }
+
+    private:
+        struct free_block {
+            free_block *next;
+        };
+
+        static size_t round_up( size_t size ) {
+            constexpr size_t align = alignof( std::max_align_t );
+            return ( std::max( size, sizeof( free_block ) ) + align - 1 ) / align * align;
+        }
+
+        void add_slab() {
+            // Slabs are never freed, the blocks of a horde are there for the next one.
+            char *const slab = static_cast<char *>( ::operator new( block_size * blocks_per_slab ) );
+            for( size_t i = blocks_per_slab; i-- > 0; ) {
+                free_blocks = new( slab + i * block_size ) free_block{ free_blocks };
+            }
+        }
+
+        const size_t block_size;
+        std::mutex mutex;
+        free_block *free_blocks = nullptr;
+};
+
+block_pool &block_pool_for( const size_t size )
+{
+    // Never destroyed, as objects can be freed by the destructors of other statics.
+    static std::mutex *const pools_mutex = new std::mutex();
+    static std::map<size_t, block_pool> *const pools = new std::map<size_t, block_pool>();
+    std::lock_guard<std::mutex> lk( *pools_mutex );
+    return pools->try_emplace( size, size ).first->second;
+}
+
+void *block_pool_allocate( block_pool &pool )
+{
+    return pool.allocate();
+}
+
+void block_pool_deallocate( block_pool &pool, void *p )
+{
+    pool.deallocate( p );
+}
+
+} // namespace cata
@@ -2,7 +2,70 @@
 #ifndef CATA_SRC_MEMORY_FAST_H
 #define CATA_SRC_MEMORY_FAST_H
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <utility>
+
+namespace cata
+{
+
+class block_pool;
+
+// The pool of the blocks of the given size, which lives until exit.
+block_pool &block_pool_for( size_t size );
+void *block_pool_allocate( block_pool &pool );
+void block_pool_deallocate( block_pool &pool, void *p );
+
+/**
+ * Allocator keeping the freed blocks of each type for the next objects of the type, carved from
+ * slabs of blocks, instead of giving them back to the heap.  For the types created and destroyed
+ * by the hundred, like monsters, through make_pooled_shared_fast.
+ */
+template<typename T>
+class pool_allocator
+{
+    public:
+        using value_type = T;
+
+        pool_allocator() = default;
+        template<typename U>
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        pool_allocator( const pool_allocator<U> & ) {}
+
+        T *allocate( size_t n ) {
+            static_assert( alignof( T ) <= alignof( std::max_align_t ),
+                           "over-aligned types are not pooled" );
+            if( n != 1 ) {
+                return static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+            }
+            return static_cast<T *>( block_pool_allocate( pool() ) );
+        }
+        void deallocate( T *p, size_t n ) {
+            if( n != 1 ) {
+                ::operator delete( p );
+                return;
+            }
+            block_pool_deallocate( pool(), p );
+        }
+
+        template<typename U>
+        bool operator==( const pool_allocator<U> & ) const {
+            return true;
+        }
+        template<typename U>
+        bool operator!=( const pool_allocator<U> & ) const {
+            return false;
+        }
+
+    private:
+        static block_pool &pool() {
+            static block_pool &pool = block_pool_for( sizeof( T ) );
+            return pool;
+        }
+};
+
+} // namespace cata
 
 #if __GLIBCXX__
 template<typename T> using shared_ptr_fast = std::__shared_ptr<T, __gnu_cxx::_S_single>;
@@ -12,6 +75,13 @@ template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
 {
     return std::__make_shared<T, __gnu_cxx::_S_single>( args... );
 }
+// As make_shared_fast, with the object and its counts in a block of cata::pool_allocator.
+template<typename T, typename... Args> shared_ptr_fast<T> make_pooled_shared_fast(
+    Args &&... args )
+{
+    return std::__allocate_shared<T, __gnu_cxx::_S_single>( cata::pool_allocator<T>(),
+            std::forward<Args>( args )... );
+}
 #else
 template<typename T> using shared_ptr_fast = std::shared_ptr<T>;
 template<typename T> using weak_ptr_fast = std::weak_ptr<T>;
@@ -20,6 +90,11 @@ template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
 {
     return std::make_shared<T>( args... );
 }
+template<typename T, typename... Args> shared_ptr_fast<T> make_pooled_shared_fast(
+    Args &&... args )
+{
+    return std::allocate_shared<T>( cata::pool_allocator<T>(), std::forward<Args>( args )... );
+}
 #endif
 
 #endif // CATA_SRC_MEMORY_FAST_H
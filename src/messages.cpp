@@ -9,6 +9,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include "cached_options.h"
 #include "calendar.h"
@@ -42,6 +43,8 @@
 
 static const efftype_id effect_weed_high( "weed_high" );
 
+static const option_handle<int> option_message_limit( "MESSAGE_LIMIT" );
+
 namespace
 {
 
@@ -56,6 +59,12 @@ struct game_message {
     bool cooldown_hidden = false; // NOLINT(cata-serialize)
     game_message_type type = m_neutral;
 
+    // Lines of get_with_count() folded to folded_width, or without color tags if folded_plain.
+    // The sidebar and the log redraw often but the messages seldom change.
+    mutable std::vector<std::string> folded; // NOLINT(cata-serialize)
+    mutable int folded_width = 0; // NOLINT(cata-serialize)
+    mutable bool folded_plain = false; // NOLINT(cata-serialize)
+
     game_message() = default;
     game_message( std::string &&msg, game_message_type const t ) :
         message( std::move( msg ) ),
@@ -76,6 +85,24 @@ struct game_message {
         return string_format( _( "%s x %d" ), message, count );
     }
 
+    /** Get the message with its count folded to @p width, kept until the width or count change.
+     * @param plain whether the color tags are removed first.
+     */
+    const std::vector<std::string> &folded_to( const int width, const bool plain = false ) const {
+        if( width != folded_width || plain != folded_plain ) {
+            const std::string text = get_with_count();
+            folded = foldstring( plain ? remove_color_tags( text ) : text, width );
+            folded_width = width;
+            folded_plain = plain;
+        }
+        return folded;
+    }
+
+    void set_count( const int new_count ) {
+        count = new_count;
+        folded_width = 0;
+    }
+
     /** Get whether or not a message should not be displayed (hidden) in the side bar because it's in a cooldown period.
      * @returns `true` if the message should **not** be displayed, `false` otherwise.
      */
@@ -108,7 +135,7 @@ struct game_message {
     void deserialize( const JsonObject &obj ) {
         obj.read( "turn", timestamp_in_turns );
         message = obj.get_string( "message" );
-        count = obj.get_int( "count" );
+        set_count( obj.get_int( "count" ) );
         type = static_cast<game_message_type>( obj.get_int( "type" ) );
     }
 
@@ -163,7 +190,7 @@ class messages_impl
             }
 
             // coalesce messages
-            last_msg.count++;
+            last_msg.set_count( last_msg.count + 1 );
             last_msg.timestamp_in_turns = calendar::turn;
             last_msg.timestamp_in_user_actions = g->get_user_action_counter();
             last_msg.type = m.type;
@@ -200,7 +227,7 @@ class messages_impl
                 return;
             }
 
-            unsigned int message_limit = get_option<int>( "MESSAGE_LIMIT" );
+            unsigned int message_limit = option_message_limit();
             while( messages.size() > message_limit ) {
                 messages.pop_front();
             }
@@ -658,8 +685,7 @@ void Messages::dialog::init( ui_adaptor &ui )
     for( size_t ind = 0; ind < msg_count; ++ind ) {
         const size_t msg_ind = log_from_top ? ind : msg_count - 1 - ind;
         const game_message &msg = player_messages.history( msg_ind );
-        const auto &folded = foldstring( msg.get_with_count(), msg_width );
-        for( const auto &it : folded ) {
+        for( const std::string &it : msg.folded_to( msg_width ) ) {
             folded_filtered.emplace_back( folded_all.size() );
             folded_all.emplace_back( msg_ind, it );
         }
@@ -947,12 +973,8 @@ void Messages::display_messages( const catacurses::window &ipk_target, const int
             }
 
             const nc_color col = m.get_color( player_messages.curmes );
-            std::string message_text = m.get_with_count();
-            if( !m.is_recent( player_messages.curmes ) ) {
-                message_text = remove_color_tags( message_text );
-            }
-
-            for( const std::string &folded : foldstring( message_text, maxlength ) ) {
+            const bool plain = !m.is_recent( player_messages.curmes );
+            for( const std::string &folded : m.folded_to( maxlength, plain ) ) {
                 if( line > bottom ) {
                     break;
                 }
@@ -980,12 +1002,8 @@ void Messages::display_messages( const catacurses::window &ipk_target, const int
             }
 
             const nc_color col = m.get_color( player_messages.curmes );
-            std::string message_text = m.get_with_count();
-            if( !m.is_recent( player_messages.curmes ) ) {
-                message_text = remove_color_tags( message_text );
-            }
-
-            const auto folded_strings = foldstring( message_text, maxlength );
+            const bool plain = !m.is_recent( player_messages.curmes );
+            const std::vector<std::string> &folded_strings = m.folded_to( maxlength, plain );
             const auto folded_rend = folded_strings.rend();
             for( auto string_iter = folded_strings.rbegin();
                  string_iter != folded_rend && line >= top; ++string_iter, line-- ) {
@@ -2260,6 +2260,7 @@ bool talk_function::companion_om_combat_check( const std::vector<npc_ptr> &group
             tripoint_om_sm local_sm;
             std::tie( omp, local_sm ) = project_remain<coords::om>( sm );
             overmap &omi = overmap_buffer.get( omp );
+            omi.ensure_dynamic_loaded();
 
             auto monster_bucket = omi.monster_map.equal_range( local_sm );
             std::for_each( monster_bucket.first,
@@ -2187,7 +2187,7 @@ bool mattack::formblob( monster *z )
         if( critter == nullptr ) {
             if( z->get_speed_base() > mon_blob_small->speed + 35 && rng( 0, 250 ) < z->get_speed_base() ) {
                 // If we're big enough, spawn a baby blob.
-                shared_ptr_fast<monster> mon = make_shared_fast<monster>( mon_blob_small );
+                shared_ptr_fast<monster> mon = make_pooled_shared_fast<monster>( mon_blob_small );
                 mon->ammo = mon->type->starting_ammo;
                 if( mon->will_move_to( dest ) && mon->know_danger_at( dest ) ) {
                     didit = true;
@@ -25,6 +25,7 @@
 #include "field.h"
 #include "field_type.h"
 #include "game.h"
+#include "game_constants.h"
 #include "item.h"
 #include "line.h"
 #include "make_static.h"
@@ -98,6 +99,8 @@ static const ter_str_id ter_t_pit( "t_pit" );
 static const ter_str_id ter_t_pit_glass( "t_pit_glass" );
 static const ter_str_id ter_t_pit_spiked( "t_pit_spiked" );
 
+static const option_handle<bool> option_log_monster_movement( "LOG_MONSTER_MOVEMENT" );
+
 bool monster::is_immune_field( const field_type_id &fid ) const
 {
     if( fid == fd_fungal_haze ) {
@@ -479,8 +482,57 @@ bool monster::mating_angry() const
     return mating_angry;
 }
 
+// Throttle monster thinking, if there are no apparent threats, stop paying attention.
+static constexpr int max_turns_for_rate_limiting = 1800;
+
+// Whether a monster that has gone this long without a target looks for hostile monsters this
+// turn.
+static bool looks_for_hostiles( const int turns_since_target )
+{
+    constexpr double max_turns_to_skip = 600.0;
+    // Outputs a range from 0.0 - 1.0.
+    float rate_limiting_factor = 1.0 - logarithmic_range( 0, max_turns_for_rate_limiting,
+                                 turns_since_target );
+    int turns_to_skip = max_turns_to_skip * rate_limiting_factor;
+    return turns_to_skip == 0 || turns_since_target % turns_to_skip == 0;
+}
+
+// Most monsters in the reality bubble spend most turns here.  They can't see the avatar or
+// any NPC they would react to, and this isn't a turn they look for hostile monsters either,
+// so every branch of plan() would come up empty.
+bool monster::nothing_to_plan_for() const
+{
+    if( friendly != 0 || !patrol_route.empty() || looks_for_hostiles( turns_since_target ) ||
+        has_flag( mon_flag_SWARMS ) ||
+        ( has_flag( mon_flag_GROUP_MORALE ) && morale < type->morale ) ||
+        has_effect( effect_operating ) || has_effect( effect_dragging ) || is_pet_follow() ) {
+        return false;
+    }
+    // What sees() checks first: nothing this far away is ever seen.
+    const auto out_of_sight = [this]( const Creature &other ) {
+        return std::abs( posz() - other.posz() ) > fov_3d_z_range ||
+               rl_dist( pos_abs(), other.pos_abs() ) > MAX_VIEW_DISTANCE;
+    };
+    if( !out_of_sight( get_player_character() ) ) {
+        return false;
+    }
+    // Monsters react to NPCs they don't ignore even when they can't see them.
+    for( const npc &who : g->all_npcs() ) {
+        const mf_attitude faction_att = faction.obj().attitude( who.get_monster_faction() );
+        if( faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY ) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void monster::plan()
 {
+    if( nothing_to_plan_for() ) {
+        turns_since_target = std::min( turns_since_target + 1, max_turns_for_rate_limiting );
+        return;
+    }
+
     monster_plan mon_plan( *this );
 
     map &here = get_map();
@@ -512,16 +564,19 @@ void monster::plan()
         }
         anger_cub_threatened( mon_plan );
     } else if( friendly != 0 && !mon_plan.docile ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 && tmp.attitude_to( *this ) == Attitude::HOSTILE &&
-                seen_levels.test( tmp.posz() + OVERMAP_DEPTH ) ) {
-                float rating = rate_target( tmp, mon_plan.dist, mon_plan.smart_planning );
+        // Monsters outside of our reachable zone can't be seen, so only those in it are rated.
+        get_creature_tracker().for_each_reachable( *this, [this, &seen_levels,
+        &mon_plan]( Creature * other ) {
+            monster *tmp = dynamic_cast<monster *>( other );
+            if( tmp != nullptr && tmp->friendly == 0 && tmp->attitude_to( *this ) == Attitude::HOSTILE &&
+                seen_levels.test( tmp->posz() + OVERMAP_DEPTH ) ) {
+                float rating = rate_target( *tmp, mon_plan.dist, mon_plan.smart_planning );
                 if( rating < mon_plan.dist ) {
-                    mon_plan.target = &tmp;
+                    mon_plan.target = tmp;
                     mon_plan.dist = rating;
                 }
             }
-        }
+        } );
     }
 
     if( mon_plan.docile ) {
@@ -583,15 +638,8 @@ void monster::plan()
     }
 
     mon_plan.fleeing = mon_plan.fleeing || ( mood == MATT_FLEE );
-    // Throttle monster thinking, if there are no apparent threats, stop paying attention.
-    constexpr int max_turns_for_rate_limiting = 1800;
-    constexpr double max_turns_to_skip = 600.0;
-    // Outputs a range from 0.0 - 1.0.
-    float rate_limiting_factor = 1.0 - logarithmic_range( 0, max_turns_for_rate_limiting,
-                                 turns_since_target );
-    int turns_to_skip = max_turns_to_skip * rate_limiting_factor;
     creature_tracker &tracker = get_creature_tracker();
-    if( friendly == 0 && ( turns_to_skip == 0 || turns_since_target % turns_to_skip == 0 ) ) {
+    if( friendly == 0 && looks_for_hostiles( turns_since_target ) ) {
         tracker.for_each_reachable( *this, [this]( const mfaction_id & other ) {
             const mf_attitude faction_att = faction->attitude( other );
             return !( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY );
@@ -874,10 +922,15 @@ void monster::move()
     // directly and instead iterate over the map from the monster type
     // (properties of monster types should never change).
     if( !has_flag( json_flag_CANNOT_ATTACK ) ) {
+        // Both maps are sorted by name, so the entries of the monster are found by walking
+        // along with those of the type.
+        auto local_iter = special_attacks.begin();
         for( const auto &sp_type : type->special_attacks ) {
             const std::string &special_name = sp_type.first;
-            const auto local_iter = special_attacks.find( special_name );
-            if( local_iter == special_attacks.end() ) {
+            while( local_iter != special_attacks.end() && local_iter->first < special_name ) {
+                ++local_iter;
+            }
+            if( local_iter == special_attacks.end() || local_iter->first != special_name ) {
                 continue;
             }
             mon_special_attack &local_attack_data = local_iter->second;
@@ -891,14 +944,16 @@ void monster::move()
             // Cooldowns are decremented in monster::process_turn
 
             if( local_attack_data.cooldown == 0 && !pacified && !is_hallucination() ) {
-                if( !sp_type.second->call( *this ) ) {
+                const bool attacked = sp_type.second->call( *this );
+                // `special_attacks` might have changed at this point, so find our place in it
+                // again.  Sadly `reset_special` doesn't check the attack name, so we need to
+                // do it here.
+                local_iter = special_attacks.lower_bound( special_name );
+                if( !attacked ) {
                     add_msg_debug( debugmode::DF_MATTACK, "Attack failed" );
                     continue;
                 }
-
-                // `special_attacks` might have changed at this point. Sadly `reset_special`
-                // doesn't check the attack name, so we need to do it here.
-                if( special_attacks.count( special_name ) == 0 ) {
+                if( local_iter == special_attacks.end() || local_iter->first != special_name ) {
                     continue;
                 }
                 reset_special( special_name );
@@ -1049,12 +1104,15 @@ void monster::move()
 
             const pathfinding_settings &pf_settings = get_pathfinding_settings();
             if( pf_settings.max_dist >= rl_dist( pos_abs(), get_dest() ) &&
-                ( path.empty() || rl_dist( pos_bub(), path.front() ) >= 2 || path.back() != local_dest ) ) {
+                ( path.empty() || rl_dist( pos_bub(), path.front() ) >= 2 || path.back() != local_dest ) &&
+                !( can_pathfind() && reuse_path( path, local_dest, pf_settings, get_path_avoid() ) ) ) {
                 // We need a new path
                 if( can_pathfind() ) {
-                    path = here.route( *this, pathfinding_target::point( local_dest ) );
+                    path = here.flow_route( *this, local_dest );
                     if( path.empty() ) {
                         increment_pathfinding_cd();
+                    } else {
+                        mark_path_planned( pf_settings );
                     }
                 } else {
                     path = here.straight_route( pos_bub(), local_dest );
@@ -1984,7 +2042,7 @@ bool monster::move_to( const tripoint_bub_ms &p, bool force, bool step_on_critte
             has_flag( mon_flag_AQUATIC ) || ( can_submerge() && !here.veh_at( destination ) )
         ) && here.is_divable( destination );
 
-    if( get_option<bool>( "LOG_MONSTER_MOVEMENT" ) ) {
+    if( option_log_monster_movement() ) {
         //Birds and other flying creatures flying over the deep water terrain
         if( was_water && flies() ) {
             if( one_in( 4 ) ) {
@@ -243,6 +243,14 @@ static int compute_kill_xp( const mtype_id &mon_type )
     return mon_type->difficulty + mon_type->difficulty_base;
 }
 
+// game::cleanup_dead only looks for monsters to kill after one of them ran out of hp.
+static void flag_if_dead( const monster &z )
+{
+    if( z.is_dead_state() ) {
+        g->set_critter_died();
+    }
+}
+
 monster::monster()
 {
     unset_dest();
@@ -375,6 +383,7 @@ void monster::poly( const mtype_id &id )
     anger = type->agro;
     morale = type->morale;
     hp = static_cast<int>( hp_percentage * type->hp );
+    flag_if_dead( *this );
     special_attacks.clear();
     dialogue d( get_talker_for( this ), get_talker_for( get_avatar() ) );
     for( const auto &sa : type->special_attacks ) {
@@ -2442,6 +2451,7 @@ int monster::heal( const int delta_hp, bool overheal )
 void monster::set_hp( const int hp )
 {
     this->hp = hp;
+    flag_if_dead( *this );
 }
 
 void monster::apply_damage( Creature *source, bodypart_id /*bp*/, int dam,
@@ -2453,6 +2463,7 @@ void monster::apply_damage( Creature *source, bodypart_id /*bp*/, int dam,
     // Ensure we can try to get at what hit us.
     reset_pathfinding_cd();
     hp -= dam;
+    flag_if_dead( *this );
 
     cata::event e = cata::event::make<event_type::monster_takes_damage>( dam, hp < 1 );
     if( source ) {
@@ -2925,6 +2936,7 @@ void monster::explode()
     // Handled in mondeath::normal
     // +1 to avoid overflow when evaluating -hp
     hp = INT_MIN + 1;
+    flag_if_dead( *this );
 }
 
 void monster::process_turn()
@@ -2950,10 +2962,13 @@ void monster::process_turn()
 
     // Special attack cooldowns are updated here.
     // Loop through the monster's special attacks, same as monster::move.
+    auto local_iter = special_attacks.begin();
     for( const auto &sp_type : type->special_attacks ) {
         const std::string &special_name = sp_type.first;
-        const auto local_iter = special_attacks.find( special_name );
-        if( local_iter == special_attacks.end() ) {
+        while( local_iter != special_attacks.end() && local_iter->first < special_name ) {
+            ++local_iter;
+        }
+        if( local_iter == special_attacks.end() || local_iter->first != special_name ) {
             continue;
         }
         mon_special_attack &local_attack_data = local_iter->second;
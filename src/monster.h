@@ -263,6 +263,8 @@ class monster : public Creature
         float rate_target( Creature &c, float best, bool smart = false ) const;
         // is it mating season?
         bool mating_angry() const;
+        // Whether plan() can't come up with anything this turn, see there.
+        bool nothing_to_plan_for() const;
         void plan();
         void anger_hostile_seen( const monster_plan &mon_plan );
         void anger_mating_season( const monster_plan &mon_plan );
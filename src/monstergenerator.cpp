@@ -119,6 +119,40 @@ bool string_id<mtype>::is_valid() const
     return MonsterGenerator::generator().mon_templates->is_valid( *this );
 }
 
+/** @relates int_id */
+template<>
+bool int_id<mtype>::is_valid() const
+{
+    return MonsterGenerator::generator().mon_templates->is_valid( *this );
+}
+
+/** @relates int_id */
+template<>
+const mtype &int_id<mtype>::obj() const
+{
+    return MonsterGenerator::generator().mon_templates->obj( *this );
+}
+
+/** @relates int_id */
+template<>
+const mtype_id &int_id<mtype>::id() const
+{
+    return MonsterGenerator::generator().mon_templates->convert( *this );
+}
+
+/** @relates int_id */
+template<>
+mtype_int_id mtype_id::id() const
+{
+    return MonsterGenerator::generator().mon_templates->convert( *this, mtype_int_id() );
+}
+
+/** @relates int_id */
+template<>
+int_id<mtype>::int_id( const mtype_id &id ) : _id( id.id().to_i() )
+{
+}
+
 /** @relates string_id */
 template<>
 const species_type &string_id<species_type>::obj() const
@@ -105,6 +105,7 @@ class MonsterGenerator
         void finalize_pathfinding_settings( mtype &mon );
 
         friend class string_id<mtype>;
+        friend class int_id<mtype>;
         friend class string_id<species_type>;
         friend class string_id<mattack_actor>;
 
@@ -1457,6 +1457,9 @@ class npc : public Character
         bool dead = false;  // If true, we need to be cleaned up
         // Temporary variable for preventing from death (used by EoC event)
         bool prevent_death_reminder = false; // NOLINT(cata-serialize)
+        // What evaluate_best_weapon returns while evaluate_best_attack runs, which asks for
+        // it once for every item it rates as thrown.
+        mutable std::optional<item *> best_weapon_while_rating; // NOLINT(cata-serialize)
 
         bool sees_dangerous_field( const tripoint_bub_ms &p ) const;
         bool could_move_onto( const tripoint_bub_ms &p ) const;
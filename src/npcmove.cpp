@@ -30,6 +30,7 @@
 #include "bodypart.h"
 #include "calendar.h"
 #include "cata_algo.h"
+#include "cata_scope_helpers.h"
 #include "character.h"
 #include "character_attire.h"
 #include "character_id.h"
@@ -254,6 +255,43 @@ bool good_for_pickup( const item &it, npc &who, const tripoint_bub_ms &there )
            who.would_take_that( it, there );
 }
 
+// The armour and weapon of a character as NPCs rate them.  Every NPC comes to the same values,
+// and in a camp every follower rates every other one each turn, so they are shared for the
+// turn, as long as the character holds on to the same weapon and wears as many items.
+struct gear_estimate {
+    character_id id;
+    const item *weapon = nullptr;
+    itype_id weapon_type;
+    size_t worn_count = 0;
+    float armour = 0.0f;
+    double weapon_value = 0.0;
+};
+
+time_point gear_estimates_turn = calendar::before_time_starts;
+std::unordered_map<const Character *, gear_estimate> gear_estimates;
+
+const gear_estimate &estimate_gear( const npc &rater, const Character &candidate )
+{
+    if( gear_estimates_turn != calendar::turn ) {
+        gear_estimates.clear();
+        gear_estimates_turn = calendar::turn;
+    }
+    const item *weapon = candidate.get_wielded_item().get_item();
+    const itype_id weapon_type = weapon ? weapon->typeId() : itype_id::NULL_ID();
+    const auto [iter, added] = gear_estimates.try_emplace( &candidate );
+    gear_estimate &estimate = iter->second;
+    if( added || estimate.id != candidate.getID() || estimate.weapon != weapon ||
+        estimate.weapon_type != weapon_type || estimate.worn_count != candidate.worn.size() ) {
+        estimate.id = candidate.getID();
+        estimate.weapon = weapon;
+        estimate.weapon_type = weapon_type;
+        estimate.worn_count = candidate.worn.size();
+        estimate.armour = rater.estimate_armour( candidate );
+        estimate.weapon_value = candidate.weapon_value( weapon ? *weapon : null_item_reference() );
+    }
+    return estimate;
+}
+
 } // namespace
 
 static std::string npc_action_name( npc_action action );
@@ -510,11 +548,10 @@ float npc::evaluate_character( const Character &candidate, bool my_gun, bool ene
 {
     float threat = 0.0f;
     bool candidate_gun = candidate.get_wielded_item() && candidate.get_wielded_item()->is_gun();
-    const item &candidate_weap = candidate.get_wielded_item() ? *candidate.get_wielded_item() :
-                                 null_item_reference();
-    double candidate_weap_val = candidate.weapon_value( candidate_weap );
+    const gear_estimate &gear = estimate_gear( *this, candidate );
+    double candidate_weap_val = gear.weapon_value;
     float candidate_health =  candidate.hp_percentage() / 100.0f;
-    float armour = estimate_armour( candidate );
+    float armour = gear.armour;
     float speed = std::max( 0.25f, candidate.get_speed() / 100.0f );
     bool is_fleeing = candidate.has_effect( effect_npc_run_away );
     int perception_inverted = std::max( ( 20 - get_per() ), 0 );
@@ -620,7 +657,7 @@ float npc::evaluate_self( bool my_gun )
     float pain_factor = rng( 0.0f,
                              static_cast<float>( get_pain() ) / static_cast<float>( get_per() ) );
     mem_combat.my_health = ( hp_percentage() - pain_factor ) / 100.0f;
-    float armour = estimate_armour( dynamic_cast<const Character &>( *this ) );
+    float armour = estimate_gear( *this, *this ).armour;
     float speed = std::max( 0.5f, get_speed() / 100.0f );
     if( my_gun ) {
         speed = std::max( speed, 0.75f );
@@ -699,8 +736,7 @@ float npc::estimate_armour( const Character &candidate ) const
     add_msg_debug( debugmode::DF_NPC_ITEMAI,
                    "<color_light_gray>%s rates </color>%s total armour value: %1.2f.", name,
                    candidate.disp_name( true ), armour );
-    // this is a value we could easily cache.
-    // I don't know how to do that, I'm supposed to be a writer.
+    // NPCs share this for the turn through estimate_gear.
     return armour;
 }
 
@@ -2049,6 +2085,12 @@ void npc::evaluate_best_attack( const Creature *target )
         }
     };
 
+    // Rating an attack doesn't change what we carry, so the best weapon stays the same.
+    best_weapon_while_rating = evaluate_best_weapon();
+    on_out_of_scope forget_best_weapon( [this]() {
+        best_weapon_while_rating.reset();
+    } );
+
     // punching things is always available
     compare( std::make_shared<npc_attack_melee>( null_item_reference() ), "barehanded" );
     visit_items( [&compare, this, &here]( item * it, item * ) {
@@ -2894,6 +2936,9 @@ bool npc::update_path( const tripoint_bub_ms &p, const bool no_bashing, bool for
             // Our path already leads to that point, no need to recalculate
             return true;
         }
+        if( reuse_path( path, p, get_pathfinding_settings( no_bashing ), get_path_avoid() ) ) {
+            return true;
+        }
     }
 
     std::vector<tripoint_bub_ms> new_path = get_map().route( pos_bub(), pathfinding_target::point( p ),
@@ -2915,6 +2960,7 @@ bool npc::update_path( const tripoint_bub_ms &p, const bool no_bashing, bool for
 
     if( !new_path.empty() || force ) {
         path = std::move( new_path );
+        mark_path_planned( get_pathfinding_settings( no_bashing ) );
         return true;
     }
 
@@ -4124,6 +4170,9 @@ double npc::evaluate_weapon( item &maybe_weapon, bool can_use_gun, bool use_sile
 
 item *npc::evaluate_best_weapon() const
 {
+    if( best_weapon_while_rating ) {
+        return *best_weapon_while_rating;
+    }
     bool can_use_gun = !is_player_ally() || rules.has_flag( ally_rule::use_guns );
     bool use_silent = is_player_ally() && rules.has_flag( ally_rule::use_silent );
 
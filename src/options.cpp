@@ -960,6 +960,7 @@ int options_manager::cOpt::getMaxLength() const
 //set to next item
 void options_manager::cOpt::setNext()
 {
+    options_manager::note_change();
     if( sType == "string_select" ) {
         int iNext = getItemPos( sSet ) + 1;
         if( iNext >= static_cast<int>( vItems.size() ) ) {
@@ -1003,6 +1004,7 @@ void options_manager::cOpt::setNext()
 //set to previous item
 void options_manager::cOpt::setPrev()
 {
+    options_manager::note_change();
     if( sType == "string_select" ) {
         int iPrev = static_cast<int>( getItemPos( sSet ) ) - 1;
         if( iPrev < 0 ) {
@@ -1041,6 +1043,7 @@ void options_manager::cOpt::setPrev()
 //set value
 void options_manager::cOpt::setValue( float fSetIn )
 {
+    options_manager::note_change();
     if( sType != "float" ) {
         debugmsg( "tried to set a float value to a %s option", sType );
         return;
@@ -1054,6 +1057,7 @@ void options_manager::cOpt::setValue( float fSetIn )
 //set value
 void options_manager::cOpt::setValue( int iSetIn )
 {
+    options_manager::note_change();
     if( sType != "int" ) {
         debugmsg( "tried to set an int value to a %s option", sType );
         return;
@@ -1067,6 +1071,7 @@ void options_manager::cOpt::setValue( int iSetIn )
 //set value
 void options_manager::cOpt::setValue( const std::string &sSetIn )
 {
+    options_manager::note_change();
     if( sType == "string_select" ) {
         if( getItemPos( sSetIn ) != -1 ) {
             sSet = sSetIn;
@@ -1664,6 +1669,21 @@ void options_manager::add_options_general()
            );
 
         get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
+
+        add( "MAPBUFFER_BUDGET", page_id, to_translation( "Loaded map memory budget (MiB)" ),
+             to_translation( "Roughly how much memory the parts of the map that were visited or loaded since the last save may take.  Beyond it, those that were visited the longest ago are saved and unloaded.  0 = no limit." ),
+             0, 65536, 0
+           );
+
+        add( "FORK_SAVES", page_id, to_translation( "Save in a forked process" ),
+             to_translation( "If true, autosaves and quicksaves are written by a copy of the game process, so play goes on at once while the copy writes the game as it was when saving began.  Loading parts of the map that are not in memory waits until the copy is done.  Not available on Windows." ),
+             false,
+#if defined(_WIN32) || defined(EMSCRIPTEN)
+             COPT_ALWAYS_HIDE
+#else
+             COPT_NO_HIDE
+#endif
+           );
     } );
 
     add_empty_line();
@@ -2755,6 +2775,11 @@ void options_manager::add_options_world_default()
          false
        );
 
+    add( "BINARY_SUBMAPS", "world_default", to_translation( "Binary map data" ),
+         to_translation( "If true, map data is saved in a binary format that loads faster.  Maps saved in either format can always be loaded." ),
+         false
+       );
+
     add_empty_line();
 
     // These optiosn are purposefully and permanently hidden. It can only be modified through the sliders when creating a new world.
@@ -2898,6 +2923,11 @@ void options_manager::add_options_debug()
          false
 #endif
        );
+
+    add( "LAZY_ITEM_FINALIZATION", "debug", to_translation( "Finalize item types on first use" ),
+         to_translation( "If enabled, the armor coverage and the repair tools of item types are worked out when the item type is first used instead of during loading.  This speeds up loading with many mods, but errors in them are only reported once the item type is used." ),
+         false
+       );
 }
 
 void options_manager::add_options_android()
@@ -3909,6 +3939,8 @@ std::string options_manager::show( bool ingame, const bool world_options_only, b
         }
     }
 
+    // The old options may have been copied back over the ones edited.
+    note_change();
     if( lang_changed ) {
         update_global_locale();
         set_language_from_options();
@@ -4064,6 +4096,7 @@ bool options_manager::save() const
 
 void options_manager::load()
 {
+    note_change();
     const cata_path file = PATH_INFO::options();
     read_from_file_optional_json( file, [&]( const JsonArray & jsin ) {
         deserialize( jsin );
@@ -4119,8 +4152,16 @@ options_manager::options_container options_manager::get_world_defaults() const
     return result;
 }
 
+uint64_t &options_manager::generation()
+{
+    // Past the generation of handles that have not looked yet.
+    static uint64_t generation = 1;
+    return generation;
+}
+
 void options_manager::set_world_options( options_container *options )
 {
+    note_change();
     if( options == nullptr ) {
         world_options.reset();
     } else {
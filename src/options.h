@@ -3,6 +3,7 @@
 #define CATA_SRC_OPTIONS_H
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <optional>
@@ -236,6 +237,17 @@ class options_manager
 
         cOpt &get_option( const std::string &name );
 
+        /**
+         * Changes whenever an option may have changed its value, or the world options were
+         * swapped, so option_handle knows to look its option up again.
+         */
+        static uint64_t get_generation() {
+            return generation();
+        }
+        static void note_change() {
+            ++generation();
+        }
+
         //add hidden external option with value
         void add_external( const std::string &sNameIn, const std::string &sPageIn,
                            const std::string &sType );
@@ -283,6 +295,7 @@ class options_manager
     private:
         options_container options;
         std::optional<options_container *> world_options; // NOLINT(cata-serialize)
+        static uint64_t &generation();
 
         /** Option group. */
         class Group
@@ -505,4 +518,28 @@ inline T get_option( const std::string &name, bool convert = false )
     return get_options().get_option( name ).value_as<T>( convert );
 }
 
+/**
+ * An option read often, looked up by name only after the options changed.  Keep it static at
+ * the call site, e.g. `static const option_handle<bool> autosave( "AUTOSAVE" );`.
+ * Not for code that runs on other threads than the main one.
+ */
+template<typename T>
+class option_handle
+{
+    public:
+        explicit option_handle( std::string name ) : name( std::move( name ) ) {}
+
+        T operator()() const {
+            if( generation != options_manager::get_generation() ) {
+                value = get_option<T>( name );
+                generation = options_manager::get_generation();
+            }
+            return value;
+        }
+    private:
+        std::string name;
+        mutable T value{};
+        mutable uint64_t generation = 0;
+};
+
 #endif // CATA_SRC_OPTIONS_H
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <exception>
 #include <filesystem>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <numeric>
@@ -26,6 +27,7 @@
 #include "cata_path.h"
 #include "cata_utility.h"
 #include "cata_views.h"
+#include "compression_dictionary.h"
 #include "catacharset.h"
 #include "character_id.h"
 #include "coordinates.h"
@@ -58,13 +60,16 @@
 #include "output.h"
 #include "overmap_connection.h"
 #include "overmap_location.h"
+#include "overmap_road_graph.h"
 #include "overmap_noise.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
+#include "perf.h"
 #include "regional_settings.h"
 #include "rng.h"
 #include "rotatable_symbols.h"
+#include "save_writer.h"
 #include "sets_intersect.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
@@ -3157,6 +3162,27 @@ void overmap::populate( overmap_special_batch &enabled_specials )
 }
 
 void overmap::populate()
+{
+    overmap_special_batch enabled_specials = enabled_default_specials();
+    populate( enabled_specials );
+}
+
+std::unique_ptr<overmap::generation> overmap::start_populating()
+{
+    try {
+        if( open_saved() ) {
+            return nullptr;
+        }
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap (%d,%d) failed to load: %s", loc.x(), loc.y(), err.what() );
+        return nullptr;
+    }
+    std::unique_ptr<generation> gen = std::make_unique<generation>( enabled_default_specials() );
+    gen->neighbors = existing_neighbors();
+    return gen;
+}
+
+overmap_special_batch overmap::enabled_default_specials() const
 {
     overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
     const overmap_feature_flag_settings &overmap_feature_flag = settings->overmap_feature_flag;
@@ -3191,7 +3217,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -3205,6 +3231,7 @@ void overmap::init_layers()
         const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
         map_layer &l = layer[k];
         l.terrain.fill( tid );
+        l.uniform_terrain_known = false;
         l.visible.fill( om_vision_level::unseen );
         l.explored.fill( false );
     }
@@ -3217,7 +3244,15 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    oter_id &current_oter = layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()];
+    map_layer &current_layer = layer[p.z() + OVERMAP_DEPTH];
+    oter_id &current_oter = current_layer.terrain[p.xy()];
+    if( current_layer.uniform_terrain != id ) {
+        current_layer.uniform_terrain_known = false;
+    }
+    if( road_graph_cache && ( overmap_road_graph::is_road( current_oter ) ||
+                              overmap_road_graph::is_road( id ) ) ) {
+        road_graph_cache.reset();
+    }
     const oter_type_str_id &current_type_id = current_oter->get_type_id();
     const oter_type_str_id &incoming_type_id = id->get_type_id();
     const bool current_type_same = current_type_id == incoming_type_id;
@@ -3251,6 +3286,14 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
     current_oter = id;
 }
 
+const overmap_road_graph &overmap::road_graph() const
+{
+    if( !road_graph_cache ) {
+        road_graph_cache = std::make_shared<const overmap_road_graph>( overmap_road_graph::build( *this ) );
+    }
+    return *road_graph_cache;
+}
+
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
@@ -3266,6 +3309,28 @@ const oter_id &overmap::ter_unsafe( const tripoint_om_omt &p ) const
     return layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()];
 }
 
+std::optional<oter_id> overmap::uniform_terrain( const int z ) const
+{
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return std::nullopt;
+    }
+    const map_layer &l = layer[z + OVERMAP_DEPTH];
+    if( !l.uniform_terrain_known ) {
+        const oter_id &first = l.terrain[0][0];
+        l.uniform_terrain = first;
+        for( int x = 0; x < OMAPX && l.uniform_terrain; ++x ) {
+            for( const oter_id &t : l.terrain[x] ) {
+                if( t != first ) {
+                    l.uniform_terrain = std::nullopt;
+                    break;
+                }
+            }
+        }
+        l.uniform_terrain_known = true;
+    }
+    return l.uniform_terrain;
+}
+
 std::optional<mapgen_arguments> *overmap::mapgen_args( const tripoint_om_omt &p )
 {
     auto it = mapgen_args_index.find( p );
@@ -3337,6 +3402,7 @@ bool overmap::is_explored( const tripoint_om_omt &p ) const
 
 bool overmap::mongroup_check( const mongroup &candidate ) const
 {
+    ensure_dynamic_loaded();
     tripoint_om_sm relp = candidate.rel_pos();
     const auto matching_range = zg.equal_range( relp );
     return std::find_if( matching_range.first, matching_range.second,
@@ -3353,6 +3419,7 @@ bool overmap::mongroup_check( const mongroup &candidate ) const
 
 bool overmap::monster_check( const std::pair<tripoint_om_sm, monster> &candidate ) const
 {
+    ensure_dynamic_loaded();
     const auto matching_range = monster_map.equal_range( candidate.first );
     return std::find_if( matching_range.first, matching_range.second,
     [candidate]( const std::pair<tripoint_om_sm, monster> &match ) {
@@ -3363,12 +3430,14 @@ bool overmap::monster_check( const std::pair<tripoint_om_sm, monster> &candidate
 
 void overmap::insert_npc( const shared_ptr_fast<npc> &who )
 {
+    ensure_dynamic_loaded();
     npcs.push_back( who );
     g->set_npcs_dirty();
 }
 
 shared_ptr_fast<npc> overmap::erase_npc( const character_id &id )
 {
+    ensure_dynamic_loaded();
     const auto iter = std::find_if( npcs.begin(),
     npcs.end(), [id]( const shared_ptr_fast<npc> &n ) {
         return n->getID() == id;
@@ -3386,6 +3455,7 @@ std::vector<shared_ptr_fast<npc>> overmap::get_npcs( const
                                std::function<bool( const npc & )>
                                &predicate ) const
 {
+    ensure_dynamic_loaded();
     std::vector<shared_ptr_fast<npc>> result;
     for( const auto &g : npcs ) {
         if( predicate( *g ) ) {
@@ -3678,6 +3748,7 @@ bool overmap::inbounds( const tripoint_om_omt &p, int clearance )
 
 const scent_trace &overmap::scent_at( const tripoint_abs_omt &loc ) const
 {
+    ensure_dynamic_loaded();
     static const scent_trace null_scent;
     const auto &scent_found = scents.find( loc );
     if( scent_found != scents.end() ) {
@@ -3688,6 +3759,7 @@ const scent_trace &overmap::scent_at( const tripoint_abs_omt &loc ) const
 
 void overmap::set_scent( const tripoint_abs_omt &loc, const scent_trace &new_scent )
 {
+    ensure_dynamic_loaded();
     // TODO: increase strength of scent trace when applied repeatedly in a short timespan.
     scents[loc] = new_scent;
 }
@@ -3696,120 +3768,161 @@ void overmap::generate( const std::vector<const overmap *> &neighbor_overmaps,
                         overmap_special_batch &enabled_specials )
 {
     dbg( D_INFO ) << "overmap::generate start…";
-    const oter_id omt_outside_defined_omap = static_cast<oter_id>
-            ( get_option<std::string>( "OUTSIDE_DEFINED_OMAP_OMT" ) );
-    const std::string overmap_pregenerated_path =
-        get_option<std::string>( "OVERMAP_PREGENERATED_PATH" );
-    if( !overmap_pregenerated_path.empty() ) {
-        // HACK: For some reason gz files are automatically unpacked and renamed during Android build process
+    generation gen( enabled_specials );
+    gen.neighbors = neighbor_overmaps;
+    while( generate_step( gen ) ) {
+    }
+    enabled_specials = gen.specials;
+    dbg( D_INFO ) << "overmap::generate done";
+}
+
+bool overmap::generate_step( generation &gen )
+{
+    const std::vector<const overmap *> &neighbor_overmaps = gen.neighbors;
+    switch( gen.stage++ ) {
+        case 0: {
+            const oter_id omt_outside_defined_omap = static_cast<oter_id>
+                    ( get_option<std::string>( "OUTSIDE_DEFINED_OMAP_OMT" ) );
+            const std::string overmap_pregenerated_path =
+                get_option<std::string>( "OVERMAP_PREGENERATED_PATH" );
+            if( !overmap_pregenerated_path.empty() ) {
+                // HACK: For some reason gz files are automatically unpacked and renamed during Android build process
 #if defined(__ANDROID__)
-        static const std::string fname = "%s/overmap_%d_%d.omap";
+                static const std::string fname = "%s/overmap_%d_%d.omap";
 #else
-        static const std::string fname = "%s/overmap_%d_%d.omap.gz";
+                static const std::string fname = "%s/overmap_%d_%d.omap.gz";
 #endif
-        const cata_path fpath = PATH_INFO::moddir() / string_format( fname,
-                                overmap_pregenerated_path, pos().x(), pos().y() );
-        dbg( D_INFO ) << "trying" << fpath;
-        if( !read_from_file_optional_json( fpath, [this, &fpath]( const JsonValue & jv ) {
-        unserialize_omap( jv, fpath );
-        } ) ) {
-            dbg( D_INFO ) << "failed" << fpath;
-            int z = 0;
-            for( int j = 0; j < OMAPY; j++ ) {
-                // NOLINTNEXTLINE(modernize-loop-convert)
-                for( int i = 0; i < OMAPX; i++ ) {
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
+                const cata_path fpath = PATH_INFO::moddir() / string_format( fname,
+                                        overmap_pregenerated_path, pos().x(), pos().y() );
+                dbg( D_INFO ) << "trying" << fpath;
+                if( !read_from_file_optional_json( fpath, [this, &fpath]( const JsonValue & jv ) {
+                unserialize_omap( jv, fpath );
+                } ) ) {
+                    dbg( D_INFO ) << "failed" << fpath;
+                    int z = 0;
+                    for( int j = 0; j < OMAPY; j++ ) {
+                        // NOLINTNEXTLINE(modernize-loop-convert)
+                        for( int i = 0; i < OMAPX; i++ ) {
+                            layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
+                        }
+                    }
+                    layer[z + OVERMAP_DEPTH].uniform_terrain_known = false;
                 }
             }
-        }
-    }
 
-    std::vector<Highway_path> highway_paths;
-    calculate_urbanity();
-    calculate_forestosity();
-    if( get_option<bool>( "OVERMAP_POPULATE_OUTSIDE_CONNECTIONS_FROM_NEIGHBORS" ) ) {
-        populate_connections_out_from_neighbors( neighbor_overmaps );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
-        place_rivers( neighbor_overmaps );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_LAKES" ) ) {
-        place_lakes( neighbor_overmaps );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_OCEANS" ) ) {
-        place_oceans( neighbor_overmaps );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_FORESTS" ) ) {
-        place_forests();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_SWAMPS" ) ) {
-        place_swamps();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RAVINES" ) ) {
-        place_ravines();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
-        // Polish rivers now so highways get the correct predecessors rather than river_center
-        polish_river( neighbor_overmaps );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_HIGHWAYS" ) ) {
-        highway_paths = place_highways( neighbor_overmaps );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_CITIES" ) ) {
-        place_cities();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILS" ) ) {
-        place_forest_trails();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RAILROADS_BEFORE_ROADS" ) ) {
-        if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
-            place_railroads( neighbor_overmaps );
-        }
-        if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
-            place_roads( neighbor_overmaps );
+            calculate_urbanity();
+            calculate_forestosity();
+            if( get_option<bool>( "OVERMAP_POPULATE_OUTSIDE_CONNECTIONS_FROM_NEIGHBORS" ) ) {
+                populate_connections_out_from_neighbors( neighbor_overmaps );
+            }
+            break;
         }
-    } else {
-        if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
-            place_roads( neighbor_overmaps );
+        case 1:
+            if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
+                place_rivers( neighbor_overmaps );
+            }
+            break;
+        case 2:
+            if( get_option<bool>( "OVERMAP_PLACE_LAKES" ) ) {
+                place_lakes( neighbor_overmaps );
+            }
+            break;
+        case 3:
+            if( get_option<bool>( "OVERMAP_PLACE_OCEANS" ) ) {
+                place_oceans( neighbor_overmaps );
+            }
+            break;
+        case 4:
+            if( get_option<bool>( "OVERMAP_PLACE_FORESTS" ) ) {
+                place_forests();
+            }
+            break;
+        case 5:
+            if( get_option<bool>( "OVERMAP_PLACE_SWAMPS" ) ) {
+                place_swamps();
+            }
+            if( get_option<bool>( "OVERMAP_PLACE_RAVINES" ) ) {
+                place_ravines();
+            }
+            break;
+        case 6:
+            if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
+                // Polish rivers now so highways get the correct predecessors rather than river_center
+                polish_river( neighbor_overmaps );
+            }
+            if( get_option<bool>( "OVERMAP_PLACE_HIGHWAYS" ) ) {
+                gen.highway_paths = place_highways( neighbor_overmaps );
+            }
+            break;
+        case 7:
+            if( get_option<bool>( "OVERMAP_PLACE_CITIES" ) ) {
+                place_cities();
+            }
+            if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILS" ) ) {
+                place_forest_trails();
+            }
+            break;
+        case 8:
+            if( get_option<bool>( "OVERMAP_PLACE_RAILROADS_BEFORE_ROADS" ) ) {
+                if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
+                    place_railroads( neighbor_overmaps );
+                }
+                if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
+                    place_roads( neighbor_overmaps );
+                }
+            } else {
+                if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
+                    place_roads( neighbor_overmaps );
+                }
+                if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
+                    place_railroads( neighbor_overmaps );
+                }
+            }
+            break;
+        case 9:
+            if( get_option<bool>( "OVERMAP_PLACE_SPECIALS" ) ) {
+                place_specials( gen.specials );
+            }
+            break;
+        case 10:
+            if( get_option<bool>( "OVERMAP_PLACE_HIGHWAYS" ) ) {
+                finalize_highways( gen.highway_paths );
+            }
+            if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILHEADS" ) ) {
+                place_forest_trailheads();
+            }
+            if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
+                polish_river( neighbor_overmaps ); // Polish again for placed specials
+            }
+            break;
+        case 11: {
+            // TODO: there is no reason we can't generate the sublevels in one pass
+            //       for that matter there is no reason we can't as we add the entrance ways either
+
+            // Always need at least one sublevel, but how many more
+            int z = -1;
+            bool requires_sub = false;
+            do {
+                requires_sub = generate_sub( z );
+            } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
+            break;
         }
-        if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
-            place_railroads( neighbor_overmaps );
+        case 12: {
+            // Always need at least one overlevel, but how many more
+            int z = 1;
+            bool requires_over = false;
+            do {
+                requires_over = generate_over( z );
+            } while( requires_over && ( ++z <= OVERMAP_HEIGHT ) );
+            break;
         }
+        default:
+            // Place the monsters, now that the terrain is laid out
+            place_mongroups();
+            place_radios();
+            return false;
     }
-    if( get_option<bool>( "OVERMAP_PLACE_SPECIALS" ) ) {
-        place_specials( enabled_specials );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_HIGHWAYS" ) ) {
-        finalize_highways( highway_paths );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILHEADS" ) ) {
-        place_forest_trailheads();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
-        polish_river( neighbor_overmaps ); // Polish again for placed specials
-    }
-
-    // TODO: there is no reason we can't generate the sublevels in one pass
-    //       for that matter there is no reason we can't as we add the entrance ways either
-
-    // Always need at least one sublevel, but how many more
-    int z = -1;
-    bool requires_sub = false;
-    do {
-        requires_sub = generate_sub( z );
-    } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
-
-    // Always need at least one overlevel, but how many more
-    z = 1;
-    bool requires_over = false;
-    do {
-        requires_over = generate_over( z );
-    } while( requires_over && ( ++z <= OVERMAP_HEIGHT ) );
-
-    // Place the monsters, now that the terrain is laid out
-    place_mongroups();
-    place_radios();
-    dbg( D_INFO ) << "overmap::generate done";
+    return true;
 }
 
 bool overmap::generate_sub( const int z )
@@ -4240,6 +4353,7 @@ tripoint_om_omt overmap::find_random_omt( const std::pair<std::string, ot_match_
 
 void overmap::process_mongroups()
 {
+    ensure_dynamic_loaded();
     for( auto it = zg.begin(); it != zg.end(); ) {
         mongroup &mg = it->second;
         if( mg.dying ) {
@@ -4255,6 +4369,7 @@ void overmap::process_mongroups()
 
 void overmap::clear_mon_groups()
 {
+    ensure_dynamic_loaded();
     zg.clear();
 }
 
@@ -4518,6 +4633,7 @@ void mongroup::wander( const overmap &om )
  */
 void overmap::move_hordes()
 {
+    ensure_dynamic_loaded();
     // Prevent hordes to be moved twice by putting them in here after moving.
     decltype( zg ) tmpzg;
     //MOVE ZOMBIE GROUPS
@@ -4575,15 +4691,19 @@ void overmap::move_hordes()
                 mg.abs_pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.emplace( mg.rel_pos(), mg );
-            zg.erase( it++ );
+            // Move the group from its old location to the new location, without copying its
+            // monsters.
+            decltype( zg )::node_type moved = zg.extract( it++ );
+            moved.key() = moved.mapped().rel_pos();
+            tmpzg.insert( std::move( moved ) );
         } else {
             ++it;
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    while( !tmpzg.empty() ) {
+        zg.insert( tmpzg.extract( tmpzg.begin() ) );
+    }
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
 
@@ -4646,11 +4766,12 @@ void overmap::move_hordes()
                     tripoint_abs_sm abs_pos = project_combine( pos(), p );
                     mongroup m( GROUP_ZOMBIE, abs_pos, 0 );
                     m.horde = true;
-                    m.monsters.push_back( this_monster );
+                    // The monster is deleted below, so it can be moved into its horde.
+                    m.monsters.push_back( std::move( this_monster ) );
                     m.interest = 0; // Ensures that we will select a new target.
                     add_mon_group( m );
                 } else {
-                    add_to_group->monsters.push_back( this_monster );
+                    add_to_group->monsters.push_back( std::move( this_monster ) );
                 }
             } else { // Bad luck--the zombie would have joined a larger horde, but not this one.  Skip.
                 // Don't delete the monster, just increment the iterator.
@@ -4671,6 +4792,7 @@ void overmap::move_hordes()
  */
 void overmap::move_nemesis()
 {
+    ensure_dynamic_loaded();
     // Prevent hordes to be moved twice by putting them in here after moving.
     decltype( zg ) tmpzg;
     //cycle through zombie groups, skip non-nemesis hordes
@@ -4720,9 +4842,10 @@ void overmap::move_nemesis()
             //update the horde's om_sm coords from the abs_sm so it can spawn in correctly
             if( project_to<coords::om>( mg.nemesis_target ) == omp ) {
 
-                // Erase the group at its old location, add the group with the new location
-                tmpzg.emplace( mg.rel_pos(), mg );
-                zg.erase( it++ );
+                // Move the group from its old location to the new location
+                decltype( zg )::node_type moved = zg.extract( it++ );
+                moved.key() = moved.mapped().rel_pos();
+                tmpzg.insert( std::move( moved ) );
 
                 //there is only one nemesis horde, so we can stop looping after we move it
                 break;
@@ -4738,12 +4861,15 @@ void overmap::move_nemesis()
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    while( !tmpzg.empty() ) {
+        zg.insert( tmpzg.extract( tmpzg.begin() ) );
+    }
 
 }
 
 bool overmap::remove_nemesis()
 {
+    ensure_dynamic_loaded();
     //cycle through zombie groups, find nemesis horde
     for( std::multimap<tripoint_om_sm, mongroup>::iterator it = zg.begin(); it != zg.end(); ) {
         mongroup &mg = it->second;
@@ -4764,6 +4890,7 @@ bool overmap::remove_nemesis()
 */
 void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 {
+    ensure_dynamic_loaded();
     tripoint_om_sm p( p_rel.raw() );
     tripoint_abs_sm absp = project_combine( pos(), p );
     for( auto &elem : zg ) {
@@ -4807,6 +4934,7 @@ void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 
 void overmap::signal_nemesis( const tripoint_abs_sm &p_abs_sm )
 {
+    ensure_dynamic_loaded();
     for( std::pair<const tripoint_om_sm, mongroup> &elem : zg ) {
         mongroup &mg = elem.second;
 
@@ -5047,15 +5175,18 @@ void overmap::place_forest_trailheads()
 void overmap::place_forests()
 {
     const oter_id default_oter_id( settings->default_oter[OVERMAP_DEPTH] );
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
+    // At this point in the process, we only want to consider converting the terrain into
+    // a forest if it's currently the default terrain type (e.g. a field).
+    const om_noise::om_noise_grid f( om_noise::om_noise_layer_forest( global_base_point(),
+    g->get_seed() ), 0, [&]( const point_om_omt & p ) {
+        return ter_unsafe( tripoint_om_omt( p, 0 ) ) == default_oter_id;
+    } );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             const tripoint_om_omt p( x, y, 0 );
             const oter_id &oter = ter( p );
 
-            // At this point in the process, we only want to consider converting the terrain into
-            // a forest if it's currently the default terrain type (e.g. a field).
             if( oter != default_oter_id ) {
                 continue;
             }
@@ -5088,14 +5219,13 @@ bool overmap::omt_lake_noise_threshold( const point_abs_omt &origin, const point
 bool overmap::guess_has_lake( const point_abs_om &p, const double noise_threshold,
                               int max_tile_count )
 {
-    const point_abs_omt origin = project_to<coords::omt>( p );
-    const om_noise::om_noise_layer_lake noise_func( origin, g->get_seed() );
+    const std::shared_ptr<const om_noise::om_noise_grid> noise = om_noise::lake_grid( p,
+            g->get_seed() );
 
     int lake_tiles = 0;
     for( int i = 0; i < OMAPX; i++ ) {
         for( int j = 0; j < OMAPY; j++ ) {
-            const point_om_omt seed_point( i, j );
-            if( omt_lake_noise_threshold( origin, seed_point, noise_threshold ) ) {
+            if( noise->noise_at( point_om_omt( i, j ) ) > noise_threshold ) {
                 lake_tiles++;
             }
         }
@@ -5105,12 +5235,14 @@ bool overmap::guess_has_lake( const point_abs_om &p, const double noise_threshol
 
 void overmap::place_lakes( const std::vector<const overmap *> &neighbor_overmaps )
 {
-    const point_abs_omt origin = global_base_point();
-    const om_noise::om_noise_layer_lake noise_func( origin, g->get_seed() );
+    const std::shared_ptr<const om_noise::om_noise_grid> noise = om_noise::lake_grid( pos(),
+            g->get_seed() );
     double noise_threshold = settings->overmap_lake.noise_threshold_lake;
 
+    // Same as omt_lake_noise_threshold.
     const auto is_lake = [&]( const point_om_omt & p ) {
-        return omt_lake_noise_threshold( origin, p, noise_threshold );
+        return p.x() > -5 && p.y() > -5 && p.x() < OMAPX + 5 && p.y() < OMAPY + 5 &&
+               noise->noise_at( p ) > noise_threshold;
     };
 
     const oter_id lake_surface( "lake_surface" );
@@ -5129,7 +5261,7 @@ void overmap::place_lakes( const std::vector<const overmap *> &neighbor_overmaps
             }
 
             // It's a lake if it exceeds the noise threshold defined in the region settings.
-            if( !omt_lake_noise_threshold( origin, seed_point, noise_threshold ) ) {
+            if( !is_lake( seed_point ) ) {
                 continue;
             }
 
@@ -5252,8 +5384,12 @@ void overmap::place_oceans( const std::vector<const overmap *> &neighbor_overmap
     int western_ocean = settings->overmap_ocean.ocean_start_west;
     int southern_ocean = settings->overmap_ocean.ocean_start_south;
 
-    const om_noise::om_noise_layer_ocean f( global_base_point(), g->get_seed() );
     const point_abs_om this_om = pos();
+    // Only sampled where the gradient lets there be ocean at all.
+    const om_noise::om_noise_grid f( om_noise::om_noise_layer_ocean( global_base_point(),
+    g->get_seed() ), 5, [&]( const point_om_omt & p ) {
+        return calculate_ocean_gradient( p, this_om ) != 0.0f;
+    } );
 
     const auto is_ocean = [&]( const point_om_omt & p ) {
         // credit to ehughsbaird for thinking up this inbounds solution to infinite flood fill lag.
@@ -5564,7 +5700,10 @@ void overmap::place_swamps()
     }
 
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( om_noise::om_noise_layer_floodplain( global_base_point(),
+    g->get_seed() ), 0, [&]( const point_om_omt & p ) {
+        return is_ot_match( "forest", ter_unsafe( tripoint_om_omt( p, 0 ) ), ot_match_type::contains );
+    } );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -6109,6 +6248,7 @@ spawns happen at... <cue Clue music>
 20:56 <kevingranade>: game:pawn_mon() in game.cpp:7380*/
 void overmap::place_cities()
 {
+    cata_timer timer( "overmap::place_cities" );
     int op_city_spacing = get_option<int>( "CITY_SPACING" );
     int op_city_size = get_option<int>( "CITY_SIZE" );
     int max_urbanity = get_option<int>( "OVERMAP_MAXIMUM_URBANITY" );
@@ -6899,51 +7039,34 @@ void overmap::connect_closest_points( const std::vector<point_om_omt> &points, i
     // sort from shortest to longest
     sort( edges.begin(), edges.end() );
 
-    // track which subgraph each point belongs to
-    std::vector<int> subgraphs( points.size(), -1 );
+    // the subgraph each point belongs to, as a forest of points pointing towards its root
+    std::vector<size_t> parent( points.size() );
+    std::iota( parent.begin(), parent.end(), 0 );
+    const auto root_of = [&parent]( size_t k ) {
+        while( parent[k] != k ) {
+            parent[k] = parent[parent[k]];
+            k = parent[k];
+        }
+        return k;
+    };
 
     for( const edge &candidate : edges ) {
-        const size_t i = candidate.second.first;
-        const size_t j = candidate.second.second;
+        const size_t i = root_of( candidate.second.first );
+        const size_t j = root_of( candidate.second.second );
         bool connect = false;
-        if( subgraphs[i] < 0 && subgraphs[j] < 0 ) {
-            // neither point of this connection has been connected yet
-            // identify them each as the root of a new subgraph
-            subgraphs[i] = i;
-            subgraphs[j] = j;
-            // and connect them
-            connect = true;
-        } else if( subgraphs[i] < 0 ) {
-            // j is already connected to something
-            // add i to j's subgraph
-            subgraphs[i] = subgraphs[j];
-            // and connect them
-            connect = true;
-        } else if( subgraphs[j] < 0 ) {
-            // i is already connected to something
-            // add j to i's subgraph
-            subgraphs[j] = subgraphs[i];
-            // and connect them
-            connect = true;
-        } else if( subgraphs[i] != subgraphs[j] ) {
-            // i and j are both connected to different subgraphs
-            // join the subgraphs
-            int dead_subtree = subgraphs[j];
-            for( size_t k = 0; k < points.size(); k++ ) {
-                if( subgraphs[k] == dead_subtree ) {
-                    subgraphs[k] = subgraphs[i];
-                }
-            }
-            // and connect them
+        if( i != j ) {
+            // the points are not connected yet, join their subgraphs and connect them
+            parent[j] = i;
             connect = true;
         } else if( one_in( 10 ) ) {
-            // the remaining case is that i and j are already in the same subgraph
+            // the points are already in the same subgraph
             // making this connection creates a loop
             connect = true;
         }
 
         if( connect ) {
-            build_connection( points[i], points[j], z, connection, false );
+            build_connection( points[candidate.second.first], points[candidate.second.second], z,
+                              connection, false );
         }
     }
 }
@@ -7254,6 +7377,37 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
     if( !special.id ) {
         return false;
     }
+
+    // Most candidate points are rejected by their terrain, so that goes before the checks that
+    // look beyond this overmap.
+    const std::vector<overmap_special_locations> fixed_terrains = special.required_locations();
+    const bool terrain_fits = std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
+    [&]( const overmap_special_locations & elem ) {
+        const tripoint_om_omt rp = p + om_direction::rotate( elem.p, dir );
+
+        if( !inbounds( rp, 1 ) ) {
+            return false;
+        }
+
+        if( must_be_unexplored ) {
+            // If this must be unexplored, check if we've already got a submap generated.
+            const bool existing_submap = is_omt_generated( rp );
+
+            // If there is an existing submap, this area has already been explored and this
+            // isn't a valid placement.
+            if( existing_submap ) {
+                return false;
+            }
+        }
+
+        const oter_id &tid = ter( rp );
+
+        return elem.can_be_placed_on( tid ) || ( rp.z() != 0 && tid == get_default_terrain( rp.z() ) );
+    } );
+    if( !terrain_fits ) {
+        return false;
+    }
+
     if( ( special.has_flag( "GLOBALLY_UNIQUE" ) &&
           overmap_buffer.contains_unique_special( special.id ) ) ||
         ( special.has_flag( "OVERMAP_UNIQUE" ) && contains_unique_special( special.id ) ) ) {
@@ -7286,32 +7440,7 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
             }
         }
     }
-
-    const std::vector<overmap_special_locations> fixed_terrains = special.required_locations();
-
-    return std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
-    [&]( const overmap_special_locations & elem ) {
-        const tripoint_om_omt rp = p + om_direction::rotate( elem.p, dir );
-
-        if( !inbounds( rp, 1 ) ) {
-            return false;
-        }
-
-        if( must_be_unexplored ) {
-            // If this must be unexplored, check if we've already got a submap generated.
-            const bool existing_submap = is_omt_generated( rp );
-
-            // If there is an existing submap, this area has already been explored and this
-            // isn't a valid placement.
-            if( existing_submap ) {
-                return false;
-            }
-        }
-
-        const oter_id &tid = ter( rp );
-
-        return elem.can_be_placed_on( tid ) || ( rp.z() != 0 && tid == get_default_terrain( rp.z() ) );
-    } );
+    return true;
 }
 
 // checks around the selected point to see if the special can be placed there
@@ -7319,6 +7448,7 @@ std::vector<tripoint_om_omt> overmap::place_special(
     const overmap_special &special, const tripoint_om_omt &p, om_direction::type dir,
     const city &cit, const bool must_be_unexplored, const bool force )
 {
+    ensure_dynamic_loaded();
     cata_assert( dir != om_direction::type::invalid );
     if( !force ) {
         cata_assert( can_place_special( special, p, dir, must_be_unexplored ) );
@@ -7470,6 +7600,7 @@ void overmap::place_specials_pass(
 // and when a special reaches max instances it is also removed.
 void overmap::place_specials( overmap_special_batch &enabled_specials )
 {
+    cata_timer timer( "overmap::place_specials" );
     // Calculate if this overmap has any lake terrain--if it doesn't, we should just
     // completely skip placing any lake specials here since they'll never place and if
     // they're mandatory they just end up causing us to spiral out into adjacent overmaps
@@ -7899,6 +8030,13 @@ void overmap::place_radios()
 }
 
 void overmap::open( overmap_special_batch &enabled_specials )
+{
+    if( !open_saved() ) {
+        generate( existing_neighbors(), enabled_specials );
+    }
+}
+
+bool overmap::open_saved()
 {
     if( world_generator->active_world->has_compression_enabled() ) {
         assure_dir_exist( PATH_INFO::world_base_save_path() / "overmaps" );
@@ -7906,84 +8044,224 @@ void overmap::open( overmap_special_batch &enabled_specials )
         const std::filesystem::path terfilename_path = std::filesystem::u8path( terfilename );
         const cata_path zzip_path = PATH_INFO::world_base_save_path() / "overmaps" / terfilename_path +
                                     ".zzip";
+        get_save_writer().wait_for( zzip_path.generic_u8string() );
+        get_save_writer().wait_for( overmapbuffer::player_filename( loc ).generic_u8string() );
         if( file_exist( zzip_path ) ) {
             std::shared_ptr<zzip> z = zzip::load( zzip_path.get_unrelative_path(),
-                                                  ( PATH_INFO::world_base_save_path() / "overmaps.dict" ).get_unrelative_path()
+                                                  compression_dictionary::current( compression_kind::overmaps )
                                                 );
 
-            if( read_from_zzip_optional( z, terfilename_path, [this]( std::string_view sv ) {
-            std::istringstream is{ std::string( sv ) };
+            if( read_from_zzip_stream_optional( z, terfilename_path, [this]( std::istream & is ) {
             unserialize( is );
             } ) ) {
+                // Older saves keep everything in the terrain entry.
+                read_from_zzip_stream_optional( z, std::filesystem::u8path( overmapbuffer::dynamic_filename(
+                loc ) ), [this]( std::istream & is ) {
+                    pending_dynamic.emplace( std::istreambuf_iterator<char>( is ),
+                                             std::istreambuf_iterator<char>() );
+                } );
                 const cata_path plrfilename = overmapbuffer::player_filename( loc );
                 read_from_file_optional( plrfilename, [this, &plrfilename]( std::istream & is ) {
                     unserialize_view( plrfilename, is );
                 } );
-                return;
+                return true;
             }
         }
     } else {
         const cata_path terfilename = PATH_INFO::world_base_save_path() / overmapbuffer::terrain_filename(
                                           loc );
+        const cata_path dynfilename = PATH_INFO::world_base_save_path() /
+                                      overmapbuffer::dynamic_filename( loc );
+        get_save_writer().wait_for( terfilename.generic_u8string() );
+        get_save_writer().wait_for( dynfilename.generic_u8string() );
+        get_save_writer().wait_for( overmapbuffer::player_filename( loc ).generic_u8string() );
 
         if( read_from_file_optional( terfilename, [this, &terfilename]( std::istream & is ) {
         unserialize( terfilename, is );
         } ) ) {
+            // Older saves keep everything in the terrain file.
+            read_from_file_optional( dynfilename, [this]( std::istream & is ) {
+                pending_dynamic.emplace( std::istreambuf_iterator<char>( is ),
+                                         std::istreambuf_iterator<char>() );
+            } );
             const cata_path plrfilename = overmapbuffer::player_filename( loc );
             read_from_file_optional( plrfilename, [this, &plrfilename]( std::istream & is ) {
                 unserialize_view( plrfilename, is );
             } );
-            return;
+            return true;
         }
     }
 
+    return false;
+}
+
+std::vector<const overmap *> overmap::existing_neighbors() const
+{
     // pointers looks like (north, south, west, east)
     std::vector<const overmap *> neighbors;
     neighbors.reserve( four_adjacent_offsets.size() );
     for( const point &adjacent : four_adjacent_offsets ) {
         neighbors.emplace_back( overmap_buffer.get_existing( loc + adjacent ) );
     }
-    generate( neighbors, enabled_specials );
+    return neighbors;
 }
 
-// Note: this may throw io errors from std::ofstream
-void overmap::save() const
+// Record the hash of data as the last saved one for a file.  Returns false if it was already
+// the last saved one, so the write can be skipped.
+void overmap::forget_saved_hashes()
 {
-    write_to_file( overmapbuffer::player_filename( loc ), [&]( std::ostream & stream ) {
-        serialize_view( stream );
-    } );
+    // Writes in flight keep the old ones.
+    last_saved = std::make_shared<saved_hashes>();
+}
+
+std::array<uint64_t, 3> overmap::saved_hash_values() const
+{
+    return { last_saved->view.load(), last_saved->terrain.load(), last_saved->dynamic.load() };
+}
+
+void overmap::set_saved_hash_values( const std::array<uint64_t, 3> &hashes )
+{
+    last_saved->view = hashes[0];
+    last_saved->terrain = hashes[1];
+    last_saved->dynamic = hashes[2];
+}
+
+static bool update_saved_hash( std::atomic<uint64_t> &saved, const std::string &data )
+{
+    // Never 0, which stands for not saved yet.
+    const uint64_t hash = std::hash<std::string>()( data ) | 1;
+    return saved.exchange( hash ) != hash;
+}
+
+// Run a queued write, forgetting the saved hash if it fails so the next save tries again.
+static void write_or_forget_hash( std::atomic<uint64_t> &saved, const std::function<void()> &write )
+{
+    try {
+        write();
+    } catch( ... ) {
+        saved = 0;
+        throw;
+    }
+}
+
+// Note: this may throw io errors from std::ofstream
+void overmap::save()
+{
+    // Serialized here, written by the save writer while the game goes on.  Most autosaves only
+    // change the view and the dynamic part, so whatever serializes the same as last time is
+    // not written again.
+    std::stringstream view;
+    serialize_view( view );
+    std::string view_data = view.str();
+    if( update_saved_hash( last_saved->view, view_data ) ) {
+        const cata_path plrfilename( overmapbuffer::player_filename( loc ) );
+        get_save_writer().enqueue( plrfilename.generic_u8string(), _( "overmap" ),
+        [plrfilename, hashes = last_saved, data = std::move( view_data )]() {
+            write_or_forget_hash( hashes->view, [&]() {
+                write_to_file( plrfilename, [&]( std::ostream & stream ) {
+                    stream << data;
+                } );
+            } );
+        } );
+    }
 
+    std::stringstream terrain;
+    serialize_static( terrain );
+    std::string terrain_data = terrain.str();
+    const bool terrain_changed = update_saved_hash( last_saved->terrain, terrain_data );
+    // Nothing can have changed a dynamic part that was never parsed.
+    std::string dynamic_data;
+    bool dynamic_changed = false;
+    if( !pending_dynamic ) {
+        std::stringstream dynamic;
+        serialize_dynamic( dynamic );
+        dynamic_data = dynamic.str();
+        dynamic_changed = update_saved_hash( last_saved->dynamic, dynamic_data );
+    }
+    if( !terrain_changed && !dynamic_changed ) {
+        return;
+    }
     if( world_generator->active_world->has_compression_enabled() ) {
         const std::string terfilename = overmapbuffer::terrain_filename( loc );
         const std::filesystem::path terfilename_path = std::filesystem::u8path( terfilename );
+        const std::filesystem::path dynfilename_path = std::filesystem::u8path(
+                    overmapbuffer::dynamic_filename( loc ) );
         const cata_path overmaps_folder = PATH_INFO::world_base_save_path() / "overmaps";
         assure_dir_exist( overmaps_folder );
         const cata_path zzip_path = overmaps_folder / terfilename_path + ".zzip";
-        std::shared_ptr<zzip> z = zzip::load( zzip_path.get_unrelative_path(),
-                                              ( PATH_INFO::world_base_save_path() / "overmaps.dict" ).get_unrelative_path()
-                                            );
-        if( !z ) {
-            throw std::runtime_error(
-                string_format(
-                    "Failed to open %s",
-                    zzip_path.get_unrelative_path().generic_u8string().c_str()
-                )
-            );
+        const std::filesystem::path dict_path = compression_dictionary::current(
+                    compression_kind::overmaps );
+        if( terrain_changed ) {
+            compression_dictionary::add_sample( compression_kind::overmaps, terrain_data );
+        } else {
+            terrain_data.clear();
         }
+        if( dynamic_changed ) {
+            compression_dictionary::add_sample( compression_kind::overmaps, dynamic_data );
+        } else {
+            dynamic_data.clear();
+        }
+        get_save_writer().enqueue( zzip_path.generic_u8string(), _( "overmap" ),
+                                   [zzip_path, dict_path, terfilename_path, dynfilename_path, om = loc,
+                                                hashes = last_saved, terrain_changed, dynamic_changed,
+                                                terrain_data = std::move( terrain_data ),
+                                   dynamic_data = std::move( dynamic_data )]() {
+            try {
+                std::shared_ptr<zzip> z = zzip::load( zzip_path.get_unrelative_path(), dict_path );
+                if( !z ) {
+                    throw std::runtime_error(
+                        string_format(
+                            "Failed to open %s",
+                            zzip_path.get_unrelative_path().generic_u8string().c_str()
+                        )
+                    );
+                }
 
-        std::stringstream s;
-        serialize( s );
-
-        if( !z->add_file( terfilename_path, s.str() ) ) {
-            throw std::runtime_error( string_format( "Failed to save omap %d.%d to %s", loc.x(),
-                                      loc.y(), zzip_path.get_unrelative_path().generic_u8string().c_str() ) );
-        }
-        z->compact( 2.0 );
-    } else {
-        write_to_file( PATH_INFO::world_base_save_path() / overmapbuffer::terrain_filename( loc ), [&](
-        std::ostream & stream ) {
-            serialize( stream );
+                // Both entries go in with one footer, so the zzip never holds the new
+                // terrain with the old dynamic part or the other way around.
+                std::vector<std::pair<std::filesystem::path, std::string_view>> entries;
+                if( terrain_changed ) {
+                    entries.emplace_back( terfilename_path, terrain_data );
+                }
+                if( dynamic_changed ) {
+                    entries.emplace_back( dynfilename_path, dynamic_data );
+                }
+                if( !z->add_files( entries ) ) {
+                    throw std::runtime_error( string_format( "Failed to save omap %d.%d to %s", om.x(),
+                                              om.y(), zzip_path.get_unrelative_path().generic_u8string().c_str() ) );
+                }
+                z->compact( 2.0 );
+            } catch( ... ) {
+                hashes->terrain = 0;
+                hashes->dynamic = 0;
+                throw;
+            }
         } );
+    } else {
+        if( terrain_changed ) {
+            const cata_path terfilename = PATH_INFO::world_base_save_path() /
+                                          overmapbuffer::terrain_filename( loc );
+            get_save_writer().enqueue( terfilename.generic_u8string(), _( "overmap" ),
+            [terfilename, hashes = last_saved, data = std::move( terrain_data )]() {
+                write_or_forget_hash( hashes->terrain, [&]() {
+                    write_to_file( terfilename, [&]( std::ostream & stream ) {
+                        stream << data;
+                    } );
+                } );
+            } );
+        }
+        if( dynamic_changed ) {
+            const cata_path dynfilename = PATH_INFO::world_base_save_path() /
+                                          overmapbuffer::dynamic_filename( loc );
+            get_save_writer().enqueue( dynfilename.generic_u8string(), _( "overmap" ),
+            [dynfilename, hashes = last_saved, data = std::move( dynamic_data )]() {
+                write_or_forget_hash( hashes->dynamic, [&]() {
+                    write_to_file( dynfilename, [&]( std::ostream & stream ) {
+                        stream << data;
+                    } );
+                } );
+            } );
+        }
     }
 }
 
@@ -8004,6 +8282,7 @@ void overmap::debug_force_add_group( const mongroup &group )
 std::vector<std::reference_wrapper<mongroup>> overmap::debug_unsafe_get_groups_at(
             tripoint_abs_omt &loc )
 {
+    ensure_dynamic_loaded();
     point_abs_om overmap;
     tripoint_om_omt omt_within_overmap;
     std::tie( overmap, omt_within_overmap ) = project_remain<coords::om>( loc );
@@ -8020,6 +8299,7 @@ std::vector<std::reference_wrapper<mongroup>> overmap::debug_unsafe_get_groups_a
 
 void overmap::add_mon_group( const mongroup &group )
 {
+    ensure_dynamic_loaded();
     zg.emplace( group.rel_pos(), group );
 }
 
@@ -8081,8 +8361,22 @@ void overmap::add_mon_group( const mongroup &group, int radius )
     }
 }
 
+void overmap::ensure_dynamic_loaded() const
+{
+    if( !pending_dynamic ) {
+        return;
+    }
+    // Parsing only brings in what was on disk all along, so this is const to callers.
+    overmap &self = const_cast<overmap &>( *this );
+    std::istringstream is( *self.pending_dynamic );
+    self.pending_dynamic.reset();
+    self.unserialize_dynamic( is );
+    overmap_buffer.fix_loaded_dynamic( self );
+}
+
 shared_ptr_fast<npc> overmap::find_npc( const character_id &id ) const
 {
+    ensure_dynamic_loaded();
     for( const auto &guy : npcs ) {
         if( guy->getID() == id ) {
             return guy;
@@ -8093,6 +8387,7 @@ shared_ptr_fast<npc> overmap::find_npc( const character_id &id ) const
 
 shared_ptr_fast<npc> overmap::find_npc_by_unique_id( const std::string &id ) const
 {
+    ensure_dynamic_loaded();
     for( const auto &guy : npcs ) {
         if( guy->get_unique_id() == id ) {
             return guy;
@@ -8103,6 +8398,7 @@ shared_ptr_fast<npc> overmap::find_npc_by_unique_id( const std::string &id ) con
 
 std::optional<basecamp *> overmap::find_camp( const point_abs_omt &p )
 {
+    ensure_dynamic_loaded();
     for( basecamp &v : camps ) {
         if( v.camp_omt_pos().xy() == p ) {
             return &v;
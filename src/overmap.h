@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <climits>
 #include <cstdlib>
@@ -12,6 +13,7 @@
 #include <iosfwd>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -51,6 +53,7 @@ class cata_path;
 class character_id;
 class npc;
 class overmap_connection;
+struct overmap_road_graph;
 struct regional_settings;
 template <typename T> struct enum_traits;
 
@@ -130,6 +133,10 @@ struct map_layer {
     cata::mdarray<bool, point_om_omt> explored;
     std::vector<om_note> notes;
     std::vector<om_map_extra> extras;
+    // Whether uniform_terrain is up to date, cleared when the terrain is written to.
+    mutable bool uniform_terrain_known = false;
+    // The terrain of every tile of the layer, if they all share one.
+    mutable std::optional<oter_id> uniform_terrain;
 };
 
 struct om_special_sectors {
@@ -309,6 +316,28 @@ class overmap
         void populate( overmap_special_batch &enabled_specials );
         void populate();
 
+        /** What is left to do of an overmap generated one stage at a time. */
+        struct generation {
+            explicit generation( const overmap_special_batch &specials ) : specials( specials ) {}
+            // North, south, west and east, see existing_neighbors.
+            std::vector<const overmap *> neighbors;
+            overmap_special_batch specials;
+            std::vector<Highway_path> highway_paths;
+            int stage = 0;
+        };
+        /**
+         * Same as populate, except that if the overmap was not saved before, generating it is
+         * left to generate_step.  Returns nullptr if there is nothing left to do.
+         */
+        std::unique_ptr<generation> start_populating();
+        /**
+         * Run the next stage of generation with the neighbours in gen.  Returns false once the
+         * overmap is complete.
+         */
+        bool generate_step( generation &gen );
+        // The neighbours that exist now, as generation takes them.
+        std::vector<const overmap *> existing_neighbors() const;
+
         const point_abs_om &pos() const {
             return loc;
         }
@@ -322,7 +351,16 @@ class overmap
         //TODO: extend pre-determined lake generation so we know instead of guess
         static bool guess_has_lake( const point_abs_om &p, double noise_threshold, int tile_count );
 
-        void save() const;
+        /**
+         * Queue the overmap's files on the save writer.  Parts whose serialized form did not
+         * change since they were last written are skipped.
+         */
+        void save();
+        // Forget what was last written, so the next save writes every part again.
+        void forget_saved_hashes();
+        // What save() last queued for the view, the terrain and the dynamic part, 0 if unknown.
+        std::array<uint64_t, 3> saved_hash_values() const;
+        void set_saved_hash_values( const std::array<uint64_t, 3> &hashes );
 
         /**
          * @return The (local) overmap terrain coordinates of a randomly
@@ -349,6 +387,11 @@ class overmap
         const oter_id &ter( const tripoint_om_omt &p ) const;
         // ter_unsafe is UB when out of bounds.
         const oter_id &ter_unsafe( const tripoint_om_omt &p ) const;
+        // The terrain of every tile of the z-level if they all share one, like the solid rock
+        // and open air of most levels. Worked out on first use after the terrain last changed.
+        std::optional<oter_id> uniform_terrain( int z ) const;
+        // The roads of this overmap, built on first use after their terrain last changed.
+        const overmap_road_graph &road_graph() const;
         std::optional<mapgen_arguments> *mapgen_args( const tripoint_om_omt & );
         std::string *join_used_at( const om_pos_dir & );
         std::vector<oter_id> predecessors( const tripoint_om_omt & );
@@ -467,12 +510,20 @@ class overmap
         shared_ptr_fast<npc> find_npc( const character_id &id ) const;
         shared_ptr_fast<npc> find_npc_by_unique_id( const std::string &id ) const;
         const std::vector<shared_ptr_fast<npc>> &get_npcs() const {
+            ensure_dynamic_loaded();
             return npcs;
         }
         std::vector<shared_ptr_fast<npc>> get_npcs( const std::function<bool( const npc & )>
                                        &predicate )
                                        const;
         point_om_omt get_fallback_road_connection_point() const;
+        /**
+         * The monsters, npcs, camps, tracked vehicles and scents of a loaded overmap are only
+         * parsed when something first needs them, so finding a terrain across many overmaps
+         * does not pay for all of their npcs.  Whatever touches those members from outside
+         * the overmap must call this first.
+         */
+        void ensure_dynamic_loaded() const;
     private:
         friend class overmapbuffer;
 
@@ -498,6 +549,20 @@ class overmap
         // Records location where mongroups are not allowed to spawn during worldgen.
         // Reconstructed on load, so need not be serialized.
         std::unordered_set<tripoint_om_omt> safe_at_worldgen; // NOLINT(cata-serialize)
+        // Derived from the terrain, and dropped when ter_set changes any road.
+        mutable std::shared_ptr<const overmap_road_graph> road_graph_cache; // NOLINT(cata-serialize)
+
+        // Hashes of what save() last queued for each file, 0 if unknown.  Shared with the
+        // queued writes so a failed write can clear its hash and be retried by the next save.
+        struct saved_hashes {
+            std::atomic<uint64_t> view{ 0 };
+            std::atomic<uint64_t> terrain{ 0 };
+            std::atomic<uint64_t> dynamic{ 0 };
+        };
+        std::shared_ptr<saved_hashes> last_saved = // NOLINT(cata-serialize)
+            std::make_shared<saved_hashes>();
+        // The dynamic part as read from disk, until ensure_dynamic_loaded parses it.
+        std::optional<std::string> pending_dynamic; // NOLINT(cata-serialize)
 
         // For oter_ts with the requires_predecessor flag, we need to store the
         // predecessor terrains so they can be used for mapgen later
@@ -523,6 +588,10 @@ class overmap
         void init_layers();
         // open existing overmap, or generate a new one
         void open( overmap_special_batch &enabled_specials );
+        // open existing overmap, returns false if it was not saved
+        bool open_saved();
+        // The specials of the default batch the region's settings allow.
+        overmap_special_batch enabled_default_specials() const;
     public:
         // Get all values from omt_stack_arguments_map at the given point or nullopt if not set yet
         std::optional<mapgen_arguments> get_existing_omt_stack_arguments(
@@ -550,8 +619,14 @@ class overmap
         // Parse per-player overmap view data.
         void unserialize_view( const cata_path &file_name, std::istream &fin );
         void unserialize_view( const JsonObject &jsobj );
+        // Parse the monsters, npcs, camps and other state kept apart from the terrain.
+        void unserialize_dynamic( std::istream &fin );
         // Save data in an opened overmap file
         void serialize( std::ostream &fout ) const;
+        // Save only the terrain and other data that changes rarely after generation.
+        void serialize_static( std::ostream &fout ) const;
+        // Save only the monsters, npcs, camps and other state that changes during play.
+        void serialize_dynamic( std::ostream &fout ) const;
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fout ) const;
     private:
@@ -795,6 +870,9 @@ class overmap
         void load_monster_groups( const JsonArray &jsin );
         void load_legacy_monstergroups( const JsonArray &jsin );
         void save_monster_groups( JsonOut &jo ) const;
+        // Write the members of serialize_static / serialize_dynamic into an open object.
+        void serialize_static_members( JsonOut &json, std::ostream &fout ) const;
+        void serialize_dynamic_members( JsonOut &json, std::ostream &fout ) const;
     public:
         static void load_oter_id_camp_migration( const JsonObject &jo );
         static void load_oter_id_migration( const JsonObject &jo );
@@ -866,6 +944,9 @@ struct oter_display_options {
 
     // Internal bookkeeping value - only draw edge mission indicator once
     mutable bool drawn_mission = false;
+    // Line from center to mission_target for the edge mission indicator, worked out on first
+    // use by oter_symbol_and_color
+    mutable std::optional<std::vector<point_abs_omt>> mission_line;
 };
 
 // arguments for oter_symbol_and_color pertaining to a single point
@@ -64,18 +64,15 @@ void overmap_connection::subtype::deserialize( const JsonObject &jo )
     load( jo );
 }
 
-const overmap_connection::subtype *overmap_connection::pick_subtype_for(
+const overmap_connection::cache &overmap_connection::cached_for(
     const int_id<oter_t> &ground ) const
 {
-    if( !ground ) {
-        return nullptr;
-    }
-
     const size_t cache_index = ground.to_i();
     cata_assert( cache_index < cached_subtypes.size() );
 
-    if( cached_subtypes[cache_index] ) {
-        return cached_subtypes[cache_index].value;
+    cache &cached = cached_subtypes[cache_index];
+    if( cached ) {
+        return cached;
     }
 
     const auto iter = std::find_if( subtypes.cbegin(),
@@ -83,19 +80,29 @@ const overmap_connection::subtype *overmap_connection::pick_subtype_for(
         return elem.allows_terrain( ground );
     } );
 
-    const overmap_connection::subtype *result = iter != subtypes.cend() ? &*iter : nullptr;
+    cached.value = iter != subtypes.cend() ? &*iter : nullptr;
+    cached.own_terrain = std::any_of( subtypes.cbegin(), subtypes.cend(),
+    [&ground]( const subtype & elem ) {
+        return ground->type_is( elem.terrain );
+    } );
+    cached.assigned = true;
 
-    cached_subtypes[cache_index].value = result;
-    cached_subtypes[cache_index].assigned = true;
+    return cached;
+}
 
-    return result;
+const overmap_connection::subtype *overmap_connection::pick_subtype_for(
+    const int_id<oter_t> &ground ) const
+{
+    if( !ground ) {
+        return nullptr;
+    }
+    return cached_for( ground ).value;
 }
 
 bool overmap_connection::has( const int_id<oter_t> &oter ) const
 {
-    return std::find_if( subtypes.cbegin(), subtypes.cend(), [&oter]( const subtype & elem ) {
-        return oter->type_is( elem.terrain );
-    } ) != subtypes.cend();
+    // Pathfinding asks this for every node it scores, so it is cached with the subtype.
+    return cached_for( oter ).own_terrain;
 }
 
 void overmap_connection::load( const JsonObject &jo, std::string_view )
@@ -64,12 +64,16 @@ class overmap_connection
     private:
         struct cache {
             const subtype *value = nullptr;
+            // Whether the terrain is one this connection builds, see has.
+            bool own_terrain = false;
             bool assigned = false;
             explicit operator bool() const {
                 return assigned;
             }
         };
 
+        const cache &cached_for( const int_id<oter_t> &ground ) const;
+
         std::list<subtype> subtypes;
         mutable std::vector<cache> cached_subtypes;
 };
@@ -32,6 +32,10 @@ const overmap_location &string_id<overmap_location>::obj() const
 
 bool overmap_location::test( const int_id<oter_t> &oter ) const
 {
+    const size_t index = oter.to_i();
+    if( index < oter_matches.size() ) {
+        return oter_matches[index];
+    }
     return terrains.count( oter->get_type_id() );
 }
 
@@ -79,6 +83,12 @@ void overmap_location::finalize()
             }
         }
     }
+    // Placing overmap specials tests locations for every candidate point.
+    const std::vector<oter_t> &all_oters = overmap_terrains::get_all();
+    oter_matches.assign( all_oters.size(), false );
+    for( size_t i = 0; i < all_oters.size(); ++i ) {
+        oter_matches[i] = terrains.count( all_oters[i].get_type_id() ) > 0;
+    }
 }
 
 void overmap_locations::load( const JsonObject &jo, const std::string &src )
@@ -34,6 +34,8 @@ struct overmap_location {
     private:
         TerrColType terrains;
         std::vector<std::string> flags;
+        // Whether each overmap terrain, by its int id, meets the restrictions.  Made by finalize.
+        std::vector<bool> oter_matches;
 };
 
 namespace overmap_locations
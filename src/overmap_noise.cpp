@@ -1,12 +1,29 @@
 #include <cmath>
 #include <algorithm>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
 
+#include "cata_thread_pool.h"
 #include "overmap_noise.h"
 #include "simplexnoise.h"
 
 namespace om_noise
 {
 
+// Lake grids kept for lake_grid.
+static constexpr size_t kept_lake_grids = 16;
+// Margin of lake grids, the flood fill of place_lakes stops 5 tiles outside of the overmap.
+static constexpr int lake_grid_margin = 5;
+
+void om_noise_layer::noise_row( const point_om_omt &omt_local, const int count, float *out ) const
+{
+    for( int i = 0; i < count; ++i ) {
+        out[i] = noise_at( omt_local + point( i, 0 ) );
+    }
+}
+
 float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -19,6 +36,18 @@ float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
     return std::max( 0.0f, r - d * 0.5f );
 }
 
+void om_noise_layer_forest::noise_row( const point_om_omt &local_omt_pos, const int count,
+                                       float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( local_omt_pos );
+    std::vector<float> d( count );
+    scaled_octave_noise_3d_row( 4, 0.5, 0.03, 0, 1, p.x(), p.y(), get_seed(), count, out );
+    scaled_octave_noise_3d_row( 6, 0.5, 0.07, 0, 1, p.x(), p.y(), get_seed(), count, d.data() );
+    for( int i = 0; i < count; ++i ) {
+        out[i] = std::max( 0.0f, std::pow( out[i], 2.0f ) - std::pow( d[i], 3.0f ) * 0.5f );
+    }
+}
+
 float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -27,6 +56,16 @@ float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) c
     return r;
 }
 
+void om_noise_layer_floodplain::noise_row( const point_om_omt &local_omt_pos, const int count,
+        float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( local_omt_pos );
+    scaled_octave_noise_3d_row( 4, 0.5, 0.05, 0, 1, p.x(), p.y(), get_seed(), count, out );
+    for( int i = 0; i < count; ++i ) {
+        out[i] = std::pow( out[i], 2.0f );
+    }
+}
+
 float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -35,6 +74,16 @@ float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+void om_noise_layer_lake::noise_row( const point_om_omt &local_omt_pos, const int count,
+                                     float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( local_omt_pos );
+    scaled_octave_noise_3d_row( 8, 0.5, 0.002, 0, 1, p.x(), p.y(), get_seed(), count, out );
+    for( int i = 0; i < count; ++i ) {
+        out[i] = std::pow( out[i], 4.0f );
+    }
+}
+
 float om_noise_layer_ocean::noise_at( const point_om_omt &local_omt_pos ) const
 {
     // this is a duplicate of lake noise.  Changing it might cause artifacts if oceans
@@ -45,4 +94,59 @@ float om_noise_layer_ocean::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+void om_noise_layer_ocean::noise_row( const point_om_omt &local_omt_pos, const int count,
+                                      float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( local_omt_pos );
+    scaled_octave_noise_3d_row( 8, 0.5, 0.002, 0, 1, p.x(), p.y(), get_seed(), count, out );
+    for( int i = 0; i < count; ++i ) {
+        out[i] = std::pow( out[i], 4.0f );
+    }
+}
+
+om_noise_grid::om_noise_grid( const om_noise_layer &layer, const int margin,
+                              const std::function<bool( const point_om_omt & )> &wanted )
+    : margin( margin ), width( OMAPX + 2 * margin ),
+      values( static_cast<size_t>( width ) * ( OMAPY + 2 * margin ), 0.0f )
+{
+    // A row per task, each writes its own part of values.
+    cata::get_thread_pool().parallel_for( -margin, OMAPY + margin, [&]( const int y ) {
+        float *row = &values[static_cast<size_t>( y + margin ) * width];
+        if( !wanted ) {
+            layer.noise_row( point_om_omt( -margin, y ), width, row );
+            return;
+        }
+        for( int x = -margin; x < OMAPX + margin; ++x ) {
+            const point_om_omt p( x, y );
+            if( wanted( p ) ) {
+                row[x + margin] = layer.noise_at( p );
+            }
+        }
+    } );
+}
+
+std::shared_ptr<const om_noise_grid> lake_grid( const point_abs_om &om, const unsigned seed )
+{
+    using key = std::pair<point_abs_om, unsigned>;
+    static std::mutex kept_mutex;
+    static std::deque<std::pair<key, std::shared_ptr<const om_noise_grid>>> kept;
+    const key k( om, seed );
+    {
+        std::lock_guard<std::mutex> lk( kept_mutex );
+        for( const std::pair<key, std::shared_ptr<const om_noise_grid>> &entry : kept ) {
+            if( entry.first == k ) {
+                return entry.second;
+            }
+        }
+    }
+    std::shared_ptr<const om_noise_grid> grid = std::make_shared<om_noise_grid>(
+                om_noise_layer_lake( project_to<coords::omt>( om ), seed ), lake_grid_margin );
+    std::lock_guard<std::mutex> lk( kept_mutex );
+    kept.emplace_back( k, grid );
+    if( kept.size() > kept_lake_grids ) {
+        kept.pop_front();
+    }
+    return grid;
+}
+
 } // namespace om_noise
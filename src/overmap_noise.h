@@ -2,8 +2,13 @@
 #ifndef CATA_SRC_OVERMAP_NOISE_H
 #define CATA_SRC_OVERMAP_NOISE_H
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
+#include "map_scale_constants.h"
 #include "point.h"
 
 namespace om_noise
@@ -21,6 +26,11 @@ class om_noise_layer
          * @param omt_local point location in overmap terrain local coordinates.
          */
         virtual float noise_at( const point_om_omt &omt_local ) const = 0;
+        /**
+         * noise_at of count points, from omt_local eastwards, into out.  Much cheaper per
+         * point than noise_at.
+         */
+        virtual void noise_row( const point_om_omt &omt_local, int count, float *out ) const;
         virtual ~om_noise_layer() = default;
     protected:
         /**
@@ -56,6 +66,7 @@ class om_noise_layer_forest : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_row( const point_om_omt &local_omt_pos, int count, float *out ) const override;
 };
 
 class om_noise_layer_floodplain : public om_noise_layer
@@ -66,6 +77,7 @@ class om_noise_layer_floodplain : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_row( const point_om_omt &local_omt_pos, int count, float *out ) const override;
 };
 
 class om_noise_layer_lake : public om_noise_layer
@@ -76,6 +88,7 @@ class om_noise_layer_lake : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_row( const point_om_omt &local_omt_pos, int count, float *out ) const override;
 };
 
 
@@ -87,8 +100,47 @@ class om_noise_layer_ocean : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_row( const point_om_omt &local_omt_pos, int count, float *out ) const override;
 };
 
+/**
+ * A noise layer sampled ahead for the overmap terrains of an overmap and those up to margin
+ * outside of it, on the thread pool.  Sampling is the bulk of the noise driven stages of
+ * generation, and the samples don't depend on each other or on the order they are taken in.
+ */
+class om_noise_grid
+{
+    public:
+        /**
+         * @param wanted Only where this holds is the layer sampled, elsewhere the grid holds 0.
+         * It is called from several threads at once.
+         */
+        om_noise_grid( const om_noise_layer &layer, int margin,
+                       const std::function<bool( const point_om_omt & )> &wanted = nullptr );
+
+        // Whether p is covered by the grid.
+        bool contains( const point_om_omt &p ) const {
+            return p.x() >= -margin && p.y() >= -margin && p.x() < OMAPX + margin &&
+                   p.y() < OMAPY + margin;
+        }
+        // The noise of the layer at p, which the grid must contain.
+        float noise_at( const point_om_omt &p ) const {
+            return values[( p.y() + margin ) * width + p.x() + margin];
+        }
+
+    private:
+        int margin;
+        int width;
+        std::vector<float> values;
+};
+
+/**
+ * The grid of the lake layer of the overmap at om, with the margin the flood fill of
+ * overmap::place_lakes can reach.  The last few grids are kept, since the highways of an
+ * overmap look for lakes in the overmaps next to it, which later generate with the same grid.
+ */
+std::shared_ptr<const om_noise_grid> lake_grid( const point_abs_om &om, unsigned seed );
+
 } // namespace om_noise
 
 #endif // CATA_SRC_OVERMAP_NOISE_H
@@ -0,0 +1,100 @@
+#include "overmap_road_graph.h"
+
+#include <array>
+
+#include "map_scale_constants.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "point.h"
+
+static const oter_type_str_id oter_type_bridgehead_ground( "bridgehead_ground" );
+static const oter_type_str_id oter_type_bridgehead_ramp( "bridgehead_ramp" );
+
+static constexpr std::array<direction, 4> horizontal_dirs = {
+    direction::NORTH, direction::EAST, direction::SOUTH, direction::WEST
+};
+
+bool overmap_road_graph::is_road( const oter_id &oter )
+{
+    const oter_travel_cost_type type = oter->get_travel_cost_type();
+    return type == oter_travel_cost_type::highway || type == oter_travel_cost_type::road;
+}
+
+bool overmap_road_graph::is_ramp( const oter_id &oter )
+{
+    return oter->get_type_id() == oter_type_bridgehead_ground ||
+           oter->get_type_id() == oter_type_bridgehead_ramp;
+}
+
+overmap_road_graph overmap_road_graph::build( const overmap &om )
+{
+    overmap_road_graph graph;
+    const auto road_at = [&om]( const tripoint_om_omt & p ) {
+        return overmap::inbounds( p ) && is_road( om.ter_unsafe( p ) );
+    };
+    const auto is_junction = [&]( const tripoint_om_omt & p ) {
+        if( p.x() == 0 || p.y() == 0 || p.x() == OMAPX - 1 || p.y() == OMAPY - 1 ||
+            is_ramp( om.ter_unsafe( p ) ) ) {
+            return true;
+        }
+        int neighbours = 0;
+        for( direction dir : horizontal_dirs ) {
+            if( road_at( p + displace( dir ) ) ) {
+                ++neighbours;
+            }
+        }
+        return neighbours != 2;
+    };
+
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                const tripoint_om_omt p( x, y, z );
+                if( !is_road( om.ter_unsafe( p ) ) || !is_junction( p ) ) {
+                    continue;
+                }
+                std::vector<link> &links = graph.junctions[p];
+                for( direction dir : horizontal_dirs ) {
+                    const tripoint_om_omt first = p + displace( dir );
+                    if( !overmap::inbounds( first ) ) {
+                        links.push_back( link{ dir, { first } } );
+                        continue;
+                    }
+                    if( !road_at( first ) ) {
+                        continue;
+                    }
+                    link l{ dir, { first } };
+                    tripoint_om_omt prev = p;
+                    tripoint_om_omt cur = first;
+                    while( !is_junction( cur ) ) {
+                        for( direction next_dir : horizontal_dirs ) {
+                            const tripoint_om_omt next = cur + displace( next_dir );
+                            if( next != prev && road_at( next ) ) {
+                                prev = cur;
+                                cur = next;
+                                break;
+                            }
+                        }
+                        l.omts.push_back( cur );
+                    }
+                    for( size_t i = 0; i + 1 < l.omts.size(); ++i ) {
+                        graph.link_at[l.omts[i]] = { p, static_cast<int>( links.size() ) };
+                    }
+                    links.push_back( std::move( l ) );
+                }
+                // Bridgeheads lead up and down to each other.
+                if( is_ramp( om.ter_unsafe( p ) ) ) {
+                    for( direction dir : {
+                             direction::ABOVECENTER, direction::BELOWCENTER
+                         } ) {
+                        const tripoint_om_omt other = p + displace( dir );
+                        if( road_at( other ) && is_ramp( om.ter_unsafe( other ) ) ) {
+                            links.push_back( link{ dir, { other } } );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return graph;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef CATA_SRC_OVERMAP_ROAD_GRAPH_H
+#define CATA_SRC_OVERMAP_ROAD_GRAPH_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "coordinates.h"
+#include "line.h"
+#include "type_id.h"
+
+class overmap;
+
+/**
+ * The roads and highways of one overmap, with every run of road between two junctions
+ * collapsed into a single link.  OMTs next to each other count as connected, as they do for
+ * pf::find_overmap_path.  Junctions are road OMTs with other than two road neighbours, ramps
+ * and road OMTs on the edge of the overmap.
+ */
+struct overmap_road_graph {
+    struct link {
+        // Direction of the first step from the junction.
+        direction dir;
+        // The OMTs the link leads through, ending with the junction at its far end.  Links
+        // off the edge of the overmap end on the neighbouring overmap, whether or not there
+        // is a road there.
+        std::vector<tripoint_om_omt> omts;
+    };
+    std::unordered_map<tripoint_om_omt, std::vector<link>> junctions;
+    // For OMTs inside a link, the junction it leaves from and its index there.  Links are
+    // listed at both of their ends; this is either of them.
+    std::unordered_map<tripoint_om_omt, std::pair<tripoint_om_omt, int>> link_at;
+
+    static bool is_road( const oter_id &oter );
+    static bool is_ramp( const oter_id &oter );
+    static overmap_road_graph build( const overmap &om );
+};
+
+#endif // CATA_SRC_OVERMAP_ROAD_GRAPH_H
@@ -4,6 +4,7 @@
 #include <array>
 #include <chrono>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -579,7 +580,6 @@ static void draw_ascii( const catacurses::window &w, overmap_draw_data_t &data )
     // Target of current mission
     const tripoint_abs_omt target = player_character.get_active_mission_target();
     const bool has_target = !target.is_invalid();
-    oter_id ccur_ter = oter_str_id::NULL_ID();
     // Debug vision allows seeing everything
     const bool has_debug_vision = player_character.has_trait( trait_DEBUG_NIGHTVISION );
     // sight_points is hoisted for speed reasons.
@@ -748,16 +748,11 @@ static void draw_ascii( const catacurses::window &w, overmap_draw_data_t &data )
     for( int i = 0; i < om_map_width; ++i ) {
         for( int j = 0; j < om_map_height; ++j ) {
             const tripoint_abs_omt omp = corner + point( i, j );
-            oter_id cur_ter = oter_str_id::NULL_ID();
             nc_color ter_color = c_black;
             std::string ter_sym = " ";
 
             const om_vision_level vision = has_debug_vision ? om_vision_level::full :
                                            overmap_buffer.seen( omp );
-            if( vision == om_vision_level::unseen ) {
-                // Only load terrain if we can actually see it
-                cur_ter = overmap_buffer.ter( omp );
-            }
 
             oter_display_args oter_args( vision );
             std::tie( ter_sym, ter_color ) = oter_symbol_and_color( omp, oter_args, oter_opts, &lru_cache );
@@ -828,7 +823,6 @@ static void draw_ascii( const catacurses::window &w, overmap_draw_data_t &data )
             }
 
             if( omp.xy() == cursor_pos.xy() && !uistate.place_special ) {
-                ccur_ter = cur_ter;
                 mvwputch_hi( w, point( i, j ), ter_color, ter_sym );
             } else {
                 mvwputch( w, point( i, j ), ter_color, ter_sym );
@@ -1816,6 +1810,7 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
     const tripoint_abs_omt player_omt_pos = player_character.pos_abs_omt();
     overmap_path_params params;
     vehicle *player_veh = nullptr;
+    bool on_wheels = false;
     if( driving ) {
         const optional_vpart_position vp = here.veh_at( player_character.pos_bub() );
         if( !vp.has_value() ) {
@@ -1837,6 +1832,7 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
                                         player_veh->average_offroad_rating() );
             const bool tiny = player_veh->get_points().size() <= 3;
             params = overmap_path_params::for_land_vehicle( offroad_coeff, tiny, can_float );
+            on_wheels = true;
         } else {
             return {};
         }
@@ -1853,9 +1849,22 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
     const tripoint_abs_omt start_omt_pos = driving ? player_veh->pos_abs_omt() : player_omt_pos;
     if( dest == player_omt_pos || dest == start_omt_pos ) {
         return {};
-    } else {
-        return overmap_buffer.get_travel_path( start_omt_pos, dest, params ).points;
     }
+    // Between two points on the road network, keep to the roads; their graph answers at once
+    if( on_wheels ) {
+        std::vector<tripoint_abs_omt> points = overmap_buffer.get_road_travel_path( start_omt_pos, dest,
+                                               params ).points;
+        if( !points.empty() ) {
+            return points;
+        }
+    }
+    // Keep the game responsive while the path is searched for
+    std::future<pf::simple_path<tripoint_abs_omt>> path = overmap_buffer.get_travel_path_async(
+                start_omt_pos, dest, params );
+    while( path.wait_for( std::chrono::milliseconds( 100 ) ) != std::future_status::ready ) {
+        g->display_om_pathfinding_progress( 0, 0 );
+    }
+    return path.get().points;
 }
 
 static int overmap_zoom_level = DEFAULT_TILESET_ZOOM;
@@ -2367,6 +2376,18 @@ std::pair<std::string, nc_color> oter_display_lru::get_symbol_and_color( const o
     return ret;
 }
 
+static bool on_mission_line( const oter_display_options &opts, const point_abs_omt &p )
+{
+    if( !opts.mission_target ) {
+        return false;
+    }
+    if( !opts.mission_line ) {
+        opts.mission_line = line_to( opts.center.xy(), opts.mission_target->xy() );
+    }
+    return std::find( opts.mission_line->begin(), opts.mission_line->end(), p ) !=
+           opts.mission_line->end();
+}
+
 std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &omp,
         oter_display_args &args, const oter_display_options &opts, oter_display_lru *lru )
 {
@@ -2374,13 +2395,8 @@ std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &
 
     oter_id cur_ter = oter_str_id::NULL_ID();
     avatar &player_character = get_avatar();
-    std::vector<point_abs_omt> plist;
     const bool blink = opts.blink || g->overmap_data.fast_traveling;
 
-    if( blink && !opts.mission_inbounds && opts.mission_target ) {
-        plist = line_to( opts.center.xy(), opts.mission_target->xy() );
-    }
-
     // Only load terrain if we can see it
     if( args.vision != om_vision_level::unseen ) {
         cur_ter = overmap_buffer.ter( omp );
@@ -2414,8 +2430,8 @@ std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &
         } else if( opts.mission_target->z() < opts.center.z() ) {
             ret.first = "v";
         }
-    } else if( !opts.mission_inbounds && !opts.drawn_mission && args.edge_tile &&
-               std::find( plist.begin(), plist.end(), omp.xy() ) != plist.end() ) {
+    } else if( blink && !opts.mission_inbounds && !opts.drawn_mission && args.edge_tile &&
+               on_mission_line( opts, omp.xy() ) ) {
         ret.first = "*";
         ret.second = c_red;
         opts.drawn_mission = true;
@@ -1,17 +1,26 @@
 #include "overmapbuffer.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
+#include <exception>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
 #include <optional>
+#include <queue>
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "basecamp.h"
 #include "calendar.h"
+#include "cata_thread_pool.h"
 #include "cata_assert.h"
 #include "cata_utility.h"
 #include "character.h"
@@ -22,6 +31,7 @@
 #include "cuboid_rectangle.h"
 #include "debug.h"
 #include "filesystem.h"
+#include "hash_utils.h"
 #include "game.h"
 #include "line.h"
 #include "map.h"
@@ -36,11 +46,13 @@
 #include "options.h"
 #include "overmap.h"
 #include "overmap_connection.h"
+#include "overmap_road_graph.h"
 #include "overmap_types.h"
 #include "path_info.h"
 #include "point.h"
 #include "regional_settings.h"
 #include "rng.h"
+#include "save_writer.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
 #include "translations.h"
@@ -55,6 +67,10 @@ static int omt_to_sm_copy( int a )
     return 2 * a;
 }
 
+// How close to the border of its overmap the avatar comes before the overmap across it is
+// pregenerated, in overmap terrains.
+static constexpr int pregenerate_distance = 24;
+
 overmapbuffer overmap_buffer;
 
 overmapbuffer::overmapbuffer()
@@ -81,6 +97,11 @@ std::string overmapbuffer::terrain_filename( const point_abs_om &p )
     return string_format( "o.%d.%d", p.x(), p.y() );
 }
 
+std::string overmapbuffer::dynamic_filename( const point_abs_om &p )
+{
+    return terrain_filename( p ) + ".dynamic";
+}
+
 cata_path overmapbuffer::player_filename( const point_abs_om &p )
 {
     return PATH_INFO::player_base_save_path() + string_format( ".seen.%d.%d", p.x(), p.y() );
@@ -97,21 +118,125 @@ overmap &overmapbuffer::get( const point_abs_om &p )
         return *( last_requested_overmap = it->second.get() );
     }
 
+    if( pregenerating ) {
+        if( pregenerating->pos() == p ) {
+            return finish_pregeneration();
+        }
+        // The new overmap lines up with the pregenerated one, as one generated after the other.
+        if( square_dist( pregenerating->pos(), p ) <= 1 ) {
+            finish_pregeneration();
+        }
+    }
+
     // That constructor loads an existing overmap or creates a new one.
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     overmap_count++;
     new_om.populate();
     // Note: fix_mongroups might load other overmaps, so overmaps.back() is not
     // necessarily the overmap at (x,y)
-    fix_mongroups( new_om );
-    fix_npcs( new_om );
+    if( !new_om.pending_dynamic ) {
+        fix_mongroups( new_om );
+        fix_npcs( new_om );
+    }
+
+    last_requested_overmap = &new_om;
+    return new_om;
+}
+
+void overmapbuffer::pregenerate_near( const tripoint_abs_omt &pos )
+{
+    if( pregenerating ) {
+        std::unique_ptr<overmap> om = std::move( pregenerating );
+        std::unique_ptr<overmap::generation> gen = std::move( pregeneration );
+        if( pregeneration_step( om, *gen ) ) {
+            pregenerating = std::move( om );
+            pregeneration = std::move( gen );
+        } else {
+            add_pregenerated( std::move( om ) );
+        }
+        return;
+    }
+    point_abs_om om_pos;
+    point_om_omt local;
+    std::tie( om_pos, local ) = project_remain<coords::om>( pos.xy() );
+    const point towards( local.x() < pregenerate_distance ? -1 :
+                         local.x() >= OMAPX - pregenerate_distance ? 1 : 0,
+                         local.y() < pregenerate_distance ? -1 :
+                         local.y() >= OMAPY - pregenerate_distance ? 1 : 0 );
+    for( const point &offset : {
+             point( towards.x, 0 ), point( 0, towards.y ), towards
+         } ) {
+        // Also loads the overmap if it was saved.
+        if( offset == point::zero || get_existing( om_pos + offset ) != nullptr ) {
+            continue;
+        }
+        std::unique_ptr<overmap> om = std::make_unique<overmap>( om_pos + offset );
+        overmap_count++;
+        std::unique_ptr<overmap::generation> gen = om->start_populating();
+        if( gen ) {
+            pregenerating = std::move( om );
+            pregeneration = std::move( gen );
+        } else {
+            add_pregenerated( std::move( om ) );
+        }
+        return;
+    }
+}
 
+bool overmapbuffer::pregeneration_step( std::unique_ptr<overmap> &om, overmap::generation &gen )
+{
+    // Like overmaps made by get, it can be found where it is while it generates.
+    const point_abs_om p = om->pos();
+    overmap *const generating = ( overmaps[p] = std::move( om ) ).get();
+    gen.neighbors = generating->existing_neighbors();
+    bool more = false;
+    try {
+        more = generating->generate_step( gen );
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap (%d,%d) failed to load: %s", p.x(), p.y(), err.what() );
+    }
+    om = std::move( overmaps[p] );
+    overmaps.erase( p );
+    if( last_requested_overmap == generating ) {
+        last_requested_overmap = nullptr;
+    }
+    return more;
+}
+
+overmap &overmapbuffer::add_pregenerated( std::unique_ptr<overmap> om )
+{
+    const point_abs_om p = om->pos();
+    overmap &new_om = *( overmaps[p] = std::move( om ) );
+    if( !new_om.pending_dynamic ) {
+        fix_mongroups( new_om );
+        fix_npcs( new_om );
+    }
     last_requested_overmap = &new_om;
     return new_om;
 }
 
+overmap &overmapbuffer::finish_pregeneration()
+{
+    // Taken out first, so overmaps the remaining stages ask for don't come back here.
+    std::unique_ptr<overmap> om = std::move( pregenerating );
+    std::unique_ptr<overmap::generation> gen = std::move( pregeneration );
+    while( pregeneration_step( om, *gen ) ) {
+    }
+    return add_pregenerated( std::move( om ) );
+}
+
 void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_special_batch &specials )
 {
+    if( pregenerating ) {
+        if( pregenerating->pos() == p ) {
+            // Replaced by the custom one, as if it had never been started.
+            pregenerating.reset();
+            pregeneration.reset();
+            overmap_count--;
+        } else if( square_dist( pregenerating->pos(), p ) <= 1 ) {
+            finish_pregeneration();
+        }
+    }
     if( last_requested_overmap != nullptr ) {
         auto om_iter = overmaps.find( p );
         if( om_iter != overmaps.end() && om_iter->second.get() == last_requested_overmap ) {
@@ -123,6 +248,32 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
     new_om.populate( specials );
 }
 
+void overmapbuffer::fix_loaded_dynamic( overmap &om )
+{
+    const auto it = overmaps.find( om.pos() );
+    if( it != overmaps.end() && it->second.get() == &om ) {
+        fix_mongroups( om );
+        fix_npcs( om );
+    }
+}
+
+void overmapbuffer::load_all_dynamic()
+{
+    // Loading one may load others from disk, so this can't iterate over overmaps directly.
+    std::vector<overmap *> pending;
+    do {
+        pending.clear();
+        for( auto &omp : overmaps ) {
+            if( omp.second->pending_dynamic ) {
+                pending.push_back( omp.second.get() );
+            }
+        }
+        for( overmap *om : pending ) {
+            om->ensure_dynamic_loaded();
+        }
+    } while( !pending.empty() );
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -232,23 +383,62 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
     }
 }
 
+void overmapbuffer::complete_pregeneration()
+{
+    if( pregenerating ) {
+        finish_pregeneration();
+    }
+}
+
 void overmapbuffer::save()
 {
+    complete_pregeneration();
     for( auto &omp : overmaps ) {
         // Note: this may throw io errors from std::ofstream
         omp.second->save();
     }
 }
 
+void overmapbuffer::forget_saved_hashes()
+{
+    for( auto &omp : overmaps ) {
+        omp.second->forget_saved_hashes();
+    }
+}
+
+std::unordered_map<point_abs_om, std::array<uint64_t, 3>> overmapbuffer::saved_hashes() const
+{
+    std::unordered_map<point_abs_om, std::array<uint64_t, 3>> hashes;
+    for( const auto &omp : overmaps ) {
+        hashes.emplace( omp.first, omp.second->saved_hash_values() );
+    }
+    return hashes;
+}
+
+void overmapbuffer::update_saved_hashes( const
+        std::unordered_map<point_abs_om, std::array<uint64_t, 3>> &changes )
+{
+    for( const auto &[p, hashes] : changes ) {
+        const auto it = overmaps.find( p );
+        if( it != overmaps.end() ) {
+            it->second->set_saved_hash_values( hashes );
+        }
+    }
+}
+
 void overmapbuffer::reset()
 {
     overmaps.clear();
+    pregenerating.reset();
+    pregeneration.reset();
     last_requested_overmap = nullptr;
 }
 
 void overmapbuffer::clear()
 {
     overmaps.clear();
+    pregenerating.reset();
+    pregeneration.reset();
     known_non_existing.clear();
     placed_unique_specials.clear();
     unique_special_count.clear();
@@ -327,7 +517,9 @@ overmap *overmapbuffer::get_existing( const point_abs_om &p )
         // checked in a previous call of this function).
         return nullptr;
     }
-    if( file_exist( PATH_INFO::world_base_save_path() / terrain_filename( p ) ) ) {
+    const cata_path terfilename = PATH_INFO::world_base_save_path() / terrain_filename( p );
+    get_save_writer().wait_for( terfilename.generic_u8string() );
+    if( file_exist( terfilename ) ) {
         // File exists, load it normally (the get function
         // indirectly call overmap::open to do so).
         return &get( p );
@@ -512,6 +704,7 @@ bool overmapbuffer::has_camp( const tripoint_abs_omt &p )
         return false;
     }
 
+    om_loc.om->ensure_dynamic_loaded();
     for( const basecamp &v : om_loc.om->camps ) {
         if( v.camp_omt_pos().xy() == p.xy() ) {
             return true;
@@ -528,6 +721,7 @@ bool overmapbuffer::has_vehicle( const tripoint_abs_omt &p )
         return false;
     }
 
+    om_loc.om->ensure_dynamic_loaded();
     for( const auto &v : om_loc.om->vehicles ) {
         if( v.second.p.xy() == om_loc.local.xy() ) {
             return true;
@@ -544,6 +738,7 @@ std::vector<om_vehicle> overmapbuffer::get_vehicle( const tripoint_abs_omt &p )
     if( !om_loc ) {
         return result;
     }
+    om_loc.om->ensure_dynamic_loaded();
     for( const auto &ov : om_loc.om->vehicles ) {
         if( ov.second.p.xy() == om_loc.local.xy() ) {
             result.push_back( ov.second );
@@ -611,6 +806,7 @@ void overmapbuffer::signal_hordes( const tripoint_abs_sm &center, const int sig_
 void overmapbuffer::signal_nemesis( const tripoint_abs_sm &p )
 {
 
+    load_all_dynamic();
     for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
         omp.second->signal_nemesis( p );
     }
@@ -649,6 +845,7 @@ void overmapbuffer::move_hordes()
 
 void overmapbuffer::move_nemesis()
 {
+    load_all_dynamic();
     for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
         omp.second->move_nemesis();
         fix_nemesis( *omp.second );
@@ -657,6 +854,7 @@ void overmapbuffer::move_nemesis()
 
 void overmapbuffer::remove_nemesis()
 {
+    load_all_dynamic();
     for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
         bool nemesis_removed = omp.second->remove_nemesis();
         if( nemesis_removed ) {
@@ -688,6 +886,7 @@ std::vector<mongroup *> overmapbuffer::groups_at( const tripoint_abs_sm &p )
         return result;
     }
     overmap &om = get( omp );
+    om.ensure_dynamic_loaded();
     auto groups_range = om.zg.equal_range( tripoint_om_sm( sm_within_om, p.z() ) );
     for( auto it = groups_range.first; it != groups_range.second; ++it ) {
         mongroup &mg = it->second;
@@ -739,6 +938,8 @@ void overmapbuffer::move_vehicle( vehicle *veh, const point_abs_ms &old_msp )
     const point_abs_omt new_omt = project_to<coords::omt>( new_msp );
     const overmap_with_local_coords old_om_loc = get_om_global( old_omt );
     const overmap_with_local_coords new_om_loc = get_om_global( new_omt );
+    old_om_loc.om->ensure_dynamic_loaded();
+    new_om_loc.om->ensure_dynamic_loaded();
     if( old_om_loc.om == new_om_loc.om ) {
         new_om_loc.om->vehicles[veh->om_id].p = new_om_loc.local;
     } else {
@@ -751,6 +952,7 @@ void overmapbuffer::remove_camp( const basecamp &camp )
 {
     const point_abs_omt omt = camp.camp_omt_pos().xy();
     const overmap_with_local_coords om_loc = get_om_global( omt );
+    om_loc.om->ensure_dynamic_loaded();
     std::vector<basecamp> &camps = om_loc.om->camps;
     for( auto it = camps.begin(); it != camps.end(); ++it ) {
         if( it->camp_omt_pos().xy() == omt ) {
@@ -768,6 +970,7 @@ void overmapbuffer::remove_vehicle( const vehicle *veh )
         debugmsg( "Can't find overmap for vehicle at %s", omt.to_string_writable() );
         return;
     }
+    om_loc.om->ensure_dynamic_loaded();
     om_loc.om->vehicles.erase( veh->om_id );
 }
 
@@ -779,6 +982,7 @@ void overmapbuffer::add_vehicle( vehicle *veh )
         debugmsg( "Can't find overmap for vehicle at %s", omt.to_string_writable() );
         return;
     }
+    om_loc.om->ensure_dynamic_loaded();
     int id = om_loc.om->vehicles.size() + 1;
     // this *should* be unique but just in case
     while( om_loc.om->vehicles.count( id ) > 0 ) {
@@ -794,6 +998,7 @@ void overmapbuffer::add_camp( const basecamp &camp )
 {
     const point_abs_omt omt = camp.camp_omt_pos().xy();
     const overmap_with_local_coords om_loc = get_om_global( omt );
+    om_loc.om->ensure_dynamic_loaded();
     om_loc.om->camps.push_back( camp );
 }
 
@@ -980,13 +1185,17 @@ static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path
     return params.get_cost( oter->get_travel_cost_type() );
 }
 
-static bool is_ramp( const tripoint_abs_omt &omt_pos )
+static bool is_ramp( const oter_id &oter )
 {
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
     return ( oter->get_type_id() == oter_type_bridgehead_ground ) ||
            ( oter->get_type_id() == oter_type_bridgehead_ramp );
 }
 
+static bool is_ramp( const tripoint_abs_omt &omt_pos )
+{
+    return is_ramp( overmap_buffer.ter_existing( omt_pos ) );
+}
+
 pf::simple_path<tripoint_abs_omt> overmapbuffer::get_travel_path(
     const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params )
 {
@@ -1012,6 +1221,298 @@ pf::simple_path<tripoint_abs_omt> overmapbuffer::get_travel_path(
     return path;
 }
 
+namespace
+{
+
+// Travel costs and ramps of the OMTs within a search radius around src, as get_travel_path's
+// scorer sees them.  The overmaps are looked up when this is made, and an overmap level is only
+// read the first time the search reaches it, on the thread doing the search.
+class travel_cost_snapshot
+{
+    public:
+        travel_cost_snapshot( overmapbuffer &buffer, const tripoint_abs_omt &src,
+                              const overmap_path_params &params, const int radius ) :
+            src( src ), params( params ) {
+            const point_abs_om src_om = project_to<coords::om>( src.xy() );
+            const int om_radius = radius / std::min( OMAPX, OMAPY ) + 1;
+            for( int omx = src_om.x() - om_radius; omx <= src_om.x() + om_radius; ++omx ) {
+                for( int omy = src_om.y() - om_radius; omy <= src_om.y() + om_radius; ++omy ) {
+                    const point_abs_om om_pos( omx, omy );
+                    if( const overmap *om = buffer.get_existing( om_pos ) ) {
+                        overmaps.emplace( om_pos, om );
+                    }
+                }
+            }
+        }
+
+        // The same score as the scorer of get_travel_path.
+        pf::omt_score score( const tripoint_abs_omt &p ) {
+            point_abs_om om_pos;
+            point_om_omt local;
+            std::tie( om_pos, local ) = project_remain<coords::om>( p.xy() );
+            const omt_level &level = level_at( om_pos, p.z() );
+            const size_t i = static_cast<size_t>( local.y() ) * OMAPX + local.x();
+            int cur_cost = level.cost.empty() ? level.missing_cost : level.cost[i];
+            if( cur_cost < 0 ) {
+                if( p == src ) {
+                    cur_cost = 0;
+                } else {
+                    return pf::omt_score::rejected;
+                }
+            }
+            return pf::omt_score( cur_cost, !level.ramp.empty() && level.ramp[i] );
+        }
+
+    private:
+        struct omt_level {
+            // Empty for overmaps that don't exist
+            std::vector<int> cost;
+            std::vector<bool> ramp;
+            int missing_cost = -1;
+        };
+
+        const omt_level &level_at( const point_abs_om &om_pos, const int z ) {
+            const auto [iter, inserted] = levels.try_emplace( tripoint_abs_om( om_pos, z ) );
+            omt_level &level = iter->second;
+            if( !inserted ) {
+                return level;
+            }
+            const auto om_iter = overmaps.find( om_pos );
+            if( om_iter == overmaps.end() ) {
+                // What get_terrain_cost gives for OMTs of overmaps that don't exist
+                static const oter_id ot_null;
+                level.missing_cost = params.only_known_by_player ? -1 :
+                                     params.get_cost( ot_null->get_travel_cost_type() );
+                return level;
+            }
+            const overmap &om = *om_iter->second;
+            level.cost.resize( static_cast<size_t>( OMAPX ) * OMAPY, -1 );
+            level.ramp.resize( level.cost.size(), false );
+            for( int y = 0; y < OMAPY; ++y ) {
+                for( int x = 0; x < OMAPX; ++x ) {
+                    const size_t i = static_cast<size_t>( y ) * OMAPX + x;
+                    const tripoint_om_omt local( x, y, z );
+                    if( ( params.only_known_by_player &&
+                          om.seen( local ) <= om_vision_level::vague ) ||
+                        ( params.avoid_danger && om.is_marked_dangerous( local ) ) ) {
+                        continue;
+                    }
+                    const oter_id &oter = om.ter( local );
+                    level.cost[i] = params.get_cost( oter->get_travel_cost_type() );
+                    level.ramp[i] = is_ramp( oter );
+                }
+            }
+            return level;
+        }
+
+        tripoint_abs_omt src;
+        overmap_path_params params;
+        std::unordered_map<point_abs_om, const overmap *> overmaps;
+        std::unordered_map<tripoint_abs_om, omt_level> levels;
+};
+
+} // namespace
+
+std::future<pf::simple_path<tripoint_abs_omt>> overmapbuffer::get_travel_path_async(
+            const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params )
+{
+    if( src.is_invalid() || dest.is_invalid() ) {
+        std::promise<pf::simple_path<tripoint_abs_omt>> none;
+        none.set_value( {} );
+        return none.get_future();
+    }
+    constexpr int radius = 4 * OMAPX; // same as get_travel_path
+    std::shared_ptr<travel_cost_snapshot> snapshot =
+        std::make_shared<travel_cost_snapshot>( *this, src, params, radius );
+    const bool allow_diagonal = params.allow_diagonal;
+    return cata::get_thread_pool().submit( [snapshot, src, dest, allow_diagonal]() {
+        const pf::omt_scoring_fn estimate = [&snapshot]( tripoint_abs_omt pos ) {
+            return snapshot->score( pos );
+        };
+        return pf::find_overmap_path( src, dest, radius, estimate, []( size_t, size_t ) {},
+                                      std::nullopt, allow_diagonal );
+    } );
+}
+
+pf::simple_path<tripoint_abs_omt> overmapbuffer::get_road_travel_path(
+    const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params )
+{
+    if( src.is_invalid() || dest.is_invalid() || src == dest || params.allow_diagonal ) {
+        return {};
+    }
+    const auto graph_at = [this]( const tripoint_abs_omt & p,
+    tripoint_om_omt & local ) -> const overmap_road_graph * {
+        const overmap_with_local_coords om_loc = get_existing_om_global( p );
+        if( !om_loc ) {
+            return nullptr;
+        }
+        local = om_loc.local;
+        return &om_loc.om->road_graph();
+    };
+    // Where p is in its overmap's road graph: the junction it is, or inside a link.
+    const auto find_on_graph = [&]( const tripoint_abs_omt & p, tripoint_om_omt & local,
+    const overmap_road_graph *&graph ) {
+        graph = graph_at( p, local );
+        return graph != nullptr &&
+               ( graph->junctions.count( local ) != 0 || graph->link_at.count( local ) != 0 );
+    };
+    tripoint_om_omt src_local;
+    tripoint_om_omt dest_local;
+    const overmap_road_graph *src_graph = nullptr;
+    const overmap_road_graph *dest_graph = nullptr;
+    if( !find_on_graph( src, src_local, src_graph ) || !find_on_graph( dest, dest_local, dest_graph ) ) {
+        return {};
+    }
+
+    std::unordered_map<tripoint_abs_omt, int> omt_costs;
+    const auto omt_cost = [&]( const tripoint_abs_omt & p ) {
+        auto iter = omt_costs.find( p );
+        if( iter == omt_costs.end() ) {
+            int cost = get_terrain_cost( p, params );
+            if( cost < 0 && p == src ) {
+                cost = 0;
+            }
+            iter = omt_costs.emplace( p, cost ).first;
+        }
+        return iter->second;
+    };
+
+    // Dijkstra over arrivals at junctions, which are told apart by the direction they came
+    // from since crossing a junction costs what turning there does.  Arriving at dest ends a
+    // path, and uses CENTER as its direction.
+    struct road_step {
+        tripoint_abs_omt pos;
+        direction from;
+        int cost;
+        int parent;
+        // OMTs since the parent's position, ending with pos
+        std::vector<tripoint_abs_omt> omts;
+    };
+    std::vector<road_step> steps;
+    std::unordered_map<std::pair<tripoint_abs_omt, int>, int, cata::tuple_hash> best_costs;
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> open;
+    constexpr int radius = 4 * OMAPX; // same as get_travel_path
+    constexpr size_t max_step_count = 100000;
+    const auto add_step = [&]( road_step && step ) {
+        if( steps.size() >= max_step_count ||
+            octile_dist( src.xy(), step.pos.xy() ) > radius ) {
+            return;
+        }
+        const std::pair<tripoint_abs_omt, int> key( step.pos, static_cast<int>( step.from ) );
+        auto iter = best_costs.find( key );
+        if( iter != best_costs.end() && iter->second <= step.cost ) {
+            return;
+        }
+        best_costs[key] = step.cost;
+        open.emplace( step.cost, static_cast<int>( steps.size() ) );
+        steps.push_back( std::move( step ) );
+    };
+    // Leave from, entered from in at the given cost, in direction out through omts.  Stops
+    // at dest, or at the last OMT, which must be a junction.
+    const auto walk = [&]( int parent, const tripoint_abs_omt & from, direction in, int cost,
+    direction out, const std::vector<tripoint_abs_omt> &omts ) {
+        cost += pf::omt_crossing_cost( omt_cost( from ), in, out );
+        tripoint_abs_omt prev = from;
+        for( size_t i = 0; i < omts.size(); ++i ) {
+            const tripoint_abs_omt &p = omts[i];
+            const int p_cost = omt_cost( p );
+            if( p_cost < 0 ) {
+                return;
+            }
+            const direction back = direction_from( ( prev - p ).raw() );
+            if( p == dest || i + 1 == omts.size() ) {
+                const bool done = p == dest;
+                add_step( road_step{ p, done ? direction::CENTER : back,
+                                     done ? cost + pf::omt_crossing_cost( p_cost, direction::CENTER, back ) : cost,
+                                     parent, std::vector<tripoint_abs_omt>( omts.begin(), omts.begin() + i + 1 ) } );
+                return;
+            }
+            cost += pf::omt_crossing_cost( p_cost, back, direction_from( ( omts[i + 1] - p ).raw() ) );
+            prev = p;
+        }
+    };
+    const auto to_abs = [&]( const point_abs_om & om_pos, const std::vector<tripoint_om_omt> &local ) {
+        std::vector<tripoint_abs_omt> ret;
+        ret.reserve( local.size() );
+        for( const tripoint_om_omt &p : local ) {
+            ret.push_back( project_combine( om_pos, p ) );
+        }
+        return ret;
+    };
+    const auto expand = [&]( int parent, const tripoint_abs_omt & pos, direction from, int cost ) {
+        tripoint_om_omt local;
+        const overmap_road_graph *graph = graph_at( pos, local );
+        const auto iter = graph->junctions.find( local );
+        const point_abs_om om_pos = project_to<coords::om>( pos.xy() );
+        for( const overmap_road_graph::link &l : iter->second ) {
+            if( l.dir == from ) {
+                continue;
+            }
+            const std::vector<tripoint_abs_omt> omts = to_abs( om_pos, l.omts );
+            if( !overmap::inbounds( l.omts.back() ) ) {
+                // Off the edge, so only a road if it's a junction of the next overmap
+                tripoint_om_omt next_local;
+                const overmap_road_graph *next_graph = graph_at( omts.back(), next_local );
+                if( next_graph == nullptr || next_graph->junctions.count( next_local ) == 0 ) {
+                    continue;
+                }
+            }
+            walk( parent, pos, from, cost, l.dir, omts );
+        }
+    };
+
+    if( src_graph->junctions.count( src_local ) != 0 ) {
+        expand( -1, src, direction::CENTER, 0 );
+    } else {
+        // Inside a link, so head for the junctions at both of its ends
+        const std::pair<tripoint_om_omt, int> &at = src_graph->link_at.at( src_local );
+        const overmap_road_graph::link &l = src_graph->junctions.at( at.first )[at.second];
+        const point_abs_om om_pos = project_to<coords::om>( src.xy() );
+        const size_t k = std::find( l.omts.begin(), l.omts.end(), src_local ) - l.omts.begin();
+        std::vector<tripoint_om_omt> ahead( l.omts.begin() + k + 1, l.omts.end() );
+        std::vector<tripoint_om_omt> behind( l.omts.rend() - k, l.omts.rend() );
+        behind.push_back( at.first );
+        for( const std::vector<tripoint_om_omt> &local : {
+                 ahead, behind
+             } ) {
+            const std::vector<tripoint_abs_omt> omts = to_abs( om_pos, local );
+            walk( -1, src, direction::CENTER, 0, direction_from( ( omts.front() - src ).raw() ), omts );
+        }
+    }
+
+    pf::simple_path<tripoint_abs_omt> ret;
+    while( !open.empty() ) {
+        const std::pair<int, int> top = open.top();
+        open.pop();
+        const road_step &step = steps[top.second];
+        if( best_costs[std::make_pair( step.pos, static_cast<int>( step.from ) )] != top.first ) {
+            continue;
+        }
+        if( step.from != direction::CENTER ) {
+            // Copies, since expanding adds steps
+            const tripoint_abs_omt pos = step.pos;
+            const direction from = step.from;
+            expand( top.second, pos, from, top.first );
+            continue;
+        }
+        ret.cost = top.first;
+        for( int i = top.second; i >= 0; i = steps[i].parent ) {
+            ret.points.insert( ret.points.end(), steps[i].omts.rbegin(), steps[i].omts.rend() );
+        }
+        ret.points.push_back( src );
+        ret.dist = 0;
+        for( size_t i = 0; i < ret.points.size(); ++i ) {
+            const direction dir_prev = i == 0 ? direction::CENTER :
+                                       direction_from( ( ret.points[i - 1] - ret.points[i] ).raw() );
+            const direction dir_next = i + 1 == ret.points.size() ? direction::CENTER :
+                                       direction_from( ( ret.points[i + 1] - ret.points[i] ).raw() );
+            ret.dist += pf::omt_crossing_cost( 24, dir_prev, dir_next );
+        }
+        return ret;
+    }
+    return ret;
+}
+
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                                   int radius, bool road_only )
 {
@@ -1149,26 +1650,40 @@ static omt_find_params assign_params(
     return params;
 }
 
-bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
-        const omt_find_params &params )
+// Whether terrains match any of the types of a search, matched by name once per terrain seen
+// rather than once per location.
+class omt_type_matches
 {
-    bool type_matches = false;
-    if( params.existing_only ) {
-        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
-            type_matches = check_ot_existing( elem.first, elem.second, location );
-            if( type_matches ) {
-                break;
+    public:
+        explicit omt_type_matches( const omt_find_params &params ) : params( params ) {}
+
+        bool operator()( const oter_id &oter ) {
+            const size_t i = static_cast<size_t>( oter.to_i() );
+            if( i >= known.size() ) {
+                known.resize( i + 1, match::unknown );
             }
-        }
-    } else {
-        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
-            type_matches = check_ot( elem.first, elem.second, location );
-            if( type_matches ) {
-                break;
+            if( known[i] == match::unknown ) {
+                known[i] = std::any_of( params.types.begin(), params.types.end(),
+                [&oter]( const std::pair<std::string, ot_match_type> & elem ) {
+                    return is_ot_match( elem.first, oter, elem.second );
+                } ) ? match::yes : match::no;
             }
+            return known[i] == match::yes;
         }
-    }
-    if( !type_matches ) {
+
+    private:
+        enum class match : char { unknown, yes, no };
+        const omt_find_params &params;
+        std::vector<match> known;
+};
+
+bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
+        const omt_find_params &params, omt_type_matches &matches )
+{
+    const overmap_with_local_coords om_loc = params.existing_only ?
+            get_existing_om_global( location ) : get_om_global( location );
+    if( !om_loc || !overmap::inbounds( om_loc.local ) ||
+        !matches( om_loc.om->ter_unsafe( om_loc.local ) ) ) {
         return false;
     }
 
@@ -1207,8 +1722,9 @@ tripoint_abs_omt overmapbuffer::find_closest(
 tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
+    omt_type_matches matches( params );
     // Check the origin before searching adjacent tiles!
-    if( params.min_distance == 0 && is_findable_location( origin, params ) ) {
+    if( params.min_distance == 0 && is_findable_location( origin, params, matches ) ) {
         return origin;
     }
 
@@ -1249,7 +1765,7 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
                     for( auto &element : om_data.overmap_special_placements ) {
                         if( element.second == special_id ) {
                             const tripoint_abs_omt loc = om_base + element.first.raw();
-                            if( is_findable_location( loc, params ) ) {
+                            if( is_findable_location( loc, params, matches ) ) {
                                 const int dist_xy = square_dist( origin.xy(), loc.xy() );
 
                                 if( dist_xy >= min_dist && dist_xy < max_dist ) {
@@ -1285,6 +1801,25 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
 
         return tripoint_abs_omt::invalid;
     } else {
+        // Z-levels of the overmap of loc_xy made of a single terrain that isn't any of the types,
+        // like the open air above most of the world.
+        point_abs_om summary_om = point_abs_om::invalid;
+        std::array<bool, OVERMAP_LAYERS> cant_match{};
+        const auto update_summary = [&]( const point_abs_om & om ) {
+            cant_match.fill( false );
+            const overmap *const om_data = get_existing( om );
+            if( om_data == nullptr ) {
+                // It may be generated by the search, look again at the next point.
+                summary_om = point_abs_om::invalid;
+                return;
+            }
+            summary_om = om;
+            for( int z = std::max( params.min_z, -OVERMAP_DEPTH );
+                 z <= std::min( params.max_z, OVERMAP_HEIGHT ); z++ ) {
+                const std::optional<oter_id> uniform = om_data->uniform_terrain( z );
+                cant_match[z + OVERMAP_DEPTH] = uniform && !matches( *uniform );
+            }
+        };
 
         for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
             const int dist_xy = square_dist( origin.xy(), loc_xy );
@@ -1293,15 +1828,21 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
                 break;
             }
 
+            const point_abs_om om = coords::project_to<coords::om>( loc_xy );
+            if( om != summary_om ) {
+                update_summary( om );
+            }
+
             for( int z = params.min_z; z <= params.max_z; z++ ) {
                 const tripoint_abs_omt loc( loc_xy, z );
                 const int dist = square_dist( origin, loc );
 
-                if( found_dist < dist ) {
+                if( found_dist < dist || ( z >= -OVERMAP_DEPTH && z <= OVERMAP_HEIGHT &&
+                                           cant_match[z + OVERMAP_DEPTH] ) ) {
                     continue;
                 }
 
-                if( is_findable_location( loc, params ) ) {
+                if( is_findable_location( loc, params, matches ) ) {
                     found_dist = dist;
                     result.push_back( loc );
                 }
@@ -1322,6 +1863,7 @@ tripoint_abs_omt overmapbuffer::find_existing_globally_unique( const tripoint_ab
     // invalid (because the entry is converted from an earlier version where the position wasn't
     // recorded).
     const tripoint_abs_om center = coords::project_to<coords::om>( origin );
+    omt_type_matches matches( params );
 
     // Very long range which will take forever if filled. Max is an arbitrary number.
     const overmap_special_id special_id = params.om_special.value();
@@ -1333,7 +1875,7 @@ tripoint_abs_omt overmapbuffer::find_existing_globally_unique( const tripoint_ab
             for( auto &element : om_data.overmap_special_placements ) {
                 if( element.second == special_id ) {
                     const tripoint_abs_omt loc = om_base + element.first.raw();
-                    if( is_findable_location( loc, params ) ) {
+                    if( is_findable_location( loc, params, matches ) ) {
                         return loc;
                     }
                 }
@@ -1348,6 +1890,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
         const omt_find_params &params )
 {
     std::vector<tripoint_abs_omt> result;
+    omt_type_matches matches( params );
     // dist == 0 means search a whole overmap diameter.
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
@@ -1368,7 +1911,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
                 for( auto &element : om_data.overmap_special_placements ) {
                     if( element.second == special_id ) {
                         const tripoint_abs_omt loc = om_base + element.first.raw();
-                        if( is_findable_location( loc, params ) ) {
+                        if( is_findable_location( loc, params, matches ) ) {
                             const int dist_xy = square_dist( origin.xy(), loc.xy() );
 
                             if( dist_xy >= min_dist && dist_xy < max_dist ) {
@@ -1381,7 +1924,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
         }
     } else {
         for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
-            if( is_findable_location( loc, params ) ) {
+            if( is_findable_location( loc, params, matches ) ) {
                 result.push_back( loc );
             }
         }
@@ -1418,6 +1961,7 @@ tripoint_abs_omt overmapbuffer::find_random(
 
 shared_ptr_fast<npc> overmapbuffer::find_npc( character_id id )
 {
+    load_all_dynamic();
     for( auto &it : overmaps ) {
         if( auto p = it.second->find_npc( id ) ) {
             return p;
@@ -1428,6 +1972,7 @@ shared_ptr_fast<npc> overmapbuffer::find_npc( character_id id )
 
 void overmapbuffer::foreach_npc( const std::function<void( npc & )> &callback )
 {
+    load_all_dynamic();
     for( auto &it : overmaps ) {
         for( auto &guy : it.second->npcs ) {
             callback( *guy );
@@ -1443,6 +1988,7 @@ shared_ptr_fast<npc> overmapbuffer::find_npc_by_unique_id( const std::string &un
 
 std::optional<basecamp *> overmapbuffer::find_camp( const point_abs_omt &p )
 {
+    load_all_dynamic();
     for( auto &it : overmaps ) {
         const point_abs_omt p2( p );
         for( int x2 = p2.x() - 3; x2 < p2.x() + 3; x2++ ) {
@@ -1466,6 +2012,7 @@ void overmapbuffer::insert_npc( const shared_ptr_fast<npc> &who )
 
 shared_ptr_fast<npc> overmapbuffer::remove_npc( const character_id &id )
 {
+    load_all_dynamic();
     for( auto &it : overmaps ) {
         if( auto p = it.second->erase_npc( id ) ) {
             return p;
@@ -1603,6 +2150,7 @@ std::vector<camp_reference> overmapbuffer::get_camps_near( const tripoint_abs_sm
 {
     std::vector<camp_reference> result;
     for( overmap *om : get_overmaps_near( location, radius ) ) {
+        om->ensure_dynamic_loaded();
         result.reserve( result.size() + om->camps.size() );
         std::transform( om->camps.begin(), om->camps.end(), std::back_inserter( result ),
         [&]( basecamp & element ) {
@@ -1623,6 +2171,7 @@ std::vector<camp_reference> overmapbuffer::get_camps_near( const tripoint_abs_sm
 std::vector<shared_ptr_fast<npc>> overmapbuffer::get_overmap_npcs()
 {
     std::vector<shared_ptr_fast<npc>> result;
+    load_all_dynamic();
     for( auto &om : overmaps ) {
         const overmap &overmap = *om.second;
         for( const auto &guy : overmap.npcs ) {
@@ -1688,13 +2237,13 @@ city_reference overmapbuffer::closest_known_city( const tripoint_abs_sm &center
 interhighway_node overmapbuffer::get_overmap_highway_intersection_point(
     const point_abs_om &p )
 {
-    return overmap_buffer.highway_intersections[p.to_string_writable()];
+    return overmap_buffer.highway_intersections[p];
 }
 
 void overmapbuffer::set_overmap_highway_intersection_point( const point_abs_om &p,
         const interhighway_node &intersection )
 {
-    overmap_buffer.highway_intersections[p.to_string_writable()] = intersection;
+    overmap_buffer.highway_intersections[p] = intersection;
 }
 
 
@@ -1746,7 +2295,7 @@ overmapbuffer::find_highway_adjacent_intersections( const point_abs_om &generate
 
 bool overmapbuffer::highway_intersection_exists( const point_abs_om &intersection_om ) const
 {
-    return highway_intersections.find( intersection_om.to_string_writable() ) !=
+    return highway_intersections.find( intersection_om ) !=
            highway_intersections.end();
 }
 
@@ -1761,7 +2310,7 @@ void overmapbuffer::generate_highway_intersection_point( const point_abs_om &gen
         new_intersection.generate_offset( intersection_max_radius );
         add_msg_debug( debugmode::DF_HIGHWAY, "Generated intersection at overmap %s.",
                        new_intersection.offset_pos.to_string_writable() );
-        overmap_buffer.highway_intersections.insert( { generated_om_pos.to_string_writable(), new_intersection } );
+        overmap_buffer.highway_intersections.insert( { generated_om_pos, new_intersection } );
     }
 }
 
@@ -1861,6 +2410,7 @@ void overmapbuffer::spawn_monster( const tripoint_abs_sm &p, bool spawn_nonlocal
     tripoint_om_sm current_submap_loc;
     std::tie( omp, current_submap_loc ) = project_remain<coords::om>( p );
     overmap &om = get( omp );
+    om.ensure_dynamic_loaded();
     auto monster_bucket = om.monster_map.equal_range( current_submap_loc );
     std::for_each( monster_bucket.first, monster_bucket.second,
     [&]( std::pair<const tripoint_om_sm, monster> &monster_entry ) {
@@ -1871,8 +2421,8 @@ void overmapbuffer::spawn_monster( const tripoint_abs_sm &p, bool spawn_nonlocal
         if( !spawn_nonlocal ) {
             cata_assert( here.inbounds( local ) );
         }
-        monster *const placed = g->place_critter_around( make_shared_fast<monster>( this_monster ),
-                                local, 0, true );
+        monster *const placed = g->place_critter_around(
+                                    make_pooled_shared_fast<monster>( this_monster ), local, 0, true );
         if( placed ) {
             placed->on_load();
         }
@@ -1887,6 +2437,7 @@ void overmapbuffer::despawn_monster( const monster &critter )
     tripoint_om_sm sm;
     std::tie( omp, sm ) = project_remain<coords::om>( critter.pos_abs_sm() );
     overmap &om = get( omp );
+    om.ensure_dynamic_loaded();
     // Store the monster using coordinates local to the overmap
 
     if( critter.is_nemesis() ) {
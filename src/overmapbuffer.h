@@ -4,6 +4,7 @@
 
 #include <array>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -33,6 +34,7 @@ class basecamp;
 class character_id;
 class monster;
 class npc;
+class omt_type_matches;
 class overmap_special;
 class vehicle;
 enum class cube_direction : int;
@@ -156,6 +158,8 @@ class overmapbuffer
         bool externally_set_args = false;
 
         static std::string terrain_filename( const point_abs_om & );
+        // Monsters, npcs and camps, saved apart from the terrain so they can change alone.
+        static std::string dynamic_filename( const point_abs_om & );
         static cata_path player_filename( const point_abs_om & );
 
         /**
@@ -163,7 +167,29 @@ class overmapbuffer
          * compared with the position of the overmap.
          */
         overmap &get( const point_abs_om & );
+        /**
+         * Generate the overmap across the border pos is nearing a stage per call, so crossing
+         * over does not wait for all of it at once.  The overmap is only added once complete,
+         * asking for it or for one of its neighbours before then completes it right away.
+         * Overmaps that were saved before are just loaded.  Called once per turn.
+         */
+        void pregenerate_near( const tripoint_abs_omt &pos );
+        /**
+         * Complete the overmap pregenerate_near is working on, if any.  Its unique specials
+         * are already counted in the global state, so a save must not leave it out.
+         */
+        void complete_pregeneration();
+        size_t loaded_overmap_count() const {
+            return overmaps.size();
+        }
         void save();
+        // For saves written where this process does not see what was written.
+        void forget_saved_hashes();
+        // What the loaded overmaps were last saved as, see overmap::saved_hash_values.
+        std::unordered_map<point_abs_om, std::array<uint64_t, 3>> saved_hashes() const;
+        // Take over what a forked copy of this process saved, for the overmaps still loaded.
+        void update_saved_hashes( const std::unordered_map<point_abs_om, std::array<uint64_t, 3>>
+                                  &changes );
         /**
          * Just drop the generated overmaps without resetting
          * the members tracking which specials we've placed.
@@ -379,6 +405,21 @@ class overmapbuffer
                      const std::function<bool( const oter_id & )> &filter );
         pf::simple_path<tripoint_abs_omt> get_travel_path(
             const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params );
+        /**
+         * Like get_travel_path, with the same result, but the search runs on the game's thread
+         * pool.  The search reads the overmaps that exist when this is called, so the caller
+         * must not change, create or unload overmaps until the future is ready.
+         */
+        std::future<pf::simple_path<tripoint_abs_omt>> get_travel_path_async(
+                    const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params );
+        /**
+         * The cheapest path from src to dest over roads and highways only, searched on the
+         * overmaps' road graphs instead of OMT by OMT.  Costs are those get_travel_path charges.
+         * Empty if either end isn't on a road, diagonal travel is allowed, or no such path is
+         * within get_travel_path's search radius.
+         */
+        pf::simple_path<tripoint_abs_omt> get_road_travel_path(
+            const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params );
         bool reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                            int radius = 0, bool road_only = false );
         /**
@@ -571,8 +612,8 @@ class overmapbuffer
         }
         // most central overmap highway intersection
         point_abs_om highway_global_offset = point_abs_om::invalid;
-        // all highway intersections
-        std::map<std::string, interhighway_node> highway_intersections;
+        // all highway intersections, by their grid point
+        std::unordered_map<point_abs_om, interhighway_node> highway_intersections;
         interhighway_node get_overmap_highway_intersection_point( const point_abs_om &p );
         void set_overmap_highway_intersection_point( const point_abs_om &p,
                 const interhighway_node &intersection );
@@ -598,11 +639,22 @@ class overmapbuffer
          * Common function used by the find_closest/all/random to determine if the location is
          * findable based on the specified criteria.
          * @param location Location of search
+         * @param matches Which terrains match params.types, kept for the whole search
          * see omt_find_params for definitions of the terms
          */
-        bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params,
+                                   omt_type_matches &matches );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
+        // The overmap pregenerate_near is generating, and what is left to do of it.
+        std::unique_ptr<overmap> pregenerating;
+        std::unique_ptr<overmap::generation> pregeneration;
+        // Run the next stage of generating om.  Returns false once om is complete.
+        bool pregeneration_step( std::unique_ptr<overmap> &om, overmap::generation &gen );
+        // Add a pregenerated overmap once it is complete.
+        overmap &add_pregenerated( std::unique_ptr<overmap> om );
+        // Complete the overmap being pregenerated and add it.
+        overmap &finish_pregeneration();
         /**
          * Set of overmap coordinates of overmaps that are known
          * to not exist on disk. See @ref get_existing for usage.
@@ -681,7 +733,14 @@ class overmapbuffer
          * Reads deprecated placed unique specials data, replaced by overmap_global_state.
          */
         void deserialize_placed_unique_specials( const JsonValue &jsin );
+        /**
+         * Does what loading an overmap does to its monster groups and npcs, once its dynamic
+         * part was parsed (see overmap::ensure_dynamic_loaded).
+         */
+        void fix_loaded_dynamic( overmap &om );
     private:
+        // Parse the dynamic part of every loaded overmap that has not been parsed yet.
+        void load_all_dynamic();
         /**
          * Go thorough the monster groups of the overmap and move out-of-bounds
          * groups to the correct overmap (if it exists), also removes empty groups.
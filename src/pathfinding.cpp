@@ -3,14 +3,17 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <climits>
 #include <cstdlib>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <queue>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "cata_utility.h"
 #include "coordinates.h"
 #include "creature.h"
@@ -41,20 +44,42 @@ struct path_data_layer {
     // Closed/open is accessed way more often than all other values here
     std::bitset< MAPSIZE_X *MAPSIZE_Y > closed;
     std::bitset< MAPSIZE_X *MAPSIZE_Y > open;
+    // Tiles currently in the open queue
+    std::bitset< MAPSIZE_X *MAPSIZE_Y > queued;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint_bub_ms, MAPSIZE_X *MAPSIZE_Y > parent;
+    // Where a queued tile is in the open queue, and the key it is queued under
+    std::array< int, MAPSIZE_X *MAPSIZE_Y > queue_key;
+    std::array< int, MAPSIZE_X *MAPSIZE_Y > queue_bucket;
+    std::array< int, MAPSIZE_X *MAPSIZE_Y > queue_pos;
 
     void reset() {
         closed.reset();
         open.reset();
+        queued.reset();
     }
 };
 
+// Number of bits needed to represent v
+static int bit_width( unsigned int v )
+{
+    int width = 0;
+    while( v != 0 ) {
+        ++width;
+        v >>= 1;
+    }
+    return width;
+}
+
 struct pathfinder {
-    using queue_type =
-        std::priority_queue< std::pair<int, tripoint_bub_ms>, std::vector< std::pair<int, tripoint_bub_ms> >, pair_greater_cmp_first >;
-    queue_type open;
+    // The open queue is a monotone radix heap with decrease-key: A* scores never drop below
+    // the score popped last, so bucket i holds the tiles whose key first differs from it in bit
+    // i - 1, and bucket 0 those equal to it.  A tile is queued at most once.
+    static constexpr int num_buckets = 33;
+    std::array< std::vector<tripoint_bub_ms>, num_buckets > buckets;
+    int last_key = 0;
+    int num_queued = 0;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
 
     path_data_layer &get_layer( const int z ) {
@@ -73,17 +98,67 @@ struct pathfinder {
                 path_data[i + OVERMAP_DEPTH]->reset();
             }
         }
-        open = queue_type();
+        for( std::vector<tripoint_bub_ms> &bucket : buckets ) {
+            bucket.clear();
+        }
+        last_key = 0;
+        num_queued = 0;
     }
 
     bool empty() const {
-        return open.empty();
+        return num_queued == 0;
+    }
+
+    void enqueue( const tripoint_bub_ms &p, const int key ) {
+        path_data_layer &layer = get_layer( p.z() );
+        const int index = flat_index( p.xy() );
+        // Moves between z-levels may score a little below the last popped tile.
+        const int clamped = std::max( key, last_key );
+        const int bucket = bit_width( static_cast<unsigned int>( clamped ^ last_key ) );
+        layer.queued[index] = true;
+        layer.queue_key[index] = clamped;
+        layer.queue_bucket[index] = bucket;
+        layer.queue_pos[index] = static_cast<int>( buckets[bucket].size() );
+        buckets[bucket].push_back( p );
+        ++num_queued;
+    }
+
+    void dequeue( const tripoint_bub_ms &p ) {
+        path_data_layer &layer = get_layer( p.z() );
+        const int index = flat_index( p.xy() );
+        std::vector<tripoint_bub_ms> &bucket = buckets[layer.queue_bucket[index]];
+        const int pos = layer.queue_pos[index];
+        const tripoint_bub_ms moved = bucket.back();
+        bucket[pos] = moved;
+        get_layer( moved.z() ).queue_pos[flat_index( moved.xy() )] = pos;
+        bucket.pop_back();
+        layer.queued[index] = false;
+        --num_queued;
     }
 
     tripoint_bub_ms get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        if( buckets[0].empty() ) {
+            // Advance to the smallest key of the first non-empty bucket, which spreads that
+            // bucket over the lower ones
+            int b = 1;
+            while( buckets[b].empty() ) {
+                ++b;
+            }
+            std::vector<tripoint_bub_ms> spread;
+            spread.swap( buckets[b] );
+            int min_key = INT_MAX;
+            for( const tripoint_bub_ms &p : spread ) {
+                min_key = std::min( min_key, get_layer( p.z() ).queue_key[flat_index( p.xy() )] );
+            }
+            last_key = min_key;
+            num_queued -= static_cast<int>( spread.size() );
+            for( const tripoint_bub_ms &p : spread ) {
+                enqueue( p, get_layer( p.z() ).queue_key[flat_index( p.xy() )] );
+            }
+        }
+        const tripoint_bub_ms next = buckets[0].back();
+        dequeue( next );
+        return next;
     }
 
     void add_point( const int gscore, const int score, const tripoint_bub_ms &from,
@@ -101,7 +176,10 @@ struct pathfinder {
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.emplace( score, to );
+        if( layer.queued[index] ) {
+            dequeue( to );
+        }
+        enqueue( to, score );
     }
 
     void close_point( const tripoint_bub_ms &p ) {
@@ -119,6 +197,17 @@ struct pathfinder {
 
 static pathfinder pf;
 
+// Routes between points further apart than this use the submap graph to bound their search.
+static constexpr int long_route_distance = 2 * SEEX;
+
+// Offsets to the eight neighbours of a tile, in the order they are expanded.  Opposite
+// directions differ only in the lowest bit of their index.
+// 7 3 5
+// 1 . 2
+// 6 4 8
+static constexpr std::array<int, 8> x_offset{ { -1,  1,  0,  0,  1, -1, -1, 1 } };
+static constexpr std::array<int, 8> y_offset{ {  0,  0, -1,  1, -1,  1, -1, 1 } };
+
 // Modifies `t` to point to a tile with `flag` in a 1-submap radius of `t`'s original value,
 // searching nearest points first (starting with `t` itself).
 // return false if it could not find a suitable point
@@ -196,10 +285,108 @@ std::vector<tripoint_bub_ms> map::straight_route( const tripoint_bub_ms &f,
     return ret;
 }
 
+std::vector<tripoint_bub_ms> map::plain_straight_route( const tripoint_bub_ms &f,
+        const tripoint_bub_ms &t, const std::function<bool( const tripoint_bub_ms & )> &avoid ) const
+{
+    if( f.z() != t.z() ) {
+        return {};
+    }
+    std::vector<tripoint_bub_ms> line_path = straight_route( f, t );
+    if( line_path.empty() ) {
+        return line_path;
+    }
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( f.z() );
+    auto should_avoid = [&avoid, &pf_cache]( const tripoint_bub_ms & p ) {
+        PathfindingFlags flags_copy = PathfindingFlags( pf_cache.special[p.xy()] );
+        flags_copy.set_clear( PathfindingFlag::Ground );
+        if( flags_copy.is_any_set() ) {
+            // If the straight line goes through any tile with any sort of special, then we
+            // don't use the straight-line optimization. Instead, we fall back to regular
+            // pathfinding. The costs might make the pathfinder pick a different path.
+            return true;
+        }
+        return avoid( p );
+    };
+    if( std::any_of( line_path.begin(), line_path.end(), should_avoid ) ) {
+        line_path.clear();
+    }
+    return line_path;
+}
+
 static constexpr int PF_IMPASSABLE = -1;
 static constexpr int PF_IMPASSABLE_FROM_HERE = -2;
+
+namespace
+{
+
+// The settings route_kernel and the cost helpers check for every tile, read from the
+// settings when the route is searched.
+struct runtime_route_flags {
+    bool avoid_traps;
+    bool avoid_rough_terrain;
+    bool avoid_sharp;
+    bool avoid_dangerous_fields;
+
+    explicit runtime_route_flags( const pathfinding_settings &settings ) :
+        avoid_traps( settings.avoid_traps ), avoid_rough_terrain( settings.avoid_rough_terrain ),
+        avoid_sharp( settings.avoid_sharp ), avoid_dangerous_fields( settings.avoid_dangerous_fields ) {}
+};
+
+// The same settings fixed at compile time, for the profiles most routes are searched with.
+template<bool AvoidTraps, bool AvoidRoughTerrain, bool AvoidSharp, bool AvoidDangerousFields>
+struct fixed_route_flags {
+    static constexpr bool avoid_traps = AvoidTraps;
+    static constexpr bool avoid_rough_terrain = AvoidRoughTerrain;
+    static constexpr bool avoid_sharp = AvoidSharp;
+    static constexpr bool avoid_dangerous_fields = AvoidDangerousFields;
+
+    static bool matches( const pathfinding_settings &settings ) {
+        return settings.avoid_traps == AvoidTraps &&
+               settings.avoid_rough_terrain == AvoidRoughTerrain &&
+               settings.avoid_sharp == AvoidSharp &&
+               settings.avoid_dangerous_fields == AvoidDangerousFields;
+    }
+};
+
+// Monsters that don't mind what they walk through, most zombies among them.
+using monster_route_flags = fixed_route_flags<false, false, false, false>;
+// The defaults of players and NPCs.
+using character_route_flags = fixed_route_flags<true, false, true, false>;
+
+} // namespace
+
+// The targets of map::route_costs and what has been found out about them so far.
+struct route_sweep {
+    // Indices of the targets that contain a tile
+    std::unordered_map<tripoint_bub_ms, std::vector<size_t>> targets_at;
+    std::vector<int> costs;
+    size_t remaining = 0;
+    int min_z = OVERMAP_HEIGHT;
+    int max_z = -OVERMAP_DEPTH;
+
+    bool contains( const tripoint_bub_ms &p ) const {
+        return targets_at.count( p ) != 0;
+    }
+
+    // Records that p was reached at cost, and returns true once every target has been.
+    bool reach( const tripoint_bub_ms &p, const int cost ) {
+        const auto it = targets_at.find( p );
+        if( it == targets_at.end() ) {
+            return false;
+        }
+        for( const size_t i : it->second ) {
+            if( costs[i] < 0 ) {
+                costs[i] = cost;
+                --remaining;
+            }
+        }
+        return remaining == 0;
+    }
+};
+
+template<typename Flags>
 int map::cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
-                       const pathfinding_settings &settings,
+                       const pathfinding_settings &settings, const Flags &flags,
                        PathfindingFlags p_special ) const
 {
     constexpr PathfindingFlags non_normal = PathfindingFlag::Slow |
@@ -210,11 +397,11 @@ int map::cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
         return 2;
     }
 
-    if( settings.avoid_rough_terrain ) {
+    if( flags.avoid_rough_terrain ) {
         return PF_IMPASSABLE;
     }
 
-    if( settings.avoid_sharp && ( p_special & PathfindingFlag::Sharp ) ) {
+    if( flags.avoid_sharp && ( p_special & PathfindingFlag::Sharp ) ) {
         return PF_IMPASSABLE;
     }
 
@@ -341,10 +528,11 @@ int map::cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
     return PF_IMPASSABLE;
 }
 
+template<typename Flags>
 int map::cost_to_avoid( const tripoint_bub_ms & /*cur*/, const tripoint_bub_ms &p,
-                        const pathfinding_settings &settings, PathfindingFlags p_special ) const
+                        const Flags &flags, PathfindingFlags p_special ) const
 {
-    if( settings.avoid_traps && ( p_special & PathfindingFlag::DangerousTrap ) ) {
+    if( flags.avoid_traps && ( p_special & PathfindingFlag::DangerousTrap ) ) {
         const const_maptile &tile = maptile_at_internal( p );
         const ter_t &terrain = tile.get_ter_t();
         const trap &ter_trp = terrain.trap.obj();
@@ -356,7 +544,7 @@ int map::cost_to_avoid( const tripoint_bub_ms & /*cur*/, const tripoint_bub_ms &
         }
     }
 
-    if( settings.avoid_dangerous_fields && ( p_special & PathfindingFlag::DangerousField ) ) {
+    if( flags.avoid_dangerous_fields && ( p_special & PathfindingFlag::DangerousField ) ) {
         // We'll walk through even known-dangerous fields if we absolutely have to.
         return 500;
     }
@@ -364,16 +552,18 @@ int map::cost_to_avoid( const tripoint_bub_ms & /*cur*/, const tripoint_bub_ms &
     return 0;
 }
 
+template<typename Flags>
 int map::extra_cost( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
-                     const pathfinding_settings &settings,
+                     const pathfinding_settings &settings, const Flags &flags,
                      PathfindingFlags p_special ) const
 {
-    int pass_cost = cost_to_pass( tripoint_bub_ms( cur ), tripoint_bub_ms( p ), settings, p_special );
+    int pass_cost = cost_to_pass( tripoint_bub_ms( cur ), tripoint_bub_ms( p ), settings, flags,
+                                  p_special );
     if( pass_cost < 0 ) {
         return pass_cost;
     }
 
-    int avoid_cost = cost_to_avoid( cur, p, settings, p_special );
+    int avoid_cost = cost_to_avoid( cur, p, flags, p_special );
     if( avoid_cost < 0 ) {
         return avoid_cost;
     }
@@ -409,25 +599,14 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    if( f.z() == t.z() ) {
-        auto line_path = straight_route( f, t );
-        if( !line_path.empty() ) {
-            const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( f.z() );
-            auto should_avoid = [&avoid, &pf_cache]( const tripoint_bub_ms & p ) {
-                PathfindingFlags flags_copy = PathfindingFlags( pf_cache.special[p.xy()] );
-                flags_copy.set_clear( PathfindingFlag::Ground );
-                if( flags_copy.is_any_set() ) {
-                    // If the straight line goes through any tile with any sort of special, then we
-                    // don't use the straight-line optimization. Instead, we fall back to regular
-                    // pathfinding. The costs might make the pathfinder pick a different path.
-                    return true;
-                }
-                return avoid( p );
-            };
-            if( std::none_of( line_path.begin(), line_path.end(), should_avoid ) ) {
-                return line_path;
-            }
-        }
+    std::vector<tripoint_bub_ms> line_path = plain_straight_route( f, t, avoid );
+    if( !line_path.empty() ) {
+        return line_path;
+    }
+
+    // Don't search at all if the target is walled off from us
+    if( !route_possible( f, target, settings ) ) {
+        return ret;
     }
 
     // If expected path length is greater than max distance, allow only line path, like above
@@ -435,7 +614,95 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
         return ret;
     }
 
+    // Long routes on one level search only the submaps the coarse graph leads through, so they
+    // aren't cut off by the padded bounding box below.  The coarse graph doesn't know whether
+    // submaps are connected inside, so fall back to the box if the corridor has no route.
+    // Unless the search never reached the edge of the corridor: it then searched everything
+    // reachable on the level, and the box can't hold a route either.
+    if( f.z() == t.z() && square_dist( f, t ) > long_route_distance ) {
+        const std::bitset<MAPSIZE * MAPSIZE> corridor = route_corridor( f, t );
+        bool left_corridor = false;
+        ret = route_search( f, target, settings, avoid, &corridor, &left_corridor, nullptr );
+        if( !ret.empty() || !left_corridor ) {
+            return ret;
+        }
+    }
+    return route_search( f, target, settings, avoid, nullptr, nullptr, nullptr );
+}
+
+std::vector<int> map::route_costs( const Creature &who,
+                                   const std::vector<pathfinding_target> &targets ) const
+{
+    return route_costs( who.pos_bub(), targets, who.get_pathfinding_settings(),
+                        who.get_path_avoid() );
+}
+
+std::vector<int> map::route_costs( const tripoint_bub_ms &f,
+                                   const std::vector<pathfinding_target> &targets,
+                                   const pathfinding_settings &settings,
+                                   const std::function<bool( const tripoint_bub_ms & )> &avoid ) const
+{
+    route_sweep sweep;
+    sweep.costs.assign( targets.size(), -1 );
+    if( !inbounds( f ) ) {
+        return sweep.costs;
+    }
+    for( size_t i = 0; i < targets.size(); ++i ) {
+        const pathfinding_target &target = targets[i];
+        bool any = false;
+        for( const tripoint_bub_ms &p : points_in_radius( target.center, target.r, target.r ) ) {
+            sweep.targets_at[p].push_back( i );
+            sweep.min_z = std::min( sweep.min_z, p.z() );
+            sweep.max_z = std::max( sweep.max_z, p.z() );
+            any = true;
+        }
+        if( any ) {
+            ++sweep.remaining;
+        }
+    }
+    if( sweep.remaining > 0 ) {
+        route_search( f, pathfinding_target::point( f ), settings, avoid, nullptr, nullptr, &sweep );
+    }
+    return sweep.costs;
+}
+
+std::vector<tripoint_bub_ms> map::route_search( const tripoint_bub_ms &f,
+        const pathfinding_target &target,
+        const pathfinding_settings &settings,
+        const std::function<bool( const tripoint_bub_ms & )> &avoid,
+        const std::bitset<MAPSIZE * MAPSIZE> *corridor, bool *left_corridor,
+        route_sweep *sweep ) const
+{
+    if( monster_route_flags::matches( settings ) ) {
+        return route_kernel( f, target, settings, monster_route_flags(), avoid, corridor,
+                             left_corridor, sweep );
+    }
+    if( character_route_flags::matches( settings ) ) {
+        return route_kernel( f, target, settings, character_route_flags(), avoid, corridor,
+                             left_corridor, sweep );
+    }
+    return route_kernel( f, target, settings, runtime_route_flags( settings ), avoid, corridor,
+                         left_corridor, sweep );
+}
+
+template<typename Flags>
+std::vector<tripoint_bub_ms> map::route_kernel( const tripoint_bub_ms &f,
+        const pathfinding_target &target,
+        const pathfinding_settings &settings, const Flags &flags,
+        const std::function<bool( const tripoint_bub_ms & )> &avoid,
+        const std::bitset<MAPSIZE * MAPSIZE> *corridor, bool *left_corridor,
+        route_sweep *sweep ) const
+{
+    std::vector<tripoint_bub_ms> ret;
+    const tripoint_bub_ms &t = target.center;
     const int max_length = settings.max_length;
+    // A sweep has no single target to head for
+    const auto estimate = [sweep, &t]( const tripoint_bub_ms & p ) {
+        return sweep == nullptr ? 2 * rl_dist( p, t ) : 0;
+    };
+    const auto is_target = [sweep, &target]( const tripoint_bub_ms & p ) {
+        return sweep == nullptr ? target.contains( p ) : sweep->contains( p );
+    };
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     tripoint_bub_ms min( std::min( f.x(), t.x() ) - pad, std::min( f.y(), t.y() ) - pad,
@@ -444,6 +711,17 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                          std::max( f.z(), t.z() ) );
     clip_to_bounds( min.x(), min.y(), min.z() );
     clip_to_bounds( max.x(), max.y(), max.z() );
+    if( corridor != nullptr || sweep != nullptr ) {
+        // The corridor bounds the search instead, and a sweep may go anywhere
+        min.x() = 0;
+        min.y() = 0;
+        max.x() = getmapsize() * SEEX;
+        max.y() = getmapsize() * SEEY;
+    }
+    if( sweep != nullptr ) {
+        min.z() = std::min( f.z(), sweep->min_z );
+        max.z() = std::max( f.z(), sweep->max_z );
+    }
 
     pf.reset( min.z(), max.z() );
 
@@ -466,7 +744,11 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
             return std::vector<tripoint_bub_ms>();
         }
 
-        if( target.contains( cur ) ) {
+        if( sweep != nullptr ) {
+            if( sweep->reach( cur, layer.gscore[parent_index] ) ) {
+                return ret;
+            }
+        } else if( target.contains( cur ) ) {
             done = true;
             found_target = cur;
             break;
@@ -477,11 +759,6 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
         const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( cur.z() );
         const PathfindingFlags cur_special = pf_cache.special[cur.x()][cur.y()];
 
-        // 7 3 5
-        // 1 . 2
-        // 6 4 8
-        constexpr std::array<int, 8> x_offset{ { -1,  1,  0,  0,  1, -1, -1, 1 } };
-        constexpr std::array<int, 8> y_offset{ {  0,  0, -1,  1, -1,  1, -1, 1 } };
         for( size_t i = 0; i < 8; i++ ) {
             const tripoint_bub_ms p( cur.x() + x_offset[i], cur.y() + y_offset[i], cur.z() );
             const int index = flat_index( p.xy() );
@@ -490,21 +767,28 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
             if( p.x() < min.x() || p.x() >= max.x() || p.y() < min.y() || p.y() >= max.y() ) {
                 continue;
             }
-
-            if( !target.contains( p ) && avoid( p ) ) {
-                layer.closed[index] = true;
+            if( corridor != nullptr && !( *corridor )[( p.x() / SEEX ) * MAPSIZE + p.y() / SEEY] ) {
+                if( left_corridor != nullptr ) {
+                    *left_corridor = true;
+                }
                 continue;
             }
 
+            // Before avoid, which is much more expensive and would only close the tile again
             if( layer.closed[index] ) {
                 continue;
             }
 
+            if( !is_target( p ) && avoid( p ) ) {
+                layer.closed[index] = true;
+                continue;
+            }
+
             // Penalize for diagonals or the path will look "unnatural"
             int newg = layer.gscore[parent_index] + ( ( cur.x() != p.x() && cur.y() != p.y() ) ? 1 : 0 );
 
             const PathfindingFlags p_special = pf_cache.special[p.x()][p.y()];
-            const int cost = extra_cost( cur, p, settings, p_special );
+            const int cost = extra_cost( cur, p, settings, flags, p_special );
             if( cost < 0 ) {
                 if( cost == PF_IMPASSABLE ) {
                     layer.closed[index] = true;
@@ -516,7 +800,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
             // Special case: pathfinders that avoid traps can avoid ledges by
             // climbing down. This can't be covered by |extra_cost| because it
             // can add a new point to the search.
-            if( settings.avoid_traps && ( p_special & PathfindingFlag::DangerousTrap ) ) {
+            if( flags.avoid_traps && ( p_special & PathfindingFlag::DangerousTrap ) ) {
                 const const_maptile &tile = maptile_at_internal( p );
                 const ter_t &terrain = tile.get_ter_t();
                 const trap &ter_trp = terrain.trap.obj();
@@ -530,7 +814,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                             path_data_layer &layer = pf.get_layer( p.z() - 1 );
                             // From cur, not p, because we won't be walking on air
                             pf.add_point( layer.gscore[parent_index] + 10,
-                                          layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
+                                          layer.score[parent_index] + 10 + estimate( below ),
                                           cur, below );
                         }
 
@@ -541,7 +825,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                 }
             }
 
-            pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
+            pf.add_point( newg, newg + estimate( p ), cur, p );
         }
 
         // TODO: We should be able to go up ramps even if we can't climb stairs.
@@ -568,7 +852,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                 }
                 path_data_layer &layer = pf.get_layer( dest.z() );
                 pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                              layer.score[parent_index] + estimate( dest ),
                               cur, dest );
             }
         }
@@ -586,7 +870,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                 }
                 path_data_layer &layer = pf.get_layer( dest.z() );
                 pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                              layer.score[parent_index] + estimate( dest ),
                               cur, dest );
             }
         }
@@ -599,7 +883,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                     continue;
                 }
                 pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                              layer.score[parent_index] + 4 + estimate( above ),
                               cur, above );
             }
         }
@@ -612,7 +896,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                     continue;
                 }
                 pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                              layer.score[parent_index] + 4 + estimate( above ),
                               cur, above );
             }
         }
@@ -625,7 +909,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
                     continue;
                 }
                 pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( below, t ),
+                              layer.score[parent_index] + 4 + estimate( below ),
                               cur, below );
             }
         }
@@ -662,6 +946,516 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
     return ret;
 }
 
+// Index of the neighbour direction d in x_offset and y_offset.
+static size_t direction_index( const point &d )
+{
+    for( size_t i = 0; i < 8; ++i ) {
+        if( x_offset[i] == d.x && y_offset[i] == d.y ) {
+            return i;
+        }
+    }
+    return 8;
+}
+
+// Coarse step costs, in the units of map::route, for moving on to the next submap.  Moving
+// between areas that no walkable crossing connects may still be possible through a door or
+// by bashing, so it is allowed at a penalty.
+static constexpr int submap_step_cost = 2 * SEEX;
+static constexpr int submap_diagonal_step_cost = 3 * SEEX;
+static constexpr int submap_blocked_step_cost = 8 * SEEX;
+
+// Whether a route with the given passage may be able to enter a tile with flags special.
+static bool is_passable( const PathfindingFlags special, const route_passage passage )
+{
+    if( !( special & PathfindingFlag::Obstacle ) ) {
+        return true;
+    }
+    switch( passage ) {
+        case route_passage::walk:
+            return false;
+        case route_passage::open:
+            return static_cast<bool>( special & ( PathfindingFlag::Door | PathfindingFlag::Climbable |
+                                      PathfindingFlag::Vehicle ) );
+        case route_passage::bash:
+        case route_passage::last:
+            break;
+    }
+    return static_cast<bool>( special & ( PathfindingFlag::Door | PathfindingFlag::Climbable |
+                              PathfindingFlag::Vehicle | PathfindingFlag::Bashable ) );
+}
+
+// Tiles a route may leave the level from, or arrive on from another one.
+static bool is_vertical( const PathfindingFlags special )
+{
+    return static_cast<bool>( special & ( PathfindingFlag::GoesUp | PathfindingFlag::GoesDown |
+                              PathfindingFlag::DangerousTrap ) );
+}
+
+// Splits the passable tiles of submap sm into 8-connected components.
+static void label_submap_components( const pathfinding_cache &cache, submap_graph &graph,
+                                     const route_passage passage, const point &sm )
+{
+    const point_bub_ms origin( sm.x * SEEX, sm.y * SEEY );
+    for( int lx = 0; lx < SEEX; ++lx ) {
+        for( int ly = 0; ly < SEEY; ++ly ) {
+            graph.component[origin + point_rel_ms( lx, ly )] = 0;
+        }
+    }
+    uint8_t count = 0;
+    uint64_t vertical = 0;
+    std::vector<point_bub_ms> stack;
+    const auto is_open = [&]( const point_bub_ms & p ) {
+        return graph.component[p] == 0 && is_passable( cache.special[p], passage );
+    };
+    for( int lx = 0; lx < SEEX; ++lx ) {
+        for( int ly = 0; ly < SEEY; ++ly ) {
+            const point_bub_ms seed = origin + point_rel_ms( lx, ly );
+            if( !is_open( seed ) ) {
+                continue;
+            }
+            ++count;
+            graph.component[seed] = count;
+            stack.push_back( seed );
+            while( !stack.empty() ) {
+                const point_bub_ms p = stack.back();
+                stack.pop_back();
+                if( is_vertical( cache.special[p] ) ) {
+                    vertical |= uint64_t{ 1 } << count;
+                }
+                for( size_t i = 0; i < 8; ++i ) {
+                    const point_bub_ms n( p.x() + x_offset[i], p.y() + y_offset[i] );
+                    if( n.x() < origin.x() || n.y() < origin.y() || n.x() >= origin.x() + SEEX ||
+                        n.y() >= origin.y() + SEEY ) {
+                        continue;
+                    }
+                    if( is_open( n ) ) {
+                        graph.component[n] = count;
+                        stack.push_back( n );
+                    }
+                }
+            }
+        }
+    }
+    graph.component_count[sm.x * MAPSIZE + sm.y] = count;
+    graph.vertical_components[sm.x * MAPSIZE + sm.y] = vertical;
+}
+
+// Lists the passable crossings from submap sm into its neighbours.
+static void find_submap_portals( submap_graph &graph, const point &sm, const int mapsize )
+{
+    std::vector<submap_portal> &portals = graph.portals[sm.x * MAPSIZE + sm.y];
+    portals.clear();
+    for( int lx = 0; lx < SEEX; ++lx ) {
+        for( int ly = 0; ly < SEEY; ++ly ) {
+            if( lx != 0 && lx != SEEX - 1 && ly != 0 && ly != SEEY - 1 ) {
+                // Only border tiles touch other submaps
+                continue;
+            }
+            const point_bub_ms p( sm.x * SEEX + lx, sm.y * SEEY + ly );
+            const uint8_t component = graph.component[p];
+            if( component == 0 ) {
+                continue;
+            }
+            for( size_t i = 0; i < 8; ++i ) {
+                const point_bub_ms n( p.x() + x_offset[i], p.y() + y_offset[i] );
+                if( n.x() < 0 || n.y() < 0 || n.x() >= mapsize * SEEX || n.y() >= mapsize * SEEY ) {
+                    continue;
+                }
+                const point d( n.x() / SEEX - sm.x, n.y() / SEEY - sm.y );
+                const uint8_t neighbour_component = graph.component[n];
+                if( d == point::zero || neighbour_component == 0 ) {
+                    continue;
+                }
+                const submap_portal portal{ component, static_cast<uint8_t>( direction_index( d ) ),
+                                            neighbour_component };
+                if( std::find( portals.begin(), portals.end(), portal ) == portals.end() ) {
+                    portals.push_back( portal );
+                }
+            }
+        }
+    }
+}
+
+// Joins the areas of all submaps that portals connect into regions of the level.
+static void find_regions( submap_graph &graph, const int mapsize )
+{
+    graph.first_node[0] = 0;
+    for( int index = 0; index < MAPSIZE * MAPSIZE; ++index ) {
+        graph.first_node[index + 1] = graph.first_node[index] + graph.component_count[index] + 1;
+    }
+    std::vector<int> &parent = graph.region;
+    parent.resize( graph.first_node.back() );
+    for( size_t node = 0; node < parent.size(); ++node ) {
+        parent[node] = static_cast<int>( node );
+    }
+    const auto find = [&parent]( int node ) {
+        while( parent[node] != node ) {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
+        }
+        return node;
+    };
+    for( int smx = 0; smx < mapsize; ++smx ) {
+        for( int smy = 0; smy < mapsize; ++smy ) {
+            const int index = smx * MAPSIZE + smy;
+            for( const submap_portal &portal : graph.portals[index] ) {
+                const int i = portal.direction;
+                const int n_index = ( smx + x_offset[i] ) * MAPSIZE + smy + y_offset[i];
+                const int a = find( graph.first_node[index] + portal.component );
+                const int b = find( graph.first_node[n_index] + portal.neighbour_component );
+                if( a != b ) {
+                    parent[std::max( a, b )] = std::min( a, b );
+                }
+            }
+        }
+    }
+    graph.region_vertical.assign( parent.size(), false );
+    for( int index = 0; index < MAPSIZE * MAPSIZE; ++index ) {
+        for( int c = 0; c <= graph.component_count[index]; ++c ) {
+            const int node = graph.first_node[index] + c;
+            parent[node] = find( node );
+            if( graph.vertical_components[index] & ( uint64_t{ 1 } << c ) ) {
+                graph.region_vertical[parent[node]] = true;
+            }
+        }
+    }
+}
+
+const submap_graph &map::get_submap_graph( const int zlev, const route_passage passage ) const
+{
+    get_pathfinding_cache_ref( zlev );
+    pathfinding_cache &cache = get_pathfinding_cache( zlev );
+    submap_graph &graph = cache.submap_graphs[static_cast<size_t>( passage )];
+    if( graph.dirty.none() ) {
+        return graph;
+    }
+    const int mapsize = getmapsize();
+    const auto in_map = [mapsize]( const point & sm ) {
+        return sm.x >= 0 && sm.y >= 0 && sm.x < mapsize && sm.y < mapsize;
+    };
+    // Relabelling a submap invalidates the portals of its neighbours into it as well
+    std::bitset<MAPSIZE * MAPSIZE> portals_dirty;
+    for( int smx = 0; smx < mapsize; ++smx ) {
+        for( int smy = 0; smy < mapsize; ++smy ) {
+            if( !graph.dirty[smx * MAPSIZE + smy] ) {
+                continue;
+            }
+            label_submap_components( cache, graph, passage, point( smx, smy ) );
+            for( int dx = -1; dx <= 1; ++dx ) {
+                for( int dy = -1; dy <= 1; ++dy ) {
+                    const point n( smx + dx, smy + dy );
+                    if( in_map( n ) ) {
+                        portals_dirty.set( n.x * MAPSIZE + n.y );
+                    }
+                }
+            }
+        }
+    }
+    for( int smx = 0; smx < mapsize; ++smx ) {
+        for( int smy = 0; smy < mapsize; ++smy ) {
+            if( portals_dirty[smx * MAPSIZE + smy] ) {
+                find_submap_portals( graph, point( smx, smy ), mapsize );
+            }
+        }
+    }
+    find_regions( graph, mapsize );
+    graph.dirty.reset();
+    return graph;
+}
+
+// The passage of the obstacles a route with settings may get past.
+static route_passage passage_for( const pathfinding_settings &settings )
+{
+    if( settings.bash_strength > 0 ) {
+        return route_passage::bash;
+    }
+    if( settings.allow_open_doors || settings.allow_unlock_doors || settings.climb_cost > 0 ) {
+        return route_passage::open;
+    }
+    return route_passage::walk;
+}
+
+bool map::route_possible( const tripoint_bub_ms &f, const pathfinding_target &target,
+                          const pathfinding_settings &settings ) const
+{
+    if( f.z() != target.center.z() || !inbounds( f ) ) {
+        // Searched over several levels, or not at all
+        return true;
+    }
+    const submap_graph &graph = get_submap_graph( f.z(), passage_for( settings ) );
+    if( graph.component[f.xy()] == 0 ) {
+        // Starting inside an obstacle; any way out may lead anywhere
+        return true;
+    }
+    if( target.r > 1 ) {
+        // Too many tiles to check one by one
+        return true;
+    }
+    const int from_region = graph.region[graph.node_of( f.xy() )];
+    const bool from_vertical = graph.region_vertical[from_region];
+    for( const tripoint_bub_ms &p : points_in_radius( target.center, target.r ) ) {
+        if( !inbounds( p ) || graph.component[p.xy()] == 0 ) {
+            continue;
+        }
+        const int to_region = graph.region[graph.node_of( p.xy() )];
+        // Stairs and ledges may lead around through another level
+        if( to_region == from_region || ( from_vertical && graph.region_vertical[to_region] ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::bitset<MAPSIZE * MAPSIZE> map::route_corridor( const tripoint_bub_ms &f,
+        const tripoint_bub_ms &t ) const
+{
+    const submap_graph &graph = get_submap_graph( f.z(), route_passage::walk );
+    const int mapsize = getmapsize();
+    const auto in_map = [mapsize]( const point & sm ) {
+        return sm.x >= 0 && sm.y >= 0 && sm.x < mapsize && sm.y < mapsize;
+    };
+
+    // Dijkstra over the areas of the submaps, from the one f is in to the one t is in.  Area 0
+    // of every submap stands for its obstacles.
+    const std::array<int, MAPSIZE * MAPSIZE + 1> &first_node = graph.first_node;
+    const auto node_of = [&first_node]( const point & sm, const int component ) {
+        return first_node[sm.x * MAPSIZE + sm.y] + component;
+    };
+    const point from_sm( f.x() / SEEX, f.y() / SEEY );
+    const point to_sm( t.x() / SEEX, t.y() / SEEY );
+    const int from_node = node_of( from_sm, graph.component[f.xy()] );
+    const int to_node = node_of( to_sm, graph.component[t.xy()] );
+    std::vector<int> cost( first_node.back(), INT_MAX );
+    std::vector<int> parent( first_node.back(), -1 );
+    std::vector<int> node_submap( first_node.back() );
+    for( int index = 0; index < MAPSIZE * MAPSIZE; ++index ) {
+        std::fill( node_submap.begin() + first_node[index], node_submap.begin() + first_node[index + 1],
+                   index );
+    }
+    using queue_type = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+          pair_greater_cmp_first>;
+    queue_type open;
+    const auto relax = [&]( const int node, const int from, const int new_cost ) {
+        if( new_cost < cost[node] ) {
+            cost[node] = new_cost;
+            parent[node] = from;
+            open.emplace( new_cost, node );
+        }
+    };
+    cost[from_node] = 0;
+    open.emplace( 0, from_node );
+    while( !open.empty() ) {
+        const std::pair<int, int> top = open.top();
+        open.pop();
+        const int node = top.second;
+        if( top.first != cost[node] ) {
+            continue;
+        }
+        if( node == to_node ) {
+            break;
+        }
+        const int index = node_submap[node];
+        const point sm( index / MAPSIZE, index % MAPSIZE );
+        const int component = node - first_node[index];
+        for( const submap_portal &portal : graph.portals[index] ) {
+            if( portal.component != component ) {
+                continue;
+            }
+            const size_t i = portal.direction;
+            const int step = ( x_offset[i] != 0 && y_offset[i] != 0 ) ? submap_diagonal_step_cost :
+                             submap_step_cost;
+            relax( node_of( sm + point( x_offset[i], y_offset[i] ), portal.neighbour_component ), node,
+                   top.first + step );
+        }
+        for( int other = first_node[index]; other < first_node[index + 1]; ++other ) {
+            relax( other, node, top.first + submap_blocked_step_cost );
+        }
+        for( size_t i = 0; i < 8; ++i ) {
+            const point n( sm.x + x_offset[i], sm.y + y_offset[i] );
+            if( !in_map( n ) ) {
+                continue;
+            }
+            const int n_index = n.x * MAPSIZE + n.y;
+            const int step = ( ( x_offset[i] != 0 && y_offset[i] != 0 ) ? submap_diagonal_step_cost :
+                               submap_step_cost ) + submap_blocked_step_cost;
+            for( int other = first_node[n_index]; other < first_node[n_index + 1]; ++other ) {
+                relax( other, node, top.first + step );
+            }
+        }
+    }
+
+    // The submaps on the coarse route and all their neighbours
+    std::bitset<MAPSIZE * MAPSIZE> corridor;
+    for( int node = to_node; node != -1; node = parent[node] ) {
+        const int index = node_submap[node];
+        const point sm( index / MAPSIZE, index % MAPSIZE );
+        for( int dx = -1; dx <= 1; ++dx ) {
+            for( int dy = -1; dy <= 1; ++dy ) {
+                const point n( sm.x + dx, sm.y + dy );
+                if( in_map( n ) ) {
+                    corridor.set( n.x * MAPSIZE + n.y );
+                }
+            }
+        }
+    }
+    return corridor;
+}
+
+// Flow fields are rebuilt every turn, so only a few targets are ever live at once.
+static constexpr size_t max_route_flow_fields = 8;
+
+bool map::route_flow_shared( const tripoint_bub_ms &t, const pathfinding_settings &settings ) const
+{
+    const int turn = to_turn<int>( calendar::turn );
+    if( !route_flow_asked ) {
+        route_flow_asked = std::make_unique<route_flow_requests>();
+    }
+    route_flow_requests &requests = *route_flow_asked;
+    if( requests.turn != turn || requests.abs_sub != abs_sub ) {
+        requests.asked.clear();
+        requests.turn = turn;
+        requests.abs_sub = abs_sub;
+    }
+    std::vector<pathfinding_settings> &asked = requests.asked[t];
+    if( std::find( asked.begin(), asked.end(), settings ) != asked.end() ) {
+        return true;
+    }
+    asked.push_back( settings );
+    return false;
+}
+
+const route_flow_field &map::get_route_flow_field( const tripoint_bub_ms &t,
+        const pathfinding_settings &settings ) const
+{
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z() );
+    const int turn = to_turn<int>( calendar::turn );
+    route_flow_fields.erase( std::remove_if( route_flow_fields.begin(), route_flow_fields.end(),
+    [&]( const std::unique_ptr<route_flow_field> &ff ) {
+        const pathfinding_cache &ff_cache = get_pathfinding_cache( ff->target.z() );
+        return ff->turn != turn || ff->abs_sub != abs_sub || ff->generation != ff_cache.generation ||
+               ff_cache.dirty || !ff_cache.dirty_points.empty();
+    } ), route_flow_fields.end() );
+    for( const std::unique_ptr<route_flow_field> &ff : route_flow_fields ) {
+        if( ff->target == t && ff->settings == settings ) {
+            return *ff;
+        }
+    }
+    if( route_flow_fields.size() >= max_route_flow_fields ) {
+        route_flow_fields.erase( route_flow_fields.begin() );
+    }
+
+    std::unique_ptr<route_flow_field> ff = std::make_unique<route_flow_field>();
+    ff->target = t;
+    ff->settings = settings;
+    ff->abs_sub = abs_sub;
+    ff->turn = turn;
+    ff->generation = pf_cache.generation;
+    ff->cost.fill( INT_MAX );
+    ff->cost[t.xy()] = 0;
+
+    // Dijkstra outwards from the target, relaxing every step that ends on the tile just
+    // closed.  The step costs are those map::route uses, so following next gives a route
+    // exactly as cheap as the one it would find on this z-level.
+    using queue_type = std::priority_queue<std::pair<int, point_bub_ms>,
+          std::vector<std::pair<int, point_bub_ms>>, pair_greater_cmp_first>;
+    queue_type open;
+    open.emplace( 0, t.xy() );
+    const int max_length = settings.max_length;
+    const runtime_route_flags flags( settings );
+    while( !open.empty() ) {
+        const std::pair<int, point_bub_ms> top = open.top();
+        open.pop();
+        const point_bub_ms &p = top.second;
+        if( top.first != ff->cost[p] ) {
+            continue;
+        }
+        const tripoint_bub_ms to( p, t.z() );
+        const PathfindingFlags to_special = pf_cache.special[p];
+
+        // map::route never steps onto a ledge that a trap avoider can climb down instead.
+        if( to != t && settings.avoid_traps && ( to_special & PathfindingFlag::DangerousTrap ) ) {
+            const const_maptile &tile = maptile_at_internal( to );
+            const ter_t &terrain = tile.get_ter_t();
+            const trap &ter_trp = terrain.trap.obj();
+            const trap &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+            if( !trp.is_benign() && terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) &&
+                valid_move( to, to + tripoint::below, false, true ) ) {
+                continue;
+            }
+        }
+
+        for( size_t i = 0; i < 8; i++ ) {
+            const tripoint_bub_ms from( p.x() + x_offset[i], p.y() + y_offset[i], t.z() );
+            if( !inbounds( from ) ) {
+                continue;
+            }
+            const int cost = extra_cost( from, to, settings, flags, to_special );
+            if( cost < 0 ) {
+                continue;
+            }
+            // Same diagonal penalty as map::route
+            const int new_cost = top.first + cost + ( ( x_offset[i] != 0 && y_offset[i] != 0 ) ? 1 : 0 );
+            if( new_cost > max_length || new_cost >= ff->cost[from.xy()] ) {
+                continue;
+            }
+            ff->cost[from.xy()] = new_cost;
+            ff->next[from.xy()] = p;
+            open.emplace( new_cost, from.xy() );
+        }
+    }
+
+    route_flow_fields.push_back( std::move( ff ) );
+    return *route_flow_fields.back();
+}
+
+std::vector<tripoint_bub_ms> map::flow_route( const Creature &who, const tripoint_bub_ms &t ) const
+{
+    const tripoint_bub_ms f = who.pos_bub();
+    const pathfinding_target target = pathfinding_target::point( t );
+    if( f == t || !inbounds( f ) || !inbounds( t ) || f.z() != t.z() ) {
+        return route( who, target );
+    }
+    const std::function<bool( const tripoint_bub_ms & )> avoid = who.get_path_avoid();
+    std::vector<tripoint_bub_ms> ret = plain_straight_route( f, t, avoid );
+    if( !ret.empty() ) {
+        return ret;
+    }
+    const pathfinding_settings &settings = who.get_pathfinding_settings();
+    if( rl_dist( f, t ) > settings.max_dist ) {
+        return ret;
+    }
+
+    if( !route_flow_shared( t, settings ) ) {
+        // A field costs a search of the whole level, which only pays off for a crowd.
+        return route( f, target, settings, avoid );
+    }
+    const route_flow_field &ff = get_route_flow_field( t, settings );
+    if( ff.cost[f.xy()] == INT_MAX ) {
+        // The field covers the whole level with route's step costs, and route doesn't leave
+        // the level between two points on it, so it would find nothing either.
+        return ret;
+    }
+    ret.reserve( rl_dist( f, t ) * 2 );
+    for( tripoint_bub_ms cur = f; cur != t; ) {
+        cur = tripoint_bub_ms( ff.next[cur.xy()], t.z() );
+        if( cur != t && avoid( cur ) ) {
+            return route( f, target, settings, avoid );
+        }
+        ret.push_back( cur );
+    }
+    return ret;
+}
+
+bool pathfinding_settings::operator==( const pathfinding_settings &rhs ) const
+{
+    return bash_strength == rhs.bash_strength && max_dist == rhs.max_dist &&
+           max_length == rhs.max_length && climb_cost == rhs.climb_cost &&
+           allow_open_doors == rhs.allow_open_doors && allow_unlock_doors == rhs.allow_unlock_doors &&
+           avoid_traps == rhs.avoid_traps && allow_climb_stairs == rhs.allow_climb_stairs &&
+           avoid_rough_terrain == rhs.avoid_rough_terrain && avoid_sharp == rhs.avoid_sharp &&
+           avoid_dangerous_fields == rhs.avoid_dangerous_fields && size == rhs.size;
+}
+
 bool pathfinding_target::contains( const tripoint_bub_ms &p ) const
 {
     if( r == 0 ) {
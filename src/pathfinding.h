@@ -2,11 +2,16 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <bitset>
 #include <cstdint>
 #include <optional>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "coordinates.h"
+#include "map_scale_constants.h"
 #include "mdarray.h"
 #include "point.h"
 
@@ -125,11 +130,68 @@ constexpr PathfindingFlags operator |( const PathfindingFlag &a, const Pathfindi
     return PathfindingFlags( a ) | PathfindingFlags( b );
 }
 
+// A walkable crossing from an area of one submap into an area of a neighbouring one.
+struct submap_portal {
+    uint8_t component;
+    // Index of the neighbour in the order map::route expands neighbours in.
+    uint8_t direction;
+    uint8_t neighbour_component;
+
+    bool operator==( const submap_portal &rhs ) const {
+        return component == rhs.component && direction == rhs.direction &&
+               neighbour_component == rhs.neighbour_component;
+    }
+};
+
+// The obstacles a route is able to get past, which decide which tiles of a level connect.
+enum class route_passage : uint8_t {
+    // Only tiles that aren't obstacles
+    walk,
+    // Also doors, climbable obstacles and vehicles
+    open,
+    // Also anything that can be bashed
+    bash,
+    last
+};
+
+// Coarse graph of a level, for one route_passage.  The tiles of each submap a route may pass
+// are split into 8-connected areas, numbered from 1 in component (0 for the others), and
+// portals lists which areas of neighbouring submaps touch.  Submaps flagged in dirty are
+// rebuilt by map::get_submap_graph, which also joins the areas into regions of the level.
+struct submap_graph {
+    cata::mdarray<uint8_t, point_bub_ms> component;
+    std::array<uint8_t, MAPSIZE * MAPSIZE> component_count{};
+    // Areas with stairs, ramps or ledges, where a route may leave the level, as a bit per area
+    std::array<uint64_t, MAPSIZE * MAPSIZE> vertical_components{};
+    std::array<std::vector<submap_portal>, MAPSIZE * MAPSIZE> portals;
+    std::bitset<MAPSIZE * MAPSIZE> dirty;
+
+    // Area c of submap index is node first_node[index] + c, where c 0 stands for the tiles
+    // the route can't pass.  region holds the connected region of the level of every node,
+    // and region_vertical whether any of its areas is vertical.
+    std::array<int, MAPSIZE * MAPSIZE + 1> first_node{};
+    std::vector<int> region;
+    std::vector<bool> region_vertical;
+
+    int node_of( const point_bub_ms &p ) const {
+        return first_node[( p.x() / SEEX ) * MAPSIZE + p.y() / SEEY] + component[p];
+    }
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
 
     bool dirty = false;
     std::unordered_set<point_bub_ms> dirty_points;
+    // Bumped whenever dirty tiles are brought up to date, so data derived from special can
+    // tell that it is stale.
+    int generation = 0;
+    // The generation at which each tile, or the whole level, was last brought up to date.
+    cata::mdarray<int, point_bub_ms> changed_generation;
+    int rebuilt_generation = 0;
+
+    // One submap_graph for every route_passage.
+    std::array<submap_graph, static_cast<size_t>( route_passage::last )> submap_graphs;
 
     cata::mdarray<PathfindingFlags, point_bub_ms> special;
 };
@@ -164,6 +226,8 @@ struct pathfinding_settings {
           avoid_rough_terrain( art ), avoid_sharp( as ), size( sz )  {}
 
     pathfinding_settings &operator=( const pathfinding_settings & ) = default;
+
+    bool operator==( const pathfinding_settings &rhs ) const;
 };
 
 struct pathfinding_target {
@@ -187,4 +251,27 @@ struct pathfinding_target {
     }
 };
 
+// Cheapest same-level routes from every tile to one target, shared by all creatures that path
+// there with the same settings.  Built by map::flow_route.
+struct route_flow_field {
+    tripoint_bub_ms target;
+    pathfinding_settings settings;
+    // What the field was built from; it is stale once any of these changes.
+    tripoint_abs_sm abs_sub;
+    int turn = 0;
+    int generation = 0;
+    // Cost of the cheapest route from a tile to the target, INT_MAX if there is none.
+    cata::mdarray<int, point_bub_ms> cost;
+    // The tile to step onto next on the way to the target.
+    cata::mdarray<point_bub_ms, point_bub_ms> next;
+};
+
+// The targets flow_route was asked for on one turn, with the settings of each request, so a
+// field is only built for a target more than one creature heads for.
+struct route_flow_requests {
+    tripoint_abs_sm abs_sub;
+    int turn = 0;
+    std::unordered_map<tripoint_bub_ms, std::vector<pathfinding_settings>> asked;
+};
+
 #endif // CATA_SRC_PATHFINDING_H
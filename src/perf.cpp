@@ -1,5 +1,67 @@
 #include "perf.h"
 
+// Clears the stats of timers, and drops those no timer measures now.  A timer's parents are
+// running whenever it is, so nothing below a dropped timer is running either.
+static void reset_timers( cata_timer::timers_map &timers )
+{
+    for( auto iter = timers.begin(); iter != timers.end(); ) {
+        cata_timer::timer_stats &stats = iter->second;
+        if( stats.running == 0 ) {
+            iter = timers.erase( iter );
+            continue;
+        }
+        stats.duration = 0;
+        stats.count = 0;
+        reset_timers( stats.child_timers );
+        ++iter;
+    }
+}
+
+void cata_timer::print_stats()
+{
+    for( const auto& [name, timer] : get_stats() ) {
+        timer.print_stats_recursively();
+    }
+}
+
+cata_timer::timers_map cata_timer::get_stats()
+{
+    std::lock_guard<std::mutex> lk( stats_mutex() );
+    return top_level_timer_map();
+}
+
+void cata_timer::reset_stats()
+{
+    std::lock_guard<std::mutex> lk( stats_mutex() );
+    reset_timers( top_level_timer_map() );
+}
+
+void cata_timer::start( const std::string_view name )
+{
+    active = true;
+    std::lock_guard<std::mutex> lk( stats_mutex() );
+    timers_map &timer_map = timer_stack().empty() ? top_level_timer_map() :
+                            timer_stack().back()->second.child_timers;
+    timer = timer_map.find( name );
+    if( timer == timer_map.end() ) {
+        timer = timer_map.emplace( name, timer_stats{ name } ).first;
+    }
+    ++timer->second.running;
+    timer_stack().push_back( timer );
+    current_start = std::chrono::high_resolution_clock::now();
+}
+
+void cata_timer::stop()
+{
+    std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+    std::lock_guard<std::mutex> lk( stats_mutex() );
+    timer->second.duration += std::chrono::duration_cast<std::chrono::microseconds>( (
+                                  end - current_start ) ).count();
+    ++timer->second.count;
+    --timer->second.running;
+    timer_stack().pop_back();
+}
+
 cata_timer::timers_map &cata_timer::top_level_timer_map()
 {
     static cata_timer::timers_map map;
@@ -8,6 +70,18 @@ cata_timer::timers_map &cata_timer::top_level_timer_map()
 
 std::vector<cata_timer::timers_map::iterator> &cata_timer::timer_stack()
 {
-    static std::vector<cata_timer::timers_map::iterator> stack;
+    static thread_local std::vector<cata_timer::timers_map::iterator> stack;
     return stack;
 }
+
+std::mutex &cata_timer::stats_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::atomic<bool> &cata_timer::collecting()
+{
+    static std::atomic<bool> collecting = false;
+    return collecting;
+}
@@ -4,10 +4,12 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -18,17 +20,18 @@
 struct cata_timer {
         struct timer_stats {
             std::string name;
-            std::chrono::high_resolution_clock::time_point current_start;
             uint64_t duration = 0;
             uint64_t count = 0;
             std::map<std::string, timer_stats, std::less<>> child_timers;
+            // Timers of any thread measuring this right now; reset_stats keeps these.
+            int running = 0;
 
             explicit timer_stats( std::string_view name ) : name{ name } {}
 
             void print_stats_recursively( std::string_view prefix = "" ) const {
                 DebugLog( DebugLevel::D_WARNING,
                           D_MAIN ) << prefix << name << ": " << std::to_string( duration ) << "us (avg: " << std::to_string(
-                                       duration / count ) << "us) (count: " << count << ")";
+                                       count == 0 ? 0 : duration / count ) << "us) (count: " << count << ")";
                 std::string child_prefix;
                 child_prefix.reserve( prefix.length() + 2 );
                 child_prefix += prefix;
@@ -41,43 +44,45 @@ struct cata_timer {
 
         using timers_map = std::map<std::string, timer_stats, std::less<>>;
 
-        // NOLINTNEXTLINE(cata-large-inline-function)
+        // Timers may run on the threads of the thread pool too.  Each thread nests its timers
+        // on its own, those started outside of any other timer of their thread are at the top
+        // level, and the stats of the same timers of all the threads are summed.
         explicit cata_timer( std::string_view name ) {
-            timers_map &timer_map = ( [&]() -> timers_map& {
-                if( timer_stack().empty() ) {
-                    return top_level_timer_map();
-                } else {
-                    return timer_stack().back()->second.child_timers;
-                }
-            } )();
-            timer = timer_map.find( name );
-            if( timer == timer_map.end() ) {
-                timer = timer_map.emplace( name, timer_stats{ name } ).first;
+            if( collecting() ) {
+                start( name );
             }
-            timer_stack().push_back( timer );
-            timer->second.current_start = std::chrono::high_resolution_clock::now();
         }
 
         ~cata_timer() {
-            std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
-            timer->second.duration += std::chrono::duration_cast<std::chrono::microseconds>( (
-                                          end - current_start ) ).count();
-            ++timer->second.count;
-            timer_stack().pop_back();
-        }
-
-        static void print_stats() {
-            for( const auto& [name, timer] : top_level_timer_map() ) {
-                timer.print_stats_recursively();
+            if( active ) {
+                stop();
             }
         }
+
+        static void print_stats();
+
+        // Timers only measure while this is set, so they cost next to nothing in hot code
+        // the rest of the time.
+        static std::atomic<bool> &collecting();
+
+        // A copy of the stats, as timers on other threads may be updating them.
+        static timers_map get_stats();
+
+        // Timers that are running keep their place in the stats, with their totals cleared.
+        static void reset_stats();
     private:
         timers_map::iterator timer;
-        std::chrono::high_resolution_clock::time_point current_start =
-            std::chrono::high_resolution_clock::now();
+        bool active = false;
+        std::chrono::high_resolution_clock::time_point current_start;
+
+        void start( std::string_view name );
+        void stop();
 
         static timers_map &top_level_timer_map();
+        // Of the calling thread.
         static std::vector<timers_map::iterator> &timer_stack();
+        // Guards the stats, shared by the timers of all the threads.
+        static std::mutex &stats_mutex();
 };
 
 #endif // CATA_SRC_PERF_H
@@ -34,6 +34,7 @@
 #include "monster.h"
 #include "pixel_minimap_projectors.h"
 #include "sdl_utils.h"
+#include "submap.h"
 #include "type_id.h"
 #include "vehicle.h"
 #include "viewer.h"
@@ -88,19 +89,20 @@ SDL_Texture_Ptr create_cache_texture( const SDL_Renderer_Ptr &renderer, int tile
                           tile_height );
 }
 
-SDL_Color get_map_color_at( const tripoint_bub_ms &p )
+// sm is the submap containing p, l the position of p within it.
+SDL_Color get_map_color_at( const map &here, const submap &sm, const tripoint_bub_ms &p,
+                            const point_sm_ms &l )
 {
-    const map &here = get_map();
     if( const optional_vpart_position vp = here.veh_at( p ) ) {
         const vpart_display vd = vp->vehicle().get_display_of_tile( vp->mount_pos() );
         return curses_color_to_SDL( vd.color );
     }
 
-    if( const furn_id &furn_id = here.furn( p ) ) {
+    if( const furn_id &furn_id = sm.get_furn( l ) ) {
         return curses_color_to_SDL( furn_id->color() );
     }
 
-    return curses_color_to_SDL( here.ter( p )->color() );
+    return curses_color_to_SDL( sm.get_ter( l )->color() );
 }
 
 SDL_Color get_critter_color( Creature *critter, int flicker, int mixture )
@@ -317,6 +319,13 @@ void pixel_minimap::update_cache_at( const tripoint_bub_sm &sm_pos )
 
     cache_item.touched = true;
 
+    // Terrain and furniture are read straight from the submap instead of resolving it per tile.
+    const submap *const sm = here.unsafe_get_submap_at( ms_pos );
+    if( sm == nullptr ) {
+        debugmsg( "Tried to update the minimap at submap %s but it is not loaded", sm_pos.to_string() );
+        return;
+    }
+
     for( int y = 0; y < SEEY; ++y ) {
         for( int x = 0; x < SEEX; ++x ) {
             const tripoint_bub_ms p = ms_pos + tripoint{x, y, 0};
@@ -328,7 +337,7 @@ void pixel_minimap::update_cache_at( const tripoint_bub_sm &sm_pos )
                 // TODO: Map memory?
                 color = { Uint8( pixel_minimap_r ), Uint8( pixel_minimap_g ), Uint8( pixel_minimap_b ), Uint8( pixel_minimap_a ) };
             } else {
-                color = get_map_color_at( p );
+                color = get_map_color_at( here, *sm, p, point_sm_ms( x, y ) );
 
                 //color terrain according to lighting conditions
                 if( nv_goggle ) {
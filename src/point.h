@@ -138,6 +138,33 @@ inline int divide_round_to_minus_infinity( int n, int d )
     return ( n - d + 1 ) / d; // NOLINT(clang-analyzer-core.DivideZero)
 }
 
+// Exponent of d, which must be a power of two.
+constexpr int power_of_two_exponent( int d )
+{
+    int exponent = 0;
+    while( ( 1 << exponent ) != d ) {
+        ++exponent;
+    }
+    return exponent;
+}
+
+// As above, with the divisor known at compile time, as it is for the scales of coordinates.h.
+// A power of two divisor becomes an arithmetic shift, which already rounds to minus infinity.
+template<int D>
+constexpr int divide_round_to_minus_infinity( int n )
+{
+    static_assert( D > 0, "divisor must be positive" );
+    if constexpr( ( D & ( D - 1 ) ) == 0 ) {
+        constexpr int shift = power_of_two_exponent( D );
+        return n >> shift;
+    } else {
+        if( n >= 0 ) {
+            return n / D;
+        }
+        return ( n - D + 1 ) / D;
+    }
+}
+
 inline point multiply_xy( const point &p, int f )
 {
     return point( p.x * f, p.y * f );
@@ -155,6 +182,21 @@ inline point divide_xy_round_to_minus_infinity_non_negative( const point &p, int
     return point( static_cast<unsigned int>( p.x ) / d, static_cast<unsigned int>( p.y ) / d );
 }
 
+template<int D>
+inline point divide_xy_round_to_minus_infinity( const point &p )
+{
+    return point( divide_round_to_minus_infinity<D>( p.x ),
+                  divide_round_to_minus_infinity<D>( p.y ) );
+}
+
+template<int D>
+inline point divide_xy_round_to_minus_infinity_non_negative( const point &p )
+{
+    static_assert( D > 0, "divisor must be positive" );
+    return point( static_cast<unsigned int>( p.x ) / static_cast<unsigned int>( D ),
+                  static_cast<unsigned int>( p.y ) / static_cast<unsigned int>( D ) );
+}
+
 // NOLINTNEXTLINE(cata-xy)
 struct tripoint {
     static constexpr int dimension = 3;
@@ -309,6 +351,18 @@ inline tripoint divide_xy_round_to_minus_infinity_non_negative( const tripoint &
     return tripoint( divide_xy_round_to_minus_infinity_non_negative( p.xy(), d ), p.z );
 }
 
+template<int D>
+inline tripoint divide_xy_round_to_minus_infinity( const tripoint &p )
+{
+    return tripoint( divide_xy_round_to_minus_infinity<D>( p.xy() ), p.z );
+}
+
+template<int D>
+inline tripoint divide_xy_round_to_minus_infinity_non_negative( const tripoint &p )
+{
+    return tripoint( divide_xy_round_to_minus_infinity_non_negative<D>( p.xy() ), p.z );
+}
+
 inline constexpr const point point::min = { INT_MIN, INT_MIN };
 inline constexpr const point point::max = { INT_MAX, INT_MAX };
 inline constexpr const point point::invalid = point::min;
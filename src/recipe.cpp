@@ -43,6 +43,7 @@
 #include "skill.h"
 #include "string_formatter.h"
 #include "string_id_utils.h"
+#include "translation_cache.h"
 #include "translations.h"
 #include "type_id.h"
 #include "uistate.h"
@@ -588,6 +589,8 @@ static cata::value_ptr<parameterized_build_reqs> calculate_all_blueprint_reqs(
 
 void recipe::finalize()
 {
+    // A name asked for while loading may be from before the result or name was copied over.
+    cached_result_name_version = INVALID_LANGUAGE_VERSION;
     if( bp_autocalc ) {
         bp_build_reqs = calculate_all_blueprint_reqs( blueprint, bp_parameter_names );
     } else if( test_mode && check_blueprint_needs ) {
@@ -1228,6 +1231,21 @@ std::string recipe::batch_savings_string() const
 }
 
 std::string recipe::result_name( const bool decorated ) const
+{
+    // Searching and sorting the crafting menu asks for the names of all recipes each time.
+    const int language_version = detail::get_current_language_version();
+    if( cached_result_name_version != language_version ) {
+        cached_result_name = undecorated_result_name();
+        cached_result_name_version = language_version;
+    }
+    if( decorated &&
+        uistate.favorite_recipes.find( this->ident() ) != uistate.favorite_recipes.end() ) {
+        return "* " + cached_result_name;
+    }
+    return cached_result_name;
+}
+
+std::string recipe::undecorated_result_name() const
 {
     std::string name;
     if( !name_.empty() ) {
@@ -1247,10 +1265,6 @@ std::string recipe::result_name( const bool decorated ) const
         }
         name = temp_item.tname( 1, segs );
     }
-    if( decorated &&
-        uistate.favorite_recipes.find( this->ident() ) != uistate.favorite_recipes.end() ) {
-        name = "* " + name;
-    }
     return name;
 }
 
@@ -16,6 +16,7 @@
 #include "calendar.h"
 #include "requirements.h"
 #include "translation.h"
+#include "translation_cache.h"
 #include "type_id.h"
 #include "value_ptr.h"
 
@@ -305,11 +306,16 @@ class recipe
 
     private:
         void incorporate_build_reqs();
+        std::string undecorated_result_name() const;
         void add_requirements( const std::vector<std::pair<requirement_id, int>> &reqs );
 
         recipe_id id = recipe_id::NULL_ID();
         std::vector<std::pair<recipe_id, mod_id>> src;
 
+        /** Undecorated @ref result_name, for the language version it was made in. */
+        mutable std::string cached_result_name;
+        mutable int cached_result_name_version = INVALID_LANGUAGE_VERSION;
+
         /** Abstract recipes can be inherited from but are themselves disposed of at finalization */
         bool abstract = false;
 
@@ -26,8 +26,10 @@ class safe_reference
     public:
         safe_reference() = default;
 
+        // The anchor only tells whether the object is still alive, so there's no need to lock
+        // it (and touch its reference count) to get the object.
         T *get() const {
-            return impl.lock().get();
+            return impl.expired() ? nullptr : object;
         }
 
         explicit operator bool() const {
@@ -48,9 +50,10 @@ class safe_reference
     private:
         friend class safe_reference_anchor;
 
-        explicit safe_reference( const std::shared_ptr<T> &p ) : impl( p ) {}
+        explicit safe_reference( const std::shared_ptr<T> &p ) : impl( p ), object( p.get() ) {}
 
         std::weak_ptr<T> impl;
+        T *object = nullptr;
 };
 
 class safe_reference_anchor
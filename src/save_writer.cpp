@@ -0,0 +1,286 @@
+#include "save_writer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <optional>
+
+#if !defined(_WIN32) && !defined(EMSCRIPTEN)
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "cached_options.h"
+#include "cata_thread_pool.h"
+#include "debug.h"
+#include "output.h"
+#include "string_formatter.h"
+#include "translations.h"
+
+#if !defined(_WIN32) && !defined(EMSCRIPTEN)
+// Waits for the forked save to exit, and returns why it failed if it did.
+static std::optional<std::string> reap( const pid_t pid )
+{
+    int status = 0;
+    while( waitpid( pid, &status, 0 ) < 0 ) {
+        if( errno != EINTR ) {
+            return string_format( "waitpid failed: %s", strerror( errno ) );
+        }
+    }
+    if( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 ) {
+        return std::nullopt;
+    }
+    if( WIFSIGNALED( status ) ) {
+        return string_format( "forked save killed by signal %d", WTERMSIG( status ) );
+    }
+    return string_format( "forked save exited with status %d", WEXITSTATUS( status ) );
+}
+
+// Reads everything until the other end is closed, then closes this one.
+static std::string read_all( const int fd )
+{
+    std::string data;
+    char buffer[4096];
+    while( true ) {
+        const ssize_t n = read( fd, buffer, sizeof( buffer ) );
+        if( n > 0 ) {
+            data.append( buffer, n );
+        } else if( n == 0 || errno != EINTR ) {
+            break;
+        }
+    }
+    close( fd );
+    return data;
+}
+
+static void write_all( const int fd, const std::string &data )
+{
+    size_t written = 0;
+    while( written < data.size() ) {
+        const ssize_t n = write( fd, data.data() + written, data.size() - written );
+        if( n > 0 ) {
+            written += n;
+        } else if( n < 0 && errno != EINTR ) {
+            break;
+        }
+    }
+}
+#endif
+
+save_writer::save_writer()
+{
+    worker = std::thread( [this]() {
+        worker_loop();
+    } );
+}
+
+save_writer::~save_writer()
+{
+    {
+        std::lock_guard<std::mutex> lk( tasks_mutex );
+        stopping = true;
+    }
+    tasks_cv.notify_all();
+    worker.join();
+}
+
+void save_writer::enqueue( const std::string &target, std::string what,
+                           std::function<void()> write )
+{
+    if( inline_writes ) {
+        try {
+            write();
+        } catch( const std::exception &err ) {
+            errors.emplace_back( std::move( what ), err.what() );
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk( tasks_mutex );
+        ++pending[target];
+        tasks.push_back( task{ target, std::move( what ), std::move( write ) } );
+    }
+    tasks_cv.notify_one();
+}
+
+void save_writer::wait_for( const std::string &target )
+{
+    std::unique_lock<std::mutex> lk( tasks_mutex );
+    done_cv.wait( lk, [&]() {
+        return pending.count( target ) == 0 && child == 0;
+    } );
+}
+
+bool save_writer::is_pending( const std::string &target )
+{
+    std::lock_guard<std::mutex> lk( tasks_mutex );
+    return pending.count( target ) != 0 || child != 0;
+}
+
+bool save_writer::is_idle()
+{
+    std::lock_guard<std::mutex> lk( tasks_mutex );
+    return pending.empty() && child == 0;
+}
+
+bool save_writer::flush()
+{
+    std::vector<std::pair<std::string, std::string>> failed;
+    {
+        std::unique_lock<std::mutex> lk( tasks_mutex );
+        done_cv.wait( lk, [this]() {
+            return pending.empty() && child == 0;
+        } );
+        failed.swap( errors );
+    }
+    for( const std::pair<std::string, std::string> &error : failed ) {
+        const std::string msg = string_format( _( "Failed to save %1$s: %2$s" ), error.first,
+                                               error.second );
+        if( test_mode ) {
+            DebugLog( D_ERROR, DC_ALL ) << msg;
+        } else {
+            popup( "%s", msg );
+        }
+    }
+    return failed.empty();
+}
+
+void save_writer::worker_loop()
+{
+    while( true ) {
+        task next;
+        {
+            std::unique_lock<std::mutex> lk( tasks_mutex );
+            tasks_cv.wait( lk, [this]() {
+                return stopping || child != 0 || !tasks.empty();
+            } );
+#if !defined(_WIN32) && !defined(EMSCRIPTEN)
+            // Writes queued after the fork may change the files the forked save writes
+            if( child != 0 ) {
+                const pid_t pid = child;
+                const int report_fd = child_report_fd;
+                lk.unlock();
+                // Read first, the copy cannot exit while the pipe is full.
+                std::string report = report_fd >= 0 ? read_all( report_fd ) : std::string();
+                std::optional<std::string> error = reap( pid );
+                lk.lock();
+                if( error ) {
+                    errors.emplace_back( child_what, *error );
+                }
+                finished_fork = fork_result{ !error, error ? std::string() : std::move( report ) };
+                child_report_fd = -1;
+                child = 0;
+                lk.unlock();
+                done_cv.notify_all();
+                continue;
+            }
+#endif
+            // Finish every write before stopping, or the save would be left half written
+            if( tasks.empty() ) {
+                return;
+            }
+            next = std::move( tasks.front() );
+            tasks.pop_front();
+        }
+        std::optional<std::string> error;
+        try {
+            next.write();
+        } catch( const std::exception &err ) {
+            error = err.what();
+        }
+        {
+            std::lock_guard<std::mutex> lk( tasks_mutex );
+            if( error ) {
+                errors.emplace_back( next.what, *error );
+            }
+            if( --pending[next.target] == 0 ) {
+                pending.erase( next.target );
+            }
+        }
+        done_cv.notify_all();
+    }
+}
+
+std::optional<save_writer::fork_result> save_writer::take_fork_result()
+{
+    std::lock_guard<std::mutex> lk( tasks_mutex );
+    std::optional<fork_result> result = std::move( finished_fork );
+    finished_fork.reset();
+    return result;
+}
+
+bool save_writer::run_in_fork( const std::function<bool()> &save, std::string what,
+                               const std::function<std::string()> &report )
+{
+#if defined(_WIN32) || defined(EMSCRIPTEN)
+    ( void )save;
+    ( void )what;
+    ( void )report;
+    return false;
+#else
+    // The copy only has the thread that forks, so it must not need anything another thread
+    // was doing, nor a lock one of them held.
+    cata::get_thread_pool().wait_until_idle();
+    std::unique_lock<std::mutex> lk( tasks_mutex );
+    done_cv.wait( lk, [this]() {
+        return pending.empty() && child == 0;
+    } );
+    int report_pipe[2] = { -1, -1 };
+    if( report && pipe( report_pipe ) != 0 ) {
+        DebugLog( D_WARNING, DC_ALL ) << "pipe failed, saving in this process: " << strerror( errno );
+        return false;
+    }
+    const pid_t pid = fork();
+    if( pid < 0 ) {
+        DebugLog( D_WARNING, DC_ALL ) << "fork failed, saving in this process: " << strerror( errno );
+        if( report ) {
+            close( report_pipe[0] );
+            close( report_pipe[1] );
+        }
+        return false;
+    }
+    if( pid == 0 ) {
+        lk.unlock();
+        if( report ) {
+            close( report_pipe[0] );
+        }
+        inline_writes = true;
+        cata::get_thread_pool().run_on_caller_only();
+        // The copy shares the window and terminal, so it must not draw or read input.
+        test_mode = true;
+        const int null_fd = open( "/dev/null", O_RDWR );
+        if( null_fd >= 0 ) {
+            dup2( null_fd, STDIN_FILENO );
+            dup2( null_fd, STDOUT_FILENO );
+        }
+        bool saved = false;
+        try {
+            saved = save();
+            if( saved && report ) {
+                write_all( report_pipe[1], report() );
+            }
+        } catch( ... ) {
+            saved = false;
+        }
+        // Nothing may run the destructors of the threads that do not exist here.
+        _exit( saved ? 0 : 1 );
+    }
+    if( report ) {
+        close( report_pipe[1] );
+    }
+    child = pid;
+    child_what = std::move( what );
+    child_report_fd = report_pipe[0];
+    finished_fork.reset();
+    lk.unlock();
+    tasks_cv.notify_one();
+    return true;
+#endif
+}
+
+save_writer &get_save_writer()
+{
+    static save_writer writer;
+    return writer;
+}
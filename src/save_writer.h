@@ -0,0 +1,108 @@
+#pragma once
+#ifndef CATA_SRC_SAVE_WRITER_H
+#define CATA_SRC_SAVE_WRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+/**
+ * A thread that writes save files in the order they were queued, so the game can go on while
+ * data it has already serialized goes to disk.
+ *
+ * Writes must only touch the file they were queued for, and must not use the UI.  Anything
+ * that reads a save file the writer may still be writing has to wait for it first.
+ */
+class save_writer
+{
+    public:
+        save_writer();
+        ~save_writer();
+
+        save_writer( const save_writer & ) = delete;
+        save_writer &operator=( const save_writer & ) = delete;
+
+        /**
+         * Queue write to run after every write queued before it.  target is the path of the
+         * file it changes, what names the data for error messages.  write reports failure by
+         * throwing.
+         */
+        void enqueue( const std::string &target, std::string what, std::function<void()> write );
+
+        // Wait until no queued write changes target.
+        void wait_for( const std::string &target );
+
+        // True if a queued or running write changes target.
+        bool is_pending( const std::string &target );
+
+        // True if nothing is queued or running.
+        bool is_idle();
+
+        /**
+         * Wait for every queued write to finish.  Returns false, after telling the player,
+         * if any of them failed since the last flush.
+         */
+        bool flush();
+
+        /**
+         * Run save in a forked copy of this process and return true at once, or return false
+         * without running it where the process cannot be forked.  The copy writes the game as
+         * it was at the fork while this process goes on.  Until the copy exits, every file
+         * counts as being written, so whatever waits for a write waits for it too.  If save
+         * returns false, the next flush reports that what failed to be saved.  If report is
+         * given, the copy runs it after a successful save and hands what it returns back to
+         * this process, see take_fork_result.
+         */
+        bool run_in_fork( const std::function<bool()> &save, std::string what,
+                          const std::function<std::string()> &report = nullptr );
+
+        struct fork_result {
+            bool saved = false;
+            std::string report;
+        };
+        // How the last forked save went, once after it exited, nullopt until then.
+        std::optional<fork_result> take_fork_result();
+
+    private:
+        struct task {
+            std::string target;
+            std::string what;
+            std::function<void()> write;
+        };
+
+        void worker_loop();
+
+        std::thread worker;
+        std::deque<task> tasks;
+        // Number of queued or running writes for each target
+        std::unordered_map<std::string, int> pending;
+        // What failed to be written and why, reported by the next flush
+        std::vector<std::pair<std::string, std::string>> errors;
+        std::mutex tasks_mutex;
+        std::condition_variable tasks_cv;
+        std::condition_variable done_cv;
+        bool stopping = false;
+        // Process id of the forked save that has not exited yet, and what it saves
+        int child = 0;
+        std::string child_what;
+        // Read end of the pipe the forked save sends its report through, -1 if none
+        int child_report_fd = -1;
+        std::optional<fork_result> finished_fork;
+        // In the forked copy, which has no worker thread, writes run as they are queued
+        bool inline_writes = false;
+};
+
+save_writer &get_save_writer();
+
+#endif // CATA_SRC_SAVE_WRITER_H
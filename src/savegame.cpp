@@ -432,6 +432,19 @@ void overmap::unserialize( std::istream &fin )
     unserialize( jsin.get_object() );
 }
 
+void overmap::unserialize_dynamic( std::istream &fin )
+{
+    // Saves that keep these apart still carry them in the terrain file if the last save was
+    // interrupted between writing the two files; the separate file is the newer one.
+    zg.clear();
+    monster_map.clear();
+    vehicles.clear();
+    scents.clear();
+    npcs.clear();
+    camps.clear();
+    unserialize( fin );
+}
+
 void overmap::unserialize( const JsonObject &jsobj )
 {
     // These must be read in this order.
@@ -497,6 +510,9 @@ void overmap::unserialize( const JsonObject &jsobj )
                 }
             }
         }
+        for( map_layer &l : layer ) {
+            l.uniform_terrain_known = false;
+        }
         migrate_oter_ids( oter_id_migrations );
         migrate_camps( camps_to_place );
     }
@@ -856,6 +872,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                     }
                 }
             }
+            layer[z + OVERMAP_DEPTH].uniform_terrain_known = false;
         }
         migrate_oter_ids( oter_id_migrations );
     }
@@ -1245,7 +1262,36 @@ void overmap::serialize( std::ostream &fout ) const
 
     JsonOut json( fout, false );
     json.start_object();
+    serialize_static_members( json, fout );
+    serialize_dynamic_members( json, fout );
+    json.end_object();
+    fout << std::endl;
+}
+
+void overmap::serialize_static( std::ostream &fout ) const
+{
+    fout << "# version " << savegame_version << std::endl;
+
+    JsonOut json( fout, false );
+    json.start_object();
+    serialize_static_members( json, fout );
+    json.end_object();
+    fout << std::endl;
+}
+
+void overmap::serialize_dynamic( std::ostream &fout ) const
+{
+    fout << "# version " << savegame_version << std::endl;
+
+    JsonOut json( fout, false );
+    json.start_object();
+    serialize_dynamic_members( json, fout );
+    json.end_object();
+    fout << std::endl;
+}
 
+void overmap::serialize_static_members( JsonOut &json, std::ostream &fout ) const
+{
     json.member( "layers" );
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
@@ -1285,9 +1331,6 @@ void overmap::serialize( std::ostream &fout ) const
     json.member( "region_id", settings->id );
     fout << std::endl;
 
-    save_monster_groups( json );
-    fout << std::endl;
-
     json.member( "cities" );
     json.start_array();
     for( const city &i : cities ) {
@@ -1344,56 +1387,6 @@ void overmap::serialize( std::ostream &fout ) const
     json.end_array();
     fout << std::endl;
 
-    json.member( "monster_map" );
-    json.start_array();
-    for( const auto &i : monster_map ) {
-        i.first.serialize( json );
-        i.second.serialize( json );
-    }
-    json.end_array();
-    fout << std::endl;
-
-    json.member( "tracked_vehicles" );
-    json.start_array();
-    for( const auto &i : vehicles ) {
-        json.start_object();
-        json.member( "id", i.first );
-        json.member( "name", i.second.name );
-        json.member( "x", i.second.p.x() );
-        json.member( "y", i.second.p.y() );
-        json.end_object();
-    }
-    json.end_array();
-    fout << std::endl;
-
-    json.member( "scent_traces" );
-    json.start_array();
-    for( const auto &scent : scents ) {
-        json.start_object();
-        json.member( "pos", scent.first );
-        json.member( "time", scent.second.creation_time );
-        json.member( "strength", scent.second.initial_strength );
-        json.end_object();
-    }
-    json.end_array();
-    fout << std::endl;
-
-    json.member( "npcs" );
-    json.start_array();
-    for( const auto &i : npcs ) {
-        json.write( *i );
-    }
-    json.end_array();
-    fout << std::endl;
-
-    json.member( "camps" );
-    json.start_array();
-    for( const basecamp &i : camps ) {
-        json.write( i );
-    }
-    json.end_array();
-    fout << std::endl;
-
     // Condense the overmap special placements so that all placements of a given special
     // are grouped under a single key for that special.
     std::map<overmap_special_id, std::vector<tripoint_om_omt>> condensed_overmap_special_placements;
@@ -1463,8 +1456,62 @@ void overmap::serialize( std::ostream &fout ) const
         predecessors_.begin(), predecessors_.end() );
     json.member( "predecessors", flattened_predecessors );
     fout << std::endl;
+}
 
-    json.end_object();
+void overmap::serialize_dynamic_members( JsonOut &json, std::ostream &fout ) const
+{
+    ensure_dynamic_loaded();
+    save_monster_groups( json );
+    fout << std::endl;
+
+    json.member( "monster_map" );
+    json.start_array();
+    for( const auto &i : monster_map ) {
+        i.first.serialize( json );
+        i.second.serialize( json );
+    }
+    json.end_array();
+    fout << std::endl;
+
+    json.member( "tracked_vehicles" );
+    json.start_array();
+    for( const auto &i : vehicles ) {
+        json.start_object();
+        json.member( "id", i.first );
+        json.member( "name", i.second.name );
+        json.member( "x", i.second.p.x() );
+        json.member( "y", i.second.p.y() );
+        json.end_object();
+    }
+    json.end_array();
+    fout << std::endl;
+
+    json.member( "scent_traces" );
+    json.start_array();
+    for( const auto &scent : scents ) {
+        json.start_object();
+        json.member( "pos", scent.first );
+        json.member( "time", scent.second.creation_time );
+        json.member( "strength", scent.second.initial_strength );
+        json.end_object();
+    }
+    json.end_array();
+    fout << std::endl;
+
+    json.member( "npcs" );
+    json.start_array();
+    for( const auto &i : npcs ) {
+        json.write( *i );
+    }
+    json.end_array();
+    fout << std::endl;
+
+    json.member( "camps" );
+    json.start_array();
+    for( const basecamp &i : camps ) {
+        json.write( i );
+    }
+    json.end_array();
     fout << std::endl;
 }
 
@@ -1632,6 +1679,7 @@ void weather_manager::unserialize_all( const JsonObject &w )
 void global_variables::unserialize( const JsonObject &jo )
 {
     // global variables
+    ++generation;
     jo.read( "global_vals", global_values );
     // potentially migrate some variable names
     for( std::pair<std::string, std::string> migration : migrations ) {
@@ -1829,7 +1877,7 @@ void creature_tracker::deserialize( const JsonArray &ja )
     monsters_by_location.clear();
     for( JsonValue jv : ja ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
-        shared_ptr_fast<monster> mptr = make_shared_fast<monster>();
+        shared_ptr_fast<monster> mptr = make_pooled_shared_fast<monster>();
         jv.read( *mptr );
         add( mptr );
     }
@@ -2513,6 +2513,10 @@ void monster::load( const JsonObject &data )
         battery_item = cata::make_value<item>( newitem );
     }
     data.read( "hp", hp );
+    if( is_dead_state() ) {
+        // So that game::cleanup_dead looks for it.
+        g->set_critter_died();
+    }
 
     // sp_timeout indicates an old save, prior to the special_attacks refactor
     if( data.has_array( "sp_timeout" ) ) {
@@ -4007,7 +4011,7 @@ void player_morale::load( const JsonObject &jsin )
     jsin.read( "morale", points );
 }
 
-void mm_submap::serialize( JsonOut &jsout ) const
+void mm_submap::serialize( JsonOut &jsout, mm_string_table &strings ) const
 {
     jsout.start_array();
 
@@ -4020,11 +4024,11 @@ void mm_submap::serialize( JsonOut &jsout ) const
         jsout.start_array();
         jsout.write( num_same );
         jsout.write( static_cast<int>( last.symbol ) );
-        jsout.write( last.ter_id );
+        jsout.write( strings.index_of( last.ter_id ) );
         jsout.write( static_cast<int>( last.ter_subtile ) );
         jsout.write( static_cast<int>( last.ter_rotation ) );
-        if( !last.get_dec_id().empty() ) {
-            jsout.write( last.dec_id );
+        if( last.dec_id != 0 ) {
+            jsout.write( strings.index_of( last.dec_id ) );
             jsout.write( static_cast<int>( last.dec_subtile ) );
             jsout.write( static_cast<int>( last.dec_rotation ) );
         }
@@ -4052,7 +4056,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( int version, const JsonArray &ja )
+void mm_submap::deserialize( int version, const JsonArray &ja, const mm_string_table &strings )
 {
     size_t submap_array_idx = 0;
 
@@ -4082,7 +4086,7 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
                         tile.set_dec_id( std::move( id ) );
                         tile.set_dec_subtile( ja_tile.get_int( 1 ) );
                         const int legacy_rotation = ja_tile.get_int( 2 );
-                        if( string_starts_with( tile.dec_id, "vp_" ) ) {
+                        if( string_starts_with( tile.get_dec_id(), "vp_" ) ) {
                             // legacy vehicle rotation needs to be converted from 0-360 degrees
                             // to 0-3 tileset rotation
                             const units::angle legacy_angle = units::from_degrees( legacy_rotation );
@@ -4098,11 +4102,20 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
                 } else {
                     remaining = ja_tile.get_int( 0 ) - 1;
                     tile.symbol = ja_tile.get_int( 1 );
-                    tile.set_ter_id( ja_tile.get_string( 2 ) );
+                    // Since version 2 ids are saved once per region.
+                    if( version < 2 ) {
+                        tile.set_ter_id( ja_tile.get_string( 2 ) );
+                    } else {
+                        tile.ter_id = strings.id_at( ja_tile.get_int( 2 ) );
+                    }
                     tile.ter_subtile = ja_tile.get_int( 3 );
                     tile.ter_rotation = ja_tile.get_int( 4 );
                     if( ja_tile.size() > 5 ) {
-                        tile.set_dec_id( ja_tile.get_string( 5 ) );
+                        if( version < 2 ) {
+                            tile.set_dec_id( ja_tile.get_string( 5 ) );
+                        } else {
+                            tile.dec_id = strings.id_at( ja_tile.get_int( 5 ) );
+                        }
                         tile.dec_subtile = ja_tile.get_int( 6 );
                         tile.dec_rotation = ja_tile.get_int( 7 );
                     } else {
@@ -4122,8 +4135,9 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    mm_string_table strings;
     jsout.start_object();
-    jsout.member( "version", 1 );
+    jsout.member( "version", 2 );
     jsout.write( "data" );
     jsout.write_member_separator();
     jsout.start_array();
@@ -4134,11 +4148,17 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, strings );
             }
         }
     }
     jsout.end_array();
+    jsout.member( "strings" );
+    jsout.start_array();
+    for( const uint32_t id : strings.ids ) {
+        jsout.write( memorized_tile::interned( id ) );
+    }
+    jsout.end_array();
     jsout.end_object();
 }
 
@@ -4146,6 +4166,7 @@ void mm_region::deserialize( const JsonValue &ja )
 {
     int version;
     JsonArray region_json;
+    mm_string_table strings;
 
     if( ja.test_array() ) { // legacy, remove after 0.H comes out
         version = 0;
@@ -4154,16 +4175,21 @@ void mm_region::deserialize( const JsonValue &ja )
         JsonObject region_obj = ja;
         version = region_obj.get_int( "version" );
         region_json = region_obj.get_array( "data" );
+        if( version >= 2 ) {
+            for( const std::string id : region_obj.get_array( "strings" ) ) {
+                strings.ids.push_back( memorized_tile::intern( id ) );
+            }
+        }
     }
 
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
         // NOLINTNEXTLINE(modernize-loop-convert)
         for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
             shared_ptr_fast<mm_submap> &sm = submaps[x][y];
-            sm = make_shared_fast<mm_submap>();
+            sm = make_pooled_shared_fast<mm_submap>();
             const JsonValue jsin = region_json.next_value();
             if( !jsin.test_null() ) {
-                sm->deserialize( version, jsin );
+                sm->deserialize( version, jsin, strings );
             }
         }
     }
@@ -4819,6 +4845,11 @@ void field_type_migrations::check()
 void submap::store( JsonOut &jsout ) const
 {
     jsout.member( "turn_last_touched", last_touched );
+    store_contents( jsout );
+}
+
+void submap::store_contents( JsonOut &jsout ) const
+{
     jsout.member( "temperature", temperature_mod );
 
     // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
@@ -5038,6 +5069,7 @@ void submap::store( JsonOut &jsout ) const
 void submap::load( const JsonValue &jv, const std::string &member_name, int version )
 {
     ensure_nonuniform();
+    light_emitters_dirty = true;
     bool rubpow_update = version < 22;
     if( member_name == "turn_last_touched" ) {
         last_touched = time_point( jv.get_int() );
@@ -5225,6 +5257,7 @@ void submap::load( const JsonValue &jv, const std::string &member_name, int vers
                     } else if( ft != field_type_str_id::NULL_ID() &&
                                m->fld[i][j].add_field( ft.id(), intensity, time_duration::from_turns( age ) ) ) {
                         field_count++;
+                        mark_field_tile( { i, j } );
                     }
                 } else { // Handle removed int enum method
                     field_json.next_value(); // Skip intensity
@@ -96,18 +96,18 @@ class CachedTTFFont : public Font
             std::string   codepoints;
             unsigned char color;
 
-            std::pair<std::string, unsigned char> as_pair() const {
-                return std::make_pair( codepoints, color );
-            }
-
+            // Compared and hashed in place, this runs for every glyph drawn.
             friend bool operator==( const key_t &lhs, const key_t &rhs ) noexcept {
-                return lhs.as_pair() == rhs.as_pair();
+                return lhs.color == rhs.color && lhs.codepoints == rhs.codepoints;
             }
         };
 
         struct key_t_hash {
             size_t operator()( const key_t &k ) const {
-                return cata::auto_hash<std::pair<std::string, unsigned char>>()( k.as_pair() );
+                size_t seed = 0;
+                cata::hash_combine( seed, k.codepoints );
+                cata::hash_combine( seed, k.color );
+                return seed;
             }
         };
 
@@ -1261,6 +1261,47 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
                         color_as_sdl( catacurses::black ) );
         update = true;
         win->line[j].touched = false;
+
+        // Backgrounds first, so that neighbouring cells of the same colour (highlighted
+        // lines, selection bars) are filled with one rect instead of one per cell.
+        // Glyphs never reach into the neighbouring cells, so drawing them afterwards
+        // gives the same picture.
+        point run_start;
+        int run_width = 0;
+        catacurses::base_color run_color = catacurses::black;
+        const auto flush_background = [&]() {
+            if( run_width > 0 ) {
+                geometry->rect( renderer, run_start, run_width, font->height,
+                                color_as_sdl( run_color ) );
+                run_width = 0;
+            }
+        };
+        for( int i = 0; i < win->width; i++ ) {
+            const cursecell &cell = win->line[j].chars[i];
+
+            const point draw( offset + point( i * font->width, j * font->height ) );
+            if( draw.x + font->width > WindowWidth || draw.y + font->height > WindowHeight ||
+                cell.ch.empty() || cell.BG == catacurses::black ) {
+                continue;
+            }
+            int cw = 1;
+            if( cell.ch != space_string ) {
+                cw = UTF8_getch( cell.ch ) == UNKNOWN_UNICODE ? 1 : utf8_width( cell.ch );
+                if( cw < 1 ) {
+                    continue;
+                }
+            }
+            if( run_width > 0 && ( cell.BG != run_color || draw.x != run_start.x + run_width ) ) {
+                flush_background();
+            }
+            if( run_width == 0 ) {
+                run_start = draw;
+                run_color = cell.BG;
+            }
+            run_width += font->width * cw;
+        }
+        flush_background();
+
         for( int i = 0; i < win->width; i++ ) {
             const cursecell &cell = win->line[j].chars[i];
 
@@ -1276,15 +1317,10 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
 
             // Spaces are used a lot, so this does help noticeably
             if( cell.ch == space_string ) {
-                if( cell.BG != catacurses::black ) {
-                    geometry->rect( renderer, draw, font->width, font->height,
-                                    color_as_sdl( cell.BG ) );
-                }
                 continue;
             }
             const int codepoint = UTF8_getch( cell.ch );
             const catacurses::base_color FG = cell.FG;
-            const catacurses::base_color BG = cell.BG;
             int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( cell.ch );
             if( cw < 1 ) {
                 // utf8_width() may return a negative width
@@ -1333,10 +1369,6 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
                     use_draw_ascii_lines_routine = false;
                     break;
             }
-            if( cell.BG != catacurses::black ) {
-                geometry->rect( renderer, draw, font->width * cw, font->height,
-                                color_as_sdl( BG ) );
-            }
             if( use_draw_ascii_lines_routine ) {
                 font->draw_ascii_lines( renderer, geometry, uc, draw, FG );
             } else {
@@ -1,5 +1,6 @@
 #include "shadowcasting.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <iterator>
@@ -62,6 +63,45 @@ struct span {
     bool skip_first_column;
 };
 
+template<typename T>
+static T grid_value( const cata::mdarray<T, point_bub_ms> &grid, const int x, const int y )
+{
+    return grid[x][y];
+}
+
+static float grid_value( const transparency_palette_grid &grid, const int x, const int y )
+{
+    return grid( x, y );
+}
+
+void transparency_palette_grid::build( const cata::mdarray<float, point_bub_ms> &source )
+{
+    int num_values = 0;
+    // Runs of equal values are common, so try the previous tile's index first.
+    uint8_t last_index = 0;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const float value = source[x][y];
+            if( num_values == 0 || palette[last_index] != value ) {
+                const auto palette_end = palette.begin() + num_values;
+                const auto found = std::find( palette.begin(), palette_end, value );
+                if( found != palette_end ) {
+                    last_index = static_cast<uint8_t>( std::distance( palette.begin(), found ) );
+                } else if( num_values < max_values ) {
+                    palette[num_values] = value;
+                    last_index = static_cast<uint8_t>( num_values );
+                    ++num_values;
+                } else {
+                    valid = false;
+                    return;
+                }
+            }
+            indices[x][y] = last_index;
+        }
+    }
+    valid = true;
+}
+
 /**
  * Handle splitting the current span in cast_horizontal_zlight_segment and
  * cast_vertical_zlight_segment to avoid as much code duplication as possible
@@ -161,10 +201,10 @@ static void split_span( cata::list<span<T>> &spans,
 template<int xx_transform, int xy_transform, int yx_transform, int yy_transform, int z_transform, typename T,
          T( *calc )( const T &, const T &, const int & ),
          bool( *is_transparent )( const T &, const T & ),
-         T( *accumulate )( const T &, const T &, const int & )>
+         T( *accumulate )( const T &, const T &, const int & ), typename Input>
 void cast_horizontal_zlight_segment(
     const array_of_grids_of<T> &output_caches,
-    const array_of_grids_of<const T> &input_arrays,
+    const std::array<const Input *, OVERMAP_LAYERS> &input_arrays,
     const array_of_grids_of<const bool> &floor_caches,
     const tripoint_bub_ms &offset, const int offset_distance,
     const T numerator )
@@ -200,6 +240,10 @@ void cast_horizontal_zlight_segment(
 
         for( auto this_span = spans.begin(); this_span != spans.end(); ) {
             bool started_block = false;
+            // The span's cumulative value only changes once per distance, so tiles at the
+            // same rl_dist share their intensity and calc() can be skipped for them.
+            int calc_dist = -1;
+            T calc_intensity( 0.0f );
             // TODO: Precalculate min/max delta.z based on start/end and distance
             for( delta.z() = 0; delta.z() <= distance; delta.z()++ ) {
                 // Shadowcasting sweeps from the cardinal to the most extreme edge of the octant
@@ -275,7 +319,7 @@ void cast_horizontal_zlight_segment(
                         break;
                     }
 
-                    T new_transparency = ( *input_arrays[z_index] )[current.x()][current.y()];
+                    T new_transparency = grid_value( *input_arrays[z_index], current.x(), current.y() );
 
                     // If we're looking at a tile with floor or roof from the floor/roof side,
                     // that tile is actually invisible to us.
@@ -300,7 +344,11 @@ void cast_horizontal_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_rel_ms::zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    if( dist != calc_dist ) {
+                        calc_dist = dist;
+                        calc_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    }
+                    last_intensity = calc_intensity;
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x()][current.y()] =
@@ -358,10 +406,10 @@ void cast_horizontal_zlight_segment(
 template<int x_transform, int y_transform, int z_transform, typename T,
          T( *calc )( const T &, const T &, const int & ),
          bool( *is_transparent )( const T &, const T & ),
-         T( *accumulate )( const T &, const T &, const int & )>
+         T( *accumulate )( const T &, const T &, const int & ), typename Input>
 void cast_vertical_zlight_segment(
     const array_of_grids_of<T> &output_caches,
-    const array_of_grids_of<const T> &input_arrays,
+    const std::array<const Input *, OVERMAP_LAYERS> &input_arrays,
     const array_of_grids_of<const bool> &floor_caches,
     const tripoint_bub_ms &offset, const int offset_distance,
     const T numerator )
@@ -395,6 +443,10 @@ void cast_vertical_zlight_segment(
 
         for( auto this_span = spans.begin(); this_span != spans.end(); ) {
             bool started_block = false;
+            // The span's cumulative value only changes once per distance, so tiles at the
+            // same rl_dist share their intensity and calc() can be skipped for them.
+            int calc_dist = -1;
+            T calc_intensity( 0.0f );
             for( delta.y() = 0; delta.y() <= distance; delta.y()++ ) {
                 // See comment above trailing_edge_major and leading_edge_major in above function.
                 const slope trailing_edge_major( delta.y() * 2 - 1, delta.z() * 2 + 1 );
@@ -449,7 +501,7 @@ void cast_vertical_zlight_segment(
 
                     const int z_index = current.z() + OVERMAP_DEPTH;
 
-                    T new_transparency = ( *input_arrays[z_index] )[current.x()][current.y()];
+                    T new_transparency = grid_value( *input_arrays[z_index], current.x(), current.y() );
 
                     // If we're looking at a tile with floor or roof from the floor/roof side,
                     // that tile is actually invisible to us.
@@ -472,7 +524,11 @@ void cast_vertical_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_rel_ms::zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    if( dist != calc_dist ) {
+                        calc_dist = dist;
+                        calc_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    }
+                    last_intensity = calc_intensity;
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x()][current.y()] =
@@ -529,10 +585,10 @@ void cast_vertical_zlight_segment(
 
 template<typename T, T( *calc )( const T &, const T &, const int & ),
          bool( *is_transparent )( const T &, const T & ),
-         T( *accumulate )( const T &, const T &, const int & )>
-void cast_zlight(
+         T( *accumulate )( const T &, const T &, const int & ), typename Input>
+static void cast_zlight_impl(
     const array_of_grids_of<T> &output_caches,
-    const array_of_grids_of<const T> &input_arrays,
+    const std::array<const Input *, OVERMAP_LAYERS> &input_arrays,
     const array_of_grids_of<const bool> &floor_caches,
     const tripoint_bub_ms &origin, const int offset_distance, const T numerator,
     vertical_direction dir )
@@ -662,6 +718,34 @@ void cast_zlight(
     }
 }
 
+template<typename T, T( *calc )( const T &, const T &, const int & ),
+         bool( *is_transparent )( const T &, const T & ),
+         T( *accumulate )( const T &, const T &, const int & )>
+void cast_zlight(
+    const array_of_grids_of<T> &output_caches,
+    const array_of_grids_of<const T> &input_arrays,
+    const array_of_grids_of<const bool> &floor_caches,
+    const tripoint_bub_ms &origin, const int offset_distance, const T numerator,
+    vertical_direction dir )
+{
+    cast_zlight_impl<T, calc, is_transparent, accumulate>(
+        output_caches, input_arrays, floor_caches, origin, offset_distance, numerator, dir );
+}
+
+template<typename T, T( *calc )( const T &, const T &, const int & ),
+         bool( *is_transparent )( const T &, const T & ),
+         T( *accumulate )( const T &, const T &, const int & )>
+void cast_zlight(
+    const array_of_grids_of<T> &output_caches,
+    const std::array<const transparency_palette_grid *, OVERMAP_LAYERS> &input_grids,
+    const array_of_grids_of<const bool> &floor_caches,
+    const tripoint_bub_ms &origin, const int offset_distance, const T numerator,
+    vertical_direction dir )
+{
+    cast_zlight_impl<T, calc, is_transparent, accumulate>(
+        output_caches, input_grids, floor_caches, origin, offset_distance, numerator, dir );
+}
+
 // I can't figure out how to make implicit instantiation work when the parameters of
 // the template-supplied function pointers are involved, so I'm explicitly instantiating instead.
 template void cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
@@ -671,6 +755,13 @@ template void cast_zlight<float, sight_calc, sight_check, accumulate_transparenc
     const tripoint_bub_ms &origin, int offset_distance, float numerator,
     vertical_direction dir );
 
+template void cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+    const array_of_grids_of<float> &output_caches,
+    const std::array<const transparency_palette_grid *, OVERMAP_LAYERS> &input_grids,
+    const array_of_grids_of<const bool> &floor_caches,
+    const tripoint_bub_ms &origin, int offset_distance, float numerator,
+    vertical_direction dir );
+
 template void cast_zlight<fragment_cloud, shrapnel_calc, shrapnel_check, accumulate_fragment_cloud>(
     const array_of_grids_of<fragment_cloud> &output_caches,
     const array_of_grids_of<const fragment_cloud> &input_arrays,
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <type_traits>
@@ -132,6 +133,29 @@ using array_of_grids_of =
     std::array<cata::mdarray<T, point_bub_ms>*, OVERMAP_LAYERS>
     >;
 
+/**
+ * Lossless 8-bit form of a transparency grid: each tile stores an index into a table of the
+ * distinct values found on the level. A level rarely has more than a handful of distinct
+ * transparencies, and the indices take a quarter of the memory of the float grid, which keeps
+ * the working set of a full 3D field of view in cache.
+ */
+struct transparency_palette_grid {
+    // Number of distinct values that can be stored.
+    static constexpr int max_values = 256;
+
+    std::array<float, max_values> palette;
+    cata::mdarray<uint8_t, point_bub_ms> indices;
+    // False if the source grid had too many distinct values to fit in the palette.
+    bool valid = false;
+
+    float operator()( int x, int y ) const {
+        return palette[indices[x][y]];
+    }
+
+    // Rebuild from source, setting valid to false if it doesn't fit.
+    void build( const cata::mdarray<float, point_bub_ms> &source );
+};
+
 // TODO: Generalize the floor check, allow semi-transparent floors
 template< typename T, T( *calc )( const T &, const T &, const int & ),
           bool( *check )( const T &, const T & ),
@@ -143,4 +167,15 @@ void cast_zlight(
     const tripoint_bub_ms &origin, int offset_distance, T numerator,
     vertical_direction dir = vertical_direction::BOTH );
 
+// As above, but reading transparency from palette grids. All grids must be valid.
+template< typename T, T( *calc )( const T &, const T &, const int & ),
+          bool( *check )( const T &, const T & ),
+          T( *accumulate )( const T &, const T &, const int & ) >
+void cast_zlight(
+    const array_of_grids_of<T> &output_caches,
+    const std::array<const transparency_palette_grid *, OVERMAP_LAYERS> &input_grids,
+    const array_of_grids_of<const bool> &floor_caches,
+    const tripoint_bub_ms &origin, int offset_distance, T numerator,
+    vertical_direction dir = vertical_direction::BOTH );
+
 #endif // CATA_SRC_SHADOWCASTING_H
@@ -8,6 +8,7 @@
 #include <limits>
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -407,6 +408,17 @@ int omt_cost_to_cross( int base_cost, direction dir_in, direction dir_out )
 
 } // namespace
 
+int omt_crossing_cost( int base_cost, direction dir_a, direction dir_b )
+{
+    if( dir_a == direction::CENTER ) {
+        return omt_cost_to_cross( base_cost, direction::CENTER, dir_b );
+    }
+    if( dir_b == direction::CENTER ) {
+        return omt_cost_to_cross( base_cost, direction::CENTER, dir_a );
+    }
+    return omt_cost_to_cross( base_cost, dir_a, dir_b );
+}
+
 const omt_score omt_score::rejected( -1 );
 
 omt_score::omt_score( int node_cost, bool allow_z_change ) : node_cost( node_cost ),
@@ -432,10 +444,70 @@ simple_path<tripoint_abs_omt> find_overmap_path( const tripoint_abs_omt &source,
     const point_abs_omt source_point = source.xy();
     constexpr int max_search_count = 100000;
 
+    // Flood backward from the destination alongside the search, one node for every few nodes
+    // the search expands.  If the flood runs dry before touching a node the search reached,
+    // the destination is walled in, and the search would only flood the rest of the radius
+    // before giving up.  Large enclosures are left to the search.
+    constexpr int search_steps_per_flood_step = 16;
+    constexpr size_t max_flood_count = 2048;
+    std::unordered_set<node_address, node_address_hasher> flood_seen;
+    std::vector<node_address> flood_open;
+    bool flooding = !( source == dest );
+    if( flooding ) {
+        const node_address dest_addr( ( dest - source ).raw() );
+        flood_seen.insert( dest_addr );
+        flood_open.push_back( dest_addr );
+    }
+    const auto stop_flooding = [&]() {
+        flooding = false;
+        flood_seen.clear();
+        flood_open.clear();
+    };
+    const auto flood_step = [&]() {
+        const node_address cur_addr = flood_open.back();
+        flood_open.pop_back();
+        for( direction dir : enumerate_directions( true, allow_diagonal ) ) {
+            const node_address next_addr = cur_addr.displace( dir );
+            if( known_nodes.count( next_addr ) ) {
+                // Joined the search, so the destination is reachable after all.
+                stop_flooding();
+                return;
+            }
+            if( flood_seen.count( next_addr ) ) {
+                continue;
+            }
+            const tripoint_abs_omt next_point = next_addr.to_tripoint( source );
+            if( octile_dist( source_point, next_point.xy() ) > radius ) {
+                continue;
+            }
+            const omt_score next_score = scorer( next_point );
+            if( next_score.node_cost >= 0 && ( dir == direction::ABOVECENTER ||
+                                               dir == direction::BELOWCENTER ) && !next_score.allow_z_change ) {
+                // Going backward, it's the node we'd come from that has to allow the z-level
+                // change, and it may still be entered from the side.
+                continue;
+            }
+            flood_seen.insert( next_addr );
+            if( next_score.node_cost >= 0 ) {
+                flood_open.push_back( next_addr );
+            }
+        }
+    };
+
     constexpr std::chrono::milliseconds report_period = std::chrono::milliseconds( 100 );
     std::chrono::steady_clock::time_point report_next = std::chrono::steady_clock::now();
     int progress = 0;
+    int flood_progress = 0;
     while( !open_set.empty() ) {
+        if( flooding && flood_progress++ % search_steps_per_flood_step == 0 ) {
+            if( flood_open.empty() ) {
+                return ret;
+            }
+            flood_step();
+            if( flood_seen.size() > max_flood_count ) {
+                stop_flooding();
+            }
+        }
         const node_address cur_addr = open_set.top().addr;
         open_set.pop();
         if( progress++ >= 100 ) { // stagger progress checks to 1 in 100 nodes
@@ -12,6 +12,8 @@
 #include "omdata.h"
 #include "point.h"
 
+enum class direction : unsigned;
+
 namespace pf
 {
 
@@ -122,8 +124,17 @@ struct omt_score {
 
 using omt_scoring_fn = std::function<omt_score( tripoint_abs_omt )>;
 
+/**
+ * Cost of crossing an OMT of the given cost between its neighbours in dir_a and dir_b, or
+ * between its center and one neighbour if the other direction is CENTER.  This is what
+ * find_overmap_path charges for each OMT on a path.
+ */
+int omt_crossing_cost( int base_cost, direction dir_a, direction dir_b );
+
 /**
  * Uses A* to find an approximately-cheapest path from source to destination (in 3D).
+ * A destination walled in by rejected OMTs is usually noticed without searching the whole
+ * radius.
  *
  * @param source Starting point of path
  * @param dest End point of path
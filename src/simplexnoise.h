@@ -84,6 +84,17 @@ float scaled_octave_noise_3d( float octaves,
                               float x,
                               float y,
                               float z );
+// scaled_octave_noise_3d at ( x + i, y, z ) for every i in [0, count), into out.
+void scaled_octave_noise_3d_row( float octaves,
+                                 float persistence,
+                                 float scale,
+                                 float loBound,
+                                 float hiBound,
+                                 float x,
+                                 float y,
+                                 float z,
+                                 int count,
+                                 float *out );
 float scaled_octave_noise_4d( float octaves,
                               float persistence,
                               float scale,
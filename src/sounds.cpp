@@ -52,10 +52,12 @@
 #   else
 #      include <SDL_mixer.h>
 #   endif
+#   include <atomic>
 #   include <thread>
 #   if defined(_WIN32) && !defined(_MSC_VER)
 #       include "mingw.thread.h"
 #   endif
+#   include "cata_thread_pool.h"
 
 #   define dbg(x) DebugLog((x),D_SDL) << __FILE__ << ":" << __LINE__ << ": "
 
@@ -479,6 +481,10 @@ void sounds::process_sounds()
             const tripoint_abs_sm target( abs_sm, source.z() );
             overmap_buffer.signal_hordes( target, sig_power );
         }
+        if( vol <= 0 ) {
+            // Drowned out by the weather, nothing below can hear it.
+            continue;
+        }
         // Alert all monsters (that can hear) to the sound.
         for( monster &critter : g->all_monsters() ) {
             // TODO: Generalize this to Creature::hear_sound
@@ -492,9 +498,9 @@ void sounds::process_sounds()
         for( const trap *trapType : trap::get_sound_triggered_traps() ) {
             for( const tripoint_bub_ms &tp : here.trap_locations( trapType->id ) ) {
                 const int dist = sound_distance( source, tp );
-                const trap &tr = here.tr_at( tp );
                 // Exclude traps that certainly won't hear the sound
                 if( vol * 2 > dist ) {
+                    const trap &tr = here.tr_at( tp );
                     if( tr.triggered_by_sound( vol, dist ) ) {
                         tr.trigger( tp );
                     }
@@ -1393,18 +1399,21 @@ void sfx::generate_melee_sound( const tripoint_bub_ms &source, const tripoint_bu
     if( test_mode ) {
         return;
     }
-    // If creating a new thread for each invocation is to much, we have to consider a thread
-    // pool or maybe a single thread that works continuously, but that requires a queue or similar
-    // to coordinate its work.
+    // The sounds sleep between the swing and the hit, so they get a few workers of their own
+    // instead of a new thread per swing or holding up the shared pool.  Swings while all the
+    // workers are playing stay silent, rather than queueing sounds that lag behind the fight.
+    constexpr int melee_sound_workers = 2;
+    static std::atomic<int> playing( 0 );
+    if( playing.load() >= melee_sound_workers ) {
+        return;
+    }
     try {
-        std::thread the_thread( sound_thread( source, target, hit, targ_mon, material ) );
-        try {
-            if( the_thread.joinable() ) {
-                the_thread.detach();
-            }
-        } catch( std::system_error &err ) {
-            dbg( D_ERROR ) << "Failed to detach melee sound thread: std::system_error: " << err.what();
-        }
+        static cata::thread_pool melee_sound_pool( melee_sound_workers );
+        ++playing;
+        melee_sound_pool.submit( [sound = sound_thread( source, target, hit, targ_mon, material )]() {
+            sound();
+            --playing;
+        } );
     } catch( std::system_error &err ) {
         // not a big deal, just skip playing the sound.
         dbg( D_ERROR ) << "Failed to create melee sound thread: std::system_error: " << err.what();
@@ -1,54 +1,163 @@
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
+#include "cata_assert.h"
 #include "string_id.h"
 
 namespace
 {
-using InternMapType = std::unordered_map<std::string, int>;
-using ReverseLookupVecType = std::vector<const std::string *>;
-} // namespace
+// Strings are interned in one of the shards picked by their hash, so threads interning
+// different ids at once rarely wait for each other.  Reading the string of an id takes no
+// lock at all.
+constexpr size_t kShardBits = 6;
+constexpr size_t kShards = size_t{ 1 } << kShardBits;
+// The strings of ids, by id, in chunks that never move once allocated.
+constexpr size_t kChunkBits = 14;
+constexpr size_t kChunkSize = size_t{ 1 } << kChunkBits;
+constexpr size_t kMaxChunks = 4096;
 
-static InternMapType &get_intern_map()
+class intern_table
 {
-    static InternMapType map{};
-    return map;
+    public:
+        intern_table() = default;
+        intern_table( const intern_table & ) = delete;
+        intern_table &operator=( const intern_table & ) = delete;
+        ~intern_table() {
+            for( std::atomic<const std::string **> &chunk : chunks ) {
+                delete[] chunk.load();
+            }
+        }
+
+        template<typename S>
+        int intern( S &&s ) {
+            const std::string_view view( s );
+            const size_t hash = std::hash<std::string_view>()( view );
+            shard &sh = shards[hash >> ( sizeof( size_t ) * 8 - kShardBits )];
+            std::lock_guard<std::mutex> lk( sh.mutex );
+            if( const int *found = sh.find( hash, view ) ) {
+                return *found;
+            }
+            // A deque never moves its elements, so the strings stay where the ids point.
+            const std::string &stored = sh.strings.emplace_back( std::forward<S>( s ) );
+            const int id = next_id++;
+            set_string( id, &stored );
+            sh.insert( hash, id );
+            return id;
+        }
+
+        // Only called with ids returned by intern, which stored the string before then.
+        const std::string &get( int id ) const {
+            const std::string *const *chunk = chunks[id >> kChunkBits].load( std::memory_order_acquire );
+            return *chunk[id & ( kChunkSize - 1 )];
+        }
+
+    private:
+        struct slot {
+            size_t hash = 0;
+            int id = -1;
+        };
+
+        // An open addressing table of the ids of the strings in this shard.
+        struct shard {
+            std::mutex mutex;
+            std::deque<std::string> strings;
+            std::vector<slot> slots = std::vector<slot>( 16 );
+            size_t count = 0;
+
+            const int *find( size_t hash, std::string_view s ) const;
+            void insert( size_t hash, int id );
+        };
+
+        void set_string( int id, const std::string *s ) {
+            const size_t chunk_index = static_cast<size_t>( id ) >> kChunkBits;
+            cata_assert( chunk_index < kMaxChunks );
+            const std::string **chunk = chunks[chunk_index].load( std::memory_order_acquire );
+            if( chunk == nullptr ) {
+                std::unique_ptr<const std::string *[]> fresh =
+                    std::make_unique<const std::string *[]>( kChunkSize );
+                if( chunks[chunk_index].compare_exchange_strong( chunk, fresh.get(),
+                        std::memory_order_acq_rel ) ) {
+                    chunk = fresh.release();
+                }
+            }
+            chunk[id & ( kChunkSize - 1 )] = s;
+        }
+
+        std::array<shard, kShards> shards;
+        std::array<std::atomic<const std::string **>, kMaxChunks> chunks{};
+        std::atomic<int> next_id{ 0 };
+};
+
+intern_table &get_intern_table()
+{
+    static intern_table table;
+    return table;
 }
 
-static ReverseLookupVecType &get_reverse_lookup_vec()
+const int *intern_table::shard::find( const size_t hash, const std::string_view s ) const
 {
-    static ReverseLookupVecType vec{};
-    return vec;
+    const size_t mask = slots.size() - 1;
+    for( size_t i = hash & mask; slots[i].id >= 0; i = ( i + 1 ) & mask ) {
+        if( slots[i].hash == hash && get_intern_table().get( slots[i].id ) == s ) {
+            return &slots[i].id;
+        }
+    }
+    return nullptr;
 }
 
-template<typename S>
-static int universal_string_id_intern( S &&s )
+void intern_table::shard::insert( const size_t hash, const int id )
 {
-    int next_id = get_reverse_lookup_vec().size();
-    const auto &pair = get_intern_map().emplace( std::forward<S>( s ), next_id );
-    if( pair.second ) { // inserted
-        get_reverse_lookup_vec().push_back( &pair.first->first );
+    // Kept at most half full, so lookups are short.
+    if( ( count + 1 ) * 2 > slots.size() ) {
+        std::vector<slot> old( slots.size() * 2 );
+        old.swap( slots );
+        const size_t mask = slots.size() - 1;
+        for( const slot &s : old ) {
+            if( s.id >= 0 ) {
+                size_t i = s.hash & mask;
+                while( slots[i].id >= 0 ) {
+                    i = ( i + 1 ) & mask;
+                }
+                slots[i] = s;
+            }
+        }
+    }
+    const size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    while( slots[i].id >= 0 ) {
+        i = ( i + 1 ) & mask;
     }
-    return pair.first->second;
+    slots[i] = slot{ hash, id };
+    ++count;
 }
+} // namespace
 
 int string_identity_static::string_id_intern( const std::string &s )
 {
-    return universal_string_id_intern( s );
+    return get_intern_table().intern( s );
 }
 
 int string_identity_static::string_id_intern( std::string &s )
 {
-    return universal_string_id_intern( s );
+    return get_intern_table().intern( s );
 }
 
 int string_identity_static::string_id_intern( std::string &&s )
 {
-    return universal_string_id_intern( std::move( s ) );
+    return get_intern_table().intern( std::move( s ) );
 }
 
 const std::string &string_identity_static::get_interned_string( int id )
 {
-    return *get_reverse_lookup_vec()[id];
+    return get_intern_table().get( id );
 }
 
 int string_identity_static::empty_interned_string()
@@ -8,6 +8,7 @@
 
 #include "basecamp.h"
 #include "debug.h"
+#include "hash_utils.h"
 #include "mapdata.h"
 #include "tileray.h"
 #include "trap.h"
@@ -208,6 +209,8 @@ void submap::rotate( int turns )
     if( turns == 0 ) {
         return;
     }
+    unshare_tiles();
+    light_emitters_dirty = true;
 
     const auto rotate_point = [turns]( const point_sm_ms & p ) {
         return p.rotate( turns, { SEEX, SEEY } );
@@ -247,6 +250,7 @@ void submap::rotate( int turns )
     }
 
     active_items.rotate_locations( turns, { SEEX, SEEY } );
+    rebuild_field_columns();
 
     for( submap::cosmetic_t &elem : cosmetics ) {
         elem.pos = rotate_point( elem.pos );
@@ -281,6 +285,8 @@ void submap::mirror( bool horizontally )
         return;
     }
     std::map<point_sm_ms, computer> mirror_comp;
+    unshare_tiles();
+    light_emitters_dirty = true;
 
     if( horizontally ) {
         for( int i = 0, ie = SEEX / 2; i < ie; i++ ) {
@@ -317,6 +323,7 @@ void submap::mirror( bool horizontally )
         }
         computers = mirror_comp;
     }
+    rebuild_field_columns();
 }
 
 void submap::revert_submap( submap &sr )
@@ -329,6 +336,7 @@ void submap::revert_submap( submap &sr )
     }
 
     ensure_nonuniform();
+    light_emitters_dirty = true;
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
             point_sm_ms pt( x, y );
@@ -351,12 +359,124 @@ submap submap::get_revert_submap() const
     submap ret;
     ret.uniform_ter = uniform_ter;
     if( !is_uniform() ) {
-        ret.m = std::make_unique<maptile_soa>( *m );
+        ret.m = std::make_shared<maptile_soa>( *m );
     }
 
     return ret;
 }
 
+void submap::rebuild_field_columns()
+{
+    field_columns.fill( 0 );
+    if( is_uniform() ) {
+        return;
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( m->fld[x][y].field_count() > 0 ) {
+                mark_field_tile( { x, y } );
+            }
+        }
+    }
+}
+
+bool submap::can_share_tiles() const
+{
+    if( is_uniform() || field_count > 0 ) {
+        return false;
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( !m->itm[x][y].empty() || m->fld[x][y].field_count() > 0 ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t submap::tiles_hash() const
+{
+    size_t seed = 0;
+    if( is_uniform() ) {
+        return seed;
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            cata::hash_combine( seed, m->ter[x][y].to_i() );
+            cata::hash_combine( seed, m->frn[x][y].to_i() );
+            cata::hash_combine( seed, m->trp[x][y].to_i() );
+            cata::hash_combine( seed, m->lum[x][y] );
+            cata::hash_combine( seed, m->rad[x][y] );
+        }
+    }
+    return seed;
+}
+
+bool submap::share_tiles_with( const submap &other )
+{
+    if( m == other.m ) {
+        return static_cast<bool>( m );
+    }
+    if( !can_share_tiles() || !other.can_share_tiles() ) {
+        return false;
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( m->ter[x][y] != other.m->ter[x][y] || m->frn[x][y] != other.m->frn[x][y] ||
+                m->trp[x][y] != other.m->trp[x][y] || m->lum[x][y] != other.m->lum[x][y] ||
+                m->rad[x][y] != other.m->rad[x][y] ) {
+                return false;
+            }
+        }
+    }
+    m = other.m;
+    return true;
+}
+
+size_t submap::memory_estimate() const
+{
+    size_t total = sizeof( submap ) + vehicles.size() * sizeof( vehicle );
+    if( is_uniform() ) {
+        return total;
+    }
+    total += sizeof( maptile_soa ) / m.use_count();
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            total += m->itm[x][y].size() * sizeof( item );
+        }
+    }
+    return total;
+}
+
+const std::vector<point_sm_ms> &submap::get_light_emitters() const
+{
+    if( !light_emitters_dirty ) {
+        return light_emitters;
+    }
+    light_emitters_dirty = false;
+    light_emitters.clear();
+    if( is_uniform() ) {
+        if( uniform_ter->light_emitted > 0 ) {
+            for( int x = 0; x < SEEX; x++ ) {
+                for( int y = 0; y < SEEY; y++ ) {
+                    light_emitters.emplace_back( x, y );
+                }
+            }
+        }
+        return light_emitters;
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( m->lum[x][y] > 0 || m->ter[x][y]->light_emitted > 0 ||
+                m->frn[x][y]->light_emitted > 0 ) {
+                light_emitters.emplace_back( x, y );
+            }
+        }
+    }
+    return light_emitters;
+}
+
 void submap::update_lum_rem( const point_sm_ms &p, const item &i )
 {
     ensure_nonuniform();
@@ -383,7 +503,9 @@ void submap::update_lum_rem( const point_sm_ms &p, const item &i )
 
 void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
 {
+    unshare_tiles();
     this->field_count = 0;
+    light_emitters_dirty = true;
 
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
@@ -420,6 +542,9 @@ void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
                  it != this->m->fld[x][y].end(); it++ ) {
                 this->field_count++;
             }
+            if( this->m->fld[x][y].field_count() > 0 ) {
+                mark_field_tile( { x, y } );
+            }
 
             if( copy_from->m->trp[x][y] != tr_null && ( copy_from_is_overlay ||
                     this->m->trp[x][y] == tr_null ) ) {
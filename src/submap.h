@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
@@ -82,12 +83,15 @@ class submap
 
         void ensure_nonuniform() {
             if( is_uniform() ) {
-                m = std::make_unique<maptile_soa>();
+                m = std::make_shared<maptile_soa>();
                 std::uninitialized_fill_n( &m->ter[0][0], elements, uniform_ter );
                 std::uninitialized_fill_n( &m->frn[0][0], elements, furn_str_id::NULL_ID() );
                 std::uninitialized_fill_n( &m->lum[0][0], elements, 0 );
                 std::uninitialized_fill_n( &m->trp[0][0], elements, tr_null );
                 std::uninitialized_fill_n( &m->rad[0][0], elements, 0 );
+                light_emitters_dirty = true;
+            } else {
+                unshare_tiles();
             }
         }
 
@@ -122,11 +126,13 @@ class submap
         void set_furn( const point_sm_ms &p, furn_id furn ) {
             ensure_nonuniform();
             m->frn[p.x()][p.y()] = furn;
+            light_emitters_dirty = true;
         }
 
         void set_all_furn( const furn_id &furn ) {
             ensure_nonuniform();
             std::uninitialized_fill_n( &m->frn[0][0], elements, furn );
+            light_emitters_dirty = true;
         }
         int get_map_damage( const point_sm_ms &p ) const {
             auto it = ephemeral_data.find( p );
@@ -150,6 +156,7 @@ class submap
         void set_ter( const point_sm_ms &p, ter_id terr ) {
             ensure_nonuniform();
             m->ter[p.x()][p.y()] = terr;
+            light_emitters_dirty = true;
         }
 
         void set_all_ter( const ter_id &terr, bool uniform_ok = false ) {
@@ -161,6 +168,7 @@ class submap
             } else {
                 std::uninitialized_fill_n( &m->ter[0][0], elements, terr );
             }
+            light_emitters_dirty = true;
         }
 
         int get_radiation( const point_sm_ms &p ) const {
@@ -185,11 +193,13 @@ class submap
         void set_lum( const point_sm_ms &p, uint8_t luminance ) {
             ensure_nonuniform();
             m->lum[p.x()][p.y()] = luminance;
+            light_emitters_dirty |= luminance > 0;
         }
 
         void update_lum_add( const point_sm_ms &p, const item &i ) {
             ensure_nonuniform();
             if( i.is_emissive() && m->lum[p.x()][p.y()] < 255 ) {
+                light_emitters_dirty |= m->lum[p.x()][p.y()] == 0;
                 m->lum[p.x()][p.y()]++;
             }
         }
@@ -202,6 +212,7 @@ class submap
                 cata::colony<item> static noitems;
                 return noitems;
             }
+            unshare_tiles();
             return m->itm[p.x()][p.y()];
         }
 
@@ -219,6 +230,7 @@ class submap
                 field static nofield;
                 return nofield;
             }
+            unshare_tiles();
             return m->fld[p.x()][p.y()];
         }
 
@@ -232,6 +244,31 @@ class submap
 
         void clear_fields( const point_sm_ms &p );
 
+        /**
+         * Tiles whose terrain, furniture or items may emit light, so lighting does not need to
+         * look at every tile.  Tiles that stopped emitting light can remain in the list until
+         * it is next rebuilt, so callers still have to check the tile itself.
+         * Light emitted by fields is not included, see @ref field_count.
+         */
+        const std::vector<point_sm_ms> &get_light_emitters() const;
+
+        /**
+         * Bit y of the result is set if tile (x, y) may hold fields, so loops over the fields of
+         * a submap can skip empty columns and tiles.  Tiles are only unmarked when a scan finds
+         * their field empty, so callers still have to check the field itself.
+         */
+        std::uint16_t get_field_column( int x ) const {
+            return field_columns[x];
+        }
+        // Marks tile p after a field was added to it.
+        void mark_field_tile( const point_sm_ms &p ) {
+            field_columns[p.x()] |= 1 << p.y();
+        }
+        // Unmarks tile p, which must not hold any fields.
+        void unmark_field_tile( const point_sm_ms &p ) {
+            field_columns[p.x()] &= ~( 1 << p.y() );
+        }
+
         struct cosmetic_t {
             point_sm_ms pos;
             std::string type;
@@ -286,6 +323,9 @@ class submap
         void mirror( bool horizontally );
 
         void store( JsonOut &jsout ) const;
+        // Everything store writes but when the submap was last touched, which is all that
+        // submaps generated alike tend to differ in.
+        void store_contents( JsonOut &jsout ) const;
         void load( const JsonValue &jv, const std::string &member_name, int version );
 
         // If is_uniform is true, this submap is a solid block of terrain
@@ -294,6 +334,23 @@ class submap
             return !static_cast<bool>( m );
         }
 
+        /**
+         * Submaps with the same tiles can share them until one of them is changed, which
+         * gives it a copy of its own.  Only tiles without items and fields are shared, as
+         * other code keeps pointers to those.
+         */
+        bool can_share_tiles() const;
+        size_t tiles_hash() const;
+        // Use the tiles of other if both can share them and they are the same.
+        bool share_tiles_with( const submap &other );
+        bool shares_tiles() const {
+            return m && m.use_count() > 1;
+        }
+
+        // Roughly how much memory the submap takes, with shared tiles split between the
+        // submaps sharing them.
+        size_t memory_estimate() const;
+
         // Merge the contents of the two submaps onto the target submap. If there is a
         // conflict the overlay wins out. Note that it's technically possible for both
         // submaps to actually be overlays, but the one that's not called out is treated
@@ -327,7 +384,20 @@ class submap
     private:
         std::map<point_sm_ms, tile_data> ephemeral_data;
         std::map<point_sm_ms, computer> computers;
-        std::unique_ptr<maptile_soa> m;
+        std::shared_ptr<maptile_soa> m;
+        // Gives this submap its own copy of tiles it shares with others.
+        void unshare_tiles() {
+            if( m.use_count() > 1 ) {
+                m = std::make_shared<maptile_soa>( *m );
+            }
+        }
+        // Cache for get_light_emitters, rebuilt when a tile may have started to emit light.
+        mutable std::vector<point_sm_ms> light_emitters; // NOLINT(cata-serialize)
+        mutable bool light_emitters_dirty = true; // NOLINT(cata-serialize)
+        static_assert( SEEY <= 16, "field_columns uses one bit per tile of a column" );
+        std::array<std::uint16_t, SEEX> field_columns = {}; // NOLINT(cata-serialize)
+        // Recomputes field_columns after fields were moved or added in bulk.
+        void rebuild_field_columns();
         ter_id uniform_ter = t_null;
         int temperature_mod = 0; // delta in F
 
@@ -51,7 +51,7 @@ trade_preset::trade_preset( Character const &you, Character const &trader )
     save_state = &inventory_ui_default_state;
     append_cell(
     [&]( item_location const & loc ) {
-        return format_money( npc_trading::trading_price( _trader, _u, { loc, 1 } ) );
+        return format_money( price( { loc, 1 } ) );
     },
     _( "Unit price" ) );
 }
@@ -65,7 +65,7 @@ bool trade_preset::is_shown( item_location const &loc ) const
 
 std::string trade_preset::get_denial( const item_location &loc ) const
 {
-    int const price = npc_trading::trading_price( _trader, _u, { loc, 1 } );
+    int const price = this->price( { loc, 1 } );
 
     if( _u.is_npc() ) {
         npc const &np = *_u.as_npc();
@@ -97,6 +97,18 @@ std::string trade_preset::get_denial( const item_location &loc ) const
     return inventory_selector_preset::get_denial( loc );
 }
 
+int trade_preset::price( trade_selector::entry_t const &it ) const
+{
+    const std::pair<item const *, int> key( it.first.get_item(), it.second );
+    const auto found = _prices.find( key );
+    if( found != _prices.end() ) {
+        return found->second;
+    }
+    const int ret = npc_trading::trading_price( _trader, _u, it );
+    _prices.emplace( key, ret );
+    return ret;
+}
+
 bool trade_preset::cat_sort_compare( const inventory_entry &lhs, const inventory_entry &rhs ) const
 {
     // sort worn and held categories last we likely don't want to trade them
@@ -199,10 +211,9 @@ void trade_ui::recalc_values_cpane()
 {
     _trade_values[_cpane] = 0;
 
+    trade_preset const &preset = _cpane == _you ? _upreset : _tpreset;
     for( entry_t const &it : _panes[_cpane]->to_trade() ) {
-        // FIXME: cache trading_price
-        _trade_values[_cpane] +=
-            npc_trading::trading_price( *_parties[-_cpane + 1], *_parties[_cpane], it );
+        _trade_values[_cpane] += preset.price( it );
     }
     if( !_parties[_trader]->as_npc()->will_exchange_items_freely() ) {
         _balance = _cost + _trade_values[_you] - _trade_values[_trader] + _delta_bank;
@@ -216,8 +227,8 @@ void trade_ui::autobalance()
     if( ( sign < 0 && _balance < 0 ) || ( sign > 0 && _balance > 0 ) ) {
         inventory_entry &entry = _panes[_cpane]->get_active_column().get_highlighted();
         size_t const avail = entry.get_available_count() - entry.chosen_count;
-        double const price = npc_trading::trading_price( *_parties[-_cpane + 1], *_parties[_cpane],
-                             entry_t{ entry.any_item(), 1 } ) * sign;
+        trade_preset const &preset = _cpane == _you ? _upreset : _tpreset;
+        double const price = preset.price( entry_t{ entry.any_item(), 1 } ) * sign;
         double const num = _balance / price;
         double const extra = sign < 0 ? std::ceil( num ) : std::floor( num );
         _panes[_cpane]->toggle_entry( entry, entry.chosen_count +
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <queue>
 #include <string>
@@ -65,8 +66,13 @@ class trade_preset : public inventory_selector_preset
         std::string get_denial( const item_location &loc ) const override;
         bool cat_sort_compare( const inventory_entry &lhs, const inventory_entry &rhs ) const override;
 
+        // Price the trader pays for it, kept while the trade screen is open
+        int price( trade_selector::entry_t const &it ) const;
+
     private:
         Character const &_u, &_trader;
+        // Nothing changes hands until the trade is done, so neither do the prices
+        mutable std::map<std::pair<item const *, int>, int> _prices;
 };
 
 class trade_ui
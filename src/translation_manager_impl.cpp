@@ -9,31 +9,64 @@
 #include "translations.h"
 #include "translation_manager_impl.h"
 
-std::uint32_t TranslationManager::Impl::Hash( const char *str )
+std::uint32_t TranslationManager::Impl::Hash( const char *context, const char *message )
 {
     std::uint32_t hash = 5381U;
-    while( *str != '\0' ) {
-        hash = hash * 33 + ( *str++ );
+    if( context != nullptr ) {
+        while( *context != '\0' ) {
+            hash = hash * 33 + static_cast<unsigned char>( *context++ );
+        }
+        hash = hash * 33 + '\004';
+    }
+    while( *message != '\0' ) {
+        hash = hash * 33 + static_cast<unsigned char>( *message++ );
     }
     return hash;
 }
 
+bool TranslationManager::Impl::Matches( const char *original, const char *context,
+                                        const char *message )
+{
+    if( context != nullptr ) {
+        const std::size_t context_length = strlen( context );
+        if( strncmp( original, context, context_length ) != 0 ||
+            original[context_length] != '\004' ) {
+            return false;
+        }
+        original += context_length + 1;
+    }
+    return strcmp( original, message ) == 0;
+}
+
+void TranslationManager::Impl::AddString( const std::uint32_t document, const std::uint32_t index )
+{
+    const char *message = documents[document].GetOriginalString( index );
+    const std::uint32_t hash = Hash( nullptr, message );
+    const std::size_t mask = strings.size() - 1;
+    std::size_t i = hash & mask;
+    for( ; strings[i].document != kEmptySlot; i = ( i + 1 ) & mask ) {
+        if( strings[i].hash == hash &&
+            strcmp( documents[strings[i].document].GetOriginalString( strings[i].index ), message ) == 0 ) {
+            return;
+        }
+    }
+    strings[i] = StringSlot{ hash, document, index };
+}
+
 std::optional<std::pair<std::size_t, std::size_t>> TranslationManager::Impl::LookupString(
-            const char *query ) const
+            const char *context, const char *message ) const
 {
     if( strings.empty() ) {
         return std::nullopt;
     }
-    std::uint32_t hash = Hash( query );
-    auto it = strings.find( hash );
-    if( it == strings.end() ) {
-        return std::nullopt;
-    }
-    for( const std::pair<size_t, size_t> &entry : it->second ) {
-        const std::size_t document = entry.first;
-        const std::size_t index = entry.second;
-        if( strcmp( documents[document].GetOriginalString( index ), query ) == 0 ) {
-            return std::optional<std::pair<std::size_t, std::size_t>> { entry };
+    const std::uint32_t hash = Hash( context, message );
+    const std::size_t mask = strings.size() - 1;
+    for( std::size_t i = hash & mask; strings[i].document != kEmptySlot; i = ( i + 1 ) & mask ) {
+        const StringSlot &slot = strings[i];
+        if( slot.hash == hash &&
+            Matches( documents[slot.document].GetOriginalString( slot.index ), context, message ) ) {
+            return std::make_pair( static_cast<std::size_t>( slot.document ),
+                                   static_cast<std::size_t>( slot.index ) );
         }
     }
     return std::nullopt;
@@ -86,7 +119,6 @@ void TranslationManager::Impl::Reset()
 {
     documents.clear();
     strings.clear();
-    strings.max_load_factor( 1.0f );
 }
 
 TranslationManager::Impl::Impl()
@@ -145,15 +177,23 @@ void TranslationManager::Impl::LoadDocuments( const std::vector<std::string> &fi
             DebugLog( D_ERROR, DC_ALL ) << e.what();
         }
     }
+    std::size_t total = 0;
+    for( const TranslationDocument &document : documents ) {
+        total += document.Count();
+    }
+    if( total == 0 ) {
+        return;
+    }
+    std::size_t capacity = 1;
+    while( capacity < total * 2 ) {
+        capacity *= 2;
+    }
+    strings.assign( capacity, StringSlot{ 0, kEmptySlot, 0 } );
     for( std::size_t document = 0; document < documents.size(); document++ ) {
         for( std::size_t i = 0; i < documents[document].Count(); i++ ) {
-            const char *message = documents[document].GetOriginalString( i );
-            if( message[0] != '\0' ) {
-                const std::uint32_t hash = Hash( message );
-                if( strings.count( hash ) == 0 ) {
-                    strings[hash] = std::vector<std::pair<std::size_t, std::size_t>>( 1 );
-                }
-                strings[hash].emplace_back( document, i );
+            // The empty string holds the header of the document, which is never looked up.
+            if( documents[document].GetOriginalString( i )[0] != '\0' ) {
+                AddString( static_cast<std::uint32_t>( document ), static_cast<std::uint32_t>( i ) );
             }
         }
     }
@@ -166,7 +206,7 @@ const char *TranslationManager::Impl::Translate( const std::string &message ) co
 
 const char *TranslationManager::Impl::Translate( const char *message ) const
 {
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( message );
+    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( nullptr, message );
     if( entry ) {
         const std::size_t document = entry->first;
         const std::size_t string_index = entry->second;
@@ -178,7 +218,7 @@ const char *TranslationManager::Impl::Translate( const char *message ) const
 const char *TranslationManager::Impl::TranslatePlural( const char *singular, const char *plural,
         std::size_t n ) const
 {
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( singular );
+    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( nullptr, singular );
     if( entry ) {
         const std::size_t document = entry->first;
         const std::size_t string_index = entry->second;
@@ -191,22 +231,10 @@ const char *TranslationManager::Impl::TranslatePlural( const char *singular, con
     }
 }
 
-std::string TranslationManager::Impl::ConstructContextualQuery( const char *context,
-        const char *message ) const
-{
-    std::string query;
-    query.reserve( strlen( context ) + 1 + strlen( message ) );
-    query.append( context );
-    query.append( "\004" );
-    query.append( message );
-    return query;
-}
-
 const char *TranslationManager::Impl::TranslateWithContext( const char *context,
         const char *message ) const
 {
-    std::string query = ConstructContextualQuery( context, message );
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( query.c_str() );
+    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( context, message );
     if( entry ) {
         const std::size_t document = entry->first;
         const std::size_t string_index = entry->second;
@@ -220,8 +248,7 @@ const char *TranslationManager::Impl::TranslatePluralWithContext( const char *co
         const char *plural,
         std::size_t n ) const
 {
-    std::string query = ConstructContextualQuery( context, singular );
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( query.c_str() );
+    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( context, singular );
     if( entry ) {
         const std::size_t document = entry->first;
         const std::size_t string_index = entry->second;
@@ -4,8 +4,13 @@
 
 #if defined(LOCALIZE)
 
+#include <cstdint>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "translation_document.h"
 #include "translation_manager.h"
@@ -15,14 +20,29 @@ class TranslationManager::Impl
     private:
         std::vector<TranslationDocument> documents;
 
-        std::unordered_map<std::uint32_t, std::vector<std::pair<std::size_t, std::size_t>>> strings;
-        static std::uint32_t Hash( const char *str );
-        std::optional<std::pair<std::size_t, std::size_t>> LookupString( const char *query ) const;
+        // An original string of one of the documents, by the hash of the string.
+        struct StringSlot {
+            std::uint32_t hash;
+            std::uint32_t document;
+            std::uint32_t index;
+        };
+        static constexpr std::uint32_t kEmptySlot = UINT32_MAX;
+        // Open addressing table of all the original strings, at most half full and built once
+        // per language, so a lookup is a hash and usually a single string comparison.
+        // The first document to have a string wins.  Only SetLanguage and LoadDocuments change
+        // it, which must not run while other threads translate.
+        std::vector<StringSlot> strings;
+        static std::uint32_t Hash( const char *context, const char *message );
+        // Whether the original string is the message, or the context, \004 and the message.
+        static bool Matches( const char *original, const char *context, const char *message );
+        void AddString( std::uint32_t document, std::uint32_t index );
+        // Contextual queries pass their context separately, so they need not be put together.
+        std::optional<std::pair<std::size_t, std::size_t>> LookupString( const char *context,
+                const char *message ) const;
 
         std::unordered_map<std::string, std::vector<std::string>> mo_files;
         static std::string LanguageCodeOfPath( std::string_view path );
         void ScanTranslationDocuments();
-        std::string ConstructContextualQuery( const char *context, const char *message ) const;
         void Reset();
         std::string current_language_code;
     public:
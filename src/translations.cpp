@@ -1,3 +1,4 @@
+#include <atomic>
 #include <string>
 
 #include "cata_utility.h"
@@ -10,11 +11,11 @@
 
 // int version/generation that is incremented each time language is changed
 // used to invalidate translation cache
-static int current_language_version = INVALID_LANGUAGE_VERSION + 1;
+static std::atomic<int> current_language_version{ INVALID_LANGUAGE_VERSION + 1 };
 
 int detail::get_current_language_version()
 {
-    return current_language_version;
+    return current_language_version.load( std::memory_order_relaxed );
 }
 
 #if defined(LOCALIZE)
@@ -90,9 +91,7 @@ void set_language( const std::string &lang )
     reset_sanity_check_genders();
 
     // increment version to invalidate translation cache
-    do {
-        current_language_version++;
-    } while( current_language_version == INVALID_LANGUAGE_VERSION );
+    while( current_language_version.fetch_add( 1 ) + 1 == INVALID_LANGUAGE_VERSION ) {}
 
 #else
     // Silence unused var warning
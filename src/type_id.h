@@ -135,6 +135,7 @@ using item_group_id = string_id<Item_spawn_data>;
 
 struct itype;
 using itype_id = string_id<itype>;
+using itype_int_id = int_id<itype>;
 
 class weapon_category;
 using weapon_category_id = string_id<weapon_category>;
@@ -183,6 +184,7 @@ using morale_type = string_id<morale_type_data>;
 
 struct mtype;
 using mtype_id = string_id<mtype>;
+using mtype_int_id = int_id<mtype>;
 
 class nested_mapgen;
 using nested_mapgen_id = string_id<nested_mapgen>;
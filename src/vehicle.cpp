@@ -2854,6 +2854,13 @@ std::vector<int> vehicle::parts_at_relative( const point_rel_ms &dp, const bool
     return res;
 }
 
+const std::vector<int> &vehicle::cached_parts_at_relative( const point_rel_ms &dp ) const
+{
+    static const std::vector<int> no_parts;
+    const auto iter = relative_parts.find( dp );
+    return iter != relative_parts.end() ? iter->second : no_parts;
+}
+
 std::optional<vpart_reference> vpart_position::obstacle_at_part() const
 {
     std::optional<vpart_reference> part = part_with_feature( VPFLAG_OBSTACLE, true, true );
@@ -3038,9 +3045,10 @@ int vehicle::part_with_feature( int part, vpart_bitflags flag, bool unbroken,
     if( vp.info().has_flag( flag ) && !( unbroken && vp.is_broken() ) ) {
         return part;
     }
-    for( const int p : parts_at_relative( vp.mount, /* use_cache = */ true, include_fake ) ) {
+    for( const int p : cached_parts_at_relative( vp.mount ) ) {
         const vehicle_part &vp_here = this->part( p );
-        if( vp_here.info().has_flag( flag ) && !( unbroken && vp_here.is_broken() ) ) {
+        if( ( include_fake || !vp_here.is_fake ) && vp_here.info().has_flag( flag ) &&
+            !( unbroken && vp_here.is_broken() ) ) {
             return p;
         }
     }
@@ -3050,9 +3058,10 @@ int vehicle::part_with_feature( int part, vpart_bitflags flag, bool unbroken,
 int vehicle::part_with_feature( const point_rel_ms &pt, vpart_bitflags f, bool unbroken,
                                 bool include_fake ) const
 {
-    for( const int p : parts_at_relative( pt, /* use_cache = */ true, include_fake ) ) {
+    for( const int p : cached_parts_at_relative( pt ) ) {
         const vehicle_part &vp_here = this->part( p );
-        if( vp_here.info().has_flag( f ) && !( unbroken && vp_here.is_broken() ) ) {
+        if( ( include_fake || !vp_here.is_fake ) && vp_here.info().has_flag( f ) &&
+            !( unbroken && vp_here.is_broken() ) ) {
             return p;
         }
     }
@@ -3542,7 +3551,7 @@ int vehicle::part_displayed_at( const point_rel_ms &dp, bool include_fake, bool
     // it's clear where the magic number comes from.
     const int ON_ROOF_Z = 9;
 
-    std::vector<int> parts_in_square = parts_at_relative( dp, true, include_fake );
+    const std::vector<int> &parts_in_square = cached_parts_at_relative( dp );
 
     if( parts_in_square.empty() ) {
         return -1;
@@ -3558,29 +3567,28 @@ int vehicle::part_displayed_at( const point_rel_ms &dp, bool include_fake, bool
 
     int top_part = -1;
     int top_z_order = ( below_roof ? 0 : ON_ROOF_Z ) - 1;
-    for( size_t index = 0; index < parts_in_square.size(); index++ ) {
-        int test_index = parts_in_square[index];
+    for( const int test_index : parts_in_square ) {
         const vehicle_part &vp = parts.at( test_index );
-        if( !vp.is_real_or_active_fake() ) {
+        if( ( !include_fake && vp.is_fake ) || !vp.is_real_or_active_fake() ) {
             continue;
         }
         int test_z_order = vp.info().z_order;
         if( ( top_z_order < test_z_order ) && ( test_z_order < hide_z_at_or_above ) ) {
-            top_part = index;
+            top_part = test_index;
             top_z_order = test_z_order;
         }
     }
-    if( top_part < 0 ) {
-        return top_part;
-    }
 
-    return parts_in_square[top_part];
+    return top_part;
 }
 
 int vehicle::roof_at_part( const int part ) const
 {
-    for( const int p : parts_at_relative( parts[part].mount, true ) ) {
+    for( const int p : cached_parts_at_relative( parts[part].mount ) ) {
         const vehicle_part &vp = parts[p];
+        if( vp.is_fake ) {
+            continue;
+        }
         if( vp.info().location == "on_roof" || vp.info().has_flag( VPFLAG_ROOF ) ) {
             return p;
         }
@@ -3648,13 +3656,25 @@ void vehicle::precalc_mounts( int idir, const units::angle &dir,
     }
     tileray tdir( dir );
     std::unordered_map<point_rel_ms, tripoint_rel_ms> mount_to_precalc;
+    // Advancing the tileray takes a step per tile, and only depends on the mount's column, so
+    // it is done once per column; see coord_translate.
+    std::unordered_map<int, point_rel_ms> column_advance;
     for( vehicle_part &p : parts ) {
         if( p.removed ) {
             continue;
         }
         auto q = mount_to_precalc.find( p.mount );
         if( q == mount_to_precalc.end() ) {
-            coord_translate( tdir, pivot, p.mount, p.precalc[idir] );
+            const int column = p.mount.x() - pivot.x();
+            const auto [col_it, inserted] = column_advance.try_emplace( column );
+            if( inserted ) {
+                tdir.clear_advance();
+                tdir.advance( column );
+                col_it->second = point_rel_ms( tdir.dx(), tdir.dy() );
+            }
+            const int row = p.mount.y() - pivot.y();
+            p.precalc[idir].x() = col_it->second.x() + tdir.ortho_dx( row );
+            p.precalc[idir].y() = col_it->second.y() + tdir.ortho_dy( row );
             mount_to_precalc.insert( { p.mount, p.precalc[idir]} );
         } else {
             p.precalc[idir] = q->second;
@@ -3790,7 +3810,7 @@ units::mass vehicle::total_mass( map &here ) const
     // than rotated_center_of_mass().
     // To improve performance, refresh mass_center_no_precalc.
     if( mass_dirty ) {
-        calc_mass_center( here, false );
+        calc_mass_center( here );
     }
 
     return enchantment_cache.modify_value( enchant_vals::mod::TOTAL_WEIGHT, mass_cache );
@@ -3829,7 +3849,7 @@ units::mass vehicle::weight_on_wheels( map &here ) const
 const point_rel_ms &vehicle::rotated_center_of_mass( map &here ) const
 {
     // TODO: Bring back caching of this point
-    calc_mass_center( here, true );
+    calc_mass_center( here );
 
     return mass_center_precalc;
 }
@@ -3837,7 +3857,7 @@ const point_rel_ms &vehicle::rotated_center_of_mass( map &here ) const
 const point_rel_ms &vehicle::local_center_of_mass( map &here ) const
 {
     if( mass_center_no_precalc_dirty ) {
-        calc_mass_center( here, false );
+        calc_mass_center( here );
     }
 
     return mass_center_no_precalc;
@@ -4103,12 +4123,64 @@ bool vehicle::can_use_rails( map &here ) const
     return is_wheel_on_rail;
 }
 
+// cubic equation solution
+// don't use complex numbers unless necessary and it's usually not
+// see https://math.vanderbilt.edu/schectex/courses/cubic/ for the gory details
+static double simple_cubic_solution( double a, double b, double c, double d )
+{
+    double p = -b / ( 3 * a );
+    double q = p * p * p + ( b * c - 3 * a * d ) / ( 6 * a * a );
+    double r = c / ( 3 * a );
+    double t = r - p * p;
+    double tricky_bit = q * q + t * t * t;
+    if( tricky_bit < 0 ) {
+        double cr = 1.0 / 3.0; // approximate the cube root of a complex number
+        std::complex<double> q_complex( q );
+        std::complex<double> tricky_complex( std::sqrt( std::complex<double>( tricky_bit ) ) );
+        std::complex<double> term1( std::pow( q_complex + tricky_complex, cr ) );
+        std::complex<double> term2( std::pow( q_complex - tricky_complex, cr ) );
+        std::complex<double> term_sum( term1 + term2 );
+
+        if( imag( term_sum ) < 2 ) {
+            return p + real( term_sum );
+        } else {
+            debugmsg( "cubic solution returned imaginary values" );
+            return 0;
+        }
+    } else {
+        double tricky_final = std::sqrt( tricky_bit );
+        double term1_part = q + tricky_final;
+        double term2_part = q - tricky_final;
+        double term1 = std::cbrt( term1_part );
+        double term2 = std::cbrt( term2_part );
+        return p + term1 + term2;
+    }
+}
+
+// Top speed on wheels for the given drag coefficients and engine power, see max_ground_velocity.
+static int ground_velocity_at_power( double c_air_drag, double c_rolling_drag, int engine_w )
+{
+    const double max_in_mps = simple_cubic_solution( c_air_drag, c_rolling_drag,
+                              c_rolling_drag * vehicles::rolling_constant_to_variable, -engine_w );
+    return mps_to_vmiph( max_in_mps );
+}
+
+// Top speed on water for the given drag coefficient and engine power, see max_water_velocity.
+static int water_velocity_at_power( double total_drag, int engine_w )
+{
+    return mps_to_vmiph( std::cbrt( engine_w / total_drag ) );
+}
+
 int vehicle::ground_acceleration( map &here, const bool fueled, int at_vel_in_vmi ) const
 {
     if( !( engine_on || skidding ) ) {
         return 0;
     }
-    int target_vmiph = std::max( at_vel_in_vmi, std::max( 1000, max_velocity( here, fueled ) / 4 ) );
+    // Summed once, the top speed is worked out from the same engine power.
+    const int total_engine_w = units::to_watt( total_power( here, fueled ) );
+    const int max_vel = ground_velocity_at_power( coeff_air_drag(), coeff_rolling_drag( here ),
+                        total_engine_w );
+    int target_vmiph = std::max( at_vel_in_vmi, std::max( 1000, max_vel / 4 ) );
     int cmps = vmiph_to_cmps( target_vmiph );
     double weight = to_kilogram( total_mass( here ) );
     if( is_towing() ) {
@@ -4117,7 +4189,7 @@ int vehicle::ground_acceleration( map &here, const bool fueled, int at_vel_in_vm
             weight = weight + to_kilogram( other_veh->total_mass( here ) );
         }
     }
-    int engine_power_ratio = units::to_watt( total_power( here, fueled ) ) / weight;
+    int engine_power_ratio = total_engine_w / weight;
     int accel_at_vel = 100 * 100 * engine_power_ratio / cmps;
     add_msg_debug( debugmode::DF_VEHICLE, "%s: accel at %d vimph is %d", name, target_vmiph,
                    cmps_to_vmiph( accel_at_vel ) );
@@ -4140,8 +4212,10 @@ int vehicle::water_acceleration( map &here, const bool fueled, int at_vel_in_vmi
     if( !( engine_on || skidding ) ) {
         return 0;
     }
-    int target_vmiph = std::max( at_vel_in_vmi, std::max( 1000,
-                                 max_water_velocity( here, fueled ) / 4 ) );
+    const int total_engine_w = units::to_watt( total_power( here, fueled ) );
+    const int max_vel = water_velocity_at_power( coeff_water_drag( here ) + coeff_air_drag(),
+                        total_engine_w );
+    int target_vmiph = std::max( at_vel_in_vmi, std::max( 1000, max_vel / 4 ) );
     int cmps = vmiph_to_cmps( target_vmiph );
     double weight = to_kilogram( total_mass( here ) );
     if( is_towing() ) {
@@ -4150,47 +4224,13 @@ int vehicle::water_acceleration( map &here, const bool fueled, int at_vel_in_vmi
             weight = weight + to_kilogram( other_veh->total_mass( here ) );
         }
     }
-    int engine_power_ratio = units::to_watt( total_power( here, fueled ) ) / weight;
+    int engine_power_ratio = total_engine_w / weight;
     int accel_at_vel = 100 * 100 * engine_power_ratio / cmps;
     add_msg_debug( debugmode::DF_VEHICLE, "%s: water accel at %d vimph is %d", name, target_vmiph,
                    cmps_to_vmiph( accel_at_vel ) );
     return cmps_to_vmiph( accel_at_vel );
 }
 
-// cubic equation solution
-// don't use complex numbers unless necessary and it's usually not
-// see https://math.vanderbilt.edu/schectex/courses/cubic/ for the gory details
-static double simple_cubic_solution( double a, double b, double c, double d )
-{
-    double p = -b / ( 3 * a );
-    double q = p * p * p + ( b * c - 3 * a * d ) / ( 6 * a * a );
-    double r = c / ( 3 * a );
-    double t = r - p * p;
-    double tricky_bit = q * q + t * t * t;
-    if( tricky_bit < 0 ) {
-        double cr = 1.0 / 3.0; // approximate the cube root of a complex number
-        std::complex<double> q_complex( q );
-        std::complex<double> tricky_complex( std::sqrt( std::complex<double>( tricky_bit ) ) );
-        std::complex<double> term1( std::pow( q_complex + tricky_complex, cr ) );
-        std::complex<double> term2( std::pow( q_complex - tricky_complex, cr ) );
-        std::complex<double> term_sum( term1 + term2 );
-
-        if( imag( term_sum ) < 2 ) {
-            return p + real( term_sum );
-        } else {
-            debugmsg( "cubic solution returned imaginary values" );
-            return 0;
-        }
-    } else {
-        double tricky_final = std::sqrt( tricky_bit );
-        double term1_part = q + tricky_final;
-        double term2_part = q - tricky_final;
-        double term1 = std::cbrt( term1_part );
-        double term2 = std::cbrt( term2_part );
-        return p + term1 + term2;
-    }
-}
-
 int vehicle::acceleration( map &here, const bool fueled, int at_vel_in_vmi ) const
 {
     if( is_watercraft() ) {
@@ -4235,13 +4275,10 @@ int vehicle::max_ground_velocity( map &here, const bool fueled ) const
 {
     int total_engine_w = units::to_watt( total_power( here, fueled ) );
     double c_rolling_drag = coeff_rolling_drag( here );
-    double max_in_mps = simple_cubic_solution( coeff_air_drag(), c_rolling_drag,
-                        c_rolling_drag * vehicles::rolling_constant_to_variable,
-                        -total_engine_w );
-    add_msg_debug( debugmode::DF_VEHICLE,
-                   "%s: power %d, c_air %3.2f, c_rolling %3.2f, max_in_mps %3.2f",
-                   name, total_engine_w, coeff_air_drag(), c_rolling_drag, max_in_mps );
-    return mps_to_vmiph( max_in_mps );
+    const int max_vel = ground_velocity_at_power( coeff_air_drag(), c_rolling_drag, total_engine_w );
+    add_msg_debug( debugmode::DF_VEHICLE, "%s: power %d, c_air %3.2f, c_rolling %3.2f, max %d vmiph",
+                   name, total_engine_w, coeff_air_drag(), c_rolling_drag, max_vel );
+    return max_vel;
 }
 
 // the same physics as ground velocity, but there's no rolling resistance so the math is easy
@@ -4257,12 +4294,12 @@ int vehicle::max_ground_velocity( map &here, const bool fueled ) const
 int vehicle::max_water_velocity( map &here, const bool fueled ) const
 {
     int total_engine_w = units::to_watt( total_power( here, fueled ) );
-    double total_drag = coeff_water_drag( here ) + coeff_air_drag();
-    double max_in_mps = std::cbrt( total_engine_w / total_drag );
+    const double c_water_drag = coeff_water_drag( here );
+    const int max_vel = water_velocity_at_power( c_water_drag + coeff_air_drag(), total_engine_w );
     add_msg_debug( debugmode::DF_VEHICLE,
-                   "%s: power %d, c_air %3.2f, c_water %3.2f, water max_in_mps %3.2f",
-                   name, total_engine_w, coeff_air_drag(), coeff_water_drag( here ), max_in_mps );
-    return mps_to_vmiph( max_in_mps );
+                   "%s: power %d, c_air %3.2f, c_water %3.2f, water max %d vmiph",
+                   name, total_engine_w, coeff_air_drag(), c_water_drag, max_vel );
+    return max_vel;
 }
 
 int vehicle::max_rotor_velocity( map &here, const bool fueled ) const
@@ -5780,6 +5817,8 @@ std::map<Vehicle *, float> vehicle::search_connected_vehicles( const map &here,
     while( !queue.empty() ) {
         Vehicle *const veh = queue.back();
         queue.pop_back();
+        // Only the distances of other vehicles are lowered below, a cable back to veh never is.
+        const float veh_dist = distances[veh];
 
         for( const int part_idx : veh->loose_parts ) { // graph "edges" are POWER_TRANSFER parts
             const vehicle_part &vp = veh->part( part_idx );
@@ -5793,12 +5832,12 @@ std::map<Vehicle *, float> vehicle::search_connected_vehicles( const map &here,
                 continue;
             }
             // try insert infinity for initial unvisited node distance
-            distances.insert( { v_next, infinity_distance } );
+            float &next_dist = distances.emplace( v_next, infinity_distance ).first->second;
 
             const float loss = units::to_kilowatt<float>( vpi.epower ) / 100.0f;
-            const float new_dist = loss + distances[veh];
-            if( distances[v_next] > new_dist ) {
-                distances[v_next] = new_dist;
+            const float new_dist = loss + veh_dist;
+            if( next_dist > new_dist ) {
+                next_dist = new_dist;
                 queue.emplace_back( v_next );
             }
         }
@@ -8376,8 +8415,9 @@ void vehicle::update_time( map &here, const time_point &update_to )
         return;
     }
     // Get one weather data set per vehicle, they don't differ much across vehicle area
-    const weather_sum accum_weather = sum_conditions( update_from, update_to,
-                                      pos_abs() );
+    // Only the funnels and solar panels use it, wind turbines and water wheels don't.
+    const weather_sum accum_weather = funnels.empty() && solar_panels.empty() ? weather_sum() :
+                                      sum_conditions( update_from, update_to, pos_abs() );
     // make some reference objects to use to check for reload
     const item water( itype_water );
     const item water_clean( itype_water_clean );
@@ -8468,10 +8508,13 @@ void vehicle::invalidate_mass()
     coeff_water_dirty = true;
 }
 
-void vehicle::calc_mass_center( map &here, bool use_precalc ) const
+void vehicle::calc_mass_center( map &here ) const
 {
+    // Both centers are summed in the same pass over the parts and their items.
     units::quantity<float, units::mass::unit_type> xf;
     units::quantity<float, units::mass::unit_type> yf;
+    units::quantity<float, units::mass::unit_type> xf_precalc;
+    units::quantity<float, units::mass::unit_type> yf_precalc;
     units::mass m_total = 0_gram;
     for( const vpart_reference &vp : get_all_parts() ) {
         const size_t i = vp.part_index();
@@ -8505,13 +8548,10 @@ void vehicle::calc_mass_center( map &here, bool use_precalc ) const
             m_part += p != nullptr ? p->get_weight() : 0_gram;
             m_part += z != nullptr ? z->get_weight() : 0_gram;
         }
-        if( use_precalc ) {
-            xf += vp.part().precalc[0].x() * m_part;
-            yf += vp.part().precalc[0].y() * m_part;
-        } else {
-            xf += vp.mount_pos().x() * m_part;
-            yf += vp.mount_pos().y() * m_part;
-        }
+        xf_precalc += vp.part().precalc[0].x() * m_part;
+        yf_precalc += vp.part().precalc[0].y() * m_part;
+        xf += vp.mount_pos().x() * m_part;
+        yf += vp.mount_pos().y() * m_part;
 
         m_total += m_part;
     }
@@ -8520,16 +8560,17 @@ void vehicle::calc_mass_center( map &here, bool use_precalc ) const
     mass_dirty = false;
 
     // If no reall parts remain the weight is zero, and we'd end up with division by zero.
-    const float x = mass_cache == 0_gram ? 0 : xf / mass_cache;
-    const float y = mass_cache == 0_gram ? 0 : yf / mass_cache;
-    if( use_precalc ) {
-        mass_center_precalc.x() = std::round( x );
-        mass_center_precalc.y() = std::round( y );
+    if( mass_cache == 0_gram ) {
+        mass_center_precalc = point_rel_ms::zero;
+        mass_center_no_precalc = point_rel_ms::zero;
     } else {
-        mass_center_no_precalc.x() = std::round( x );
-        mass_center_no_precalc.y() = std::round( y );
+        mass_center_precalc.x() = std::round( xf_precalc / mass_cache );
+        mass_center_precalc.y() = std::round( yf_precalc / mass_cache );
+        mass_center_no_precalc.x() = std::round( xf / mass_cache );
+        mass_center_no_precalc.y() = std::round( yf / mass_cache );
     }
 
+    mass_center_precalc_dirty = false;
     mass_center_no_precalc_dirty = false;
 }
 
@@ -871,7 +871,8 @@ class vehicle
         // refresh pivot_cache, clear pivot_dirty
         void refresh_pivot( map &here ) const;
 
-        void calc_mass_center( map &here, bool precalc ) const;
+        // refresh mass_cache and both centers of mass, clear mass_dirty
+        void calc_mass_center( map &here ) const;
 
         /** empty the contents of a tank, battery or turret spilling liquids randomly on the ground */
         void leak_fuel( map &here,  vehicle_part &pt ) const;
@@ -1230,6 +1231,9 @@ class vehicle
         // returns the list of indices of parts at certain position (not accounting frame direction)
         std::vector<int> parts_at_relative( const point_rel_ms &dp, bool use_cache,
                                             bool include_fake = false ) const;
+        // returns the cached indices of parts at certain position, fake parts included, without
+        // copying them like parts_at_relative does
+        const std::vector<int> &cached_parts_at_relative( const point_rel_ms &dp ) const;
 
         /**
         *  Returns index of part at mount point \p pt which has given \p f flag
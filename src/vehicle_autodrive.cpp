@@ -672,10 +672,9 @@ vehicle_profile vehicle::autodrive_controller::compute_profile( map &here,
         }
         tripoint_rel_ms pos;
         driven_veh.coord_translate( tdir, pivot, part.mount, pos );
-        if( extent_map.find( pos.y() ) == extent_map.end() ) {
-            extent_map[pos.y()] = {pos.x(), pos.x()};
-        } else {
-            auto &extent = extent_map[pos.y()];
+        const auto [it, inserted] = extent_map.try_emplace( pos.y(), pos.x(), pos.x() );
+        if( !inserted ) {
+            auto &extent = it->second;
             extent.first = std::min( extent.first, pos.x() );
             extent.second = std::max( extent.second, pos.x() );
         }
@@ -885,15 +884,22 @@ void vehicle::autodrive_controller::compute_obstacles_from_enqueued_ramp_points(
 void vehicle::autodrive_controller::compute_valid_positions()
 {
     const coord_transformation veh_rot = { point::zero, -data.nav_to_map.rotation, point::zero };
+    const point veh_rot_origin = veh_rot.transform( point::zero );
     for( orientation facing : all_orientations() ) {
         const vehicle_profile &profile = data.profile( data.nav_to_map.transform( facing ) );
+        // Offsets of the occupied points in view space, the same for every nav point.
+        std::vector<point> view_offsets;
+        view_offsets.reserve( profile.occupied_zone.size() );
+        for( const point_rel_ms &veh_pt : profile.occupied_zone ) {
+            view_offsets.emplace_back( veh_rot.transform( veh_pt.raw() ) - veh_rot_origin );
+        }
         for( int mx = 0; mx < NAV_MAP_SIZE_X; mx++ ) {
             for( int my = 0; my < NAV_MAP_SIZE_Y; my++ ) {
                 const point nav_pt( mx, my );
+                const point view_nav_pt = data.nav_to_view.transform( nav_pt );
                 bool valid = true;
-                for( const point_rel_ms &veh_pt : profile.occupied_zone ) {
-                    const point view_pt = data.nav_to_view.transform( nav_pt ) + veh_rot.transform(
-                                              veh_pt.raw() ) - veh_rot.transform( point::zero );
+                for( const point &offset : view_offsets ) {
+                    const point view_pt = view_nav_pt + offset;
                     if( !data.view_bounds.contains( view_pt ) || data.is_obstacle[view_pt.x][view_pt.y] ) {
                         valid = false;
                         break;
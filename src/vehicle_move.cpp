@@ -843,8 +843,6 @@ veh_collision vehicle::part_collision( map &here, int part, const tripoint_abs_m
     Creature *critter = get_creature_tracker().creature_at( p, true );
     Character *ph = dynamic_cast<Character *>( critter );
 
-    Character *driver = get_driver( here );
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
@@ -1111,6 +1109,7 @@ veh_collision vehicle::part_collision( map &here, int part, const tripoint_abs_m
                 critter->add_effect( effect_stunned, time_stunned );
             }
 
+            Character *driver = get_driver( here );
             if( ph != nullptr ) {
                 ph->hitall( dam, 40, driver );
             } else {
@@ -180,10 +180,10 @@ static void proc_weather_sum( const weather_type_id &wtype, weather_sum &data,
 weather_type_id current_weather( const tripoint_abs_ms &location, const time_point &t )
 {
     weather_manager &weather = get_weather();
-    const weather_generator wgen = weather.get_cur_weather_gen();
     if( weather.weather_override != WEATHER_NULL ) {
         return weather.weather_override;
     }
+    const weather_generator &wgen = weather.get_cur_weather_gen();
     return wgen.get_weather_conditions( location, t, g->get_seed() );
 }
 
@@ -195,6 +195,10 @@ weather_sum sum_conditions( const time_point &start, const time_point &end,
     weather_sum data;
 
     weather_manager &weather = get_weather();
+    // The wind is taken from the current weather at a fixed place, so it is the same every tick.
+    const int local_windpower = get_local_windpower( weather.windspeed,
+                                overmap_buffer.ter( project_to<coords::omt>( location ) ), location,
+                                weather.winddirection, false );
     for( time_point t = start; t < end; t += tick_size ) {
         const time_duration diff = end - t;
         if( diff < 10_turns ) {
@@ -207,10 +211,7 @@ weather_sum sum_conditions( const time_point &start, const time_point &end,
 
         weather_type_id wtype = current_weather( location, t );
         proc_weather_sum( wtype, data, t, tick_size );
-        data.wind_amount += get_local_windpower( weather.windspeed,
-                            overmap_buffer.ter( project_to<coords::omt>( location ) ),
-                            location,
-                            weather.winddirection, false ) * to_turns<int>( tick_size );
+        data.wind_amount += local_windpower * to_turns<int>( tick_size );
     }
     return data;
 }
@@ -557,9 +558,9 @@ std::string weather_forecast( const point_abs_sm &abs_sm_pos )
     // TODO: wind direction and speed
     const time_point last_hour = calendar::turn - ( calendar::turn - calendar::turn_zero ) %
                                  1_hours;
+    const weather_generator &wgen = get_weather().get_cur_weather_gen();
     for( int d = 0; d < 6; d++ ) {
         weather_type_id forecast = WEATHER_NULL;
-        const weather_generator wgen = get_weather().get_cur_weather_gen();
         for( time_point i = last_hour + d * 12_hours; i < last_hour + ( d + 1 ) * 12_hours; i += 1_hours ) {
             w_point w = wgen.get_weather( abs_ms_pos, i, g->get_seed() );
             *weather.weather_precise = w;
@@ -981,6 +982,19 @@ units::temperature weather_manager::get_temperature( const tripoint_bub_ms &loca
     return temp;
 }
 
+units::temperature_delta weather_manager::get_heat_radiation( const tripoint_bub_ms &location )
+{
+    // Other maps, loaded for mapgen or explosions, use the same coordinates for other places.
+    if( &get_map() != &reality_bubble() ) {
+        return ::get_heat_radiation( location );
+    }
+    const auto [it, inserted] = heat_radiation_cache.try_emplace( location );
+    if( inserted ) {
+        it->second = ::get_heat_radiation( location );
+    }
+    return it->second;
+}
+
 units::temperature weather_manager::get_temperature( const tripoint_abs_omt &location ) const
 {
     return location.z() < 0 ? units::from_celsius(
@@ -990,6 +1004,7 @@ units::temperature weather_manager::get_temperature( const tripoint_abs_omt &loc
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    heat_radiation_cache.clear();
 }
 
 const weather_manager &get_weather_const()
@@ -221,8 +221,12 @@ class weather_manager
         time_point nextweather;
         /** temperature cache, cleared every turn, sparse map of map tripoints to temperatures */
         std::unordered_map< tripoint_bub_ms, units::temperature > temperature_cache;
+        /** heat radiation cache, cleared with temperature_cache, for the reality bubble only */
+        std::unordered_map< tripoint_bub_ms, units::temperature_delta > heat_radiation_cache;
         // Returns outdoor or indoor temperature of given location
         units::temperature get_temperature( const tripoint_bub_ms &location );
+        // Returns get_heat_radiation( location ), worked out once per turn for each location
+        units::temperature_delta get_heat_radiation( const tripoint_bub_ms &location );
         // Returns outdoor or indoor temperature of given location
         units::temperature get_temperature( const tripoint_abs_omt &location ) const;
         void clear_temp_cache();
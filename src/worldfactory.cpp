@@ -3,18 +3,29 @@
 #include <algorithm>
 #include <array>
 #include <charconv>
+#include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <exception>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <set>
+#include <string>
+#include <system_error>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "cata_scope_helpers.h"
+#include "cata_thread_pool.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "char_validity_check.h"
 #include "color.h"
+#include "compression_dictionary.h"
 #include "cursesdef.h"
 #include "debug.h"
 #include "enums.h"
@@ -29,6 +40,7 @@
 #include "path_info.h"
 #include "point.h"
 #include "popup.h"
+#include "save_writer.h"
 #include "sounds.h"
 #include "string_formatter.h"
 #include "string_input_popup.h"
@@ -298,6 +310,8 @@ WORLD *worldfactory::make_new_world( special_game_type special_type )
 void worldfactory::set_active_world( WORLD *world )
 {
     world_generator->active_world = world;
+    // Another world, or the same one created again, has its own dictionaries.
+    compression_dictionary::reset();
     if( world ) {
         get_options().set_world_options( &world->WORLD_OPTIONS );
     } else {
@@ -2083,14 +2097,214 @@ bool WORLD::has_compression_enabled() const
            std::filesystem::exists( ( world_folder_path / "overmaps.dict" ).get_unrelative_path() );
 }
 
+namespace
+{
+
+// A piece of converting a world to or from compression that touches no files of any other,
+// so the pieces can run side by side on the thread pool.
+struct conversion_job {
+    // Names the job in the checkpoint, and is the path of the file or folder it converts.
+    std::string key;
+    std::function<bool()> run;
+    // Files it converts besides the one named by the key.
+    std::vector<std::filesystem::path> other_sources = {};
+};
+
+// Changes whenever a file in the given file or folder is added, removed, resized or written.
+uint64_t source_fingerprint( const std::filesystem::path &path )
+{
+    const auto entry_hash = []( const std::filesystem::path & p, const std::string & name ) {
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size( p, ec );
+        const int64_t time = std::filesystem::last_write_time( p, ec ).time_since_epoch().count();
+        uint64_t h = std::hash<std::string>()( name );
+        h = h * 0x100000001b3ULL ^ static_cast<uint64_t>( size );
+        h = h * 0x100000001b3ULL ^ static_cast<uint64_t>( time );
+        return h;
+    };
+    std::error_code ec;
+    if( !std::filesystem::is_directory( path, ec ) ) {
+        return std::filesystem::exists( path, ec ) ? entry_hash( path, std::string() ) : 0;
+    }
+    // Summed, as the order of the entries is up to the file system.
+    uint64_t fingerprint = 1;
+    for( const std::filesystem::directory_entry &entry :
+         std::filesystem::recursive_directory_iterator( path, ec ) ) {
+        if( entry.is_regular_file( ec ) ) {
+            fingerprint += entry_hash( entry.path(),
+                                       entry.path().lexically_relative( path ).generic_u8string() );
+        }
+    }
+    return fingerprint;
+}
+
+uint64_t job_fingerprint( const conversion_job &job )
+{
+    uint64_t fingerprint = source_fingerprint( std::filesystem::u8path( job.key ) );
+    for( const std::filesystem::path &source : job.other_sources ) {
+        fingerprint = fingerprint * 31 + source_fingerprint( source );
+    }
+    return fingerprint;
+}
+
+/**
+ * Records in the world folder which jobs of a conversion finished, so a conversion that was
+ * interrupted carries on from there the next time instead of starting over.  What is
+ * recorded only counts for the direction it was recorded for, and for the sources as they
+ * were: a job whose files changed since, e.g. because the world was played in between, is
+ * done again so its cleanup does not delete anything newer than the converted copy.
+ */
+class conversion_checkpoint
+{
+    public:
+        conversion_checkpoint( const cata_path &world_folder, bool compressing )
+            : path_( ( world_folder / "compression.checkpoint" ).get_unrelative_path() ) {
+            const std::string direction = compressing ? "compress" : "decompress";
+            std::ifstream fin( path_, std::ios::binary );
+            std::string line;
+            const bool resuming = std::getline( fin, line ) && line == direction;
+            while( resuming && std::getline( fin, line ) ) {
+                const size_t tab = line.rfind( '\t' );
+                if( tab != std::string::npos ) {
+                    done_[line.substr( 0, tab )] = line.substr( tab + 1 );
+                }
+            }
+            fin.close();
+            out_.open( path_, std::ios::binary | ( resuming ? std::ios::app : std::ios::trunc ) );
+            if( !resuming ) {
+                out_ << direction << '\n';
+            }
+        }
+
+        bool is_done( const conversion_job &job ) const {
+            const auto it = done_.find( job.key );
+            return it != done_.end() && it->second == std::to_string( job_fingerprint( job ) );
+        }
+
+        // The fingerprint is taken before the job runs, what it writes is not its source.
+        void mark_done( const conversion_job &job, uint64_t fingerprint ) {
+            out_ << job.key << '\t' << fingerprint << '\n';
+            out_.flush();
+        }
+
+        // Forget the progress once the whole conversion went through.
+        void finish() {
+            out_.close();
+            std::error_code ec;
+            std::filesystem::remove( path_, ec );
+        }
+
+    private:
+        std::filesystem::path path_;
+        std::unordered_map<std::string, std::string> done_;
+        std::ofstream out_;
+};
+
+// Runs the jobs that did not finish before on the thread pool, with their progress in the
+// popup.  If any of them fails, the others still run to the end so nothing is left writing.
+bool run_conversion_jobs( static_popup &popup, const std::string &message,
+                          const std::vector<conversion_job> &jobs, conversion_checkpoint &checkpoint )
+{
+    struct running_job {
+        const conversion_job *job;
+        uint64_t fingerprint;
+        std::future<bool> result;
+    };
+    std::vector<running_job> running;
+    size_t done = 0;
+    for( const conversion_job &job : jobs ) {
+        if( checkpoint.is_done( job ) ) {
+            ++done;
+            continue;
+        }
+        running.push_back( running_job{ &job, job_fingerprint( job ),
+                                        cata::get_thread_pool().submit( [&job]() {
+            return job.run();
+        } ) } );
+    }
+    bool success = true;
+    while( true ) {
+        popup.message( message, done, jobs.size() );
+        ui_manager::redraw();
+        refresh_display();
+        inp_mngr.pump_events();
+        if( running.empty() ) {
+            break;
+        }
+        running.front().result.wait_for( std::chrono::milliseconds( 50 ) );
+        for( auto it = running.begin(); it != running.end(); ) {
+            if( it->result.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+                ++it;
+                continue;
+            }
+            bool job_done = false;
+            try {
+                job_done = it->result.get();
+            } catch( const std::exception &err ) {
+                DebugLog( D_ERROR, DC_ALL ) << "Converting " << it->job->key << " failed: "
+                                            << err.what();
+            }
+            if( job_done ) {
+                checkpoint.mark_done( *it->job, it->fingerprint );
+            } else {
+                success = false;
+            }
+            ++done;
+            it = running.erase( it );
+        }
+    }
+    return success;
+}
+
+// Zzips left over by a job that was interrupted would otherwise get everything added twice.
+void remove_partial_zzip( const std::filesystem::path &path )
+{
+    std::error_code ec;
+    std::filesystem::remove( path, ec );
+}
+
+// The old format starts save files with a `# version <number>` line, from a time when the
+// file had to be loaded linearly in text.  We now parse to a binary format and can random
+// access anything in constant time, and the compressed save load path requires the version
+// as a regular json member instead, so it is inserted textually.
+std::string save_contents_for_zzip( std::string savefile_contents )
+{
+    if( savefile_contents.empty() || savefile_contents[0] != '#' ) {
+        return savefile_contents;
+    }
+    size_t newline = savefile_contents.find( '\n' );
+    size_t char_after_open_brace = savefile_contents.find_first_not_of( '{', newline + 1 );
+    std::string_view header{ savefile_contents.data(), newline };
+    std::string_view savefile_json{ savefile_contents.data() + char_after_open_brace,
+                                    savefile_contents.size() - char_after_open_brace };
+    int savefile_version = std::strtol( header.data() + header.find_last_of( ' ' ), nullptr, 10 );
+    std::string converted;
+    converted.reserve( savefile_json.size() + 32 ); // 30 for text and 2 for digits.
+    converted.append( "{\"savegame_loading_version\":" );
+    converted.append( std::to_string( savefile_version ) );
+    converted.append( ",\n" );
+    converted.append( savefile_json );
+    return converted;
+}
+
+} // namespace
+
 bool WORLD::set_compression_enabled( bool enabled ) const
 {
+    // Nothing may still be writing the files this moves around
+    get_save_writer().flush();
     // Return immediately if we're already in the desired state.
     if( enabled == has_compression_enabled() ) {
         return true;
     }
+    // The dictionaries are copied in or deleted below.
+    on_out_of_scope reset_dictionaries( []() {
+        compression_dictionary::reset();
+    } );
     static_popup popup;
     cata_path world_folder_path = folder_path();
+    // Maps segments, overmaps, map memories and saves each convert on their own, in parallel.
+    conversion_checkpoint checkpoint( world_folder_path, enabled );
     if( enabled ) {
         cata_path dictionary_folder = PATH_INFO::compression_folder_path();
         cata_path maps_dict = dictionary_folder / "maps.dict";
@@ -2103,26 +2317,29 @@ bool WORLD::set_compression_enabled( bool enabled ) const
         {
             std::vector<cata_path> maps_folders = get_directories( world_folder_path / "maps" );
             std::filesystem::path maps_dict_path = maps_dict.get_unrelative_path();
-            size_t done = 0;
+            std::vector<conversion_job> jobs;
             for( const cata_path &map_folder : maps_folders ) {
-                popup.message( _( "Compressing maps [%d/%d]" ), done++, maps_folders.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
-                if( !zzip::create_from_folder( ( map_folder + ".zzip" ).get_unrelative_path(),
-                                               map_folder.get_unrelative_path(), maps_dict_path ) ) {
-                    return false;
-                }
+                jobs.push_back( conversion_job{ map_folder.generic_u8string(), [map_folder,
+                                maps_dict_path]() {
+                    const std::filesystem::path zzip_path = ( map_folder + ".zzip" )
+                                                            .get_unrelative_path();
+                    remove_partial_zzip( zzip_path );
+                    return zzip::create_from_folder( zzip_path, map_folder.get_unrelative_path(),
+                                                     maps_dict_path ) != nullptr;
+                } } );
+            }
+            if( !run_conversion_jobs( popup, _( "Compressing maps [%d/%d]" ), jobs, checkpoint ) ) {
+                return false;
             }
             folders_to_clean = std::move( maps_folders );
         }
         {
             std::vector<cata_path> overmaps = get_files_from_path( "o.", world_folder_path );
             files_to_clean.reserve( files_to_clean.size() + overmaps.size() );
-            size_t done = 0;
-            std::error_code ec;
             assure_dir_exist( world_folder_path / "overmaps" );
             std::filesystem::path world_folder_unrelative_path = world_folder_path.get_unrelative_path();
+            std::filesystem::path overmaps_dict_path = overmaps_dict.get_unrelative_path();
+            std::vector<conversion_job> jobs;
             for( const cata_path &overmap : overmaps ) {
                 // Some random other files might have `o.` in the name. We only care about the actual
                 // overmap files whose names start with `o.`.
@@ -2131,109 +2348,107 @@ bool WORLD::set_compression_enabled( bool enabled ) const
                 if( overmap_file_name.generic_u8string().find( "o." ) != 0 ) {
                     continue;
                 }
-                popup.message( _( "Compressing overmaps [%d/%d]" ), done++, overmaps.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
+                // The dynamic part of an overmap goes into the zzip of its terrain file.
+                if( overmap_file_name.extension() == ".dynamic" ) {
+                    continue;
+                }
 
                 // Each overmap gets put into its own zzip indexed by its own file name.
-                std::shared_ptr overmap_zzip = zzip::create_from_folder_with_files( (
-                                                   world_folder_path / "overmaps" / overmap_file_name + ".zzip" ).get_unrelative_path(),
-                                               world_folder_unrelative_path, { overmap_file_path }, 0,
-                                               overmaps_dict.get_unrelative_path() );
-                if( !overmap_zzip ) {
-                    return false;
+                std::vector<std::filesystem::path> overmap_files{ overmap_file_path };
+                const cata_path dynamic_file = overmap + ".dynamic";
+                const bool has_dynamic_file = file_exist( dynamic_file );
+                if( has_dynamic_file ) {
+                    overmap_files.push_back( dynamic_file.get_unrelative_path() );
                 }
+                const std::filesystem::path zzip_path = ( world_folder_path / "overmaps" / overmap_file_name +
+                                                        ".zzip" ).get_unrelative_path();
+                jobs.push_back( conversion_job{ overmap.generic_u8string(), [zzip_path,
+                                world_folder_unrelative_path, overmap_files, overmaps_dict_path]() {
+                    remove_partial_zzip( zzip_path );
+                    return zzip::create_from_folder_with_files( zzip_path, world_folder_unrelative_path,
+                            overmap_files, 0, overmaps_dict_path ) != nullptr;
+                }, overmap_files } );
                 files_to_clean.push_back( overmap );
+                if( has_dynamic_file ) {
+                    files_to_clean.push_back( dynamic_file );
+                }
+            }
+            if( !run_conversion_jobs( popup, _( "Compressing overmaps [%d/%d]" ), jobs, checkpoint ) ) {
+                return false;
             }
         }
         {
-            std::vector<cata_path> character_map_memories;
-            size_t done = 0;
             // Each of these is a folder for per-character map memory.
             // We compress each into a zzip_stack, with the same folder name for simplicity.
             // Each map memory region file inside the folders is compressed separately.
-            character_map_memories = get_files_from_path( ".mm1", folder_path(), false, true );
+            std::vector<cata_path> character_map_memories = get_files_from_path( ".mm1", folder_path(),
+                    false, true );
+            std::filesystem::path mmr_dict_path = mmr_dict.get_unrelative_path();
+            std::vector<conversion_job> jobs;
             for( const cata_path &character_map_memory_folder : character_map_memories ) {
-                popup.message( _( "Compressing map memory [%d/%d]" ), done++, character_map_memories.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
-
                 std::vector<cata_path> character_map_memory_files = get_files_from_path( ".mmr",
                         character_map_memory_folder, false, true );
                 std::filesystem::path mmr_path = character_map_memory_folder.get_unrelative_path();
+                std::vector<std::filesystem::path> mmr_files;
                 for( const cata_path &map_memory : character_map_memory_files ) {
-                    std::filesystem::path map_memory_filename = map_memory.get_unrelative_path().filename();
-                    std::shared_ptr<zzip_stack> map_memory_zzip = zzip_stack::create_from_folder_with_files(
-                                character_map_memory_folder.get_unrelative_path(),
-                                mmr_path, { mmr_path / map_memory_filename }, 0,
-                                mmr_dict.get_unrelative_path() );
-                    if( !map_memory_zzip ) {
-                        return false;
-                    }
+                    mmr_files.emplace_back( mmr_path / map_memory.get_unrelative_path().filename() );
                 }
+                jobs.push_back( conversion_job{ character_map_memory_folder.generic_u8string(), [mmr_path,
+                                mmr_files, mmr_dict_path]() {
+                    std::error_code ec;
+                    for( const std::filesystem::directory_entry &entry :
+                         std::filesystem::directory_iterator( mmr_path, ec ) ) {
+                        if( entry.path().extension() == ".zzip" ) {
+                            remove_partial_zzip( entry.path() );
+                        }
+                    }
+                    return mmr_files.empty() ||
+                           zzip_stack::create_from_folder_with_files( mmr_path, mmr_path, mmr_files, 0,
+                                   mmr_dict_path ) != nullptr;
+                } } );
 
                 files_to_clean.insert( files_to_clean.end(), character_map_memory_files.begin(),
                                        character_map_memory_files.end() );
             }
+            if( !run_conversion_jobs( popup, _( "Compressing map memory [%d/%d]" ), jobs, checkpoint ) ) {
+                return false;
+            }
         }
         {
-            std::vector<cata_path> saves;
-            size_t done = 0;
-            std::error_code ec;
-            saves = get_files_from_path( ".sav", world_folder_path );
+            std::vector<cata_path> saves = get_files_from_path( ".sav", world_folder_path );
+            std::vector<conversion_job> jobs;
             for( const cata_path &save : saves ) {
-                popup.message( _( "Compressing main save files [%d/%d]" ), done++, saves.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
-
                 // Each save gets put into its own zzip indexed by its own file name.
                 std::filesystem::path save_file_path = save.get_unrelative_path();
                 std::filesystem::path save_file_name = save_file_path.filename();
-
-                // But first, we have to do some surgery.
-                // Current the first line of a save file is a hokey line like
-                // # version <number>
-                // This is outdated from a time when the file had to be loaded linearly
-                // in text. We now parse to a binary format and can random access anything
-                // in constant time. The new format encodes the version as a regular json
-                // member. The compressed save load path requires that. So first we test if
-                // the first line is this format and we insert it manually textually if it is.
-                std::string savefile_contents = read_entire_file( save_file_path );
-                if( savefile_contents.empty() ) {
+                std::error_code ec;
+                // The zzips of saves converted before an interruption match too.
+                if( save_file_name.extension() != ".sav" ||
+                    std::filesystem::file_size( save_file_path, ec ) == 0 ) {
                     // Eh just skip it.
                     continue;
                 }
-                if( savefile_contents[0] == '#' ) {
-                    // Parse the version header.
-                    std::string temp_savefile_contents = std::move( savefile_contents );
-                    savefile_contents.clear();
-                    size_t newline = temp_savefile_contents.find( '\n' );
-                    size_t char_after_open_brace = temp_savefile_contents.find_first_not_of( '{', newline + 1 );
-                    std::string_view header{ temp_savefile_contents.data(), newline };
-                    std::string_view savefile_json{ temp_savefile_contents.data() + char_after_open_brace, temp_savefile_contents.size() - char_after_open_brace };
-                    int temp_savefile_version = std::strtol( header.data() + header.find_last_of( ' ' ), nullptr, 10 );
-                    savefile_contents.reserve( savefile_json.size() + 32 ); // 30 for text and 2 for digits.
-                    savefile_contents.append( "{\"savegame_loading_version\":" );
-                    savefile_contents.append( std::to_string( temp_savefile_version ) );
-                    savefile_contents.append( ",\n" );
-                    savefile_contents.append( savefile_json );
-                };
-
-                std::shared_ptr save_zzip = zzip::load( ( world_folder_path / save_file_name +
-                                                        ".zzip" ).get_unrelative_path() );
-                if( !save_zzip ) {
-                    return false;
-                }
-                save_zzip->add_file( save_file_name, savefile_contents );
+                const std::filesystem::path zzip_path = ( world_folder_path / save_file_name +
+                                                        ".zzip" ).get_unrelative_path();
+                jobs.push_back( conversion_job{ save.generic_u8string(), [save_file_path, save_file_name,
+                                zzip_path]() {
+                    std::string savefile_contents = save_contents_for_zzip( read_entire_file(
+                                                        save_file_path ) );
+                    remove_partial_zzip( zzip_path );
+                    std::shared_ptr save_zzip = zzip::load( zzip_path );
+                    return save_zzip && save_zzip->add_file( save_file_name, savefile_contents );
+                } } );
                 files_to_clean.push_back( save );
             }
+            if( !run_conversion_jobs( popup, _( "Compressing main save files [%d/%d]" ), jobs,
+                                      checkpoint ) ) {
+                return false;
+            }
         }
         copy_file( maps_dict, folder_path() / "maps.dict" );
         copy_file( overmaps_dict, folder_path() / "overmaps.dict" );
         copy_file( mmr_dict, folder_path() / "mmr.dict" );
+        checkpoint.finish();
         size_t done = 0;
         size_t to_do = folders_to_clean.size() + files_to_clean.size();
         for( const cata_path &folder : folders_to_clean ) {
@@ -2270,91 +2485,88 @@ bool WORLD::set_compression_enabled( bool enabled ) const
         zzips_to_clean.reserve( maps_zzips.size() + overmap_zzips.size() +
                                 character_map_memory_folders.size() * 3 );
 
-        size_t done = 0;
         {
             std::filesystem::path maps_dict_path = maps_dict.get_unrelative_path();
+            std::vector<conversion_job> jobs;
             for( const cata_path &map_zzip : maps_zzips ) {
-                popup.message( _( "Decompressing maps [%d/%d]" ), done++, maps_zzips.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
                 std::filesystem::path zzip_path = map_zzip.get_unrelative_path();
-                std::filesystem::path dest_folder_name = zzip_path.parent_path() / zzip_path.stem();
-                if( !zzip::extract_to_folder( zzip_path, dest_folder_name, maps_dict_path ) ) {
-                    return false;
-                }
+                jobs.push_back( conversion_job{ map_zzip.generic_u8string(), [zzip_path,
+                                maps_dict_path]() {
+                    std::filesystem::path dest_folder_name = zzip_path.parent_path() / zzip_path.stem();
+                    return zzip::extract_to_folder( zzip_path, dest_folder_name, maps_dict_path );
+                } } );
+            }
+            if( !run_conversion_jobs( popup, _( "Decompressing maps [%d/%d]" ), jobs, checkpoint ) ) {
+                return false;
             }
             zzips_to_clean.insert( zzips_to_clean.end(), maps_zzips.begin(), maps_zzips.end() );
         }
         {
-            size_t done = 0;
             std::filesystem::path overmaps_dict_path = overmaps_dict.get_unrelative_path();
             zzips_to_clean.reserve( zzips_to_clean.size() + overmap_zzips.size() );
             std::filesystem::path dest_folder_name = folder_path().get_unrelative_path();
-            for( cata_path &overmap_zzip : overmap_zzips ) {
-
-                popup.message( _( "Decompressing overmaps [%d/%d]" ), done++, overmap_zzips.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
-
+            std::vector<conversion_job> jobs;
+            for( const cata_path &overmap_zzip : overmap_zzips ) {
                 std::filesystem::path zzip_path = overmap_zzip.get_unrelative_path();
-                if( !zzip::extract_to_folder( zzip_path, dest_folder_name, overmaps_dict_path ) ) {
-                    return false;
-                }
-                zzips_to_clean.push_back( std::move( overmap_zzip ) );
+                jobs.push_back( conversion_job{ overmap_zzip.generic_u8string(), [zzip_path, dest_folder_name,
+                                overmaps_dict_path]() {
+                    return zzip::extract_to_folder( zzip_path, dest_folder_name, overmaps_dict_path );
+                } } );
+            }
+            if( !run_conversion_jobs( popup, _( "Decompressing overmaps [%d/%d]" ), jobs, checkpoint ) ) {
+                return false;
             }
+            zzips_to_clean.insert( zzips_to_clean.end(), overmap_zzips.begin(), overmap_zzips.end() );
             zzips_to_clean.push_back( world_folder_path / "overmaps" );
         }
         {
-            size_t done = 0;
             std::filesystem::path mmr_dict_path = mmr_dict.get_unrelative_path();
             std::vector<cata_path> character_map_memory_zzips;
+            std::vector<conversion_job> jobs;
             for( const cata_path &character_map_memory_zzip : character_map_memory_folders ) {
-                popup.message( _( "Decompressing map memory [%d/%d]" ), done++,
-                               character_map_memory_folders.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
-
                 std::filesystem::path zzip_path = character_map_memory_zzip.get_unrelative_path();
                 // We reuse the same folder for the map memory files.
-                const std::filesystem::path &dest_folder_name = zzip_path;
-                if( !zzip_stack::extract_to_folder( zzip_path, dest_folder_name, mmr_dict_path ) ) {
-                    return false;
-                }
+                jobs.push_back( conversion_job{ character_map_memory_zzip.generic_u8string(), [zzip_path,
+                                mmr_dict_path]() {
+                    return zzip_stack::extract_to_folder( zzip_path, zzip_path, mmr_dict_path );
+                } } );
 
                 character_map_memory_zzips.emplace_back( character_map_memory_zzip /
-                        dest_folder_name.filename().concat( ".cold.zzip" ) ); // NOLINT(cata-u8-path)
+                        zzip_path.filename().concat( ".cold.zzip" ) ); // NOLINT(cata-u8-path)
                 character_map_memory_zzips.emplace_back( character_map_memory_zzip /
-                        dest_folder_name.filename().concat( ".warm.zzip" ) ); // NOLINT(cata-u8-path)
+                        zzip_path.filename().concat( ".warm.zzip" ) ); // NOLINT(cata-u8-path)
                 character_map_memory_zzips.emplace_back( character_map_memory_zzip /
-                        dest_folder_name.filename().concat( ".hot.zzip" ) ); // NOLINT(cata-u8-path)
+                        zzip_path.filename().concat( ".hot.zzip" ) ); // NOLINT(cata-u8-path)
+            }
+            if( !run_conversion_jobs( popup, _( "Decompressing map memory [%d/%d]" ), jobs,
+                                      checkpoint ) ) {
+                return false;
             }
             zzips_to_clean.insert( zzips_to_clean.end(), character_map_memory_zzips.begin(),
                                    character_map_memory_zzips.end() );
         }
         {
-            size_t done = 0;
             std::filesystem::path dest_folder_name = world_folder_path.get_unrelative_path();
-            for( cata_path &save_zzip : save_zzips ) {
-
-                popup.message( _( "Decompressing main save files [%d/%d]" ), done++, overmap_zzips.size() );
-                ui_manager::redraw();
-                refresh_display();
-                inp_mngr.pump_events();
-
+            std::vector<conversion_job> jobs;
+            for( const cata_path &save_zzip : save_zzips ) {
                 std::filesystem::path zzip_path = save_zzip.get_unrelative_path();
-                if( !zzip::extract_to_folder( zzip_path, dest_folder_name ) ) {
-                    return false;
-                }
-                zzips_to_clean.push_back( std::move( save_zzip ) );
+                jobs.push_back( conversion_job{ save_zzip.generic_u8string(), [zzip_path,
+                                dest_folder_name]() {
+                    return zzip::extract_to_folder( zzip_path, dest_folder_name );
+                } } );
+            }
+            if( !run_conversion_jobs( popup, _( "Decompressing main save files [%d/%d]" ), jobs,
+                                      checkpoint ) ) {
+                return false;
             }
+            zzips_to_clean.insert( zzips_to_clean.end(), save_zzips.begin(), save_zzips.end() );
         }
-        remove_file( maps_dict );
-        remove_file( overmaps_dict );
-        remove_file( mmr_dict );
-        done = 0;
+        // Along with the dictionaries the world retrained.
+        for( const cata_path &dict : get_files_from_path( ".dict", world_folder_path, false, true ) ) {
+            remove_file( dict );
+        }
+        checkpoint.finish();
+        size_t done = 0;
         for( const cata_path &zzip_to_clean : zzips_to_clean ) {
             popup.message( _( "Cleaning up [%d/%d]" ), done++, zzips_to_clean.size() );
             ui_manager::redraw();
@@ -2418,6 +2630,8 @@ static bool isForbidden( const cata_path &candidate )
 
 void worldfactory::delete_world( const std::string &worldname, const bool delete_folder )
 {
+    // Or writes still in flight would bring files back
+    get_save_writer().flush();
     cata_path worldpath = get_world( worldname )->folder_path();
     std::set<std::filesystem::path> directory_paths;
 
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <exception>
 #include <functional>
-#include <iosfwd>
+#include <istream>
 #include <memory>
 #include <optional>
 #include <string>
@@ -24,6 +26,7 @@
 #include <zstd/common/xxhash.h>
 
 #include "cata_scope_helpers.h"
+#include "cata_thread_pool.h"
 #include "filesystem.h"
 #include "flexbuffer_cache.h"
 #include "flexbuffer_json.h"
@@ -33,6 +36,31 @@
 namespace
 {
 
+// Added to by every thread, read by get_io_stats.
+struct io_counters {
+    std::atomic<uint64_t> entries_written{ 0 };
+    std::atomic<uint64_t> bytes_written{ 0 };
+    std::atomic<uint64_t> compressed_bytes_written{ 0 };
+    std::atomic<uint64_t> write_us{ 0 };
+    std::atomic<uint64_t> entries_read{ 0 };
+    std::atomic<uint64_t> bytes_read{ 0 };
+    std::atomic<uint64_t> read_us{ 0 };
+    std::atomic<uint64_t> compactions{ 0 };
+    std::atomic<uint64_t> compacted_bytes{ 0 };
+};
+
+io_counters &counters()
+{
+    static io_counters c;
+    return c;
+}
+
+uint64_t us_since( const std::chrono::steady_clock::time_point start )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start ).count();
+}
+
 // Implementations of the mandatory Json helper types
 // to use flexbuffers/JsonObject with zzips.
 
@@ -85,8 +113,9 @@ struct zzip_vector_storage : flexbuffer_storage {
     }
 };
 
-// To save time, and because we aren't multithreading, we can cache zstd
-// compress and decompress contexts, indexed by dictionary path.
+// To save time we cache zstd compress and decompress contexts, indexed by dictionary path.
+// zzips are used from the save writer and thread pool workers as well as the main thread,
+// so each thread keeps its own.
 struct cached_zstd_context {
     std::vector<char> dictionary_;
     ZSTD_CCtx *cctx = nullptr;
@@ -134,7 +163,64 @@ struct cached_zstd_context {
     }
 };
 
-std::unordered_map<std::string, cached_zstd_context> cached_contexts;
+thread_local std::unordered_map<std::string, cached_zstd_context> cached_contexts;
+// Bumped by zzip::invalidate_dictionary_cache.
+std::atomic<uint64_t> cached_contexts_generation{ 0 };
+thread_local uint64_t cached_contexts_thread_generation = 0;
+// Contexts from before an invalidation.  Open zzips may still point at them, so they are
+// only kept out of lookups, not freed.
+thread_local std::vector<std::unordered_map<std::string, cached_zstd_context>>
+retired_cached_contexts;
+
+cached_zstd_context &cached_context_for( std::filesystem::path const &dictionary_path )
+{
+    const uint64_t generation = cached_contexts_generation.load( std::memory_order_acquire );
+    if( generation != cached_contexts_thread_generation ) {
+        cached_contexts_thread_generation = generation;
+        if( !cached_contexts.empty() ) {
+            retired_cached_contexts.emplace_back( std::move( cached_contexts ) );
+            cached_contexts.clear();
+        }
+    }
+    if( auto it = cached_contexts.find( dictionary_path.string() ); it != cached_contexts.end() ) {
+        return it->second;
+    }
+    ZSTD_CCtx *cctx = ZSTD_createCCtx();
+    ZSTD_DCtx *dctx = ZSTD_createDCtx();
+
+    std::vector<char> dictionary;
+    if( !dictionary_path.empty() ) {
+        ZSTD_CCtx_setParameter( cctx, ZSTD_c_compressionLevel, 7 );
+        std::shared_ptr<const mmap_file> dictionary_file = mmap_file::map_file( dictionary_path );
+        // A missing dictionary leaves the context without one, the entries that needed it
+        // fail to decompress instead of crashing.
+        if( dictionary_file ) {
+            dictionary.resize( dictionary_file->len() );
+            memcpy( dictionary.data(), dictionary_file->base(), dictionary_file->len() );
+            ZSTD_CCtx_loadDictionary_byReference( cctx, dictionary.data(), dictionary.size() );
+            ZSTD_DCtx_loadDictionary_byReference( dctx, dictionary.data(), dictionary.size() );
+        }
+    }
+
+    return cached_contexts.emplace( dictionary_path.string(),
+                                    cached_zstd_context{ std::move( dictionary ), cctx, dctx } ).first->second;
+}
+
+// The cached context for entries compressed with the given version of this zzip's
+// dictionary, or nullptr if that version is gone.
+cached_zstd_context *context_for_version( const std::filesystem::path &dictionary_path,
+                                          uint32_t version )
+{
+    const std::filesystem::path path = zzip::dictionary_version_path( dictionary_path, version );
+    if( path.empty() && version != 0 ) {
+        return nullptr;
+    }
+    std::error_code ec;
+    if( !path.empty() && !std::filesystem::exists( path, ec ) ) {
+        return nullptr;
+    }
+    return &cached_context_for( path );
+}
 
 } // namespace
 
@@ -149,11 +235,13 @@ namespace
 
 constexpr unsigned int kEntryFileNameMagic = 0;
 constexpr unsigned int kEntryChecksumMagic = 1;
+constexpr unsigned int kEntryDictionaryMagic = 2;
 constexpr unsigned int kFooterChecksumMagic = 15;
 
 constexpr size_t kFooterChecksumContentSize = 2 * sizeof( uint64_t );
 constexpr size_t kFooterChecksumFrameSize = ZSTD_SKIPPABLEHEADERSIZE + kFooterChecksumContentSize;
 constexpr size_t kEntryChecksumFrameSize = ZSTD_SKIPPABLEHEADERSIZE + sizeof( uint64_t );
+constexpr size_t kEntryDictionaryFrameSize = ZSTD_SKIPPABLEHEADERSIZE + sizeof( uint32_t );
 constexpr size_t kDefaultFooterSize = 1024;
 
 constexpr size_t kFixedSizeOverhead = kFooterChecksumFrameSize + kDefaultFooterSize;
@@ -284,6 +372,38 @@ bool write_footer_len_and_checksum( void *base, uint64_t frame_len, uint64_t foo
     return true;
 }
 
+// Writes the checksum frame for the compressed frame of an entry to dest.
+// Returns its size or the zstd error.
+size_t write_entry_checksum( void *dest, const void *frame, size_t frame_size )
+{
+    uint64_t checksum = XXH64( frame, frame_size, kCheckumSeed );
+    uint64_t checksum_le = 0;
+    MEM_writeLE64( &checksum_le, checksum );
+    return ZSTD_writeSkippableFrame(
+               dest,
+               kEntryChecksumFrameSize,
+               reinterpret_cast<const char *>( &checksum_le ),
+               sizeof( checksum_le ),
+               kEntryChecksumMagic
+           );
+}
+
+// Writes the frame recording which version of the dictionary an entry was compressed with.
+// Entries without one use the unversioned dictionary.
+// Returns its size or the zstd error.
+size_t write_entry_dictionary_version( void *dest, size_t capacity, uint32_t version )
+{
+    uint32_t version_le = 0;
+    MEM_writeLE32( &version_le, version );
+    return ZSTD_writeSkippableFrame(
+               dest,
+               capacity,
+               reinterpret_cast<const char *>( &version_le ),
+               sizeof( version_le ),
+               kEntryDictionaryMagic
+           );
+}
+
 // Given a pointer and length of an encoded entry, reads or skips the metadata
 // and returns a pointer to the beginning of any content after the metadata frames.
 // Returns { nullptr, 0 } on any detected errors.
@@ -291,7 +411,8 @@ std::pair<void *, size_t> read_and_skip_entry_metadata(
     void *entry_base,
     size_t entry_len,
     std::optional<std::string> *filename_out = nullptr,
-    std::optional<uint64_t> *checksum_out = nullptr )
+    std::optional<uint64_t> *checksum_out = nullptr,
+    std::optional<uint32_t> *dictionary_version_out = nullptr )
 {
     char *base = static_cast<char *>( entry_base );
     while( entry_len > 0 && ZSTD_isSkippableFrame( base, entry_len ) ) {
@@ -314,6 +435,14 @@ std::pair<void *, size_t> read_and_skip_entry_metadata(
                 }
                 checksum_out->emplace( MEM_readLE64( &checksum ) );
             }
+            if( dictionary_version_out && header.dictID == kEntryDictionaryMagic ) {
+                uint32_t version;
+                size_t ec = ZSTD_readSkippableFrame( &version, sizeof( version ), nullptr, base, entry_len );
+                if( ZSTD_isError( ec ) || ec != sizeof( uint32_t ) ) {
+                    return { nullptr, 0 };
+                }
+                dictionary_version_out->emplace( MEM_readLE32( &version ) );
+            }
         } else {
             return { nullptr, 0 };
         }
@@ -331,13 +460,151 @@ std::pair<void *, size_t> read_and_skip_entry_metadata(
 } // namespace
 
 struct zzip::context {
-    context( ZSTD_CCtx *cctx, ZSTD_DCtx *dctx )
-        : cctx{ cctx }, dctx{ dctx }
+    context( ZSTD_CCtx *cctx, ZSTD_DCtx *dctx, const std::vector<char> &dictionary,
+             std::filesystem::path dictionary_path )
+        : cctx{ cctx }, dctx{ dctx }, dictionary{ dictionary },
+          dictionary_path{ std::move( dictionary_path ) },
+          dictionary_version{ zzip::dictionary_version( this->dictionary_path ) }
     {}
     ZSTD_CCtx *cctx;
     ZSTD_DCtx *dctx;
+    // Owned by the cached context, for streams that decompress with their own context.
+    const std::vector<char> &dictionary;
+    // For other threads to find their own contexts with the same dictionary.
+    std::filesystem::path dictionary_path;
+    // Recorded with every entry written, so entries stay readable after the dictionary
+    // is retrained.
+    uint32_t dictionary_version;
 };
 
+namespace
+{
+
+// Decompresses one zzip entry a chunk at a time as it is read.  Seeking is supported
+// because JsonIn relies on it: short steps back stay within the chunk, anything else
+// decompresses again from the start or skips ahead.
+class zstd_istreambuf : public std::streambuf
+{
+    public:
+        zstd_istreambuf( std::shared_ptr<mmap_file> file, const void *frame, size_t frame_len,
+                         const std::vector<char> &dictionary )
+            : file_{ std::move( file ) },
+              in_{ frame, frame_len, 0 },
+              content_size_{ ZSTD_getFrameContentSize( frame, frame_len ) },
+              dctx_{ ZSTD_createDCtx() },
+              buffer_( kChunkSize ) {
+            if( !dictionary.empty() ) {
+                ZSTD_DCtx_loadDictionary_byReference( dctx_, dictionary.data(), dictionary.size() );
+            }
+            setg( buffer_.data(), buffer_.data(), buffer_.data() );
+        }
+
+        zstd_istreambuf( const zstd_istreambuf & ) = delete;
+        zstd_istreambuf &operator=( const zstd_istreambuf & ) = delete;
+
+        ~zstd_istreambuf() override {
+            ZSTD_freeDCtx( dctx_ );
+        }
+
+    protected:
+        int_type underflow() override {
+            if( gptr() == egptr() && !fill() ) {
+                return traits_type::eof();
+            }
+            return traits_type::to_int_type( *gptr() );
+        }
+
+        pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                          std::ios_base::openmode /*which*/ ) override {
+            if( dir == std::ios_base::cur ) {
+                return seek_to( chunk_pos_ + ( gptr() - eback() ) + off );
+            } else if( dir == std::ios_base::end ) {
+                if( ZSTD_isError( content_size_ ) || content_size_ == ZSTD_CONTENTSIZE_UNKNOWN ) {
+                    return pos_type( off_type( -1 ) );
+                }
+                return seek_to( static_cast<off_type>( content_size_ ) + off );
+            }
+            return seek_to( off );
+        }
+
+        pos_type seekpos( pos_type pos, std::ios_base::openmode /*which*/ ) override {
+            return seek_to( pos );
+        }
+
+    private:
+        static constexpr size_t kChunkSize = 64 * 1024;
+        // Bytes of the previous chunk kept at the start of the next one.
+        static constexpr size_t kKeepBehind = 64;
+
+        pos_type seek_to( off_type target ) {
+            if( target < 0 ) {
+                return pos_type( off_type( -1 ) );
+            }
+            if( target < chunk_pos_ ) {
+                // Back to before this chunk, start over.
+                ZSTD_DCtx_reset( dctx_, ZSTD_reset_session_only );
+                in_.pos = 0;
+                chunk_pos_ = 0;
+                finished_ = false;
+                setg( buffer_.data(), buffer_.data(), buffer_.data() );
+            }
+            while( target > chunk_pos_ + ( egptr() - eback() ) ) {
+                if( !fill() ) {
+                    return pos_type( off_type( -1 ) );
+                }
+            }
+            setg( eback(), eback() + ( target - chunk_pos_ ), egptr() );
+            return target;
+        }
+
+        // Decompresses the next chunk.  Returns false at the end of the entry, or if it is
+        // corrupt.
+        bool fill() {
+            const size_t available = egptr() - eback();
+            const size_t keep = std::min( kKeepBehind, available );
+            std::memmove( buffer_.data(), egptr() - keep, keep );
+            chunk_pos_ += available - keep;
+
+            ZSTD_outBuffer out{ buffer_.data() + keep, buffer_.size() - keep, 0 };
+            while( out.pos == 0 && !finished_ ) {
+                const size_t ret = ZSTD_decompressStream( dctx_, &out, &in_ );
+                // Stop on errors, a finished frame, or input that ran out before it finished.
+                if( ZSTD_isError( ret ) || ret == 0 ||
+                    ( in_.pos == in_.size && out.pos < out.size ) ) {
+                    finished_ = true;
+                }
+            }
+            setg( buffer_.data(), buffer_.data() + keep, buffer_.data() + keep + out.pos );
+            return out.pos > 0;
+        }
+
+        // Keeps the mapping with the frame alive.
+        std::shared_ptr<mmap_file> file_;
+        ZSTD_inBuffer in_;
+        unsigned long long content_size_;
+        ZSTD_DCtx *dctx_;
+        std::vector<char> buffer_;
+        // Position in the entry of the start of buffer_.
+        off_type chunk_pos_ = 0;
+        bool finished_ = false;
+};
+
+class zstd_istream : public std::istream
+{
+    public:
+        zstd_istream( std::shared_ptr<mmap_file> file, const void *frame, size_t frame_len,
+                      const std::vector<char> &dictionary )
+            : std::istream( nullptr ),
+              buf_( std::move( file ), frame, frame_len, dictionary ) {
+            rdbuf( &buf_ );
+        }
+
+    private:
+        zstd_istreambuf buf_;
+};
+
+} // namespace
+
 zzip::zzip( std::filesystem::path path, std::shared_ptr<mmap_file> file, JsonObject footer )
     : path_{ std::move( path ) },
       file_{ std::move( file ) },
@@ -349,6 +616,45 @@ zzip::~zzip() noexcept
     footer_.allow_omitted_members();
 }
 
+uint32_t zzip::dictionary_version( std::filesystem::path const &dictionary )
+{
+    // NOLINTNEXTLINE(cata-u8-path)
+    const std::string version = dictionary.stem().extension().string();
+    if( version.size() < 2 || version.size() > 10 ) {
+        return 0;
+    }
+    uint32_t ret = 0;
+    for( size_t i = 1; i < version.size(); ++i ) {
+        if( version[i] < '0' || version[i] > '9' ) {
+            return 0;
+        }
+        ret = ret * 10 + ( version[i] - '0' );
+    }
+    return ret;
+}
+
+std::filesystem::path zzip::dictionary_version_path( std::filesystem::path const &dictionary,
+        uint32_t version )
+{
+    if( dictionary.empty() ) {
+        return {};
+    }
+    std::filesystem::path base = dictionary.stem();
+    if( dictionary_version( dictionary ) != 0 ) {
+        base = base.stem();
+    }
+    if( version != 0 ) {
+        base += "." + std::to_string( version );
+    }
+    base += dictionary.extension();
+    return dictionary.parent_path() / base;
+}
+
+void zzip::invalidate_dictionary_cache()
+{
+    cached_contexts_generation.fetch_add( 1, std::memory_order_acq_rel );
+}
+
 std::shared_ptr<zzip> zzip::load( std::filesystem::path const &path,
                                   std::filesystem::path const &dictionary_path )
 {
@@ -385,33 +691,9 @@ std::shared_ptr<zzip> zzip::load( std::filesystem::path const &path,
 
     zip = std::shared_ptr<zzip>( new zzip( path, std::move( file ), std::move( footer ) ) );
 
-    ZSTD_CCtx *cctx;
-    ZSTD_DCtx *dctx;
-    if( dictionary_path.empty() ) {
-        cctx = ZSTD_createCCtx();
-        dctx = ZSTD_createDCtx();
-    } else if( auto it = cached_contexts.find( dictionary_path.string() );
-               it != cached_contexts.end() ) {
-        cctx = it->second.cctx;
-        dctx = it->second.dctx;
-    } else {
-        cctx = ZSTD_createCCtx();
-        ZSTD_CCtx_setParameter( cctx, ZSTD_c_compressionLevel, 7 );
-        dctx = ZSTD_createDCtx();
-
-        std::vector<char> dictionary;
-        if( !dictionary_path.empty() ) {
-            std::shared_ptr<const mmap_file> dictionary_file = mmap_file::map_file( dictionary_path );
-            dictionary.resize( dictionary_file->len() );
-            memcpy( dictionary.data(), dictionary_file->base(), dictionary_file->len() );
-            ZSTD_CCtx_loadDictionary_byReference( cctx, dictionary.data(), dictionary.size() );
-            ZSTD_DCtx_loadDictionary_byReference( dctx, dictionary.data(), dictionary.size() );
-        }
-
-        cached_contexts.emplace( dictionary_path.string(), cached_zstd_context{ std::move( dictionary ), cctx, dctx } );
-    }
-
-    zip->ctx_ = std::make_unique<zzip::context>( cctx, dctx );
+    cached_zstd_context &cached = cached_context_for( dictionary_path );
+    zip->ctx_ = std::make_unique<zzip::context>( cached.cctx, cached.dctx, cached.dictionary_,
+                dictionary_path );
 
     if( needs_footer && !zip->rewrite_footer() ) {
         return nullptr;
@@ -422,6 +704,7 @@ std::shared_ptr<zzip> zzip::load( std::filesystem::path const &path,
 
 bool zzip::add_file( std::filesystem::path const &zzip_relative_path, std::string_view content )
 {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     size_t estimated_size = ZSTD_compressBound( content.length() );
 
     JsonObject footer_copy = copy_footer();
@@ -439,6 +722,7 @@ bool zzip::add_file( std::filesystem::path const &zzip_relative_path, std::strin
     if( !ensure_capacity_for(
             old_content_end +
             ZSTD_SKIPPABLEHEADERSIZE + relative_path_string.length() +
+            kEntryDictionaryFrameSize +
             kEntryChecksumFrameSize +
             estimated_size +
             kFixedSizeOverhead ) ) {
@@ -462,9 +746,115 @@ bool zzip::add_file( std::filesystem::path const &zzip_relative_path, std::strin
         return false;
     }
 
+    io_counters &c = counters();
+    c.entries_written += 1;
+    c.bytes_written += content.size();
+    c.compressed_bytes_written += final_size;
+    c.write_us += us_since( start );
     return true;
 }
 
+bool zzip::add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const
+                      &files )
+{
+    return add_files( files, {} );
+}
+
+bool zzip::add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const
+                      &files, std::unordered_set<std::filesystem::path, std_fs_path_hash> const &deleted )
+{
+    if( files.size() == 1 && deleted.empty() ) {
+        return add_file( files.front().first, files.front().second );
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<std::string> names;
+    names.reserve( files.size() );
+    std::unordered_map<std::string, size_t> last_index;
+    for( size_t i = 0; i < files.size(); ++i ) {
+        names.emplace_back( files[i].first.generic_u8string() );
+        last_index[names.back()] = i;
+    }
+    const auto is_replaced = [&]( size_t i ) {
+        return last_index.at( names[i] ) != i;
+    };
+
+    // Every entry is its own zstd frame, so they compress independently.  Each thread
+    // compresses with its own context for the dictionary of this zzip.
+    std::vector<std::string> frames( files.size() );
+    std::vector<size_t> frame_sizes( files.size(), 0 );
+    const std::filesystem::path &dictionary_path = ctx_->dictionary_path;
+    cata::get_thread_pool().parallel_for( 0, static_cast<int>( files.size() ), [&]( int i ) {
+        if( is_replaced( i ) ) {
+            return;
+        }
+        const std::string_view content = files[i].second;
+        ZSTD_CCtx *cctx = cached_context_for( dictionary_path ).cctx;
+        frames[i].resize( ZSTD_compressBound( content.size() ) );
+        frame_sizes[i] = ZSTD_compress2( cctx, frames[i].data(), frames[i].size(), content.data(),
+                                         content.size() );
+    } );
+
+    JsonObject footer_copy = copy_footer();
+    footer_copy.allow_omitted_members();
+    zzip_footer footer{ footer_copy };
+
+    std::optional<zzip_meta> meta_opt = footer.get_meta();
+    size_t content_end = 0;
+    if( meta_opt.has_value() ) {
+        content_end = meta_opt->content_end;
+    }
+
+    size_t needed = content_end + kFixedSizeOverhead;
+    for( size_t i = 0; i < files.size(); ++i ) {
+        if( is_replaced( i ) ) {
+            continue;
+        }
+        if( ZSTD_isError( frame_sizes[i] ) ) {
+            return false;
+        }
+        needed += ZSTD_SKIPPABLEHEADERSIZE + names[i].length() + kEntryDictionaryFrameSize +
+                  kEntryChecksumFrameSize + frame_sizes[i];
+    }
+    if( !ensure_capacity_for( needed ) ) {
+        return false;
+    }
+
+    std::vector<compressed_entry> new_entries;
+    for( size_t i = 0; i < files.size(); ++i ) {
+        if( is_replaced( i ) ) {
+            continue;
+        }
+        size_t entry_size = write_compressed_at( names[i],
+                            std::string_view( frames[i].data(), frame_sizes[i] ), content_end );
+        if( entry_size == 0 || ZSTD_isError( entry_size ) ) {
+            return false;
+        }
+        new_entries.emplace_back( zzip::compressed_entry{ std::move( names[i] ), content_end, entry_size } );
+        content_end += entry_size;
+    }
+
+    std::unordered_set<std::string> dropped;
+    for( const std::filesystem::path &path : deleted ) {
+        dropped.insert( path.generic_u8string() );
+    }
+    if( !update_footer( footer_copy, content_end, new_entries, false, dropped ) ) {
+        return false;
+    }
+
+    io_counters &c = counters();
+    c.entries_written += new_entries.size();
+    for( size_t i = 0; i < files.size(); ++i ) {
+        if( !is_replaced( i ) ) {
+            c.bytes_written += files[i].second.size();
+        }
+    }
+    for( const compressed_entry &entry : new_entries ) {
+        c.compressed_bytes_written += entry.len;
+    }
+    c.write_us += us_since( start );
+    return true;
+}
 
 bool zzip::copy_files( std::vector<std::filesystem::path> const &zzip_relative_paths,
                        std::shared_ptr<zzip> const &from )
@@ -546,41 +936,97 @@ std::vector<std::byte> zzip::get_file( std::filesystem::path const &zzip_relativ
     return buf;
 }
 
-size_t zzip::get_file_to( std::filesystem::path const &zzip_relative_path, std::byte *dest,
-                          size_t dest_len ) const
+// Finds the compressed frame of the given file and checks it against its checksum.
+// Returns { nullptr, 0 } if the file does not exist or is corrupt.
+std::pair<void *, size_t> zzip::find_frame( std::filesystem::path const &zzip_relative_path,
+        uint32_t *dictionary_version_out ) const
 {
     zzip_footer footer{ footer_ };
     std::optional<zzip_file_entry> fparams = footer.get_entry( zzip_relative_path );
     if( !fparams.has_value() ) {
-        return 0;
+        return { nullptr, 0 };
     }
     size_t file_len = fparams->len;
     void *file_base = file_base_plus( fparams->offset );
     if( file_len > file_capacity_at( fparams->offset ) ) {
-        return 0;
+        return { nullptr, 0 };
     }
 
     std::optional<uint64_t> checksum_opt;
+    std::optional<uint32_t> dictionary_version_opt;
     std::tie( file_base, file_len ) = read_and_skip_entry_metadata(
                                           file_base,
                                           file_len,
                                           nullptr,
-                                          &checksum_opt );
-    if( !checksum_opt.has_value() ) {
-        return 0;
+                                          &checksum_opt,
+                                          &dictionary_version_opt );
+    if( file_base == nullptr || !checksum_opt.has_value() ) {
+        return { nullptr, 0 };
     }
     uint64_t checksum = XXH64( file_base, file_len, kCheckumSeed );
     if( checksum != *checksum_opt ) {
+        return { nullptr, 0 };
+    }
+    if( dictionary_version_out ) {
+        *dictionary_version_out = dictionary_version_opt.value_or( 0 );
+    }
+    return { file_base, file_len };
+}
+
+std::unique_ptr<std::istream> zzip::get_file_stream( std::filesystem::path const
+        &zzip_relative_path ) const
+{
+    void *file_base = nullptr;
+    size_t file_len = 0;
+    uint32_t version = 0;
+    std::tie( file_base, file_len ) = find_frame( zzip_relative_path, &version );
+    if( file_base == nullptr ) {
+        return nullptr;
+    }
+    // Decompressed as it is read, so only the entry is counted.
+    counters().entries_read += 1;
+    if( version == ctx_->dictionary_version ) {
+        return std::make_unique<zstd_istream>( file_, file_base, file_len, ctx_->dictionary );
+    }
+    cached_zstd_context *older = context_for_version( ctx_->dictionary_path, version );
+    if( older == nullptr ) {
+        return nullptr;
+    }
+    return std::make_unique<zstd_istream>( file_, file_base, file_len, older->dictionary_ );
+}
+
+size_t zzip::get_file_to( std::filesystem::path const &zzip_relative_path, std::byte *dest,
+                          size_t dest_len ) const
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    void *file_base = nullptr;
+    size_t file_len = 0;
+    uint32_t version = 0;
+    std::tie( file_base, file_len ) = find_frame( zzip_relative_path, &version );
+    if( file_base == nullptr ) {
         return 0;
     }
     unsigned long long file_size = ZSTD_decompressBound( file_base, file_len );
     if( dest_len < file_size ) {
         return 0;
     }
-    size_t actual = ZSTD_decompressDCtx( ctx_->dctx, dest, dest_len, file_base, file_len );
+    ZSTD_DCtx *dctx = ctx_->dctx;
+    if( version != ctx_->dictionary_version ) {
+        // Written before the dictionary was last retrained.
+        cached_zstd_context *older = context_for_version( ctx_->dictionary_path, version );
+        if( older == nullptr ) {
+            return 0;
+        }
+        dctx = older->dctx;
+    }
+    size_t actual = ZSTD_decompressDCtx( dctx, dest, dest_len, file_base, file_len );
     if( ZSTD_isError( actual ) ) {
         return 0;
     }
+    io_counters &c = counters();
+    c.entries_read += 1;
+    c.bytes_read += actual;
+    c.read_us += us_since( start );
     return actual;
 }
 
@@ -594,6 +1040,44 @@ size_t zzip::get_zzip_size() const
     return file_->len();
 }
 
+size_t zzip::get_wasted_size() const
+{
+    zzip_meta meta = zzip_footer{ footer_ }.get_meta();
+    const size_t used = meta.content_end - std::min( meta.content_end, kFooterChecksumFrameSize );
+    return used - std::min( used, meta.total_content_size );
+}
+
+zzip::io_stats zzip::io_stats::since( const io_stats &before ) const
+{
+    io_stats result;
+    result.entries_written = entries_written - before.entries_written;
+    result.bytes_written = bytes_written - before.bytes_written;
+    result.compressed_bytes_written = compressed_bytes_written - before.compressed_bytes_written;
+    result.write_us = write_us - before.write_us;
+    result.entries_read = entries_read - before.entries_read;
+    result.bytes_read = bytes_read - before.bytes_read;
+    result.read_us = read_us - before.read_us;
+    result.compactions = compactions - before.compactions;
+    result.compacted_bytes = compacted_bytes - before.compacted_bytes;
+    return result;
+}
+
+zzip::io_stats zzip::get_io_stats()
+{
+    const io_counters &c = counters();
+    io_stats result;
+    result.entries_written = c.entries_written;
+    result.bytes_written = c.bytes_written;
+    result.compressed_bytes_written = c.compressed_bytes_written;
+    result.write_us = c.write_us;
+    result.entries_read = c.entries_read;
+    result.bytes_read = c.bytes_read;
+    result.read_us = c.read_us;
+    result.compactions = c.compactions;
+    result.compacted_bytes = c.compacted_bytes;
+    return result;
+}
+
 std::filesystem::path const &zzip::get_path() const
 {
     return path_;
@@ -662,8 +1146,9 @@ size_t zzip::write_file_at( std::string_view filename, std::string_view content,
 {
     // The format of a compressed entry is a series of zstd frames.
     // There are an unbounded number of leading skippable frames of unspecified content.
-    // At present, we write two skippable frames per entry:
+    // At present, we write these skippable frames per entry:
     //   - A frame for the filename of the entry.
+    //   - A frame for the version of the dictionary, unless it is unversioned.
     //   - A frame for a 64 bit XXH checksum of the entire compressed frame.
     //   - The actual compressed frame.
     // Returns the size of the entire file entry, or the return zstd error.
@@ -684,6 +1169,15 @@ size_t zzip::write_file_at( std::string_view filename, std::string_view content,
         return header_size;
     }
     offset += header_size;
+    if( ctx_->dictionary_version != 0 ) {
+        size_t version_size = write_entry_dictionary_version( file_base_plus( offset ),
+                              file_capacity_at( offset ), ctx_->dictionary_version );
+        if( ZSTD_isError( version_size ) ) {
+            return version_size;
+        }
+        header_size += version_size;
+        offset += version_size;
+    }
     // Make room for the checksum frame before the file.
     offset += kEntryChecksumFrameSize;
     size_t file_size = ZSTD_compress2(
@@ -696,30 +1190,64 @@ size_t zzip::write_file_at( std::string_view filename, std::string_view content,
     if( ZSTD_isError( file_size ) ) {
         return file_size;
     }
-    uint64_t checksum = XXH64( file_base_plus( offset ), file_size, kCheckumSeed );
-    uint64_t checksum_le = 0;
-    MEM_writeLE64( &checksum_le, checksum );
-    size_t checksum_size = ZSTD_writeSkippableFrame(
-                               file_base_plus( offset - kEntryChecksumFrameSize ),
-                               kEntryChecksumFrameSize,
-                               reinterpret_cast<const char *>( &checksum_le ),
-                               sizeof( checksum_le ),
-                               kEntryChecksumMagic
-                           );
+    size_t checksum_size = write_entry_checksum( file_base_plus( offset - kEntryChecksumFrameSize ),
+                           file_base_plus( offset ), file_size );
     if( ZSTD_isError( checksum_size ) || checksum_size != kEntryChecksumFrameSize ) {
         return checksum_size;
     }
     return header_size + checksum_size + file_size;
 }
 
+// Like write_file_at, for a frame that was already compressed.
+size_t zzip::write_compressed_at( std::string_view filename, std::string_view frame,
+                                  size_t offset )
+{
+    if( file_->len() <= offset ) {
+        return 0;
+    }
+
+    size_t header_size = ZSTD_writeSkippableFrame(
+                             file_base_plus( offset ),
+                             file_capacity_at( offset ),
+                             filename.data(),
+                             filename.length(),
+                             kEntryFileNameMagic
+                         );
+    if( ZSTD_isError( header_size ) ) {
+        return header_size;
+    }
+    offset += header_size;
+    if( ctx_->dictionary_version != 0 ) {
+        size_t version_size = write_entry_dictionary_version( file_base_plus( offset ),
+                              file_capacity_at( offset ), ctx_->dictionary_version );
+        if( ZSTD_isError( version_size ) ) {
+            return version_size;
+        }
+        header_size += version_size;
+        offset += version_size;
+    }
+    if( file_capacity_at( offset ) < kEntryChecksumFrameSize + frame.size() ) {
+        return static_cast<size_t>( -ZSTD_error_dstSize_tooSmall );
+    }
+    memcpy( file_base_plus( offset + kEntryChecksumFrameSize ), frame.data(), frame.size() );
+    size_t checksum_size = write_entry_checksum( file_base_plus( offset ), frame.data(),
+                           frame.size() );
+    if( ZSTD_isError( checksum_size ) || checksum_size != kEntryChecksumFrameSize ) {
+        return checksum_size;
+    }
+    return header_size + checksum_size + frame.size();
+}
+
 // Writes a new footer at the end of the zzip, copying old entries from the given
-// original JsonObject and inserting the given new entries.
+// original JsonObject but the dropped ones and inserting the given new entries.
 // If shrink_to_fit is true, will shrink the file as needed to eliminate padding bytes
 // between the content and the footer.
 bool zzip::update_footer( JsonObject const &original_footer, size_t content_end,
-                          const std::vector<compressed_entry> &entries, bool shrink_to_fit )
+                          const std::vector<compressed_entry> &entries, bool shrink_to_fit,
+                          const std::unordered_set<std::string> &dropped )
 {
-    std::unordered_set<std::string> processed_files;
+    // Old entries that are dropped are skipped just like the ones that are replaced.
+    std::unordered_set<std::string> processed_files = dropped;
     flexbuffers::Builder builder;
     size_t root_start = builder.StartMap();
     size_t total_content_size = 0;
@@ -1098,6 +1626,7 @@ bool zzip::compact( double bloat_factor )
         return lhs.offset < rhs.offset;
     } );
 
+    const size_t old_len = file_->len();
     std::filesystem::path tmp_path = path_;
     tmp_path.replace_extension( ".zzip.tmp" ); // NOLINT(cata-u8-path)
 
@@ -1144,9 +1673,40 @@ bool zzip::compact( double bloat_factor )
         return false;
     }
     reset_on_failure.cancel();
+    io_counters &c = counters();
+    c.compactions += 1;
+    c.compacted_bytes += old_len - std::min( old_len, file_->len() );
     return true;
 }
 
+size_t zzip::verify( size_t first_entry, size_t max_bytes,
+                     std::vector<std::filesystem::path> &corrupt_out ) const
+{
+    std::vector<compressed_entry> entries = zzip_footer{ footer_ }.get_entries();
+    size_t checked = 0;
+    for( size_t i = first_entry; i < entries.size(); ++i ) {
+        std::filesystem::path entry_path = std::filesystem::u8path( entries[i].path );
+        if( find_frame( entry_path ).first == nullptr ) {
+            corrupt_out.emplace_back( std::move( entry_path ) );
+        }
+        checked += entries[i].len;
+        if( checked >= max_bytes && i + 1 < entries.size() ) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+bool zzip::repair( std::vector<std::filesystem::path> const &corrupt )
+{
+    std::unordered_set<std::filesystem::path, std_fs_path_hash> paths( corrupt.begin(),
+            corrupt.end() );
+    if( !paths.empty() && !delete_files( paths ) ) {
+        return false;
+    }
+    return compact( 0 );
+}
+
 // Can't directly increment void*, have to cast to char* first.
 void *zzip::file_base_plus( size_t offset ) const
 {
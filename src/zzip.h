@@ -6,9 +6,11 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <iosfwd>
 #include <memory>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "flexbuffer_json.h"
@@ -64,12 +66,41 @@ class zzip
         static std::shared_ptr<zzip> load( std::filesystem::path const &path,
                                            std::filesystem::path const &dictionary = {} );
 
+        /**
+         * Dictionaries can be retrained without recompressing what was already written with
+         * them.  Each version sits next to the unversioned one, as `maps.dict`, `maps.1.dict`,
+         * `maps.2.dict` and so on.  Entries record the version they were written with and
+         * are read with that one, while new entries use the version the zzip was loaded with.
+         */
+        static uint32_t dictionary_version( std::filesystem::path const &dictionary );
+        static std::filesystem::path dictionary_version_path( std::filesystem::path const &dictionary,
+                uint32_t version );
+
+        /**
+         * Makes every thread read its dictionaries from disk again the next time they are used,
+         * for when dictionaries were deleted or replaced under the same paths.
+         */
+        static void invalidate_dictionary_cache();
+
         /**
          * Writes the given file contents under the given file path into the zzip.
          * Returns true on success, false on any error.
          */
         bool add_file( std::filesystem::path const &zzip_relative_path, std::string_view content );
 
+        /**
+         * Writes several files at once, compressing them in parallel on the thread pool and
+         * writing a single new footer.  If a path is given more than once, its last content
+         * is kept.  The deleted files are removed from that same footer, as delete_files
+         * would, unless they are written again.  Returns true on success, false on any error,
+         * in which case none of the files were added or removed.
+         */
+        bool add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const
+                        &files );
+        bool add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const
+                        &files, std::unordered_set<std::filesystem::path, std_fs_path_hash> const
+                        &deleted );
+
         /**
          * Directly copies a compressed entry from one zzip to another. Both zzips
          * must have been opened using the same dictionary. The relative path is
@@ -106,6 +137,31 @@ class zzip
          */
         size_t get_entry_size( std::filesystem::path const &zzip_relative_path ) const;
 
+        /**
+         * Returns how many bytes of content are taken by entries that were replaced or
+         * deleted since the zzip was last compacted.
+         */
+        size_t get_wasted_size() const;
+
+        /**
+         * What all zzips of the process wrote, read and compacted, summed since start.
+         * Take the difference of two to get the share of a single save or load.
+         */
+        struct io_stats {
+            uint64_t entries_written = 0;
+            uint64_t bytes_written = 0;
+            uint64_t compressed_bytes_written = 0;
+            uint64_t write_us = 0;
+            uint64_t entries_read = 0;
+            uint64_t bytes_read = 0;
+            uint64_t read_us = 0;
+            uint64_t compactions = 0;
+            uint64_t compacted_bytes = 0;
+
+            io_stats since( const io_stats &before ) const;
+        };
+        static io_stats get_io_stats();
+
         /**
          * Returns the path to this zzip.
          */
@@ -122,6 +178,15 @@ class zzip
          */
         std::vector<std::byte> get_file( std::filesystem::path const &zzip_relative_path ) const;
 
+        /**
+         * Returns a stream that decompresses the given file a chunk at a time as it is read,
+         * so large files never have to be held in memory whole.  Returns nullptr if the file
+         * does not exist or is corrupt.  The stream must not be used after the zzip is
+         * written to.
+         */
+        std::unique_ptr<std::istream> get_file_stream( std::filesystem::path const
+                &zzip_relative_path ) const;
+
         /**
          * Extracts the given file into the given destination.
          * Returns 0 if the file does not exist.
@@ -150,6 +215,23 @@ class zzip
          */
         bool compact( double bloat_factor = 1.0 );
 
+        /**
+         * Checks entries against their checksums, a few at a time so a large zzip can be
+         * verified in the background without a pass over the whole file. Starts at the given
+         * index into the entries and stops after about max_bytes of compressed data.
+         * The paths of corrupt entries are added to corrupt_out.
+         * Returns the index to carry on from, or 0 once the last entry was checked.
+         */
+        size_t verify( size_t first_entry, size_t max_bytes,
+                       std::vector<std::filesystem::path> &corrupt_out ) const;
+
+        /**
+         * Drops the given corrupt entries and compacts, so the zzip is once more an unbroken
+         * run of valid frames and a later scan by rewrite_footer finds everything after them.
+         * Returns true on success.
+         */
+        bool repair( std::vector<std::filesystem::path> const &corrupt );
+
         /**
          * Create a zzip from a folder of existing files.
          * The files in the zzip are indexed based on their relative path inside the folder.
@@ -176,11 +258,16 @@ class zzip
         struct compressed_entry;
     private:
         JsonObject copy_footer() const;
+        std::pair<void *, size_t> find_frame( std::filesystem::path const &zzip_relative_path,
+                                              uint32_t *dictionary_version_out = nullptr ) const;
         size_t ensure_capacity_for( size_t bytes );
         size_t write_file_at( std::string_view filename, std::string_view content, size_t offset );
+        size_t write_compressed_at( std::string_view filename, std::string_view frame,
+                                    size_t offset );
 
         bool update_footer( JsonObject const &original_footer, size_t content_end,
-                            const std::vector<compressed_entry> &entries, bool shrink_to_fit = false );
+                            const std::vector<compressed_entry> &entries, bool shrink_to_fit = false,
+                            const std::unordered_set<std::string> &dropped = {} );
 
         bool rewrite_footer();
 
@@ -0,0 +1,239 @@
+#include "zzip_maintenance.h"
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cata_path.h"
+#include "cata_scope_helpers.h"
+#include "debug.h"
+#include "map_memory.h"
+#include "mapbuffer.h"
+#include "path_info.h"
+#include "save_writer.h"
+#include "string_formatter.h"
+#include "translations.h"
+#include "worldfactory.h"
+#include "zzip.h"
+#include "zzip_stack.h"
+
+namespace
+{
+
+// Real time between two steps, so upkeep never keeps the disk busy for long.
+constexpr std::chrono::milliseconds kStepInterval( 2000 );
+// Compressed bytes checked against their checksums per zzip and step.
+constexpr size_t kVerifyBytesPerStep = 4 * 1024 * 1024;
+// A zzip is compacted once replaced entries take this share of its live content,
+constexpr double kWasteRatio = 0.25;
+// and at least this many bytes.  Less is not worth rewriting the file for.
+constexpr size_t kMinWaste = 256 * 1024;
+// Saving map memory compacts its stacks with 3.
+constexpr double kStackBloatFactor = 2.0;
+
+struct archive {
+    // A zzip, or the folder of a zzip_stack.
+    std::filesystem::path path;
+    bool is_stack = false;
+};
+
+struct maintenance_state {
+    std::string world;
+    // Archives left to visit in this round, the next one last.
+    std::vector<archive> round;
+    // Where verification of each zzip carries on from.
+    std::unordered_map<std::string, size_t> cursors;
+    // Set while a step is queued or running.
+    bool busy = false;
+    std::chrono::steady_clock::time_point last_step;
+    // What the steps found, logged by the main thread.
+    std::vector<std::string> to_log;
+};
+
+std::mutex state_mutex;
+maintenance_state state;
+
+std::vector<archive> find_archives()
+{
+    std::vector<archive> found;
+    const std::filesystem::path world = PATH_INFO::world_base_save_path().get_unrelative_path();
+    const std::filesystem::path zzip_extension = std::filesystem::u8path( ".zzip" );
+    for( const char *folder : {
+             "maps", "overmaps"
+         } ) {
+        std::error_code ec;
+        for( const std::filesystem::directory_entry &entry :
+             std::filesystem::directory_iterator( world / std::filesystem::u8path( folder ), ec ) ) {
+            if( entry.path().extension() == zzip_extension ) {
+                found.push_back( archive{ entry.path(), false } );
+            }
+        }
+    }
+    std::error_code ec;
+    const std::filesystem::path mm_dir = map_memory::save_dir().get_unrelative_path();
+    if( std::filesystem::is_directory( mm_dir, ec ) ) {
+        found.push_back( archive{ mm_dir, true } );
+    }
+    return found;
+}
+
+// Checks the next slice of the zzip and drops its corrupt entries.  Returns true once it
+// was checked through to its last entry.
+bool verify_slice( const std::filesystem::path &path, std::vector<std::string> &to_log )
+{
+    std::error_code ec;
+    if( !std::filesystem::exists( path, ec ) ) {
+        return true;
+    }
+    // Verifying and compacting never decompress, so no dictionary is needed.
+    std::shared_ptr<zzip> z = zzip::load( path );
+    if( !z ) {
+        return true;
+    }
+    const std::string key = path.generic_u8string();
+    size_t cursor = 0;
+    {
+        std::lock_guard<std::mutex> lk( state_mutex );
+        cursor = state.cursors[key];
+    }
+    std::vector<std::filesystem::path> corrupt;
+    const size_t next = z->verify( cursor, kVerifyBytesPerStep, corrupt );
+    if( !corrupt.empty() ) {
+        const bool repaired = z->repair( corrupt );
+        for( const std::filesystem::path &entry : corrupt ) {
+            to_log.emplace_back( string_format( "%s entry %s of %s", repaired ? "Dropped corrupt" :
+                                                "Failed to drop corrupt", entry.generic_u8string(), key ) );
+        }
+    }
+    std::lock_guard<std::mutex> lk( state_mutex );
+    if( next == 0 ) {
+        state.cursors.erase( key );
+    } else {
+        state.cursors[key] = next;
+    }
+    return next == 0;
+}
+
+// Runs on the save writer.  Returns true once the archive was verified through.
+bool maintain( const archive &a, std::vector<std::string> &to_log )
+{
+    if( !a.is_stack ) {
+        const bool verified = verify_slice( a.path, to_log );
+        std::error_code ec;
+        if( !std::filesystem::exists( a.path, ec ) ) {
+            return true;
+        }
+        std::shared_ptr<zzip> z = zzip::load( a.path );
+        const size_t wasted = z ? z->get_wasted_size() : 0;
+        if( wasted >= kMinWaste && wasted > z->get_content_size() * kWasteRatio ) {
+            z->compact( 0 );
+        }
+        return verified;
+    }
+    bool verified = true;
+    // The zzips of the stack are checked on their own first, as repairing one replaces it.
+    std::shared_ptr<zzip_stack> stack = zzip_stack::load( a.path );
+    if( !stack ) {
+        return true;
+    }
+    for( const std::filesystem::path &member : stack->get_zzip_paths() ) {
+        verified = verify_slice( member, to_log ) && verified;
+    }
+    // Reloaded to see the repaired zzips.
+    stack = zzip_stack::load( a.path );
+    if( stack && stack->get_wasted_size() >= kMinWaste ) {
+        stack->compact( kStackBloatFactor );
+    }
+    return verified;
+}
+
+} // namespace
+
+void zzip_maintenance::step_if_idle()
+{
+    std::vector<std::string> found;
+    archive next;
+    {
+        std::lock_guard<std::mutex> lk( state_mutex );
+        found.swap( state.to_log );
+    }
+    for( const std::string &msg : found ) {
+        DebugLog( D_WARNING, DC_ALL ) << msg;
+    }
+    if( world_generator->active_world == nullptr ||
+        !world_generator->active_world->has_compression_enabled() ) {
+        return;
+    }
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lk( state_mutex );
+        if( state.busy || now - state.last_step < kStepInterval ) {
+            return;
+        }
+    }
+    if( !get_save_writer().is_idle() ) {
+        return;
+    }
+    const std::string world = PATH_INFO::world_base_save_path().generic_u8string();
+    bool new_round = false;
+    {
+        std::lock_guard<std::mutex> lk( state_mutex );
+        if( state.world != world ) {
+            state.world = world;
+            state.round.clear();
+            state.cursors.clear();
+        }
+        new_round = state.round.empty();
+    }
+    // Only the main thread starts rounds, so the scan can go without the lock.
+    std::vector<archive> archives = new_round ? find_archives() : std::vector<archive>();
+    {
+        std::lock_guard<std::mutex> lk( state_mutex );
+        if( new_round ) {
+            state.round = std::move( archives );
+        }
+        if( state.round.empty() ) {
+            state.last_step = now;
+            return;
+        }
+        next = std::move( state.round.back() );
+        state.round.pop_back();
+        state.busy = true;
+    }
+    if( !next.is_stack ) {
+        // Repairing and compacting replace the zzip, which reads ahead may still have mapped.
+        std::filesystem::path segment = next.path;
+        segment.replace_extension();
+        MAPBUFFER.drop_prefetched( segment.generic_u8string() );
+    }
+    get_save_writer().enqueue( next.path.generic_u8string(), _( "save maintenance" ),
+    [next, world]() {
+        std::vector<std::string> to_log;
+        bool verified = true;
+        on_out_of_scope done( [&]() {
+            std::lock_guard<std::mutex> lk( state_mutex );
+            state.busy = false;
+            state.last_step = std::chrono::steady_clock::now();
+            state.to_log.insert( state.to_log.end(), to_log.begin(), to_log.end() );
+            // Come back to it next step until all of it was checked.
+            if( !verified && state.world == world ) {
+                state.round.push_back( next );
+            }
+        } );
+        try {
+            verified = maintain( next, to_log );
+        } catch( const std::exception &err ) {
+            // Upkeep is retried next round, and must not fail the next save.
+            to_log.emplace_back( string_format( "Maintenance of %s failed: %s",
+                                                next.path.generic_u8string(), err.what() ) );
+        }
+    } );
+}
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef CATA_SRC_ZZIP_MAINTENANCE_H
+#define CATA_SRC_ZZIP_MAINTENANCE_H
+
+/**
+ * Background upkeep of the zzips and zzip_stacks of the active world.  While the save writer
+ * has nothing else to do, the archives take turns to have a slice of their entries checked
+ * against their checksums, with corrupt entries dropped so the frames after them stay
+ * recoverable, and to be compacted once what their replaced entries waste passes a threshold.
+ * Saving still compacts archives that grew far past that, but most of them are kept small
+ * here instead of in the middle of a save.
+ *
+ * Each step runs on the save writer with the archive as its target, so it never overlaps a
+ * write to that archive and anything reading it waits for it like for any write.  Quads read
+ * ahead from a map zzip are dropped before its step is queued.
+ */
+namespace zzip_maintenance
+{
+
+// Queue the next step if the save writer is idle and the last step was a while ago.
+void step_if_idle();
+
+} // namespace zzip_maintenance
+
+#endif // CATA_SRC_ZZIP_MAINTENANCE_H
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <array>
+#include <filesystem>
 #include <memory>
+#include <string_view>
 #include <system_error>
 #include <unordered_map>
 #include <unordered_set>
@@ -44,6 +46,18 @@ bool zzip_stack::add_file( std::filesystem::path const &zzip_relative_path,
     return ret;
 }
 
+bool zzip_stack::add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const
+                            &files )
+{
+    bool ret = hot()->add_files( files );
+    if( ret ) {
+        for( const std::pair<std::filesystem::path, std::string_view> &file : files ) {
+            path_temp_map_[file.first] = file_temp::hot;
+        }
+    }
+    return ret;
+}
+
 bool zzip_stack::has_file( std::filesystem::path const &zzip_relative_path ) const
 {
     return temp_of_file( zzip_relative_path ) != file_temp::unknown;
@@ -228,6 +242,36 @@ bool zzip_stack::compact( double bloat_factor )
     return cold_->compact( std::max( bloat_factor / 2.0, 1.0 ) );
 }
 
+size_t zzip_stack::get_wasted_size() const
+{
+    cold();
+    warm();
+    hot();
+    size_t live_size = 0;
+    for( const auto& [file, temp] : path_temp_map_ ) {
+        live_size += zzip_of_temp( temp )->get_entry_size( file );
+    }
+    const size_t used_size = cold_->get_content_size() + warm_->get_content_size() +
+                             hot_->get_content_size();
+    return used_size - std::min( used_size, live_size );
+}
+
+std::vector<std::filesystem::path> zzip_stack::get_zzip_paths() const
+{
+    std::vector<std::filesystem::path> paths;
+    for( std::string_view suffix : {
+             kColdSuffix, kWarmSuffix, kHotSuffix
+         } ) {
+        std::filesystem::path zzip_path = path_.filename();
+        zzip_path += suffix; // NOLINT(cata-u8-path)
+        std::error_code ec;
+        if( std::filesystem::exists( path_ / zzip_path, ec ) ) {
+            paths.emplace_back( path_ / zzip_path );
+        }
+    }
+    return paths;
+}
+
 std::shared_ptr<zzip> &zzip_stack::cold() const
 {
     if( !cold_ ) {
@@ -10,6 +10,7 @@
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "std_hash_fs_path.h"
@@ -48,6 +49,13 @@ class zzip_stack
          */
         bool add_file( std::filesystem::path const &zzip_relative_path, std::string_view content );
 
+        /**
+         * Writes several files at once, see zzip::add_files.
+         * Returns true on success, false on any error.
+         */
+        bool add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const
+                        &files );
+
         /**
          * Returns true if the zzip contains the given path. Paths are checked through exact string
          * matches. Normalizing paths, and using generic u8 paths, is recommended.
@@ -94,6 +102,17 @@ class zzip_stack
          */
         bool compact( double bloat_factor = 1.0 );
 
+        /**
+         * Returns roughly how many bytes the zzips of the stack hold beyond the live version
+         * of every file, whether replaced in place or shadowed by a newer copy higher up.
+         */
+        size_t get_wasted_size() const;
+
+        /**
+         * Returns the paths of the zzips that make up the stack and exist on disk.
+         */
+        std::vector<std::filesystem::path> get_zzip_paths() const;
+
         /**
          * Create a zzip_stack from a folder of existing files.
          * The files in the zzip are indexed based on their relative path inside the folder.
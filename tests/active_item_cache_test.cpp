@@ -1,5 +1,8 @@
+#include <optional>
 #include <set>
+#include <utility>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "cata_catch.h"
 #include "coordinates.h"
@@ -44,3 +47,22 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_item_cache_tracks_items_once", "[item]" )
+{
+    active_item_cache cache;
+    item kept( itype_firecracker_act, calendar::turn_zero, item::default_charges_tag() );
+    kept.activate();
+    std::optional<item> gone( std::in_place, itype_firecracker_act, calendar::turn_zero,
+                              item::default_charges_tag() );
+    gone->activate();
+    REQUIRE( cache.add( kept, point_sm_ms( 1, 1 ) ) );
+    REQUIRE( cache.add( *gone, point_sm_ms( 2, 2 ) ) );
+
+    // Dropping the reference to the destroyed item also drops the index of the cache.
+    gone.reset();
+    REQUIRE( cache.get().size() == 1 );
+
+    cache.add( kept, point_sm_ms( 1, 1 ) );
+    CHECK( cache.get().size() == 1 );
+}
@@ -0,0 +1,41 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "cata_catch.h"
+#include "compression_dictionary.h"
+
+// Small documents sharing most of their structure, like submap quads do.
+static std::vector<std::string> make_samples( int first, int count )
+{
+    std::vector<std::string> samples;
+    for( int i = first; i < first + count; ++i ) {
+        samples.emplace_back( "{\"version\":36,\"coordinates\":[" + std::to_string( i ) + "," +
+                              std::to_string( i * 3 ) + ",0],\"turn_last_touched\":" +
+                              std::to_string( i * 7919 ) + ",\"temperature\":0,\"terrain\":[[\"t_grass\"," +
+                              std::to_string( 100 + i % 44 ) + "],[\"t_dirt\",5],[\"t_tree_young\"," +
+                              std::to_string( 1 + i % 5 ) + "]],\"radiation\":[0,144],\"furniture\":[],"
+                              "\"items\":[],\"traps\":[],\"fields\":[],\"cosmetics\":[],\"spawns\":[],"
+                              "\"vehicles\":[],\"partial_constructions\":[]}" );
+    }
+    return samples;
+}
+
+TEST_CASE( "trained_dictionary_compresses_similar_data_better", "[zzip][nogame]" )
+{
+    const std::vector<std::string> training = make_samples( 0, 200 );
+    const std::vector<std::string> held_out = make_samples( 1000, 50 );
+
+    const std::string dictionary = compression_dictionary::train( training, 4096 );
+    CHECK_FALSE( dictionary.empty() );
+    CHECK( dictionary.size() <= 4096 );
+    CHECK( compression_dictionary::compressed_size( held_out, dictionary ) <
+           compression_dictionary::compressed_size( held_out, "" ) * 0.7 );
+}
+
+TEST_CASE( "training_on_too_little_data_keeps_it_whole", "[zzip][nogame]" )
+{
+    const std::vector<std::string> samples = { "abc", "def" };
+    CHECK( compression_dictionary::train( samples, 4096 ) == "abcdef" );
+    CHECK( compression_dictionary::train( samples, 2 ) == "ab" );
+}
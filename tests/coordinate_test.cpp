@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <functional>
 #include <string>
 #include <tuple>
@@ -496,6 +497,27 @@ TEST_CASE( "coordinate_conversion_consistency", "[point][coords][nogame]" )
     }
 }
 
+static_assert( divide_round_to_minus_infinity<2>( -1 ) == -1 );
+static_assert( divide_round_to_minus_infinity<2>( -2 ) == -1 );
+static_assert( divide_round_to_minus_infinity<SEEX>( -1 ) == -1 );
+static_assert( divide_round_to_minus_infinity<SEEX>( SEEX ) == 1 );
+
+TEST_CASE( "compile_time_divisor_matches_runtime_divisor", "[point][coords][nogame]" )
+{
+    point p = GENERATE( take( num_trials, random_points() ) );
+    CAPTURE( p );
+    CHECK( divide_xy_round_to_minus_infinity<2>( p ) == divide_xy_round_to_minus_infinity( p, 2 ) );
+    CHECK( divide_xy_round_to_minus_infinity<SEEX>( p ) ==
+           divide_xy_round_to_minus_infinity( p, SEEX ) );
+    CHECK( divide_xy_round_to_minus_infinity<OMAPX>( p ) ==
+           divide_xy_round_to_minus_infinity( p, OMAPX ) );
+    const point non_negative( std::abs( p.x ), std::abs( p.y ) );
+    CHECK( divide_xy_round_to_minus_infinity_non_negative<2>( non_negative ) ==
+           divide_xy_round_to_minus_infinity( non_negative, 2 ) );
+    CHECK( divide_xy_round_to_minus_infinity_non_negative<SEEX>( non_negative ) ==
+           divide_xy_round_to_minus_infinity( non_negative, SEEX ) );
+}
+
 TEST_CASE( "combine_is_opposite_of_remain", "[point][coords][nogame]" )
 {
     SECTION( "point_point" ) {
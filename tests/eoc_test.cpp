@@ -10,6 +10,7 @@
 #include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "cata_scope_helpers.h"
 #include "character.h"
 #include "character_attire.h"
 #include "character_id.h"
@@ -22,11 +23,14 @@
 #include "dialogue.h"
 #include "dialogue_helpers.h"
 #include "effect_on_condition.h"
+#include "event.h"
 #include "field_type.h"
+#include "flexbuffer_json.h"
 #include "game.h"
 #include "global_vars.h"
 #include "item.h"
 #include "item_location.h"
+#include "json_loader.h"
 #include "line.h"
 #include "magic.h"
 #include "make_static.h"
@@ -38,6 +42,7 @@
 #include "math_parser_diag_value.h"
 #include "memory_fast.h"
 #include "messages.h"
+#include "mod_tracker.h"
 #include "monster.h"
 #include "npc.h"
 #include "overmapbuffer.h"
@@ -255,6 +260,32 @@ TEST_CASE( "EOC_teleport", "[eoc]" )
     CHECK( before + tripoint::south_east == after );
 }
 
+TEST_CASE( "EOC_profile_counts_activations_and_conditions", "[eoc]" )
+{
+    clear_avatar();
+    get_globals().clear_global_values();
+    dialogue d( get_talker_for( get_avatar() ), std::make_unique<talker>() );
+    effect_on_conditions::reset_profile();
+    effect_on_conditions::profiling() = true;
+    effect_on_condition_EOC_math_test_greater_increment->activate( d );
+    effect_on_condition_EOC_math_test_greater_increment->activate( d );
+    effect_on_conditions::profiling() = false;
+    // Not timed any more.
+    effect_on_condition_EOC_math_test_greater_increment->activate( d );
+
+    std::optional<effect_on_conditions::eoc_profile> timed;
+    for( const auto &[id, profile] : effect_on_conditions::get_profile() ) {
+        if( id == effect_on_condition_EOC_math_test_greater_increment ) {
+            timed = profile;
+        }
+    }
+    REQUIRE( timed );
+    CHECK( timed->activations == 2 );
+    CHECK( timed->condition_checks == 2 );
+    CHECK( timed->time >= timed->condition_time );
+    effect_on_conditions::reset_profile();
+}
+
 TEST_CASE( "EOC_beta_elevate", "[eoc]" )
 {
     clear_avatar();
@@ -1549,3 +1580,36 @@ TEST_CASE( "EOC_run_eocs", "[eoc]" )
     CHECK( effect_on_condition_run_eocs_talker_mixes_loc->activate( d2 ) );
     CHECK( globvars.get_global_value( "alpha_name" ) == zombie->get_name() );
 }
+
+TEST_CASE( "EOC_loads_several_required_events", "[eoc]" )
+{
+    JsonValue jv = json_loader::from_string( R"({
+        "id": "EOC_test_several_events",
+        "eoc_type": "EVENT",
+        "required_event": [ "avatar_moves", "character_kills_monster" ]
+    })" );
+    effect_on_condition eoc;
+    eoc.load( jv.get_object(), "" );
+    CHECK( eoc.required_events == std::vector<event_type> {
+        event_type::avatar_moves, event_type::character_kills_monster
+    } );
+}
+
+TEST_CASE( "EOC_inline_reloaded_replaces_the_old_one", "[eoc]" )
+{
+    const auto load = []( const std::string & json ) {
+        return effect_on_conditions::load_inline_eoc( json_loader::from_string( json ), "dda" );
+    };
+    const effect_on_condition_id id = load( R"({ "id": "EOC_test_reloaded_inline", "effect": [] })" );
+    CHECK_FALSE( id->has_false_effect );
+    const std::string changed =
+        R"({ "id": "EOC_test_reloaded_inline", "effect": [], "false_effect": [] })";
+    CHECK_THROWS_AS( load( changed ), mod_error );
+
+    effect_on_conditions::reloading_inline_eocs() = true;
+    on_out_of_scope stop_reloading( []() {
+        effect_on_conditions::reloading_inline_eocs() = false;
+    } );
+    CHECK( load( changed ) == id );
+    CHECK( id->has_false_effect );
+}
@@ -132,6 +132,41 @@ TEST_CASE( "generic_factory_common_null_ids", "[generic_factory]" )
     CHECK( field_type_str_id::NULL_ID().is_valid() );
 }
 
+TEST_CASE( "generic_factory_find", "[generic_factory]" )
+{
+    generic_factory<test_obj> test_factory( "test_factory" );
+    test_factory.insert( { test_obj_id_0, "value_0" } );
+    test_factory.insert( { test_obj_id_1, "value_1" } );
+
+    const test_obj *found = test_factory.find( test_obj_id_1 );
+    REQUIRE( found != nullptr );
+    CHECK( found->value == "value_1" );
+    CHECK( found == &test_factory.obj( test_obj_id_1 ) );
+    CHECK( test_factory.find( test_obj_non_existent_id ) == nullptr );
+
+    test_factory.reset();
+    CHECK( test_factory.find( test_obj_id_1 ) == nullptr );
+}
+
+TEST_CASE( "itype_and_mtype_int_ids", "[generic_factory][int_id]" )
+{
+    const itype_id rock( "rock" );
+    const itype_int_id rock_int = rock.id();
+    REQUIRE( rock_int.is_valid() );
+    CHECK( rock_int.id() == rock );
+    CHECK( &rock_int.obj() == &rock.obj() );
+    CHECK( itype_int_id( rock ) == rock_int );
+    CHECK_FALSE( itype_id( "non_existent_item" ).id().is_valid() );
+
+    const mtype_id zombie( "mon_zombie" );
+    const mtype_int_id zombie_int = zombie.id();
+    REQUIRE( zombie_int.is_valid() );
+    CHECK( zombie_int.id() == zombie );
+    CHECK( &zombie_int.obj() == &zombie.obj() );
+    CHECK( mtype_int_id( zombie ) == zombie_int );
+    CHECK( mtype_id::NULL_ID().id() == mtype_int_id() );
+}
+
 TEST_CASE( "generic_factory_version_wrapper", "[generic_factory]" )
 {
     generic_factory<test_obj> test_factory( "test_factory" );
@@ -1,10 +1,12 @@
 #include <algorithm>
 #include <list>
+#include <map>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "cata_catch.h"
 #include "cata_utility.h"
 #include "enums.h"
@@ -269,3 +271,32 @@ TEST_CASE( "Event-based_item_spawns_do_not_spawn_outside_event", "[item_group]"
         CHECK( items[0].typeId() == test_rock );
     }
 }
+
+TEST_CASE( "distribution_rolls_entries_by_their_weight", "[item_group]" )
+{
+    Item_group group( Item_group::G_DISTRIBUTION, 100, 0, 0, "distribution test" );
+    group.add_item_entry( itype_rock, 1 );
+    group.add_item_entry( itype_test_rock, 3 );
+    group.add_item_entry( itype_match, 4 );
+
+    const Item_spawn_data &spawn = group;
+    std::map<itype_id, int> rolled;
+    const int rolls = 8000;
+    for( int i = 0; i < rolls; i++ ) {
+        rolled[spawn.create_single( calendar::turn_zero ).typeId()]++;
+    }
+    CHECK( rolled.size() == 3 );
+    // Several standard deviations wide.
+    CHECK( rolled[itype_rock] == Approx( rolls / 8 ).margin( 150 ) );
+    CHECK( rolled[itype_test_rock] == Approx( rolls * 3 / 8 ).margin( 220 ) );
+    CHECK( rolled[itype_match] == Approx( rolls / 2 ).margin( 230 ) );
+
+    // Entries removed after rolling are never rolled again.
+    group.remove_item( itype_match );
+    rolled.clear();
+    for( int i = 0; i < rolls; i++ ) {
+        rolled[spawn.create_single( calendar::turn_zero ).typeId()]++;
+    }
+    CHECK( rolled.size() == 2 );
+    CHECK( rolled[itype_rock] == Approx( rolls / 4 ).margin( 200 ) );
+}
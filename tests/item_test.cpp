@@ -1098,3 +1098,22 @@ TEST_CASE( "item_rotten_contents", "[item]" )
     //   butter
     CHECK( wrapper.get_category_of_contents().id == item_category_food );
 }
+
+TEST_CASE( "item_stacks_with_and_weight_benchmark", "[.][item][benchmark]" )
+{
+    // Both recurse into the contents, so fill a container with a few different items.
+    item pack( itype_backpack );
+    for( int i = 0; i < 10; ++i ) {
+        REQUIRE( pack.put_in( item( itype_aspirin ), pocket_type::CONTAINER ).success() );
+        REQUIRE( pack.put_in( item( itype_bottle_plastic_small ), pocket_type::CONTAINER ).success() );
+    }
+    const item other = pack;
+    REQUIRE( pack.stacks_with( other ) );
+
+    BENCHMARK( "stacks_with of filled containers" ) {
+        return pack.stacks_with( other );
+    };
+    BENCHMARK( "weight of a filled container" ) {
+        return pack.weight();
+    };
+}
@@ -1,9 +1,12 @@
 #include <algorithm>
 #include <array>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iterator>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <sstream>
@@ -20,11 +23,13 @@
 #include "damage.h"
 #include "debug.h"
 #include "enum_bitset.h"
+#include "flexbuffer_cache.h"
 #include "item.h"
 #include "json.h"
 #include "json_loader.h"
 #include "magic.h"
 #include "mutation.h"
+#include "path_info.h"
 #include "sounds.h"
 #include "string_formatter.h"
 #include "translations.h"
@@ -851,6 +856,67 @@ TEST_CASE( "jsonin_get_string", "[json]" )
     // NOLINTEND(cata-text-style)
 }
 
+TEST_CASE( "text_jsonin_reads_strings_longer_than_a_block", "[json][nogame]" )
+{
+    // NOLINTBEGIN(cata-text-style)
+    const std::string plain( 200, 'x' );
+    std::istringstream is( "[ \"" + plain + "\\n" + plain + "\u2026\\u2026\", \"" + plain +
+                           "\", 1 ]" );
+    // NOLINTEND(cata-text-style)
+    TextJsonIn jsin( is );
+    jsin.start_array();
+    CHECK( jsin.get_string() == plain + "\n" + plain + "\u2026\u2026" );
+    jsin.skip_string();
+    CHECK( jsin.get_int() == 1 );
+    CHECK( jsin.end_array() );
+}
+
+TEST_CASE( "json_object_finds_members_of_large_objects", "[json][nogame]" )
+{
+    constexpr int num_members = 100;
+    std::string json = "{";
+    for( int i = 0; i < num_members; ++i ) {
+        json += string_format( "%s\"member_%d\": %d", i == 0 ? "" : ", ", i, i );
+    }
+    json += "}";
+    JsonObject jo = json_loader::from_string( json );
+    REQUIRE( jo.size() == num_members );
+    for( int i = 0; i < num_members; ++i ) {
+        CHECK( jo.get_int( string_format( "member_%d", i ) ) == i );
+    }
+    CHECK_FALSE( jo.has_member( "member_" ) );
+    CHECK_FALSE( jo.has_member( "member_100" ) );
+    CHECK_FALSE( jo.has_member( "" ) );
+    CHECK( jo.get_int( "missing", -1 ) == -1 );
+}
+
+TEST_CASE( "json_object_records_member_stats", "[json][nogame]" )
+{
+    JsonObject::reset_member_stats();
+    const bool was_recording = JsonObject::globally_record_member_stats( true );
+    {
+        JsonObject jo = json_loader::from_string( R"({ "a": 1, "b": 2 })" );
+        JsonObject::member_stats_scope scope( "test_type" );
+        CHECK( jo.get_int( "a" ) == 1 );
+        CHECK( jo.get_int( "a", 0 ) == 1 );
+        CHECK( jo.get_int( "c", 3 ) == 3 );
+        jo.allow_omitted_members();
+    }
+    JsonObject::globally_record_member_stats( was_recording );
+    std::map<std::string, json_member_stat> by_member;
+    for( const json_member_stat &stat : JsonObject::member_stats() ) {
+        if( stat.type == "test_type" ) {
+            by_member.emplace( stat.member, stat );
+        }
+    }
+    JsonObject::reset_member_stats();
+    REQUIRE( by_member.size() == 2 );
+    CHECK( by_member["a"].lookups == 2 );
+    CHECK( by_member["a"].failed == 0 );
+    CHECK( by_member["c"].lookups == 1 );
+    CHECK( by_member["c"].failed == 1 );
+}
+
 TEST_CASE( "item_colony_ser_deser", "[json][item]" )
 {
     // calculates the number of substring (needle) occurrences withing the target string (haystack)
@@ -1005,3 +1071,156 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+TEST_CASE( "json_read_back_from_binary_form", "[json]" )
+{
+    const std::string json =
+        R"([{"version":1,"coordinates":[4,-2,0],"terrain":[["t_dirt",144]],"names":["a","b"]}])";
+    JsonValue jsin = json_loader::from_flexbuffer( flexbuffer_cache::json_to_binary( json ) );
+    JsonArray ja = jsin;
+    REQUIRE( ja.size() == 1 );
+    JsonObject jo = ja.next_object();
+    CHECK( jo.get_int( "version" ) == 1 );
+    std::vector<int> coords;
+    jo.read( "coordinates", coords );
+    CHECK( coords == std::vector<int> { 4, -2, 0 } );
+    std::vector<std::string> names;
+    jo.read( "names", names );
+    CHECK( names == std::vector<std::string> { "a", "b" } );
+    jo.allow_omitted_members();
+
+    CHECK_THROWS_AS( flexbuffer_cache::json_to_binary( "[1," ), JsonError );
+}
+
+TEST_CASE( "json_binary_form_rejects_corrupt_buffers", "[json]" )
+{
+    const std::vector<uint8_t> buffer = flexbuffer_cache::json_to_binary(
+                                            R"({"terrain":[["t_dirt",144]],"names":["a","b"]})" );
+    REQUIRE( buffer.size() < 0xff );
+    CHECK_NOTHROW( json_loader::from_flexbuffer( buffer ) );
+    CHECK_THROWS_AS( json_loader::from_flexbuffer( {} ), JsonError );
+
+    // The buffer ends with the root offset, the root type and the width of the offset.
+    std::vector<uint8_t> bad_width = buffer;
+    bad_width.back() = 3;
+    CHECK_THROWS_AS( json_loader::from_flexbuffer( bad_width ), JsonError );
+    std::vector<uint8_t> bad_offset = buffer;
+    bad_offset[bad_offset.size() - 3] = 0xff;
+    CHECK_THROWS_AS( json_loader::from_flexbuffer( bad_offset ), JsonError );
+    std::vector<uint8_t> truncated( buffer.begin() + 8, buffer.end() );
+    CHECK_THROWS_AS( json_loader::from_flexbuffer( truncated ), JsonError );
+}
+
+TEST_CASE( "json_parse_benchmark", "[.][json][benchmark][nogame]" )
+{
+    std::string json = "[";
+    for( int i = 0; i < 1000; ++i ) {
+        json += string_format( R"(%s{ "id": "thing_%d", "weight": %d, "flags": [ "A", "B" ] })",
+                               i == 0 ? "" : ", ", i, i );
+    }
+    json += "]";
+
+    BENCHMARK( "TextJsonIn skipping every member" ) {
+        std::istringstream is( json );
+        TextJsonIn jsin( is );
+        int members = 0;
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_object();
+            while( !jsin.end_object() ) {
+                jsin.get_member_name();
+                jsin.skip_value();
+                ++members;
+            }
+        }
+        return members;
+    };
+    BENCHMARK( "json_loader::from_string reading every object" ) {
+        int weight = 0;
+        for( JsonObject jo : json_loader::from_string( json ).get_array() ) {
+            jo.allow_omitted_members();
+            weight += jo.get_int( "weight" );
+        }
+        return weight;
+    };
+}
+
+TEST_CASE( "flexbuffer_cache_uses_files_cached_by_other_instances", "[json]" )
+{
+    const std::filesystem::path root = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "flexbuffer_shared_cache_test";
+    std::filesystem::remove_all( root );
+    std::filesystem::create_directories( root / "data" );
+    const std::filesystem::path path = root / "data" / "a.json";
+    std::ofstream( path ) << R"({"id":1})";
+    // Both started before anything was cached.
+    flexbuffer_cache first( root / "cache", root );
+    flexbuffer_cache second( root / "cache", root );
+    first.parse_and_cache( path );
+
+    // Swap what the first one cached for something else, to tell where the second one read from.
+    std::vector<std::filesystem::path> cached;
+    for( const std::filesystem::directory_entry &entry :
+         std::filesystem::recursive_directory_iterator( root / "cache" ) ) {
+        if( entry.path().extension() == ".fb" ) {
+            cached.push_back( entry.path() );
+        }
+    }
+    REQUIRE( cached.size() == 1 );
+    const std::vector<uint8_t> other = flexbuffer_cache::json_to_binary( R"({"id":2})" );
+    std::filesystem::remove( cached[0] );
+    std::ofstream( cached[0], std::ofstream::binary ).write(
+        reinterpret_cast<const char *>( other.data() ), other.size() );
+
+    {
+        std::shared_ptr<parsed_flexbuffer> buffer = second.parse_and_cache( path );
+        JsonValue jsin( buffer, flexbuffer_root_from_storage( buffer->get_storage() ), nullptr, 0 );
+        JsonObject jo = jsin;
+        CHECK( jo.get_int( "id" ) == 2 );
+    }
+    std::filesystem::remove_all( root );
+}
+
+TEST_CASE( "flexbuffer_pack_is_used_only_for_the_files_it_was_written_for", "[json]" )
+{
+    const std::filesystem::path root = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "flexbuffer_pack_test";
+    std::filesystem::remove_all( root );
+    std::filesystem::create_directories( root / "data" );
+    std::vector<std::filesystem::path> paths;
+    for( int i = 0; i < 3; ++i ) {
+        paths.push_back( root / "data" / std::filesystem::u8path( std::to_string( i ) + ".json" ) );
+        std::ofstream( paths.back() ) << R"([{"id":)" << i << R"(,"name":"x"}])";
+    }
+    {
+        flexbuffer_cache cache( root / "cache", root );
+        std::vector<std::shared_ptr<parsed_flexbuffer>> buffers;
+        for( const std::filesystem::path &path : paths ) {
+            buffers.push_back( cache.parse_and_cache( path ) );
+        }
+        CHECK_FALSE( cache.load_pack( paths ) );
+        REQUIRE( cache.save_pack( paths, buffers ) );
+    }
+
+    flexbuffer_cache cache( root / "cache", root );
+    std::optional<std::vector<std::shared_ptr<parsed_flexbuffer>>> packed = cache.load_pack( paths );
+    REQUIRE( packed );
+    REQUIRE( packed->size() == paths.size() );
+    for( size_t i = 0; i < paths.size(); ++i ) {
+        std::shared_ptr<parsed_flexbuffer> &buffer = ( *packed )[i];
+        CHECK( buffer->get_source_path() == paths[i] );
+        JsonValue jsin( buffer, flexbuffer_root_from_storage( buffer->get_storage() ), nullptr, 0 );
+        JsonArray ja = jsin;
+        JsonObject jo = ja.next_object();
+        CHECK( jo.get_int( "id" ) == static_cast<int>( i ) );
+        jo.allow_omitted_members();
+    }
+
+    // Another set of files, or a file that changed, has no pack.
+    CHECK_FALSE( cache.load_pack( { paths[0], paths[1] } ) );
+    std::ofstream( paths[2] ) << R"([{"id":2,"name":"changed"}])";
+    CHECK_FALSE( cache.load_pack( paths ) );
+
+    packed.reset();
+    std::filesystem::remove_all( root );
+}
@@ -50,11 +50,7 @@ void clear_radiation()
     map &here = get_map();
     const int mapsize = here.getmapsize() * SEEX;
     for( int z = -1; z <= OVERMAP_HEIGHT; ++z ) {
-        for( int x = 0; x < mapsize; ++x ) {
-            for( int y = 0; y < mapsize; ++y ) {
-                here.set_radiation( tripoint_bub_ms{ x, y, z}, 0 );
-            }
-        }
+        here.set_radiation_square( point_bub_ms::zero, point_bub_ms( mapsize - 1, mapsize - 1 ), z, 0 );
     }
 }
 
@@ -4,11 +4,13 @@
 #include <string>
 
 #include "cata_catch.h"
+#include "cata_utility.h"
 #include "coordinates.h"
 #include "lru_cache.h"
 #include "map.h"
 #include "map_memory.h"
 #include "map_scale_constants.h"
+#include "memory_fast.h"
 #include "point.h"
 
 static constexpr tripoint_abs_ms p1{ -SEEX - 2, -SEEY - 3, -1 };
@@ -122,6 +124,43 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     CHECK( mt.get_dec_rotation() == 0 );
 }
 
+TEST_CASE( "map_memory_region_round_trip", "[map_memory]" )
+{
+    mm_region region;
+    for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+        for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+            region.submaps[x][y] = make_pooled_shared_fast<mm_submap>();
+        }
+    }
+    memorized_tile wall;
+    wall.set_ter_id( "t_wall" );
+    wall.set_ter_rotation( 1 );
+    memorized_tile chair = wall;
+    chair.set_dec_id( "f_chair" );
+    chair.set_dec_subtile( 2 );
+    chair.symbol = 'h';
+    region.submaps[0][0]->set_tile( point_sm_ms( 1, 2 ), wall );
+    region.submaps[0][0]->set_tile( point_sm_ms( 3, 4 ), chair );
+    region.submaps[1][0]->set_tile( point_sm_ms( 1, 2 ), chair );
+
+    const std::string saved = serialize( region );
+    // Each id is saved once for the whole region.
+    CHECK( saved.find( "t_wall" ) == saved.rfind( "t_wall" ) );
+    mm_region loaded;
+    deserialize_from_string( loaded, saved );
+    for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+        for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+            CAPTURE( x, y );
+            CHECK( loaded.submaps[x][y]->is_empty() == region.submaps[x][y]->is_empty() );
+        }
+    }
+    CHECK( loaded.submaps[0][0]->get_tile( point_sm_ms( 1, 2 ) ) == wall );
+    CHECK( loaded.submaps[0][0]->get_tile( point_sm_ms( 3, 4 ) ) == chair );
+    CHECK( loaded.submaps[1][0]->get_tile( point_sm_ms( 1, 2 ) ) == chair );
+    CHECK( loaded.submaps[1][0]->get_tile( point_sm_ms( 3, 4 ) ) == mm_submap::default_tile );
+    CHECK( loaded.submaps[0][0]->get_tile( point_sm_ms( 3, 4 ) ).get_dec_id() == "f_chair" );
+}
+
 // TODO: map memory save / load
 
 #include <chrono>
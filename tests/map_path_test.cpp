@@ -647,3 +647,288 @@ TEST_CASE( "map_route_mon_around_danger", "[map][pathfinding]" )
     }
     clear_map();
 }
+
+TEST_CASE( "batched_sees_matches_single_queries", "[map]" )
+{
+    map &here = setup_map_without_obstacles();
+    const tripoint_bub_ms source{ 10, 10, 0 };
+    place_obstacle( here, { { 8, 10, 0 }, { 12, 12, 0 }, { 10, 6, 0 }, { 13, 9, 0 }, { 7, 14, 0 } } );
+
+    std::vector<tripoint_bub_ms> targets;
+    for( const tripoint_bub_ms &p : here.points_in_radius( source, 9 ) ) {
+        targets.push_back( p );
+    }
+    const std::vector<bool> batched = here.sees( source, targets, 8 );
+    REQUIRE( batched.size() == targets.size() );
+
+    // Rebuild the caches so the single queries don't just read back the batched results.
+    clear_map_caches( here );
+    for( size_t i = 0; i < targets.size(); ++i ) {
+        CAPTURE( targets[i] );
+        CHECK( batched[i] == here.sees( source, targets[i], 8 ) );
+    }
+    CHECK_FALSE( batched[std::find( targets.begin(), targets.end(),
+                                    tripoint_bub_ms{ 6, 10, 0 } ) - targets.begin()] );
+    clear_map();
+}
+
+// Cost of a route over plain floor as map::route counts it.
+static int floor_route_cost( const tripoint_bub_ms &from, const std::vector<tripoint_bub_ms> &path )
+{
+    int cost = 0;
+    tripoint_bub_ms cur = from;
+    for( const tripoint_bub_ms &p : path ) {
+        REQUIRE( square_dist( cur, p ) == 1 );
+        cost += 2 + ( ( cur.x() != p.x() && cur.y() != p.y() ) ? 1 : 0 );
+        cur = p;
+    }
+    return cost;
+}
+
+TEST_CASE( "flow_route_matches_route_and_follows_map_changes", "[map][pathfinding]" )
+{
+    map &m = get_map();
+    clear_map();
+    const tripoint_bub_ms source{ 60, 60, 0 };
+    const tripoint_bub_ms target{ 70, 60, 0 };
+    const tripoint_bub_ms gap{ 65, 64, 0 };
+    std::vector<tripoint_bub_ms> wall;
+    for( int y = 52; y <= 68; ++y ) {
+        if( y != gap.y() ) {
+            wall.emplace_back( 65, y, 0 );
+        }
+    }
+    place_obstacle( m, wall );
+    Character &pc = place_player_at( source );
+
+    const std::vector<tripoint_bub_ms> expected = m.route( pc, pathfinding_target::point( target ) );
+    // The first creature heading somewhere gets route's path, the field is built for the next.
+    CHECK( floor_route_cost( source, m.flow_route( pc, target ) ) ==
+           floor_route_cost( source, expected ) );
+    const std::vector<tripoint_bub_ms> path = m.flow_route( pc, target );
+    REQUIRE( !path.empty() );
+    CHECK( path.back() == target );
+    CHECK( std::find( path.begin(), path.end(), gap ) != path.end() );
+    CHECK( floor_route_cost( source, path ) == floor_route_cost( source, expected ) );
+
+    // Closing the gap dirties its tile, which must invalidate the shared field.
+    m.ter_set( gap, ter_id( "t_wall_metal" ) );
+    const std::vector<tripoint_bub_ms> detour = m.flow_route( pc, target );
+    CHECK( std::find( detour.begin(), detour.end(), gap ) == detour.end() );
+    CHECK( floor_route_cost( source, detour ) ==
+           floor_route_cost( source, m.route( pc, pathfinding_target::point( target ) ) ) );
+    clear_map();
+}
+
+TEST_CASE( "walled_in_targets_have_no_route", "[map][pathfinding]" )
+{
+    map &m = get_map();
+    clear_map();
+    const tripoint_bub_ms source{ 40, 60, 0 };
+    const tripoint_bub_ms target{ 90, 60, 0 };
+    std::vector<tripoint_bub_ms> walls;
+    for( const tripoint_bub_ms &p : m.points_in_radius( target, 1 ) ) {
+        if( p != target ) {
+            walls.push_back( p );
+        }
+    }
+    place_obstacle( m, walls );
+    Character &pc = place_player_at( source );
+
+    CHECK( m.route( pc, pathfinding_target::point( target ) ).empty() );
+    CHECK( m.flow_route( pc, target ).empty() );
+    clear_map();
+}
+
+TEST_CASE( "route_costs_match_route_for_every_target", "[map][pathfinding]" )
+{
+    map &m = setup_map_without_obstacles();
+    const tripoint_bub_ms source{ 60, 60, 0 };
+    const tripoint_bub_ms enclosed{ 70, 66, 0 };
+    std::vector<tripoint_bub_ms> walls;
+    for( int y = 52; y <= 68; ++y ) {
+        if( y != 64 ) {
+            walls.emplace_back( 65, y, 0 );
+        }
+    }
+    for( const tripoint_bub_ms &p : m.points_in_radius( enclosed, 1 ) ) {
+        if( p != enclosed ) {
+            walls.push_back( p );
+        }
+    }
+    place_obstacle( m, walls );
+    Character &pc = place_player_at( source );
+
+    const std::vector<tripoint_bub_ms> reachable = {
+        { 62, 61, 0 }, { 70, 60, 0 }, { 68, 70, 0 }, { 55, 66, 0 }
+    };
+    std::vector<pathfinding_target> targets;
+    for( const tripoint_bub_ms &p : reachable ) {
+        targets.push_back( pathfinding_target::point( p ) );
+    }
+    targets.push_back( pathfinding_target::point( source ) );
+    targets.push_back( pathfinding_target::point( enclosed ) );
+    targets.push_back( pathfinding_target::adjacent( { 65, 60, 0 } ) );
+
+    const std::vector<int> costs = m.route_costs( pc, targets );
+    REQUIRE( costs.size() == targets.size() );
+    for( size_t i = 0; i < reachable.size(); ++i ) {
+        CAPTURE( reachable[i] );
+        CHECK( costs[i] == floor_route_cost( source,
+                                             m.route( pc, pathfinding_target::point( reachable[i] ) ) ) );
+    }
+    CHECK( costs[reachable.size()] == 0 );
+    CHECK( costs[reachable.size() + 1] == -1 );
+    CHECK( m.route( pc, pathfinding_target::point( enclosed ) ).empty() );
+    // The wall tile itself cannot be entered, but the tiles next to it can
+    CHECK( costs[reachable.size() + 2] ==
+           floor_route_cost( source, m.route( pc, pathfinding_target::adjacent( { 65, 60, 0 } ) ) ) );
+    clear_map();
+}
+
+TEST_CASE( "route_possible_rejects_walled_off_targets", "[map][pathfinding]" )
+{
+    map &m = setup_map_without_obstacles();
+    const tripoint_bub_ms source{ 60, 60, 0 };
+    const tripoint_bub_ms enclosed{ 68, 66, 0 };
+    std::vector<tripoint_bub_ms> walls;
+    for( const tripoint_bub_ms &p : m.points_in_radius( enclosed, 1 ) ) {
+        if( p != enclosed ) {
+            walls.push_back( p );
+        }
+    }
+    place_obstacle( m, walls );
+    Character &pc = place_player_at( source );
+    const pathfinding_settings &settings = pc.get_pathfinding_settings();
+    const pathfinding_settings walker{ 0, 1000, 1000, 0, false, false, false, true, false, false };
+
+    CHECK( m.route_possible( source, pathfinding_target::point( { 70, 60, 0 } ), settings ) );
+    CHECK_FALSE( m.route_possible( source, pathfinding_target::point( enclosed ), settings ) );
+    CHECK_FALSE( m.route_possible( source, pathfinding_target::point( walls.front() ), settings ) );
+    CHECK( m.route_possible( source, pathfinding_target::adjacent( walls.front() ), settings ) );
+    CHECK( m.route( pc, pathfinding_target::point( enclosed ) ).empty() );
+
+    // A door lets in those that can open it, once the changed tile is labelled again
+    const tripoint_bub_ms door = enclosed + tripoint::west;
+    m.ter_set( door, ter_id( "t_door_c" ) );
+    CHECK( m.route_possible( source, pathfinding_target::point( enclosed ), settings ) );
+    CHECK_FALSE( m.route_possible( source, pathfinding_target::point( enclosed ), walker ) );
+    const std::vector<tripoint_bub_ms> path = m.route( pc, pathfinding_target::point( enclosed ) );
+    REQUIRE( !path.empty() );
+    CHECK( path.back() == enclosed );
+    clear_map();
+}
+
+TEST_CASE( "route_possible_to_targets_on_the_map_edge", "[map][pathfinding]" )
+{
+    map &m = setup_map_without_obstacles();
+    const tripoint_bub_ms source{ 60, 60, 0 };
+    Character &pc = place_player_at( source );
+    const pathfinding_settings &settings = pc.get_pathfinding_settings();
+    const int edge = SEEX * m.getmapsize() - 1;
+    const std::vector<tripoint_bub_ms> on_edge{ { 0, 0, 0 }, { edge, edge, 0 }, { 0, 60, 0 } };
+    for( const tripoint_bub_ms &corner : on_edge ) {
+        CAPTURE( corner );
+        CHECK( m.route_possible( source, pathfinding_target::adjacent( corner ), settings ) );
+        const std::vector<tripoint_bub_ms> path = m.route( pc, pathfinding_target::adjacent( corner ) );
+        REQUIRE( !path.empty() );
+        CHECK( square_dist( path.back(), corner ) <= 1 );
+    }
+
+    // Walled off from the source, the tiles next to the edge are still out of reach
+    const tripoint_bub_ms walled{ 0, 30, 0 };
+    std::vector<tripoint_bub_ms> walls;
+    for( const tripoint_bub_ms &p : m.points_in_radius( walled, 2 ) ) {
+        if( square_dist( p, walled ) == 2 ) {
+            walls.push_back( p );
+        }
+    }
+    place_obstacle( m, walls );
+    CHECK_FALSE( m.route_possible( source, pathfinding_target::adjacent( walled ), settings ) );
+    clear_map();
+}
+
+TEST_CASE( "map_route_leaves_bounding_box_for_long_routes", "[map][pathfinding]" )
+{
+    map &m = get_map();
+    clear_map();
+    const tripoint_bub_ms source{ 60, 60, 0 };
+    const tripoint_bub_ms target{ 100, 60, 0 };
+    // A wall between them that only ends outside the padded box around both
+    std::vector<tripoint_bub_ms> wall;
+    for( int y = 40; y < MAPSIZE_Y; ++y ) {
+        wall.emplace_back( 80, y, 0 );
+    }
+    place_obstacle( m, wall );
+    Character &pc = place_player_at( source );
+
+    const std::vector<tripoint_bub_ms> path = m.route( pc, pathfinding_target::point( target ) );
+    REQUIRE( !path.empty() );
+    CHECK( path.back() == target );
+    CHECK( std::any_of( path.begin(), path.end(), []( const tripoint_bub_ms & p ) {
+        return p.x() == 80 && p.y() < 40;
+    } ) );
+    clear_map();
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "map_route_benchmark", "[.][map][pathfinding][benchmark]" )
+{
+    map &m = get_map();
+    clear_map();
+    const tripoint_bub_ms source{ 60, 64, 0 };
+    const tripoint_bub_ms target{ 96, 64, 0 };
+    // A comb of walls with gaps at alternating ends, so the route has to zigzag
+    std::vector<tripoint_bub_ms> walls;
+    for( int x = 64; x <= 92; x += 4 ) {
+        const int gap_y = ( x / 4 ) % 2 == 0 ? 52 : 76;
+        for( int y = 52; y <= 76; ++y ) {
+            if( y != gap_y ) {
+                walls.emplace_back( x, y, 0 );
+            }
+        }
+    }
+    place_obstacle( m, walls );
+    const Character &pc = place_player_at( source );
+    REQUIRE( !m.route( pc, pathfinding_target::point( target ) ).empty() );
+
+    BENCHMARK( "route through a comb of walls" ) {
+        return m.route( pc, pathfinding_target::point( target ) ).size();
+    };
+    clear_map();
+}
+
+TEST_CASE( "reused_path_follows_target_until_its_tiles_change", "[map][pathfinding]" )
+{
+    map &m = get_map();
+    clear_map();
+    const tripoint_bub_ms source{ 60, 60, 0 };
+    const tripoint_bub_ms target{ 70, 64, 0 };
+    // Make the route need real pathfinding instead of a straight line
+    place_obstacle( m, { { 65, 61, 0 }, { 65, 62, 0 }, { 65, 63, 0 } } );
+    Character &pc = place_player_at( source );
+    const pathfinding_settings &settings = pc.get_pathfinding_settings();
+
+    std::vector<tripoint_bub_ms> path = m.route( pc, pathfinding_target::point( target ) );
+    REQUIRE( !path.empty() );
+    pc.mark_path_planned( settings );
+
+    const tripoint_bub_ms moved_target{ 71, 65, 0 };
+    REQUIRE( pc.reuse_path( path, moved_target, settings, pc.get_path_avoid() ) );
+    CHECK( path.back() == moved_target );
+    tripoint_bub_ms cur = source;
+    for( const tripoint_bub_ms &p : path ) {
+        CHECK( square_dist( cur, p ) == 1 );
+        cur = p;
+    }
+
+    // So does planning with other settings
+    pathfinding_settings bashing = settings;
+    bashing.bash_strength += 10;
+    CHECK_FALSE( pc.reuse_path( path, moved_target, bashing, pc.get_path_avoid() ) );
+
+    // A wall on the route makes it stale
+    m.ter_set( path[path.size() / 2], ter_id( "t_wall_metal" ) );
+    CHECK_FALSE( pc.reuse_path( path, target, settings, pc.get_path_avoid() ) );
+    clear_map();
+}
@@ -85,6 +85,34 @@ TEST_CASE( "map_coordinate_conversion_functions" )
     CHECK( here.get_bub( here.get_abs( test_point ) ) == test_point );
 }
 
+TEST_CASE( "map_shift_keeps_transparency_cache_consistent", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const ter_id t_wall( "t_wall" );
+    for( int i = 0; i < MAPSIZE_X; i += 7 ) {
+        here.ter_set( tripoint_bub_ms( i, ( i * 3 ) % MAPSIZE_Y, 0 ), t_wall );
+    }
+    here.build_map_cache( 0 );
+
+    const point_rel_sm shift = GENERATE( point_rel_sm::east, point_rel_sm::north_west );
+    here.shift( shift );
+    here.build_map_cache( 0 );
+    std::vector<float> shifted;
+    for( const tripoint_bub_ms &p : here.points_on_zlevel( 0 ) ) {
+        shifted.push_back( here.light_transparency( p ) );
+    }
+
+    here.set_transparency_cache_dirty( 0 );
+    here.build_map_cache( 0 );
+    size_t i = 0;
+    for( const tripoint_bub_ms &p : here.points_on_zlevel( 0 ) ) {
+        CAPTURE( p );
+        CHECK( shifted[i++] == here.light_transparency( p ) );
+    }
+    here.shift( -shift );
+}
+
 TEST_CASE( "destroy_grabbed_furniture" )
 {
     clear_map();
@@ -133,6 +161,48 @@ TEST_CASE( "map_bounds_checking" )
     }
 }
 
+TEST_CASE( "set_radiation_square_across_submaps", "[map]" )
+{
+    clear_map();
+    clear_radiation();
+    map &here = get_map();
+    // Crosses a submap border and hangs off the edge of the map.
+    const point_bub_ms p1( -3, SEEY - 2 );
+    const point_bub_ms p2( SEEX + 1, SEEY + 1 );
+    here.set_radiation_square( p1, p2, 0, 7 );
+    for( int x = -1; x <= SEEX + 2; ++x ) {
+        for( int y = SEEY - 3; y <= SEEY + 2; ++y ) {
+            const tripoint_bub_ms p( x, y, 0 );
+            INFO( p.to_string() );
+            const bool in_square = x <= p2.x() && y >= p1.y() && y <= p2.y();
+            CHECK( here.get_radiation( p ) == ( in_square && here.inbounds( p ) ? 7 : 0 ) );
+        }
+    }
+    CHECK( here.get_radiation( tripoint_bub_ms( 0, SEEY - 2, 1 ) ) == 0 );
+    clear_radiation();
+}
+
+TEST_CASE( "map_terrain_searches_across_submaps", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const ter_id t_wall( "t_wall" );
+    const ter_id t_dirt( "t_dirt" );
+    const ter_id t_grass( "t_grass" );
+    // On the corner of a submap, looked for from the one diagonal to it.
+    const tripoint_bub_ms wall( SEEX, SEEY, 0 );
+    here.ter_set( wall, t_wall );
+    const tripoint_bub_ms from( SEEX - 2, SEEY - 2, 0 );
+    CHECK( here.has_nearby_ter( from, t_wall, 2 ) );
+    CHECK_FALSE( here.has_nearby_ter( from, t_wall, 1 ) );
+    CHECK( here.has_nearby_ter( from, t_grass, 1 ) );
+
+    here.translate( t_wall, t_dirt );
+    CHECK( here.ter( wall ) == t_dirt );
+    CHECK( here.ter( wall + point::west ) == t_grass );
+    CHECK_FALSE( here.has_nearby_ter( from, t_wall, 2 ) );
+}
+
 TEST_CASE( "tinymap_bounds_checking" )
 {
     // FIXME: There are issues with vehicle caching between maps, because
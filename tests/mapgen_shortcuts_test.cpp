@@ -0,0 +1,120 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_catch.h"
+#include "cata_scope_helpers.h"
+#include "coordinates.h"
+#include "flexbuffer_json.h"
+#include "json_loader.h"
+#include "map.h"
+#include "mapgen.h"
+#include "mapgendata.h"
+#include "point.h"
+#include "rng.h"
+#include "type_id.h"
+
+static const ter_str_id ter_t_dirt( "t_dirt" );
+
+namespace
+{
+
+using layout = std::vector<std::pair<ter_id, furn_id>>;
+
+// Rows of an overmap terrain, with the key key_at gives for each cell.
+std::string rows_json( char( *key_at )( int x, int y ) )
+{
+    std::string rows = "[";
+    for( int y = 0; y < SEEY * 2; ++y ) {
+        rows += y == 0 ? "\"" : ",\"";
+        for( int x = 0; x < SEEX * 2; ++x ) {
+            rows += key_at( x, y );
+        }
+        rows += "\"";
+    }
+    return rows + "]";
+}
+
+// Runs the mapgen on an emptied overmap terrain with the same seed each time, and returns
+// the terrain and furniture it left on each cell.
+layout generate_layout( const std::string &json, bool shortcuts )
+{
+    JsonValue jv = json_loader::from_string( R"({ "object": )" + json + "}" );
+    const std::shared_ptr<mapgen_function> mapgen = load_mapgen_function( jv.get_object(),
+            "test_mapgen", point_rel_omt::zero, point_rel_omt( 1, 1 ) );
+    mapgen->setup();
+    mapgen->finalize_parameters();
+
+    const tripoint_abs_omt pos( project_to<coords::omt>( get_avatar().pos_abs() ).xy(), 0 );
+    tinymap tm;
+    tm.load( pos, true );
+    map &m = *tm.cast_to_map();
+    for( const tripoint_bub_ms &p : m.points_on_zlevel( 0 ) ) {
+        m.furn_clear( p );
+        m.remove_trap( p );
+        m.i_clear( p );
+        m.ter_set( p, ter_t_dirt );
+    }
+
+    mapgen_shortcuts = shortcuts;
+    on_out_of_scope restore_shortcuts( []() {
+        mapgen_shortcuts = true;
+    } );
+    rng_set_engine_seed( 4242 );
+    mapgendata md( pos, m, 0.0f, calendar::turn, nullptr );
+    mapgen->generate( md );
+
+    layout ret;
+    for( const tripoint_bub_ms &p : m.points_on_zlevel( 0 ) ) {
+        ret.emplace_back( m.ter( p ), m.furn( p ) );
+    }
+    return ret;
+}
+
+} // namespace
+
+TEST_CASE( "mapgen_cell_terrain_matches_the_generic_placement", "[mapgen]" )
+{
+    // The random terrain keeps the layout from being copied whole, so only the terrain of
+    // the rows is placed directly.
+    const std::string json = R"({
+        "fill_ter": "t_floor",
+        "rows": )" + rows_json( []( int x, int y ) {
+        if( x == 0 || y == 0 ) {
+            return '+';
+        }
+        return ( x * 7 + y * 3 ) % 11 == 0 ? '#' : '.';
+    } ) + R"(,
+        "terrain": {
+            "+": "t_door_c",
+            "#": { "distribution": [ [ "t_wall", 3 ], [ "t_dirt", 1 ], [ "t_grass", 1 ] ] }
+        },
+        "place_furniture": [
+            { "furn": "f_chair", "x": 5, "y": 5 },
+            { "furn": "f_chair", "x": 0, "y": 3 }
+        ],
+        "place_terrain": [ { "ter": "t_wall", "x": 5, "y": 5 } ]
+    })";
+    CHECK( generate_layout( json, true ) == generate_layout( json, false ) );
+}
+
+TEST_CASE( "mapgen_fixed_layout_matches_the_generic_placement", "[mapgen]" )
+{
+    // Everything is the same every time, so the layout is copied whole, turned by the rotation.
+    const std::string json = R"({
+        "fill_ter": "t_floor",
+        "rotation": 1,
+        "rows": )" + rows_json( []( int x, int y ) {
+        if( x == 0 || y == 0 || x == SEEX * 2 - 1 ) {
+            return x == 4 ? '+' : '#';
+        }
+        return x % 5 == 2 && y % 3 == 1 ? 'c' : '.';
+    } ) + R"(,
+        "terrain": { "#": "t_wall", "+": "t_door_c", "c": "t_floor" },
+        "furniture": { "c": "f_chair" }
+    })";
+    CHECK( generate_layout( json, true ) == generate_layout( json, false ) );
+}
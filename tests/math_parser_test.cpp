@@ -320,6 +320,31 @@ TEST_CASE( "math_parser_parsing", "[math_parser]" )
 }
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity): false positive
+TEST_CASE( "math_parser_global_vars_follow_changes", "[math_parser]" )
+{
+    dialogue d( get_talker_for( get_avatar() ), std::make_unique<talker>() );
+    math_exp testexp;
+    global_variables &globvars = get_globals();
+    globvars.clear_global_values();
+    REQUIRE( testexp.parse( "glob_a * 2" ) );
+
+    CHECK( testexp.eval( d ) == Approx( 0 ) );
+    globvars.set_global_value( "glob_a", 3 );
+    CHECK( testexp.eval( d ) == Approx( 6 ) );
+    // Other values do not move the one found.
+    for( int i = 0; i < 100; ++i ) {
+        globvars.set_global_value( "glob_filler_" + std::to_string( i ), i );
+    }
+    globvars.set_global_value( "glob_a", 4 );
+    CHECK( testexp.eval( d ) == Approx( 8 ) );
+    globvars.remove_global_value( "glob_a" );
+    CHECK( testexp.eval( d ) == Approx( 0 ) );
+    globvars.set_global_value( "glob_a", 5 );
+    CHECK( testexp.eval( d ) == Approx( 10 ) );
+    globvars.clear_global_values();
+    CHECK( testexp.eval( d ) == Approx( 0 ) );
+}
+
 TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
 {
     standard_npc dude;
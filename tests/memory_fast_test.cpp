@@ -0,0 +1,39 @@
+#include "cata_catch.h"
+
+#include <set>
+#include <vector>
+
+#include "memory_fast.h"
+
+struct pooled_example {
+    int value;
+    explicit pooled_example( int v ) : value( v ) {}
+};
+
+TEST_CASE( "pooled_shared_ptr_fast_holds_its_object", "[memory]" )
+{
+    shared_ptr_fast<pooled_example> p = make_pooled_shared_fast<pooled_example>( 3 );
+    weak_ptr_fast<pooled_example> w = p;
+    CHECK( p->value == 3 );
+    CHECK( w.lock() == p );
+    p.reset();
+    CHECK( w.expired() );
+}
+
+TEST_CASE( "pooled_shared_ptr_fast_reuses_freed_blocks", "[memory]" )
+{
+    std::vector<shared_ptr_fast<pooled_example>> horde;
+    for( int i = 0; i < 200; ++i ) {
+        horde.push_back( make_pooled_shared_fast<pooled_example>( i ) );
+    }
+    std::set<const pooled_example *> used;
+    for( int i = 0; i < 200; ++i ) {
+        CHECK( horde[i]->value == i );
+        used.insert( horde[i].get() );
+    }
+    CHECK( used.size() == 200 );
+
+    horde.clear();
+    const shared_ptr_fast<pooled_example> next = make_pooled_shared_fast<pooled_example>( 0 );
+    CHECK( used.count( next.get() ) == 1 );
+}
@@ -3,13 +3,17 @@
 #include "calendar.h"
 #include "cata_catch.h"
 #include "coordinates.h"
+#include "creature_tracker.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "monster.h"
 #include "point.h"
 #include "type_id.h"
 
+static const efftype_id effect_invisibility( "invisibility" );
+
 static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_wall( "t_wall" );
 
 static monster &spawn_and_clear( const tripoint_bub_ms &pos, bool set_floor )
 {
@@ -74,3 +78,44 @@ TEST_CASE( "monsters_should_not_see_through_floors", "[vision]" )
     CHECK( sky.sees( here, distant ) );
     CHECK( distant.sees( here, sky ) );
 }
+
+TEST_CASE( "remembered_sees_is_asked_again_after_changes", "[vision]" )
+{
+    map &here = get_map();
+    creature_tracker &creatures = get_creature_tracker();
+
+    calendar::turn = midday;
+    clear_map( -2, 1 );
+    monster &watcher = spawn_and_clear( { 5, 5, 0 }, true );
+    monster &target = spawn_and_clear( { 5, 2, 0 }, true );
+    here.build_map_cache( 0 );
+
+    REQUIRE( creatures.sees( here, watcher, target ) );
+    const size_t hits = creatures.get_sees_memo_stats().hits;
+    CHECK( creatures.sees( here, watcher, target ) );
+    CHECK( creatures.get_sees_memo_stats().hits == hits + 1 );
+
+    SECTION( "a wall goes up between them" ) {
+        here.ter_set( tripoint_bub_ms( 5, 4, 0 ), ter_t_wall );
+        here.build_map_cache( 0 );
+        CHECK( !creatures.sees( here, watcher, target ) );
+    }
+    SECTION( "the target acts" ) {
+        target.add_effect( effect_invisibility, 1_hours );
+        target.mod_moves( -100 );
+        CHECK( !creatures.sees( here, watcher, target ) );
+    }
+    SECTION( "a turn passes" ) {
+        CHECK( creatures.sees( here, target, watcher ) );
+        CHECK( creatures.sees_memo_size() == 2 );
+        calendar::turn += 1_turns;
+        CHECK( creatures.sees( here, watcher, target ) );
+        CHECK( creatures.sees_memo_size() == 1 );
+    }
+    SECTION( "the watcher is removed" ) {
+        const size_t misses = creatures.get_sees_memo_stats().misses;
+        creatures.remove( watcher );
+        CHECK( creatures.sees( here, watcher, target ) );
+        CHECK( creatures.get_sees_memo_stats().misses == misses + 1 );
+    }
+}
@@ -5,6 +5,7 @@
 
 #include "cata_catch.h"
 #include "options.h"
+#include "options_helpers.h"
 #include "string_formatter.h"
 #include "translation.h"
 #include "type_id.h"
@@ -91,3 +92,16 @@ TEST_CASE( "option_slider_test", "[option]" )
     }
     CHECK( checked == num_slider_options );
 }
+
+TEST_CASE( "option_handle_follows_option_changes", "[option]" )
+{
+    const option_handle<int> autosave_turns( "AUTOSAVE_TURNS" );
+    {
+        override_option turns( "AUTOSAVE_TURNS", "20" );
+        CHECK( autosave_turns() == 20 );
+        CHECK( autosave_turns() == 20 );
+        override_option more_turns( "AUTOSAVE_TURNS", "30" );
+        CHECK( autosave_turns() == 30 );
+    }
+    CHECK( autosave_turns() == get_option<int>( "AUTOSAVE_TURNS" ) );
+}
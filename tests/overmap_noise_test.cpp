@@ -1,6 +1,8 @@
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "cata_catch.h"
 #include "coordinates.h"
@@ -69,3 +71,56 @@ TEST_CASE( "om_noise_layer_lake_export", "[.]" )
     export_raw_noise( "lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5 );
     export_interpreted_noise( "lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25 );
 }
+
+TEST_CASE( "om_noise_grid_matches_its_layer", "[overmap][nogame]" )
+{
+    const om_noise::om_noise_layer_lake lake( point_abs_omt( 360, -180 ), 1920237457 );
+    const om_noise::om_noise_grid grid( lake, 5, []( const point_om_omt & p ) {
+        return p.x() != p.y();
+    } );
+    for( int x = -5; x < OMAPX + 5; x++ ) {
+        for( int y = -5; y < OMAPY + 5; y++ ) {
+            const point_om_omt p( x, y );
+            REQUIRE( grid.contains( p ) );
+            CAPTURE( x, y );
+            REQUIRE( grid.noise_at( p ) == ( x != y ? lake.noise_at( p ) : 0.0f ) );
+        }
+    }
+    CHECK_FALSE( grid.contains( point_om_omt( -6, 0 ) ) );
+    CHECK_FALSE( grid.contains( point_om_omt( 0, OMAPY + 5 ) ) );
+}
+
+TEST_CASE( "om_noise_layer_rows_match_their_points", "[overmap][nogame]" )
+{
+    const point_abs_omt base( -540, 900 );
+    const unsigned seed = 1920237457;
+    const om_noise::om_noise_layer_forest forest( base, seed );
+    const om_noise::om_noise_layer_floodplain floodplain( base, seed );
+    const om_noise::om_noise_layer_lake lake( base, seed );
+    const om_noise::om_noise_layer_ocean ocean( base, seed );
+    std::vector<float> row( OMAPX );
+    for( const om_noise::om_noise_layer *layer : {
+             static_cast<const om_noise::om_noise_layer *>( &forest ),
+             static_cast<const om_noise::om_noise_layer *>( &floodplain ),
+             static_cast<const om_noise::om_noise_layer *>( &lake ),
+             static_cast<const om_noise::om_noise_layer *>( &ocean )
+         } ) {
+        for( int y = -5; y < OMAPY; y += 31 ) {
+            layer->noise_row( point_om_omt( -5, y ), OMAPX, row.data() );
+            for( int x = 0; x < OMAPX; x++ ) {
+                CAPTURE( x, y );
+                REQUIRE( row[x] == layer->noise_at( point_om_omt( x - 5, y ) ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "om_noise_lake_grid_is_kept", "[overmap][nogame]" )
+{
+    const point_abs_om om( 3, -2 );
+    const std::shared_ptr<const om_noise::om_noise_grid> grid = om_noise::lake_grid( om, 42 );
+    CHECK( om_noise::lake_grid( om, 42 ) == grid );
+    CHECK( om_noise::lake_grid( om, 43 ) != grid );
+    const om_noise::om_noise_layer_lake lake( project_to<coords::omt>( om ), 42 );
+    CHECK( grid->noise_at( point_om_omt( -5, 7 ) ) == lake.noise_at( point_om_omt( -5, 7 ) ) );
+}
@@ -2,6 +2,7 @@
 #include <cmath>
 #include <cstdio>
 #include <functional>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
@@ -14,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
 #include "city.h"
@@ -37,6 +39,7 @@
 #include "overmapbuffer.h"
 #include "point.h"
 #include "recipe.h"
+#include "simple_pathfinding.h"
 #include "rng.h"
 #include "test_data.h"
 #include "type_id.h"
@@ -74,6 +77,110 @@ TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
     REQUIRE( test_overmap->scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
 
+TEST_CASE( "async_travel_path_matches_travel_path", "[overmap][pathfinding]" )
+{
+    const tripoint_abs_omt src = get_player_character().pos_abs_omt();
+    const overmap_path_params params = overmap_path_params::for_npc();
+    for( const point_rel_omt &offset : {
+             point_rel_omt( 6, 2 ), point_rel_omt( -9, 14 ), point_rel_omt( 30, -25 )
+         } ) {
+        const tripoint_abs_omt dest = src + offset;
+        CAPTURE( dest );
+        std::future<pf::simple_path<tripoint_abs_omt>> async_path =
+            overmap_buffer.get_travel_path_async( src, dest, params );
+        const pf::simple_path<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest, params );
+        const pf::simple_path<tripoint_abs_omt> async_result = async_path.get();
+        CHECK( async_result.points == path.points );
+        CHECK( async_result.cost == path.cost );
+    }
+}
+
+TEST_CASE( "road_travel_path_is_cheapest_road_path", "[overmap][pathfinding]" )
+{
+    // A ring road with a road across it, in a field so no other road touches it
+    const tripoint_abs_omt base = get_player_character().pos_abs_omt() + point_rel_omt( 10, 10 );
+    const oter_id field( "field" );
+    const oter_id road( "road_nesw" );
+    std::map<tripoint_abs_omt, oter_id> old_terrain;
+    for( int x = 0; x < 24; ++x ) {
+        for( int y = 0; y < 16; ++y ) {
+            const tripoint_abs_omt p = base + point_rel_omt( x, y );
+            old_terrain.emplace( p, overmap_buffer.ter( p ) );
+            const bool on_ring = ( x == 2 || x == 21 ) ? y >= 2 && y <= 13 :
+                                 ( y == 2 || y == 13 ) && x >= 2 && x <= 21;
+            const bool across = x == 8 && y >= 2 && y <= 13;
+            overmap_buffer.ter_set( p, on_ring || across ? road : field );
+        }
+    }
+    overmap_path_params params = overmap_path_params::for_land_vehicle( 0.0f, false, false );
+    params.only_known_by_player = false;
+    params.avoid_danger = false;
+
+    for( const std::pair<point_rel_omt, point_rel_omt> &ends : {
+             std::make_pair( point_rel_omt( 2, 7 ), point_rel_omt( 21, 5 ) ),
+             std::make_pair( point_rel_omt( 8, 2 ), point_rel_omt( 8, 13 ) ),
+             std::make_pair( point_rel_omt( 15, 13 ), point_rel_omt( 2, 2 ) )
+         } ) {
+        const tripoint_abs_omt src = base + ends.first;
+        const tripoint_abs_omt dest = base + ends.second;
+        CAPTURE( src, dest );
+        const pf::simple_path<tripoint_abs_omt> road_path =
+            overmap_buffer.get_road_travel_path( src, dest, params );
+        const pf::simple_path<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest, params );
+        REQUIRE( !path.points.empty() );
+        REQUIRE( !road_path.points.empty() );
+        CHECK( road_path.points.front() == dest );
+        CHECK( road_path.points.back() == src );
+        for( size_t i = 0; i + 1 < road_path.points.size(); ++i ) {
+            CHECK( manhattan_dist( road_path.points[i].xy(), road_path.points[i + 1].xy() ) == 1 );
+        }
+        CHECK( road_path.cost <= path.cost );
+    }
+
+    // Roads off the graph are found again once the terrain changes
+    const tripoint_abs_omt off_road = base + point_rel_omt( 14, 7 );
+    CHECK( overmap_buffer.get_road_travel_path( base + point_rel_omt( 2, 7 ), off_road,
+            params ).points.empty() );
+    for( int x = 9; x <= 14; ++x ) {
+        overmap_buffer.ter_set( base + point_rel_omt( x, 7 ), road );
+    }
+    CHECK( !overmap_buffer.get_road_travel_path( base + point_rel_omt( 2, 7 ), off_road,
+            params ).points.empty() );
+
+    for( const std::pair<const tripoint_abs_omt, oter_id> &old : old_terrain ) {
+        overmap_buffer.ter_set( old.first, old.second );
+    }
+}
+
+TEST_CASE( "overmap_uniform_terrain_follows_changes", "[overmap][terrain]" )
+{
+    const tripoint_abs_omt p( get_player_character().pos_abs_omt().xy() + point_rel_omt( 12, 12 ),
+                              OVERMAP_HEIGHT );
+    const overmap_with_local_coords om_loc = overmap_buffer.get_om_global( p );
+    const std::optional<oter_id> before = om_loc.om->uniform_terrain( OVERMAP_HEIGHT );
+    const oter_id old = om_loc.om->ter( om_loc.local );
+    const oter_id field( "field" );
+    REQUIRE( old != field );
+
+    omt_find_params params;
+    params.types = { { "field", ot_match_type::type } };
+    params.search_range = 10;
+    params.min_z = OVERMAP_HEIGHT;
+    params.max_z = OVERMAP_HEIGHT;
+    const tripoint_abs_omt origin = p + point_rel_omt( 3, -2 );
+
+    om_loc.om->ter_set( om_loc.local, field );
+    CHECK_FALSE( om_loc.om->uniform_terrain( OVERMAP_HEIGHT ) );
+    CHECK( overmap_buffer.find_closest( origin, params ) == p );
+
+    om_loc.om->ter_set( om_loc.local, old );
+    CHECK( om_loc.om->uniform_terrain( OVERMAP_HEIGHT ) == before );
+    if( before ) {
+        CHECK( *before == old );
+        CHECK( overmap_buffer.find_closest( origin, params ) == tripoint_abs_omt::invalid );
+    }
+}
+
 TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
 {
     overmap_buffer.clear();
@@ -98,6 +205,39 @@ TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
     }
 }
 
+TEST_CASE( "overmap_across_nearing_border_is_pregenerated", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    const point_abs_om origin;
+    const point_abs_om east = origin + point::east;
+    overmap_buffer.get( origin );
+    const tripoint_abs_omt near_border( project_to<coords::omt>( origin ) +
+                                        point( OMAPX - 2, OMAPY / 2 ), 0 );
+    overmap_buffer.pregenerate_near( near_border );
+    // Only added once complete.
+    CHECK_FALSE( overmap_buffer.has( east ) );
+
+    SECTION( "a stage per call" ) {
+        int calls = 1;
+        while( !overmap_buffer.has( east ) && calls < 100 ) {
+            overmap_buffer.pregenerate_near( near_border );
+            ++calls;
+        }
+        CHECK( overmap_buffer.has( east ) );
+        CHECK( calls > 2 );
+    }
+    SECTION( "completed when asked for" ) {
+        overmap_buffer.pregenerate_near( near_border );
+        CHECK( overmap_buffer.get( east ).pos() == east );
+        CHECK( overmap_buffer.has( east ) );
+    }
+    SECTION( "completed before it is left out of a save" ) {
+        overmap_buffer.pregenerate_near( near_border );
+        overmap_buffer.complete_pregeneration();
+        CHECK( overmap_buffer.has( east ) );
+    }
+}
+
 TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin", "[overmap][slow]" )
 {
     const point_abs_om origin{};
@@ -0,0 +1,16 @@
+#include "perf_helpers.h"
+
+#include <map>
+
+#include "string_formatter.h"
+
+void append_timer_stats( std::string &out, const cata_timer::timer_stats &stats,
+                         const std::string_view indent )
+{
+    out += string_format( "%s%s: %d ms, %d calls\n", indent, stats.name, stats.duration / 1000,
+                          stats.count );
+    const std::string child_indent = std::string( indent ) + "  ";
+    for( const auto &[name, child] : stats.child_timers ) {
+        append_timer_stats( out, child, child_indent );
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+#ifndef CATA_TESTS_PERF_HELPERS_H
+#define CATA_TESTS_PERF_HELPERS_H
+
+#include <string>
+#include <string_view>
+
+#include "perf.h"
+
+// Appends the time and calls of a timer, then of its children indented below it.
+void append_timer_stats( std::string &out, const cata_timer::timer_stats &stats,
+                         std::string_view indent = "" );
+
+#endif // CATA_TESTS_PERF_HELPERS_H
@@ -0,0 +1,36 @@
+#include <optional>
+
+#include "cata_catch.h"
+#include "cata_scope_helpers.h"
+#include "perf.h"
+
+TEST_CASE( "timer_reset_keeps_running_timers", "[perf][nogame]" )
+{
+    cata_timer::reset_stats();
+    cata_timer::collecting() = true;
+    on_out_of_scope stop_timers( []() {
+        cata_timer::collecting() = false;
+    } );
+    {
+        cata_timer done( "test_done" );
+    }
+    std::optional<cata_timer> outer;
+    outer.emplace( "test_outer" );
+    {
+        cata_timer inner( "test_inner" );
+        cata_timer::reset_stats();
+        const cata_timer::timers_map stats = cata_timer::get_stats();
+        CHECK( stats.count( "test_done" ) == 0 );
+        REQUIRE( stats.count( "test_outer" ) == 1 );
+        CHECK( stats.at( "test_outer" ).count == 0 );
+        CHECK( stats.at( "test_outer" ).child_timers.count( "test_inner" ) == 1 );
+    }
+    outer.reset();
+
+    const cata_timer::timers_map stats = cata_timer::get_stats();
+    REQUIRE( stats.count( "test_outer" ) == 1 );
+    CHECK( stats.at( "test_outer" ).count == 1 );
+    CHECK( stats.at( "test_outer" ).child_timers.at( "test_inner" ).count == 1 );
+    cata_timer::reset_stats();
+    CHECK( cata_timer::get_stats().empty() );
+}
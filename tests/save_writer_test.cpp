@@ -0,0 +1,117 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cata_catch.h"
+#include "path_info.h"
+#include "save_writer.h"
+
+TEST_CASE( "save_writer_runs_writes_in_order", "[save_writer][nogame]" )
+{
+    save_writer writer;
+    std::vector<int> order;
+    for( int i = 0; i < 20; ++i ) {
+        writer.enqueue( "file" + std::to_string( i % 3 ), "test data", [&order, i]() {
+            order.push_back( i );
+        } );
+    }
+    CHECK( writer.flush() );
+    REQUIRE( order.size() == 20 );
+    for( int i = 0; i < 20; ++i ) {
+        CHECK( order[i] == i );
+    }
+}
+
+TEST_CASE( "save_writer_waits_only_for_its_target", "[save_writer][nogame]" )
+{
+    save_writer writer;
+    std::atomic<bool> release( false );
+    std::atomic<bool> written( false );
+    writer.enqueue( "slow", "test data", [&]() {
+        while( !release ) {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+    } );
+    writer.enqueue( "target", "test data", [&]() {
+        written = true;
+    } );
+    // Nothing is queued for this one, so it must not wait behind the slow write
+    writer.wait_for( "other" );
+    CHECK_FALSE( written );
+    release = true;
+    writer.wait_for( "target" );
+    CHECK( written );
+    CHECK( writer.flush() );
+}
+
+TEST_CASE( "save_writer_reports_failures_on_flush", "[save_writer][nogame]" )
+{
+    save_writer writer;
+    bool after_failure = false;
+    writer.enqueue( "file", "test data", []() {
+        throw std::runtime_error( "disk full" );
+    } );
+    writer.enqueue( "file", "test data", [&]() {
+        after_failure = true;
+    } );
+    CHECK_FALSE( writer.flush() );
+    CHECK( after_failure );
+    // Each failure is only reported once
+    CHECK( writer.flush() );
+}
+
+#if !defined(_WIN32) && !defined(EMSCRIPTEN)
+TEST_CASE( "save_writer_forked_save_sees_the_state_at_the_fork", "[save_writer][nogame]" )
+{
+    const std::filesystem::path path = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "save_writer_fork_test.txt";
+    std::filesystem::remove( path );
+    save_writer writer;
+    int state = 1;
+    REQUIRE( writer.run_in_fork( [&]() {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        std::ofstream fout( path );
+        fout << state;
+        return static_cast<bool>( fout );
+    }, "test data" ) );
+    // The copy saves the state as it was when it was forked
+    state = 2;
+    CHECK( writer.is_pending( "anything" ) );
+    CHECK( writer.flush() );
+    CHECK_FALSE( writer.is_pending( "anything" ) );
+    std::ifstream fin( path );
+    int saved = 0;
+    fin >> saved;
+    CHECK( saved == 1 );
+    fin.close();
+    std::filesystem::remove( path );
+
+    REQUIRE( writer.run_in_fork( []() {
+        return false;
+    }, "test data" ) );
+    CHECK_FALSE( writer.flush() );
+    std::optional<save_writer::fork_result> failed = writer.take_fork_result();
+    REQUIRE( failed );
+    CHECK_FALSE( failed->saved );
+
+    // Larger than a pipe holds, so the copy can only exit once it was read.
+    const std::string report( 1 << 20, 'r' );
+    REQUIRE( writer.run_in_fork( []() {
+        return true;
+    }, "test data", [&report]() {
+        return report;
+    } ) );
+    CHECK( writer.flush() );
+    std::optional<save_writer::fork_result> result = writer.take_fork_result();
+    REQUIRE( result );
+    CHECK( result->saved );
+    CHECK( result->report == report );
+    CHECK_FALSE( writer.take_fork_result() );
+}
+#endif
@@ -1125,6 +1125,66 @@ TEST_CASE( "shadowcasting_3d_performance", "[.]" )
     shadowcasting_3d_benchmark( 10000 );
 }
 
+TEST_CASE( "shadowcasting_palette_equivalence", "[shadowcasting]" )
+{
+    struct test_grids {
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> transparency_cache = {};
+        std::array<transparency_palette_grid, OVERMAP_LAYERS> palettes = {};
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> seen_float = {};
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> seen_palette = {};
+        std::array<cata::mdarray<bool, point_bub_ms>, OVERMAP_LAYERS> floor_cache = {};
+    };
+    std::unique_ptr<test_grids> grids = std::make_unique<test_grids>();
+
+    array_of_grids_of<const float> transparency_caches;
+    std::array<const transparency_palette_grid *, OVERMAP_LAYERS> palettes;
+    array_of_grids_of<float> seen_float;
+    array_of_grids_of<float> seen_palette;
+    array_of_grids_of<const bool> floor_caches;
+    for( int z = 0; z < OVERMAP_LAYERS; z++ ) {
+        randomly_fill_transparency( grids->transparency_cache[z] );
+        grids->palettes[z].build( grids->transparency_cache[z] );
+        REQUIRE( grids->palettes[z].valid );
+        transparency_caches[z] = &grids->transparency_cache[z];
+        palettes[z] = &grids->palettes[z];
+        seen_float[z] = &grids->seen_float[z];
+        seen_palette[z] = &grids->seen_palette[z];
+        floor_caches[z] = &grids->floor_cache[z];
+    }
+
+    const tripoint_bub_ms origin( 65, 65, 0 );
+    cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+        seen_float, transparency_caches, floor_caches, origin, 0, 1.0 );
+    cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+        seen_palette, palettes, floor_caches, origin, 0, 1.0 );
+
+    for( int z = 0; z < OVERMAP_LAYERS; z++ ) {
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                CAPTURE( x, y, z );
+                REQUIRE( grids->seen_float[z][x][y] == grids->seen_palette[z][x][y] );
+            }
+        }
+    }
+}
+
+TEST_CASE( "transparency_palette_overflow", "[shadowcasting]" )
+{
+    std::unique_ptr<cata::mdarray<float, point_bub_ms>> transparency =
+        std::make_unique<cata::mdarray<float, point_bub_ms>>( LIGHT_TRANSPARENCY_OPEN_AIR );
+    std::unique_ptr<transparency_palette_grid> palette =
+        std::make_unique<transparency_palette_grid>();
+    palette->build( *transparency );
+    CHECK( palette->valid );
+    CHECK( ( *palette )( 10, 10 ) == LIGHT_TRANSPARENCY_OPEN_AIR );
+
+    for( int i = 0; i < transparency_palette_grid::max_values; ++i ) {
+        ( *transparency )[i % MAPSIZE_X][i / MAPSIZE_X] = LIGHT_TRANSPARENCY_OPEN_AIR * ( i + 2 );
+    }
+    palette->build( *transparency );
+    CHECK_FALSE( palette->valid );
+}
+
 TEST_CASE( "shadowcasting_float_quad_equivalence", "[shadowcasting]" )
 {
     shadowcasting_float_quad( 1 );
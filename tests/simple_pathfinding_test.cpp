@@ -140,3 +140,26 @@ TEST_CASE( "find_overmap_path_bridge", "[pathfinding]" )
     CHECK( pth.points[0] == Point( 2, 0, 0 ) );
 }
 
+
+TEST_CASE( "find_overmap_path_enclosed_destination", "[pathfinding]" )
+{
+    using Point = tripoint_abs_omt;
+    const Point start( 0, 0, 0 );
+    const Point finish( 20, 0, 0 );
+    constexpr int radius = 50;
+    // An open field with the destination walled in on all sides.
+    int scored = 0;
+    const pf::omt_scoring_fn estimate = [&]( Point cur ) {
+        ++scored;
+        if( cur.z() != 0 || ( square_dist( cur.xy(), finish.xy() ) == 1 ) ) {
+            return pf::omt_score::rejected;
+        }
+        return pf::omt_score( 10, false );
+    };
+
+    const pf::simple_path<Point> pth = pf::find_overmap_path( start, finish, radius, estimate,
+                                       noop_fn );
+    CHECK( pth.points.empty() );
+    // Searching the whole radius would score over ten thousand OMTs.
+    CHECK( scored < 1000 );
+}
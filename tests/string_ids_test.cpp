@@ -2,6 +2,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -67,6 +68,39 @@ TEST_CASE( "string_ids_intern_test", "[string_id]" )
     }
 }
 
+TEST_CASE( "string_ids_intern_concurrently", "[string_id]" )
+{
+    static constexpr int num_threads = 8;
+    // Prime, so every stride below visits each id once.
+    static constexpr int num_ids = 20011;
+
+    struct test_obj {};
+    // Every thread interns the same ids, in a different order.
+    std::vector<std::vector<string_id<test_obj>>> ids( num_threads );
+    std::vector<std::thread> threads;
+    for( int t = 0; t < num_threads; ++t ) {
+        threads.emplace_back( [&ids, t]() {
+            ids[t].resize( num_ids );
+            for( int n = 0; n < num_ids; ++n ) {
+                const int i = ( n * ( 2 * t + 1 ) ) % num_ids;
+                ids[t][i] = string_id<test_obj>( "concurrent_id" + std::to_string( i ) );
+            }
+        } );
+    }
+    for( std::thread &th : threads ) {
+        th.join();
+    }
+
+    for( int i = 0; i < num_ids; ++i ) {
+        const string_id<test_obj> expected( "concurrent_id" + std::to_string( i ) );
+        for( int t = 0; t < num_threads; ++t ) {
+            CAPTURE( i, t );
+            CHECK( ids[t][i] == expected );
+            CHECK( &ids[t][i].str() == &expected.str() );
+        }
+    }
+}
+
 TEST_CASE( "string_ids_collection_equality", "[string_id]" )
 {
     struct test_obj {};
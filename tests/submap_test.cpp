@@ -115,3 +115,60 @@ TEST_CASE( "submap_rotation2", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_light_emitters_follow_changes", "[submap]" )
+{
+    submap sm;
+    sm.set_all_ter( ter_str_id( "t_dirt" ).id() );
+    REQUIRE( sm.get_light_emitters().empty() );
+
+    const point_sm_ms lamp( 2, 3 );
+    sm.set_lum( lamp, 1 );
+    REQUIRE( sm.get_light_emitters().size() == 1 );
+    CHECK( sm.get_light_emitters().front() == lamp );
+
+    sm.rotate( 1 );
+    REQUIRE( sm.get_light_emitters().size() == 1 );
+    CHECK( sm.get_light_emitters().front() == lamp.rotate( 1, { SEEX, SEEY } ) );
+}
+
+TEST_CASE( "submap_field_columns_follow_rotation", "[submap]" )
+{
+    submap sm;
+    sm.ensure_nonuniform();
+    const point_sm_ms fire( 1, 4 );
+    REQUIRE( sm.get_field( fire ).add_field( field_type_str_id( "fd_fire" ).id(), 1 ) );
+    sm.mark_field_tile( fire );
+    CHECK( sm.get_field_column( fire.x() ) == 1 << fire.y() );
+
+    sm.rotate( 1 );
+    const point_sm_ms rotated = fire.rotate( 1, { SEEX, SEEY } );
+    for( int x = 0; x < SEEX; x++ ) {
+        CAPTURE( x );
+        CHECK( sm.get_field_column( x ) == ( x == rotated.x() ? 1 << rotated.y() : 0 ) );
+    }
+}
+
+TEST_CASE( "submap_shared_tiles_copy_on_write", "[submap]" )
+{
+    constexpr point_sm_ms p = { SEEX / 2, SEEY / 2 };
+    submap sm_a;
+    submap sm_b;
+    sm_a.set_all_ter( ter_id( 1 ) );
+    sm_a.set_ter( p, ter_id( 2 ) );
+    sm_b.set_all_ter( ter_id( 1 ) );
+    sm_b.set_ter( p, ter_id( 2 ) );
+    REQUIRE( sm_a.tiles_hash() == sm_b.tiles_hash() );
+    const size_t unshared_memory = sm_b.memory_estimate();
+    REQUIRE( sm_b.share_tiles_with( sm_a ) );
+    CHECK( sm_a.shares_tiles() );
+    CHECK( sm_b.shares_tiles() );
+    CHECK( sm_b.memory_estimate() < unshared_memory );
+
+    sm_b.set_ter( p, ter_id( 3 ) );
+    CHECK_FALSE( sm_a.shares_tiles() );
+    CHECK_FALSE( sm_b.shares_tiles() );
+    CHECK( sm_a.get_ter( p ) == ter_id( 2 ) );
+    CHECK( sm_b.get_ter( p ) == ter_id( 3 ) );
+    CHECK_FALSE( sm_b.share_tiles_with( sm_a ) );
+}
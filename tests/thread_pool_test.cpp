@@ -0,0 +1,83 @@
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cata_catch.h"
+#include "cata_thread_pool.h"
+#include "debug.h"
+
+TEST_CASE( "thread_pool_parallel_for_visits_each_index_once", "[thread_pool][nogame]" )
+{
+    const int num_workers = GENERATE( 0, 1, 3 );
+    CAPTURE( num_workers );
+    cata::thread_pool pool( num_workers );
+    std::vector<std::atomic<int>> visits( 100 );
+    pool.parallel_for( 0, 100, [&]( const int i ) {
+        ++visits[i];
+    } );
+    for( const std::atomic<int> &v : visits ) {
+        CHECK( v.load() == 1 );
+    }
+}
+
+TEST_CASE( "thread_pool_parallel_for_rethrows", "[thread_pool][nogame]" )
+{
+    cata::thread_pool pool( 2 );
+    std::atomic<int> calls( 0 );
+    CHECK_THROWS_AS( pool.parallel_for( 0, 10, [&]( const int i ) {
+        ++calls;
+        if( i == 5 ) {
+            throw std::runtime_error( "failure" );
+        }
+    } ), std::runtime_error );
+    CHECK( calls.load() == 10 );
+}
+
+TEST_CASE( "thread_pool_parallel_for_runs_on_caller_while_workers_are_busy",
+           "[thread_pool][nogame]" )
+{
+    cata::thread_pool pool( 1 );
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::future<void> busy = pool.submit( [released]() {
+        released.wait();
+    } );
+    int calls = 0;
+    pool.parallel_for( 0, 10, [&]( int ) {
+        ++calls;
+    } );
+    CHECK( calls == 10 );
+    release.set_value();
+    busy.get();
+    pool.wait_until_idle();
+}
+
+TEST_CASE( "thread_pool_submit_returns_result", "[thread_pool][nogame]" )
+{
+    const int num_workers = GENERATE( 0, 2 );
+    cata::thread_pool pool( num_workers );
+    std::future<int> result = pool.submit( []() {
+        return 6 * 7;
+    } );
+    CHECK( result.get() == 42 );
+}
+
+TEST_CASE( "thread_pool_debugmsg_deferred_on_workers", "[thread_pool][nogame]" )
+{
+    cata::thread_pool pool( 3 );
+    std::vector<std::vector<deferred_debugmsg>> messages( 8 );
+    pool.parallel_for( 0, 8, [&]( const int i ) {
+        defer_debugmsg_during( [i]() {
+            debugmsg( "check %d", i );
+        }, messages[i] );
+    } );
+    const std::string reported = capture_debugmsg_during( [&]() {
+        for( const std::vector<deferred_debugmsg> &m : messages ) {
+            REQUIRE( m.size() == 1 );
+            report_deferred_debugmsg( m );
+        }
+    } );
+    CHECK( reported == "check 0check 1check 2check 3check 4check 5check 6check 7" );
+}
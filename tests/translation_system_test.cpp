@@ -1,5 +1,6 @@
 #include <cstring>
 #include <filesystem>
+#include <string>
 #include "cata_catch.h"
 #include "filesystem.h"
 #include "string_formatter.h"
@@ -68,6 +69,34 @@ TEST_CASE( "No_string_buffer_overlap_in_TranslationDocument", "[translations]" )
     }
 }
 
+TEST_CASE( "TranslationManager_finds_every_string_of_a_document", "[translations]" )
+{
+    const char *path = "./data/mods/TEST_DATA/lang/mo/ru/LC_MESSAGES/TEST_DATA.mo";
+    TranslationDocument document( path );
+    TranslationManager manager;
+    manager.LoadDocuments( { path } );
+    for( std::size_t i = 0; i < document.Count(); i++ ) {
+        const std::string original = document.GetOriginalString( i );
+        if( original.empty() ) {
+            continue;
+        }
+        CAPTURE( original );
+        const char *expected = document.GetTranslatedString( i );
+        const std::size_t context_end = original.find( '\004' );
+        if( context_end == std::string::npos ) {
+            CHECK( std::strcmp( manager.Translate( original ), expected ) == 0 );
+        } else {
+            const std::string context = original.substr( 0, context_end );
+            const std::string message = original.substr( context_end + 1 );
+            CHECK( std::strcmp( manager.TranslateWithContext( context.c_str(), message.c_str() ),
+                                expected ) == 0 );
+        }
+    }
+    const char *missing = "A string that is in no document";
+    CHECK( manager.Translate( missing ) == missing );
+    CHECK( manager.TranslateWithContext( "no context", missing ) == missing );
+}
+
 TEST_CASE( "TranslationDocument_loading_benchmark", "[.][benchmark][translations]" )
 {
     BENCHMARK( "Load Russian" ) {
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_catch.h"
+#include "cata_scope_helpers.h"
+#include "coordinates.h"
+#include "do_turn.h"
+#include "game.h"
+#include "item.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "perf.h"
+#include "perf_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "string_formatter.h"
+#include "type_id.h"
+#include "units.h"
+
+static const itype_id itype_gasoline_lantern_on( "gasoline_lantern_on" );
+
+static const vproto_id vehicle_prototype_car( "car" );
+
+// Turns run, after the ones letting the horde close in.
+static constexpr int benchmark_turns = 500;
+static constexpr int warmup_turns = 20;
+
+static void run_turn()
+{
+    calendar::turn += 1_turns;
+    // Only the horde and the items should be busy, not the player dying.
+    get_avatar().set_all_parts_hp_to_max();
+    process_world_turn();
+}
+
+// Runs the turns of the same busy scene in each run: a horde closing in on the player, lit
+// lanterns and parked cars.  Run with `tests/cata_test "[turn][benchmark]"`.
+TEST_CASE( "turn_benchmark", "[.][turn][benchmark]" )
+{
+    clear_avatar();
+    clear_map();
+    set_time_to_day();
+    rng_set_engine_seed( 4242424242 );
+    avatar &u = get_avatar();
+    map &here = get_map();
+    const tripoint_bub_ms center = u.pos_bub();
+
+    for( const tripoint_bub_ms &p : here.points_in_radius( center, 20 ) ) {
+        const int dist = rl_dist( p, center );
+        if( dist >= 15 && p.x() % 2 == 0 && p.y() % 2 == 0 ) {
+            spawn_test_monster( "mon_zombie", p );
+        } else if( dist >= 4 && dist < 10 && p.x() % 3 == 0 && p.y() % 3 == 0 ) {
+            item lantern( itype_gasoline_lantern_on );
+            lantern.ammo_set( lantern.ammo_default() );
+            lantern.active = true;
+            here.add_item( p, lantern );
+        }
+    }
+    for( int i = 0; i < 4; ++i ) {
+        REQUIRE( here.add_vehicle( vehicle_prototype_car, center + point( -30 + 8 * i, 25 ),
+                                   0_degrees, 0, 0 ) );
+    }
+
+    for( int i = 0; i < warmup_turns; ++i ) {
+        run_turn();
+    }
+
+    cata_timer::reset_stats();
+    cata_timer::collecting() = true;
+    on_out_of_scope stop_timers( []() {
+        cata_timer::collecting() = false;
+    } );
+    std::vector<int64_t> turn_us;
+    turn_us.reserve( benchmark_turns );
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for( int i = 0; i < benchmark_turns; ++i ) {
+        const std::chrono::steady_clock::time_point turn_start = std::chrono::steady_clock::now();
+        run_turn();
+        turn_us.push_back( std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - turn_start ).count() );
+    }
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                           start ).count();
+
+    std::sort( turn_us.begin(), turn_us.end() );
+    std::string report = string_format( "%d monsters, %.1f turns/s, p50 %d us, p99 %d us\n",
+                                        g->num_creatures() - 1, benchmark_turns / seconds,
+                                        turn_us[turn_us.size() / 2], turn_us[turn_us.size() * 99 / 100] );
+    for( const auto &[name, stats] : cata_timer::get_stats() ) {
+        append_timer_stats( report, stats );
+    }
+    WARN( report );
+    CHECK( cata_timer::get_stats().count( "monmove" ) == 1 );
+}
@@ -0,0 +1,63 @@
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_catch.h"
+#include "cata_scope_helpers.h"
+#include "coordinates.h"
+#include "debug.h"
+#include "map.h"
+#include "map_scale_constants.h"
+#include "mapbuffer.h"
+#include "overmapbuffer.h"
+#include "perf.h"
+#include "perf_helpers.h"
+#include "point.h"
+#include "rng.h"
+
+// Overmaps generated, around the first one.
+static constexpr int benchmark_overmap_radius = 1;
+// OMTs generated, the closest ones to the middle of the first overmap.
+static constexpr int benchmark_omt_radius = 6;
+
+// Generates the same world in each run with the same mods and options, so the timings of two
+// builds or mod lists can be compared.  Run with `tests/cata_test "[worldgen][benchmark]"`.
+TEST_CASE( "worldgen_benchmark", "[.][worldgen][benchmark]" )
+{
+    rng_set_engine_seed( 4242424242 );
+    // Far from the reality bubble, which is never generated over.
+    const point_abs_om origin( 8, 8 );
+    overmap_buffer.clear();
+    cata_timer::reset_stats();
+    cata_timer::collecting() = true;
+    on_out_of_scope stop_timers( []() {
+        cata_timer::collecting() = false;
+        overmap_buffer.clear();
+    } );
+
+    {
+        cata_timer timer( "overmaps" );
+        for( const point_abs_om &om : closest_points_first( origin, benchmark_overmap_radius ) ) {
+            overmap_buffer.get( om );
+        }
+    }
+
+    const point_abs_omt middle = project_to<coords::omt>( origin ) + point( OMAPX / 2, OMAPY / 2 );
+    const std::string msg = capture_debugmsg_during( [&middle]() {
+        cata_timer timer( "omts" );
+        for( const point_abs_omt &p : closest_points_first( middle, benchmark_omt_radius ) ) {
+            MAPBUFFER.clear_outside_reality_bubble();
+            smallmap tm;
+            tm.generate( tripoint_abs_omt( p, 0 ), calendar::turn, false );
+            tm.delete_unmerged_submaps();
+        }
+    } );
+    CAPTURE( msg );
+
+    std::string report;
+    for( const auto &[name, stats] : cata_timer::get_stats() ) {
+        append_timer_stats( report, stats );
+    }
+    WARN( report );
+    CHECK( cata_timer::get_stats().count( "omts" ) == 1 );
+}
@@ -0,0 +1,361 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "path_info.h"
+#include "std_hash_fs_path.h"
+#include "zzip.h"
+
+static std::string file_contents( const std::shared_ptr<zzip> &z, const std::string &name )
+{
+    std::vector<std::byte> contents = z->get_file( std::filesystem::u8path( name ) );
+    return std::string( reinterpret_cast<const char *>( contents.data() ), contents.size() );
+}
+
+TEST_CASE( "zzip_add_files_matches_add_file", "[zzip][nogame]" )
+{
+    const std::filesystem::path path = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "zzip_add_files_test.zzip";
+    std::filesystem::remove( path );
+
+    std::vector<std::string> contents;
+    for( int i = 0; i < 40; ++i ) {
+        contents.emplace_back( std::string( 100 + i * 37, static_cast<char>( 'a' + i % 26 ) ) +
+                               std::to_string( i ) );
+    }
+    {
+        std::shared_ptr<zzip> z = zzip::load( path );
+        REQUIRE( z );
+        REQUIRE( z->add_file( std::filesystem::u8path( "old" ), "old contents" ) );
+        REQUIRE( z->add_file( std::filesystem::u8path( "0" ), "replaced" ) );
+
+        std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+        for( size_t i = 0; i < contents.size(); ++i ) {
+            files.emplace_back( std::filesystem::u8path( std::to_string( i ) ), contents[i] );
+        }
+        // The last content for a repeated path wins.
+        files.emplace_back( std::filesystem::u8path( "1" ), "repeated" );
+        REQUIRE( z->add_files( files ) );
+    }
+
+    // Read back from a fresh load, so the footer on disk is checked as well.
+    std::shared_ptr<zzip> z = zzip::load( path );
+    REQUIRE( z );
+    CHECK( file_contents( z, "old" ) == "old contents" );
+    CHECK( file_contents( z, "0" ) == contents[0] );
+    CHECK( file_contents( z, "1" ) == "repeated" );
+    for( size_t i = 2; i < contents.size(); ++i ) {
+        CHECK( file_contents( z, std::to_string( i ) ) == contents[i] );
+    }
+    CHECK( z->get_entries().size() == contents.size() + 1 );
+
+    z.reset();
+    std::filesystem::remove( path );
+}
+
+TEST_CASE( "zzip_add_files_deletes_in_the_same_footer", "[zzip][nogame]" )
+{
+    const std::filesystem::path path = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "zzip_add_files_delete_test.zzip";
+    std::filesystem::remove( path );
+    {
+        std::shared_ptr<zzip> z = zzip::load( path );
+        REQUIRE( z );
+        REQUIRE( z->add_file( std::filesystem::u8path( "kept" ), "kept contents" ) );
+        REQUIRE( z->add_file( std::filesystem::u8path( "gone" ), "gone contents" ) );
+        REQUIRE( z->add_file( std::filesystem::u8path( "back" ), "old back contents" ) );
+
+        std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+        files.emplace_back( std::filesystem::u8path( "new" ), "new contents" );
+        files.emplace_back( std::filesystem::u8path( "back" ), "new back contents" );
+        // A deleted file that is written again stays.
+        REQUIRE( z->add_files( files, { std::filesystem::u8path( "gone" ),
+                                        std::filesystem::u8path( "back" )
+                                      } ) );
+    }
+
+    std::shared_ptr<zzip> z = zzip::load( path );
+    REQUIRE( z );
+    CHECK( file_contents( z, "kept" ) == "kept contents" );
+    CHECK( file_contents( z, "new" ) == "new contents" );
+    CHECK( file_contents( z, "back" ) == "new back contents" );
+    CHECK_FALSE( z->has_file( std::filesystem::u8path( "gone" ) ) );
+    CHECK( z->get_entries().size() == 3 );
+
+    z.reset();
+    std::filesystem::remove( path );
+}
+
+TEST_CASE( "zzip_io_stats_count_writes_and_reads", "[zzip][nogame]" )
+{
+    const std::filesystem::path path = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "zzip_io_stats_test.zzip";
+    std::filesystem::remove( path );
+    const std::string content( 5000, 'x' );
+
+    const zzip::io_stats before = zzip::get_io_stats();
+    std::shared_ptr<zzip> z = zzip::load( path );
+    REQUIRE( z );
+    REQUIRE( z->add_file( std::filesystem::u8path( "one" ), content ) );
+    std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+    files.emplace_back( std::filesystem::u8path( "two" ), content );
+    files.emplace_back( std::filesystem::u8path( "three" ), content );
+    REQUIRE( z->add_files( files ) );
+    CHECK( file_contents( z, "two" ) == content );
+    const zzip::io_stats stats = zzip::get_io_stats().since( before );
+
+    CHECK( stats.entries_written == 3 );
+    CHECK( stats.bytes_written == 3 * content.size() );
+    // A run of the same byte compresses to almost nothing.
+    CHECK( stats.compressed_bytes_written < content.size() );
+    CHECK( stats.entries_read == 1 );
+    CHECK( stats.bytes_read == content.size() );
+
+    z.reset();
+    std::filesystem::remove( path );
+}
+
+TEST_CASE( "zzip_file_stream_matches_get_file", "[zzip][nogame]" )
+{
+    const std::filesystem::path path = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "zzip_file_stream_test.zzip";
+    std::filesystem::remove( path );
+
+    // Several chunks of the stream, with a few different byte values to decompress.
+    std::string content;
+    for( int i = 0; i < 50000; ++i ) {
+        content += "{\"x\":" + std::to_string( i * 7919 % 1000 ) + "},";
+    }
+    {
+        std::shared_ptr<zzip> z = zzip::load( path );
+        REQUIRE( z );
+        REQUIRE( z->add_file( std::filesystem::u8path( "big" ), content ) );
+
+        std::unique_ptr<std::istream> stream = z->get_file_stream( std::filesystem::u8path( "big" ) );
+        REQUIRE( stream );
+        CHECK( std::string( std::istreambuf_iterator<char>( *stream ),
+                            std::istreambuf_iterator<char>() ) == content );
+
+        stream->clear();
+        for( size_t pos : {
+                 size_t{ 0 }, content.size() - 1, size_t{ 100000 }, size_t{ 99990 }, size_t{ 3 }
+             } ) {
+            stream->seekg( pos );
+            CHECK( static_cast<char>( stream->get() ) == content[pos] );
+        }
+        stream->seekg( -1, std::ios_base::cur );
+        CHECK( static_cast<char>( stream->get() ) == content[3] );
+
+        CHECK_FALSE( z->get_file_stream( std::filesystem::u8path( "missing" ) ) );
+    }
+    std::filesystem::remove( path );
+}
+
+TEST_CASE( "zzip_reads_entries_of_older_dictionary_versions", "[zzip][nogame]" )
+{
+    const std::filesystem::path folder = std::filesystem::u8path( PATH_INFO::savedir() );
+    const std::filesystem::path path = folder / "zzip_dictionary_version_test.zzip";
+    const std::filesystem::path dict = folder / "zzip_test.dict";
+    const std::filesystem::path dict_1 = zzip::dictionary_version_path( dict, 1 );
+    const std::filesystem::path dict_2 = zzip::dictionary_version_path( dict, 2 );
+    CHECK( dict_1 == folder / "zzip_test.1.dict" );
+    CHECK( zzip::dictionary_version( dict_2 ) == 2 );
+    CHECK( zzip::dictionary_version_path( dict_2, 0 ) == dict );
+
+    const auto write_dictionary = []( const std::filesystem::path & p, const std::string & content ) {
+        std::ofstream fout( p, std::ios::binary );
+        fout << content;
+    };
+    write_dictionary( dict, "{\"terrain\":\"t_grass\",\"furniture\":\"f_null\"}" );
+    write_dictionary( dict_1, "{\"items\":[{\"typeid\":\"rock\",\"charges\":1}]}" );
+    write_dictionary( dict_2, "{\"monsters\":[{\"typeid\":\"mon_zombie\",\"hp\":80}]}" );
+    std::filesystem::remove( path );
+
+    const std::string old_content = "{\"items\":[{\"typeid\":\"rock\",\"charges\":3}]}";
+    const std::string new_content = "{\"monsters\":[{\"typeid\":\"mon_zombie\",\"hp\":12}]}";
+    {
+        std::shared_ptr<zzip> z = zzip::load( path, dict_1 );
+        REQUIRE( z );
+        REQUIRE( z->add_file( std::filesystem::u8path( "old" ), old_content ) );
+    }
+    {
+        std::shared_ptr<zzip> z = zzip::load( path, dict_2 );
+        REQUIRE( z );
+        REQUIRE( z->add_file( std::filesystem::u8path( "new" ), new_content ) );
+        CHECK( file_contents( z, "old" ) == old_content );
+        CHECK( file_contents( z, "new" ) == new_content );
+        std::unique_ptr<std::istream> stream = z->get_file_stream( std::filesystem::u8path( "old" ) );
+        REQUIRE( stream );
+        CHECK( std::string( std::istreambuf_iterator<char>( *stream ),
+                            std::istreambuf_iterator<char>() ) == old_content );
+    }
+    // Extracting with the unversioned dictionary finds the versions the entries used.
+    const std::filesystem::path extracted = folder / "zzip_dictionary_version_test";
+    std::filesystem::remove_all( extracted );
+    REQUIRE( zzip::extract_to_folder( path, extracted, dict ) );
+    CHECK( std::filesystem::file_size( extracted / "old" ) == old_content.size() );
+    CHECK( std::filesystem::file_size( extracted / "new" ) == new_content.size() );
+
+    std::filesystem::remove_all( extracted );
+    for( const std::filesystem::path &p : {
+             path, dict, dict_1, dict_2
+         } ) {
+        std::filesystem::remove( p );
+    }
+}
+
+TEST_CASE( "zzip_rereads_dictionaries_after_invalidation", "[zzip][nogame]" )
+{
+    const std::filesystem::path folder = std::filesystem::u8path( PATH_INFO::savedir() );
+    const std::filesystem::path path = folder / "zzip_dictionary_invalidation_test.zzip";
+    const std::filesystem::path dict = folder / "zzip_invalidation_test.dict";
+    const std::string content = "{\"items\":[{\"typeid\":\"rock\",\"charges\":3}]}";
+    const auto write_dictionary = [&dict]( const std::string & dictionary ) {
+        std::ofstream fout( dict, std::ios::binary );
+        fout << dictionary;
+    };
+
+    write_dictionary( "{\"terrain\":\"t_grass\",\"furniture\":\"f_null\"}" );
+    std::filesystem::remove( path );
+    {
+        std::shared_ptr<zzip> z = zzip::load( path, dict );
+        REQUIRE( z );
+        REQUIRE( z->add_file( std::filesystem::u8path( "a" ), content ) );
+    }
+    std::filesystem::remove( path );
+
+    // A world made again under the same name brings another dictionary.
+    write_dictionary( "{\"items\":[{\"typeid\":\"rock\",\"charges\":1}]}" );
+    zzip::invalidate_dictionary_cache();
+    {
+        std::shared_ptr<zzip> z = zzip::load( path, dict );
+        REQUIRE( z );
+        REQUIRE( z->add_file( std::filesystem::u8path( "a" ), content ) );
+    }
+    std::filesystem::remove( dict );
+    zzip::invalidate_dictionary_cache();
+    {
+        std::shared_ptr<zzip> z = zzip::load( path, dict );
+        REQUIRE( z );
+        // Entries needing the dictionary fail to read instead of crashing.
+        CHECK_NOTHROW( file_contents( z, "a" ) );
+    }
+    write_dictionary( "{\"items\":[{\"typeid\":\"rock\",\"charges\":1}]}" );
+    zzip::invalidate_dictionary_cache();
+    {
+        std::shared_ptr<zzip> z = zzip::load( path, dict );
+        REQUIRE( z );
+        CHECK( file_contents( z, "a" ) == content );
+    }
+
+    std::filesystem::remove( path );
+    std::filesystem::remove( dict );
+}
+
+TEST_CASE( "zzip_verify_finds_and_repairs_corrupt_entries", "[zzip][nogame]" )
+{
+    const std::filesystem::path path = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "zzip_verify_test.zzip";
+    std::filesystem::remove( path );
+
+    // Varied enough that the compressed frames are a good deal longer than their metadata.
+    const auto make_content = []( int seed ) {
+        std::string content;
+        unsigned int x = seed;
+        for( int i = 0; i < 4000; ++i ) {
+            x = x * 1103515245 + 12345;
+            content += static_cast<char>( 'a' + ( x >> 16 ) % 26 );
+        }
+        return content;
+    };
+    {
+        std::shared_ptr<zzip> z = zzip::load( path );
+        REQUIRE( z );
+        for( int i = 0; i < 10; ++i ) {
+            REQUIRE( z->add_file( std::filesystem::u8path( "entry" + std::to_string( i ) ),
+                                  make_content( i ) ) );
+        }
+        CHECK( z->get_wasted_size() == 0 );
+        REQUIRE( z->add_file( std::filesystem::u8path( "entry0" ), make_content( 100 ) ) );
+        CHECK( z->get_wasted_size() > 0 );
+        REQUIRE( z->add_file( std::filesystem::u8path( "victim" ), make_content( 42 ) ) );
+    }
+
+    // Flip a byte inside the compressed frame that follows the name of the victim.
+    {
+        std::fstream f( path, std::ios::in | std::ios::out | std::ios::binary );
+        const std::string data( ( std::istreambuf_iterator<char>( f ) ),
+                                std::istreambuf_iterator<char>() );
+        const size_t name_pos = data.find( "victim" );
+        REQUIRE( name_pos != std::string::npos );
+        const size_t pos = name_pos + 200;
+        f.seekp( pos );
+        f.put( static_cast<char>( data[pos] ^ 0x55 ) );
+    }
+
+    std::shared_ptr<zzip> z = zzip::load( path );
+    REQUIRE( z );
+    std::vector<std::filesystem::path> corrupt;
+    size_t cursor = 0;
+    int steps = 0;
+    do {
+        cursor = z->verify( cursor, 1, corrupt );
+        ++steps;
+    } while( cursor != 0 && steps < 100 );
+    // One entry per step with such a small budget.
+    CHECK( steps == 11 );
+    REQUIRE( corrupt.size() == 1 );
+    CHECK( corrupt[0] == std::filesystem::u8path( "victim" ) );
+
+    REQUIRE( z->repair( corrupt ) );
+    CHECK( z->get_wasted_size() == 0 );
+    z = zzip::load( path );
+    REQUIRE( z );
+    CHECK_FALSE( z->has_file( std::filesystem::u8path( "victim" ) ) );
+    CHECK( file_contents( z, "entry0" ) == make_content( 100 ) );
+    CHECK( file_contents( z, "entry9" ) == make_content( 9 ) );
+    corrupt.clear();
+    CHECK( z->verify( 0, 1024 * 1024, corrupt ) == 0 );
+    CHECK( corrupt.empty() );
+
+    z.reset();
+    std::filesystem::remove( path );
+}
+
+TEST_CASE( "zzip_benchmark", "[.][zzip][benchmark][nogame]" )
+{
+    const std::filesystem::path path = std::filesystem::u8path( PATH_INFO::savedir() ) /
+                                       "zzip_benchmark.zzip";
+    std::filesystem::remove( path );
+
+    // About the size of a saved submap.
+    std::string content;
+    for( int i = 0; i < 2000; ++i ) {
+        content += "{\"x\":" + std::to_string( i * 7919 % 1000 ) + "},";
+    }
+    std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+    for( int i = 0; i < 64; ++i ) {
+        files.emplace_back( std::filesystem::u8path( std::to_string( i ) ), content );
+    }
+    {
+        std::shared_ptr<zzip> z = zzip::load( path );
+        REQUIRE( z );
+        BENCHMARK( "add_files of 64 files" ) {
+            return z->add_files( files );
+        };
+        BENCHMARK( "get_file" ) {
+            return z->get_file( files[0].first ).size();
+        };
+    }
+    std::filesystem::remove( path );
+}